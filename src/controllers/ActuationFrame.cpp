@@ -0,0 +1,70 @@
+/*
+ * ActuationFrame.cpp
+ * 
+ * Implementation of the staged actuator commands.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "ActuationFrame.h"
+
+#include "DriveTrain.h"
+
+ActuationFrame::ActuationFrame() {
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        powers[i] = 0;
+    }
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        pistons[i] = false;
+    }
+}
+
+void ActuationFrame::setDrive(int leftPower, int rightPower) {
+    setMotor(LEFT_FRONT, leftPower);
+    setMotor(LEFT_MIDDLE, leftPower);
+    setMotor(LEFT_BACK, leftPower);
+    setMotor(RIGHT_FRONT, rightPower);
+    setMotor(RIGHT_MIDDLE, rightPower);
+    setMotor(RIGHT_BACK, rightPower);
+}
+
+void ActuationFrame::setMotor(Motor motor, int power) {
+    powers[motor] = DriveTrain::clamp(power, -100, 100);
+}
+
+void ActuationFrame::setPistons(bool extended) {
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        pistons[i] = extended;
+    }
+}
+
+int ActuationFrame::getMotor(Motor motor) const {
+    return powers[motor];
+}
+
+bool ActuationFrame::getPiston(int piston) const {
+    return pistons[piston];
+}
+
+ActuationFrame::Motor ActuationFrame::writeOrder(int position) {
+    static const Motor ORDER[MOTOR_COUNT] = {
+        LEFT_FRONT, RIGHT_FRONT,
+        LEFT_MIDDLE, RIGHT_MIDDLE,
+        LEFT_BACK, RIGHT_BACK,
+        INTAKE, RAMP, FULL_POWER_RAMP
+    };
+    return ORDER[position];
+}
+
+uint32_t ActuationFrame::apply(MotorWriter writeMotor, PistonWriter writePiston, MicrosecondClock clock) const {
+    uint32_t startUs = (clock != nullptr) ? clock() : 0;
+    
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        Motor motor = writeOrder(i);
+        writeMotor(motor, powers[motor]);
+    }
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        writePiston(i, pistons[i]);
+    }
+    
+    return (clock != nullptr) ? clock() - startUs : 0;
+}
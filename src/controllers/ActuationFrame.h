@@ -0,0 +1,126 @@
+/*
+ * ActuationFrame.h
+ * 
+ * This header defines the ActuationFrame class, which collects every actuator command
+ * for one control tick (nine motors, two pistons) and then writes them all together.
+ * 
+ * The control loop runs in three phases: sense (read inputs), compute (decide),
+ * actuate (apply()). Writing back-to-back keeps the time between the first and the
+ * last actuator update (skew) small and the same every tick, no matter how much
+ * computing happens in between. Left and right drive motors are written in pairs
+ * so both sides of the drive change together.
+ * 
+ * No hardware dependencies - main.cpp supplies the functions that do the writes.
+ */
+
+#ifndef ACTUATIONFRAME_H
+#define ACTUATIONFRAME_H
+
+#include <cstdint>
+
+/**
+ * ActuationFrame Class
+ * 
+ * Usage (each tick):
+ *   1. setDrive(), setMotor(), setPistons() while computing
+ *   2. apply() once at the end
+ */
+class ActuationFrame {
+public:
+    /**
+     * Motors, in the same order as AllMotors in main.cpp
+     */
+    enum Motor {
+        LEFT_FRONT, LEFT_MIDDLE, LEFT_BACK,
+        RIGHT_FRONT, RIGHT_MIDDLE, RIGHT_BACK,
+        INTAKE, RAMP, FULL_POWER_RAMP,
+        MOTOR_COUNT
+    };
+    
+    /**
+     * Number of pistons (both move the full power wheel together)
+     */
+    static const int PISTON_COUNT = 2;
+    
+    /**
+     * Writes per apply()
+     */
+    static const int WRITE_COUNT = MOTOR_COUNT + PISTON_COUNT;
+    
+    /**
+     * Writes one motor command (power in percent, -100 to 100)
+     */
+    typedef void (*MotorWriter)(Motor motor, int power);
+    
+    /**
+     * Writes one piston command (true = extended)
+     */
+    typedef void (*PistonWriter)(int piston, bool extended);
+    
+    /**
+     * Supplies the current time in microseconds (for skew measurement)
+     */
+    typedef uint32_t (*MicrosecondClock)();
+    
+    /**
+     * Create a frame: every motor stopped, pistons retracted
+     */
+    ActuationFrame();
+    
+    /**
+     * Stage both drive sides
+     * 
+     * @param leftPower Left side power (-100 to 100)
+     * @param rightPower Right side power (-100 to 100)
+     */
+    void setDrive(int leftPower, int rightPower);
+    
+    /**
+     * Stage one motor
+     * 
+     * @param motor Which motor
+     * @param power Power (-100 to 100, clamped)
+     */
+    void setMotor(Motor motor, int power);
+    
+    /**
+     * Stage both pistons
+     * 
+     * @param extended true = extended
+     */
+    void setPistons(bool extended);
+    
+    /**
+     * Staged power of a motor
+     */
+    int getMotor(Motor motor) const;
+    
+    /**
+     * Staged state of a piston
+     */
+    bool getPiston(int piston) const;
+    
+    /**
+     * Motor written at a position in the burst
+     * Drive pairs first (left front, right front, left middle, ...), then the rollers.
+     * 
+     * @param position 0 to MOTOR_COUNT - 1
+     */
+    static Motor writeOrder(int position);
+    
+    /**
+     * Write every staged command back-to-back: motors in writeOrder(), then pistons
+     * 
+     * @param writeMotor Function that commands one motor
+     * @param writePiston Function that commands one piston
+     * @param clock Microsecond clock (nullptr = don't measure)
+     * @return Skew: microseconds from the first write to the last (0 if not measured)
+     */
+    uint32_t apply(MotorWriter writeMotor, PistonWriter writePiston, MicrosecondClock clock = nullptr) const;
+    
+private:
+    int powers[MOTOR_COUNT];
+    bool pistons[PISTON_COUNT];
+};
+
+#endif // ACTUATIONFRAME_H
@@ -0,0 +1,181 @@
+/*
+ * ActuationProbe.cpp
+ * 
+ * Implementation of the encoder-based actuation latency measurement.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "ActuationProbe.h"
+
+#include <cmath>
+
+ActuationProbe::ActuationProbe() : motionLatency(MOTION_BUCKET_US), riseTime(RISE_BUCKET_US) {
+    reset();
+}
+
+void ActuationProbe::reset() {
+    sampleCount = 0;
+    commandUs = 0;
+    startPosition = 0.0;
+    running = false;
+    lastResult = TrialResult{false, 0, 0, 0.0, 0.0, 0.0};
+    trialCount = 0;
+    failedCount = 0;
+    motionLatency.reset();
+    riseTime.reset();
+    deadTimeSumMs = 0.0;
+    timeConstantSumMs = 0.0;
+    steadyRpmSum = 0.0;
+}
+
+void ActuationProbe::startTrial(uint32_t commandTimeUs, double startPositionDeg) {
+    commandUs = commandTimeUs;
+    startPosition = startPositionDeg;
+    sampleCount = 0;
+    running = true;
+}
+
+bool ActuationProbe::addSample(uint32_t timestampUs, double positionDeg) {
+    if (!running) {
+        return true;
+    }
+    uint32_t elapsedUs = timestampUs - commandUs;
+    if (sampleCount < MAX_SAMPLES) {
+        sampleUs[sampleCount] = elapsedUs;
+        samplePosition[sampleCount] = positionDeg - startPosition;
+        sampleCount++;
+    }
+    if (elapsedUs >= TRIAL_TIME_US || sampleCount >= MAX_SAMPLES) {
+        finishTrial();
+        return true;
+    }
+    return false;
+}
+
+bool ActuationProbe::isRunning() const {
+    return running;
+}
+
+ActuationProbe::TrialResult ActuationProbe::getLastResult() const {
+    return lastResult;
+}
+
+int ActuationProbe::getTrialCount() const {
+    return trialCount;
+}
+
+int ActuationProbe::getFailedCount() const {
+    return failedCount;
+}
+
+const LatencyStats& ActuationProbe::getMotionLatency() const {
+    return motionLatency;
+}
+
+const LatencyStats& ActuationProbe::getRiseTime() const {
+    return riseTime;
+}
+
+ActuationProbe::MotorModel ActuationProbe::getModel() const {
+    int valid = trialCount - failedCount;
+    if (valid <= 0) {
+        return MotorModel{0.0, 0.0, 0.0};
+    }
+    return MotorModel{deadTimeSumMs / valid, timeConstantSumMs / valid, steadyRpmSum / valid};
+}
+
+void ActuationProbe::fitFirstOrder(double t10Ms, double t90Ms, double& deadTimeMs, double& timeConstantMs) {
+    timeConstantMs = (t90Ms - t10Ms) / (LN_10 - LN_10_OVER_9);
+    deadTimeMs = t10Ms - LN_10_OVER_9 * timeConstantMs;
+    if (deadTimeMs < 0.0) {
+        deadTimeMs = 0.0;
+    }
+}
+
+double ActuationProbe::speedAt(int index) const {
+    // Degrees per microsecond -> rpm (one reading back; index >= 1)
+    double dt = (double)(sampleUs[index] - sampleUs[index - 1]);
+    if (dt <= 0.0) {
+        return 0.0;
+    }
+    return (samplePosition[index] - samplePosition[index - 1]) / dt * 1e6 / 6.0;
+}
+
+double ActuationProbe::crossingTime(double t0, double v0, double t1, double v1, double level) {
+    if (v1 <= v0) {
+        return t1;
+    }
+    double fraction = (level - v0) / (v1 - v0);
+    if (fraction < 0.0) {
+        fraction = 0.0;
+    }
+    return t0 + fraction * (t1 - t0);
+}
+
+void ActuationProbe::finishTrial() {
+    running = false;
+    trialCount++;
+    TrialResult result = TrialResult{false, 0, 0, 0.0, 0.0, 0.0};
+    
+    // First encoder movement
+    bool moved = false;
+    for (int i = 0; i < sampleCount; i++) {
+        if (std::fabs(samplePosition[i]) >= MOVE_THRESHOLD_DEG) {
+            result.firstMotionUs = sampleUs[i];
+            moved = true;
+            break;
+        }
+    }
+    
+    // Steady speed: average over the end of the trial
+    uint32_t steadyFromUs = (uint32_t)(sampleUs[sampleCount > 0 ? sampleCount - 1 : 0] * STEADY_FRACTION);
+    int steadyIndex = -1;
+    for (int i = 1; i < sampleCount; i++) {
+        if (sampleUs[i - 1] >= steadyFromUs) {
+            steadyIndex = i - 1;
+            break;
+        }
+    }
+    if (moved && steadyIndex >= 0 && steadyIndex < sampleCount - 1) {
+        int last = sampleCount - 1;
+        result.steadyRpm = (samplePosition[last] - samplePosition[steadyIndex]) /
+                           (double)(sampleUs[last] - sampleUs[steadyIndex]) * 1e6 / 6.0;
+    }
+    
+    // 10% and 90% speed crossings. Speed is measured between readings (placed at the
+    // midpoint time) and the crossing is interpolated, so the report period doesn't bias it.
+    double t10Ms = -1.0;
+    double t90Ms = -1.0;
+    double steadyMagnitude = std::fabs(result.steadyRpm);
+    if (steadyMagnitude > 1.0) {
+        double previousMs = 0.0;     // At rest when commanded
+        double previousSpeed = 0.0;
+        for (int i = 1; i < sampleCount && t90Ms < 0.0; i++) {
+            double speed = std::fabs(speedAt(i));
+            double midMs = (sampleUs[i] + sampleUs[i - 1]) / 2000.0;
+            if (t10Ms < 0.0 && speed >= 0.1 * steadyMagnitude) {
+                t10Ms = crossingTime(previousMs, previousSpeed, midMs, speed, 0.1 * steadyMagnitude);
+            }
+            if (speed >= 0.9 * steadyMagnitude) {
+                t90Ms = crossingTime(previousMs, previousSpeed, midMs, speed, 0.9 * steadyMagnitude);
+            }
+            previousMs = midMs;
+            previousSpeed = speed;
+        }
+    }
+    
+    if (moved && t10Ms >= 0.0 && t90Ms > t10Ms) {
+        result.valid = true;
+        result.riseTimeUs = (uint32_t)((t90Ms - t10Ms) * 1000.0);
+        fitFirstOrder(t10Ms, t90Ms, result.deadTimeMs, result.timeConstantMs);
+        
+        motionLatency.add(result.firstMotionUs);
+        riseTime.add(result.riseTimeUs);
+        deadTimeSumMs += result.deadTimeMs;
+        timeConstantSumMs += result.timeConstantMs;
+        steadyRpmSum += result.steadyRpm;
+    } else {
+        failedCount++;
+    }
+    lastResult = result;
+}
@@ -0,0 +1,170 @@
+/*
+ * ActuationProbe.h
+ * 
+ * This header defines the ActuationProbe class, which measures how long a motor
+ * really takes to respond to a command, from its own encoder.
+ * 
+ * Software timestamps stop at the spin() call; the motor firmware, the smart port
+ * link and the motor's own acceleration come after it. One trial is:
+ *   1. the robot code commands a step (stopped -> fixed power) and calls startTrial()
+ *   2. it passes every new encoder reading to addSample()
+ *   3. the probe finds the first encoder movement and the 10% -> 90% speed rise time
+ * 
+ * Over many trials it keeps distributions of both, and fits a simple motor model
+ * (dead time + first-order lag) for the simulator and the latency budgets.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef ACTUATIONPROBE_H
+#define ACTUATIONPROBE_H
+
+#include <cstdint>
+
+#include "LatencyStats.h"
+
+/**
+ * ActuationProbe Class
+ * 
+ * Usage (one probe per motor type):
+ *   startTrial(commandUs, position) right after the step command
+ *   while (!addSample(nowUs, position)) { ... }   - only new encoder readings
+ *   stop the motor, rest, repeat; then read the statistics and getModel()
+ */
+class ActuationProbe {
+public:
+    /**
+     * Most encoder readings kept per trial
+     */
+    static const int MAX_SAMPLES = 128;
+    
+    /**
+     * Movement (degrees) that counts as "the motor started"
+     */
+    static constexpr double MOVE_THRESHOLD_DEG = 0.5;
+    
+    /**
+     * Length of one trial (microseconds) - long enough to reach full speed
+     */
+    static const uint32_t TRIAL_TIME_US = 400000;
+    
+    /**
+     * Result of one trial
+     */
+    struct TrialResult {
+        bool valid;             // Moved and reached a steady speed
+        uint32_t firstMotionUs; // Command -> first encoder movement
+        uint32_t riseTimeUs;    // 10% -> 90% of steady speed
+        double deadTimeMs;      // Fitted dead time (command -> start of acceleration)
+        double timeConstantMs;  // Fitted first-order time constant
+        double steadyRpm;       // Speed over the last part of the trial
+    };
+    
+    /**
+     * Motor model for the simulator: speed follows the command after deadTimeMs,
+     * with a first-order lag of timeConstantMs, settling at steadyRpm
+     */
+    struct MotorModel {
+        double deadTimeMs;
+        double timeConstantMs;
+        double steadyRpm;
+    };
+    
+    /**
+     * Create a probe with no trials
+     */
+    ActuationProbe();
+    
+    /**
+     * Forget every trial
+     */
+    void reset();
+    
+    /**
+     * Start a trial (call right after commanding the step)
+     * 
+     * @param commandUs When the command was sent (microseconds)
+     * @param startPositionDeg Encoder position before the step (degrees)
+     */
+    void startTrial(uint32_t commandUs, double startPositionDeg);
+    
+    /**
+     * Add a new encoder reading
+     * 
+     * @param timestampUs When it was read (microseconds, same clock as startTrial)
+     * @param positionDeg Encoder position (degrees)
+     * @return true when the trial is over (results are in)
+     */
+    bool addSample(uint32_t timestampUs, double positionDeg);
+    
+    /**
+     * Check if a trial is in progress
+     */
+    bool isRunning() const;
+    
+    /**
+     * Result of the last finished trial
+     */
+    TrialResult getLastResult() const;
+    
+    /**
+     * Number of finished trials, and how many of them failed (no movement, no steady speed)
+     */
+    int getTrialCount() const;
+    int getFailedCount() const;
+    
+    /**
+     * Distribution of command -> first encoder movement
+     */
+    const LatencyStats& getMotionLatency() const;
+    
+    /**
+     * Distribution of 10% -> 90% rise time
+     */
+    const LatencyStats& getRiseTime() const;
+    
+    /**
+     * Motor model averaged over the valid trials (all zero if none)
+     */
+    MotorModel getModel() const;
+    
+    /**
+     * Fit a first-order model to the 10% and 90% speed crossing times
+     * For v = V(1 - e^-(t - dead) / tau): t10 = dead + 0.105 tau, t90 = dead + 2.303 tau
+     * 
+     * @param t10Ms Time the speed reached 10% (ms after the command)
+     * @param t90Ms Time the speed reached 90% (ms after the command)
+     * @param deadTimeMs Output: dead time
+     * @param timeConstantMs Output: time constant
+     */
+    static void fitFirstOrder(double t10Ms, double t90Ms, double& deadTimeMs, double& timeConstantMs);
+    
+private:
+    static const uint32_t MOTION_BUCKET_US = 1000;       // 1 ms resolution, up to 64 ms
+    static const uint32_t RISE_BUCKET_US = 4000;         // 4 ms resolution, up to 256 ms
+    static constexpr double STEADY_FRACTION = 0.75;      // Steady speed = average after 75% of the trial
+    static constexpr double LN_10_OVER_9 = 0.10536;      // ln(1 / 0.9)
+    static constexpr double LN_10 = 2.30259;             // ln(1 / 0.1)
+    
+    uint32_t sampleUs[MAX_SAMPLES];      // Time since the command
+    double samplePosition[MAX_SAMPLES];  // Degrees moved since the start
+    int sampleCount;
+    uint32_t commandUs;
+    double startPosition;
+    bool running;
+    
+    TrialResult lastResult;
+    int trialCount;
+    int failedCount;
+    LatencyStats motionLatency;
+    LatencyStats riseTime;
+    double deadTimeSumMs;
+    double timeConstantSumMs;
+    double steadyRpmSum;
+    
+    void finishTrial();
+    double speedAt(int index) const;
+    static double crossingTime(double t0, double v0, double t1, double v1, double level);
+};
+
+#endif // ACTUATIONPROBE_H
@@ -0,0 +1,275 @@
+/*
+ * AutonSchedule.cpp
+ * 
+ * Implementation of the time-aware autonomous step schedule.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "AutonSchedule.h"
+
+AutonSchedule::AutonSchedule() {
+    clear();
+}
+
+void AutonSchedule::clear() {
+    count = 0;
+    endMs = 0;
+    current = NO_STEP;
+    currentStartMs = 0;
+    takenMs = 0;
+    plannedMs = 0;
+}
+
+int AutonSchedule::addStep(const char* name, uint32_t expectedMs, double points, int needs) {
+    if (count >= MAX_STEPS || needs < NO_STEP || needs >= count) {
+        return NO_STEP;
+    }
+    Step& step = steps[count];
+    step.name = name;
+    step.expectedMs = expectedMs;
+    step.points = points;
+    step.needs = needs;
+    step.state = PENDING;
+    return count++;
+}
+
+void AutonSchedule::start(uint32_t nowMs, uint32_t periodMs) {
+    endMs = nowMs + periodMs;
+    current = NO_STEP;
+    takenMs = 0;
+    plannedMs = 0;
+    for (int i = 0; i < count; i++) {
+        steps[i].state = PENDING;
+    }
+}
+
+int AutonSchedule::next(uint32_t nowMs) {
+    if (current != NO_STEP) {
+        return current;
+    }
+    skipOrphans();
+    
+    int chosen = NO_STEP;
+    if (!isBehind(nowMs)) {
+        // On time: the listed order
+        for (int i = 0; i < count && chosen == NO_STEP; i++) {
+            bool needsDone = steps[i].needs == NO_STEP || steps[steps[i].needs].state == DONE;
+            if (steps[i].state == PENDING && needsDone) {
+                chosen = i;
+            }
+        }
+    } else {
+        Paths paths;
+        findPaths(nowMs, paths);
+        int32_t leftMs = timeLeft(nowMs);
+        
+        // Best points per second, and most points, that still fit
+        int fastest = NO_STEP;
+        int biggest = NO_STEP;
+        double bestRate = 0.0;
+        for (int i = 0; i < count; i++) {
+            double stepRate = rate(paths, i, leftMs);
+            if (stepRate <= 0.0) {
+                continue;
+            }
+            if (stepRate > bestRate) {
+                fastest = i;
+                bestRate = stepRate;
+            }
+            if (biggest == NO_STEP || paths.points[i] > paths.points[biggest]) {
+                biggest = i;
+            }
+        }
+        
+        // The fastest points first, unless that leaves no time for more points
+        int target = fastest;
+        if (fastest != NO_STEP && paths.first[biggest] != paths.first[fastest] &&
+            paths.ms[fastest] + paths.ms[biggest] > leftMs &&
+            paths.points[biggest] > paths.points[fastest]) {
+            target = biggest;
+        }
+        
+        // Nothing fits: the quickest points left, it might still make it
+        for (int i = 0; i < count && fastest == NO_STEP; i++) {
+            if (paths.first[i] != NO_STEP && paths.points[i] > 0.0 &&
+                (target == NO_STEP || paths.ms[i] < paths.ms[target])) {
+                target = i;
+            }
+        }
+        if (target != NO_STEP) {
+            chosen = paths.first[target];
+        }
+    }
+    
+    if (chosen == NO_STEP) {
+        // Nothing left leads to points
+        for (int i = 0; i < count; i++) {
+            if (steps[i].state == PENDING) {
+                steps[i].state = SKIPPED;
+            }
+        }
+    } else {
+        steps[chosen].state = RUNNING;
+        current = chosen;
+        currentStartMs = nowMs;
+    }
+    return chosen;
+}
+
+bool AutonSchedule::update(uint32_t nowMs) {
+    if (current == NO_STEP) {
+        return true;
+    }
+    double expected = getPace() * steps[current].expectedMs;
+    double elapsed = (double)(nowMs - currentStartMs);
+    bool overrun = elapsed > MAX_OVERRUN * expected;
+    bool tooLate = runningNeedsMs(nowMs) > timeLeft(nowMs);
+    if (!overrun && !tooLate) {
+        return true;
+    }
+    
+    // Points from staying with this step (and whatever else fits after it) vs. the
+    // most points another step gets out of the time left
+    Paths paths;
+    findPaths(nowMs, paths);
+    int32_t leftMs = timeLeft(nowMs);
+    int stay = NO_STEP;
+    double otherPoints = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (rate(paths, i, leftMs) <= 0.0) {
+            continue;
+        }
+        if (paths.first[i] == current) {
+            stay = (stay == NO_STEP || paths.points[i] > paths.points[stay]) ? i : stay;
+        } else if (paths.points[i] > otherPoints) {
+            otherPoints = paths.points[i];
+        }
+    }
+    if (stay == NO_STEP) {
+        return otherPoints <= 0.0;  // Can't make it: stop if something else can
+    }
+    double afterPoints = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (paths.first[i] != current && rate(paths, i, leftMs - (int32_t)paths.ms[stay]) > 0.0 &&
+            paths.points[i] > afterPoints) {
+            afterPoints = paths.points[i];
+        }
+    }
+    return paths.points[stay] + afterPoints >= otherPoints;
+}
+
+void AutonSchedule::finishStep(uint32_t nowMs, bool finished) {
+    if (current == NO_STEP) {
+        return;
+    }
+    Step& step = steps[current];
+    if (finished) {
+        step.state = DONE;
+        takenMs += nowMs - currentStartMs;
+        plannedMs += step.expectedMs;
+    } else {
+        step.state = FAILED;
+        skipOrphans();
+    }
+    current = NO_STEP;
+}
+
+bool AutonSchedule::isBehind(uint32_t nowMs) const {
+    double pendingMs = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (steps[i].state == PENDING) {
+            pendingMs += steps[i].expectedMs;
+        }
+    }
+    return getPace() * pendingMs + runningNeedsMs(nowMs) > timeLeft(nowMs);
+}
+
+double AutonSchedule::getPace() const {
+    if (plannedMs == 0) {
+        return 1.0;
+    }
+    double pace = (double)takenMs / plannedMs;
+    return (pace < MIN_PACE) ? MIN_PACE : (pace > MAX_PACE) ? MAX_PACE : pace;
+}
+
+double AutonSchedule::getScore() const {
+    double score = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (steps[i].state == DONE) {
+            score += steps[i].points;
+        }
+    }
+    return score;
+}
+
+int AutonSchedule::getStepCount() const {
+    return count;
+}
+
+int AutonSchedule::getCurrent() const {
+    return current;
+}
+
+AutonSchedule::StepState AutonSchedule::getState(int step) const {
+    return steps[step].state;
+}
+
+const char* AutonSchedule::getName(int step) const {
+    return steps[step].name;
+}
+
+int32_t AutonSchedule::timeLeft(uint32_t nowMs) const {
+    return (int32_t)(endMs - END_MARGIN_MS - nowMs);
+}
+
+double AutonSchedule::runningNeedsMs(uint32_t nowMs) const {
+    if (current == NO_STEP) {
+        return 0.0;
+    }
+    double expected = getPace() * steps[current].expectedMs;
+    double elapsed = (double)(nowMs - currentStartMs);
+    return (elapsed < expected) ? expected - elapsed : OVERRUN_LEFT * expected;
+}
+
+void AutonSchedule::findPaths(uint32_t nowMs, Paths& paths) const {
+    for (int i = 0; i < count; i++) {
+        const Step& step = steps[i];
+        paths.ms[i] = 0.0;
+        paths.points[i] = 0.0;
+        paths.first[i] = NO_STEP;
+        if (step.state != PENDING && step.state != RUNNING) {
+            continue;
+        }
+        
+        double ownMs = (step.state == RUNNING) ? runningNeedsMs(nowMs) : getPace() * step.expectedMs;
+        if (step.needs == NO_STEP || steps[step.needs].state == DONE) {
+            paths.ms[i] = ownMs;
+            paths.points[i] = step.points;
+            paths.first[i] = i;
+        } else if (paths.first[step.needs] != NO_STEP) {
+            paths.ms[i] = paths.ms[step.needs] + ownMs;
+            paths.points[i] = paths.points[step.needs] + step.points;
+            paths.first[i] = paths.first[step.needs];
+        }
+    }
+}
+
+double AutonSchedule::rate(const Paths& paths, int step, int32_t leftMs) const {
+    if (paths.first[step] == NO_STEP || paths.points[step] <= 0.0 || paths.ms[step] > leftMs) {
+        return 0.0;
+    }
+    return paths.points[step] / (paths.ms[step] > 1.0 ? paths.ms[step] : 1.0);
+}
+
+void AutonSchedule::skipOrphans() {
+    // A step only needs earlier steps, so one pass in order reaches the whole chain
+    for (int i = 0; i < count; i++) {
+        int needs = steps[i].needs;
+        if (steps[i].state != PENDING || needs == NO_STEP) {
+            continue;
+        }
+        if (steps[needs].state == FAILED || steps[needs].state == SKIPPED) {
+            steps[i].state = SKIPPED;
+        }
+    }
+}
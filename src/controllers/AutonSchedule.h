@@ -0,0 +1,218 @@
+/*
+ * AutonSchedule.h
+ * 
+ * This header defines the AutonSchedule class, which decides which autonomous step to
+ * run next, and whether to keep going with the one that is running, from how much of
+ * the period is left.
+ * 
+ * An autonomous routine is a list of steps (drive out, pick up a ball, score it, ...),
+ * each with how long it is expected to take and how many points it is worth when it
+ * finishes. Steps can need an earlier step (scoring a ball needs the pickup); a step that
+ * only sets up later ones is worth 0 by itself.
+ * 
+ * While the routine is on time, the steps run in the order they were listed. Once what
+ * is left would run past the end of the period (a slow pickup, a detour), the schedule
+ * goes for the points it can still get: the most points per second first (a step's
+ * points include the steps it needs, e.g. pickup + score), unless that leaves no time
+ * for a bigger score. Steps that no longer fit are passed over and only tried at the end
+ * if nothing else is left, instead of the robot being caught mid-move at the buzzer with
+ * nothing scored. A step running late is stopped once staying with it gets fewer points
+ * than starting another one.
+ * 
+ * Expected times are scaled by the pace so far (time taken / time expected for the
+ * finished steps), so a robot that runs slow all match plans for it.
+ * 
+ * Every decision is one pass over the steps.
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef AUTONSCHEDULE_H
+#define AUTONSCHEDULE_H
+
+#include <cstdint>
+
+/**
+ * AutonSchedule Class
+ * 
+ * Usage:
+ *   1. clear(), addStep() for each step of the routine, in the order to run them
+ *   2. start() when the period starts
+ *   3. next() for the step to run (NO_STEP = nothing left worth doing)
+ *   4. Every tick while it runs: update(); false = stop the step now
+ *   5. finishStep() when it ends, then back to 3
+ */
+class AutonSchedule {
+public:
+    /**
+     * Where a step is
+     */
+    enum StepState {
+        PENDING,   // Not run yet
+        RUNNING,   // Being run
+        DONE,      // Finished (its points count)
+        FAILED,    // Ran but didn't finish (timed out, abandoned, nothing to pick up)
+        SKIPPED    // Not run: nothing left to gain from it, or a step it needs failed
+    };
+    
+    /**
+     * Most steps in a routine
+     */
+    static const int MAX_STEPS = 16;
+    
+    /**
+     * "No step" (from next(), and for a step that needs nothing before it)
+     */
+    static const int NO_STEP = -1;
+    
+    /**
+     * Aim to have the last step done this long before the end of the period (ms)
+     */
+    static const uint32_t END_MARGIN_MS = 200;
+    
+    /**
+     * Limits on the pace (time taken / time expected of the finished steps)
+     */
+    static constexpr double MIN_PACE = 0.8;
+    static constexpr double MAX_PACE = 1.5;
+    
+    /**
+     * A step running this many times its expected time (or that can't finish in time
+     * anymore) is checked against starting another step instead
+     */
+    static constexpr double MAX_OVERRUN = 1.5;
+    
+    /**
+     * Time still needed by a step already past its expected time, as a part of that
+     * time (it is close, but nobody knows how close)
+     */
+    static constexpr double OVERRUN_LEFT = 0.25;
+    
+    AutonSchedule();
+    
+    /**
+     * Remove every step
+     */
+    void clear();
+    
+    /**
+     * Add a step at the end of the routine
+     * 
+     * @param name Short name for logs (not copied, use a string literal)
+     * @param expectedMs How long it usually takes
+     * @param points What finishing it is worth (0 for a step that sets up later ones)
+     * @param needs Step that must be DONE before this one (an earlier step, or NO_STEP)
+     * @return The step's number, or NO_STEP if the routine is full or needs is invalid
+     */
+    int addStep(const char* name, uint32_t expectedMs, double points, int needs = NO_STEP);
+    
+    /**
+     * Start the routine: every step PENDING
+     * 
+     * @param nowMs Current time
+     * @param periodMs Time until the end of the period (e.g. MatchClock::getRemainingMs())
+     */
+    void start(uint32_t nowMs, uint32_t periodMs);
+    
+    /**
+     * Pick the step to run and mark it RUNNING
+     * 
+     * When nothing is left that leads to points, the steps not run are marked SKIPPED.
+     * 
+     * @param nowMs Current time
+     * @return Step number, or NO_STEP when nothing left is worth starting
+     */
+    int next(uint32_t nowMs);
+    
+    /**
+     * Check the running step (call every tick)
+     * 
+     * @param nowMs Current time
+     * @return false if the step should be stopped now (then call finishStep() with false)
+     */
+    bool update(uint32_t nowMs);
+    
+    /**
+     * The running step ended
+     * 
+     * @param nowMs Current time
+     * @param finished true if it did what it was for (its points count); false skips
+     *                 the steps that need it
+     */
+    void finishStep(uint32_t nowMs, bool finished);
+    
+    /**
+     * True if the steps left would run past the end of the period at the current pace
+     */
+    bool isBehind(uint32_t nowMs) const;
+    
+    /**
+     * Time taken / time expected of the finished steps (1.0 until one finishes)
+     */
+    double getPace() const;
+    
+    /**
+     * Points of the DONE steps
+     */
+    double getScore() const;
+    
+    int getStepCount() const;
+    int getCurrent() const;
+    StepState getState(int step) const;
+    const char* getName(int step) const;
+    
+private:
+    struct Step {
+        const char* name;
+        uint32_t expectedMs;
+        double points;
+        int needs;
+        StepState state;
+    };
+    
+    /**
+     * What it takes to finish each step from now: the step and every step it needs
+     * that isn't DONE yet (the running one counts for its time still needed)
+     */
+    struct Paths {
+        double ms[MAX_STEPS];
+        double points[MAX_STEPS];
+        int first[MAX_STEPS];   // Step to run first on the way (NO_STEP = can't be done)
+    };
+    
+    Step steps[MAX_STEPS];
+    int count;
+    
+    uint32_t endMs;
+    int current;
+    uint32_t currentStartMs;
+    uint32_t takenMs;      // Time the finished steps took
+    uint32_t plannedMs;    // Time they were expected to take
+    
+    /**
+     * Time left until END_MARGIN_MS before the end (negative when past it)
+     */
+    int32_t timeLeft(uint32_t nowMs) const;
+    
+    /**
+     * Time the running step still needs at the current pace
+     */
+    double runningNeedsMs(uint32_t nowMs) const;
+    
+    /**
+     * Fill in the paths (one pass: a step only needs earlier steps)
+     */
+    void findPaths(uint32_t nowMs, Paths& paths) const;
+    
+    /**
+     * Points per second of going for a step (0 if it's worth nothing or its path
+     * doesn't fit in leftMs)
+     */
+    double rate(const Paths& paths, int step, int32_t leftMs) const;
+    
+    /**
+     * Mark SKIPPED every PENDING step whose needed step FAILED or was SKIPPED
+     */
+    void skipOrphans();
+};
+
+#endif // AUTONSCHEDULE_H
@@ -0,0 +1,204 @@
+/*
+ * BallDetector.cpp
+ * 
+ * Implementation of sensorless ball detection.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "BallDetector.h"
+
+#include <cmath>
+#include <cstdlib>
+
+BallDetector::BallDetector(int capacity)
+    : capacity(capacity),
+      count(0),
+      wheelFeeding(false) {
+    // Half-sine bump in the middle of the window, flat on each side. Removing the mean
+    // makes the filter blind to the motor's steady current and speed, and scaling to
+    // unit length makes the output the bump's size in CURRENT/SPEED_SCALE units.
+    const double PI = 3.14159265358979;
+    int flat = (WINDOW - SIGNATURE_TICKS) / 2;
+    double mean = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        int k = i - flat;
+        weights[i] = (k >= 0 && k < SIGNATURE_TICKS) ? std::sin(PI * (k + 0.5) / SIGNATURE_TICKS) : 0.0;
+        mean += weights[i] / WINDOW;
+    }
+    double length = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        weights[i] -= mean;
+        length += weights[i] * weights[i];
+    }
+    length = std::sqrt(length);
+    for (int i = 0; i < WINDOW; i++) {
+        weights[i] /= length;
+    }
+    
+    reset();
+}
+
+void BallDetector::reset(int balls) {
+    count = 0;
+    addBalls(balls);
+    for (int c = 0; c < CHANNEL_COUNT; c++) {
+        restart(channels[c], 0, 0);
+        channels[c].detected = false;
+        channels[c].lastDetectMs = 0;
+        channels[c].detections = 0;
+    }
+}
+
+void BallDetector::setWheelFeeding(bool feeding) {
+    wheelFeeding = feeding;
+}
+
+bool BallDetector::update(Channel channel, double amps, double rpm, int power, uint32_t nowMs) {
+    ChannelState& state = channels[channel];
+    int direction = (power > 0) ? 1 : (power < 0) ? -1 : 0;
+    
+    // Stopped, stalled, or reversed: the readings are speed changes, not balls
+    bool reversed = direction != state.direction;
+    if (reversed || direction == 0 || std::fabs(rpm) < MIN_RUNNING_RPM) {
+        if (reversed || state.filled > 0) {
+            restart(state, power, nowMs);
+        }
+        return false;
+    }
+    
+    // A step in the command: hold the window until the speed settles at the new level
+    if (std::abs(power - state.power) > POWER_CHANGE && state.filled > 0) {
+        state.settling = true;
+        state.settleStartMs = nowMs;
+        state.settleHasValue = false;
+    }
+    state.power = power;
+    
+    // A reading in a later slot finishes the current one (and repeats it over any slots
+    // that got no reading), then starts its own
+    uint32_t slot = (nowMs - state.runningSinceMs) / SAMPLE_MS;
+    bool hit = false;
+    if (state.slotReadings > 0 && slot > state.slot) {
+        double value = state.slotSum / state.slotReadings;
+        if (!state.settling || settle(state, value, nowMs)) {
+            uint32_t finished = slot - state.slot;
+            for (uint32_t i = 0; i < finished && i < (uint32_t)WINDOW; i++) {
+                hit = addSlot(channel, value, nowMs) || hit;
+            }
+        }
+        state.slotSum = 0.0;
+        state.slotReadings = 0;
+    }
+    state.slot = slot;
+    state.slotSum += std::fabs(amps) / CURRENT_SCALE_AMPS - std::fabs(rpm) / SPEED_SCALE_RPM;
+    state.slotReadings++;
+    return hit;
+}
+
+bool BallDetector::addSlot(Channel channel, double value, uint32_t nowMs) {
+    ChannelState& state = channels[channel];
+    state.signal[state.next] = value;
+    state.next = (state.next + 1) % WINDOW;
+    if (state.filled < WINDOW) {
+        state.filled++;
+    }
+    if (state.filled < WINDOW || nowMs - state.runningSinceMs < SPINUP_MS) {
+        return false;
+    }
+    
+    // Matched filter over the window, oldest slot first
+    state.lastScore = state.score;
+    state.score = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        state.score += weights[i] * state.signal[(state.next + i) % WINDOW];
+    }
+    
+    // A ball is the peak of the filter output (the slot after it starts falling)
+    bool peak = state.lastScore >= DETECT_THRESHOLD && state.score < state.lastScore;
+    bool tooSoon = state.detected && nowMs - state.lastDetectMs < MIN_GAP_MS;
+    if (!peak || tooSoon) {
+        return false;
+    }
+    
+    state.detected = true;
+    state.lastDetectMs = nowMs;
+    state.detections++;
+    if (channel == INTAKE) {
+        addBalls(state.direction);  // Grabbed, or spat out
+    } else if (state.direction > 0 && wheelFeeding) {
+        addBalls(-1);               // Fed into the full power wheel and scored
+    }
+    return true;
+}
+
+int BallDetector::getCount() const {
+    return count;
+}
+
+int BallDetector::getCapacity() const {
+    return capacity;
+}
+
+bool BallDetector::isFull() const {
+    return count >= capacity;
+}
+
+int BallDetector::getDetectionCount(Channel channel) const {
+    return channels[channel].detections;
+}
+
+double BallDetector::getScore(Channel channel) const {
+    return channels[channel].score;
+}
+
+bool BallDetector::settle(ChannelState& state, double value, uint32_t nowMs) {
+    // Settled once the signal stops changing (slots without a reading count as steps too)
+    bool steady = state.settleHasValue &&
+                  std::fabs(value - state.settleValue) <= SETTLED_CHANGE * (state.slot - state.settleSlot);
+    state.settleHasValue = true;
+    state.settleValue = value;
+    state.settleSlot = state.slot;
+    if (!steady && nowMs - state.settleStartMs < SETTLE_MS) {
+        return false;
+    }
+    
+    // The filter ignores a constant level but not a step: move the readings from before
+    // the step to the new level so only what comes next can look like a ball
+    double shift = value - state.signal[(state.next + WINDOW - 1) % WINDOW];
+    for (int i = 0; i < WINDOW; i++) {
+        state.signal[i] += shift;
+    }
+    state.settling = false;
+    return true;
+}
+
+void BallDetector::restart(ChannelState& state, int power, uint32_t nowMs) {
+    for (int i = 0; i < WINDOW; i++) {
+        state.signal[i] = 0.0;
+    }
+    state.next = 0;
+    state.filled = 0;
+    state.slot = 0;
+    state.slotSum = 0.0;
+    state.slotReadings = 0;
+    state.direction = (power > 0) ? 1 : (power < 0) ? -1 : 0;
+    state.power = power;
+    state.settling = false;
+    state.settleStartMs = nowMs;
+    state.settleHasValue = false;
+    state.settleValue = 0.0;
+    state.settleSlot = 0;
+    state.runningSinceMs = nowMs;
+    state.score = 0.0;
+    state.lastScore = 0.0;
+}
+
+void BallDetector::addBalls(int change) {
+    count += change;
+    if (count < 0) {
+        count = 0;
+    }
+    if (count > capacity) {
+        count = capacity;
+    }
+}
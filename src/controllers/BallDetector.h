@@ -0,0 +1,219 @@
+/*
+ * BallDetector.h
+ * 
+ * This header defines the BallDetector class, which counts balls without an optical
+ * sensor. When a ball is grabbed by the intake (or pushed along by the ramp), the
+ * motor works harder for a moment: its current bumps up and its speed dips. The
+ * detector looks for that shape in each motor's recent readings with a small matched
+ * filter and keeps an approximate count of the balls in the robot.
+ * 
+ * The count is approximate: a missed grab or a double count is corrected the next
+ * time the robot is emptied (the count never goes below 0 or above the capacity).
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef BALLDETECTOR_H
+#define BALLDETECTOR_H
+
+#include <cstdint>
+
+/**
+ * BallDetector Class
+ * 
+ * Usage (once per control tick, any period - readings are resampled by timestamp):
+ *   1. setWheelFeeding() - true while the ramp feeds balls into a spinning full power wheel
+ *   2. update() for the intake and the ramp with current, speed and commanded power
+ *   3. isFull() to stop intaking (IntakeController::limitToCapacity())
+ * 
+ * Counting:
+ *   - Intake forward signature: ball grabbed (+1)
+ *   - Intake reverse signature: ball spat out (-1)
+ *   - Ramp forward signature while feeding the wheel: ball scored (-1)
+ *   - Ramp signature otherwise: hand-off inside the robot (no change)
+ */
+class BallDetector {
+public:
+    /**
+     * Motors that are watched
+     */
+    enum Channel {
+        INTAKE = 0,
+        RAMP = 1,
+        CHANNEL_COUNT = 2
+    };
+    
+    /**
+     * Readings are averaged into slots this long (ms), one window entry per slot, so
+     * the window covers the same time however often update() is called. A slot with
+     * no reading (ticks slower than SAMPLE_MS) repeats the previous one.
+     */
+    static const uint32_t SAMPLE_MS = 10;
+    
+    /**
+     * Slots in the matched filter window
+     */
+    static const int WINDOW = 12;
+    
+    /**
+     * Slots of the ball signature inside the window (the rest is flat on each side)
+     */
+    static const int SIGNATURE_TICKS = 8;
+    
+    /**
+     * Units that make a current bump and a speed dip comparable
+     * (a typical grab is about 0.5 A up and 15 rpm down)
+     */
+    static constexpr double CURRENT_SCALE_AMPS = 0.5;
+    static constexpr double SPEED_SCALE_RPM = 20.0;
+    
+    /**
+     * Matched filter output that counts as a ball
+     */
+    static constexpr double DETECT_THRESHOLD = 1.0;
+    
+    /**
+     * Two balls can't go through one motor closer together than this (ms)
+     */
+    static const uint32_t MIN_GAP_MS = 150;
+    
+    /**
+     * A commanded power this far (percent) from the last update's is a step: the motor's
+     * velocity loop catching up looks just like a ball, so the window waits for the speed
+     * to settle and then moves its older readings to the new level. Gradual changes (the
+     * ground-speed-matched intake following the drive) need nothing: the filter is blind
+     * to a steady ramp.
+     */
+    static const int POWER_CHANGE = 10;
+    
+    /**
+     * After a step, the speed has settled once the signal changes less than this per
+     * slot (in CURRENT/SPEED_SCALE units)
+     */
+    static constexpr double SETTLED_CHANGE = 0.05;
+    
+    /**
+     * Longest wait for the speed to settle after a step (ms)
+     */
+    static const uint32_t SETTLE_MS = 200;
+    
+    /**
+     * Readings are ignored this long after the motor starts or changes direction (ms)
+     */
+    static const uint32_t SPINUP_MS = 200;
+    
+    /**
+     * Below this speed the motor is stalled or stopped, not handling a ball (rpm)
+     */
+    static constexpr double MIN_RUNNING_RPM = 20.0;
+    
+    /**
+     * Balls the robot holds when full (tune to the robot)
+     */
+    static const int DEFAULT_CAPACITY = 3;
+    
+    /**
+     * Constructor
+     * 
+     * @param capacity Balls the robot holds when full
+     */
+    BallDetector(int capacity = DEFAULT_CAPACITY);
+    
+    /**
+     * Start over with a known count (e.g. 1 preload at the start of a match)
+     */
+    void reset(int balls = 0);
+    
+    /**
+     * Ramp detections are balls leaving through the full power wheel
+     */
+    void setWheelFeeding(bool feeding);
+    
+    /**
+     * Add one reading for a motor
+     * 
+     * @param channel INTAKE or RAMP
+     * @param amps Motor current
+     * @param rpm Motor speed
+     * @param power Commanded power (percent, sign = direction)
+     * @param nowMs Current time
+     * @return true if a ball was detected on this call
+     */
+    bool update(Channel channel, double amps, double rpm, int power, uint32_t nowMs);
+    
+    /**
+     * Approximate balls in the robot (0 to capacity)
+     */
+    int getCount() const;
+    int getCapacity() const;
+    bool isFull() const;
+    
+    /**
+     * Balls detected on a motor since the last reset()
+     */
+    int getDetectionCount(Channel channel) const;
+    
+    /**
+     * Latest matched filter output for a motor (for tuning DETECT_THRESHOLD)
+     */
+    double getScore(Channel channel) const;
+    
+private:
+    /**
+     * One motor's recent readings
+     */
+    struct ChannelState {
+        double signal[WINDOW];  // Ring buffer of current bump + speed dip, one per slot
+        int next;               // Where the next slot goes
+        int filled;
+        uint32_t slot;          // Slot being filled (SAMPLE_MS steps since runningSinceMs)
+        double slotSum;         // Readings in it so far
+        int slotReadings;
+        int direction;          // Sign of the commanded power
+        int power;              // Commanded power at the last update
+        bool settling;          // Waiting for the speed to settle after a step
+        uint32_t settleStartMs;
+        bool settleHasValue;    // settleValue/settleSlot are valid
+        double settleValue;     // Last finished slot while settling
+        uint32_t settleSlot;
+        uint32_t runningSinceMs;
+        uint32_t lastDetectMs;
+        bool detected;          // Has ever detected (lastDetectMs is valid)
+        double score;
+        double lastScore;
+        int detections;
+    };
+    
+    double weights[WINDOW];   // Matched filter (zero mean, unit length)
+    ChannelState channels[CHANNEL_COUNT];
+    int capacity;
+    int count;
+    bool wheelFeeding;
+    
+    /**
+     * Forget a motor's readings (it stopped or changed direction)
+     */
+    void restart(ChannelState& state, int power, uint32_t nowMs);
+    
+    /**
+     * Check a finished slot while settling after a step; once settled, moves the window's
+     * readings to the new level
+     * 
+     * @return true if settled (the slot goes into the window)
+     */
+    bool settle(ChannelState& state, double value, uint32_t nowMs);
+    
+    /**
+     * Add a finished slot to the window and look for a ball
+     * 
+     * @return true if a ball was detected
+     */
+    bool addSlot(Channel channel, double value, uint32_t nowMs);
+    
+    /**
+     * Change the count by one ball, kept within 0 to capacity
+     */
+    void addBalls(int change);
+};
+
+#endif // BALLDETECTOR_H
@@ -0,0 +1,104 @@
+/*
+ * BallPursuit.cpp
+ * 
+ * Implementation of vision-guided ball pickup.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "BallPursuit.h"
+
+#include <cmath>
+
+#include "DriveTrain.h"
+
+BallPursuit::BallPursuit()
+    : status(IDLE),
+      startMs(0),
+      timeoutMs(0),
+      collectStartMs(0),
+      targetId(-1) {
+}
+
+void BallPursuit::start(uint32_t nowMs, uint32_t timeoutMs) {
+    status = SEARCHING;
+    startMs = nowMs;
+    this->timeoutMs = timeoutMs;
+    targetId = -1;
+}
+
+void BallPursuit::cancel() {
+    status = IDLE;
+    targetId = -1;
+}
+
+BallPursuit::Status BallPursuit::update(const VisionTracker& tracker, bool ballGrabbed, uint32_t nowMs,
+                                        int& leftPower, int& rightPower, IntakeController::MotorState& intake) {
+    leftPower = 0;
+    rightPower = 0;
+    intake = IntakeController::STOP;
+    if (!isRunning()) {
+        return status;
+    }
+    if (ballGrabbed) {
+        status = DONE;
+        return status;
+    }
+    if (nowMs - startMs >= timeoutMs) {
+        status = FAILED;
+        return status;
+    }
+    
+    intake = IntakeController::FORWARD;
+    const VisionTracker::Track* target = tracker.getTarget();
+    
+    // Close ball out of view: it is under the camera, keep driving over it
+    if (status == COLLECT && nowMs - collectStartMs < COLLECT_TIME_MS &&
+        (target == nullptr || target->id != targetId)) {
+        leftPower = COLLECT_POWER;
+        rightPower = COLLECT_POWER;
+        return status;
+    }
+    
+    if (target == nullptr) {
+        status = SEARCHING;
+        targetId = -1;
+        DriveTrain::calculateArcadeDrive(0, SEARCH_TURN_POWER, leftPower, rightPower);
+        return status;
+    }
+    
+    // Turn toward the ball, driving slower the further off-center it is
+    targetId = target->id;
+    double turn = target->bearingDeg * TURN_KP;
+    if (turn > MAX_TURN_POWER) {
+        turn = MAX_TURN_POWER;
+    } else if (turn < -MAX_TURN_POWER) {
+        turn = -MAX_TURN_POWER;
+    }
+    double alignment = 1.0 - std::fabs(target->bearingDeg) / FULL_TURN_BEARING_DEG;
+    if (alignment < 0.0) {
+        alignment = 0.0;
+    }
+    
+    int forwardPower = APPROACH_POWER;
+    if (target->distanceMm < COLLECT_DISTANCE_MM) {
+        status = COLLECT;
+        collectStartMs = nowMs;
+        forwardPower = COLLECT_POWER;
+    } else {
+        status = APPROACH;
+    }
+    DriveTrain::calculateArcadeDrive((int)(forwardPower * alignment), (int)turn, leftPower, rightPower);
+    return status;
+}
+
+BallPursuit::Status BallPursuit::getStatus() const {
+    return status;
+}
+
+bool BallPursuit::isRunning() const {
+    return status == SEARCHING || status == APPROACH || status == COLLECT;
+}
+
+int BallPursuit::getTargetId() const {
+    return targetId;
+}
@@ -0,0 +1,123 @@
+/*
+ * BallPursuit.h
+ * 
+ * This header defines the BallPursuit class, which drives autonomous to a ball the
+ * vision sensor can see and picks it up. It steers toward the VisionTracker's target
+ * (turning harder and driving slower the further off-center it is), runs the intake
+ * the whole way, and keeps driving forward for a moment after the ball disappears
+ * under the camera. If no ball is in view it turns slowly in place to look for one.
+ * 
+ * Works from an autonomous loop (one update() per vision frame).
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef BALLPURSUIT_H
+#define BALLPURSUIT_H
+
+#include <cstdint>
+
+#include "IntakeController.h"
+#include "VisionTracker.h"
+
+/**
+ * BallPursuit Class
+ * 
+ * Usage:
+ *   1. start() with a time limit
+ *   2. update() every vision frame with the tracker and whether a ball was just
+ *      grabbed (BallDetector); apply the returned drive powers and intake state
+ *   3. Stop when it returns DONE (ball picked up) or FAILED (time limit)
+ */
+class BallPursuit {
+public:
+    /**
+     * Where the pickup is
+     */
+    enum Status {
+        IDLE,        // Not running
+        SEARCHING,   // No ball in view, turning to look for one
+        APPROACH,    // Driving toward the target ball
+        COLLECT,     // Ball too close to see, driving over it with the intake on
+        DONE,        // Ball picked up (finished)
+        FAILED       // Time limit reached (finished)
+    };
+    
+    /**
+     * Steering: turn power per degree of bearing, and its limit (percent)
+     */
+    static constexpr double TURN_KP = 1.2;
+    static const int MAX_TURN_POWER = 40;
+    
+    /**
+     * Forward power far from the ball and close to it (percent)
+     */
+    static const int APPROACH_POWER = 55;
+    static const int COLLECT_POWER = 35;
+    
+    /**
+     * Forward power drops to 0 at this bearing (turn first, then drive)
+     */
+    static constexpr double FULL_TURN_BEARING_DEG = 40.0;
+    
+    /**
+     * Closer than this the ball is about to drop out of the bottom of the image (mm)
+     */
+    static constexpr double COLLECT_DISTANCE_MM = 600.0;
+    
+    /**
+     * Driving blind over a ball that left the view, before looking again (ms)
+     */
+    static const uint32_t COLLECT_TIME_MS = 1000;
+    
+    /**
+     * Turn power while searching (percent, clockwise)
+     */
+    static const int SEARCH_TURN_POWER = 25;
+    
+    BallPursuit();
+    
+    /**
+     * Start a pickup
+     * 
+     * @param nowMs Current time
+     * @param timeoutMs Give up after this long
+     */
+    void start(uint32_t nowMs, uint32_t timeoutMs);
+    
+    /**
+     * Stop without finishing (outputs go to 0)
+     */
+    void cancel();
+    
+    /**
+     * One control step
+     * 
+     * @param tracker Tracker after this frame's update()
+     * @param ballGrabbed A ball went into the intake since the last step
+     * @param nowMs Current time
+     * @param leftPower Left drive power (percent)
+     * @param rightPower Right drive power (percent)
+     * @param intake Intake state to apply
+     * @return Status after the step
+     */
+    Status update(const VisionTracker& tracker, bool ballGrabbed, uint32_t nowMs,
+                  int& leftPower, int& rightPower, IntakeController::MotorState& intake);
+    
+    Status getStatus() const;
+    bool isRunning() const;
+    
+    /**
+     * Id of the track being chased (-1 if none)
+     */
+    int getTargetId() const;
+    
+private:
+    Status status;
+    uint32_t startMs;
+    uint32_t timeoutMs;
+    uint32_t collectStartMs;
+    int targetId;
+};
+
+#endif // BALLPURSUIT_H
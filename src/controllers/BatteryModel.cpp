@@ -0,0 +1,94 @@
+/*
+ * BatteryModel.cpp
+ * 
+ * Implementation of the battery state-of-charge and internal-resistance model.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "BatteryModel.h"
+
+#include <cmath>
+
+BatteryModel::BatteryModel(double stateOfCharge)
+    : stateOfCharge(clampPercent(stateOfCharge)),
+      internalResistance(DEFAULT_RESISTANCE),
+      matchCount(0),
+      hasLastSample(false),
+      lastVolts(0.0),
+      lastAmps(0.0) {
+}
+
+double BatteryModel::clampPercent(double percent) {
+    if (percent < 0.0) {
+        return 0.0;
+    }
+    if (percent > 100.0) {
+        return 100.0;
+    }
+    return percent;
+}
+
+void BatteryModel::update(double terminalVolts, double amps, double dtSeconds) {
+    // Coulomb counting: amp-seconds drawn / (capacity in amp-seconds) = fraction used
+    if (dtSeconds > 0.0) {
+        double capacityAmpSeconds = CAPACITY_AMP_HOURS * 3600.0;
+        stateOfCharge = clampPercent(stateOfCharge - 100.0 * amps * dtSeconds / capacityAmpSeconds);
+    }
+    
+    // Resistance from a load step: more current -> more voltage sag
+    if (hasLastSample) {
+        double currentStep = amps - lastAmps;
+        if (std::fabs(currentStep) >= MIN_CURRENT_STEP) {
+            double measured = -(terminalVolts - lastVolts) / currentStep;
+            // Ignore physically impossible readings (noise, or a regen spike)
+            if (measured > 0.0 && measured < 1.0) {
+                // Smooth: each step moves the estimate 20% of the way
+                internalResistance += 0.2 * (measured - internalResistance);
+            }
+        }
+    }
+    hasLastSample = true;
+    lastVolts = terminalVolts;
+    lastAmps = amps;
+}
+
+double BatteryModel::getStateOfCharge() const {
+    return stateOfCharge;
+}
+
+double BatteryModel::getInternalResistance() const {
+    return internalResistance;
+}
+
+double BatteryModel::getOpenCircuitVoltage() const {
+    return lastVolts + lastAmps * internalResistance;
+}
+
+BatteryModel::State BatteryModel::getState() const {
+    State state;
+    state.stateOfCharge = stateOfCharge;
+    state.internalResistance = internalResistance;
+    state.matchCount = matchCount;
+    return state;
+}
+
+bool BatteryModel::restore(const State& saved, double brainCapacityPercent) {
+    bool sameBattery = std::fabs(saved.stateOfCharge - brainCapacityPercent) <= SAME_BATTERY_TOLERANCE &&
+                       saved.internalResistance > 0.0 && saved.matchCount >= 0;
+    if (sameBattery) {
+        stateOfCharge = clampPercent(saved.stateOfCharge);
+        internalResistance = saved.internalResistance;
+        matchCount = saved.matchCount;
+    } else {
+        // Different battery (or garbage on the SD card): start over
+        stateOfCharge = clampPercent(brainCapacityPercent);
+        internalResistance = DEFAULT_RESISTANCE;
+        matchCount = 0;
+    }
+    hasLastSample = false;
+    return sameBattery;
+}
+
+void BatteryModel::startMatch() {
+    matchCount++;
+}
@@ -0,0 +1,121 @@
+/*
+ * BatteryModel.h
+ * 
+ * This header defines the BatteryModel class, which tracks the V5 battery's
+ * state of charge and internal resistance across matches.
+ * 
+ * - State of charge: counts the charge drawn (amp-seconds) against the battery capacity
+ * - Internal resistance: whenever the current changes a lot, the voltage sag tells us
+ *   the resistance (R = -dV / dI). A tired battery has a higher resistance and sags more
+ *   under load - those are the batteries to swap out before eliminations.
+ * 
+ * No hardware dependencies - main.cpp passes in Brain.Battery readings.
+ */
+
+#ifndef BATTERYMODEL_H
+#define BATTERYMODEL_H
+
+/**
+ * BatteryModel Class
+ * 
+ * Call update() every tick with the battery terminal voltage and current.
+ * getState() / restore() let main.cpp keep the model on the SD card between matches.
+ */
+class BatteryModel {
+public:
+    /**
+     * Saved battery state (plain data, safe to write to the SD card as bytes)
+     */
+    struct State {
+        double stateOfCharge;       // Percent (0-100)
+        double internalResistance;  // Ohms
+        int matchCount;             // Matches run on this battery since it was detected
+    };
+    
+    /**
+     * V5 battery capacity (1100 mAh)
+     */
+    static constexpr double CAPACITY_AMP_HOURS = 1.1;
+    
+    /**
+     * Starting resistance guess before any load steps are seen (ohms)
+     */
+    static constexpr double DEFAULT_RESISTANCE = 0.08;
+    
+    /**
+     * Smallest current change used to measure resistance (amps)
+     * Smaller steps are swamped by voltage measurement noise.
+     */
+    static constexpr double MIN_CURRENT_STEP = 2.0;
+    
+    /**
+     * How far the saved state of charge may differ from the Brain's own estimate
+     * before we decide a different battery was plugged in (percent)
+     */
+    static constexpr double SAME_BATTERY_TOLERANCE = 15.0;
+    
+    /**
+     * Create a model for a battery at a known state of charge
+     * 
+     * @param stateOfCharge Starting state of charge (percent, clamped to 0-100)
+     */
+    BatteryModel(double stateOfCharge = 100.0);
+    
+    /**
+     * Add one battery reading
+     * 
+     * @param terminalVolts Battery voltage (V)
+     * @param amps Battery current (A, positive = discharging)
+     * @param dtSeconds Time since the previous reading (seconds)
+     */
+    void update(double terminalVolts, double amps, double dtSeconds);
+    
+    /**
+     * Estimated state of charge (percent, 0-100)
+     */
+    double getStateOfCharge() const;
+    
+    /**
+     * Estimated internal resistance (ohms)
+     */
+    double getInternalResistance() const;
+    
+    /**
+     * Estimated voltage with no load (terminal voltage + current * resistance)
+     */
+    double getOpenCircuitVoltage() const;
+    
+    /**
+     * Current state, for saving between matches
+     */
+    State getState() const;
+    
+    /**
+     * Continue from a saved state if it still matches the battery plugged in
+     * 
+     * If the saved state of charge is far from what the Brain reports, a different
+     * battery is plugged in: start fresh from the Brain's estimate instead.
+     * 
+     * @param saved State loaded from the SD card
+     * @param brainCapacityPercent Brain.Battery.capacity() reading
+     * @return true if the saved state was used, false if a new battery was detected
+     */
+    bool restore(const State& saved, double brainCapacityPercent);
+    
+    /**
+     * Count one more match on this battery
+     */
+    void startMatch();
+    
+private:
+    static double clampPercent(double percent);
+    
+    double stateOfCharge;
+    double internalResistance;
+    int matchCount;
+    bool hasLastSample;
+    double lastVolts;
+    double lastAmps;
+};
+
+#endif // BATTERYMODEL_H
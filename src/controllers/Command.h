@@ -0,0 +1,154 @@
+/*
+ * Command.h
+ * 
+ * This header defines the Command interface used by the CommandScheduler, and
+ * FunctionCommand, a command built from plain functions.
+ * 
+ * A command is one thing the robot does (drive with the sticks, run a quick turn,
+ * recover from a tip). It says which subsystems it needs; the scheduler makes sure
+ * only one command owns each subsystem at a time.
+ * 
+ * Commands are created once (globals or statics) and scheduled by pointer, so
+ * scheduling never allocates memory.
+ */
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <cstdint>
+
+#include "ActuationFrame.h"
+
+/**
+ * Command Interface
+ * 
+ * Life of a command: initialize() once when scheduled, execute() every tick,
+ * then end() when isFinished() returns true (interrupted = false) or another
+ * command takes one of its subsystems (interrupted = true).
+ */
+class Command {
+public:
+    /**
+     * Subsystems a command can require (bit flags, combine with |)
+     */
+    enum Subsystem {
+        DRIVE = 1 << 0,      // Both drive sides
+        INTAKE = 1 << 1,     // Intake motor
+        RAMP = 1 << 2,       // Ramp motor (first two ramp wheels)
+        TOP_WHEEL = 1 << 3,  // Full power ramp motor
+        HEIGHT = 1 << 4      // Both pistons
+    };
+    
+    /**
+     * Number of subsystems
+     */
+    static const int SUBSYSTEM_COUNT = 5;
+    
+    virtual ~Command() {}
+    
+    /**
+     * Subsystems this command needs
+     * 
+     * @return Subsystem flags combined with |
+     */
+    virtual uint8_t getRequirements() const = 0;
+    
+    /**
+     * Whether another command may take this command's subsystems
+     * 
+     * @return true by default
+     */
+    virtual bool isInterruptible() const { return true; }
+    
+    /**
+     * Called once when the command is scheduled
+     */
+    virtual void initialize() {}
+    
+    /**
+     * Called every tick while scheduled
+     * Stage outputs only for the subsystems this command requires.
+     * 
+     * @param frame This tick's actuator commands
+     */
+    virtual void execute(ActuationFrame& frame) = 0;
+    
+    /**
+     * Checked after every execute()
+     * 
+     * @return true when the command is done (false by default - runs until interrupted)
+     */
+    virtual bool isFinished() { return false; }
+    
+    /**
+     * Called once when the command stops
+     * 
+     * @param interrupted true if cancelled or replaced, false if it finished
+     */
+    virtual void end(bool interrupted) { (void)interrupted; }
+};
+
+/**
+ * FunctionCommand Class
+ * 
+ * A command made from plain functions, for robot code that is written as functions
+ * (like the phase hooks). Any function except execute may be nullptr.
+ */
+class FunctionCommand : public Command {
+public:
+    typedef void (*InitializeFunction)();
+    typedef void (*ExecuteFunction)(ActuationFrame& frame);
+    typedef bool (*FinishedFunction)();
+    typedef void (*EndFunction)(bool interrupted);
+    
+    /**
+     * Create a command
+     * 
+     * @param requirements Subsystem flags combined with |
+     * @param executeFunction Runs every tick
+     * @param finishedFunction Returns true when done (nullptr = runs until interrupted)
+     * @param initializeFunction Runs when scheduled (nullptr = nothing)
+     * @param endFunction Runs when stopped (nullptr = nothing)
+     * @param interruptible false = nothing can take its subsystems until it finishes
+     */
+    FunctionCommand(uint8_t requirements, ExecuteFunction executeFunction,
+                    FinishedFunction finishedFunction = nullptr,
+                    InitializeFunction initializeFunction = nullptr,
+                    EndFunction endFunction = nullptr, bool interruptible = true)
+        : requirements(requirements), executeFunction(executeFunction),
+          finishedFunction(finishedFunction), initializeFunction(initializeFunction),
+          endFunction(endFunction), interruptible(interruptible) {}
+    
+    uint8_t getRequirements() const override { return requirements; }
+    bool isInterruptible() const override { return interruptible; }
+    
+    void initialize() override {
+        if (initializeFunction != nullptr) {
+            initializeFunction();
+        }
+    }
+    
+    void execute(ActuationFrame& frame) override {
+        executeFunction(frame);
+    }
+    
+    bool isFinished() override {
+        return (finishedFunction != nullptr) && finishedFunction();
+    }
+    
+    void end(bool interrupted) override {
+        if (endFunction != nullptr) {
+            endFunction(interrupted);
+        }
+    }
+    
+private:
+    uint8_t requirements;
+    ExecuteFunction executeFunction;
+    FinishedFunction finishedFunction;
+    InitializeFunction initializeFunction;
+    EndFunction endFunction;
+    bool interruptible;
+};
+
+#endif // COMMAND_H
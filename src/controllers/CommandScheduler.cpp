@@ -0,0 +1,164 @@
+/*
+ * CommandScheduler.cpp
+ * 
+ * Implementation of the command scheduler.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "CommandScheduler.h"
+
+CommandScheduler::CommandScheduler() : scheduledCount(0) {
+    for (int i = 0; i < MAX_SCHEDULED; i++) {
+        scheduled[i] = nullptr;
+    }
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        owners[i] = nullptr;
+        defaults[i] = nullptr;
+    }
+}
+
+bool CommandScheduler::setDefaultCommand(Command::Subsystem subsystem, Command* command) {
+    int index = subsystemIndex(subsystem);
+    if (index < 0) {
+        return false;
+    }
+    if (command != nullptr && (command->getRequirements() & subsystem) == 0) {
+        return false;  // A default must own the subsystem it fills
+    }
+    defaults[index] = command;
+    return true;
+}
+
+bool CommandScheduler::schedule(Command* command) {
+    if (command == nullptr) {
+        return false;
+    }
+    if (indexOf(command) >= 0) {
+        return true;
+    }
+    
+    uint8_t requirements = command->getRequirements();
+    
+    // Refuse if any owner can't be interrupted (checked before interrupting anything)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if ((requirements & (1 << i)) && owners[i] != nullptr && !owners[i]->isInterruptible()) {
+            return false;
+        }
+    }
+    
+    // Interrupt the current owners (one command may own several of the subsystems)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if ((requirements & (1 << i)) && owners[i] != nullptr) {
+            remove(indexOf(owners[i]), true);
+        }
+    }
+    
+    if (scheduledCount >= MAX_SCHEDULED) {
+        return false;
+    }
+    
+    scheduled[scheduledCount++] = command;
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (requirements & (1 << i)) {
+            owners[i] = command;
+        }
+    }
+    command->initialize();
+    return true;
+}
+
+void CommandScheduler::cancel(Command* command) {
+    int index = indexOf(command);
+    if (index >= 0) {
+        remove(index, true);
+    }
+}
+
+void CommandScheduler::cancelAll() {
+    while (scheduledCount > 0) {
+        remove(scheduledCount - 1, true);
+    }
+}
+
+void CommandScheduler::run(ActuationFrame& frame) {
+    // Defaults fill free subsystems (only if everything they need is free)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        Command* fallback = defaults[i];
+        if (owners[i] == nullptr && fallback != nullptr &&
+            (fallback->getRequirements() & getOwnedMask()) == 0) {
+            schedule(fallback);
+        }
+    }
+    
+    // Execute in the order scheduled
+    for (int i = 0; i < scheduledCount; i++) {
+        scheduled[i]->execute(frame);
+    }
+    
+    // End the finished ones
+    int i = 0;
+    while (i < scheduledCount) {
+        if (scheduled[i]->isFinished()) {
+            remove(i, false);
+        } else {
+            i++;
+        }
+    }
+}
+
+bool CommandScheduler::isScheduled(const Command* command) const {
+    return indexOf(command) >= 0;
+}
+
+Command* CommandScheduler::getOwner(Command::Subsystem subsystem) const {
+    int index = subsystemIndex(subsystem);
+    return (index >= 0) ? owners[index] : nullptr;
+}
+
+int CommandScheduler::getScheduledCount() const {
+    return scheduledCount;
+}
+
+void CommandScheduler::remove(int index, bool interrupted) {
+    Command* command = scheduled[index];
+    for (int i = index; i < scheduledCount - 1; i++) {
+        scheduled[i] = scheduled[i + 1];
+    }
+    scheduledCount--;
+    scheduled[scheduledCount] = nullptr;
+    
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (owners[i] == command) {
+            owners[i] = nullptr;
+        }
+    }
+    command->end(interrupted);
+}
+
+int CommandScheduler::indexOf(const Command* command) const {
+    for (int i = 0; i < scheduledCount; i++) {
+        if (scheduled[i] == command) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint8_t CommandScheduler::getOwnedMask() const {
+    uint8_t mask = 0;
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (owners[i] != nullptr) {
+            mask |= (1 << i);
+        }
+    }
+    return mask;
+}
+
+int CommandScheduler::subsystemIndex(Command::Subsystem subsystem) {
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (subsystem == (1 << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
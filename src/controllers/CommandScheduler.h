@@ -0,0 +1,112 @@
+/*
+ * CommandScheduler.h
+ * 
+ * This header defines the CommandScheduler class, which decides each tick which
+ * command drives each subsystem (Drive, Intake, Ramp, TopWheel, Height).
+ * 
+ * - Each subsystem is owned by at most one command.
+ * - Scheduling a command interrupts the commands that own its subsystems, unless
+ *   one of them is not interruptible (then the new command is refused).
+ * - A subsystem nobody owns runs its default command (e.g. the driver's sticks).
+ * 
+ * Fixed-size arrays only: nothing is allocated while scheduling or running.
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef COMMANDSCHEDULER_H
+#define COMMANDSCHEDULER_H
+
+#include <cstdint>
+
+#include "Command.h"
+#include "ActuationFrame.h"
+
+/**
+ * CommandScheduler Class
+ * 
+ * Usage (each tick):
+ *   1. schedule() / cancel() commands in response to buttons or events
+ *   2. run(frame) - default commands fill free subsystems, every command executes
+ *   3. frame.apply() to write the outputs
+ */
+class CommandScheduler {
+public:
+    /**
+     * Most commands scheduled at once
+     */
+    static const int MAX_SCHEDULED = 8;
+    
+    /**
+     * Create an empty scheduler (no commands, no defaults)
+     */
+    CommandScheduler();
+    
+    /**
+     * Set the command that runs when nothing else owns a subsystem
+     * 
+     * @param subsystem The subsystem
+     * @param command Default command (must require the subsystem), nullptr = none
+     * @return true if set
+     */
+    bool setDefaultCommand(Command::Subsystem subsystem, Command* command);
+    
+    /**
+     * Start a command, interrupting the owners of its subsystems
+     * Scheduling a command that is already running does nothing.
+     * Don't call from inside a command's execute().
+     * 
+     * @param command The command
+     * @return true if it is running, false if refused (non-interruptible owner or full)
+     */
+    bool schedule(Command* command);
+    
+    /**
+     * Stop a command (end() is called with interrupted = true)
+     * 
+     * @param command The command (ignored if not running)
+     */
+    void cancel(Command* command);
+    
+    /**
+     * Stop every command, interruptible or not
+     */
+    void cancelAll();
+    
+    /**
+     * One tick: start defaults on free subsystems, execute every command,
+     * end the finished ones
+     * 
+     * @param frame This tick's actuator commands
+     */
+    void run(ActuationFrame& frame);
+    
+    /**
+     * Check if a command is running
+     */
+    bool isScheduled(const Command* command) const;
+    
+    /**
+     * Command that owns a subsystem
+     * 
+     * @return The owner, or nullptr if free
+     */
+    Command* getOwner(Command::Subsystem subsystem) const;
+    
+    /**
+     * Number of commands running
+     */
+    int getScheduledCount() const;
+    
+private:
+    Command* scheduled[MAX_SCHEDULED];
+    int scheduledCount;
+    Command* owners[Command::SUBSYSTEM_COUNT];
+    Command* defaults[Command::SUBSYSTEM_COUNT];
+    
+    void remove(int index, bool interrupted);
+    int indexOf(const Command* command) const;
+    uint8_t getOwnedMask() const;
+    static int subsystemIndex(Command::Subsystem subsystem);
+};
+
+#endif // COMMANDSCHEDULER_H
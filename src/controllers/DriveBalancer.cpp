@@ -0,0 +1,182 @@
+/*
+ * DriveBalancer.cpp
+ * 
+ * Implementation of per-motor drive command distribution.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "DriveBalancer.h"
+
+#include <cmath>
+#include <cstdlib>
+
+DriveBalancer::DriveBalancer() {
+    reset();
+}
+
+void DriveBalancer::reset() {
+    for (int side = 0; side < SIDE_COUNT; side++) {
+        for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+            shares[side][i] = 1.0;
+        }
+    }
+}
+
+void DriveBalancer::update(Side side, int sidePower, const MotorReading readings[MOTORS_PER_SIDE],
+                           double dtSeconds, int powers[MOTORS_PER_SIDE]) {
+    double* share = shares[side];
+    
+    // Barely driving: nothing useful to measure, drift back to an even split
+    if (std::abs(sidePower) < MIN_BALANCE_POWER) {
+        double relax = std::fmin(1.0, dtSeconds / RELAX_SECONDS);
+        for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+            share[i] += (1.0 - share[i]) * relax;
+            powers[i] = sidePower;
+        }
+        return;
+    }
+    
+    // Speeds and currents in the commanded direction
+    double direction = (sidePower > 0) ? 1.0 : -1.0;
+    double speed[MOTORS_PER_SIDE];
+    double current[MOTORS_PER_SIDE];
+    double slowest = 0.0;
+    double meanTemperature = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        speed[i] = direction * readings[i].rpm;
+        current[i] = direction * readings[i].currentA;
+        if (i == 0 || speed[i] < slowest) {
+            slowest = speed[i];
+        }
+        meanTemperature += readings[i].temperatureC / MOTORS_PER_SIDE;
+    }
+    
+    // Slip: faster than the slowest wheel (which is the one most likely gripping)
+    double slip[MOTORS_PER_SIDE];
+    bool slipping[MOTORS_PER_SIDE];
+    bool anySlipping = false;
+    double grippingCurrent = 0.0;
+    double grippingTemperature = 0.0;
+    int grippingCount = 0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        slip[i] = (speed[i] - slowest) / std::fmax(slowest, MIN_SLIP_RPM) - SLIP_RATIO;
+        slipping[i] = slip[i] > 0.0;
+        anySlipping = anySlipping || slipping[i];
+        if (!slipping[i]) {
+            grippingCurrent += current[i];
+            grippingTemperature += readings[i].temperatureC;
+            grippingCount++;
+        }
+    }
+    grippingCurrent /= grippingCount;  // At least the slowest wheel grips
+    grippingTemperature /= grippingCount;
+    double scale = std::fmax(std::fabs(grippingCurrent), MIN_BALANCE_AMPS);
+    
+    // Largest share a motor can use before its power clamps at 100
+    double fullShare = std::fmin(MAX_SHARE, 100.0 / std::abs(sidePower));
+    
+    // Current and temperature: effort moves between gripping motors, from the most loaded
+    // and hottest to the others, and only to motors that can still take more (zero sum)
+    double error[MOTORS_PER_SIDE];
+    double meanError = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        error[i] = 0.0;
+        if (!slipping[i]) {
+            error[i] = CURRENT_GAIN * (current[i] - grippingCurrent) / scale +
+                       TEMPERATURE_GAIN * (readings[i].temperatureC - grippingTemperature) / TEMPERATURE_SCALE_C;
+            meanError += error[i] / grippingCount;
+        }
+    }
+    double change[MOTORS_PER_SIDE];
+    double given = 0.0;
+    double taken = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        change[i] = slipping[i] ? 0.0 : -ADAPT_RATE * dtSeconds * (error[i] - meanError);
+        if (change[i] > 0.0 && share[i] >= fullShare) {
+            change[i] = 0.0;
+        }
+        if (change[i] > 0.0) {
+            taken += change[i];
+        } else {
+            given -= change[i];
+        }
+    }
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (change[i] > 0.0 && taken > given) {
+            change[i] *= given / taken;
+        } else if (change[i] < 0.0 && given > taken) {
+            change[i] *= taken / given;
+        }
+    }
+    
+    // Slipping wheels shed effort (it only spins them faster). Gripping motors with room
+    // get it; the rest is dropped, and comes back once nothing slips.
+    double shed = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (slipping[i]) {
+            double drop = std::fmin(share[i] - MIN_SHARE, ADAPT_RATE * dtSeconds * SLIP_GAIN * std::fmin(slip[i], 1.0));
+            drop = std::fmax(0.0, drop);
+            change[i] -= drop;
+            shed += drop;
+        }
+    }
+    double total = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        total += share[i] + change[i];
+    }
+    if (!anySlipping && total < MOTORS_PER_SIDE) {
+        shed += (MOTORS_PER_SIDE - total) * std::fmin(1.0, dtSeconds / RELAX_SECONDS);
+    }
+    int roomCount = 0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (!slipping[i] && share[i] + change[i] < fullShare) {
+            roomCount++;
+        }
+    }
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (!slipping[i] && share[i] + change[i] < fullShare) {
+            change[i] += std::fmin(shed / roomCount, fullShare - share[i] - change[i]);
+        }
+    }
+    
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        share[i] = std::fmin(MAX_SHARE, std::fmax(MIN_SHARE, share[i] + change[i]));
+    }
+    
+    distribute(sidePower, share, powers);
+}
+
+double DriveBalancer::getShare(Side side, int motor) const {
+    return shares[side][motor];
+}
+
+void DriveBalancer::distribute(int sidePower, const double shares[MOTORS_PER_SIDE],
+                               int powers[MOTORS_PER_SIDE]) {
+    double power[MOTORS_PER_SIDE];
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        power[i] = sidePower * shares[i];
+    }
+    
+    // A motor can't do more than 100%: what a share asks past that is lost, not handed
+    // back to a wheel that was shedding effort
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        power[i] = std::fmax(-100.0, std::fmin(100.0, power[i]));
+    }
+    
+    // Round, then hand out what rounding lost so the total matches the side command
+    int total = 0;
+    double target = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        powers[i] = (int)std::lround(power[i]);
+        total += powers[i];
+        target += power[i];
+    }
+    int remainder = (int)std::lround(target) - total;
+    for (int i = 0; i < MOTORS_PER_SIDE && remainder != 0; i++) {
+        int step = (remainder > 0) ? 1 : -1;
+        if (std::abs(powers[i] + step) <= 100) {
+            powers[i] += step;
+            remainder -= step;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * DriveBalancer.h
+ * 
+ * This header defines the DriveBalancer class, which splits each drive side's command
+ * between its three motors (front, middle, back) instead of sending all three the same
+ * power. With the same command, the motor whose wheel carries the load (e.g. the middle
+ * drop-center wheel in a turn) hits its current limit while the others coast, and a
+ * wheel that has lost traction just spins.
+ * 
+ * Each motor gets a share of the side's command (1.0 = an even split). Shares move,
+ * a little every tick, away from:
+ *   - wheels that are slipping (turning faster than the side's slowest wheel)
+ *   - motors drawing more current than the side's other gripping motors
+ *   - motors hotter than the others on their side
+ * and toward the rest. Effort moved for current or temperature is taken from one motor
+ * and given to another that can still take more, so the side's total commanded effort
+ * stays the same. Effort a slipping wheel sheds goes to the gripping motors; if they are
+ * already at 100% it is dropped until the wheel grips again (it was only spinning the
+ * wheel faster).
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef DRIVEBALANCER_H
+#define DRIVEBALANCER_H
+
+/**
+ * DriveBalancer Class
+ * 
+ * Usage (once per control tick, after the drive command is known):
+ *   1. update() for each side with its command and its motors' readings
+ *   2. Write the returned per-motor powers instead of the side command
+ */
+class DriveBalancer {
+public:
+    /**
+     * Drive sides
+     */
+    enum Side {
+        LEFT,
+        RIGHT,
+        SIDE_COUNT
+    };
+    
+    /**
+     * Motors per side (front, middle, back)
+     */
+    static const int MOTORS_PER_SIDE = 3;
+    
+    /**
+     * One motor's measurements
+     */
+    struct MotorReading {
+        double currentA;      // Current draw (amps, signed like the motor's power)
+        double temperatureC;  // Motor temperature (celsius)
+        double rpm;           // Measured speed (signed)
+    };
+    
+    /**
+     * Limits on a motor's share of its side's command (1.0 = even split; a share is
+     * never raised past what takes the motor to 100%)
+     */
+    static constexpr double MIN_SHARE = 0.2;
+    static constexpr double MAX_SHARE = 1.6;
+    
+    /**
+     * Share change per second per unit of imbalance
+     */
+    static constexpr double ADAPT_RATE = 1.5;
+    
+    /**
+     * Weights of the three imbalances
+     */
+    static constexpr double SLIP_GAIN = 4.0;         // Per unit of slip past SLIP_RATIO
+    static constexpr double CURRENT_GAIN = 1.0;      // Per unit of (current - mean) / mean
+    static constexpr double TEMPERATURE_GAIN = 1.0;  // Per TEMPERATURE_SCALE_C above the mean
+    
+    /**
+     * A wheel turning this much faster than the side's slowest wheel is slipping
+     */
+    static constexpr double SLIP_RATIO = 0.05;
+    
+    /**
+     * Below this side speed (rpm) slip isn't measured (too slow to tell)
+     */
+    static constexpr double MIN_SLIP_RPM = 15.0;
+    
+    /**
+     * Currents are compared relative to the side's mean, but never to less than this (amps)
+     */
+    static constexpr double MIN_BALANCE_AMPS = 0.5;
+    
+    /**
+     * Temperature difference that counts as one unit of imbalance (celsius)
+     */
+    static constexpr double TEMPERATURE_SCALE_C = 10.0;
+    
+    /**
+     * Side commands smaller than this (percent) are passed through unchanged, and the
+     * shares drift back to even with this time constant (seconds)
+     */
+    static const int MIN_BALANCE_POWER = 5;
+    static constexpr double RELAX_SECONDS = 0.5;
+    
+    /**
+     * Constructor: every share even
+     */
+    DriveBalancer();
+    
+    /**
+     * Back to an even split on both sides
+     */
+    void reset();
+    
+    /**
+     * Split one side's command for this tick
+     * 
+     * @param side Which side
+     * @param sidePower Side command (-100 to 100)
+     * @param readings Front, middle, back motor readings
+     * @param dtSeconds Time since the last update of this side
+     * @param powers Output: front, middle, back powers (-100 to 100); they add up to
+     *               3 x sidePower unless a slipping wheel's effort had nowhere to go
+     */
+    void update(Side side, int sidePower, const MotorReading readings[MOTORS_PER_SIDE],
+                double dtSeconds, int powers[MOTORS_PER_SIDE]);
+    
+    /**
+     * Current share of a motor (1.0 = even split)
+     */
+    double getShare(Side side, int motor) const;
+    
+    /**
+     * Split a side command by shares, keeping the total (rounding included); powers
+     * past +/-100 are clamped
+     * 
+     * @param sidePower Side command (-100 to 100)
+     * @param shares Shares (adding up to MOTORS_PER_SIDE)
+     * @param powers Output: motor powers
+     */
+    static void distribute(int sidePower, const double shares[MOTORS_PER_SIDE], int powers[MOTORS_PER_SIDE]);
+    
+private:
+    double shares[SIDE_COUNT][MOTORS_PER_SIDE];
+};
+
+#endif // DRIVEBALANCER_H
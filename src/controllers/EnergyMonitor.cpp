@@ -0,0 +1,81 @@
+/*
+ * EnergyMonitor.cpp
+ * 
+ * Implementation of per-subsystem energy accounting.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "EnergyMonitor.h"
+
+#include <cmath>
+
+EnergyMonitor::EnergyMonitor() {
+    reset();
+}
+
+double EnergyMonitor::electricalPower(double volts, double amps) {
+    return std::fabs(volts) * std::fabs(amps);
+}
+
+bool EnergyMonitor::isValid(Subsystem subsystem) {
+    // Bounds check before using the enum as an array index
+    return subsystem >= 0 && subsystem < SUBSYSTEM_COUNT;
+}
+
+void EnergyMonitor::addMotorSample(Subsystem subsystem, double volts, double amps) {
+    if (!isValid(subsystem)) {
+        return;
+    }
+    tickPower[subsystem] += electricalPower(volts, amps);
+}
+
+void EnergyMonitor::endTick(double dtSeconds) {
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        // Energy (J) = power (W) * time (s)
+        if (dtSeconds > 0.0) {
+            energy[i] += tickPower[i] * dtSeconds;
+        }
+        lastPower[i] = tickPower[i];
+        tickPower[i] = 0.0;
+    }
+}
+
+double EnergyMonitor::getEnergy(Subsystem subsystem) const {
+    return isValid(subsystem) ? energy[subsystem] : 0.0;
+}
+
+double EnergyMonitor::getTotalEnergy() const {
+    double total = 0.0;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        total += energy[i];
+    }
+    return total;
+}
+
+double EnergyMonitor::getShare(Subsystem subsystem) const {
+    double total = getTotalEnergy();
+    if (total <= 0.0) {
+        return 0.0;
+    }
+    return getEnergy(subsystem) / total;
+}
+
+double EnergyMonitor::getPower(Subsystem subsystem) const {
+    return isValid(subsystem) ? lastPower[subsystem] : 0.0;
+}
+
+double EnergyMonitor::getTotalPower() const {
+    double total = 0.0;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        total += lastPower[i];
+    }
+    return total;
+}
+
+void EnergyMonitor::reset() {
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        energy[i] = 0.0;
+        tickPower[i] = 0.0;
+        lastPower[i] = 0.0;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * EnergyMonitor.h
+ * 
+ * This header defines the EnergyMonitor class, which adds up how much electrical energy
+ * each subsystem (drive, intake, ramp, full power ramp) uses during a match.
+ * Knowing where the battery goes lets us budget aggressive features.
+ * 
+ * No hardware dependencies - main.cpp reads motor voltage and current and passes them in.
+ */
+
+#ifndef ENERGYMONITOR_H
+#define ENERGYMONITOR_H
+
+/**
+ * EnergyMonitor Class
+ * 
+ * Usage every control tick:
+ *   1. addMotorSample() once per motor
+ *   2. endTick() once, with the time since the last tick
+ */
+class EnergyMonitor {
+public:
+    /**
+     * Subsystems energy is tracked for
+     */
+    enum Subsystem {
+        DRIVE = 0,            // 6 drive motors
+        INTAKE = 1,           // Intake motor (5.5W)
+        RAMP = 2,             // First two ramp wheels (5.5W)
+        FULL_POWER_RAMP = 3,  // Final ramp wheel (11W)
+        SUBSYSTEM_COUNT = 4
+    };
+    
+    EnergyMonitor();
+    
+    /**
+     * Electrical power drawn by a motor
+     * 
+     * Pure function: power = |voltage| * |current|. The sign of the voltage only says
+     * which way the motor spins - either way the battery supplies the power.
+     * 
+     * @param volts Voltage applied to the motor (V, may be negative)
+     * @param amps Motor current (A)
+     * @return Power in watts (always >= 0)
+     */
+    static double electricalPower(double volts, double amps);
+    
+    /**
+     * Add one motor's reading to this tick
+     * 
+     * @param subsystem Subsystem the motor belongs to
+     * @param volts Applied voltage (V)
+     * @param amps Current (A)
+     */
+    void addMotorSample(Subsystem subsystem, double volts, double amps);
+    
+    /**
+     * Finish the tick: integrate this tick's power over the elapsed time
+     * 
+     * @param dtSeconds Time since the previous tick (seconds, ignored if <= 0)
+     */
+    void endTick(double dtSeconds);
+    
+    /**
+     * Energy used by a subsystem since the last reset (joules)
+     */
+    double getEnergy(Subsystem subsystem) const;
+    
+    /**
+     * Energy used by all subsystems since the last reset (joules)
+     */
+    double getTotalEnergy() const;
+    
+    /**
+     * Fraction of the total energy used by a subsystem (0-1, 0 if nothing used yet)
+     */
+    double getShare(Subsystem subsystem) const;
+    
+    /**
+     * Power drawn by a subsystem during the last completed tick (watts)
+     */
+    double getPower(Subsystem subsystem) const;
+    
+    /**
+     * Power drawn by all subsystems during the last completed tick (watts)
+     */
+    double getTotalPower() const;
+    
+    /**
+     * Clear all totals (e.g. at the start of a match)
+     */
+    void reset();
+    
+private:
+    static bool isValid(Subsystem subsystem);
+    
+    double energy[SUBSYSTEM_COUNT];        // Joules since reset
+    double tickPower[SUBSYSTEM_COUNT];     // Watts being summed for the current tick
+    double lastPower[SUBSYSTEM_COUNT];     // Watts of the last completed tick
+};
+
+#endif // ENERGYMONITOR_H
@@ -0,0 +1,217 @@
+/*
+ * EventBus.h
+ * 
+ * This header defines EventChannel and EventBus, which carry events between tasks
+ * and subsystems without shared globals.
+ * 
+ * - EventChannel<Event>: one lock-free queue (SpscQueue) plus the functions that
+ *   subscribed to that event type.
+ * - EventBus<Channels...>: a fixed set of channels chosen at compile time.
+ *   publish(event) picks the channel from the event's type; publishing a type the
+ *   bus doesn't carry is a compile error, not a runtime lookup.
+ * 
+ * Publishing only queues the event. Handlers run when the consumer calls
+ * dispatch() - once per control tick - so they never run in the middle of a tick
+ * or inside another task.
+ * 
+ * Each event type has one publishing task and one dispatching task (SpscQueue rules).
+ * Subscribe during initialization, before the tasks start. No memory allocation.
+ * Header only (template). No hardware dependencies, fully testable!
+ */
+
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include <cstdint>
+
+#include "SpscQueue.h"
+
+/**
+ * EventChannel Class
+ * 
+ * Queue and subscriber list for one event type.
+ * 
+ * @tparam Event The event struct
+ * @tparam CAPACITY Most events waiting between dispatches (power of two)
+ * @tparam MAX_SUBSCRIBERS Most subscribed handlers
+ */
+template <typename Event, uint32_t CAPACITY = 16, int MAX_SUBSCRIBERS = 4>
+class EventChannel {
+public:
+    typedef Event EventType;
+    
+    /**
+     * Called once per event during dispatch()
+     */
+    typedef void (*Handler)(const Event& event);
+    
+    /**
+     * Create a channel with no subscribers
+     */
+    EventChannel() : subscriberCount(0) {
+        for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+            subscribers[i] = nullptr;
+        }
+    }
+    
+    /**
+     * Add a handler (initialization only)
+     * 
+     * @param handler Function to call for each event
+     * @return false if the subscriber list is full
+     */
+    bool subscribe(Handler handler) {
+        if (handler == nullptr || subscriberCount >= MAX_SUBSCRIBERS) {
+            return false;
+        }
+        subscribers[subscriberCount++] = handler;
+        return true;
+    }
+    
+    /**
+     * Queue an event (publishing task only; never waits)
+     * 
+     * @param event The event
+     * @return false if the queue was full (the event is dropped and counted)
+     */
+    bool publish(const Event& event) {
+        return queue.push(event);
+    }
+    
+    /**
+     * Deliver every queued event to every subscriber, oldest first (dispatching task only)
+     * 
+     * @return Number of events delivered
+     */
+    int dispatch() {
+        int delivered = 0;
+        Event event;
+        while (queue.pop(event)) {
+            for (int i = 0; i < subscriberCount; i++) {
+                subscribers[i](event);
+            }
+            delivered++;
+        }
+        return delivered;
+    }
+    
+    /**
+     * Events waiting for dispatch()
+     */
+    uint32_t getPendingCount() const {
+        return queue.size();
+    }
+    
+    /**
+     * Events lost because the queue was full
+     */
+    uint32_t getDroppedCount() const {
+        return queue.getDroppedCount();
+    }
+    
+    /**
+     * Number of subscribed handlers
+     */
+    int getSubscriberCount() const {
+        return subscriberCount;
+    }
+    
+private:
+    SpscQueue<Event, CAPACITY> queue;
+    Handler subscribers[MAX_SUBSCRIBERS];
+    int subscriberCount;
+};
+
+/**
+ * EventBus Class
+ * 
+ * Usage:
+ *   typedef EventBus<EventChannel<JamEvent>, EventChannel<FaultEvent, 8> > RobotBus;
+ *   Init:             bus.subscribe<JamEvent>(onJam);
+ *   Publishing task:  bus.publish(JamEvent{...});
+ *   Each tick:        bus.dispatchAll();
+ * 
+ * @tparam Channels One EventChannel per event type (each type at most once)
+ */
+template <typename... Channels>
+class EventBus;
+
+/**
+ * Empty bus (end of the channel list)
+ */
+template <>
+class EventBus<> {
+public:
+    int dispatchAll() {
+        return 0;
+    }
+    
+    uint32_t getDroppedCount() const {
+        return 0;
+    }
+    
+protected:
+    void channelFor() {}
+};
+
+template <typename First, typename... Rest>
+class EventBus<First, Rest...> : private EventBus<Rest...> {
+public:
+    /**
+     * Add a handler for an event type (initialization only)
+     * 
+     * @return false if that channel's subscriber list is full
+     */
+    template <typename Event>
+    bool subscribe(void (*handler)(const Event& event)) {
+        return channelFor(static_cast<const Event*>(nullptr)).subscribe(handler);
+    }
+    
+    /**
+     * Queue an event on the channel for its type
+     * 
+     * @return false if that channel was full (event dropped)
+     */
+    template <typename Event>
+    bool publish(const Event& event) {
+        return channelFor(static_cast<const Event*>(nullptr)).publish(event);
+    }
+    
+    /**
+     * Deliver every queued event on every channel (channels in the order listed)
+     * 
+     * @return Number of events delivered
+     */
+    int dispatchAll() {
+        int delivered = first.dispatch();
+        return delivered + EventBus<Rest...>::dispatchAll();
+    }
+    
+    /**
+     * Events of one type waiting for dispatch
+     */
+    template <typename Event>
+    uint32_t getPendingCount() {
+        return channelFor(static_cast<const Event*>(nullptr)).getPendingCount();
+    }
+    
+    /**
+     * Events lost on every channel
+     */
+    uint32_t getDroppedCount() const {
+        return first.getDroppedCount() + EventBus<Rest...>::getDroppedCount();
+    }
+    
+protected:
+    // Overload per channel: the compiler picks the channel from the event pointer type
+    using EventBus<Rest...>::channelFor;
+    
+    First& channelFor(const typename First::EventType*) {
+        return first;
+    }
+    
+private:
+    First first;
+};
+
+#endif // EVENTBUS_H
@@ -0,0 +1,205 @@
+/*
+ * GoalAim.cpp
+ * 
+ * Implementation of vision and gyro goal aiming.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "GoalAim.h"
+
+#include <cmath>
+
+#include "DriveTrain.h"
+#include "Odometry.h"
+
+GoalAim::GoalAim(int goalSignature, uint32_t cameraLatencyMs)
+    : goalSignature(goalSignature),
+      cameraLatencyMs(cameraLatencyMs) {
+    reset();
+}
+
+void GoalAim::reset() {
+    newest = 0;
+    count = 0;
+    goalSeen = false;
+    goalHeading = 0.0;
+    goalSeenMs = 0;
+    active = false;
+    locked = false;
+    settling = false;
+    settledSinceMs = 0;
+}
+
+void GoalAim::addHeading(double heading, uint32_t nowMs) {
+    // Unwrap against the previous sample so the history is continuous across 0/360
+    double unwrapped = heading;
+    if (count > 0) {
+        double previous = sample(0).heading;
+        unwrapped = previous + Odometry::headingDifference(Odometry::wrapHeading(previous), heading);
+    }
+    
+    newest = (newest + 1) % HEADING_HISTORY;
+    history[newest].timeMs = nowMs;
+    history[newest].heading = unwrapped;
+    if (count < HEADING_HISTORY) {
+        count++;
+    }
+}
+
+bool GoalAim::addGoalFrame(const VisionTracker::Detection* detections, int detectionCount, uint32_t readMs) {
+    // The goal is the widest blob of its color (other robots' goals are further away)
+    int widest = -1;
+    for (int i = 0; i < detectionCount && i < VisionTracker::MAX_DETECTIONS; i++) {
+        const VisionTracker::Detection& d = detections[i];
+        if (d.signature != goalSignature || d.width < MIN_GOAL_WIDTH_PX) {
+            continue;
+        }
+        if (widest < 0 || d.width > detections[widest].width) {
+            widest = i;
+        }
+    }
+    if (widest < 0) {
+        return false;
+    }
+    
+    // Bearing in the frame + where the robot pointed when the frame was taken
+    double bearing = VisionTracker::bearingFromX(detections[widest].centerX);
+    double measured = Odometry::wrapHeading(headingAt(readMs - cameraLatencyMs) + bearing);
+    
+    if (!hasGoal(readMs)) {
+        goalHeading = measured;
+    } else {
+        goalHeading = Odometry::wrapHeading(goalHeading +
+                                            GOAL_SMOOTHING * Odometry::headingDifference(goalHeading, measured));
+    }
+    goalSeen = true;
+    goalSeenMs = readMs;
+    return true;
+}
+
+bool GoalAim::hasGoal(uint32_t nowMs) const {
+    return goalSeen && nowMs - goalSeenMs <= GOAL_TIMEOUT_MS;
+}
+
+double GoalAim::getGoalHeading() const {
+    return goalHeading;
+}
+
+double GoalAim::getHeadingError() const {
+    double heading = (count > 0) ? Odometry::wrapHeading(sample(0).heading) : 0.0;
+    return Odometry::headingDifference(heading, goalHeading);
+}
+
+double GoalAim::headingAt(uint32_t timeMs) const {
+    return Odometry::wrapHeading(unwrappedAt(timeMs));
+}
+
+double GoalAim::getTurnRate() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    uint32_t newestMs = sample(0).timeMs;
+    uint32_t fromMs = newestMs - RATE_WINDOW_MS;
+    uint32_t oldestMs = sample(count - 1).timeMs;
+    if (newestMs - oldestMs < RATE_WINDOW_MS) {
+        fromMs = oldestMs;  // Not enough history yet
+    }
+    if (fromMs == newestMs) {
+        return 0.0;
+    }
+    return (sample(0).heading - unwrappedAt(fromMs)) * 1000.0 / (double)(newestMs - fromMs);
+}
+
+void GoalAim::start() {
+    active = true;
+    locked = false;
+    settling = false;
+}
+
+bool GoalAim::update(uint32_t nowMs, int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!active) {
+        return false;
+    }
+    if (!hasGoal(nowMs)) {
+        // Nothing to aim at: hand the drive back
+        active = false;
+        locked = false;
+        return false;
+    }
+    
+    double error = getHeadingError();
+    double rate = getTurnRate();
+    
+    // Locked once on target and still for a moment; a bump past the wider band unlocks
+    if (locked) {
+        if (std::fabs(error) > UNLOCK_TOLERANCE_DEG) {
+            locked = false;
+            settling = false;
+        }
+    } else if (std::fabs(error) <= LOCK_TOLERANCE_DEG && std::fabs(rate) <= LOCK_RATE_DPS) {
+        if (!settling) {
+            settling = true;
+            settledSinceMs = nowMs;
+        }
+        if (nowMs - settledSinceMs >= LOCK_TIME_MS) {
+            locked = true;
+        }
+    } else {
+        settling = false;
+    }
+    
+    // PD on the heading error, with the gyro rate as the damping term
+    double power = TURN_KP * error - TURN_KD * rate;
+    if (std::fabs(error) > DEADBAND_DEG && std::fabs(power) < MIN_TURN_POWER) {
+        power = (error > 0.0) ? MIN_TURN_POWER : -MIN_TURN_POWER;
+    }
+    int turnPower = DriveTrain::clamp((int)std::lround(power), -MAX_TURN_POWER, MAX_TURN_POWER);
+    
+    // Turn in place (clockwise: left forward, right backward)
+    DriveTrain::calculateArcadeDrive(0, turnPower, leftPower, rightPower);
+    return true;
+}
+
+void GoalAim::cancel() {
+    active = false;
+    locked = false;
+    settling = false;
+}
+
+bool GoalAim::isActive() const {
+    return active;
+}
+
+bool GoalAim::isLocked() const {
+    return active && locked;
+}
+
+const GoalAim::HeadingSample& GoalAim::sample(int age) const {
+    return history[(newest - age + HEADING_HISTORY) % HEADING_HISTORY];
+}
+
+double GoalAim::unwrappedAt(uint32_t timeMs) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    if ((int32_t)(timeMs - sample(0).timeMs) >= 0) {
+        return sample(0).heading;
+    }
+    
+    // Newest sample at or before the time, interpolated toward the one after it
+    for (int age = 1; age < count; age++) {
+        const HeadingSample& before = sample(age);
+        if ((int32_t)(timeMs - before.timeMs) >= 0) {
+            const HeadingSample& after = sample(age - 1);
+            uint32_t span = after.timeMs - before.timeMs;
+            if (span == 0) {
+                return after.heading;
+            }
+            double fraction = (double)(timeMs - before.timeMs) / (double)span;
+            return before.heading + (after.heading - before.heading) * fraction;
+        }
+    }
+    return sample(count - 1).heading;  // Older than the history: oldest sample
+}
@@ -0,0 +1,214 @@
+/*
+ * GoalAim.h
+ * 
+ * This header defines the GoalAim class, which turns the robot in place to face the
+ * goal before a full power wheel shot. The vision sensor gives the goal's bearing in
+ * each frame; GoalAim adds it to the gyro heading the robot had when the frame was
+ * taken (the camera is a few tens of ms behind), which gives the goal's field heading.
+ * Between frames the heading error comes from the gyro alone, so the turn controller
+ * runs at the control rate instead of waiting for the camera.
+ * 
+ * Once the robot has been on target and still for a moment the aim is "locked" and
+ * the scoring pipeline can feed balls (ScoringProfile::holdForAim()).
+ * 
+ * Headings are compass style: degrees, clockwise positive (same as the inertial sensor).
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef GOALAIM_H
+#define GOALAIM_H
+
+#include <cstdint>
+
+#include "VisionTracker.h"
+
+/**
+ * GoalAim Class
+ * 
+ * Usage (once per control tick):
+ *   1. addHeading() with the gyro heading (every tick, aiming or not)
+ *   2. addGoalFrame() whenever a new vision frame is read
+ *   3. start(); then update() while it returns true, using its motor powers
+ *   4. isLocked() tells the scoring pipeline it can shoot
+ */
+class GoalAim {
+public:
+    /**
+     * Time from the vision sensor taking a frame to the program reading it (ms)
+     */
+    static const uint32_t DEFAULT_CAMERA_LATENCY_MS = 40;
+    
+    /**
+     * Gyro samples kept to look up the heading at a frame's capture time
+     * (one per control tick: 128 ms even at the fastest 2 ms driver tick)
+     */
+    static const int HEADING_HISTORY = 64;
+    
+    /**
+     * Goal blobs narrower than this (pixels) are noise
+     */
+    static const int MIN_GOAL_WIDTH_PX = 10;
+    
+    /**
+     * Weight of each new frame in the goal's heading
+     */
+    static constexpr double GOAL_SMOOTHING = 0.5;
+    
+    /**
+     * Goal not seen for this long (ms) = lost; the aim stops
+     */
+    static const uint32_t GOAL_TIMEOUT_MS = 300;
+    
+    /**
+     * Turn controller: power per degree of error, power per degree/second of turn
+     * rate (damping), and its limits (percent)
+     */
+    static constexpr double TURN_KP = 3.0;
+    static constexpr double TURN_KD = 0.16;
+    static const int MIN_TURN_POWER = 6;    // Overcomes friction for the last few degrees
+    static const int MAX_TURN_POWER = 80;
+    
+    /**
+     * Errors smaller than this (degrees) don't get MIN_TURN_POWER (the robot stops)
+     */
+    static constexpr double DEADBAND_DEG = 0.5;
+    
+    /**
+     * Locked when within LOCK_TOLERANCE_DEG and turning slower than LOCK_RATE_DPS
+     * for LOCK_TIME_MS; unlocks again past UNLOCK_TOLERANCE_DEG
+     */
+    static constexpr double LOCK_TOLERANCE_DEG = 1.5;
+    static constexpr double UNLOCK_TOLERANCE_DEG = 3.0;
+    static constexpr double LOCK_RATE_DPS = 15.0;
+    static const uint32_t LOCK_TIME_MS = 60;
+    
+    /**
+     * Turn rate is measured over this much gyro history (ms)
+     */
+    static const uint32_t RATE_WINDOW_MS = 30;
+    
+    /**
+     * Constructor
+     * 
+     * @param goalSignature Color signature of the goal
+     * @param cameraLatencyMs Frame age when it is read (0 = frames are current)
+     */
+    GoalAim(int goalSignature, uint32_t cameraLatencyMs = DEFAULT_CAMERA_LATENCY_MS);
+    
+    /**
+     * Forget the goal and the gyro history, and stop aiming
+     */
+    void reset();
+    
+    /**
+     * Record the gyro heading (every control tick)
+     * 
+     * @param heading Gyro heading (degrees)
+     * @param nowMs Time of the reading (must not go backwards)
+     */
+    void addHeading(double heading, uint32_t nowMs);
+    
+    /**
+     * Take the goal's bearing from a vision frame (widest blob of the goal's color)
+     * 
+     * @param detections Blobs in the frame
+     * @param detectionCount Number of blobs
+     * @param readMs Time the frame was read (it was taken cameraLatencyMs earlier)
+     * @return true if the goal was in the frame
+     */
+    bool addGoalFrame(const VisionTracker::Detection* detections, int detectionCount, uint32_t readMs);
+    
+    /**
+     * Goal seen recently enough to aim at
+     */
+    bool hasGoal(uint32_t nowMs) const;
+    
+    /**
+     * Field heading of the goal (degrees; only meaningful while hasGoal())
+     */
+    double getGoalHeading() const;
+    
+    /**
+     * Turn still needed to face the goal from the newest gyro heading
+     * (positive = clockwise)
+     */
+    double getHeadingError() const;
+    
+    /**
+     * Gyro heading at a past time, interpolated from the history
+     * (clamped to the oldest / newest sample)
+     */
+    double headingAt(uint32_t timeMs) const;
+    
+    /**
+     * Turn rate over the last RATE_WINDOW_MS (degrees per second, clockwise positive)
+     */
+    double getTurnRate() const;
+    
+    /**
+     * Start aiming (takes effect if the goal is in view)
+     */
+    void start();
+    
+    /**
+     * One control step (after addHeading() for this tick)
+     * 
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return true while aiming (use the powers), false when idle or the goal was lost
+     */
+    bool update(uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop aiming
+     */
+    void cancel();
+    
+    /**
+     * True while aiming
+     */
+    bool isActive() const;
+    
+    /**
+     * Aiming, on target and settled: safe to shoot
+     */
+    bool isLocked() const;
+    
+private:
+    /**
+     * One gyro sample (heading unwrapped, so interpolation never crosses 0/360)
+     */
+    struct HeadingSample {
+        uint32_t timeMs;
+        double heading;
+    };
+    
+    int goalSignature;
+    uint32_t cameraLatencyMs;
+    
+    HeadingSample history[HEADING_HISTORY];
+    int newest;   // Ring position of the newest sample
+    int count;
+    
+    bool goalSeen;
+    double goalHeading;
+    uint32_t goalSeenMs;
+    
+    bool active;
+    bool locked;
+    bool settling;
+    uint32_t settledSinceMs;
+    
+    /**
+     * History sample by age (0 = newest)
+     */
+    const HeadingSample& sample(int age) const;
+    
+    /**
+     * Unwrapped heading at a time (interpolated, clamped)
+     */
+    double unwrappedAt(uint32_t timeMs) const;
+};
+
+#endif // GOALAIM_H
@@ -0,0 +1,137 @@
+/*
+ * GpsFusion.cpp
+ * 
+ * Implementation of latency-compensated GPS + odometry fusion.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "GpsFusion.h"
+
+#include <cmath>
+
+GpsFusion::GpsFusion(double positionGain, double headingGain)
+    : currentPose{0.0, 0.0, 0.0},
+      positionGain(positionGain),
+      headingGain(headingGain),
+      headingOffset(0.0),
+      initialized(false),
+      rejectedFixCount(0),
+      outlierCount(0),
+      outlierErrorX(0.0),
+      outlierErrorY(0.0) {
+}
+
+void GpsFusion::reset(uint32_t timestampMs, const Odometry::Pose& pose, double rawHeading) {
+    history.clear();
+    currentPose = pose;
+    currentPose.heading = Odometry::wrapHeading(pose.heading);
+    
+    // From now on: field heading = raw inertial heading + offset
+    headingOffset = Odometry::headingDifference(rawHeading, currentPose.heading);
+    initialized = true;
+    rejectedFixCount = 0;
+    outlierCount = 0;
+    
+    PoseHistory::Entry entry = {timestampMs, currentPose, 0.0, rawHeading};
+    history.add(entry);
+}
+
+void GpsFusion::updateOdometry(uint32_t timestampMs, double forwardDistance, double rawHeading) {
+    currentPose = Odometry::integrate(currentPose, forwardDistance, rawHeading + headingOffset);
+    
+    // Keep the raw step too, so it can be replayed after a late GPS correction
+    PoseHistory::Entry entry = {timestampMs, currentPose, forwardDistance, rawHeading};
+    history.add(entry);
+}
+
+GpsFusion::FixResult GpsFusion::applyGpsFix(uint32_t measuredAtMs, const Odometry::Pose& gpsPose,
+                                            int quality) {
+    // Dropout: the GPS can't see enough of the field code strip
+    if (quality < MIN_GPS_QUALITY) {
+        rejectedFixCount++;
+        return REJECTED_LOW_QUALITY;
+    }
+    
+    // Find where odometry thought we were when the GPS took its measurement
+    int index = history.findAtOrBefore(measuredAtMs);
+    if (index < 0) {
+        rejectedFixCount++;
+        return REJECTED_TOO_OLD;
+    }
+    
+    // The fix usually lands between two history entries: interpolate the position
+    // so a fast-moving robot isn't corrected by up to a whole tick of travel
+    const PoseHistory::Entry& before = history.at(index);
+    Odometry::Pose predicted = before.pose;
+    if (index + 1 < history.size()) {
+        const PoseHistory::Entry& after = history.at(index + 1);
+        double span = static_cast<double>(after.timestampMs - before.timestampMs);
+        if (span > 0.0) {
+            double fraction = static_cast<double>(measuredAtMs - before.timestampMs) / span;
+            predicted.x += (after.pose.x - before.pose.x) * fraction;
+            predicted.y += (after.pose.y - before.pose.y) * fraction;
+        }
+    }
+    
+    double errorX = gpsPose.x - predicted.x;
+    double errorY = gpsPose.y - predicted.y;
+    double errorHeading = Odometry::headingDifference(predicted.heading, gpsPose.heading);
+    
+    // A huge jump means a bad reading, not a huge odometry error - unless the GPS keeps
+    // reporting the same jump: then the robot was moved and odometry missed it
+    bool recovering = false;
+    if (initialized && std::sqrt(errorX * errorX + errorY * errorY) > MAX_CORRECTION) {
+        double changeX = errorX - outlierErrorX;
+        double changeY = errorY - outlierErrorY;
+        bool agrees = outlierCount > 0 && std::sqrt(changeX * changeX + changeY * changeY) <= OUTLIER_AGREEMENT;
+        outlierCount = agrees ? outlierCount + 1 : 1;
+        outlierErrorX = errorX;
+        outlierErrorY = errorY;
+        if (outlierCount < OUTLIER_RECOVERY_COUNT) {
+            rejectedFixCount++;
+            return REJECTED_OUTLIER;
+        }
+        recovering = true;
+    }
+    outlierCount = 0;
+    
+    // The very first fix places the robot on the field, so take it completely (same for
+    // the position after a run of agreeing outliers)
+    double positionStep = (initialized && !recovering) ? positionGain : 1.0;
+    double headingStep = initialized ? headingGain : 1.0;
+    
+    // Correct the pose at measurement time
+    PoseHistory::Entry& corrected = history.at(index);
+    corrected.pose.x += errorX * positionStep;
+    corrected.pose.y += errorY * positionStep;
+    corrected.pose.heading = Odometry::wrapHeading(corrected.pose.heading + errorHeading * headingStep);
+    headingOffset += errorHeading * headingStep;
+    
+    // Replay every odometry step recorded after the measurement to reach the present
+    for (int i = index + 1; i < history.size(); i++) {
+        PoseHistory::Entry& entry = history.at(i);
+        entry.pose = Odometry::integrate(history.at(i - 1).pose, entry.forwardDistance,
+                                         entry.odometryHeading + headingOffset);
+    }
+    currentPose = history.at(history.size() - 1).pose;
+    
+    FixResult result = !initialized ? INITIALIZED : recovering ? RECOVERED : APPLIED;
+    initialized = true;
+    return result;
+}
+
+Odometry::Pose GpsFusion::getPose() const {
+    return currentPose;
+}
+
+bool GpsFusion::isInitialized() const {
+    return initialized;
+}
+
+int GpsFusion::getRejectedFixCount() const {
+    return rejectedFixCount;
+}
+
+const PoseHistory& GpsFusion::getHistory() const {
+    return history;
+}
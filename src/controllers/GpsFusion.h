@@ -0,0 +1,137 @@
+/*
+ * GpsFusion.h
+ * 
+ * This header defines the GpsFusion class, which combines drive odometry with the
+ * VEX GPS sensor.
+ * 
+ * Odometry is smooth and fast but drifts. The GPS knows the absolute field position but:
+ * - Its fixes arrive late (the pose it reports is where the robot was some time ago)
+ * - It drops out when the field code strip is blocked (near goals, other robots, walls)
+ * 
+ * GpsFusion keeps a PoseHistory, applies each GPS fix to the pose at the time the fix
+ * was MEASURED, and then replays the odometry recorded since then to bring the corrected
+ * pose back up to the present. No hardware dependencies - fully testable!
+ */
+
+#ifndef GPSFUSION_H
+#define GPSFUSION_H
+
+#include <cstdint>
+
+#include "Odometry.h"
+#include "PoseHistory.h"
+
+/**
+ * GpsFusion Class
+ * 
+ * Latency-compensated odometry + GPS localization.
+ * main.cpp calls updateOdometry() every localization tick and applyGpsFix() whenever
+ * the GPS has a new reading.
+ */
+class GpsFusion {
+public:
+    /**
+     * What happened to a GPS fix
+     */
+    enum FixResult {
+        APPLIED = 0,               // Fix blended into the pose history
+        INITIALIZED = 1,           // First fix: pose snapped to the GPS
+        REJECTED_LOW_QUALITY = 2,  // GPS quality below MIN_GPS_QUALITY (dropout)
+        REJECTED_TOO_OLD = 3,      // Fix is older than the whole pose history
+        REJECTED_OUTLIER = 4,      // Fix disagrees with odometry by more than MAX_CORRECTION
+        RECOVERED = 5              // OUTLIER_RECOVERY_COUNT outliers in a row agreed: pose re-snapped
+    };
+    
+    /**
+     * Lowest GPS quality (0-100) that is trusted
+     */
+    static const int MIN_GPS_QUALITY = 90;
+    
+    /**
+     * Largest position correction accepted from one fix (inches)
+     * Bigger jumps are almost always reflections or a partly blocked code strip.
+     */
+    static constexpr double MAX_CORRECTION = 12.0;
+    
+    /**
+     * Outliers in a row that re-snap the pose to the GPS when they agree with each other
+     * (their errors within OUTLIER_AGREEMENT inches): a bump or wheel slip moved the robot
+     * and odometry didn't see it. Low quality fixes in between don't break the run.
+     */
+    static const int OUTLIER_RECOVERY_COUNT = 5;
+    static constexpr double OUTLIER_AGREEMENT = 3.0;
+    
+    /**
+     * Create a fusion filter
+     * 
+     * @param positionGain How much of each GPS position error to correct (0-1)
+     * @param headingGain How much of each GPS heading error to correct (0-1, 0 = trust the gyro)
+     */
+    GpsFusion(double positionGain = 0.3, double headingGain = 0.05);
+    
+    /**
+     * Set a known pose (e.g. the autonomous starting tile) and clear the history
+     * 
+     * @param timestampMs Current time
+     * @param pose Known pose
+     * @param rawHeading Heading the inertial sensor reports right now
+     */
+    void reset(uint32_t timestampMs, const Odometry::Pose& pose, double rawHeading);
+    
+    /**
+     * Advance the pose with one odometry step and record it in the history
+     * 
+     * @param timestampMs Time of the encoder/inertial reading
+     * @param forwardDistance Inches driven since the last call (average of both sides)
+     * @param rawHeading Heading reported by the inertial sensor (degrees)
+     */
+    void updateOdometry(uint32_t timestampMs, double forwardDistance, double rawHeading);
+    
+    /**
+     * Apply a GPS fix at the time it was measured and re-propagate to the present
+     * 
+     * Cost: O(log n) lookup + O(n) replay of the entries newer than the fix.
+     * 
+     * @param measuredAtMs Time the GPS actually measured this pose (receive time minus latency)
+     * @param gpsPose Pose reported by the GPS
+     * @param quality GPS quality (0-100)
+     * @return What was done with the fix
+     */
+    FixResult applyGpsFix(uint32_t measuredAtMs, const Odometry::Pose& gpsPose, int quality);
+    
+    /**
+     * Best estimate of the current pose
+     */
+    Odometry::Pose getPose() const;
+    
+    /**
+     * True once reset() was called or a first GPS fix was accepted
+     */
+    bool isInitialized() const;
+    
+    /**
+     * Number of GPS fixes rejected since the last reset (dropouts, outliers, stale fixes)
+     */
+    int getRejectedFixCount() const;
+    
+    /**
+     * Read-only access to the pose history (e.g. for heading at a past time)
+     */
+    const PoseHistory& getHistory() const;
+    
+private:
+    PoseHistory history;
+    Odometry::Pose currentPose;
+    double positionGain;
+    double headingGain;
+    double headingOffset;  // Added to the raw inertial heading to get field heading
+    bool initialized;
+    int rejectedFixCount;
+    
+    // Outliers in a row, and the error of the last one (inches)
+    int outlierCount;
+    double outlierErrorX;
+    double outlierErrorY;
+};
+
+#endif // GPSFUSION_H
@@ -0,0 +1,302 @@
+/*
+ * GridPlanner.cpp
+ * 
+ * Implementation of the incremental grid path search.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "GridPlanner.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+const float DIAGONAL_COST = 1.41421356f;
+}
+
+GridPlanner::GridPlanner() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] = 0;
+        Point center = centerOf(cell);
+        if (std::fabs(center.x) > FIELD_HALF_SIZE - ROBOT_RADIUS ||
+            std::fabs(center.y) > FIELD_HALF_SIZE - ROBOT_RADIUS) {
+            blocked[cell] = WALL;
+        }
+    }
+    status = IDLE;
+    startCell = 0;
+    goalCell = 0;
+    origin.x = 0.0;
+    origin.y = 0.0;
+    goal = origin;
+    heapSize = 0;
+    expansions = 0;
+    waypointCount = 0;
+}
+
+void GridPlanner::clearObstacles() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] &= ~(OBSTACLE | SEEN);
+    }
+}
+
+void GridPlanner::clearSeenObstacles() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] &= ~SEEN;
+    }
+}
+
+void GridPlanner::addObstacle(Point center, double radius) {
+    markCircle(center, radius, OBSTACLE);
+}
+
+void GridPlanner::addSeenObstacle(Point center, double radius) {
+    markCircle(center, radius, SEEN);
+}
+
+void GridPlanner::markCircle(Point center, double radius, uint8_t blocker) {
+    double reach = radius + ROBOT_RADIUS;
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        Point c = centerOf(cell);
+        double dx = c.x - center.x;
+        double dy = c.y - center.y;
+        if (dx * dx + dy * dy <= reach * reach) {
+            blocked[cell] |= blocker;
+        }
+    }
+}
+
+bool GridPlanner::isBlocked(Point point) const {
+    return blocked[cellOf(point)] != 0;
+}
+
+void GridPlanner::start(Point from, Point to) {
+    origin = from;
+    goal = to;
+    startCell = cellOf(from);
+    goalCell = cellOf(to);
+    expansions = 0;
+    waypointCount = 0;
+    
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        cost[cell] = INFINITY;
+        parent[cell] = -1;
+        closed[cell] = false;
+        heapIndex[cell] = -1;
+    }
+    heapSize = 0;
+    
+    if ((blocked[goalCell] & (OBSTACLE | SEEN)) != 0) {
+        status = NO_PATH;
+        return;
+    }
+    cost[startCell] = 0.0f;
+    heap[0] = (int16_t)startCell;
+    heapIndex[startCell] = 0;
+    heapSize = 1;
+    status = SEARCHING;
+}
+
+GridPlanner::Status GridPlanner::step(int maxExpansions) {
+    if (status != SEARCHING) {
+        return status;
+    }
+    
+    for (int n = 0; n < maxExpansions; n++) {
+        if (heapSize == 0) {
+            status = NO_PATH;
+            return status;
+        }
+        int cell = heapPop();
+        if (cell == goalCell) {
+            buildWaypoints();
+            status = FOUND;
+            return status;
+        }
+        closed[cell] = true;
+        expansions++;
+        
+        int row = cell / GRID_SIZE;
+        int col = cell % GRID_SIZE;
+        for (int dRow = -1; dRow <= 1; dRow++) {
+            for (int dCol = -1; dCol <= 1; dCol++) {
+                int r = row + dRow;
+                int c = col + dCol;
+                if ((dRow == 0 && dCol == 0) || r < 0 || r >= GRID_SIZE || c < 0 || c >= GRID_SIZE) {
+                    continue;
+                }
+                int next = r * GRID_SIZE + c;
+                if (closed[next] || !passable(next)) {
+                    continue;
+                }
+                bool diagonal = dRow != 0 && dCol != 0;
+                if (diagonal && (!passable(row * GRID_SIZE + c) || !passable(r * GRID_SIZE + col))) {
+                    continue;  // Don't cut a blocked corner
+                }
+                float newCost = cost[cell] + (diagonal ? DIAGONAL_COST : 1.0f);
+                if (newCost >= cost[next]) {
+                    continue;
+                }
+                cost[next] = newCost;
+                parent[next] = (int16_t)cell;
+                if (heapIndex[next] < 0) {
+                    heap[heapSize] = (int16_t)next;
+                    heapIndex[next] = (int16_t)heapSize;
+                    heapSize++;
+                }
+                heapMoveUp(heapIndex[next]);
+            }
+        }
+    }
+    return status;
+}
+
+GridPlanner::Status GridPlanner::getStatus() const {
+    return status;
+}
+
+int GridPlanner::getExpansions() const {
+    return expansions;
+}
+
+int GridPlanner::getWaypointCount() const {
+    return waypointCount;
+}
+
+GridPlanner::Point GridPlanner::getWaypoint(int index) const {
+    return waypoints[index];
+}
+
+int GridPlanner::cellOf(Point point) const {
+    int col = (int)std::floor((point.x + FIELD_HALF_SIZE) / CELL_SIZE);
+    int row = (int)std::floor((point.y + FIELD_HALF_SIZE) / CELL_SIZE);
+    col = (col < 0) ? 0 : (col >= GRID_SIZE) ? GRID_SIZE - 1 : col;
+    row = (row < 0) ? 0 : (row >= GRID_SIZE) ? GRID_SIZE - 1 : row;
+    return row * GRID_SIZE + col;
+}
+
+GridPlanner::Point GridPlanner::centerOf(int cell) const {
+    Point center;
+    center.x = -FIELD_HALF_SIZE + ((cell % GRID_SIZE) + 0.5) * CELL_SIZE;
+    center.y = -FIELD_HALF_SIZE + ((cell / GRID_SIZE) + 0.5) * CELL_SIZE;
+    return center;
+}
+
+bool GridPlanner::passable(int cell) const {
+    if (cell == startCell) {
+        return true;
+    }
+    if (cell == goalCell) {
+        return (blocked[cell] & (OBSTACLE | SEEN)) == 0;
+    }
+    return blocked[cell] == 0;
+}
+
+float GridPlanner::estimate(int cell) const {
+    int dRow = std::abs(cell / GRID_SIZE - goalCell / GRID_SIZE);
+    int dCol = std::abs(cell % GRID_SIZE - goalCell % GRID_SIZE);
+    int straight = (dRow > dCol) ? dRow - dCol : dCol - dRow;
+    int diagonal = (dRow > dCol) ? dCol : dRow;
+    return straight + DIAGONAL_COST * diagonal;
+}
+
+bool GridPlanner::before(int a, int b) const {
+    float fa = cost[a] + estimate(a);
+    float fb = cost[b] + estimate(b);
+    if (fa != fb) {
+        return fa < fb;
+    }
+    return cost[a] > cost[b];  // Tie: the one further along (closer to the goal)
+}
+
+void GridPlanner::heapMoveUp(int position) {
+    int cell = heap[position];
+    while (position > 0) {
+        int parentPosition = (position - 1) / 2;
+        int above = heap[parentPosition];
+        if (!before(cell, above)) {
+            break;
+        }
+        heap[position] = (int16_t)above;
+        heapIndex[above] = (int16_t)position;
+        position = parentPosition;
+    }
+    heap[position] = (int16_t)cell;
+    heapIndex[cell] = (int16_t)position;
+}
+
+int GridPlanner::heapPop() {
+    int top = heap[0];
+    heapIndex[top] = -1;
+    heapSize--;
+    if (heapSize == 0) {
+        return top;
+    }
+    
+    // Last cell to the root, then down to where it belongs
+    int cell = heap[heapSize];
+    int position = 0;
+    while (true) {
+        int child = 2 * position + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], cell)) {
+            break;
+        }
+        heap[position] = heap[child];
+        heapIndex[heap[child]] = (int16_t)position;
+        position = child;
+    }
+    heap[position] = (int16_t)cell;
+    heapIndex[cell] = (int16_t)position;
+    return top;
+}
+
+void GridPlanner::buildWaypoints() {
+    // Cells from the goal back to the start
+    int16_t path[CELL_COUNT];
+    int length = 0;
+    for (int cell = goalCell; cell != startCell && cell >= 0; cell = parent[cell]) {
+        path[length++] = (int16_t)cell;
+    }
+    
+    // From where the robot is, go straight to the furthest cell it can see; repeat
+    waypointCount = 0;
+    Point from = origin;
+    int index = length - 1;  // Next cell along the path
+    while (index > 0 && waypointCount < MAX_WAYPOINTS - 1) {
+        int furthest = index;
+        for (int i = 0; i < index; i++) {
+            if (lineClear(from, (i == 0) ? goal : centerOf(path[i]))) {
+                furthest = i;
+                break;
+            }
+        }
+        if (furthest == 0) {
+            break;
+        }
+        from = centerOf(path[furthest]);
+        waypoints[waypointCount++] = from;
+        index = furthest - 1;
+    }
+    waypoints[waypointCount++] = goal;
+}
+
+bool GridPlanner::lineClear(Point from, Point to) const {
+    double dx = to.x - from.x;
+    double dy = to.y - from.y;
+    int samples = (int)std::ceil(std::sqrt(dx * dx + dy * dy) / (CELL_SIZE / 4.0)) + 1;
+    for (int i = 0; i <= samples; i++) {
+        Point p;
+        p.x = from.x + dx * i / samples;
+        p.y = from.y + dy * i / samples;
+        if (!passable(cellOf(p))) {
+            return false;
+        }
+    }
+    return true;
+}
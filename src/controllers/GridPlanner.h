@@ -0,0 +1,205 @@
+/*
+ * GridPlanner.h
+ * 
+ * This header defines the GridPlanner class, which finds a way around obstacles on a
+ * coarse grid over the field (A* search, 8 neighbors). It is used to replan an
+ * autonomous route when something blocks it (see RouteFollower).
+ * 
+ * The search runs incrementally: step() expands at most a given number of cells and
+ * returns, keeping the search where it stopped, so a replan is spread over several
+ * control ticks instead of holding one of them up.
+ * 
+ * Obstacles are grown by the robot's radius when they are marked, so the robot can be
+ * planned as a point. The field walls are grown the same way.
+ * 
+ * Field conventions are the same as Odometry (inches, origin at the field center).
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef GRIDPLANNER_H
+#define GRIDPLANNER_H
+
+#include <cstdint>
+
+/**
+ * GridPlanner Class
+ * 
+ * Usage:
+ *   1. addObstacle() for whatever blocks the field (clearObstacles() to forget them),
+ *      addSeenObstacle() for things found in the way that may move (clearSeenObstacles())
+ *   2. start() with where the robot is and where it is going
+ *   3. step() once per control tick until it returns FOUND or NO_PATH
+ *   4. getWaypointCount() / getWaypoint(): the path, shortened to its corners
+ */
+class GridPlanner {
+public:
+    /**
+     * Where the search is
+     */
+    enum Status {
+        IDLE,        // Not started
+        SEARCHING,   // Started, step() again
+        FOUND,       // Path ready (finished)
+        NO_PATH      // Nothing gets there (finished)
+    };
+    
+    /**
+     * Field size: 144" square, origin at the center (inches)
+     */
+    static constexpr double FIELD_HALF_SIZE = 72.0;
+    
+    /**
+     * Grid cell size (inches) and cells per side
+     */
+    static constexpr double CELL_SIZE = 6.0;
+    static const int GRID_SIZE = 24;
+    static const int CELL_COUNT = GRID_SIZE * GRID_SIZE;
+    
+    /**
+     * Robot radius obstacles and walls are grown by (inches)
+     */
+    static constexpr double ROBOT_RADIUS = 9.0;
+    
+    /**
+     * Most waypoints a path is shortened to
+     */
+    static const int MAX_WAYPOINTS = 16;
+    
+    /**
+     * One point on the field (inches)
+     */
+    struct Point {
+        double x;
+        double y;
+    };
+    
+    /**
+     * Constructor: empty field
+     */
+    GridPlanner();
+    
+    /**
+     * Forget every obstacle (the walls stay)
+     */
+    void clearObstacles();
+    
+    /**
+     * Forget only the obstacles added with addSeenObstacle()
+     */
+    void clearSeenObstacles();
+    
+    /**
+     * Mark a round obstacle (grown by ROBOT_RADIUS)
+     * 
+     * @param center Obstacle center (inches)
+     * @param radius Obstacle radius (inches)
+     */
+    void addObstacle(Point center, double radius);
+    
+    /**
+     * Mark something found in the way that may move (a robot): blocks like addObstacle()
+     * until clearSeenObstacles()
+     */
+    void addSeenObstacle(Point center, double radius);
+    
+    /**
+     * True if the robot's center can't be at this point
+     */
+    bool isBlocked(Point point) const;
+    
+    /**
+     * Start a search (any search in progress is dropped)
+     * 
+     * The robot's own cell is always allowed, so it can plan its way out of a cell
+     * an obstacle was just grown over. So is the goal's cell if only the walls block it
+     * (routes often end close to a wall); a goal inside an obstacle gives NO_PATH.
+     * 
+     * @param from Robot position
+     * @param to Goal
+     */
+    void start(Point from, Point to);
+    
+    /**
+     * Continue the search
+     * 
+     * @param maxExpansions Most cells to expand in this call (the compute budget)
+     * @return Status after the call
+     */
+    Status step(int maxExpansions);
+    
+    Status getStatus() const;
+    
+    /**
+     * Cells expanded since start()
+     */
+    int getExpansions() const;
+    
+    /**
+     * Path waypoints once FOUND (the robot's position not included; the last one is
+     * the goal)
+     */
+    int getWaypointCount() const;
+    Point getWaypoint(int index) const;
+    
+private:
+    /**
+     * What blocks a cell (bit flags)
+     */
+    enum Blocker {
+        WALL = 1,
+        OBSTACLE = 2,
+        SEEN = 4
+    };
+    
+    /**
+     * Mark every cell an obstacle reaches
+     */
+    void markCircle(Point center, double radius, uint8_t blocker);
+    
+    uint8_t blocked[CELL_COUNT];
+    
+    // Search state (kept between step() calls)
+    Status status;
+    int startCell;
+    int goalCell;
+    Point origin;
+    Point goal;
+    float cost[CELL_COUNT];       // Best cost from the start so far (cells)
+    int16_t parent[CELL_COUNT];
+    bool closed[CELL_COUNT];
+    int16_t heap[CELL_COUNT];     // Open cells, binary heap on cost + estimate
+    int16_t heapIndex[CELL_COUNT];  // Position in the heap, -1 = not in it
+    int heapSize;
+    int expansions;
+    
+    Point waypoints[MAX_WAYPOINTS];
+    int waypointCount;
+    
+    int cellOf(Point point) const;
+    Point centerOf(int cell) const;
+    bool passable(int cell) const;
+    
+    /**
+     * Cost estimate to the goal (octile distance, in cells)
+     */
+    float estimate(int cell) const;
+    
+    /**
+     * Open list: cheapest cost + estimate first
+     */
+    bool before(int a, int b) const;
+    void heapMoveUp(int position);
+    int heapPop();
+    
+    /**
+     * Follow the parents back from the goal, keeping only the corners
+     */
+    void buildWaypoints();
+    
+    /**
+     * Straight line between two points crosses only passable cells
+     */
+    bool lineClear(Point from, Point to) const;
+};
+
+#endif // GRIDPLANNER_H
@@ -0,0 +1,158 @@
+/*
+ * HeadingSnap.cpp
+ * 
+ * Implementation of profiled turn-to-heading.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "HeadingSnap.h"
+
+#include <cmath>
+
+#include "DriveTrain.h"
+#include "Odometry.h"
+
+HeadingSnap::HeadingSnap()
+    : active(false),
+      startHeading(0.0),
+      target(0.0),
+      angle(0.0),
+      traveled(0.0),
+      lastHeading(0.0),
+      startMs(0),
+      durationMs(0),
+      settledSinceMs(0),
+      settling(false) {
+}
+
+void HeadingSnap::start(double currentHeading, double targetHeading, uint32_t nowMs) {
+    // Absolute target: start fresh (don't chain onto a running snap)
+    active = false;
+    startRelative(currentHeading, Odometry::headingDifference(currentHeading, targetHeading), nowMs);
+}
+
+void HeadingSnap::startRelative(double currentHeading, double turn, uint32_t nowMs) {
+    // Chained presses build on the previous target, not on where the robot is mid-turn
+    double base = active ? target : currentHeading;
+    double remaining = active ? (angle - traveled) : 0.0;
+    
+    active = true;
+    startHeading = currentHeading;
+    target = Odometry::wrapHeading(base + turn);
+    angle = remaining + turn;
+    traveled = 0.0;
+    lastHeading = currentHeading;
+    startMs = nowMs;
+    durationMs = profileDurationMs(angle);
+    settling = false;
+}
+
+bool HeadingSnap::update(double heading, uint32_t nowMs, int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!active) {
+        return false;
+    }
+    
+    // Unwrapped progress, so 180 degree turns don't flip direction halfway
+    traveled += Odometry::headingDifference(lastHeading, heading);
+    lastHeading = heading;
+    
+    uint32_t elapsedMs = nowMs - startMs;
+    double position, rate;
+    profileAt(angle, elapsedMs / 1000.0, position, rate);
+    
+    // Finished? Profile done and close enough for a little while
+    double remaining = angle - traveled;
+    if (elapsedMs >= durationMs && std::fabs(remaining) <= SETTLE_TOLERANCE) {
+        if (!settling) {
+            settling = true;
+            settledSinceMs = nowMs;
+        }
+        if (nowMs - settledSinceMs >= SETTLE_TIME_MS) {
+            active = false;
+            return false;
+        }
+    } else {
+        settling = false;
+    }
+    if (elapsedMs >= durationMs + TIMEOUT_MARGIN_MS) {
+        active = false;
+        return false;
+    }
+    
+    // Feedforward from the (upcoming) profile speed + feedback on the profile position
+    double leadPosition, leadRate;
+    profileAt(angle, (elapsedMs + FEEDFORWARD_LEAD_MS) / 1000.0, leadPosition, leadRate);
+    double power = KV * leadRate + KP * (position - traveled);
+    int turnPower = DriveTrain::clamp((int)std::lround(power), -100, 100);
+    
+    // Clockwise: left forward, right backward
+    leftPower = turnPower;
+    rightPower = -turnPower;
+    return true;
+}
+
+void HeadingSnap::cancel() {
+    active = false;
+}
+
+bool HeadingSnap::isActive() const {
+    return active;
+}
+
+double HeadingSnap::getTarget() const {
+    return target;
+}
+
+double HeadingSnap::nearestPreset(double heading) {
+    return Odometry::wrapHeading(std::floor(Odometry::wrapHeading(heading) / 90.0 + 0.5) * 90.0);
+}
+
+uint32_t HeadingSnap::profileDurationMs(double turn) {
+    double distance = std::fabs(turn);
+    double accelTime = MAX_TURN_RATE / TURN_ACCEL;
+    double accelDistance = 0.5 * TURN_ACCEL * accelTime * accelTime;
+    
+    double seconds;
+    if (distance < 2.0 * accelDistance) {
+        // Triangle: never reaches full speed
+        seconds = 2.0 * std::sqrt(distance / TURN_ACCEL);
+    } else {
+        seconds = 2.0 * accelTime + (distance - 2.0 * accelDistance) / MAX_TURN_RATE;
+    }
+    return (uint32_t)std::lround(seconds * 1000.0);
+}
+
+void HeadingSnap::profileAt(double turn, double t, double& position, double& rate) {
+    double distance = std::fabs(turn);
+    double direction = (turn < 0.0) ? -1.0 : 1.0;
+    
+    // Peak speed (lower than MAX_TURN_RATE for short turns)
+    double peakRate = std::fmin(MAX_TURN_RATE, std::sqrt(distance * TURN_ACCEL));
+    double accelTime = peakRate / TURN_ACCEL;
+    double accelDistance = 0.5 * peakRate * accelTime;
+    double cruiseTime = (peakRate > 0.0) ? (distance - 2.0 * accelDistance) / peakRate : 0.0;
+    double total = 2.0 * accelTime + cruiseTime;
+    
+    double p, v;
+    if (t <= 0.0) {
+        p = 0.0;
+        v = 0.0;
+    } else if (t < accelTime) {
+        p = 0.5 * TURN_ACCEL * t * t;
+        v = TURN_ACCEL * t;
+    } else if (t < accelTime + cruiseTime) {
+        p = accelDistance + peakRate * (t - accelTime);
+        v = peakRate;
+    } else if (t < total) {
+        double left = total - t;
+        p = distance - 0.5 * TURN_ACCEL * left * left;
+        v = TURN_ACCEL * left;
+    } else {
+        p = distance;
+        v = 0.0;
+    }
+    position = direction * p;
+    rate = direction * v;
+}
@@ -0,0 +1,163 @@
+/*
+ * HeadingSnap.h
+ * 
+ * This header defines the HeadingSnap class, which turns the robot in place to a
+ * heading using the inertial sensor, following a trapezoidal speed profile
+ * (speed up, cruise, slow down) so it stops on the target instead of overshooting.
+ * 
+ * Used for D-pad quick turns in driver control: the snap overrides the tank drive
+ * output until it settles, or until the driver moves a stick.
+ * 
+ * Headings are compass style: degrees, clockwise positive (same as the inertial sensor).
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef HEADINGSNAP_H
+#define HEADINGSNAP_H
+
+#include <cstdint>
+
+/**
+ * HeadingSnap Class
+ * 
+ * Usage (once per control tick):
+ *   1. start() when a D-pad button is pressed
+ *   2. update() with the gyro heading; while it returns true, use its motor powers
+ *   3. cancel() as soon as the driver moves a stick
+ */
+class HeadingSnap {
+public:
+    /**
+     * Maximum turn speed of the profile (degrees per second)
+     */
+    static constexpr double MAX_TURN_RATE = 300.0;
+    
+    /**
+     * Turn acceleration / deceleration of the profile (degrees per second squared)
+     */
+    static constexpr double TURN_ACCEL = 1500.0;
+    
+    /**
+     * Power per degree/second of profile speed (feedforward, percent)
+     * About 100% / top turn speed of the drive.
+     */
+    static constexpr double KV = 0.22;
+    
+    /**
+     * Feedforward looks this far ahead in the profile (ms)
+     * The drive takes about this long to reach a commanded speed; without the lead
+     * the robot is still turning fast when the profile has already stopped.
+     */
+    static const uint32_t FEEDFORWARD_LEAD_MS = 80;
+    
+    /**
+     * Power per degree of error from the profile (feedback, percent)
+     */
+    static constexpr double KP = 1.6;
+    
+    /**
+     * Finished when within this many degrees of the target...
+     */
+    static constexpr double SETTLE_TOLERANCE = 2.0;
+    
+    /**
+     * ...for this long after the profile ends (ms)
+     */
+    static const uint32_t SETTLE_TIME_MS = 60;
+    
+    /**
+     * Give up this long after the profile should have ended (ms)
+     */
+    static const uint32_t TIMEOUT_MARGIN_MS = 750;
+    
+    /**
+     * Create an idle snap
+     */
+    HeadingSnap();
+    
+    /**
+     * Start a turn to an absolute heading (shortest direction)
+     * 
+     * @param currentHeading Gyro heading now (degrees)
+     * @param targetHeading Heading to end at (degrees)
+     * @param nowMs Current time
+     */
+    void start(double currentHeading, double targetHeading, uint32_t nowMs);
+    
+    /**
+     * Start a turn by a relative angle (e.g. 90, -90, 180)
+     * 
+     * If a snap is already running, the angle is added to its target, so pressing
+     * right twice turns 180 degrees.
+     * 
+     * @param currentHeading Gyro heading now (degrees)
+     * @param angle Turn in degrees (positive = clockwise)
+     * @param nowMs Current time
+     */
+    void startRelative(double currentHeading, double angle, uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param heading Gyro heading now (degrees)
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return true while the snap is running (use the powers), false when idle
+     */
+    bool update(double heading, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop the snap and hand control back to the driver
+     */
+    void cancel();
+    
+    /**
+     * True while a snap is running
+     */
+    bool isActive() const;
+    
+    /**
+     * Heading the running (or last) snap is turning to
+     */
+    double getTarget() const;
+    
+    /**
+     * Nearest multiple of 90 degrees (field-square preset)
+     * 
+     * @param heading Any heading (degrees)
+     * @return 0, 90, 180 or 270
+     */
+    static double nearestPreset(double heading);
+    
+    /**
+     * Time the profile needs for a turn (ms)
+     * 
+     * @param angle Turn size in degrees (sign ignored)
+     */
+    static uint32_t profileDurationMs(double angle);
+    
+    /**
+     * Profile position and speed at a time into the turn
+     * 
+     * @param angle Total turn (degrees, signed)
+     * @param elapsedSeconds Time since the start
+     * @param position Output: degrees turned so far (signed)
+     * @param rate Output: degrees per second (signed)
+     */
+    static void profileAt(double angle, double elapsedSeconds, double& position, double& rate);
+    
+private:
+    bool active;
+    double startHeading;
+    double target;
+    double angle;            // Signed turn from startHeading to target
+    double traveled;         // Signed turn so far (unwrapped)
+    double lastHeading;
+    uint32_t startMs;
+    uint32_t durationMs;
+    uint32_t settledSinceMs;
+    bool settling;
+};
+
+#endif // HEADINGSNAP_H
@@ -0,0 +1,80 @@
+/*
+ * InputSampler.cpp
+ * 
+ * Implementation of controller input sampling.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "InputSampler.h"
+
+bool InputSampler::Snapshot::pressed(Button button) const {
+    return (buttons & buttonBit(button)) != 0;
+}
+
+int InputSampler::Snapshot::axis(Axis which) const {
+    return axes[which];
+}
+
+uint16_t InputSampler::buttonBit(Button button) {
+    return (uint16_t)(1u << button);
+}
+
+bool InputSampler::differs(const Snapshot& a, const Snapshot& b) {
+    if (a.buttons != b.buttons) {
+        return true;
+    }
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        if (a.axes[i] != b.axes[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+InputSampler::InputSampler()
+    : sampleCount(0) {
+    current.timestampUs = 0;
+    current.changedAtUs = 0;
+    current.sequence = 0;
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        current.axes[i] = 0;
+    }
+    current.buttons = 0;
+    published.write(current);
+    
+    // Nothing new for the reader yet
+    Snapshot discard;
+    published.read(discard);
+}
+
+bool InputSampler::sample(const int axes[AXIS_COUNT], uint16_t buttons, uint32_t nowUs) {
+    sampleCount++;
+    
+    Snapshot reading = current;
+    reading.timestampUs = nowUs;
+    reading.buttons = buttons;
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        reading.axes[i] = axes[i];
+    }
+    
+    bool changed = differs(reading, current);
+    if (changed) {
+        reading.changedAtUs = nowUs;
+        reading.sequence = current.sequence + 1;
+        published.write(reading);
+    }
+    current = reading;
+    return changed;
+}
+
+bool InputSampler::read(Snapshot& snapshot) {
+    return published.read(snapshot);
+}
+
+bool InputSampler::hasNew() const {
+    return published.hasNew();
+}
+
+uint32_t InputSampler::getSampleCount() const {
+    return sampleCount;
+}
@@ -0,0 +1,122 @@
+/*
+ * InputSampler.h
+ * 
+ * This header defines the InputSampler class, which turns raw controller readings into
+ * timestamped snapshots and hands the latest one to the driver control loop.
+ * 
+ * A fast input task calls sample() every couple of milliseconds. Whenever a stick or
+ * button changes, the new snapshot (with the time the change was first seen) is
+ * published through a TripleBuffer. The control loop reads it without waiting,
+ * and can run as soon as something changes instead of at the next 20 ms tick.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef INPUTSAMPLER_H
+#define INPUTSAMPLER_H
+
+#include <cstdint>
+
+#include "TripleBuffer.h"
+
+/**
+ * InputSampler Class
+ * 
+ * Usage:
+ *   Input task:   sample(axes, buttons, now) as often as possible
+ *   Control loop: read(snapshot) - true when something changed since the last read
+ */
+class InputSampler {
+public:
+    /**
+     * Controller buttons (bit positions in Snapshot::buttons)
+     */
+    enum Button {
+        BUTTON_L1, BUTTON_L2, BUTTON_R1, BUTTON_R2,
+        BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT,
+        BUTTON_X, BUTTON_B, BUTTON_Y, BUTTON_A,
+        BUTTON_COUNT
+    };
+    
+    /**
+     * Controller axes (Axis1 to Axis4)
+     */
+    enum Axis {
+        AXIS_1,   // Right stick X
+        AXIS_2,   // Right stick Y
+        AXIS_3,   // Left stick Y
+        AXIS_4,   // Left stick X
+        AXIS_COUNT
+    };
+    
+    /**
+     * One controller reading
+     */
+    struct Snapshot {
+        uint32_t timestampUs;        // When it was sampled
+        uint32_t changedAtUs;        // When this input state was first seen
+        uint32_t sequence;           // Increases with every published change
+        int axes[AXIS_COUNT];        // -100 to 100
+        uint16_t buttons;            // One bit per Button
+        
+        /**
+         * True if the button is held
+         */
+        bool pressed(Button button) const;
+        
+        /**
+         * Axis position (-100 to 100)
+         */
+        int axis(Axis which) const;
+    };
+    
+    /**
+     * Bit for a button in Snapshot::buttons
+     */
+    static uint16_t buttonBit(Button button);
+    
+    /**
+     * True if two snapshots have different stick positions or buttons
+     */
+    static bool differs(const Snapshot& a, const Snapshot& b);
+    
+    /**
+     * Create a sampler (sticks centered, nothing pressed)
+     */
+    InputSampler();
+    
+    /**
+     * Add one raw reading (input task only)
+     * 
+     * @param axes Stick positions, AXIS_COUNT values (-100 to 100)
+     * @param buttons Held buttons (buttonBit() of each)
+     * @param nowUs Current time in microseconds
+     * @return true if the input changed (and was published)
+     */
+    bool sample(const int axes[AXIS_COUNT], uint16_t buttons, uint32_t nowUs);
+    
+    /**
+     * Latest snapshot (control loop only; never waits)
+     * 
+     * @param snapshot Output: the latest snapshot
+     * @return true if it changed since the last read
+     */
+    bool read(Snapshot& snapshot);
+    
+    /**
+     * True if a change is waiting to be read
+     */
+    bool hasNew() const;
+    
+    /**
+     * Number of raw readings so far
+     */
+    uint32_t getSampleCount() const;
+    
+private:
+    TripleBuffer<Snapshot> published;
+    Snapshot current;       // Input task's latest reading
+    uint32_t sampleCount;
+};
+
+#endif // INPUTSAMPLER_H
@@ -7,6 +7,8 @@
 
 #include "IntakeController.h"
 
+#include <cmath>
+
 int IntakeController::calculateIntakePower(MotorState state, int powerLevel) {
     // If motor should stop, return 0 regardless of power level
     if (state == STOP) {
@@ -27,6 +29,26 @@ int IntakeController::calculateIntakePower(MotorState state, int powerLevel) {
     return 0;
 }
 
+int IntakeController::calculateGroundMatchedPower(MotorState state, double groundSpeed, double maxSurfaceSpeed,
+                                                   double overspeed) {
+    // Spitting out and stopping don't depend on the ground speed
+    if (state != FORWARD) {
+        return calculateIntakePower(state, 100);
+    }
+    
+    // A ball only comes at the roller while the robot drives forward
+    double target = MIN_SURFACE_SPEED + std::fmax(0.0, groundSpeed) * (1.0 + overspeed);
+    
+    // Round up so the roller is never slower than the target
+    int power = (int)std::ceil(100.0 * target / maxSurfaceSpeed - 1e-9);
+    return calculateIntakePower(FORWARD, power);
+}
+
+double IntakeController::surfaceSpeed(double motorRpm, double diameter, double gearRatio) {
+    // Turns per second times circumference
+    return motorRpm / 60.0 * gearRatio * 3.14159265358979323846 * diameter;
+}
+
 int IntakeController::calculateRampPower(MotorState state, int powerLevel) {
     // Ramp motor uses same logic as intake motor
     // If motor should stop, return 0 regardless of power level
@@ -48,6 +70,14 @@ int IntakeController::calculateRampPower(MotorState state, int powerLevel) {
     return 0;
 }
 
+IntakeController::MotorState IntakeController::limitToCapacity(MotorState state, bool full) {
+    // A full robot can't take another ball - stop instead of jamming it against the others
+    if (full && state == FORWARD) {
+        return STOP;
+    }
+    return state;
+}
+
 int IntakeController::clampPowerLevel(int powerLevel) {
     // Ensure power level stays within 0-100 range
     if (powerLevel < 0) {
@@ -32,6 +32,19 @@ public:
         REVERSE = -1   // Motor spinning reverse (spit out/ramp down)
     };
     
+    /**
+     * Ground-speed-matched intake: the roller's surface runs this much faster than the
+     * robot drives (0.2 = 20%), so a ball it drives onto is pulled in instead of being
+     * pushed ahead or flicked off by a roller far faster than the ball
+     */
+    static constexpr double DEFAULT_OVERSPEED = 0.2;
+    
+    /**
+     * Roller surface speed on top of the matched speed (inches per second): what the
+     * roller runs at with the robot stopped, enough for a ball rolling into it
+     */
+    static constexpr double MIN_SURFACE_SPEED = 12.0;
+    
     /**
      * Calculate intake motor power
      * 
@@ -43,6 +56,34 @@ public:
      */
     static int calculateIntakePower(MotorState state, int powerLevel);
     
+    /**
+     * Calculate intake motor power matched to the robot's ground speed
+     * 
+     * Pure function: FORWARD runs the roller surface at MIN_SURFACE_SPEED plus the forward
+     * ground speed times (1 + overspeed); driving backwards counts as stopped. REVERSE
+     * (spitting out) is full power. The motor's velocity control holds the speed.
+     * 
+     * @param state The desired motor state (STOP, FORWARD, REVERSE)
+     * @param groundSpeed Robot forward speed (inches per second, negative = backwards)
+     * @param maxSurfaceSpeed Roller surface speed at 100% (inches per second)
+     * @param overspeed Roller surface speed above the ground speed (0.2 = 20% faster)
+     * @return Motor power value (-100 to 100, where 0 = stop)
+     */
+    static int calculateGroundMatchedPower(MotorState state, double groundSpeed, double maxSurfaceSpeed,
+                                           double overspeed = DEFAULT_OVERSPEED);
+    
+    /**
+     * Surface speed of a wheel or roller
+     * 
+     * Pure function: works for the drive wheels (ground speed) and the intake roller
+     * 
+     * @param motorRpm Motor speed (rpm)
+     * @param diameter Wheel or roller diameter (inches)
+     * @param gearRatio Wheel turns per motor turn
+     * @return Surface speed (inches per second)
+     */
+    static double surfaceSpeed(double motorRpm, double diameter, double gearRatio);
+    
     /**
      * Calculate ramp motor power
      * 
@@ -54,6 +95,17 @@ public:
      */
     static int calculateRampPower(MotorState state, int powerLevel);
     
+    /**
+     * Stop intaking when the robot is full
+     * 
+     * Pure function: FORWARD becomes STOP when full; REVERSE (spitting out) is always allowed
+     * 
+     * @param state The requested intake state
+     * @param full true if the robot holds as many balls as it can (see BallDetector)
+     * @return The intake state to use
+     */
+    static MotorState limitToCapacity(MotorState state, bool full);
+    
     /**
      * Clamp power level to valid range
      * 
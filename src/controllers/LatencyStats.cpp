@@ -0,0 +1,81 @@
+/*
+ * LatencyStats.cpp
+ * 
+ * Implementation of latency statistics.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "LatencyStats.h"
+
+LatencyStats::LatencyStats(uint32_t bucketUs)
+    : bucketUs(bucketUs > 0 ? bucketUs : DEFAULT_BUCKET_US) {
+    reset();
+}
+
+void LatencyStats::add(uint32_t latencyUs) {
+    uint32_t bucket = latencyUs / bucketUs;
+    if (bucket >= (uint32_t)BUCKET_COUNT) {
+        bucket = BUCKET_COUNT - 1;
+    }
+    buckets[bucket]++;
+    
+    if (count == 0 || latencyUs < minUs) {
+        minUs = latencyUs;
+    }
+    if (count == 0 || latencyUs > maxUs) {
+        maxUs = latencyUs;
+    }
+    count++;
+    totalUs += latencyUs;
+}
+
+void LatencyStats::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] = 0;
+    }
+    count = 0;
+    minUs = 0;
+    maxUs = 0;
+    totalUs = 0;
+}
+
+uint32_t LatencyStats::getCount() const {
+    return count;
+}
+
+uint32_t LatencyStats::getMin() const {
+    return minUs;
+}
+
+uint32_t LatencyStats::getMax() const {
+    return maxUs;
+}
+
+double LatencyStats::getMean() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    return (double)totalUs / count;
+}
+
+uint32_t LatencyStats::getPercentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    
+    // Smallest bucket whose running total reaches the requested share
+    double needed = percent / 100.0 * count;
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= needed) {
+            uint32_t upperEdge = (i == BUCKET_COUNT - 1) ? maxUs : (uint32_t)(i + 1) * bucketUs;
+            return (upperEdge < maxUs) ? upperEdge : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+uint32_t LatencyStats::getBucketUs() const {
+    return bucketUs;
+}
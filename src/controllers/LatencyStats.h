@@ -0,0 +1,97 @@
+/*
+ * LatencyStats.h
+ * 
+ * This header defines the LatencyStats class, which collects a distribution of
+ * latencies (e.g. controller input to motor command) in a fixed histogram:
+ * count, min, mean, max and percentiles, with no memory allocation.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <cstdint>
+
+/**
+ * LatencyStats Class
+ * 
+ * Usage:
+ *   1. add() each measured latency
+ *   2. Read getMean(), getPercentile(95), getMax(), ...
+ */
+class LatencyStats {
+public:
+    /**
+     * Number of histogram buckets (the last one collects everything longer)
+     */
+    static const int BUCKET_COUNT = 64;
+    
+    /**
+     * Default bucket width (microseconds)
+     */
+    static const uint32_t DEFAULT_BUCKET_US = 500;
+    
+    /**
+     * Create empty statistics
+     * 
+     * @param bucketUs Histogram bucket width in microseconds (percentile resolution)
+     */
+    LatencyStats(uint32_t bucketUs = DEFAULT_BUCKET_US);
+    
+    /**
+     * Add one measurement
+     * 
+     * @param latencyUs Latency in microseconds
+     */
+    void add(uint32_t latencyUs);
+    
+    /**
+     * Forget all measurements
+     */
+    void reset();
+    
+    /**
+     * Number of measurements
+     */
+    uint32_t getCount() const;
+    
+    /**
+     * Shortest latency (microseconds, 0 if none)
+     */
+    uint32_t getMin() const;
+    
+    /**
+     * Longest latency (microseconds, 0 if none)
+     */
+    uint32_t getMax() const;
+    
+    /**
+     * Average latency (microseconds, 0 if none)
+     */
+    double getMean() const;
+    
+    /**
+     * Latency that the given percent of measurements are at or below
+     * (upper edge of the histogram bucket, never more than getMax())
+     * 
+     * @param percent 0 to 100 (e.g. 95)
+     * @return Latency in microseconds (0 if none)
+     */
+    uint32_t getPercentile(double percent) const;
+    
+    /**
+     * Bucket width (microseconds)
+     */
+    uint32_t getBucketUs() const;
+    
+private:
+    uint32_t bucketUs;
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+#endif // LATENCYSTATS_H
@@ -0,0 +1,60 @@
+/*
+ * MatchClock.cpp
+ * 
+ * Implementation of the match clock.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "MatchClock.h"
+
+MatchClock::MatchClock()
+    : phase(DISABLED),
+      phaseStartMs(0),
+      autonomousMs(DEFAULT_AUTONOMOUS_MS),
+      driverMs(DEFAULT_DRIVER_MS) {
+}
+
+MatchClock::Phase MatchClock::phaseFromFlags(bool enabled, bool autonomous) {
+    if (!enabled) {
+        return DISABLED;
+    }
+    return autonomous ? AUTONOMOUS : DRIVER;
+}
+
+void MatchClock::setDurations(uint32_t autonomousMs, uint32_t driverMs) {
+    this->autonomousMs = autonomousMs;
+    this->driverMs = driverMs;
+}
+
+bool MatchClock::update(Phase newPhase, uint32_t nowMs) {
+    if (newPhase == phase) {
+        return false;
+    }
+    // Transition: the new period starts now
+    phase = newPhase;
+    phaseStartMs = nowMs;
+    return true;
+}
+
+MatchClock::Phase MatchClock::getPhase() const {
+    return phase;
+}
+
+uint32_t MatchClock::getElapsedMs(uint32_t nowMs) const {
+    return nowMs - phaseStartMs;
+}
+
+uint32_t MatchClock::getRemainingMs(uint32_t nowMs) const {
+    uint32_t duration = 0;
+    if (phase == AUTONOMOUS) {
+        duration = autonomousMs;
+    } else if (phase == DRIVER) {
+        duration = driverMs;
+    }
+    
+    uint32_t elapsed = getElapsedMs(nowMs);
+    if (elapsed >= duration) {
+        return 0;
+    }
+    return duration - elapsed;
+}
@@ -0,0 +1,97 @@
+/*
+ * MatchClock.h
+ * 
+ * This header defines the MatchClock class, which knows which part of the match
+ * we're in and how much time is left.
+ * 
+ * The V5 Brain tells us the competition state (disabled / autonomous / driver control)
+ * but not how long the period has been running. MatchClock watches for state changes
+ * and timestamps them, so any code can ask "how many seconds are left?"
+ * 
+ * No hardware dependencies - main.cpp passes in Competition state and the time.
+ */
+
+#ifndef MATCHCLOCK_H
+#define MATCHCLOCK_H
+
+#include <cstdint>
+
+/**
+ * MatchClock Class
+ * 
+ * Call update() regularly (every tick) with the current competition phase.
+ */
+class MatchClock {
+public:
+    /**
+     * Competition phases
+     */
+    enum Phase {
+        DISABLED = 0,    // Robot disabled (before/between/after periods)
+        AUTONOMOUS = 1,  // Autonomous period
+        DRIVER = 2       // Driver control period
+    };
+    
+    /**
+     * Standard match period lengths (VRC: 0:15 autonomous, 1:45 driver control)
+     */
+    static const uint32_t DEFAULT_AUTONOMOUS_MS = 15000;
+    static const uint32_t DEFAULT_DRIVER_MS = 105000;
+    
+    MatchClock();
+    
+    /**
+     * Turn competition flags into a phase
+     * 
+     * Pure function.
+     * 
+     * @param enabled Competition.isEnabled()
+     * @param autonomous Competition.isAutonomous()
+     * @return DISABLED, AUTONOMOUS or DRIVER
+     */
+    static Phase phaseFromFlags(bool enabled, bool autonomous);
+    
+    /**
+     * Change the period lengths (e.g. 60 s for skills runs)
+     * 
+     * @param autonomousMs Autonomous period length
+     * @param driverMs Driver control period length
+     */
+    void setDurations(uint32_t autonomousMs, uint32_t driverMs);
+    
+    /**
+     * Report the current phase
+     * 
+     * @param phase Current competition phase
+     * @param nowMs Current time
+     * @return true if the phase changed since the last update (a transition)
+     */
+    bool update(Phase phase, uint32_t nowMs);
+    
+    /**
+     * Current phase
+     */
+    Phase getPhase() const;
+    
+    /**
+     * Time since the current phase started
+     * 
+     * @param nowMs Current time
+     */
+    uint32_t getElapsedMs(uint32_t nowMs) const;
+    
+    /**
+     * Time left in the current period (0 when disabled or the period is over)
+     * 
+     * @param nowMs Current time
+     */
+    uint32_t getRemainingMs(uint32_t nowMs) const;
+    
+private:
+    Phase phase;
+    uint32_t phaseStartMs;
+    uint32_t autonomousMs;
+    uint32_t driverMs;
+};
+
+#endif // MATCHCLOCK_H
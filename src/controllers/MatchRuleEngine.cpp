@@ -0,0 +1,73 @@
+/*
+ * MatchRuleEngine.cpp
+ * 
+ * Implementation of the timed behavior rules.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "MatchRuleEngine.h"
+
+MatchRuleEngine::MatchRuleEngine()
+    : ruleCount(0), currentPhase(MatchClock::DISABLED), nextRule(0) {
+}
+
+uint32_t MatchRuleEngine::actionBit(Action action) {
+    return 1u << static_cast<uint32_t>(action);
+}
+
+bool MatchRuleEngine::addRule(MatchClock::Phase phase, uint32_t remainingMs, Action action) {
+    if (ruleCount >= MAX_RULES) {
+        return false;
+    }
+    
+    // Insertion sort: keep rules grouped by phase, earliest-firing (most time left) first.
+    // This runs at startup only, so the per-tick check can stay O(1).
+    int position = ruleCount;
+    while (position > 0) {
+        const Rule& before = rules[position - 1];
+        bool beforeComesFirst = before.phase < phase ||
+                                (before.phase == phase && before.remainingMs >= remainingMs);
+        if (beforeComesFirst) {
+            break;
+        }
+        rules[position] = before;
+        position--;
+    }
+    rules[position].phase = phase;
+    rules[position].remainingMs = remainingMs;
+    rules[position].action = action;
+    ruleCount++;
+    return true;
+}
+
+void MatchRuleEngine::clearRules() {
+    ruleCount = 0;
+    nextRule = 0;
+}
+
+void MatchRuleEngine::startPhase(MatchClock::Phase phase) {
+    currentPhase = phase;
+    
+    // Skip to the first rule of this phase
+    nextRule = 0;
+    while (nextRule < ruleCount && rules[nextRule].phase < phase) {
+        nextRule++;
+    }
+}
+
+uint32_t MatchRuleEngine::update(uint32_t remainingMs) {
+    uint32_t due = 0;
+    
+    // Only the next rule can be due; the loop repeats only when several rules share a time
+    while (nextRule < ruleCount &&
+           rules[nextRule].phase == currentPhase &&
+           remainingMs <= rules[nextRule].remainingMs) {
+        due |= actionBit(rules[nextRule].action);
+        nextRule++;
+    }
+    return due;
+}
+
+int MatchRuleEngine::getRuleCount() const {
+    return ruleCount;
+}
@@ -0,0 +1,111 @@
+/*
+ * MatchRuleEngine.h
+ * 
+ * This header defines the MatchRuleEngine class, which switches robot behavior at
+ * set times in the match (e.g. "with 15 seconds left, relax the motor limits").
+ * 
+ * Rules are added once at startup and kept sorted by time. Each tick only the NEXT
+ * rule due is checked, so evaluation is a constant-time comparison no matter how many
+ * rules there are.
+ * 
+ * No hardware dependencies - the engine only says WHICH actions are due;
+ * main.cpp carries them out.
+ */
+
+#ifndef MATCHRULEENGINE_H
+#define MATCHRULEENGINE_H
+
+#include <cstdint>
+
+#include "MatchClock.h"
+
+/**
+ * MatchRuleEngine Class
+ * 
+ * Usage:
+ *   1. addRule() for each timed behavior (at startup)
+ *   2. startPhase() when the competition phase changes
+ *   3. update() every tick - returns a bit mask of actions that just became due
+ */
+class MatchRuleEngine {
+public:
+    /**
+     * Things a rule can do (used as bit positions in the update() mask)
+     */
+    enum Action {
+        RELAX_LIMITS = 0,     // Raise motor torque limits for the final push
+        SET_HEIGHT_HIGH = 1,  // Raise the full power wheel for endgame scoring
+        SET_HEIGHT_LOW = 2,   // Lower the full power wheel
+        RUMBLE_DRIVER = 3,    // Rumble the controller to warn the driver
+        ACTION_COUNT = 4
+    };
+    
+    /**
+     * Largest number of rules (fixed array, no dynamic allocation)
+     */
+    static const int MAX_RULES = 16;
+    
+    /**
+     * A timed behavior
+     */
+    struct Rule {
+        MatchClock::Phase phase;  // Period the rule belongs to
+        uint32_t remainingMs;     // Fires when this much time (or less) is left
+        Action action;            // What to do
+    };
+    
+    MatchRuleEngine();
+    
+    /**
+     * Bit for an action in the update() mask
+     * 
+     * @param action The action
+     * @return 1 << action
+     */
+    static uint32_t actionBit(Action action);
+    
+    /**
+     * Add a rule (call at startup, not during a match)
+     * 
+     * @param phase Period the rule belongs to
+     * @param remainingMs Time left in that period when the rule fires
+     * @param action What to do
+     * @return false if the rule table is full
+     */
+    bool addRule(MatchClock::Phase phase, uint32_t remainingMs, Action action);
+    
+    /**
+     * Remove all rules
+     */
+    void clearRules();
+    
+    /**
+     * A new phase started: arm that phase's rules from the beginning
+     * 
+     * @param phase The phase that just started
+     */
+    void startPhase(MatchClock::Phase phase);
+    
+    /**
+     * Check for rules that are now due (constant time per tick)
+     * 
+     * Each rule fires once per phase.
+     * 
+     * @param remainingMs Time left in the current phase
+     * @return Bit mask of actions due this tick (test with actionBit())
+     */
+    uint32_t update(uint32_t remainingMs);
+    
+    /**
+     * Number of rules
+     */
+    int getRuleCount() const;
+    
+private:
+    Rule rules[MAX_RULES];  // Sorted by phase, then by remainingMs from most to least
+    int ruleCount;
+    MatchClock::Phase currentPhase;
+    int nextRule;           // Next rule to check in the current phase
+};
+
+#endif // MATCHRULEENGINE_H
@@ -0,0 +1,47 @@
+/*
+ * Odometry.cpp
+ * 
+ * Implementation of tank-drive dead reckoning.
+ * These are pure functions - no hardware dependencies, fully testable!
+ */
+
+#include "Odometry.h"
+
+#include <cmath>
+
+Odometry::Pose Odometry::integrate(const Pose& start, double forwardDistance, double newHeading) {
+    // Average the start and end heading along the shortest turn direction
+    // (averaging 350 and 10 must give 0, not 180)
+    double midHeading = start.heading + headingDifference(start.heading, newHeading) / 2.0;
+    double midRadians = midHeading * DEGREES_TO_RADIANS;
+    
+    // Compass convention: heading 0 drives along +y, heading 90 drives along +x
+    Pose result;
+    result.x = start.x + forwardDistance * std::sin(midRadians);
+    result.y = start.y + forwardDistance * std::cos(midRadians);
+    result.heading = wrapHeading(newHeading);
+    return result;
+}
+
+double Odometry::wheelTravel(double motorDegrees, double wheelDiameter, double gearRatio) {
+    // Arc length rolled = wheel angle (radians) * wheel radius
+    double wheelRadians = motorDegrees * gearRatio * DEGREES_TO_RADIANS;
+    return wheelRadians * (wheelDiameter / 2.0);
+}
+
+double Odometry::wrapHeading(double heading) {
+    double wrapped = std::fmod(heading, 360.0);
+    if (wrapped < 0.0) {
+        wrapped += 360.0;
+    }
+    return wrapped;
+}
+
+double Odometry::headingDifference(double from, double to) {
+    double difference = wrapHeading(to - from);
+    // Anything past half a turn is shorter the other way around
+    if (difference > 180.0) {
+        difference -= 360.0;
+    }
+    return difference;
+}
@@ -0,0 +1,80 @@
+/*
+ * Odometry.h
+ * 
+ * This header defines the Odometry class, which turns drive encoder travel and
+ * inertial heading into a field position (dead reckoning).
+ * By separating this from the hardware, we can test the math without a robot on a field.
+ * 
+ * Field conventions (same as the VEX GPS sensor):
+ * - x and y are in inches
+ * - heading is in degrees, 0 = facing +y, increasing clockwise (like a compass)
+ */
+
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+/**
+ * Odometry Class
+ * 
+ * Pure functions for tank-drive dead reckoning.
+ * Nothing here touches hardware - main.cpp reads the encoders and inertial sensor
+ * and passes the numbers in.
+ */
+class Odometry {
+public:
+    /**
+     * Robot position on the field
+     */
+    struct Pose {
+        double x;        // Inches
+        double y;        // Inches
+        double heading;  // Degrees, 0-360, clockwise from +y
+    };
+    
+    /**
+     * Move a pose forward by a distance driven
+     * 
+     * Pure function: uses the average of the old and new heading so that
+     * driving along an arc is integrated more accurately than using either end alone.
+     * 
+     * @param start Pose before the move
+     * @param forwardDistance Distance driven along the robot's forward axis (inches, negative = backward)
+     * @param newHeading Heading at the end of the move (degrees)
+     * @return Pose after the move
+     */
+    static Pose integrate(const Pose& start, double forwardDistance, double newHeading);
+    
+    /**
+     * Convert motor rotation into wheel travel
+     * 
+     * @param motorDegrees Motor output shaft rotation (degrees)
+     * @param wheelDiameter Wheel diameter (inches)
+     * @param gearRatio Wheel turns per motor output turn (1.0 for direct drive)
+     * @return Distance the wheel rolled (inches)
+     */
+    static double wheelTravel(double motorDegrees, double wheelDiameter, double gearRatio);
+    
+    /**
+     * Wrap a heading into the 0-360 range
+     * 
+     * @param heading Any heading in degrees (e.g. -90 or 450)
+     * @return Same direction expressed in [0, 360)
+     */
+    static double wrapHeading(double heading);
+    
+    /**
+     * Shortest signed angle from one heading to another
+     * 
+     * @param from Starting heading (degrees)
+     * @param to Target heading (degrees)
+     * @return Turn needed in degrees, in (-180, 180] (positive = clockwise)
+     */
+    static double headingDifference(double from, double to);
+    
+    /**
+     * Degrees to radians conversion factor (pi / 180)
+     */
+    static constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+};
+
+#endif // ODOMETRY_H
@@ -0,0 +1,132 @@
+/*
+ * PhaseManager.cpp
+ * 
+ * Implementation of competition phase transitions and the driver handoff.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "PhaseManager.h"
+
+PhaseManager::PhaseManager(MicrosecondClock clock)
+    : clock(clock),
+      phase(MatchClock::DISABLED),
+      state(defaultState()),
+      transitionStartUs(0),
+      hookLatencyUs(0),
+      maxHookLatencyUs(0),
+      firstTickLatencyUs(0),
+      waitingForFirstTick(false),
+      transitionCount(0) {
+    handoff.ready = false;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        enterHooks[i] = nullptr;
+        exitHooks[i] = nullptr;
+    }
+}
+
+PhaseManager::RobotState PhaseManager::defaultState() {
+    RobotState defaults;
+    defaults.height = PneumaticController::LOW;
+    defaults.lastToggleButton = false;
+    defaults.intakeState = IntakeController::STOP;
+    defaults.rampState = IntakeController::STOP;
+    defaults.fullPowerState = RampController::STOP;
+    return defaults;
+}
+
+uint32_t PhaseManager::now() const {
+    return clock != nullptr ? clock() : 0;
+}
+
+void PhaseManager::setHooks(MatchClock::Phase phase, Hook enter, Hook exit) {
+    // Bounds check before using the enum as an array index
+    if (phase < 0 || phase >= PHASE_COUNT) {
+        return;
+    }
+    enterHooks[phase] = enter;
+    exitHooks[phase] = exit;
+}
+
+bool PhaseManager::transition(MatchClock::Phase newPhase) {
+    if (newPhase == phase || newPhase < 0 || newPhase >= PHASE_COUNT) {
+        return false;
+    }
+    
+    transitionStartUs = now();
+    
+    // Leave the old phase cleanly before starting the new one
+    if (exitHooks[phase] != nullptr) {
+        exitHooks[phase]();
+    }
+    phase = newPhase;
+    if (enterHooks[phase] != nullptr) {
+        enterHooks[phase]();
+    }
+    
+    hookLatencyUs = now() - transitionStartUs;
+    if (hookLatencyUs > maxHookLatencyUs) {
+        maxHookLatencyUs = hookLatencyUs;
+    }
+    firstTickLatencyUs = 0;
+    waitingForFirstTick = true;
+    transitionCount++;
+    return true;
+}
+
+MatchClock::Phase PhaseManager::getPhase() const {
+    return phase;
+}
+
+PhaseManager::RobotState& PhaseManager::getState() {
+    return state;
+}
+
+void PhaseManager::prepareHandoff(const DriverHandoff& prepared) {
+    handoff = prepared;
+    handoff.ready = true;
+}
+
+bool PhaseManager::takeHandoff(uint32_t nowMs, DriverHandoff& out) {
+    if (!handoff.ready) {
+        return false;
+    }
+    out = handoff;
+    handoff.ready = false;
+    
+    // State always carries over: a held A button must not count as a new press
+    state.lastToggleButton = out.toggleButtonHeld;
+    state.intakeState = out.intakeState;
+    state.rampState = out.rampState;
+    state.fullPowerState = out.fullPowerState;
+    
+    // Motor commands are only safe to apply if the sticks were read moments ago
+    return (nowMs - out.preparedAtMs) <= HANDOFF_MAX_AGE_MS;
+}
+
+bool PhaseManager::hasHandoff() const {
+    return handoff.ready;
+}
+
+void PhaseManager::markFirstTick() {
+    if (!waitingForFirstTick) {
+        return;
+    }
+    waitingForFirstTick = false;
+    firstTickLatencyUs = now() - transitionStartUs;
+}
+
+uint32_t PhaseManager::getHookLatencyUs() const {
+    return hookLatencyUs;
+}
+
+uint32_t PhaseManager::getFirstTickLatencyUs() const {
+    return firstTickLatencyUs;
+}
+
+uint32_t PhaseManager::getMaxHookLatencyUs() const {
+    return maxHookLatencyUs;
+}
+
+int PhaseManager::getTransitionCount() const {
+    return transitionCount;
+}
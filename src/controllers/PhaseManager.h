@@ -0,0 +1,189 @@
+/*
+ * PhaseManager.h
+ * 
+ * This header defines the PhaseManager class, which owns the robot's driver-facing state
+ * and runs explicit hooks when the competition phase changes
+ * (disabled -> autonomous -> disabled -> driver control).
+ * 
+ * Without it, state like the current piston height and the last A-button reading
+ * silently carries over between phases, and motors keep whatever command they had.
+ * 
+ * It also holds a "warm handoff": near the end of autonomous, main.cpp pre-computes what
+ * the first driver control tick needs, so driver control acts immediately.
+ * 
+ * No hardware dependencies - hooks are plain functions supplied by main.cpp.
+ */
+
+#ifndef PHASEMANAGER_H
+#define PHASEMANAGER_H
+
+#include <cstdint>
+
+#include "IntakeController.h"
+#include "MatchClock.h"
+#include "PneumaticController.h"
+#include "RampController.h"
+
+/**
+ * PhaseManager Class
+ * 
+ * Usage:
+ *   1. setHooks() for each phase at startup
+ *   2. transition() whenever a phase change is detected (safe to call repeatedly)
+ *   3. Read and write subsystem state through getState()
+ */
+class PhaseManager {
+public:
+    /**
+     * Enter/exit hook: a plain function with no arguments
+     */
+    typedef void (*Hook)();
+    
+    /**
+     * Supplies the current time in microseconds (for latency measurement)
+     */
+    typedef uint32_t (*MicrosecondClock)();
+    
+    /**
+     * Subsystem state owned by the manager (used to be loose globals in main.cpp)
+     */
+    struct RobotState {
+        PneumaticController::HeightPosition height;  // Current full power wheel height
+        bool lastToggleButton;                       // A button last tick (edge detection)
+        IntakeController::MotorState intakeState;    // Last intake command
+        IntakeController::MotorState rampState;      // Last ramp command
+        RampController::MotorState fullPowerState;   // Last full power ramp command
+    };
+    
+    /**
+     * What the first driver control tick needs, prepared during autonomous
+     */
+    struct DriverHandoff {
+        bool ready;                                   // Prepared and not yet used
+        uint32_t preparedAtMs;                        // When it was prepared
+        int leftPower;                                // Drive powers from the sticks (-100 to 100)
+        int rightPower;
+        IntakeController::MotorState intakeState;     // Intake command from the buttons
+        IntakeController::MotorState rampState;       // Ramp command from the buttons
+        RampController::MotorState fullPowerState;    // Full power ramp command from the buttons
+        bool toggleButtonHeld;                        // A held across the boundary (must not toggle)
+    };
+    
+    /**
+     * Oldest handoff whose motor commands may still be applied directly (ms)
+     * Older handoffs (e.g. across the disabled gap in a real match) only restore state.
+     */
+    static const uint32_t HANDOFF_MAX_AGE_MS = 100;
+    
+    /**
+     * Number of phases (DISABLED, AUTONOMOUS, DRIVER)
+     */
+    static const int PHASE_COUNT = 3;
+    
+    /**
+     * Create a manager
+     * 
+     * @param clock Microsecond clock for latency measurement (nullptr = don't measure)
+     */
+    PhaseManager(MicrosecondClock clock = nullptr);
+    
+    /**
+     * Default state: LOW height, everything stopped, no button held
+     */
+    static RobotState defaultState();
+    
+    /**
+     * Set the hooks for a phase (either may be nullptr)
+     * 
+     * @param phase The phase
+     * @param enter Called when the phase starts
+     * @param exit Called when the phase ends
+     */
+    void setHooks(MatchClock::Phase phase, Hook enter, Hook exit);
+    
+    /**
+     * Switch phase: exit hook of the old phase, then enter hook of the new one
+     * 
+     * Calling it again with the current phase does nothing, so both the Competition
+     * callbacks and a polling task can report the same change.
+     * 
+     * @param phase New phase
+     * @return true if a transition happened
+     */
+    bool transition(MatchClock::Phase phase);
+    
+    /**
+     * Current phase
+     */
+    MatchClock::Phase getPhase() const;
+    
+    /**
+     * Subsystem state (read and write)
+     */
+    RobotState& getState();
+    
+    /**
+     * Store a prepared driver handoff (replaces any previous one)
+     * 
+     * @param handoff Prepared values (ready is set automatically)
+     */
+    void prepareHandoff(const DriverHandoff& handoff);
+    
+    /**
+     * Use the handoff once: copies its state into getState()
+     * 
+     * @param nowMs Current time
+     * @param handoff Output: the handoff
+     * @return true if the handoff's motor commands are fresh enough to apply directly
+     */
+    bool takeHandoff(uint32_t nowMs, DriverHandoff& handoff);
+    
+    /**
+     * True if a handoff is prepared and not yet used
+     */
+    bool hasHandoff() const;
+    
+    /**
+     * Mark the first control tick of the current phase as done
+     * (records the transition-to-first-tick latency; later calls are ignored)
+     */
+    void markFirstTick();
+    
+    /**
+     * Time the last transition spent in its exit + enter hooks (microseconds)
+     */
+    uint32_t getHookLatencyUs() const;
+    
+    /**
+     * Time from the last transition to the first control tick (microseconds, 0 if not yet)
+     */
+    uint32_t getFirstTickLatencyUs() const;
+    
+    /**
+     * Worst hook latency seen since startup (microseconds)
+     */
+    uint32_t getMaxHookLatencyUs() const;
+    
+    /**
+     * Number of transitions since startup
+     */
+    int getTransitionCount() const;
+    
+private:
+    uint32_t now() const;
+    
+    MicrosecondClock clock;
+    MatchClock::Phase phase;
+    RobotState state;
+    DriverHandoff handoff;
+    Hook enterHooks[PHASE_COUNT];
+    Hook exitHooks[PHASE_COUNT];
+    uint32_t transitionStartUs;
+    uint32_t hookLatencyUs;
+    uint32_t maxHookLatencyUs;
+    uint32_t firstTickLatencyUs;
+    bool waitingForFirstTick;
+    int transitionCount;
+};
+
+#endif // PHASEMANAGER_H
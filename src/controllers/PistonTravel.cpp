@@ -0,0 +1,123 @@
+/*
+ * PistonTravel.cpp
+ * 
+ * Implementation of the piston travel-time model.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "PistonTravel.h"
+
+#include <cmath>
+
+PistonTravel::PistonTravel(double extendMs, double retractMs)
+    : target(PneumaticController::LOW),
+      status(SETTLED),
+      confirmationRequired{false, false},
+      travel(0.0),
+      strokeFrom(0.0),
+      strokeStartMs(0),
+      fullStroke(false),
+      awaitingConfirm(false),
+      calibrationCount(0),
+      unconfirmedCount(0) {
+    travelMs[PneumaticController::LOW] = retractMs;
+    travelMs[PneumaticController::HIGH] = extendMs;
+}
+
+void PistonTravel::reset(PneumaticController::HeightPosition position) {
+    target = position;
+    awaitingConfirm = false;
+    settle();
+}
+
+void PistonTravel::setConfirmationRequired(PneumaticController::HeightPosition position, bool required) {
+    confirmationRequired[position] = required;
+}
+
+PistonTravel::Status PistonTravel::update(PneumaticController::HeightPosition target, uint32_t nowMs) {
+    if (target != this->target) {
+        this->target = target;
+        strokeFrom = travel;
+        strokeStartMs = nowMs;
+        fullStroke = (travel == ((target == PneumaticController::HIGH) ? 0.0 : 1.0));
+        awaitingConfirm = true;
+        status = IN_TRANSIT;
+    }
+    if (status == SETTLED) {
+        return status;
+    }
+    
+    // Constant speed over the stroke, toward the target end
+    double endTravel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    double fraction = (double)(nowMs - strokeStartMs) / travelMs[target];
+    double distance = std::fabs(endTravel - strokeFrom);
+    if (fraction >= distance) {
+        travel = endTravel;
+        if (!confirmationRequired[target]) {
+            settle();
+        } else if (fraction >= distance * CONFIRM_TIMEOUT_FACTOR) {
+            unconfirmedCount++;
+            settle();
+        }
+    } else {
+        travel = (endTravel > strokeFrom) ? strokeFrom + fraction : strokeFrom - fraction;
+    }
+    return status;
+}
+
+void PistonTravel::confirm(PneumaticController::HeightPosition position, uint32_t nowMs) {
+    if (!awaitingConfirm || position != target) {
+        return;
+    }
+    awaitingConfirm = false;
+    
+    // Only a stroke from the other end measures the whole travel time
+    if (fullStroke) {
+        double measuredMs = (double)(nowMs - strokeStartMs);
+        travelMs[target] += (measuredMs - travelMs[target]) * CALIBRATION_WEIGHT;
+        calibrationCount++;
+    }
+    settle();
+}
+
+PistonTravel::Status PistonTravel::getStatus() const {
+    return status;
+}
+
+bool PistonTravel::isSettled() const {
+    return status == SETTLED;
+}
+
+PneumaticController::HeightPosition PistonTravel::getTarget() const {
+    return target;
+}
+
+double PistonTravel::getTravel() const {
+    return travel;
+}
+
+double PistonTravel::getRemainingMs() const {
+    if (status == SETTLED) {
+        return 0.0;
+    }
+    double endTravel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    return std::fabs(endTravel - travel) * travelMs[target];
+}
+
+double PistonTravel::getTravelMs(PneumaticController::HeightPosition position) const {
+    return travelMs[position];
+}
+
+int PistonTravel::getCalibrationCount() const {
+    return calibrationCount;
+}
+
+int PistonTravel::getUnconfirmedCount() const {
+    return unconfirmedCount;
+}
+
+void PistonTravel::settle() {
+    travel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    strokeFrom = travel;
+    status = SETTLED;
+}
@@ -0,0 +1,150 @@
+/*
+ * PistonTravel.h
+ * 
+ * This header defines the PistonTravel class, a model of how long the height pistons
+ * take to stroke. PneumaticController only says where the pistons should be; the
+ * cylinders need a few hundred milliseconds to get there, and a ball shot by the full
+ * power wheel mid-stroke leaves at the wrong height.
+ * 
+ * Extending and retracting have their own travel times. A limit switch (or any sensor
+ * that sees an end position) confirms full strokes and calibrates the times; without
+ * one the model runs on the calibrated defaults alone. Confirmation is set per direction,
+ * since a switch usually sits at one end of the stroke only.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef PISTONTRAVEL_H
+#define PISTONTRAVEL_H
+
+#include <cstdint>
+
+#include "PneumaticController.h"
+
+/**
+ * PistonTravel Class
+ * 
+ * Usage (once per control tick):
+ *   1. update() with the commanded height (a change starts a stroke)
+ *   2. confirm() when a sensor sees the pistons at an end position (optional)
+ *   3. Score only while isSettled() (ScoringProfile::update() takes it)
+ */
+class PistonTravel {
+public:
+    /**
+     * Where the pistons are
+     */
+    enum Status {
+        SETTLED,     // At the commanded end position
+        IN_TRANSIT   // Still stroking toward it
+    };
+    
+    /**
+     * Default stroke times (ms), measured at full tank pressure
+     */
+    static constexpr double DEFAULT_EXTEND_MS = 300.0;
+    static constexpr double DEFAULT_RETRACT_MS = 220.0;
+    
+    /**
+     * Weight of each confirmed stroke in the calibrated travel time
+     */
+    static constexpr double CALIBRATION_WEIGHT = 0.25;
+    
+    /**
+     * With confirmation required, a stroke the sensor never confirms is trusted
+     * after this many travel times (a broken switch must not block scoring)
+     */
+    static constexpr double CONFIRM_TIMEOUT_FACTOR = 2.0;
+    
+    /**
+     * Constructor
+     * 
+     * @param extendMs Travel time LOW to HIGH
+     * @param retractMs Travel time HIGH to LOW
+     */
+    PistonTravel(double extendMs = DEFAULT_EXTEND_MS, double retractMs = DEFAULT_RETRACT_MS);
+    
+    /**
+     * Forget any stroke: the pistons are known to be settled at a position
+     */
+    void reset(PneumaticController::HeightPosition position);
+    
+    /**
+     * Require a sensor to confirm strokes toward a position before they count as settled
+     * (a switch at one end only confirms strokes toward that end)
+     * 
+     * @param position HIGH for extends, LOW for retracts
+     * @param required true = wait for confirm()
+     */
+    void setConfirmationRequired(PneumaticController::HeightPosition position, bool required);
+    
+    /**
+     * Advance the model
+     * 
+     * A new target starts a stroke from wherever the pistons are (reversing
+     * mid-stroke only takes the distance already travelled).
+     * 
+     * @param target Commanded height
+     * @param nowMs Current time
+     * @return Current status
+     */
+    Status update(PneumaticController::HeightPosition target, uint32_t nowMs);
+    
+    /**
+     * A sensor sees the pistons at an end position
+     * Settles a stroke toward that position; a full stroke also calibrates
+     * that direction's travel time (even if the model already settled it).
+     * 
+     * @param position End position the sensor sees
+     * @param nowMs Current time
+     */
+    void confirm(PneumaticController::HeightPosition position, uint32_t nowMs);
+    
+    Status getStatus() const;
+    bool isSettled() const;
+    PneumaticController::HeightPosition getTarget() const;
+    
+    /**
+     * Piston position: 0 = fully LOW, 1 = fully HIGH
+     */
+    double getTravel() const;
+    
+    /**
+     * Time until the current stroke should end (0 when settled)
+     */
+    double getRemainingMs() const;
+    
+    /**
+     * Calibrated travel time toward a position
+     * 
+     * @param position HIGH for the extend time, LOW for the retract time
+     */
+    double getTravelMs(PneumaticController::HeightPosition position) const;
+    
+    /**
+     * Strokes used for calibration, and strokes settled without the required confirmation
+     */
+    int getCalibrationCount() const;
+    int getUnconfirmedCount() const;
+    
+    
+private:
+    double travelMs[2];  // Indexed by HeightPosition: [LOW] = retract, [HIGH] = extend
+    PneumaticController::HeightPosition target;
+    Status status;
+    bool confirmationRequired[2];  // Indexed by HeightPosition, like travelMs
+    double travel;        // 0 to 1
+    double strokeFrom;    // travel when the stroke started
+    uint32_t strokeStartMs;
+    bool fullStroke;      // Stroke started at the other end position
+    bool awaitingConfirm; // No sensor has seen the end of this stroke yet
+    int calibrationCount;
+    int unconfirmedCount;
+    
+    /**
+     * Settle at the target end position
+     */
+    void settle();
+};
+
+#endif // PISTONTRAVEL_H
@@ -0,0 +1,67 @@
+/*
+ * PoseHistory.cpp
+ * 
+ * Implementation of the fixed-size pose ring buffer.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "PoseHistory.h"
+
+PoseHistory::PoseHistory() : oldest(0), count(0) {
+}
+
+void PoseHistory::clear() {
+    oldest = 0;
+    count = 0;
+}
+
+void PoseHistory::add(const Entry& entry) {
+    if (count < CAPACITY) {
+        // Still filling up: write after the newest entry
+        entries[(oldest + count) % CAPACITY] = entry;
+        count++;
+    } else {
+        // Full: the oldest slot becomes the newest entry
+        entries[oldest] = entry;
+        oldest = (oldest + 1) % CAPACITY;
+    }
+}
+
+int PoseHistory::size() const {
+    return count;
+}
+
+PoseHistory::Entry& PoseHistory::at(int index) {
+    // Bounds check: clamp instead of reading outside the array
+    if (index >= count) {
+        index = count - 1;
+    }
+    if (index < 0) {
+        index = 0;
+    }
+    return entries[(oldest + index) % CAPACITY];
+}
+
+const PoseHistory::Entry& PoseHistory::at(int index) const {
+    return const_cast<PoseHistory*>(this)->at(index);
+}
+
+int PoseHistory::findAtOrBefore(uint32_t timestampMs) const {
+    if (count == 0 || timestampMs < at(0).timestampMs) {
+        return -1;
+    }
+    
+    // Binary search for the last entry with timestamp <= timestampMs
+    // Invariant: at(low) is at or before the time, everything after high is after it
+    int low = 0;
+    int high = count - 1;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;  // Round up so the loop always shrinks
+        if (at(middle).timestampMs <= timestampMs) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
@@ -0,0 +1,89 @@
+/*
+ * PoseHistory.h
+ * 
+ * This header defines the PoseHistory class, a fixed-size record of recent robot poses.
+ * Sensors like the GPS report where the robot WAS a little while ago, so localization
+ * needs to look up (and correct) the pose at that earlier time.
+ * 
+ * Memory: fixed-size ring buffer, no dynamic allocation.
+ * Lookup: binary search on timestamps, O(log n).
+ */
+
+#ifndef POSEHISTORY_H
+#define POSEHISTORY_H
+
+#include <cstdint>
+
+#include "Odometry.h"
+
+/**
+ * PoseHistory Class
+ * 
+ * Ring buffer of timestamped poses, oldest entry first.
+ * Each entry also keeps the odometry step that produced it (distance driven and
+ * heading reached) so a corrected pose can be re-propagated to the present.
+ */
+class PoseHistory {
+public:
+    /**
+     * Number of entries kept (at a 10 ms update rate this is 1.28 seconds of history)
+     */
+    static const int CAPACITY = 128;
+    
+    /**
+     * One recorded pose
+     */
+    struct Entry {
+        uint32_t timestampMs;     // When the pose was valid (Brain system time)
+        Odometry::Pose pose;      // Pose at that time
+        double forwardDistance;   // Inches driven since the previous entry
+        double odometryHeading;   // Heading reported by the inertial sensor for this step
+    };
+    
+    PoseHistory();
+    
+    /**
+     * Remove all entries
+     */
+    void clear();
+    
+    /**
+     * Add a new entry (overwrites the oldest entry once full)
+     * 
+     * Timestamps must not go backwards - entries are kept in time order for binary search.
+     * 
+     * @param entry The entry to record
+     */
+    void add(const Entry& entry);
+    
+    /**
+     * Number of entries currently stored (0 to CAPACITY)
+     */
+    int size() const;
+    
+    /**
+     * Access an entry by age
+     * 
+     * @param index 0 = oldest entry, size() - 1 = newest entry
+     * @return Reference to the entry (index is clamped to the valid range)
+     */
+    Entry& at(int index);
+    const Entry& at(int index) const;
+    
+    /**
+     * Find the newest entry recorded at or before a time
+     * 
+     * Binary search: O(log n).
+     * 
+     * @param timestampMs Time to look up
+     * @return Index of the entry (0 = oldest), or -1 if the time is older than all entries
+     */
+    int findAtOrBefore(uint32_t timestampMs) const;
+    
+private:
+    Entry entries[CAPACITY];
+    int oldest;  // Ring position of the oldest entry
+    int count;   // Number of valid entries
+};
+
+#endif // POSEHISTORY_H
@@ -0,0 +1,11 @@
+/*
+ * RobotDescriptor.cpp
+ * 
+ * Storage for the robot description tables (the values live in the header).
+ * No hardware dependencies, fully testable!
+ */
+
+#include "RobotDescriptor.h"
+
+constexpr RobotDescriptor::MotorSpec RobotDescriptor::MOTORS[RobotDescriptor::MOTOR_COUNT];
+constexpr RobotDescriptor::PistonSpec RobotDescriptor::PISTONS[RobotDescriptor::PISTON_COUNT];
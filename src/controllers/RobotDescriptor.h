@@ -0,0 +1,211 @@
+/*
+ * RobotDescriptor.h
+ * 
+ * This header defines the RobotDescriptor class: the one place that describes how
+ * the robot is wired. Each motor's name, smart port, gearset, reversal, drive side
+ * and subsystem, each piston's 3-wire port, and the sensor ports.
+ * 
+ * Everything is constexpr. main.cpp builds its motors, pistons and dispatch tables
+ * from it, subsystem groupings (which motors are the left drive, etc.) are computed
+ * by the compiler, and Telemetry lays out the per-motor record from it. Wiring
+ * mistakes such as two motors on one port fail to compile.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef ROBOTDESCRIPTOR_H
+#define ROBOTDESCRIPTOR_H
+
+#include <cstdint>
+
+#include "ActuationFrame.h"
+#include "Command.h"
+#include "EnergyMonitor.h"
+
+/**
+ * RobotDescriptor Class
+ * 
+ * To rewire the robot, edit MOTORS / PISTONS / sensor ports below - nothing else.
+ * MOTORS is indexed by ActuationFrame::Motor (same order as AllMotors).
+ */
+class RobotDescriptor {
+public:
+    /**
+     * Motor cartridge
+     */
+    enum Gearset {
+        GEARSET_36_1,  // Red (100 rpm)
+        GEARSET_18_1,  // Green (200 rpm)
+        GEARSET_6_1    // Blue (600 rpm)
+    };
+    
+    /**
+     * Drive side of a motor
+     */
+    enum Side {
+        LEFT,
+        RIGHT,
+        NO_SIDE  // Not a drive motor
+    };
+    
+    /**
+     * One motor
+     */
+    struct MotorSpec {
+        ActuationFrame::Motor id;      // Must match its position in MOTORS
+        const char* name;              // Telemetry name
+        int port;                      // Smart port (1-21)
+        Gearset gearset;
+        bool reversed;                 // true = spins the other way for forward
+        Side side;
+        Command::Subsystem subsystem;  // Who commands it (see CommandScheduler)
+    };
+    
+    /**
+     * One pneumatic piston (solenoid on a 3-wire port)
+     */
+    struct PistonSpec {
+        const char* name;
+        char port;  // 3-wire port letter ('A' to 'H')
+    };
+    
+    static constexpr int MOTOR_COUNT = ActuationFrame::MOTOR_COUNT;
+    static constexpr int PISTON_COUNT = ActuationFrame::PISTON_COUNT;
+    
+    // Adjust ports and reversals to match your robot's wiring
+    static constexpr MotorSpec MOTORS[MOTOR_COUNT] = {
+        {ActuationFrame::LEFT_FRONT, "LeftFront", 1, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::LEFT_MIDDLE, "LeftMiddle", 2, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::LEFT_BACK, "LeftBack", 3, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::RIGHT_FRONT, "RightFront", 4, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::RIGHT_MIDDLE, "RightMiddle", 5, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::RIGHT_BACK, "RightBack", 6, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::INTAKE, "Intake", 7, GEARSET_18_1, false, NO_SIDE, Command::INTAKE},
+        {ActuationFrame::RAMP, "Ramp", 8, GEARSET_18_1, false, NO_SIDE, Command::RAMP},
+        {ActuationFrame::FULL_POWER_RAMP, "TopWheel", 9, GEARSET_18_1, false, NO_SIDE, Command::TOP_WHEEL}
+    };
+    
+    // Both pistons move the full power wheel together
+    static constexpr PistonSpec PISTONS[PISTON_COUNT] = {
+        {"Piston1", 'A'},
+        {"Piston2", 'B'}
+    };
+    
+    // Limit switch closed at the top of the piston stroke (optional, see PistonTravel)
+    static constexpr char HEIGHT_SWITCH_PORT = 'C';
+    
+    static constexpr int INERTIAL_PORT = 10;  // Mount flat near the center of the robot
+    static constexpr int GPS_PORT = 11;
+    static constexpr int VISION_PORT = 12;  // Front of the robot, looking slightly down at the field
+    
+    // Distance sensors for start position detection (see StartDetector), level, facing out
+    static constexpr int DISTANCE_LEFT_PORT = 13;
+    static constexpr int DISTANCE_RIGHT_PORT = 14;
+    static constexpr int DISTANCE_BACK_PORT = 15;
+    
+    /**
+     * Number of motors in any of the given subsystems
+     * 
+     * @param subsystems Command::Subsystem flags combined with |
+     */
+    static constexpr int countMotors(uint8_t subsystems, int from = 0) {
+        return (from >= MOTOR_COUNT) ? 0
+             : ((MOTORS[from].subsystem & subsystems) ? 1 : 0) + countMotors(subsystems, from + 1);
+    }
+    
+    /**
+     * Number of motors on a drive side
+     */
+    static constexpr int countSide(Side side, int from = 0) {
+        return (from >= MOTOR_COUNT) ? 0
+             : ((MOTORS[from].side == side) ? 1 : 0) + countSide(side, from + 1);
+    }
+    
+    /**
+     * The nth motor (front to back) on a drive side
+     * 
+     * @return Motor index, or -1 if the side has fewer motors
+     */
+    static constexpr int sideMotor(Side side, int n, int from = 0) {
+        return (from >= MOTOR_COUNT) ? -1
+             : (MOTORS[from].side != side) ? sideMotor(side, n, from + 1)
+             : (n == 0) ? from
+             : sideMotor(side, n - 1, from + 1);
+    }
+    
+    /**
+     * Energy accounting group of a motor
+     */
+    static constexpr EnergyMonitor::Subsystem energySubsystem(int motor) {
+        return (MOTORS[motor].subsystem == Command::DRIVE) ? EnergyMonitor::DRIVE
+             : (MOTORS[motor].subsystem == Command::INTAKE) ? EnergyMonitor::INTAKE
+             : (MOTORS[motor].subsystem == Command::RAMP) ? EnergyMonitor::RAMP
+             : EnergyMonitor::FULL_POWER_RAMP;
+    }
+    
+    /**
+     * Free speed of a motor's cartridge (rpm)
+     */
+    static constexpr double maxRpm(int motor) {
+        return (MOTORS[motor].gearset == GEARSET_36_1) ? 100.0
+             : (MOTORS[motor].gearset == GEARSET_18_1) ? 200.0
+             : 600.0;
+    }
+    
+    /**
+     * Checks used by the static_asserts below
+     */
+    static constexpr bool idsInOrder(int from = 0) {
+        return (from >= MOTOR_COUNT) || (MOTORS[from].id == from && idsInOrder(from + 1));
+    }
+    
+    static constexpr bool sensorPort(int port) {
+        return port == INERTIAL_PORT || port == GPS_PORT || port == VISION_PORT ||
+               port == DISTANCE_LEFT_PORT || port == DISTANCE_RIGHT_PORT || port == DISTANCE_BACK_PORT;
+    }
+    
+    static constexpr bool sensorPortsDistinct() {
+        return INERTIAL_PORT != GPS_PORT && VISION_PORT != INERTIAL_PORT && VISION_PORT != GPS_PORT &&
+               !(DISTANCE_LEFT_PORT == INERTIAL_PORT || DISTANCE_LEFT_PORT == GPS_PORT || DISTANCE_LEFT_PORT == VISION_PORT) &&
+               !(DISTANCE_RIGHT_PORT == INERTIAL_PORT || DISTANCE_RIGHT_PORT == GPS_PORT || DISTANCE_RIGHT_PORT == VISION_PORT) &&
+               !(DISTANCE_BACK_PORT == INERTIAL_PORT || DISTANCE_BACK_PORT == GPS_PORT || DISTANCE_BACK_PORT == VISION_PORT) &&
+               DISTANCE_LEFT_PORT != DISTANCE_RIGHT_PORT && DISTANCE_LEFT_PORT != DISTANCE_BACK_PORT &&
+               DISTANCE_RIGHT_PORT != DISTANCE_BACK_PORT;
+    }
+    
+    static constexpr bool portUsedAfter(int port, int from) {
+        return (from < MOTOR_COUNT) && (MOTORS[from].port == port || portUsedAfter(port, from + 1));
+    }
+    
+    static constexpr bool motorPortsValid(int from = 0) {
+        return (from >= MOTOR_COUNT) ||
+               (MOTORS[from].port >= 1 && MOTORS[from].port <= 21 &&
+                !sensorPort(MOTORS[from].port) &&
+                !portUsedAfter(MOTORS[from].port, from + 1) && motorPortsValid(from + 1));
+    }
+    
+    static constexpr bool pistonPortsValid(int from = 0) {
+        return (from >= PISTON_COUNT) ||
+               (PISTONS[from].port >= 'A' && PISTONS[from].port <= 'H' &&
+                (from + 1 >= PISTON_COUNT || PISTONS[from].port != PISTONS[from + 1].port) &&
+                pistonPortsValid(from + 1));
+    }
+    
+    static constexpr bool pistonPortUsed(char port, int from = 0) {
+        return (from < PISTON_COUNT) && (PISTONS[from].port == port || pistonPortUsed(port, from + 1));
+    }
+};
+
+static_assert(RobotDescriptor::idsInOrder(), "RobotDescriptor: MOTORS must be in ActuationFrame::Motor order");
+static_assert(RobotDescriptor::motorPortsValid(), "RobotDescriptor: each motor needs its own smart port (1-21)");
+static_assert(RobotDescriptor::pistonPortsValid(), "RobotDescriptor: each piston needs its own 3-wire port (A-H)");
+static_assert(!RobotDescriptor::pistonPortUsed(RobotDescriptor::HEIGHT_SWITCH_PORT),
+              "RobotDescriptor: the height switch needs its own 3-wire port");
+static_assert(RobotDescriptor::sensorPortsDistinct(), "RobotDescriptor: sensors share a port");
+static_assert(RobotDescriptor::countSide(RobotDescriptor::LEFT) == RobotDescriptor::countSide(RobotDescriptor::RIGHT),
+              "RobotDescriptor: both drive sides need the same number of motors");
+static_assert(RobotDescriptor::countMotors(Command::DRIVE) ==
+              RobotDescriptor::countSide(RobotDescriptor::LEFT) + RobotDescriptor::countSide(RobotDescriptor::RIGHT),
+              "RobotDescriptor: every drive motor needs a side");
+
+#endif // ROBOTDESCRIPTOR_H
@@ -0,0 +1,251 @@
+/*
+ * RouteFollower.cpp
+ * 
+ * Implementation of route driving with blocked detection and replanning.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "RouteFollower.h"
+
+#include <cmath>
+
+#include "DriveTrain.h"
+
+namespace {
+double distanceBetween(GridPlanner::Point a, GridPlanner::Point b) {
+    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+}
+
+GridPlanner::Point positionOf(const Odometry::Pose& pose) {
+    GridPlanner::Point point;
+    point.x = pose.x;
+    point.y = pose.y;
+    return point;
+}
+}
+
+RouteFollower::RouteFollower() {
+    clear();
+}
+
+void RouteFollower::clear() {
+    count = 0;
+    next = 0;
+    status = IDLE;
+    startMs = 0;
+    timeoutMs = 0;
+    replans = 0;
+    maxTickExpansions = 0;
+    progressSet = false;
+    progressMs = 0;
+    collided = false;
+    collisionMs = 0;
+    backoffStartMs = 0;
+}
+
+bool RouteFollower::addWaypoint(GridPlanner::Point point) {
+    if (count >= MAX_WAYPOINTS) {
+        return false;
+    }
+    route[count++] = point;
+    return true;
+}
+
+void RouteFollower::start(uint32_t nowMs, uint32_t timeoutMs) {
+    this->startMs = nowMs;
+    this->timeoutMs = timeoutMs;
+    next = 0;
+    replans = 0;
+    maxTickExpansions = 0;
+    progressSet = false;
+    collided = false;
+    
+    // What blocked an earlier route has probably moved since (known obstacles stay)
+    planner.clearSeenObstacles();
+    status = (count > 0) ? DRIVING : DONE;
+}
+
+void RouteFollower::cancel() {
+    status = IDLE;
+}
+
+void RouteFollower::notifyCollision(uint32_t nowMs) {
+    collided = true;
+    collisionMs = nowMs;
+}
+
+RouteFollower::Status RouteFollower::update(const Odometry::Pose& pose, uint32_t nowMs,
+                                            int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!isRunning()) {
+        return status;
+    }
+    if (nowMs - startMs >= timeoutMs) {
+        finish(FAILED, leftPower, rightPower);
+        return status;
+    }
+    
+    if (status == DRIVING) {
+        return drive(pose, nowMs, leftPower, rightPower);
+    }
+    
+    if (status == BACKING_OFF) {
+        bool farEnough = distanceBetween(positionOf(pose), blockedPoint) >= BACKOFF_DISTANCE;
+        if (farEnough || nowMs - backoffStartMs >= BACKOFF_MS) {
+            startReplan(pose);  // Searching starts next tick
+            return status;
+        }
+        leftPower = -BACKOFF_POWER;
+        rightPower = -BACKOFF_POWER;
+        return status;
+    }
+    
+    // REPLANNING: one budget's worth of search per tick, robot stopped
+    int before = planner.getExpansions();
+    GridPlanner::Status search = planner.step(EXPANSIONS_PER_TICK);
+    int used = planner.getExpansions() - before;
+    if (used > maxTickExpansions) {
+        maxTickExpansions = used;
+    }
+    if (search == GridPlanner::FOUND) {
+        if (!insertDetour()) {
+            finish(FAILED, leftPower, rightPower);
+            return status;
+        }
+        status = DRIVING;
+        progressSet = false;
+    } else if (search == GridPlanner::NO_PATH) {
+        // The waypoint itself is blocked (or walled in): try the next one
+        if (next + 1 >= count) {
+            finish(FAILED, leftPower, rightPower);
+            return status;
+        }
+        next++;
+        startReplan(pose);
+    }
+    return status;
+}
+
+RouteFollower::Status RouteFollower::getStatus() const {
+    return status;
+}
+
+bool RouteFollower::isRunning() const {
+    return status == DRIVING || status == BACKING_OFF || status == REPLANNING;
+}
+
+int RouteFollower::getReplanCount() const {
+    return replans;
+}
+
+int RouteFollower::getRemainingCount() const {
+    return count - next;
+}
+
+GridPlanner::Point RouteFollower::getWaypoint(int index) const {
+    return route[next + index];
+}
+
+GridPlanner::Point RouteFollower::pointAhead(const Odometry::Pose& pose, double distance) {
+    GridPlanner::Point point;
+    point.x = pose.x + distance * std::sin(pose.heading * Odometry::DEGREES_TO_RADIANS);
+    point.y = pose.y + distance * std::cos(pose.heading * Odometry::DEGREES_TO_RADIANS);
+    return point;
+}
+
+GridPlanner& RouteFollower::getPlanner() {
+    return planner;
+}
+
+int RouteFollower::getMaxTickExpansions() const {
+    return maxTickExpansions;
+}
+
+void RouteFollower::finish(Status result, int& leftPower, int& rightPower) {
+    status = result;
+    leftPower = 0;
+    rightPower = 0;
+}
+
+RouteFollower::Status RouteFollower::drive(const Odometry::Pose& pose, uint32_t nowMs,
+                                           int& leftPower, int& rightPower) {
+    GridPlanner::Point here = positionOf(pose);
+    
+    // Pass (or reach) waypoints
+    bool last = next == count - 1;
+    while (distanceBetween(here, route[next]) < (last ? ARRIVE_DISTANCE : PASS_DISTANCE)) {
+        next++;
+        if (next >= count) {
+            finish(DONE, leftPower, rightPower);
+            return status;
+        }
+        last = next == count - 1;
+    }
+    
+    // Steer toward the waypoint (turn first when it is far off to the side)
+    GridPlanner::Point target = route[next];
+    double distance = distanceBetween(here, target);
+    double targetHeading = std::atan2(target.x - here.x, target.y - here.y) / Odometry::DEGREES_TO_RADIANS;
+    double bearing = Odometry::headingDifference(pose.heading, targetHeading);
+    int turn = DriveTrain::clamp((int)std::lround(TURN_KP * bearing), -MAX_TURN_POWER, MAX_TURN_POWER);
+    double forward = DRIVE_POWER * std::fmax(0.0, 1.0 - std::fabs(bearing) / FULL_TURN_BEARING_DEG);
+    if (last) {
+        forward *= std::fmax((double)MIN_DRIVE_POWER / DRIVE_POWER, std::fmin(1.0, distance / SLOW_DISTANCE));
+    }
+    int forwardPower = (int)std::lround(forward);
+    DriveTrain::calculateArcadeDrive(forwardPower, turn, leftPower, rightPower);
+    
+    // Blocked: pushing forward without getting anywhere
+    if (!progressSet || forwardPower < MIN_STALL_POWER ||
+        distanceBetween(here, progressPoint) >= MIN_PROGRESS) {
+        progressSet = true;
+        progressPoint = here;
+        progressMs = nowMs;
+        return status;
+    }
+    bool recentCollision = collided && nowMs - collisionMs <= STALL_MS;
+    if (nowMs - progressMs >= (recentCollision ? COLLISION_STALL_MS : STALL_MS)) {
+        blocked(pose, nowMs);
+        leftPower = 0;
+        rightPower = 0;
+    }
+    return status;
+}
+
+void RouteFollower::blocked(const Odometry::Pose& pose, uint32_t nowMs) {
+    replans++;
+    collided = false;
+    if (replans > MAX_REPLANS) {
+        status = FAILED;
+        return;
+    }
+    
+    // Whatever it is sits just ahead of the robot
+    planner.addSeenObstacle(pointAhead(pose, GridPlanner::ROBOT_RADIUS + OBSTACLE_RADIUS), OBSTACLE_RADIUS);
+    
+    blockedPoint = positionOf(pose);
+    backoffStartMs = nowMs;
+    status = BACKING_OFF;
+}
+
+void RouteFollower::startReplan(const Odometry::Pose& pose) {
+    planner.start(positionOf(pose), route[next]);
+    status = REPLANNING;
+}
+
+bool RouteFollower::insertDetour() {
+    // The planner's last waypoint is the one being driven to, already in the route
+    int added = planner.getWaypointCount() - 1;
+    if (count + added > MAX_WAYPOINTS) {
+        return false;
+    }
+    for (int i = count - 1; i >= next; i--) {
+        route[i + added] = route[i];
+    }
+    for (int i = 0; i < added; i++) {
+        route[next + i] = planner.getWaypoint(i);
+    }
+    count += added;
+    return true;
+}
@@ -0,0 +1,228 @@
+/*
+ * RouteFollower.h
+ * 
+ * This header defines the RouteFollower class, which drives an autonomous route (a
+ * list of field waypoints) from the localization pose, and finds a way around whatever
+ * blocks it instead of pushing into it until the routine times out.
+ * 
+ * Blocked = the robot is driving forward but hasn't moved for a while (sooner after a
+ * collision, see TipDetector). The follower then marks an obstacle just ahead of the
+ * robot, backs off a little, and replans to the waypoint it was heading for on a coarse
+ * grid (GridPlanner). The search is spread over the following ticks with a fixed budget
+ * per tick, so the control loop never waits for it. The detour is put in front of the
+ * rest of the route and the routine carries on.
+ * 
+ * If the waypoint itself is blocked, it is skipped and the next one is planned to.
+ * 
+ * Field conventions are the same as Odometry (inches, heading clockwise from +y).
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef ROUTEFOLLOWER_H
+#define ROUTEFOLLOWER_H
+
+#include <cstdint>
+
+#include "GridPlanner.h"
+#include "Odometry.h"
+
+/**
+ * RouteFollower Class
+ * 
+ * Usage (once per control tick):
+ *   1. clear(), addWaypoint() for each point of the route, start()
+ *   2. notifyCollision() when TipDetector reports a COLLISION
+ *   3. update() with the pose; apply the returned drive powers
+ *   4. Stop when it returns DONE or FAILED
+ */
+class RouteFollower {
+public:
+    /**
+     * Where the route is
+     */
+    enum Status {
+        IDLE,          // Not running
+        DRIVING,       // Driving to the next waypoint
+        BACKING_OFF,   // Blocked: backing away before replanning
+        REPLANNING,    // Searching for a detour (a few ticks, robot stopped)
+        DONE,          // Last waypoint reached (finished)
+        FAILED         // Time limit, too many blocks, or no way through (finished)
+    };
+    
+    /**
+     * Most waypoints in the route, detours included
+     */
+    static const int MAX_WAYPOINTS = 24;
+    
+    /**
+     * Driving: forward power, turn power per degree of bearing and its limit (percent)
+     */
+    static const int DRIVE_POWER = 60;
+    static constexpr double TURN_KP = 1.5;
+    static const int MAX_TURN_POWER = 50;
+    
+    /**
+     * Forward power drops to 0 at this bearing (turn first, then drive)
+     */
+    static constexpr double FULL_TURN_BEARING_DEG = 45.0;
+    
+    /**
+     * Slowing down for the last waypoint: full power this far out (inches), never
+     * slower than MIN_DRIVE_POWER
+     */
+    static constexpr double SLOW_DISTANCE = 12.0;
+    static const int MIN_DRIVE_POWER = 15;
+    
+    /**
+     * A waypoint is reached this close (inches): the last one exactly, the others as
+     * the robot passes
+     */
+    static constexpr double ARRIVE_DISTANCE = 2.0;
+    static constexpr double PASS_DISTANCE = 6.0;
+    
+    /**
+     * Blocked: less than MIN_PROGRESS inches in STALL_MS while driving with at least
+     * MIN_STALL_POWER forward; COLLISION_STALL_MS right after a collision
+     */
+    static constexpr double MIN_PROGRESS = 1.0;
+    static const uint32_t STALL_MS = 400;
+    static const uint32_t COLLISION_STALL_MS = 150;
+    static const int MIN_STALL_POWER = 20;
+    
+    /**
+     * What blocked the robot is marked as a circle this big (inches; about a robot)
+     * just ahead of the robot
+     */
+    static constexpr double OBSTACLE_RADIUS = 9.0;
+    
+    /**
+     * Backing off before replanning: distance (inches), power (percent), time limit (ms)
+     */
+    static constexpr double BACKOFF_DISTANCE = 6.0;
+    static const int BACKOFF_POWER = 30;
+    static const uint32_t BACKOFF_MS = 600;
+    
+    /**
+     * Planner budget: grid cells expanded per control tick
+     */
+    static const int EXPANSIONS_PER_TICK = 60;
+    
+    /**
+     * Blocks before the route is given up
+     */
+    static const int MAX_REPLANS = 4;
+    
+    RouteFollower();
+    
+    /**
+     * Empty the route
+     */
+    void clear();
+    
+    /**
+     * Add a waypoint at the end of the route
+     * 
+     * @return false if the route is full
+     */
+    bool addWaypoint(GridPlanner::Point point);
+    
+    /**
+     * Start driving the route (forgets what blocked earlier routes)
+     * 
+     * @param nowMs Current time
+     * @param timeoutMs Give up after this long
+     */
+    void start(uint32_t nowMs, uint32_t timeoutMs);
+    
+    /**
+     * Stop without finishing (outputs go to 0)
+     */
+    void cancel();
+    
+    /**
+     * The robot hit something (the blocked check then needs only COLLISION_STALL_MS)
+     */
+    void notifyCollision(uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param pose Robot pose
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (percent)
+     * @param rightPower Output: right drive power (percent)
+     * @return Status after the step
+     */
+    Status update(const Odometry::Pose& pose, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    Status getStatus() const;
+    bool isRunning() const;
+    
+    /**
+     * Times the route was blocked and replanned
+     */
+    int getReplanCount() const;
+    
+    /**
+     * Waypoints left, the one being driven to first
+     */
+    int getRemainingCount() const;
+    GridPlanner::Point getWaypoint(int index) const;
+    
+    /**
+     * Point a distance straight ahead of a pose (negative = behind)
+     */
+    static GridPlanner::Point pointAhead(const Odometry::Pose& pose, double distance);
+    
+    /**
+     * The grid: add known obstacles (goals, field elements) before start()
+     */
+    GridPlanner& getPlanner();
+    
+    /**
+     * Most grid cells the planner expanded in one tick since start()
+     */
+    int getMaxTickExpansions() const;
+    
+private:
+    GridPlanner planner;
+    
+    GridPlanner::Point route[MAX_WAYPOINTS];
+    int count;
+    int next;   // Waypoint being driven to
+    
+    Status status;
+    uint32_t startMs;
+    uint32_t timeoutMs;
+    int replans;
+    int maxTickExpansions;
+    
+    // Blocked check: where the robot was when it last made progress
+    bool progressSet;
+    GridPlanner::Point progressPoint;
+    uint32_t progressMs;
+    bool collided;
+    uint32_t collisionMs;
+    
+    // Backing off
+    GridPlanner::Point blockedPoint;
+    uint32_t backoffStartMs;
+    
+    void finish(Status result, int& leftPower, int& rightPower);
+    Status drive(const Odometry::Pose& pose, uint32_t nowMs, int& leftPower, int& rightPower);
+    void blocked(const Odometry::Pose& pose, uint32_t nowMs);
+    
+    /**
+     * Start a search from the robot to the waypoint being driven to
+     */
+    void startReplan(const Odometry::Pose& pose);
+    
+    /**
+     * Put the planner's detour in front of the waypoint being driven to
+     * 
+     * @return false if the route has no room for it
+     */
+    bool insertDetour();
+};
+
+#endif // ROUTEFOLLOWER_H
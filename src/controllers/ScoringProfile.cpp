@@ -0,0 +1,102 @@
+/*
+ * ScoringProfile.cpp
+ * 
+ * Implementation of height-aware scoring profiles.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "ScoringProfile.h"
+
+constexpr ScoringProfile::Profile ScoringProfile::PROFILES[2];
+
+ScoringProfile::ScoringProfile(double wheelMaxRpm)
+    : wheelMaxRpm(wheelMaxRpm),
+      height(PneumaticController::LOW),
+      spinning(false),
+      ready(false),
+      aimHold(false),
+      preSpinning(false),
+      spinStartMs(0),
+      preSpinStartMs(0),
+      wheelRpm(0.0) {
+}
+
+const ScoringProfile::Profile& ScoringProfile::forHeight(PneumaticController::HeightPosition height) {
+    return PROFILES[height];
+}
+
+void ScoringProfile::update(PneumaticController::HeightPosition height, bool scoreHeld, bool settled,
+                            double wheelRpm, uint32_t nowMs) {
+    this->wheelRpm = wheelRpm;
+    
+    // New height: switch profile and spin up to it while the pistons travel
+    if (height != this->height) {
+        this->height = height;
+        preSpinning = true;
+        preSpinStartMs = nowMs;
+        startSpin(nowMs);
+    }
+    if (preSpinning && !scoreHeld && nowMs - preSpinStartMs >= PRESPIN_HOLD_MS) {
+        preSpinning = false;
+    }
+    
+    bool wasSpinning = spinning;
+    spinning = scoreHeld || preSpinning;
+    if (spinning && !wasSpinning) {
+        startSpin(nowMs);
+    }
+    
+    ready = spinning && settled && (nowMs - spinStartMs >= getActiveProfile().preSpinMs);
+}
+
+void ScoringProfile::stop() {
+    spinning = false;
+    preSpinning = false;
+    ready = false;
+}
+
+void ScoringProfile::holdForAim(bool hold) {
+    aimHold = hold;
+}
+
+const ScoringProfile::Profile& ScoringProfile::getActiveProfile() const {
+    return forHeight(height);
+}
+
+bool ScoringProfile::isSpinning() const {
+    return spinning;
+}
+
+bool ScoringProfile::isReady() const {
+    return ready && !aimHold;
+}
+
+int ScoringProfile::getWheelPower() const {
+    if (!spinning) {
+        return 0;
+    }
+    double targetRpm = getActiveProfile().wheelRpm;
+    double power = targetRpm / wheelMaxRpm * 100.0 + (targetRpm - wheelRpm) * VELOCITY_KP;
+    if (power < 0.0) {
+        return 0;  // Never brake the wheel with a ball in it
+    }
+    if (power > 100.0) {
+        return 100;
+    }
+    return (int)(power + 0.5);
+}
+
+int ScoringProfile::getFeedPower(int requestedPower) const {
+    if (requestedPower <= 0 || !spinning) {
+        return requestedPower;
+    }
+    if (!isReady()) {
+        return 0;  // Ball waits on the ramp until the wheel is at speed and height (and aimed)
+    }
+    return requestedPower * getActiveProfile().feedPower / 100;
+}
+
+void ScoringProfile::startSpin(uint32_t nowMs) {
+    spinStartMs = nowMs;
+    ready = false;
+}
@@ -0,0 +1,145 @@
+/*
+ * ScoringProfile.h
+ * 
+ * This header defines the ScoringProfile class, which runs the full power wheel at
+ * the exit speed the current height needs. LOW and HIGH shots need different wheel
+ * speeds and feed rates, so each height has its own profile.
+ * 
+ * When the height changes, the wheel starts spinning up to the new profile right
+ * away, while the pistons are still stroking. Balls are only fed into the wheel once
+ * the pistons have settled AND the wheel has had its pre-spin time, so the first
+ * ball leaves at the right speed from the right height with no dead time.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef SCORINGPROFILE_H
+#define SCORINGPROFILE_H
+
+#include <cstdint>
+
+#include "PneumaticController.h"
+
+/**
+ * ScoringProfile Class
+ * 
+ * Usage (once per control tick):
+ *   1. update() with the commanded height, the score button, whether the pistons
+ *      have settled (PistonTravel) and the wheel's measured speed
+ *   2. getWheelPower() for the full power wheel while isSpinning()
+ *   3. getFeedPower() for the ramp (held while the wheel is not ready, or while
+ *      holdForAim() says the robot is still turning to the goal)
+ */
+class ScoringProfile {
+public:
+    /**
+     * How to score at one height
+     */
+    struct Profile {
+        double wheelRpm;      // Full power wheel exit speed target
+        int feedPower;        // Ramp power while feeding balls into the wheel (percent)
+        uint32_t preSpinMs;   // Wheel spin-up before the first ball is fed
+    };
+    
+    /**
+     * Profiles indexed by PneumaticController::HeightPosition (tune on the field)
+     */
+    static constexpr Profile PROFILES[2] = {
+        {140.0, 100, 200},   // LOW: flatter shot, feed as fast as the wheel takes them
+        {185.0, 70, 300}     // HIGH: faster exit, slower feed so the wheel recovers between balls
+    };
+    
+    /**
+     * Speed loop gain on top of the feedforward (percent per rpm of error)
+     */
+    static constexpr double VELOCITY_KP = 0.5;
+    
+    /**
+     * After a height change the wheel keeps its pre-spin this long waiting for the
+     * score button, then stops to save energy
+     */
+    static const uint32_t PRESPIN_HOLD_MS = 2000;
+    
+    /**
+     * Constructor
+     * 
+     * @param wheelMaxRpm Free speed of the wheel's cartridge (100% power)
+     */
+    ScoringProfile(double wheelMaxRpm);
+    
+    /**
+     * Profile for a height
+     */
+    static const Profile& forHeight(PneumaticController::HeightPosition height);
+    
+    /**
+     * Advance one control tick
+     * 
+     * @param height Commanded height (a change switches profile and starts a pre-spin)
+     * @param scoreHeld Score button held
+     * @param settled Pistons have finished their stroke (PistonTravel::isSettled())
+     * @param wheelRpm Measured wheel speed
+     * @param nowMs Current time
+     */
+    void update(PneumaticController::HeightPosition height, bool scoreHeld, bool settled,
+                double wheelRpm, uint32_t nowMs);
+    
+    /**
+     * Stop spinning (pre-spin included) until the score button or a height change
+     */
+    void stop();
+    
+    /**
+     * Hold the feed while auto-aim is turning to the goal (GoalAim)
+     * 
+     * @param hold true until the aim locks; false when not aiming
+     */
+    void holdForAim(bool hold);
+    
+    /**
+     * Profile of the current height
+     */
+    const Profile& getActiveProfile() const;
+    
+    /**
+     * Wheel is spinning for a shot (score button held or pre-spinning)
+     */
+    bool isSpinning() const;
+    
+    /**
+     * Balls can be fed: spinning, pistons settled, pre-spin time done and not
+     * held for the aim
+     */
+    bool isReady() const;
+    
+    /**
+     * Full power wheel power (percent): feedforward plus speed loop while spinning, else 0
+     */
+    int getWheelPower() const;
+    
+    /**
+     * Ramp power (percent) for a requested ramp power
+     * Forward feed is held while the wheel is spinning but not ready, and scaled to
+     * the profile's feed rate once it is. Reverse, and feeding to a stopped wheel,
+     * pass through unchanged.
+     */
+    int getFeedPower(int requestedPower) const;
+    
+private:
+    double wheelMaxRpm;
+    PneumaticController::HeightPosition height;
+    bool spinning;
+    bool ready;
+    bool aimHold;
+    bool preSpinning;      // Spinning because of a height change, not the button
+    uint32_t spinStartMs;
+    uint32_t preSpinStartMs;
+    double wheelRpm;
+    
+    /**
+     * Start (or restart, for a new target) the spin-up clock
+     */
+    void startSpin(uint32_t nowMs);
+};
+
+#endif // SCORINGPROFILE_H
@@ -0,0 +1,105 @@
+/*
+ * SeqLock.h
+ * 
+ * This header defines the SeqLock class, which shares a small plain-data value
+ * (e.g. the robot pose) from one writer task with any number of reader tasks,
+ * without locks.
+ * 
+ * A sequence number is odd while a write is in progress and even otherwise.
+ * A reader copies the value and checks the number didn't change (and wasn't odd);
+ * if it did, the copy may be torn and the reader tries again. The writer never
+ * waits, so the task producing the data keeps its timing.
+ * 
+ * T must be plain data (copyable with memcpy, no pointers to itself).
+ * Uses only <atomic>: works with vex::task on the robot and std::thread on the host.
+ * Header only (template). No hardware dependencies, fully testable!
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * SeqLock Class
+ * 
+ * Usage:
+ *   Writer task (only one): write(value)
+ *   Reader tasks: read(value) - retries until it gets a consistent copy
+ */
+template <typename T>
+class SeqLock {
+public:
+    /**
+     * Most attempts read() makes before giving up (a writer would have to be
+     * stuck mid-write for this to happen)
+     */
+    static const int MAX_READ_ATTEMPTS = 1000;
+    
+    /**
+     * Create a seqlock holding a default value
+     */
+    SeqLock()
+        : sequence(0),
+          value() {
+    }
+    
+    /**
+     * Publish a value (one writer task only; never waits)
+     * 
+     * @param newValue The new value
+     */
+    void write(const T& newValue) {
+        uint32_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);   // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&value, &newValue, sizeof(T));
+        sequence.store(start + 2, std::memory_order_release);   // Even: done
+    }
+    
+    /**
+     * One attempt at reading (never waits)
+     * 
+     * @param out Output: the value (only valid when this returns true)
+     * @return true if the copy is consistent
+     */
+    bool tryRead(T& out) const {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;  // Writer is in the middle of an update
+        }
+        std::memcpy(&out, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+    
+    /**
+     * Read a consistent copy, retrying if a write got in the way
+     * 
+     * @param out Output: the value
+     * @return true on success (false only if the writer never finished)
+     */
+    bool read(T& out) const {
+        for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+            if (tryRead(out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * Number of writes so far (readers can tell whether anything changed)
+     */
+    uint32_t getVersion() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+    
+private:
+    std::atomic<uint32_t> sequence;
+    T value;
+};
+
+#endif // SEQLOCK_H
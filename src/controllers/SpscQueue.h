@@ -0,0 +1,110 @@
+/*
+ * SpscQueue.h
+ * 
+ * This header defines the SpscQueue class, a fixed-size first-in first-out queue
+ * for passing events from one producer task to one consumer task without locks.
+ * 
+ * The producer only moves the tail, the consumer only moves the head, so neither
+ * ever waits for the other: push() fails when full, pop() fails when empty.
+ * 
+ * Capacity must be a power of two. No memory allocation.
+ * Uses only <atomic>: works with vex::task on the robot and std::thread on the host.
+ * Header only (template). No hardware dependencies, fully testable!
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * SpscQueue Class
+ * 
+ * Usage:
+ *   Producer task (only one): push(item) - false if full (item is dropped)
+ *   Consumer task (only one): pop(item) - false if empty
+ */
+template <typename T, uint32_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+    
+public:
+    /**
+     * Create an empty queue
+     */
+    SpscQueue()
+        : head(0),
+          tail(0),
+          dropped(0) {
+    }
+    
+    /**
+     * Add an item at the back (producer only; never waits)
+     * 
+     * @param item The item
+     * @return false if the queue was full (the item is counted as dropped)
+     */
+    bool push(const T& item) {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        items[currentTail & (CAPACITY - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Take the item at the front (consumer only; never waits)
+     * 
+     * @param item Output: the item
+     * @return false if the queue was empty
+     */
+    bool pop(T& item) {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[currentHead & (CAPACITY - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Number of items waiting (exact from either task's own point of view)
+     */
+    uint32_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * True if nothing is waiting
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    /**
+     * Items lost because the queue was full
+     */
+    uint32_t getDroppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * Maximum number of waiting items
+     */
+    static uint32_t capacity() {
+        return CAPACITY;
+    }
+    
+private:
+    T items[CAPACITY];
+    std::atomic<uint32_t> head;     // Next item to pop (consumer writes)
+    std::atomic<uint32_t> tail;     // Next free slot (producer writes)
+    std::atomic<uint32_t> dropped;
+};
+
+#endif // SPSCQUEUE_H
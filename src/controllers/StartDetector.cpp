@@ -0,0 +1,206 @@
+/*
+ * StartDetector.cpp
+ * 
+ * Implementation of start tile detection from distance sensors.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "StartDetector.h"
+
+#include <cmath>
+
+StartDetector::StartDetector() {
+    sensorCount = 0;
+    startCount = 0;
+    restart();
+}
+
+bool StartDetector::addSensor(const Mount& mount) {
+    if (sensorCount >= MAX_SENSORS) {
+        return false;
+    }
+    sensors[sensorCount++] = mount;
+    restart();
+    return true;
+}
+
+int StartDetector::addStart(const Odometry::Pose& pose) {
+    if (startCount >= MAX_STARTS) {
+        return -1;
+    }
+    starts[startCount] = pose;
+    restart();
+    return startCount++;
+}
+
+void StartDetector::restart() {
+    for (int i = 0; i < MAX_SENSORS; i++) {
+        sums[i] = 0.0;
+        hits[i] = 0;
+    }
+    samples = 0;
+    firstHeading = 0.0;
+    status = WAITING;
+    start = -1;
+    headingError = 0.0;
+    error = 0.0;
+    runnerUpError = 0.0;
+}
+
+StartDetector::Status StartDetector::update(const double distances[], double headingDeg) {
+    // Moved or turned since the average started: start over from here
+    bool moved = samples > 0 && std::fabs(Odometry::headingDifference(firstHeading, headingDeg)) > MOVE_DEGREES;
+    for (int i = 0; i < sensorCount && !moved; i++) {
+        moved = distances[i] >= 0.0 && hits[i] > 0 && std::fabs(distances[i] - sums[i] / hits[i]) > MOVE_INCHES;
+    }
+    if (moved) {
+        restart();
+    }
+    if (samples == 0) {
+        firstHeading = headingDeg;
+    }
+    
+    for (int i = 0; i < sensorCount; i++) {
+        if (distances[i] >= 0.0) {
+            sums[i] += distances[i];
+            hits[i]++;
+        }
+    }
+    samples++;
+    
+    if (samples >= SAMPLE_COUNT) {
+        match();
+    }
+    return status;
+}
+
+StartDetector::Status StartDetector::getStatus() const {
+    return status;
+}
+
+int StartDetector::getStart() const {
+    return start;
+}
+
+double StartDetector::getHeadingError() const {
+    return headingError;
+}
+
+double StartDetector::getError() const {
+    return error;
+}
+
+double StartDetector::getRunnerUpError() const {
+    return runnerUpError;
+}
+
+Odometry::Pose StartDetector::getPose() const {
+    Odometry::Pose pose = {0.0, 0.0, 0.0};
+    if (start >= 0) {
+        pose = starts[start];
+        pose.heading = Odometry::wrapHeading(pose.heading + headingError);
+    }
+    return pose;
+}
+
+double StartDetector::expectedDistance(const Odometry::Pose& robot, const Mount& mount) {
+    // Sensor position: robot center + mount offset, turned with the robot
+    double heading = robot.heading * Odometry::DEGREES_TO_RADIANS;
+    double x = robot.x + mount.x * std::cos(heading) + mount.y * std::sin(heading);
+    double y = robot.y - mount.x * std::sin(heading) + mount.y * std::cos(heading);
+    
+    // Along the beam to the first wall it reaches
+    double beam = (robot.heading + mount.angle) * Odometry::DEGREES_TO_RADIANS;
+    double dx = std::sin(beam);
+    double dy = std::cos(beam);
+    double distance = INFINITY;
+    if (std::fabs(dx) > 1e-9) {
+        distance = std::fmin(distance, ((dx > 0.0 ? FIELD_HALF_SIZE : -FIELD_HALF_SIZE) - x) / dx);
+    }
+    if (std::fabs(dy) > 1e-9) {
+        distance = std::fmin(distance, ((dy > 0.0 ? FIELD_HALF_SIZE : -FIELD_HALF_SIZE) - y) / dy);
+    }
+    return (distance > MAX_RANGE) ? -1.0 : distance;
+}
+
+double StartDetector::poseError(const Odometry::Pose& pose) const {
+    if (sensorCount == 0) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < sensorCount; i++) {
+        double expected = expectedDistance(pose, sensors[i]);
+        double measured = average(i);
+        double difference;
+        if (expected < 0.0 && measured < 0.0) {
+            difference = 0.0;
+        } else if (expected < 0.0 || measured < 0.0) {
+            difference = BLOCKED_ERROR;
+        } else {
+            difference = std::fmin(std::fabs(measured - expected), BLOCKED_ERROR);
+        }
+        sum += difference * difference;
+    }
+    return std::sqrt(sum / sensorCount);
+}
+
+double StartDetector::average(int sensor) const {
+    // Mostly nothing in range: treat as nothing in range
+    if (hits[sensor] * 2 < samples) {
+        return -1.0;
+    }
+    return sums[sensor] / hits[sensor];
+}
+
+void StartDetector::match() {
+    // Best of every start pose facing every way
+    int bestStart = -1;
+    int bestTurn = 0;
+    double bestError = INFINITY;
+    for (int s = 0; s < startCount; s++) {
+        for (int turn = 0; turn < 4; turn++) {
+            Odometry::Pose pose = starts[s];
+            pose.heading = Odometry::wrapHeading(pose.heading + 90.0 * turn);
+            double poseErr = poseError(pose);
+            if (poseErr < bestError) {
+                bestStart = s;
+                bestTurn = turn;
+                bestError = poseErr;
+            }
+        }
+    }
+    
+    // Next best pose somewhere else (two routines from the same pose: the first one added)
+    double nextError = INFINITY;
+    Odometry::Pose best = (bestStart >= 0) ? starts[bestStart] : Odometry::Pose{0.0, 0.0, 0.0};
+    best.heading = Odometry::wrapHeading(best.heading + 90.0 * bestTurn);
+    for (int s = 0; s < startCount; s++) {
+        for (int turn = 0; turn < 4; turn++) {
+            Odometry::Pose pose = starts[s];
+            pose.heading = Odometry::wrapHeading(pose.heading + 90.0 * turn);
+            bool samePose = std::fabs(pose.x - best.x) < 1.0 && std::fabs(pose.y - best.y) < 1.0 &&
+                            std::fabs(Odometry::headingDifference(pose.heading, best.heading)) < 1.0;
+            if (samePose) {
+                // Prefer a routine that starts facing this way over one turned to it
+                if (turn == 0 && bestTurn != 0) {
+                    bestStart = s;
+                    bestTurn = 0;
+                }
+                continue;
+            }
+            nextError = std::fmin(nextError, poseError(pose));
+        }
+    }
+    
+    error = bestError;
+    runnerUpError = nextError;
+    if (bestStart >= 0 && bestError <= MAX_ERROR && nextError - bestError >= MIN_MARGIN) {
+        start = bestStart;
+        headingError = 90.0 * bestTurn;
+        status = (bestTurn == 0) ? DETECTED : WRONG_HEADING;
+    } else {
+        start = -1;
+        headingError = 0.0;
+        status = UNKNOWN;
+    }
+}
@@ -0,0 +1,192 @@
+/*
+ * StartDetector.h
+ * 
+ * This header defines the StartDetector class, which works out which starting tile the
+ * robot was placed on, and which way it faces, before the match starts, so the matching
+ * autonomous routine can be selected without anyone picking it by hand.
+ * 
+ * Each autonomous routine registers its start pose. Distance sensors on the robot measure
+ * how far the field walls are; for each start pose, facing its own way and the three
+ * other ways, the detector works out what the sensors would measure there and picks the
+ * pose that matches best. A sensor blocked by something (a partner robot, a game element)
+ * only costs a limited amount, so one bad reading doesn't hide the right tile.
+ * 
+ * Readings are averaged while the robot is still. The inertial heading tells when the
+ * robot is moved or turned (being placed, straightened): the average starts over.
+ * 
+ * Field conventions are the same as Odometry (inches, origin at the field center,
+ * heading clockwise from +y).
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef STARTDETECTOR_H
+#define STARTDETECTOR_H
+
+#include "Odometry.h"
+
+/**
+ * StartDetector Class
+ * 
+ * Usage:
+ *   1. addSensor() for each distance sensor, addStart() for each routine's start pose
+ *   2. While disabled before the match: update() with the readings and inertial heading
+ *   3. getStatus() / getStart(): the routine to run
+ */
+class StartDetector {
+public:
+    /**
+     * What the detector knows
+     */
+    enum Status {
+        WAITING,         // Averaging readings (robot just placed or moved)
+        DETECTED,        // On a routine's start pose, facing its way
+        WRONG_HEADING,   // On a routine's start tile, but facing another way
+        UNKNOWN          // No start pose matches, or two match about as well
+    };
+    
+    /**
+     * Most distance sensors and start poses
+     */
+    static const int MAX_SENSORS = 4;
+    static const int MAX_STARTS = 8;
+    
+    /**
+     * Where a distance sensor is on the robot
+     */
+    struct Mount {
+        double x;       // Inches right of the robot's center
+        double y;       // Inches forward of the robot's center
+        double angle;   // Direction it faces, degrees clockwise from the robot's front
+    };
+    
+    /**
+     * Field half size (walls at +/- this, inches) and the farthest a distance sensor
+     * measures (2 m)
+     */
+    static constexpr double FIELD_HALF_SIZE = 72.0;
+    static constexpr double MAX_RANGE = 78.0;
+    
+    /**
+     * Readings averaged before a detection (one per update())
+     */
+    static const int SAMPLE_COUNT = 10;
+    
+    /**
+     * The robot counts as moved when its heading changes this much (degrees) or a
+     * reading jumps this much (inches) from the average so far
+     */
+    static constexpr double MOVE_DEGREES = 3.0;
+    static constexpr double MOVE_INCHES = 3.0;
+    
+    /**
+     * Most a single sensor adds to a pose's error (inches): a blocked sensor, or one
+     * that sees a wall where none was expected
+     */
+    static constexpr double BLOCKED_ERROR = 12.0;
+    
+    /**
+     * A match: RMS error (inches) at most MAX_ERROR, and at least MIN_MARGIN better
+     * than the next best pose
+     */
+    static constexpr double MAX_ERROR = 4.0;
+    static constexpr double MIN_MARGIN = 2.0;
+    
+    /**
+     * Constructor: no sensors, no start poses
+     */
+    StartDetector();
+    
+    /**
+     * Add a distance sensor (readings are passed in this order)
+     * 
+     * @return false if there are already MAX_SENSORS
+     */
+    bool addSensor(const Mount& mount);
+    
+    /**
+     * Add a routine's start pose
+     * 
+     * @return The start's number (0, 1, ...), or -1 if there are already MAX_STARTS
+     */
+    int addStart(const Odometry::Pose& pose);
+    
+    /**
+     * Forget the readings (back to WAITING)
+     */
+    void restart();
+    
+    /**
+     * Add one set of readings
+     * 
+     * @param distances Distance per sensor (inches; negative = nothing in range)
+     * @param headingDeg Inertial heading (degrees, any zero)
+     * @return Status after the update
+     */
+    Status update(const double distances[], double headingDeg);
+    
+    Status getStatus() const;
+    
+    /**
+     * Start pose the robot is on (DETECTED or WRONG_HEADING), else -1
+     */
+    int getStart() const;
+    
+    /**
+     * How far the robot is turned from that start's heading (0, 90, 180 or 270; clockwise)
+     */
+    double getHeadingError() const;
+    
+    /**
+     * RMS error of the best pose, and of the next best (inches)
+     */
+    double getError() const;
+    double getRunnerUpError() const;
+    
+    /**
+     * Where the robot's center is estimated to be (the best pose, or the field center
+     * before a detection)
+     */
+    Odometry::Pose getPose() const;
+    
+    /**
+     * What a sensor would measure with the robot at a pose (nothing but the walls)
+     * 
+     * @return Inches, or -1 if the wall is out of range
+     */
+    static double expectedDistance(const Odometry::Pose& robot, const Mount& mount);
+    
+    /**
+     * RMS error of the averaged readings against a pose (inches)
+     */
+    double poseError(const Odometry::Pose& pose) const;
+    
+private:
+    Mount sensors[MAX_SENSORS];
+    int sensorCount;
+    Odometry::Pose starts[MAX_STARTS];
+    int startCount;
+    
+    // Averaging (inches; "nothing in range" readings are counted separately)
+    double sums[MAX_SENSORS];
+    int hits[MAX_SENSORS];
+    int samples;
+    double firstHeading;
+    
+    Status status;
+    int start;
+    double headingError;
+    double error;
+    double runnerUpError;
+    
+    /**
+     * Averaged reading of a sensor (-1 if it mostly saw nothing)
+     */
+    double average(int sensor) const;
+    
+    /**
+     * Score every start pose facing every way
+     */
+    void match();
+};
+
+#endif // STARTDETECTOR_H
@@ -0,0 +1,96 @@
+/*
+ * Telemetry.cpp
+ * 
+ * Implementation of telemetry and dashboard text formatting.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "Telemetry.h"
+
+#include <cstdio>
+
+int Telemetry::finish(int written, int bufferSize) {
+    // snprintf returns the length it WANTED to write; report what actually fit
+    if (written < 0 || bufferSize <= 0) {
+        return 0;
+    }
+    if (written >= bufferSize) {
+        return bufferSize - 1;
+    }
+    return written;
+}
+
+int Telemetry::formatEnergyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                  const EnergyMonitor& energy, const BatteryModel& battery) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "ENERGY,%lu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.0f",
+                                static_cast<unsigned long>(timestampMs),
+                                energy.getEnergy(EnergyMonitor::DRIVE),
+                                energy.getEnergy(EnergyMonitor::INTAKE),
+                                energy.getEnergy(EnergyMonitor::RAMP),
+                                energy.getEnergy(EnergyMonitor::FULL_POWER_RAMP),
+                                energy.getTotalPower(),
+                                battery.getStateOfCharge(),
+                                battery.getInternalResistance() * 1000.0);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatEnergyDashboard(char* buffer, int bufferSize, const EnergyMonitor& energy) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "Drv %.0f%% Int %.0f%% Rmp %.0f%% Top %.0f%%",
+                                energy.getShare(EnergyMonitor::DRIVE) * 100.0,
+                                energy.getShare(EnergyMonitor::INTAKE) * 100.0,
+                                energy.getShare(EnergyMonitor::RAMP) * 100.0,
+                                energy.getShare(EnergyMonitor::FULL_POWER_RAMP) * 100.0);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatBatteryDashboard(char* buffer, int bufferSize, const BatteryModel& battery) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    BatteryModel::State state = battery.getState();
+    int written = std::snprintf(buffer, bufferSize, "Batt %.0f%% R %.0fmOhm Match %d",
+                                state.stateOfCharge, state.internalResistance * 1000.0, state.matchCount);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatLatencyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                   const char* name, const LatencyStats& stats) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "LATENCY,%lu,%s,%lu,%.0f,%lu,%lu",
+                                (unsigned long)timestampMs, name, (unsigned long)stats.getCount(),
+                                stats.getMean(), (unsigned long)stats.getPercentile(95.0),
+                                (unsigned long)stats.getMax());
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatMotorLayout(char* buffer, int bufferSize) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "MOTORS_LAYOUT,rpm;amps;celsius");
+    for (int i = 0; i < RobotDescriptor::MOTOR_COUNT && written >= 0 && written < bufferSize; i++) {
+        written += std::snprintf(buffer + written, bufferSize - written, ",%s", RobotDescriptor::MOTORS[i].name);
+    }
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatMotorRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                 const double rpm[], const double amps[], const double celsius[]) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "MOTORS,%lu", (unsigned long)timestampMs);
+    for (int i = 0; i < RobotDescriptor::MOTOR_COUNT && written >= 0 && written < bufferSize; i++) {
+        written += std::snprintf(buffer + written, bufferSize - written, ",%.0f,%.1f,%.0f",
+                                 rpm[i], amps[i], celsius[i]);
+    }
+    return finish(written, bufferSize);
+}
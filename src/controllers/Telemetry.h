@@ -0,0 +1,114 @@
+/*
+ * Telemetry.h
+ * 
+ * This header defines the Telemetry class, which formats robot data as text.
+ * - Telemetry lines: comma-separated values printed over the USB/radio serial link,
+ *   one line per record, easy to paste into a spreadsheet
+ * - Dashboard lines: short human-readable lines for the Brain screen
+ * 
+ * Formatting is separated from printing so the exact output can be unit tested.
+ * All functions write into a caller-provided buffer - no dynamic allocation.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <cstdint>
+
+#include "BatteryModel.h"
+#include "EnergyMonitor.h"
+#include "LatencyStats.h"
+#include "RobotDescriptor.h"
+
+/**
+ * Telemetry Class
+ * 
+ * Pure formatting functions. Each returns the number of characters written
+ * (not counting the terminating '\0'), truncating safely if the buffer is too small.
+ */
+class Telemetry {
+public:
+    /**
+     * Format an energy telemetry record
+     * 
+     * Layout: ENERGY,<time ms>,<drive J>,<intake J>,<ramp J>,<full power ramp J>,
+     *         <total W>,<state of charge %>,<internal resistance mOhm>
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param energy Energy totals
+     * @param battery Battery model
+     * @return Characters written
+     */
+    static int formatEnergyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                  const EnergyMonitor& energy, const BatteryModel& battery);
+    
+    /**
+     * Format the energy split for the Brain screen, e.g. "Drv 62% Int 12% Rmp 9% Top 17%"
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param energy Energy totals
+     * @return Characters written
+     */
+    static int formatEnergyDashboard(char* buffer, int bufferSize, const EnergyMonitor& energy);
+    
+    /**
+     * Format the battery state for the Brain screen, e.g. "Batt 87% R 85mOhm Match 3"
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param battery Battery model
+     * @return Characters written
+     */
+    static int formatBatteryDashboard(char* buffer, int bufferSize, const BatteryModel& battery);
+    
+    /**
+     * Format a latency distribution record
+     * 
+     * Layout: LATENCY,<time ms>,<name>,<count>,<mean us>,<p95 us>,<max us>
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param name What was measured (e.g. "input")
+     * @param stats The distribution
+     * @return Characters written
+     */
+    static int formatLatencyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                   const char* name, const LatencyStats& stats);
+    
+    /**
+     * Format the per-motor record layout (print once at startup)
+     * One column group per motor, in RobotDescriptor::MOTORS order.
+     * 
+     * Layout: MOTORS_LAYOUT,rpm;amps;celsius,<motor 0 name>,<motor 1 name>,...
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @return Characters written
+     */
+    static int formatMotorLayout(char* buffer, int bufferSize);
+    
+    /**
+     * Format a per-motor record (columns as in formatMotorLayout())
+     * 
+     * Layout: MOTORS,<time ms>,<rpm>,<amps>,<celsius>,... (three values per motor)
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param rpm Speed of each motor (RobotDescriptor::MOTOR_COUNT values)
+     * @param amps Current of each motor
+     * @param celsius Temperature of each motor
+     * @return Characters written
+     */
+    static int formatMotorRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                 const double rpm[], const double amps[], const double celsius[]);
+    
+private:
+    static int finish(int written, int bufferSize);
+};
+
+#endif // TELEMETRY_H
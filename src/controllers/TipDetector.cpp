@@ -0,0 +1,151 @@
+/*
+ * TipDetector.cpp
+ * 
+ * Implementation of tip and collision detection.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "TipDetector.h"
+
+#include <cmath>
+
+TipDetector::TipDetector(bool dropHeightOnTip)
+    : dropHeightOnTip(dropHeightOnTip),
+      hasReading(false),
+      lastMs(0),
+      pitch(0.0),
+      roll(0.0),
+      pitchRate(0.0),
+      rollRate(0.0),
+      lastAccelForward(0.0),
+      lastAccelRight(0.0),
+      tipping(false),
+      tipDirection(BACK),
+      collisionRecent(false),
+      lastCollisionMs(0),
+      eventStart(0),
+      eventCount(0),
+      droppedEvents(0) {
+}
+
+void TipDetector::update(uint32_t timestampMs, double newPitch, double newRoll,
+                         double accelForward, double accelRight) {
+    if (!hasReading) {
+        hasReading = true;
+        lastMs = timestampMs;
+        pitch = newPitch;
+        roll = newRoll;
+        lastAccelForward = accelForward;
+        lastAccelRight = accelRight;
+        return;
+    }
+    if (timestampMs == lastMs) {
+        return;  // Same reading again
+    }
+    double dt = (timestampMs - lastMs) / 1000.0;
+    lastMs = timestampMs;
+    
+    // Tilt rates (smoothed - the raw difference is noisy at full sensor rate)
+    pitchRate += ((newPitch - pitch) / dt - pitchRate) * RATE_FILTER;
+    rollRate += ((newRoll - roll) / dt - rollRate) * RATE_FILTER;
+    pitch = newPitch;
+    roll = newRoll;
+    
+    // Collisions: jerk = change in horizontal acceleration per second
+    double jerkForward = (accelForward - lastAccelForward) / dt;
+    double jerkRight = (accelRight - lastAccelRight) / dt;
+    lastAccelForward = accelForward;
+    lastAccelRight = accelRight;
+    double jerk = std::sqrt(jerkForward * jerkForward + jerkRight * jerkRight);
+    
+    if (collisionRecent && timestampMs - lastCollisionMs >= COLLISION_HOLDOFF_MS) {
+        collisionRecent = false;
+    }
+    if (!collisionRecent && jerk >= COLLISION_JERK) {
+        // Direction of the hit: a hit on the front pushes the robot backward
+        Direction direction;
+        if (std::fabs(jerkForward) >= std::fabs(jerkRight)) {
+            direction = (jerkForward < 0.0) ? FRONT : BACK;
+        } else {
+            direction = (jerkRight < 0.0) ? RIGHT : LEFT;
+        }
+        collisionRecent = true;
+        lastCollisionMs = timestampMs;
+        publish(COLLISION, direction, timestampMs, jerk);
+    }
+    
+    // Tipping: now, or soon at the current rate
+    double predictedPitch = pitch + pitchRate * PREDICT_SECONDS;
+    double predictedRoll = roll + rollRate * PREDICT_SECONDS;
+    bool pitchTip = std::fabs(predictedPitch) >= TIP_ANGLE || std::fabs(pitch) >= TIP_ANGLE;
+    bool rollTip = std::fabs(predictedRoll) >= TIP_ANGLE || std::fabs(roll) >= TIP_ANGLE;
+    
+    if (!tipping && (pitchTip || rollTip)) {
+        tipping = true;
+        if (pitchTip && (!rollTip || std::fabs(predictedPitch) >= std::fabs(predictedRoll))) {
+            tipDirection = (predictedPitch > 0.0) ? BACK : FRONT;
+        } else {
+            tipDirection = (predictedRoll > 0.0) ? RIGHT : LEFT;
+        }
+        publish(TIP_WARNING, tipDirection, timestampMs, std::fmax(std::fabs(predictedPitch), std::fabs(predictedRoll)));
+    } else if (tipping && std::fabs(pitch) < CLEAR_ANGLE && std::fabs(roll) < CLEAR_ANGLE) {
+        tipping = false;
+        publish(TIP_CLEARED, tipDirection, timestampMs, std::fmax(std::fabs(pitch), std::fabs(roll)));
+    }
+}
+
+bool TipDetector::isTipping() const {
+    return tipping;
+}
+
+int TipDetector::getCorrectionPower() const {
+    if (!tipping || (tipDirection != FRONT && tipDirection != BACK)) {
+        return 0;
+    }
+    
+    // Drive toward the side going down (at least a little while the tip is still predicted)
+    double excess = std::fmax(std::fabs(pitch) - CLEAR_ANGLE, 0.0);
+    double power = std::fmin(CORRECTION_GAIN * excess + MAX_CORRECTION / 3.0, (double)MAX_CORRECTION);
+    return (tipDirection == BACK) ? -(int)power : (int)power;
+}
+
+bool TipDetector::shouldDropHeight() const {
+    return tipping && dropHeightOnTip;
+}
+
+bool TipDetector::pollEvent(Event& event) {
+    if (eventCount == 0) {
+        return false;
+    }
+    event = events[eventStart];
+    eventStart = (eventStart + 1) % EVENT_CAPACITY;
+    eventCount--;
+    return true;
+}
+
+int TipDetector::getEventCount() const {
+    return eventCount;
+}
+
+int TipDetector::getDroppedEventCount() const {
+    return droppedEvents;
+}
+
+double TipDetector::getPredictedTilt() const {
+    return std::fmax(std::fabs(pitch + pitchRate * PREDICT_SECONDS), std::fabs(roll + rollRate * PREDICT_SECONDS));
+}
+
+void TipDetector::publish(EventType type, Direction direction, uint32_t timestampMs, double magnitude) {
+    if (eventCount == EVENT_CAPACITY) {
+        // Full: drop the oldest so the newest is always there
+        eventStart = (eventStart + 1) % EVENT_CAPACITY;
+        eventCount--;
+        droppedEvents++;
+    }
+    Event& event = events[(eventStart + eventCount) % EVENT_CAPACITY];
+    event.type = type;
+    event.direction = direction;
+    event.timestampMs = timestampMs;
+    event.magnitude = magnitude;
+    eventCount++;
+}
@@ -0,0 +1,186 @@
+/*
+ * TipDetector.h
+ * 
+ * This header defines the TipDetector class, which watches the inertial sensor for
+ * two things:
+ * - Tipping: pitch or roll getting large, or heading there fast (predicted a little
+ *   ahead from the tilt rate). With the wheel raised to HIGH the robot tips more easily.
+ * - Collisions: sudden changes in acceleration (jerk) from being hit or hitting something.
+ * 
+ * On a tip it suggests a corrective drive power (drive toward the side that is going
+ * down, which puts the wheels back under the robot) and whether to drop to LOW height.
+ * Both tips and collisions are published as events that autonomous can read.
+ * 
+ * Signs: pitch > 0 = front up (tipping backward), roll > 0 = right side down.
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef TIPDETECTOR_H
+#define TIPDETECTOR_H
+
+#include <cstdint>
+
+/**
+ * TipDetector Class
+ * 
+ * Usage:
+ *   1. update() with every inertial reading (as fast as the sensor runs)
+ *   2. While isTipping(): drive with getCorrectionPower(), drop height if shouldDropHeight()
+ *   3. pollEvent() to react to tips and collisions
+ */
+class TipDetector {
+public:
+    /**
+     * Kinds of event
+     */
+    enum EventType {
+        TIP_WARNING,   // Tipping started
+        TIP_CLEARED,   // Back on the ground
+        COLLISION      // Hit something (or got hit)
+    };
+    
+    /**
+     * Direction of a tip or collision, relative to the robot
+     */
+    enum Direction {
+        FRONT,
+        BACK,
+        LEFT,
+        RIGHT
+    };
+    
+    /**
+     * One published event
+     */
+    struct Event {
+        EventType type;
+        Direction direction;
+        uint32_t timestampMs;
+        double magnitude;   // Tilt in degrees (tips) or jerk in g/s (collisions)
+    };
+    
+    /**
+     * Tilt that counts as tipping (degrees)
+     */
+    static constexpr double TIP_ANGLE = 15.0;
+    
+    /**
+     * Tilt must be below this to count as back on the ground (degrees)
+     */
+    static constexpr double CLEAR_ANGLE = 6.0;
+    
+    /**
+     * How far ahead the tilt is predicted from its rate (seconds)
+     */
+    static constexpr double PREDICT_SECONDS = 0.15;
+    
+    /**
+     * Tilt rate smoothing weight for the newest reading (0-1)
+     */
+    static constexpr double RATE_FILTER = 0.3;
+    
+    /**
+     * Corrective drive power per degree of pitch over CLEAR_ANGLE (percent)
+     */
+    static constexpr double CORRECTION_GAIN = 4.0;
+    
+    /**
+     * Most corrective drive power (percent)
+     */
+    static const int MAX_CORRECTION = 60;
+    
+    /**
+     * Jerk that counts as a collision (g per second)
+     */
+    static constexpr double COLLISION_JERK = 40.0;
+    
+    /**
+     * Ignore further collisions for this long after one (ms)
+     */
+    static const uint32_t COLLISION_HOLDOFF_MS = 250;
+    
+    /**
+     * Events kept until polled (oldest dropped when full)
+     */
+    static const int EVENT_CAPACITY = 16;
+    
+    /**
+     * Create a detector
+     * 
+     * @param dropHeightOnTip true = suggest LOW height when tipping starts
+     */
+    TipDetector(bool dropHeightOnTip = true);
+    
+    /**
+     * Add one inertial reading
+     * 
+     * @param timestampMs When it was measured
+     * @param pitch Degrees (front up positive)
+     * @param roll Degrees (right down positive)
+     * @param accelForward Forward acceleration (g)
+     * @param accelRight Sideways acceleration (g)
+     */
+    void update(uint32_t timestampMs, double pitch, double roll, double accelForward, double accelRight);
+    
+    /**
+     * True while tipping
+     */
+    bool isTipping() const;
+    
+    /**
+     * Drive power to apply to both sides while tipping (percent, 0 if not tipping)
+     * Positive = forward. Sideways tips can't be driven out of, so they give 0.
+     */
+    int getCorrectionPower() const;
+    
+    /**
+     * True while tipping and the height should be dropped to LOW
+     */
+    bool shouldDropHeight() const;
+    
+    /**
+     * Take the oldest unread event
+     * 
+     * @param event Output: the event
+     * @return false if there are none
+     */
+    bool pollEvent(Event& event);
+    
+    /**
+     * Number of unread events
+     */
+    int getEventCount() const;
+    
+    /**
+     * Events lost because nobody read them in time
+     */
+    int getDroppedEventCount() const;
+    
+    /**
+     * Predicted tilt (degrees) after PREDICT_SECONDS
+     */
+    double getPredictedTilt() const;
+    
+private:
+    bool dropHeightOnTip;
+    bool hasReading;
+    uint32_t lastMs;
+    double pitch;
+    double roll;
+    double pitchRate;      // Degrees per second (filtered)
+    double rollRate;
+    double lastAccelForward;
+    double lastAccelRight;
+    bool tipping;
+    Direction tipDirection;
+    bool collisionRecent;
+    uint32_t lastCollisionMs;
+    Event events[EVENT_CAPACITY];
+    int eventStart;
+    int eventCount;
+    int droppedEvents;
+    
+    void publish(EventType type, Direction direction, uint32_t timestampMs, double magnitude);
+};
+
+#endif // TIPDETECTOR_H
@@ -0,0 +1,90 @@
+/*
+ * TripleBuffer.h
+ * 
+ * This header defines the TripleBuffer class, which hands the latest value of something
+ * (e.g. a controller snapshot) from one task to another without locks and without
+ * either side ever waiting.
+ * 
+ * Three copies of the value: the writer fills one, the reader reads another, and the
+ * third holds the most recent finished value. Publishing and taking are a single
+ * atomic exchange of which copy is which. The reader always gets a complete value
+ * (never half of an old one and half of a new one); values the reader was too slow
+ * to see are simply skipped.
+ * 
+ * Exactly one writer task and one reader task.
+ * Uses only <atomic>: works with vex::task on the robot and std::thread on the host.
+ * Header only (template). No hardware dependencies, fully testable!
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * TripleBuffer Class
+ * 
+ * Usage:
+ *   Writer task: write(value) whenever there is a new value
+ *   Reader task: read(value) - returns true if the value is new since the last read
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * Create a buffer holding three default values
+     */
+    TripleBuffer()
+        : middle(1),
+          back(2),
+          front(0) {
+    }
+    
+    /**
+     * Publish a value (writer task only; never waits)
+     * 
+     * @param value The new value
+     */
+    void write(const T& value) {
+        buffers[back] = value;
+        // Swap the filled copy into the middle, marked fresh; take the old middle to fill next
+        uint8_t previous = middle.exchange((uint8_t)(back | FRESH_BIT), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+    
+    /**
+     * Get the latest value (reader task only; never waits)
+     * 
+     * @param value Output: the latest published value (or the last one read if nothing new)
+     * @return true if it is new since the last read
+     */
+    bool read(T& value) {
+        bool fresh = (middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+        if (fresh) {
+            // Swap our old copy into the middle (not fresh) and take the new one
+            uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+            front = previous & INDEX_MASK;
+        }
+        value = buffers[front];
+        return fresh;
+    }
+    
+    /**
+     * True if a value was published since the last read (either task)
+     */
+    bool hasNew() const {
+        return (middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+    
+private:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH_BIT = 0x04;
+    
+    T buffers[3];
+    std::atomic<uint8_t> middle;   // Index of the middle copy + FRESH_BIT (shared)
+    uint8_t back;                  // Writer's copy (writer only)
+    uint8_t front;                 // Reader's copy (reader only)
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,107 @@
+/*
+ * VelocityEstimator.cpp
+ * 
+ * Implementation of timestamp-aware encoder velocity estimation.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "VelocityEstimator.h"
+
+VelocityEstimator::VelocityEstimator(FilterType filter, int windowSize, double alpha, double beta)
+    : filter(filter), alpha(alpha), beta(beta) {
+    // Bounds check: a slope needs at least 2 points and must fit in the buffer
+    if (windowSize < 2) {
+        windowSize = 2;
+    }
+    if (windowSize > MAX_WINDOW) {
+        windowSize = MAX_WINDOW;
+    }
+    this->windowSize = windowSize;
+    reset();
+}
+
+void VelocityEstimator::reset() {
+    newest = -1;
+    count = 0;
+    firstTimestampMs = 0;
+    lastTimestampMs = 0;
+    trackedPosition = 0.0;
+    velocity = 0.0;
+}
+
+bool VelocityEstimator::addSample(uint32_t timestampMs, double position) {
+    // Same device timestamp = same reading read twice; using it would fake a zero velocity
+    if (count > 0 && timestampMs == lastTimestampMs) {
+        return false;
+    }
+    if (count == 0) {
+        firstTimestampMs = timestampMs;
+    }
+    
+    // Seconds since the first reading (small numbers keep the least-squares math accurate)
+    double time = static_cast<double>(timestampMs - firstTimestampMs) / 1000.0;
+    double dt = static_cast<double>(timestampMs - lastTimestampMs) / 1000.0;
+    lastTimestampMs = timestampMs;
+    
+    newest = (newest + 1) % windowSize;
+    times[newest] = time;
+    positions[newest] = position;
+    if (count < windowSize) {
+        count++;
+    }
+    
+    if (filter == ALPHA_BETA) {
+        if (count == 1) {
+            trackedPosition = position;
+            velocity = 0.0;
+        } else {
+            // Predict where the motor should be now, then correct by the measured error
+            double predicted = trackedPosition + velocity * dt;
+            double error = position - predicted;
+            trackedPosition = predicted + alpha * error;
+            velocity = velocity + (beta / dt) * error;
+        }
+    } else {
+        velocity = computeSlope();
+    }
+    return true;
+}
+
+double VelocityEstimator::computeSlope() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    
+    // Least-squares line through (time, position): slope = cov(t, p) / var(t)
+    double meanTime = 0.0;
+    double meanPosition = 0.0;
+    for (int i = 0; i < count; i++) {
+        meanTime += times[i];
+        meanPosition += positions[i];
+    }
+    meanTime /= count;
+    meanPosition /= count;
+    
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (int i = 0; i < count; i++) {
+        double timeOffset = times[i] - meanTime;
+        covariance += timeOffset * (positions[i] - meanPosition);
+        variance += timeOffset * timeOffset;
+    }
+    
+    // Can't happen with distinct timestamps, but never divide by zero
+    if (variance <= 0.0) {
+        return 0.0;
+    }
+    return covariance / variance;
+}
+
+double VelocityEstimator::getVelocity() const {
+    return velocity;
+}
+
+double VelocityEstimator::getRpm() const {
+    // degrees/second -> revolutions/minute: * 60 / 360
+    return velocity / 6.0;
+}
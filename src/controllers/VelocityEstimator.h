@@ -0,0 +1,102 @@
+/*
+ * VelocityEstimator.h
+ * 
+ * This header defines the VelocityEstimator class, which estimates how fast a motor
+ * is turning from its encoder position AND the time the motor actually took that reading.
+ * 
+ * Why not just (position - lastPosition) / 20 ms?
+ * - The control loop never runs exactly every 20 ms
+ * - Motors send a new reading about every 10 ms, so a loop tick can see the same
+ *   reading twice (zero velocity) or skip one (double velocity)
+ * Using the device timestamp of each reading removes both errors.
+ * 
+ * Memory: fixed-size ring buffer, no dynamic allocation.
+ */
+
+#ifndef VELOCITYESTIMATOR_H
+#define VELOCITYESTIMATOR_H
+
+#include <cstdint>
+
+/**
+ * VelocityEstimator Class
+ * 
+ * One instance per motor. Feed it (timestamp, position) every tick; it ignores
+ * repeated readings and filters the rest with the selected filter.
+ */
+class VelocityEstimator {
+public:
+    /**
+     * Filter used to turn positions into a velocity
+     */
+    enum FilterType {
+        // Least-squares slope over the last N readings (a first-order Savitzky-Golay
+        // derivative, generalized to uneven sample spacing). Smooth, but lags by about
+        // half the window.
+        SAVITZKY_GOLAY = 0,
+        // Alpha-beta tracker: predicts position, corrects with a fraction of the error
+        ALPHA_BETA = 1
+    };
+    
+    /**
+     * Largest supported Savitzky-Golay window
+     */
+    static const int MAX_WINDOW = 16;
+    
+    /**
+     * Create an estimator
+     * 
+     * @param filter Filter type
+     * @param windowSize Readings used by SAVITZKY_GOLAY (2 to MAX_WINDOW, clamped)
+     * @param alpha ALPHA_BETA position correction gain (0-1)
+     * @param beta ALPHA_BETA velocity correction gain (0-1, usually much smaller than alpha)
+     */
+    VelocityEstimator(FilterType filter = SAVITZKY_GOLAY, int windowSize = 6,
+                      double alpha = 0.5, double beta = 0.1);
+    
+    /**
+     * Add an encoder reading
+     * 
+     * @param timestampMs Time the DEVICE took the reading (motor.timestamp()), not loop time
+     * @param position Encoder position (degrees)
+     * @return true if this was a new reading, false if it was a repeat and was ignored
+     */
+    bool addSample(uint32_t timestampMs, double position);
+    
+    /**
+     * Latest velocity estimate in degrees per second (0 until two readings arrive)
+     */
+    double getVelocity() const;
+    
+    /**
+     * Latest velocity estimate in RPM
+     */
+    double getRpm() const;
+    
+    /**
+     * Forget all readings (e.g. after resetting the encoder)
+     */
+    void reset();
+    
+private:
+    double computeSlope() const;
+    
+    FilterType filter;
+    int windowSize;
+    double alpha;
+    double beta;
+    
+    // Ring buffer of recent readings (time stored in seconds relative to the first reading)
+    double times[MAX_WINDOW];
+    double positions[MAX_WINDOW];
+    int newest;
+    int count;
+    uint32_t firstTimestampMs;
+    uint32_t lastTimestampMs;
+    
+    // Alpha-beta tracker state
+    double trackedPosition;
+    double velocity;
+};
+
+#endif // VELOCITYESTIMATOR_H
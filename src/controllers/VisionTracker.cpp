@@ -0,0 +1,160 @@
+/*
+ * VisionTracker.cpp
+ * 
+ * Implementation of vision ball tracking.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "VisionTracker.h"
+
+#include <cmath>
+
+VisionTracker::VisionTracker(int ballSignature)
+    : trackCount(0),
+      nextId(1),
+      ballSignature(ballSignature),
+      targetId(-1) {
+}
+
+void VisionTracker::reset() {
+    trackCount = 0;
+    targetId = -1;
+}
+
+void VisionTracker::setBallSignature(int signature) {
+    ballSignature = signature;
+    selectTarget();
+}
+
+int VisionTracker::update(const Detection* detections, int count) {
+    if (count > MAX_DETECTIONS) {
+        count = MAX_DETECTIONS;
+    }
+    
+    // Greedy nearest match: each track takes the closest free detection of its color
+    bool used[MAX_DETECTIONS] = {false};
+    for (int t = 0; t < trackCount; t++) {
+        Track& track = tracks[t];
+        int best = -1;
+        double bestDistance = MATCH_GATE_PX;
+        for (int d = 0; d < count; d++) {
+            if (used[d] || detections[d].signature != track.signature) {
+                continue;
+            }
+            double dx = detections[d].centerX - track.centerX;
+            double dy = detections[d].centerY - track.centerY;
+            double distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < bestDistance) {
+                best = d;
+                bestDistance = distance;
+            }
+        }
+        
+        if (best < 0) {
+            track.misses++;
+            continue;
+        }
+        used[best] = true;
+        const Detection& seen = detections[best];
+        track.centerX += (seen.centerX - track.centerX) * SMOOTHING;
+        track.centerY += (seen.centerY - track.centerY) * SMOOTHING;
+        track.width += (seen.width - track.width) * SMOOTHING;
+        track.height += (seen.height - track.height) * SMOOTHING;
+        track.hits++;
+        track.misses = 0;
+    }
+    
+    // Drop tracks that have been missing too long (keep the array packed)
+    int kept = 0;
+    for (int t = 0; t < trackCount; t++) {
+        if (tracks[t].misses < DROP_AFTER_MISSES) {
+            tracks[kept++] = tracks[t];
+        }
+    }
+    trackCount = kept;
+    
+    // New tracks for unmatched detections while there is room
+    for (int d = 0; d < count && trackCount < MAX_TRACKS; d++) {
+        if (used[d]) {
+            continue;
+        }
+        Track& track = tracks[trackCount++];
+        track.id = nextId++;
+        track.centerX = detections[d].centerX;
+        track.centerY = detections[d].centerY;
+        track.width = detections[d].width;
+        track.height = detections[d].height;
+        track.signature = detections[d].signature;
+        track.hits = 1;
+        track.misses = 0;
+    }
+    
+    for (int t = 0; t < trackCount; t++) {
+        tracks[t].distanceMm = distanceFromWidth(tracks[t].width);
+        tracks[t].bearingDeg = bearingFromX(tracks[t].centerX);
+    }
+    selectTarget();
+    return trackCount;
+}
+
+const VisionTracker::Track* VisionTracker::getTarget() const {
+    int index = findTrack(targetId);
+    return (index < 0) ? nullptr : &tracks[index];
+}
+
+int VisionTracker::getTrackCount() const {
+    return trackCount;
+}
+
+const VisionTracker::Track& VisionTracker::getTrack(int index) const {
+    return tracks[index];
+}
+
+bool VisionTracker::isValidBall(const Track& track) const {
+    if (track.signature != ballSignature || track.hits < CONFIRM_FRAMES || track.width < MIN_WIDTH_PX) {
+        return false;
+    }
+    double aspect = (track.height > 0.0) ? track.width / track.height : MAX_ASPECT + 1.0;
+    return aspect <= MAX_ASPECT && aspect >= 1.0 / MAX_ASPECT;
+}
+
+double VisionTracker::distanceFromWidth(double widthPx) {
+    const double PI = 3.14159265358979;
+    double focalPx = (IMAGE_WIDTH / 2.0) / std::tan(FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+    return BALL_DIAMETER_MM * focalPx / ((widthPx > 1.0) ? widthPx : 1.0);
+}
+
+double VisionTracker::bearingFromX(double centerX) {
+    const double PI = 3.14159265358979;
+    double focalPx = (IMAGE_WIDTH / 2.0) / std::tan(FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+    return std::atan((centerX - IMAGE_WIDTH / 2.0) / focalPx) * 180.0 / PI;
+}
+
+void VisionTracker::selectTarget() {
+    int current = findTrack(targetId);
+    if (current >= 0 && !isValidBall(tracks[current])) {
+        current = -1;
+    }
+    
+    int nearest = -1;
+    for (int t = 0; t < trackCount; t++) {
+        if (isValidBall(tracks[t]) && (nearest < 0 || tracks[t].distanceMm < tracks[nearest].distanceMm)) {
+            nearest = t;
+        }
+    }
+    
+    // Keep chasing the same ball unless another one is clearly nearer
+    if (current >= 0 && nearest >= 0 && tracks[nearest].distanceMm > tracks[current].distanceMm * SWITCH_MARGIN) {
+        nearest = current;
+    }
+    targetId = (nearest < 0) ? -1 : tracks[nearest].id;
+}
+
+int VisionTracker::findTrack(int id) const {
+    for (int t = 0; t < trackCount; t++) {
+        if (tracks[t].id == id) {
+            return t;
+        }
+    }
+    return -1;
+}
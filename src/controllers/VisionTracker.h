@@ -0,0 +1,170 @@
+/*
+ * VisionTracker.h
+ * 
+ * This header defines the VisionTracker class, which turns vision sensor snapshots
+ * into tracked balls. Each snapshot is a list of colored blobs (position, size,
+ * color signature); the tracker matches them to the balls it saw in earlier frames,
+ * smooths their position, works out each ball's distance and bearing from the
+ * camera, and picks the nearest valid ball to go after.
+ * 
+ * Work per frame is bounded: at most MAX_DETECTIONS blobs against MAX_TRACKS tracks,
+ * with no dynamic memory.
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef VISIONTRACKER_H
+#define VISIONTRACKER_H
+
+/**
+ * VisionTracker Class
+ * 
+ * Usage (once per vision frame):
+ *   1. update() with the frame's detections
+ *   2. getTarget() for the nearest valid ball (nullptr if there is none)
+ */
+class VisionTracker {
+public:
+    /**
+     * One blob from the vision sensor (pixels, origin top left)
+     */
+    struct Detection {
+        int centerX;
+        int centerY;
+        int width;
+        int height;
+        int signature;  // Color signature id
+    };
+    
+    /**
+     * A ball followed across frames
+     */
+    struct Track {
+        int id;               // Stays the same while the ball is tracked
+        double centerX;       // Smoothed (pixels)
+        double centerY;
+        double width;
+        double height;
+        int signature;
+        int hits;             // Frames it was seen in
+        int misses;           // Frames in a row it was not seen
+        double distanceMm;    // From the camera, worked out from the width
+        double bearingDeg;    // Right of the camera axis is positive
+    };
+    
+    /**
+     * Camera (V5 vision sensor: 316 x 212 pixels, about 61 degrees wide)
+     */
+    static const int IMAGE_WIDTH = 316;
+    static const int IMAGE_HEIGHT = 212;
+    static constexpr double FIELD_OF_VIEW_DEG = 61.0;
+    
+    /**
+     * Game ball diameter (mm)
+     */
+    static constexpr double BALL_DIAMETER_MM = 160.0;
+    
+    /**
+     * Limits that bound the work per frame (the sensor reports at most 16 objects)
+     */
+    static const int MAX_DETECTIONS = 16;
+    static const int MAX_TRACKS = 8;
+    
+    /**
+     * A detection this close (pixels) to a track's center is that ball
+     */
+    static constexpr double MATCH_GATE_PX = 40.0;
+    
+    /**
+     * Weight of each new frame in a track's smoothed position and size
+     */
+    static constexpr double SMOOTHING = 0.5;
+    
+    /**
+     * Frames a track must be seen in before it can be a target,
+     * and missed frames in a row before it is dropped
+     */
+    static const int CONFIRM_FRAMES = 2;
+    static const int DROP_AFTER_MISSES = 3;
+    
+    /**
+     * Shape checks for a valid ball (smaller blobs are noise; balls are round)
+     */
+    static const int MIN_WIDTH_PX = 6;
+    static constexpr double MAX_ASPECT = 1.6;
+    
+    /**
+     * Another ball must be this much nearer to take over as the target
+     */
+    static constexpr double SWITCH_MARGIN = 0.8;
+    
+    /**
+     * Constructor
+     * 
+     * @param ballSignature Color signature of the balls to pick up
+     */
+    VisionTracker(int ballSignature);
+    
+    /**
+     * Forget every track (start of a new pickup)
+     */
+    void reset();
+    
+    /**
+     * Change the color of the balls to pick up
+     */
+    void setBallSignature(int signature);
+    
+    /**
+     * Process one frame
+     * 
+     * @param detections Blobs in the frame (only the first MAX_DETECTIONS are used)
+     * @param count Number of blobs
+     * @return Number of tracks after the frame
+     */
+    int update(const Detection* detections, int count);
+    
+    /**
+     * Nearest valid ball (sticks to the current one unless another is clearly nearer)
+     * 
+     * @return The target track, or nullptr if no valid ball is tracked
+     */
+    const Track* getTarget() const;
+    
+    int getTrackCount() const;
+    const Track& getTrack(int index) const;
+    
+    /**
+     * A confirmed, round ball of the right color
+     */
+    bool isValidBall(const Track& track) const;
+    
+    /**
+     * Distance to a ball from its width in the image (pinhole camera)
+     */
+    static double distanceFromWidth(double widthPx);
+    
+    /**
+     * Bearing of an image column from the camera axis (degrees, right positive)
+     */
+    static double bearingFromX(double centerX);
+    
+private:
+    Track tracks[MAX_TRACKS];
+    int trackCount;
+    int nextId;
+    int ballSignature;
+    int targetId;   // -1 = no target
+    
+    /**
+     * Pick the target after a frame
+     */
+    void selectTarget();
+    
+    /**
+     * Index of the track with an id, or -1
+     */
+    int findTrack(int id) const;
+};
+
+#endif // VISIONTRACKER_H
@@ -0,0 +1,136 @@
+/*
+ * WallSquare.cpp
+ * 
+ * Implementation of automatic wall squaring.
+ * No hardware dependencies, fully testable!
+ */
+
+#include "WallSquare.h"
+
+#include <cmath>
+
+#include "HeadingSnap.h"
+
+WallSquare::WallSquare()
+    : status(IDLE),
+      direction(1),
+      startMs(0),
+      firstContact(LEFT),
+      measuredHeading(0.0) {
+    for (int side = 0; side < SIDE_COUNT; side++) {
+        current[side] = 0.0;
+        freeCurrent[side] = 0.0;
+        freeRpm[side] = 0.0;
+        freeSamples[side] = 0;
+        contact[side] = false;
+        pending[side] = false;
+        pendingSinceMs[side] = 0;
+    }
+}
+
+void WallSquare::start(int direction, uint32_t nowMs) {
+    *this = WallSquare();
+    this->direction = (direction < 0) ? -1 : 1;
+    startMs = nowMs;
+    status = APPROACH;
+}
+
+void WallSquare::updateSide(int side, double rawCurrent, double rpm, uint32_t nowMs) {
+    double speed = std::fabs(rpm);
+    current[side] += (rawCurrent - current[side]) * CURRENT_FILTER;
+    
+    if (nowMs - startMs < SPINUP_MS) {
+        // Spin-up: current is high and speed is low anyway, nothing to learn yet
+        return;
+    }
+    
+    bool currentRise = freeSamples[side] > 0 && current[side] > freeCurrent[side] + CONTACT_CURRENT_RISE;
+    bool speedDrop = speed < freeRpm[side] * CONTACT_SPEED_FRACTION;
+    
+    if (currentRise && speedDrop) {
+        if (!pending[side]) {
+            pending[side] = true;
+            pendingSinceMs[side] = nowMs;
+        }
+        if (nowMs - pendingSinceMs[side] >= CONTACT_CONFIRM_MS) {
+            contact[side] = true;
+        }
+        return;
+    }
+    pending[side] = false;
+    
+    // Free running: learn the normal current (average) and speed (peak)
+    freeSamples[side]++;
+    freeCurrent[side] += (current[side] - freeCurrent[side]) / freeSamples[side];
+    if (speed > freeRpm[side]) {
+        freeRpm[side] = speed;
+    }
+}
+
+WallSquare::Status WallSquare::update(double leftCurrent, double leftRpm,
+                                      double rightCurrent, double rightRpm,
+                                      double heading, uint32_t nowMs,
+                                      int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (status != APPROACH) {
+        return status;
+    }
+    
+    if (nowMs - startMs >= TIMEOUT_MS) {
+        status = FAILED;
+        return status;
+    }
+    
+    bool hadContact = contact[LEFT] || contact[RIGHT];
+    if (!contact[LEFT]) {
+        updateSide(LEFT, leftCurrent, leftRpm, nowMs);
+    }
+    if (!contact[RIGHT]) {
+        updateSide(RIGHT, rightCurrent, rightRpm, nowMs);
+    }
+    if (!hadContact && (contact[LEFT] || contact[RIGHT])) {
+        firstContact = contact[LEFT] ? LEFT : RIGHT;
+    }
+    
+    if (contact[LEFT] && contact[RIGHT]) {
+        measuredHeading = heading;
+        status = SQUARED;
+        return status;
+    }
+    
+    // A side touching the wall only pushes gently; the other keeps driving
+    leftPower = direction * (contact[LEFT] ? HOLD_POWER : APPROACH_POWER);
+    rightPower = direction * (contact[RIGHT] ? HOLD_POWER : APPROACH_POWER);
+    return status;
+}
+
+void WallSquare::cancel() {
+    if (status == APPROACH) {
+        status = IDLE;
+    }
+}
+
+WallSquare::Status WallSquare::getStatus() const {
+    return status;
+}
+
+bool WallSquare::isActive() const {
+    return status == APPROACH;
+}
+
+bool WallSquare::hasContact(Side side) const {
+    return contact[side];
+}
+
+WallSquare::Side WallSquare::getFirstContact() const {
+    return firstContact;
+}
+
+double WallSquare::getMeasuredHeading() const {
+    return measuredHeading;
+}
+
+double WallSquare::getAlignedHeading() const {
+    return HeadingSnap::nearestPreset(measuredHeading);
+}
@@ -0,0 +1,171 @@
+/*
+ * WallSquare.h
+ * 
+ * This header defines the WallSquare class, which squares the robot against a wall
+ * automatically: drive into the wall at low power, detect when each drive side
+ * touches (current goes up, speed drops), keep the first side pushing gently until
+ * the other side touches too, then report the heading the robot is aligned to.
+ * 
+ * Works the same from autonomous (loop until done) and as a driver macro
+ * (one update() per usercontrol() tick).
+ * 
+ * No hardware dependencies, fully testable!
+ */
+
+#ifndef WALLSQUARE_H
+#define WALLSQUARE_H
+
+#include <cstdint>
+
+/**
+ * WallSquare Class
+ * 
+ * Usage (once per control tick):
+ *   1. start() with the direction to drive (forward or backward into the wall)
+ *   2. update() with each side's current and speed; apply the returned powers
+ *   3. When it returns SQUARED, getAlignedHeading() is the wall's heading
+ */
+class WallSquare {
+public:
+    /**
+     * Where the routine is
+     */
+    enum Status {
+        IDLE,       // Not running
+        APPROACH,   // Driving toward the wall
+        SQUARED,    // Both sides touched (finished)
+        FAILED      // Timed out without both sides touching
+    };
+    
+    /**
+     * One drive side
+     */
+    enum Side {
+        LEFT = 0,
+        RIGHT = 1,
+        SIDE_COUNT = 2
+    };
+    
+    /**
+     * Drive power on the way to the wall (percent)
+     */
+    static const int APPROACH_POWER = 30;
+    
+    /**
+     * Power that keeps a touching side pressed against the wall (percent)
+     */
+    static const int HOLD_POWER = 12;
+    
+    /**
+     * Contact readings are ignored while the drive spins up (ms)
+     */
+    static const uint32_t SPINUP_MS = 300;
+    
+    /**
+     * Current rise over the free-running current that counts as contact (amps)
+     */
+    static constexpr double CONTACT_CURRENT_RISE = 0.5;
+    
+    /**
+     * Current low-pass filter weight for the newest reading (0-1, lower = smoother)
+     */
+    static constexpr double CURRENT_FILTER = 0.5;
+    
+    /**
+     * Speed below this fraction of the free-running speed counts as contact
+     */
+    static constexpr double CONTACT_SPEED_FRACTION = 0.4;
+    
+    /**
+     * Both signs must hold this long to count (filters bumps and noise) (ms)
+     */
+    static const uint32_t CONTACT_CONFIRM_MS = 60;
+    
+    /**
+     * Give up after this long (ms)
+     */
+    static const uint32_t TIMEOUT_MS = 3000;
+    
+    /**
+     * Create an idle routine
+     */
+    WallSquare();
+    
+    /**
+     * Start driving into the wall
+     * 
+     * @param direction 1 = forward into the wall, -1 = backward
+     * @param nowMs Current time
+     */
+    void start(int direction, uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param leftCurrent Average motor current of the left side (amps)
+     * @param leftRpm Average motor speed of the left side (rpm, any sign)
+     * @param rightCurrent Average motor current of the right side (amps)
+     * @param rightRpm Average motor speed of the right side (rpm, any sign)
+     * @param heading Gyro heading now (degrees)
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return Status after this step
+     */
+    Status update(double leftCurrent, double leftRpm, double rightCurrent, double rightRpm,
+                  double heading, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop the routine (e.g. the driver moved a stick)
+     */
+    void cancel();
+    
+    /**
+     * Current status
+     */
+    Status getStatus() const;
+    
+    /**
+     * True while driving to the wall
+     */
+    bool isActive() const;
+    
+    /**
+     * True once a side has touched the wall
+     */
+    bool hasContact(Side side) const;
+    
+    /**
+     * Side that touched first (only valid once a side has contact)
+     */
+    Side getFirstContact() const;
+    
+    /**
+     * Gyro heading when both sides touched (degrees)
+     */
+    double getMeasuredHeading() const;
+    
+    /**
+     * Wall heading: the measured heading snapped to the nearest 90 degrees
+     * (walls are square to the field). Use it to correct the gyro.
+     */
+    double getAlignedHeading() const;
+    
+private:
+    Status status;
+    int direction;
+    uint32_t startMs;
+    double current[SIDE_COUNT];       // Filtered current
+    double freeCurrent[SIDE_COUNT];   // Average current before contact
+    double freeRpm[SIDE_COUNT];       // Fastest speed before contact
+    int freeSamples[SIDE_COUNT];
+    bool contact[SIDE_COUNT];
+    bool pending[SIDE_COUNT];         // Contact signs seen, not yet confirmed
+    uint32_t pendingSinceMs[SIDE_COUNT];
+    Side firstContact;
+    double measuredHeading;
+    
+    void updateSide(int side, double rawCurrent, double rpm, uint32_t nowMs);
+};
+
+#endif // WALLSQUARE_H
@@ -11,6 +11,37 @@
 #include "controllers/IntakeController.h"  // Intake and ramp motor control
 #include "controllers/RampController.h"  // Full power ramp motor control
 #include "controllers/PneumaticController.h"  // Pneumatic piston control
+#include "controllers/PistonTravel.h"  // Piston stroke timing (in transit vs settled)
+#include "controllers/ScoringProfile.h"  // Full power wheel speed and feed rate per height
+#include "controllers/BallDetector.h"  // Ball count from intake/ramp current signatures
+#include "controllers/VisionTracker.h"  // Vision sensor balls tracked across frames
+#include "controllers/BallPursuit.h"  // Drive to a ball and pick it up (autonomous)
+#include "controllers/DriveBalancer.h"  // Per-motor split of each drive side's command
+#include "controllers/Odometry.h"  // Dead reckoning math
+#include "controllers/GpsFusion.h"  // Latency-compensated GPS + odometry localization
+#include "controllers/VelocityEstimator.h"  // Timestamp-aware motor velocity
+#include "controllers/EnergyMonitor.h"  // Per-subsystem energy accounting
+#include "controllers/BatteryModel.h"  // Battery state of charge and resistance
+#include "controllers/Telemetry.h"  // Telemetry and dashboard text
+#include "controllers/MatchClock.h"  // Match phase and time remaining
+#include "controllers/MatchRuleEngine.h"  // Timed endgame behaviors
+#include "controllers/PhaseManager.h"  // Phase hooks, robot state, driver handoff
+#include "controllers/HeadingSnap.h"  // D-pad quick turns
+#include "controllers/GoalAim.h"  // Vision + gyro auto-aim for the full power wheel
+#include "controllers/WallSquare.h"  // Automatic wall squaring
+#include "controllers/RouteFollower.h"  // Autonomous routes, replanned around whatever blocks them
+#include "controllers/AutonSchedule.h"  // Autonomous steps chosen against the time left
+#include "controllers/StartDetector.h"  // Start tile detection for picking the autonomous routine
+#include "controllers/TipDetector.h"  // Tip and collision detection
+#include "controllers/InputSampler.h"  // Fast controller sampling
+#include "controllers/LatencyStats.h"  // Latency distributions
+#include "controllers/SeqLock.h"  // Lock-free state sharing between tasks
+#include "controllers/SpscQueue.h"  // Lock-free event queue between two tasks
+#include "controllers/ActuationFrame.h"  // Staged, back-to-back actuator writes
+#include "controllers/CommandScheduler.h"  // Commands and subsystem ownership
+#include "controllers/EventBus.h"  // Typed events between tasks and subsystems
+#include "controllers/RobotDescriptor.h"  // Wiring: ports, gearsets, reversals, subsystems
+#include "controllers/ActuationProbe.h"  // Command-to-motion latency measurement
 
 using namespace vex;  // Allows us to use VEX functions without typing "vex::"
 
@@ -18,54 +49,1508 @@ using namespace vex;  // Allows us to use VEX functions without typing "vex::"
 brain Brain;
 
 // MOTOR DECLARATIONS
-// Motors are named and assigned to specific ports on the V5 Brain
+// Motors are named and built from the robot description (see RobotDescriptor.h) -
+// change ports, reversals and gearsets there, not here.
 // The motor groups allow us to control multiple motors together
 
+/**
+ * VEX port number for a smart port (PORT1 is 0)
+ */
+int32_t smartPort(int port) {
+  return port - 1;
+}
+
+/**
+ * VEX gear setting for a cartridge
+ */
+gearSetting motorGearing(RobotDescriptor::Gearset gearset) {
+  switch (gearset) {
+    case RobotDescriptor::GEARSET_36_1: return ratio36_1;
+    case RobotDescriptor::GEARSET_6_1: return ratio6_1;
+    default: return ratio18_1;
+  }
+}
+
+/**
+ * Build a motor from its description
+ * 
+ * @param id Which motor (index into RobotDescriptor::MOTORS)
+ */
+motor makeMotor(ActuationFrame::Motor id) {
+  const RobotDescriptor::MotorSpec& spec = RobotDescriptor::MOTORS[id];
+  return motor(smartPort(spec.port), motorGearing(spec.gearset), spec.reversed);
+}
+
+/**
+ * VEX 3-wire port for a port letter
+ */
+triport::port& threeWirePort(char letter) {
+  switch (letter) {
+    case 'A': return Brain.ThreeWirePort.A;
+    case 'B': return Brain.ThreeWirePort.B;
+    case 'C': return Brain.ThreeWirePort.C;
+    case 'D': return Brain.ThreeWirePort.D;
+    case 'E': return Brain.ThreeWirePort.E;
+    case 'F': return Brain.ThreeWirePort.F;
+    case 'G': return Brain.ThreeWirePort.G;
+    default: return Brain.ThreeWirePort.H;
+  }
+}
+
 // Left side motors - 3 motors that spin together to move the left side
-motor LeftFrontMotor = motor(PORT1, ratio18_1, false);  
-// motor: the type (like "int" or "string" but for VEX motors)
-// LeftFrontMotor: the variable name we'll use to control this motor
-// motor(...): the constructor that creates the motor object
-//   PORT1: physical port number on the V5 Brain (where the motor is plugged in)
-//   ratio18_1: gear ratio (18:1 means 18 motor rotations = 1 wheel rotation)
-//   false: NOT reversed (set to true if the motor spins the wrong direction)
-motor LeftMiddleMotor = motor(PORT2, ratio18_1, false);   // Port 2, middle left motor
-motor LeftBackMotor = motor(PORT3, ratio18_1, false);   // Port 3, back left motor
+motor LeftFrontMotor = makeMotor(ActuationFrame::LEFT_FRONT);
+motor LeftMiddleMotor = makeMotor(ActuationFrame::LEFT_MIDDLE);
+motor LeftBackMotor = makeMotor(ActuationFrame::LEFT_BACK);
 motor_group LeftDrive = motor_group(LeftFrontMotor, LeftMiddleMotor, LeftBackMotor);  // Group all 3 together
 
-// Right side motors - 3 motors that spin together to move the right side
-motor RightFrontMotor = motor(PORT4, ratio18_1, true);  // Port 4, reversed for opposite spin
-motor RightMiddleMotor = motor(PORT5, ratio18_1, true);  // Port 5, middle right motor, reversed
-motor RightBackMotor = motor(PORT6, ratio18_1, true);   // Port 6, back right motor, reversed
-motor_group RightDrive = motor_group(RightFrontMotor, RightMiddleMotor, RightBackMotor);  // Group all 3 together
+// Right side motors - 3 motors that spin together to move the right side (reversed for opposite spin)
+motor RightFrontMotor = makeMotor(ActuationFrame::RIGHT_FRONT);
+motor RightMiddleMotor = makeMotor(ActuationFrame::RIGHT_MIDDLE);
+motor RightBackMotor = makeMotor(ActuationFrame::RIGHT_BACK);
+motor_group RightDrive = motor_group(RightFrontMotor, RightMiddleMotor, RightBackMotor);  // Group all 3 together
+
+// INTAKE AND RAMP MOTORS (Feature 2)
+// Intake motor - collects balls from ground (5.5V motor)
+motor IntakeMotor = makeMotor(ActuationFrame::INTAKE);
+
+// Ramp motors - first two ramp wheels share one motor (5.5V motor)
+motor RampMotor = makeMotor(ActuationFrame::RAMP);
+
+// FULL POWER RAMP MOTOR (Feature 3)
+// Final ramp wheel - pushes balls out at top (full power motor)
+motor FullPowerRampMotor = makeMotor(ActuationFrame::FULL_POWER_RAMP);
+
+// ALL MOTORS - dispatch table indexed by ActuationFrame::Motor (RobotDescriptor::MOTORS order)
+const int MOTOR_COUNT = RobotDescriptor::MOTOR_COUNT;
+motor* const AllMotors[MOTOR_COUNT] = {
+  &LeftFrontMotor, &LeftMiddleMotor, &LeftBackMotor,
+  &RightFrontMotor, &RightMiddleMotor, &RightBackMotor,
+  &IntakeMotor, &RampMotor, &FullPowerRampMotor
+};
+
+// Drive motors per side, front to back (worked out from the description at compile time)
+const int DRIVE_MOTORS_PER_SIDE = RobotDescriptor::countSide(RobotDescriptor::LEFT);
+static_assert(RobotDescriptor::sideMotor(RobotDescriptor::LEFT, 0) == ActuationFrame::LEFT_FRONT &&
+              RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, 0) == ActuationFrame::RIGHT_FRONT,
+              "LeftDrive/RightDrive groups must match the robot description");
+
+// PNEUMATIC PISTONS (Feature 4)
+// Two pneumatic pistons control height of full power wheel
+digital_out Piston1 = digital_out(threeWirePort(RobotDescriptor::PISTONS[0].port));  // First piston
+digital_out Piston2 = digital_out(threeWirePort(RobotDescriptor::PISTONS[1].port));  // Second piston
+// Limit switch closed when the pistons are fully extended (set to true once it is fitted)
+const bool HEIGHT_SWITCH_INSTALLED = false;
+limit HeightSwitch = limit(threeWirePort(RobotDescriptor::HEIGHT_SWITCH_PORT));
+
+// LOCALIZATION SENSORS
+// Inertial sensor - heading for odometry
+inertial Inertial = inertial(smartPort(RobotDescriptor::INERTIAL_PORT));
+// GPS sensor - absolute field position from the field code strip
+// gps(port, x offset, y offset, units, heading offset): offsets from robot center to sensor
+gps GPS = gps(smartPort(RobotDescriptor::GPS_PORT), 0.0, 0.0, mm, 180);  // Facing backward (180 degree offset)
+
+// VISION SENSOR
+// Finds balls of our color for autonomous pickup (see VisionTracker, BallPursuit) and the
+// goal for driver auto-aim (see GoalAim)
+// Generate the signatures with the Vision Utility (VEXcode) and paste them here
+const int BALL_SIGNATURE_ID = 1;
+vision::signature BALL_SIGNATURE = vision::signature(BALL_SIGNATURE_ID, 8099, 8893, 8496, -1505, -949, -1227, 3.0, 0);
+const int GOAL_SIGNATURE_ID = 2;
+vision::signature GOAL_SIGNATURE = vision::signature(GOAL_SIGNATURE_ID, -3441, -2785, -3113, 8975, 10355, 9665, 2.5, 0);
+vision Vision = vision(smartPort(RobotDescriptor::VISION_PORT), 50, BALL_SIGNATURE, GOAL_SIGNATURE);
+
+// DISTANCE SENSORS
+// Measure the field walls before the match to find the start tile (see StartDetector)
+distance DistanceLeft = distance(smartPort(RobotDescriptor::DISTANCE_LEFT_PORT));
+distance DistanceRight = distance(smartPort(RobotDescriptor::DISTANCE_RIGHT_PORT));
+distance DistanceBack = distance(smartPort(RobotDescriptor::DISTANCE_BACK_PORT));
+
+// Controller - the V5 controller that the driver uses
+controller Controller1 = controller(primary);
+
+// Competition object - handles autonomous and driver control periods
+competition Competition;
+
+// ROBOT STATE AND PHASES
+// Current height, button edge detection and last subsystem commands live in Phases.getState()
+// so every phase starts from a known state (see the hooks below setupPhaseHooks()).
+
+/**
+ * Microsecond clock for phase latency measurement
+ */
+uint32_t phaseClockUs() {
+  return (uint32_t)timer::systemHighResolution();
+}
+
+PhaseManager Phases(phaseClockUs);
+
+// LOCALIZATION
+// Wheel and sensor constants - adjust to match your robot
+const double DRIVE_WHEEL_DIAMETER = 4.0;  // Inches
+const double DRIVE_GEAR_RATIO = 1.0;      // Wheel turns per motor output turn (1.0 = direct drive)
+const uint32_t GPS_LATENCY_MS = 100;      // How old a GPS reading is when it reaches the Brain
+const uint32_t LOCALIZATION_PERIOD_MS = 10;
+
+// Robot pose on the field, updated by localizationTask()
+// Other tasks read the published copy: RobotPose.read(pose) (never blocks localization)
+GpsFusion Localization;
+SeqLock<Odometry::Pose> RobotPose;
+
+// Known start pose (e.g. from start tile detection): written by any task, applied by
+// localizationTask() on its next tick
+SeqLock<Odometry::Pose> StartPose;
+
+/**
+ * LOCALIZATION TASK
+ * Runs in the background for the whole program.
+ * Every 10 ms: adds one odometry step. Whenever the GPS has a new reading:
+ * applies it at the time it was measured (see GpsFusion). A new StartPose resets the pose.
+ */
+int localizationTask() {
+  double lastLeftDegrees = LeftDrive.position(degrees);
+  double lastRightDegrees = RightDrive.position(degrees);
+  uint32_t lastGpsTimestamp = GPS.timestamp();
+  uint32_t startPoseVersion = StartPose.getVersion();
+  
+  while (true) {
+    uint32_t now = timer::system();
+    
+    // Start pose: only use it once
+    if (StartPose.getVersion() != startPoseVersion) {
+      startPoseVersion = StartPose.getVersion();
+      Odometry::Pose start;
+      StartPose.read(start);
+      Localization.reset(now, start, Inertial.heading());
+    }
+    
+    // Odometry: average travel of both sides since the last tick
+    double leftDegrees = LeftDrive.position(degrees);
+    double rightDegrees = RightDrive.position(degrees);
+    double leftTravel = Odometry::wheelTravel(leftDegrees - lastLeftDegrees, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+    double rightTravel = Odometry::wheelTravel(rightDegrees - lastRightDegrees, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+    lastLeftDegrees = leftDegrees;
+    lastRightDegrees = rightDegrees;
+    Localization.updateOdometry(now, (leftTravel + rightTravel) / 2.0, Inertial.heading());
+    
+    // GPS: only use a reading once (timestamp changes when a new packet arrives)
+    uint32_t gpsTimestamp = GPS.timestamp();
+    if (gpsTimestamp != lastGpsTimestamp && gpsTimestamp > GPS_LATENCY_MS) {
+      lastGpsTimestamp = gpsTimestamp;
+      Odometry::Pose gpsPose;
+      gpsPose.x = GPS.xPosition(inches);
+      gpsPose.y = GPS.yPosition(inches);
+      gpsPose.heading = GPS.heading();
+      Localization.applyGpsFix(gpsTimestamp - GPS_LATENCY_MS, gpsPose, GPS.quality());
+    }
+    RobotPose.write(Localization.getPose());
+    
+    wait(LOCALIZATION_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// MOTOR VELOCITY
+// One estimator per motor, same order as AllMotors (default filter: Savitzky-Golay)
+VelocityEstimator MotorVelocities[MOTOR_COUNT];
+const uint32_t VELOCITY_PERIOD_MS = 5;  // Faster than the ~10 ms motor reports, so none are missed
+
+// Latest speed of every motor, published by motorVelocityTask() for other tasks
+struct MotorSpeeds {
+  double rpm[MOTOR_COUNT];
+};
+SeqLock<MotorSpeeds> PublishedMotorSpeeds;
+
+/**
+ * MOTOR VELOCITY TASK
+ * Runs in the background for the whole program.
+ * Feeds each motor's encoder position and the motor's OWN reading timestamp to its
+ * estimator. Repeated readings are ignored by the estimator, so polling fast is free.
+ * Publishes all speeds together in PublishedMotorSpeeds.
+ */
+int motorVelocityTask() {
+  while (true) {
+    MotorSpeeds speeds;
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+      MotorVelocities[i].addSample(AllMotors[i]->timestamp(), AllMotors[i]->position(degrees));
+      speeds.rpm[i] = MotorVelocities[i].getRpm();
+    }
+    PublishedMotorSpeeds.write(speeds);
+    wait(VELOCITY_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// CONTROLLER INPUT
+// inputTask() samples the controller every 2 ms and hands changes to usercontrol(),
+// which wakes up as soon as something changes instead of waiting for its next tick.
+InputSampler Inputs;
+LatencyStats InputLatency;               // Input change seen -> all motors commanded
+const uint32_t INPUT_PERIOD_MS = 2;
+const uint32_t CONTROL_PERIOD_MS = 20;   // Longest time between usercontrol() ticks
+const bool EVENT_DRIVEN_CONTROL = true;  // false = old fixed 20 ms loop (to compare latency)
+
+// Controller buttons in InputSampler::Button order
+controller::button* const ControllerButtons[InputSampler::BUTTON_COUNT] = {
+  &Controller1.ButtonL1, &Controller1.ButtonL2, &Controller1.ButtonR1, &Controller1.ButtonR2,
+  &Controller1.ButtonUp, &Controller1.ButtonDown, &Controller1.ButtonLeft, &Controller1.ButtonRight,
+  &Controller1.ButtonX, &Controller1.ButtonB, &Controller1.ButtonY, &Controller1.ButtonA
+};
+
+/**
+ * INPUT TASK
+ * Runs in the background for the whole program.
+ * Reads the controller much faster than radio packets arrive, so every new packet is
+ * seen within 2 ms, and timestamps it with the microsecond timer.
+ */
+int inputTask() {
+  while (true) {
+    int axes[InputSampler::AXIS_COUNT] = {
+      Controller1.Axis1.position(), Controller1.Axis2.position(),
+      Controller1.Axis3.position(), Controller1.Axis4.position()
+    };
+    uint16_t buttons = 0;
+    for (int i = 0; i < InputSampler::BUTTON_COUNT; i++) {
+      if (ControllerButtons[i]->pressing()) {
+        buttons |= InputSampler::buttonBit((InputSampler::Button)i);
+      }
+    }
+    Inputs.sample(axes, buttons, (uint32_t)timer::systemHighResolution());
+    wait(INPUT_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+/**
+ * Wait for the next usercontrol() tick: a controller change, or CONTROL_PERIOD_MS at most
+ * 
+ * @param tickStartMs When the tick that just finished started
+ */
+void waitForNextTick(uint32_t tickStartMs) {
+  if (!EVENT_DRIVEN_CONTROL) {
+    wait(CONTROL_PERIOD_MS, msec);
+    return;
+  }
+  while (!Inputs.hasNew() && timer::system() - tickStartMs < CONTROL_PERIOD_MS) {
+    wait(1, msec);
+  }
+}
+
+// ACTUATION
+// usercontrol() stages every motor and piston command in an ActuationFrame while it computes,
+// then writes them all back-to-back at the end of the tick (see ActuationFrame).
+digital_out* const AllPistons[ActuationFrame::PISTON_COUNT] = {&Piston1, &Piston2};
+LatencyStats ActuationSkew(50);     // First write -> last write of a tick (50 us buckets)
+LatencyStats SchedulerOverhead(5);  // Commands.run() time per tick (5 us buckets, see COMMANDS)
+
+/**
+ * Write one staged motor command (index = AllMotors order)
+ */
+void writeFrameMotor(ActuationFrame::Motor motor, int power) {
+  AllMotors[motor]->spin(forward, power, percent);
+}
+
+/**
+ * Write one staged piston command
+ */
+void writeFramePiston(int piston, bool extended) {
+  AllPistons[piston]->set(extended);
+}
+
+// EVENTS
+// Tasks publish events instead of setting shared globals; handlers run at the start of each
+// control tick (usercontrol(), or waitUnlessCollision() in autonomous) - see EventBus.
+// Each event type has exactly one publishing task.
+
+/**
+ * The match moved to a new period (published by matchClockTask())
+ */
+struct PhaseChangedEvent {
+  MatchClock::Phase from;
+  MatchClock::Phase to;
+  uint32_t timeMs;
+};
+
+/**
+ * A motor problem the driver should know about (published by energyTask())
+ */
+struct FaultEvent {
+  enum Type { MOTOR_HOT, MOTOR_COOLED, MOTOR_UNPLUGGED, MOTOR_PLUGGED_IN };
+  Type type;
+  int motor;  // AllMotors index
+  uint32_t timeMs;
+};
+
+/**
+ * The ball detector saw a ball go in, out, or into the full power wheel (published by
+ * countBalls(), from autonomous() or usercontrol() - never both at once)
+ */
+struct BallEvent {
+  enum Type { GRABBED, SPAT_OUT, SCORED };
+  Type type;
+  int count;  // Balls in the robot afterwards (approximate, see BallDetector)
+  uint32_t timeMs;
+};
+
+typedef EventBus<EventChannel<PhaseChangedEvent, 8>, EventChannel<FaultEvent, 16>,
+                 EventChannel<BallEvent, 8> > RobotEventBus;
+RobotEventBus RobotEvents;
+
+const double MOTOR_HOT_CELSIUS = 55.0;   // V5 motors start limiting current here
+const double MOTOR_COOL_CELSIUS = 50.0;  // Below this the motor counts as cooled again
+
+// Torque (current) limits: full torque unless a motor runs hot, then derated until it
+// cools (the endgame rules lift the derating for the final push)
+const double FULL_TORQUE_LIMIT = 100.0;  // Percent - motor firmware limit
+const double HOT_TORQUE_LIMIT = 80.0;    // Percent - for a motor over MOTOR_HOT_CELSIUS
+bool MotorHot[MOTOR_COUNT] = {false};    // Updated by publishMotorFaults()
+bool TorqueDeratingOff = false;          // Set by the endgame rules, cleared every period
+
+/**
+ * Set a motor's torque limit from its temperature and the endgame rules
+ * 
+ * @param motor AllMotors index
+ */
+void applyTorqueLimit(int motor) {
+  bool derate = MotorHot[motor] && !TorqueDeratingOff;
+  AllMotors[motor]->setMaxTorque(derate ? HOT_TORQUE_LIMIT : FULL_TORQUE_LIMIT, percent);
+}
+
+/**
+ * Apply the torque limits of every motor
+ */
+void applyTorqueLimits() {
+  for (int i = 0; i < MOTOR_COUNT; i++) {
+    applyTorqueLimit(i);
+  }
+}
+
+/**
+ * Deliver waiting events (call once at the start of a control tick)
+ */
+void dispatchEvents() {
+  RobotEvents.dispatchAll();
+}
+
+/**
+ * Log every phase change
+ */
+void logPhaseChange(const PhaseChangedEvent& event) {
+  printf("PHASE_CHANGE,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.from, (int)event.to);
+}
+
+/**
+ * Log motor faults and warn the driver when a motor overheats or comes unplugged
+ */
+void reportFault(const FaultEvent& event) {
+  printf("FAULT,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.type, event.motor);
+  if (event.type == FaultEvent::MOTOR_HOT || event.type == FaultEvent::MOTOR_UNPLUGGED) {
+    Controller1.rumble("---");
+  }
+}
+
+/**
+ * Log ball events and tell the driver when the robot is full (the intake has stopped)
+ */
+void reportBall(const BallEvent& event) {
+  printf("BALLS,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.type, event.count);
+  if (event.type == BallEvent::GRABBED && event.count >= BallDetector::DEFAULT_CAPACITY) {
+    Controller1.rumble(".");
+  }
+}
+
+/**
+ * Subscribe the event handlers (before the tasks start)
+ */
+void setupEvents() {
+  RobotEvents.subscribe<PhaseChangedEvent>(logPhaseChange);
+  RobotEvents.subscribe<FaultEvent>(reportFault);
+  RobotEvents.subscribe<BallEvent>(reportBall);
+}
+
+// ENERGY AND BATTERY
+// Each motor counts toward the subsystem given in RobotDescriptor
+EnergyMonitor Energy;          // Energy used per subsystem this match
+BatteryModel BatteryEstimate;  // Battery state of charge and internal resistance
+const uint32_t ENERGY_PERIOD_MS = 20;       // Same as the driver control loop
+const uint32_t TELEMETRY_PERIOD_MS = 500;   // Serial record + Brain screen refresh
+const uint32_t BATTERY_SAVE_PERIOD_MS = 10000;
+const char* BATTERY_FILE = "battery.dat";   // Battery model saved on the SD card between matches
+
+/**
+ * Load the saved battery model from the SD card (or start fresh if there is none)
+ */
+void loadBatteryState() {
+  BatteryModel::State saved;
+  int32_t bytesRead = 0;
+  if (Brain.SDcard.isInserted()) {
+    bytesRead = Brain.SDcard.loadfile(BATTERY_FILE, reinterpret_cast<uint8_t*>(&saved), sizeof(saved));
+  }
+  if (bytesRead == static_cast<int32_t>(sizeof(saved))) {
+    BatteryEstimate.restore(saved, Brain.Battery.capacity());
+  } else {
+    BatteryEstimate = BatteryModel(Brain.Battery.capacity());
+  }
+}
+
+/**
+ * Save the battery model to the SD card
+ */
+void saveBatteryState() {
+  if (!Brain.SDcard.isInserted()) {
+    return;
+  }
+  BatteryModel::State state = BatteryEstimate.getState();
+  Brain.SDcard.savefile(BATTERY_FILE, reinterpret_cast<uint8_t*>(&state), sizeof(state));
+}
+
+/**
+ * Publish a fault when a motor crosses the temperature limits or is unplugged/plugged in
+ * (and derate a hot motor's torque until it cools)
+ * 
+ * @param motor AllMotors index
+ * @param now Current time (ms)
+ */
+void publishMotorFaults(int motor, uint32_t now) {
+  static bool unplugged[MOTOR_COUNT] = {false};
+  
+  bool installed = AllMotors[motor]->installed();
+  if (installed == unplugged[motor]) {
+    unplugged[motor] = !installed;
+    RobotEvents.publish(FaultEvent{installed ? FaultEvent::MOTOR_PLUGGED_IN : FaultEvent::MOTOR_UNPLUGGED, motor, now});
+  }
+  
+  double temperature = AllMotors[motor]->temperature(celsius);
+  if (!MotorHot[motor] && temperature >= MOTOR_HOT_CELSIUS) {
+    MotorHot[motor] = true;
+    applyTorqueLimit(motor);
+    RobotEvents.publish(FaultEvent{FaultEvent::MOTOR_HOT, motor, now});
+  } else if (MotorHot[motor] && temperature < MOTOR_COOL_CELSIUS) {
+    MotorHot[motor] = false;
+    applyTorqueLimit(motor);
+    RobotEvents.publish(FaultEvent{FaultEvent::MOTOR_COOLED, motor, now});
+  }
+}
+
+/**
+ * ENERGY TASK
+ * Runs in the background for the whole program.
+ * Every 20 ms: integrates each motor's electrical power into its subsystem and
+ * updates the battery model. Every 500 ms: prints a telemetry record over serial
+ * and refreshes the Brain screen dashboard.
+ */
+int energyTask() {
+  uint32_t lastTick = timer::system();
+  uint32_t lastReport = lastTick;
+  uint32_t lastSave = lastTick;
+  char line[96];
+  char motorLine[256];  // One column group per motor
+  
+  // Column names for the MOTORS records, from the robot description
+  Telemetry::formatMotorLayout(motorLine, sizeof(motorLine));
+  printf("%s\n", motorLine);
+  
+  while (true) {
+    wait(ENERGY_PERIOD_MS, msec);
+    uint32_t now = timer::system();
+    double dtSeconds = (now - lastTick) / 1000.0;  // Real elapsed time, not the nominal 20 ms
+    lastTick = now;
+    
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+      Energy.addMotorSample(RobotDescriptor::energySubsystem(i), AllMotors[i]->voltage(volt), AllMotors[i]->current(amp));
+      publishMotorFaults(i, now);
+    }
+    Energy.endTick(dtSeconds);
+    BatteryEstimate.update(Brain.Battery.voltage(volt), Brain.Battery.current(amp), dtSeconds);
+    
+    if (now - lastReport >= TELEMETRY_PERIOD_MS) {
+      lastReport = now;
+      
+      // Telemetry: one CSV record over serial
+      Telemetry::formatEnergyRecord(line, sizeof(line), now, Energy, BatteryEstimate);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "input", InputLatency);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "actuation_skew", ActuationSkew);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "scheduler", SchedulerOverhead);
+      printf("%s\n", line);
+      
+      // Per-motor speed, current and temperature
+      MotorSpeeds speeds;
+      PublishedMotorSpeeds.read(speeds);
+      double amps[MOTOR_COUNT];
+      double celsiusReadings[MOTOR_COUNT];
+      for (int i = 0; i < MOTOR_COUNT; i++) {
+        amps[i] = AllMotors[i]->current(amp);
+        celsiusReadings[i] = AllMotors[i]->temperature(celsius);
+      }
+      Telemetry::formatMotorRecord(motorLine, sizeof(motorLine), now, speeds.rpm, amps, celsiusReadings);
+      printf("%s\n", motorLine);
+      
+      // Dashboard: energy split on row 1, battery on row 2 of the Brain screen
+      Telemetry::formatEnergyDashboard(line, sizeof(line), Energy);
+      Brain.Screen.clearLine(1);
+      Brain.Screen.setCursor(1, 1);
+      Brain.Screen.print("%s", line);
+      Telemetry::formatBatteryDashboard(line, sizeof(line), BatteryEstimate);
+      Brain.Screen.clearLine(2);
+      Brain.Screen.setCursor(2, 1);
+      Brain.Screen.print("%s", line);
+    }
+    
+    if (now - lastSave >= BATTERY_SAVE_PERIOD_MS) {
+      lastSave = now;
+      saveBatteryState();
+    }
+  }
+  return 0;
+}
+
+// MATCH CLOCK AND ENDGAME RULES
+MatchClock Match;               // Current phase and time left, updated by matchClockTask()
+MatchRuleEngine EndgameRules;   // Timed behaviors, checked every driver control tick
+const uint32_t MATCH_CLOCK_PERIOD_MS = 10;
+
+// Where the pistons really are: a new height takes a few hundred ms to reach
+PistonTravel HeightTravel;
+// Full power wheel speed and feed rate for the current height (see ScoringProfile::PROFILES)
+ScoringProfile Scoring(RobotDescriptor::maxRpm(ActuationFrame::FULL_POWER_RAMP));
+
+// BALL COUNT
+// The intake and ramp motors' current bump and speed dip count the balls in the robot
+// (no sensor needed - see BallDetector). The intake stops by itself when the robot is full;
+// pressing R1 again runs it anyway (the count is only approximate).
+BallDetector Balls;
+const int PRELOAD_BALLS = 0;  // Balls in the robot at the start of the match
+
+/**
+ * Feed this tick's intake and ramp readings to the ball detector and publish what it saw
+ * 
+ * @param frame Commands written this tick (direction of each motor)
+ * @param speeds Latest motor speeds
+ */
+void countBalls(const ActuationFrame& frame, const MotorSpeeds& speeds, uint32_t nowMs) {
+  bool wheelFeeding = Scoring.isReady();
+  Balls.setWheelFeeding(wheelFeeding);
+  int intakeCommand = frame.getMotor(ActuationFrame::INTAKE);
+  int rampCommand = frame.getMotor(ActuationFrame::RAMP);
+  if (Balls.update(BallDetector::INTAKE, IntakeMotor.current(amp), speeds.rpm[ActuationFrame::INTAKE],
+                   intakeCommand, nowMs)) {
+    BallEvent::Type type = (intakeCommand > 0) ? BallEvent::GRABBED : BallEvent::SPAT_OUT;
+    RobotEvents.publish(BallEvent{type, Balls.getCount(), nowMs});
+  }
+  if (Balls.update(BallDetector::RAMP, RampMotor.current(amp), speeds.rpm[ActuationFrame::RAMP],
+                   rampCommand, nowMs) && wheelFeeding && rampCommand > 0) {
+    RobotEvents.publish(BallEvent{BallEvent::SCORED, Balls.getCount(), nowMs});  // Hand-offs aren't events
+  }
+}
+
+// DRIVE BALANCE
+// Each side's three motors get their own share of the side command instead of the same
+// power: effort moves away from a slipping wheel, the motor drawing the most current and
+// the hottest motor (see DriveBalancer). Set to false to send all three the same power.
+const bool BALANCE_DRIVE = true;
+DriveBalancer DriveBalance;
+static_assert(DRIVE_MOTORS_PER_SIDE == DriveBalancer::MOTORS_PER_SIDE, "DriveBalancer splits three motors per side");
+
+/**
+ * Replace the staged side commands with per-motor powers
+ * 
+ * @param frame Commands staged this tick (drive powers are rewritten)
+ * @param speeds Latest motor speeds
+ */
+void balanceDrive(ActuationFrame& frame, const MotorSpeeds& speeds, uint32_t nowMs) {
+  static uint32_t lastMs = nowMs;
+  double dtSeconds = (nowMs - lastMs) / 1000.0;
+  lastMs = nowMs;
+  if (!BALANCE_DRIVE) {
+    return;
+  }
+  
+  const RobotDescriptor::Side sides[] = {RobotDescriptor::LEFT, RobotDescriptor::RIGHT};
+  const DriveBalancer::Side balancerSides[] = {DriveBalancer::LEFT, DriveBalancer::RIGHT};
+  for (int s = 0; s < 2; s++) {
+    ActuationFrame::Motor ids[DriveBalancer::MOTORS_PER_SIDE];
+    DriveBalancer::MotorReading readings[DriveBalancer::MOTORS_PER_SIDE];
+    for (int i = 0; i < DriveBalancer::MOTORS_PER_SIDE; i++) {
+      ids[i] = (ActuationFrame::Motor)RobotDescriptor::sideMotor(sides[s], i);
+      double amps = AllMotors[ids[i]]->current(amp);  // Always positive: sign it like the command
+      readings[i].currentA = (frame.getMotor(ids[i]) < 0) ? -amps : amps;
+      readings[i].temperatureC = AllMotors[ids[i]]->temperature(celsius);
+      readings[i].rpm = speeds.rpm[ids[i]];
+    }
+    
+    int powers[DriveBalancer::MOTORS_PER_SIDE];
+    DriveBalance.update(balancerSides[s], frame.getMotor(ids[0]), readings, dtSeconds, powers);
+    for (int i = 0; i < DriveBalancer::MOTORS_PER_SIDE; i++) {
+      frame.setMotor(ids[i], powers[i]);
+    }
+  }
+}
+
+/**
+ * Move both pistons to a height and remember it
+ * 
+ * @param position LOW or HIGH
+ */
+void setHeight(PneumaticController::HeightPosition position) {
+  Phases.getState().height = position;
+  
+  // Calculate piston state (true = extended, false = retracted)
+  bool pistonState = PneumaticController::calculatePistonState(position);
+  
+  // Set both pistons to the same state
+  Piston1.set(pistonState);
+  Piston2.set(pistonState);
+  HeightTravel.update(position, timer::system());
+}
+
+/**
+ * Advance the piston travel model (the switch confirms and calibrates full extends)
+ */
+void trackHeight(uint32_t nowMs) {
+  HeightTravel.update(Phases.getState().height, nowMs);
+  if (HEIGHT_SWITCH_INSTALLED && HeightSwitch.pressing()) {
+    int calibrations = HeightTravel.getCalibrationCount();
+    HeightTravel.confirm(PneumaticController::HIGH, nowMs);
+    if (HeightTravel.getCalibrationCount() != calibrations) {
+      printf("PISTON_TRAVEL,extend_ms=%.0f,retract_ms=%.0f\n",
+             HeightTravel.getTravelMs(PneumaticController::HIGH), HeightTravel.getTravelMs(PneumaticController::LOW));
+    }
+  }
+}
+
+/**
+ * Timed behaviors for the end of driver control
+ * Adjust times here (milliseconds LEFT in the period).
+ */
+void setupMatchRules() {
+  EndgameRules.addRule(MatchClock::DRIVER, 30000, MatchRuleEngine::RUMBLE_DRIVER);    // 30 s warning
+  EndgameRules.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RUMBLE_DRIVER);    // 15 s warning
+  EndgameRules.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);     // Full torque for the final push, even hot
+  EndgameRules.addRule(MatchClock::DRIVER, 10000, MatchRuleEngine::SET_HEIGHT_HIGH);  // Endgame scoring height
+}
+
+/**
+ * Carry out the actions the rule engine says are due (usercontrol() tick)
+ * Height actions only change the commanded height; the pistons move when the frame is written.
+ * 
+ * @param due Bit mask from EndgameRules.update(), plus whatever was held back last tick
+ * @param heightBusy true while something else owns the height (tip recovery)
+ * @return Height actions held back because of heightBusy (pass them in again next tick)
+ */
+uint32_t applyMatchActions(uint32_t due, bool heightBusy) {
+  uint32_t heightActions = MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH) |
+                           MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_LOW);
+  uint32_t held = heightBusy ? (due & heightActions) : 0;
+  due &= ~held;
+  
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS)) {
+    TorqueDeratingOff = true;
+    applyTorqueLimits();
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH)) {
+    Phases.getState().height = PneumaticController::HIGH;
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_LOW)) {
+    Phases.getState().height = PneumaticController::LOW;
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::RUMBLE_DRIVER)) {
+    Controller1.rumble("--");
+  }
+  return held;
+}
+
+// PHASE HOOKS AND DRIVER HANDOFF
+const uint32_t HANDOFF_WINDOW_MS = 500;  // Start preparing the handoff this close to the end of autonomous
+const int DRIVE_DEADBAND = 5;            // Stick deadband (percent)
+
+// D-pad quick turns, run from usercontrol() (see HeadingSnap)
+HeadingSnap QuickTurn;
+
+// Wall squaring: squareToWall() in autonomous, B button macro in usercontrol() (see WallSquare)
+WallSquare WallAlign;
+const uint32_t WALL_SQUARE_PERIOD_MS = 10;
+
+/**
+ * Average current (amps) and speed (rpm) of each drive side
+ * Speeds come from motorVelocityTask()
+ */
+void readDriveSides(double& leftCurrent, double& leftRpm, double& rightCurrent, double& rightRpm) {
+  MotorSpeeds speeds;
+  PublishedMotorSpeeds.read(speeds);
+  leftCurrent = 0.0;
+  leftRpm = 0.0;
+  rightCurrent = 0.0;
+  rightRpm = 0.0;
+  for (int i = 0; i < DRIVE_MOTORS_PER_SIDE; i++) {
+    int left = RobotDescriptor::sideMotor(RobotDescriptor::LEFT, i);
+    int right = RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, i);
+    leftCurrent += AllMotors[left]->current(amp) / DRIVE_MOTORS_PER_SIDE;
+    leftRpm += speeds.rpm[left] / DRIVE_MOTORS_PER_SIDE;
+    rightCurrent += AllMotors[right]->current(amp) / DRIVE_MOTORS_PER_SIDE;
+    rightRpm += speeds.rpm[right] / DRIVE_MOTORS_PER_SIDE;
+  }
+}
+
+// GROUND-SPEED-MATCHED INTAKE
+// Intake forward runs the roller's surface a little faster than the robot drives (see
+// IntakeController::calculateGroundMatchedPower()) instead of always at 100%: a ball the
+// robot drives onto is pulled in instead of bouncing off, and the roller idles slowly
+// while the robot stands still. The motor's velocity control holds the speed.
+const bool INTAKE_MATCH_GROUND_SPEED = true;  // false = intake always at 100%
+const double INTAKE_ROLLER_DIAMETER = 2.5;    // Inches - adjust to match your robot
+const double INTAKE_GEAR_RATIO = 3.0;         // Roller turns per motor turn
+const double INTAKE_OVERSPEED = IntakeController::DEFAULT_OVERSPEED;  // 0.2 = roller 20% faster than the ground
+
+/**
+ * Intake motor power for a state, matched to the robot's forward speed
+ * Speeds come from motorVelocityTask()
+ */
+int intakePower(IntakeController::MotorState state) {
+  if (!INTAKE_MATCH_GROUND_SPEED) {
+    return IntakeController::calculateIntakePower(state, 100);
+  }
+  MotorSpeeds speeds;
+  PublishedMotorSpeeds.read(speeds);
+  double driveRpm = 0.0;
+  for (int i = 0; i < DRIVE_MOTORS_PER_SIDE; i++) {
+    driveRpm += speeds.rpm[RobotDescriptor::sideMotor(RobotDescriptor::LEFT, i)] / (2 * DRIVE_MOTORS_PER_SIDE);
+    driveRpm += speeds.rpm[RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, i)] / (2 * DRIVE_MOTORS_PER_SIDE);
+  }
+  double groundSpeed = IntakeController::surfaceSpeed(driveRpm, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+  double maxSurfaceSpeed = IntakeController::surfaceSpeed(RobotDescriptor::maxRpm(ActuationFrame::INTAKE),
+                                                          INTAKE_ROLLER_DIAMETER, INTAKE_GEAR_RATIO);
+  return IntakeController::calculateGroundMatchedPower(state, groundSpeed, maxSurfaceSpeed, INTAKE_OVERSPEED);
+}
+
+/**
+ * One wall squaring step; once squared, corrects the gyro to the wall's heading
+ * 
+ * @param leftPower Output: left drive power
+ * @param rightPower Output: right drive power
+ * @return Status after this step
+ */
+WallSquare::Status stepWallSquare(int& leftPower, int& rightPower) {
+  double leftCurrent, leftRpm, rightCurrent, rightRpm;
+  readDriveSides(leftCurrent, leftRpm, rightCurrent, rightRpm);
+  WallSquare::Status status = WallAlign.update(leftCurrent, leftRpm, rightCurrent, rightRpm,
+                                               Inertial.heading(), timer::system(), leftPower, rightPower);
+  if (status == WallSquare::SQUARED) {
+    Inertial.setHeading(WallAlign.getAlignedHeading(), degrees);
+  }
+  return status;
+}
+
+/**
+ * Square up against a wall (autonomous - waits until done)
+ * 
+ * @param direction 1 = drive forward into the wall, -1 = backward
+ * @return true if both sides touched (gyro corrected), false on timeout
+ */
+bool squareToWall(int direction) {
+  WallAlign.start(direction, timer::system());
+  int leftPower, rightPower;
+  while (stepWallSquare(leftPower, rightPower) == WallSquare::APPROACH) {
+    LeftDrive.spin(forward, leftPower, percent);
+    RightDrive.spin(forward, rightPower, percent);
+    wait(WALL_SQUARE_PERIOD_MS, msec);
+  }
+  LeftDrive.stop();
+  RightDrive.stop();
+  return WallAlign.getStatus() == WallSquare::SQUARED;
+}
+
+/**
+ * Stop every motor (coast)
+ */
+void stopAllMotors() {
+  for (int i = 0; i < MOTOR_COUNT; i++) {
+    AllMotors[i]->stop();
+  }
+}
+
+/**
+ * Start of autonomous: known state, new match for energy and battery tracking
+ */
+void enterAutonomous() {
+  Phases.getState() = PhaseManager::defaultState();
+  setHeight(PneumaticController::LOW);
+  Balls.reset(PRELOAD_BALLS);
+  
+  // New match: start the energy totals over and count the match on this battery
+  Energy.reset();
+  BatteryEstimate.startMatch();
+}
+
+/**
+ * End of any active phase: nothing keeps running on an old command
+ */
+void exitActivePhase() {
+  QuickTurn.cancel();
+  WallAlign.cancel();
+  stopAllMotors();
+}
+
+/**
+ * Start of driver control: apply the handoff prepared at the end of autonomous
+ * If it is fresh, the drive and rollers already run the driver's commands before the
+ * first usercontrol() tick. Otherwise only the button state is carried over.
+ */
+void enterDriver() {
+  PhaseManager::DriverHandoff handoff;
+  if (!Phases.hasHandoff()) {
+    return;
+  }
+  if (Phases.takeHandoff(timer::system(), handoff)) {
+    LeftDrive.spin(forward, handoff.leftPower, percent);
+    RightDrive.spin(forward, handoff.rightPower, percent);
+    IntakeController::MotorState intakeState = IntakeController::limitToCapacity(handoff.intakeState, Balls.isFull());
+    IntakeMotor.spin(forward, intakePower(intakeState), percent);
+    // The ramp and top wheel wait for the first tick: they go through Scoring, which
+    // holds the feed until the wheel is up to speed at a settled height
+  }
+}
+
+/**
+ * Register the enter/exit hooks for each phase
+ */
+void setupPhaseHooks() {
+  Phases.setHooks(MatchClock::DISABLED, stopAllMotors, nullptr);
+  Phases.setHooks(MatchClock::AUTONOMOUS, enterAutonomous, exitActivePhase);
+  Phases.setHooks(MatchClock::DRIVER, enterDriver, exitActivePhase);
+}
+
+/**
+ * Read the controller into a driver handoff (same mapping as usercontrol())
+ */
+PhaseManager::DriverHandoff readDriverHandoff() {
+  PhaseManager::DriverHandoff handoff;
+  int leftStickInput = DriveTrain::applyDeadband(Controller1.Axis3.position(), DRIVE_DEADBAND);
+  int rightStickInput = DriveTrain::applyDeadband(Controller1.Axis2.position(), DRIVE_DEADBAND);
+  DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, handoff.leftPower, handoff.rightPower);
+  
+  handoff.intakeState = IntakeController::STOP;
+  if (Controller1.ButtonR1.pressing()) {
+    handoff.intakeState = IntakeController::FORWARD;
+  } else if (Controller1.ButtonR2.pressing()) {
+    handoff.intakeState = IntakeController::REVERSE;
+  }
+  handoff.rampState = IntakeController::STOP;
+  if (Controller1.ButtonL1.pressing()) {
+    handoff.rampState = IntakeController::FORWARD;
+  } else if (Controller1.ButtonL2.pressing()) {
+    handoff.rampState = IntakeController::REVERSE;
+  }
+  handoff.fullPowerState = RampController::STOP;
+  if (Controller1.ButtonX.pressing()) {
+    handoff.fullPowerState = RampController::FORWARD;
+  } else if (Controller1.ButtonY.pressing()) {
+    handoff.fullPowerState = RampController::REVERSE;
+  }
+  handoff.toggleButtonHeld = Controller1.ButtonA.pressing();
+  handoff.ready = true;
+  handoff.preparedAtMs = timer::system();
+  return handoff;
+}
+
+/**
+ * MATCH CLOCK TASK
+ * Runs in the background for the whole program.
+ * Watches the competition state and timestamps every change, so the rest of the
+ * code can ask how much time is left in the period. Also runs the phase hooks.
+ */
+int matchClockTask() {
+  MatchClock::Phase lastPhase = MatchClock::DISABLED;
+  while (true) {
+    MatchClock::Phase phase = MatchClock::phaseFromFlags(Competition.isEnabled(), Competition.isAutonomous());
+    if (Match.update(phase, timer::system())) {
+      RobotEvents.publish(PhaseChangedEvent{lastPhase, phase, timer::system()});
+      lastPhase = phase;
+      
+      // New period: arm its rules and go back to normal limits
+      EndgameRules.startPhase(phase);
+      TorqueDeratingOff = false;
+      applyTorqueLimits();
+      Phases.transition(phase);
+    }
+    
+    // Keep the driver handoff fresh during the last moments of autonomous
+    uint32_t now = timer::system();
+    if (phase == MatchClock::AUTONOMOUS && Match.getRemainingMs(now) <= HANDOFF_WINDOW_MS) {
+      Phases.prepareHandoff(readDriverHandoff());
+    }
+    wait(MATCH_CLOCK_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// TIP AND COLLISION DETECTION
+// Only tipTask() touches TipGuard. Other tasks read what it publishes: the tipping state
+// from PublishedTipState, tips and collisions from TipEvents (autonomous task only).
+TipDetector TipGuard;                 // Drops to LOW height when tipping starts
+const uint32_t TIP_PERIOD_MS = 5;     // Faster than the inertial sensor, so no reading is missed
 
-// INTAKE AND RAMP MOTORS (Feature 2)
-// Intake motor - collects balls from ground (5.5V motor)
-motor IntakeMotor = motor(PORT7, ratio18_1, false);  // Port 7, adjust port and reversal as needed
+// Tipping state, published by tipTask() for the task that owns the drive
+struct TipState {
+  bool tipping;
+  bool dropHeight;       // Drop to LOW height
+  int correctionPower;   // Drive power for both sides while tipping
+};
+SeqLock<TipState> PublishedTipState;
 
-// Ramp motors - first two ramp wheels share one motor (5.5V motor)
-motor RampMotor = motor(PORT8, ratio18_1, false);  // Port 8, adjust port and reversal as needed
+// Tips and collisions, from tipTask() to the autonomous task (newest dropped when full)
+SpscQueue<TipDetector::Event, TipDetector::EVENT_CAPACITY> TipEvents;
 
-// FULL POWER RAMP MOTOR (Feature 3)
-// Final ramp wheel - pushes balls out at top (full power motor)
-motor FullPowerRampMotor = motor(PORT9, ratio18_1, false);  // Port 9, adjust port and reversal as needed
+/**
+ * TIP TASK
+ * Runs in the background for the whole program.
+ * Feeds every inertial reading to TipGuard and publishes what it finds. Detection only: the
+ * task that owns the drive corrects (usercontrol() schedules TipRecovery, the autonomous
+ * loops call recoverFromTip()).
+ */
+int tipTask() {
+  while (true) {
+    TipGuard.update(Inertial.timestamp(), Inertial.pitch(), Inertial.roll(),
+                    Inertial.acceleration(xaxis), Inertial.acceleration(yaxis));
+    
+    TipDetector::Event event;
+    while (TipGuard.pollEvent(event)) {
+      TipEvents.push(event);
+    }
+    TipState state = {TipGuard.isTipping(), TipGuard.shouldDropHeight(), TipGuard.getCorrectionPower()};
+    PublishedTipState.write(state);
+    wait(TIP_PERIOD_MS, msec);
+  }
+  return 0;
+}
 
-// PNEUMATIC PISTONS (Feature 4)
-// Two pneumatic pistons control height of full power wheel
-// Note: Adjust port numbers to match your robot's wiring
-digital_out Piston1 = digital_out(Brain.ThreeWirePort.A);  // First piston
-digital_out Piston2 = digital_out(Brain.ThreeWirePort.B);  // Second piston
+/**
+ * Tip recovery for the autonomous drive loops: while tipping, drive toward the side going
+ * down and drop to LOW height
+ * 
+ * @param leftPower In: the loop's drive power. Out: the correction while tipping
+ * @param rightPower Same for the right side
+ * @return true while tipping
+ */
+bool recoverFromTip(int& leftPower, int& rightPower) {
+  TipState tip;
+  PublishedTipState.read(tip);
+  if (!tip.tipping) {
+    return false;
+  }
+  if (tip.dropHeight && Phases.getState().height == PneumaticController::HIGH) {
+    setHeight(PneumaticController::LOW);
+  }
+  leftPower = tip.correctionPower;
+  rightPower = leftPower;
+  return true;
+}
 
-// Controller - the V5 controller that the driver uses
-controller Controller1 = controller(primary);
+/**
+ * Wait, but stop early if the robot hits something (for autonomous)
+ * 
+ * @param timeMs Longest time to wait
+ * @return true if a collision ended the wait
+ */
+bool waitUnlessCollision(uint32_t timeMs) {
+  uint32_t start = timer::system();
+  TipDetector::Event event;
+  while (timer::system() - start < timeMs) {
+    dispatchEvents();  // Autonomous control tick boundary
+    while (TipEvents.pop(event)) {
+      if (event.type == TipDetector::COLLISION) {
+        return true;
+      }
+    }
+    wait(TIP_PERIOD_MS, msec);
+  }
+  return false;
+}
 
-// Competition object - handles autonomous and driver control periods
-competition Competition;
+// AUTONOMOUS SCHEDULE
+// autonomous() runs its steps through AutonSchedule: in order while on time; when running
+// late, the steps worth the most points that still fit first. Routines that run a step
+// check keepAutonStep() every tick and stop when it returns false.
+AutonSchedule Auton;
+
+/**
+ * Should the autonomous step being run keep going? (always true outside a step)
+ */
+bool keepAutonStep() {
+  return Auton.update(timer::system());
+}
+
+// AUTONOMOUS ROUTES
+// followRoute() drives the waypoints in Route from the localization pose. If something
+// blocks the way (no progress while driving, or a collision from tipTask()), it backs off
+// and plans a detour on a coarse field grid, a little each tick (see RouteFollower).
+RouteFollower Route;
+const uint32_t ROUTE_PERIOD_MS = 10;  // Same as localization
+
+/**
+ * Drive the route in Route (add its waypoints first)
+ * 
+ * @param timeoutMs Give up after this long
+ * @return true if the last waypoint was reached
+ */
+bool followRoute(uint32_t timeoutMs) {
+  Route.start(timer::system(), timeoutMs);
+  while (Route.isRunning()) {
+    if (!keepAutonStep()) {
+      Route.cancel();
+      break;
+    }
+    dispatchEvents();  // Autonomous control tick boundary
+    TipDetector::Event event;
+    while (TipEvents.pop(event)) {
+      if (event.type == TipDetector::COLLISION) {
+        Route.notifyCollision(timer::system());
+      }
+    }
+    
+    Odometry::Pose pose;
+    RobotPose.read(pose);
+    int leftPower;
+    int rightPower;
+    Route.update(pose, timer::system(), leftPower, rightPower);
+    recoverFromTip(leftPower, rightPower);
+    LeftDrive.spin(forward, leftPower, percent);
+    RightDrive.spin(forward, rightPower, percent);
+    wait(ROUTE_PERIOD_MS, msec);
+  }
+  LeftDrive.stop();
+  RightDrive.stop();
+  
+  if (Route.getReplanCount() > 0) {
+    printf("ROUTE,replans=%d,max_expansions=%d,done=%d\n", Route.getReplanCount(),
+           Route.getMaxTickExpansions(), Route.getStatus() == RouteFollower::DONE);
+  }
+  return Route.getStatus() == RouteFollower::DONE;
+}
+
+// VISION BALL PICKUP
+// pickUpBall() in autonomous: drive to the nearest ball of our color and intake it,
+// wherever it has rolled to
+VisionTracker BallTracker(BALL_SIGNATURE_ID);
+BallPursuit Pursuit;
+const uint32_t VISION_PERIOD_MS = 20;  // Vision sensor frame rate (50 Hz)
+
+/**
+ * Take one vision snapshot and update the tracker
+ */
+void readVisionFrame() {
+  VisionTracker::Detection detections[VisionTracker::MAX_DETECTIONS];
+  int count = Vision.takeSnapshot(BALL_SIGNATURE);
+  if (count > VisionTracker::MAX_DETECTIONS) {
+    count = VisionTracker::MAX_DETECTIONS;
+  }
+  for (int i = 0; i < count; i++) {
+    detections[i].centerX = Vision.objects[i].centerX;
+    detections[i].centerY = Vision.objects[i].centerY;
+    detections[i].width = Vision.objects[i].width;
+    detections[i].height = Vision.objects[i].height;
+    detections[i].signature = BALL_SIGNATURE_ID;
+  }
+  BallTracker.update(detections, count);
+}
+
+/**
+ * Drive to the nearest ball the vision sensor can see and pick it up
+ * 
+ * @param timeoutMs Give up after this long
+ * @return true if a ball was picked up
+ */
+bool pickUpBall(uint32_t timeoutMs) {
+  if (!Vision.installed() || Balls.isFull()) {
+    return false;
+  }
+  BallTracker.reset();
+  Pursuit.start(timer::system(), timeoutMs);
+  int grabsBefore = Balls.getDetectionCount(BallDetector::INTAKE);
+  
+  while (Pursuit.isRunning()) {
+    if (!keepAutonStep()) {
+      Pursuit.cancel();
+      LeftDrive.stop();
+      RightDrive.stop();
+      IntakeMotor.stop();
+      break;
+    }
+    dispatchEvents();  // Autonomous control tick boundary
+    readVisionFrame();
+    
+    int leftPower;
+    int rightPower;
+    IntakeController::MotorState intakeState;
+    bool ballGrabbed = Balls.getDetectionCount(BallDetector::INTAKE) != grabsBefore;
+    Pursuit.update(BallTracker, ballGrabbed, timer::system(), leftPower, rightPower, intakeState);
+    recoverFromTip(leftPower, rightPower);
+    
+    ActuationFrame frame;
+    frame.setDrive(leftPower, rightPower);
+    frame.setMotor(ActuationFrame::INTAKE, intakePower(intakeState));
+    frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+    frame.apply(writeFrameMotor, writeFramePiston);
+    
+    // The intake's current signature tells us when the ball is in
+    MotorSpeeds speeds;
+    PublishedMotorSpeeds.read(speeds);
+    countBalls(frame, speeds, timer::system());
+    wait(VISION_PERIOD_MS, msec);
+  }
+  return Pursuit.getStatus() == BallPursuit::DONE;
+}
+
+// GOAL AUTO-AIM
+// Holding X (score) with the goal in view turns the robot to face it before the first ball
+// is fed (see GoalAim). Set AUTO_AIM_ON_SCORE to false to aim by eye.
+const bool AUTO_AIM_ON_SCORE = true;
+GoalAim Aim(GOAL_SIGNATURE_ID);
+uint32_t LastGoalFrameMs = 0;
+
+/**
+ * Take one vision snapshot of the goal color (at most one per VISION_PERIOD_MS)
+ * Gyro headings are added every driver tick; the frame is matched to the heading
+ * the robot had when the camera took it.
+ */
+void readGoalFrame(uint32_t nowMs) {
+  if (!Vision.installed() || nowMs - LastGoalFrameMs < VISION_PERIOD_MS) {
+    return;
+  }
+  LastGoalFrameMs = nowMs;
+  VisionTracker::Detection detections[VisionTracker::MAX_DETECTIONS];
+  int count = Vision.takeSnapshot(GOAL_SIGNATURE);
+  if (count > VisionTracker::MAX_DETECTIONS) {
+    count = VisionTracker::MAX_DETECTIONS;
+  }
+  for (int i = 0; i < count; i++) {
+    detections[i].centerX = Vision.objects[i].centerX;
+    detections[i].centerY = Vision.objects[i].centerY;
+    detections[i].width = Vision.objects[i].width;
+    detections[i].height = Vision.objects[i].height;
+    detections[i].signature = GOAL_SIGNATURE_ID;
+  }
+  Aim.addGoalFrame(detections, count, nowMs);
+}
+
+// COMMANDS
+// Driver control is built from commands (see CommandScheduler). Each subsystem has a default
+// command that follows the controller; the quick turn and wall squaring macros and tip
+// recovery take the subsystems they need and give them back when they finish.
+CommandScheduler Commands;
+
+// What the current usercontrol() tick sensed, read by the commands
+InputSampler::Snapshot DriverInput;
+double DriverHeading = 0.0;
+uint32_t DriverTickMs = 0;
+
+/**
+ * Drive default: tank drive from the sticks
+ */
+void driveWithSticks(ActuationFrame& frame) {
+  // OPTION 1: TANK DRIVE
+  // Driver uses left stick for left motors, right stick for right motors
+  // This is like a tank - each side moves independently
+  
+  // Read controller stick values (-100 to +100)
+  int leftStickInput = DriverInput.axis(InputSampler::AXIS_3);   // Left stick vertical axis (Y)
+  int rightStickInput = DriverInput.axis(InputSampler::AXIS_2);  // Right stick vertical axis (Y)
+  // Note: Axis3 = Left stick Y, Axis2 = Right stick Y
+  // If this doesn't work, try Axis4 for right stick instead of Axis2
+  
+  // Apply deadband to prevent drift (removes small unwanted movements)
+  leftStickInput = DriveTrain::applyDeadband(leftStickInput, DRIVE_DEADBAND);
+  rightStickInput = DriveTrain::applyDeadband(rightStickInput, DRIVE_DEADBAND);
+  
+  // Calculate motor powers using our testable DriveTrain class
+  int leftPower, rightPower;
+  DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+  
+  // OPTION 2: ARCADE DRIVE (COMMENTED OUT - UNCOMMENT TO USE, and remove option 1)
+  // Driver uses one stick: forward/backward controls speed, left/right controls turning
+  // This is more like a car - more intuitive for some drivers
+  
+  /*
+  // Read controller input
+  int forwardInput = DriverInput.axis(InputSampler::AXIS_3);    // Forward/backward
+  int turnInput = DriverInput.axis(InputSampler::AXIS_1);       // Left/right turning
+  
+  // Apply deadband to prevent drift
+  forwardInput = DriveTrain::applyDeadband(forwardInput, 5);
+  turnInput = DriveTrain::applyDeadband(turnInput, 5);
+  
+  // Calculate left and right motor powers using our testable DriveTrain class
+  int leftPowerArcade, rightPowerArcade;
+  DriveTrain::calculateArcadeDrive(forwardInput, turnInput, leftPowerArcade, rightPowerArcade);
+  
+  // Stage motor speeds (clamping is handled inside calculateArcadeDrive!)
+  frame.setDrive(leftPowerArcade, rightPowerArcade);
+  */
+}
+
+/**
+ * Intake default: R1 = intake forward (collect balls, stops when full), R2 = reverse (spit out)
+ * Pressing R1 again while full runs the intake anyway until R1 is released: the count is
+ * approximate, and the driver can see the robot.
+ */
+void runIntakeButtons(ActuationFrame& frame) {
+  static bool lastIntakeButton = false;
+  static bool fullOverride = false;
+  bool intakeButton = DriverInput.pressed(InputSampler::BUTTON_R1);
+  if (intakeButton && !lastIntakeButton) {
+    fullOverride = Balls.isFull();
+  } else if (!intakeButton) {
+    fullOverride = false;
+  }
+  lastIntakeButton = intakeButton;
+  
+  IntakeController::MotorState intakeState = IntakeController::STOP;
+  if (intakeButton) {
+    intakeState = IntakeController::FORWARD;  // Collect balls
+  } else if (DriverInput.pressed(InputSampler::BUTTON_R2)) {
+    intakeState = IntakeController::REVERSE;  // Spit out
+  }
+  if (!fullOverride) {
+    intakeState = IntakeController::limitToCapacity(intakeState, Balls.isFull());
+  }
+  
+  // Calculate intake motor power using our testable IntakeController (matched to the ground speed)
+  frame.setMotor(ActuationFrame::INTAKE, intakePower(intakeState));
+  Phases.getState().intakeState = intakeState;
+}
+
+/**
+ * Ramp default: L1 = ramp forward (bring balls up), L2 = reverse (bring balls down)
+ */
+void runRampButtons(ActuationFrame& frame) {
+  IntakeController::MotorState rampState = IntakeController::STOP;
+  if (DriverInput.pressed(InputSampler::BUTTON_L1)) {
+    rampState = IntakeController::FORWARD;  // Bring balls up
+  } else if (DriverInput.pressed(InputSampler::BUTTON_L2)) {
+    rampState = IntakeController::REVERSE;  // Bring balls down
+  }
+  
+  // Calculate ramp motor power using our testable IntakeController (100% power)
+  // While the full power wheel spins, balls are fed at its profile's rate once it is ready
+  frame.setMotor(ActuationFrame::RAMP, Scoring.getFeedPower(IntakeController::calculateRampPower(rampState, 100)));
+  Phases.getState().rampState = rampState;
+}
+
+/**
+ * Top wheel default: X = full power forward (push balls out), Y = full power reverse
+ */
+void runTopWheelButtons(ActuationFrame& frame) {
+  RampController::MotorState fullPowerState = RampController::STOP;
+  if (DriverInput.pressed(InputSampler::BUTTON_X)) {
+    fullPowerState = RampController::FORWARD;  // Push balls out
+  } else if (DriverInput.pressed(InputSampler::BUTTON_Y)) {
+    fullPowerState = RampController::REVERSE;  // Pull balls back
+  }
+  
+  // Calculate full power ramp motor power using our testable RampController
+  // Use full power mode (100% when active) for reverse. Forward, and the pre-spin after a
+  // height change, run at the current height's wheel speed (runRampButtons() holds the
+  // feed until the pistons settle and the wheel is up to speed).
+  int fullPower = RampController::calculateRampPower(fullPowerState, true, 0);
+  if (fullPowerState == RampController::REVERSE) {
+    Scoring.stop();
+  } else if (Scoring.isSpinning()) {
+    fullPower = Scoring.getWheelPower();
+  }
+  frame.setMotor(ActuationFrame::FULL_POWER_RAMP, fullPower);
+  Phases.getState().fullPowerState = fullPowerState;
+}
+
+/**
+ * Height default: both pistons follow the current height (A toggles it in usercontrol())
+ */
+void holdHeight(ActuationFrame& frame) {
+  frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+}
+
+/**
+ * Quick turn macro (D-pad): drives until HeadingSnap settles
+ */
+void runQuickTurn(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  QuickTurn.update(DriverHeading, DriverTickMs, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool quickTurnDone() {
+  return !QuickTurn.isActive();
+}
+
+void stopQuickTurn(bool interrupted) {
+  if (interrupted) {
+    QuickTurn.cancel();
+  }
+}
+
+/**
+ * Auto-aim macro (X with the goal in view): turns to the goal; runRampButtons() feeds
+ * once the aim locks
+ */
+void runAutoAim(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  Aim.update(DriverTickMs, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool autoAimDone() {
+  return !Aim.isActive();  // Goal lost
+}
+
+void stopAutoAim(bool interrupted) {
+  if (interrupted) {
+    Aim.cancel();
+  }
+}
+
+/**
+ * Wall squaring macro (B): drives into the wall until both sides touch
+ */
+void runWallSquare(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  if (stepWallSquare(leftPower, rightPower) == WallSquare::SQUARED) {
+    Controller1.rumble(".");  // Squared and gyro corrected
+  }
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool wallSquareDone() {
+  return !WallAlign.isActive();
+}
+
+void stopWallSquare(bool interrupted) {
+  if (interrupted) {
+    WallAlign.cancel();
+  }
+}
+
+/**
+ * Tip recovery: drives toward the side going down at LOW height (tipTask() detects the tip)
+ * Not interruptible - no macro can take the drive until the robot is level again.
+ */
+void runTipRecovery(ActuationFrame& frame) {
+  TipState tip;
+  PublishedTipState.read(tip);
+  if (tip.dropHeight) {
+    Phases.getState().height = PneumaticController::LOW;
+  }
+  frame.setDrive(tip.correctionPower, tip.correctionPower);
+  frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+}
+
+bool tipRecovered() {
+  TipState tip;
+  PublishedTipState.read(tip);
+  return !tip.tipping;
+}
+
+// Defaults (one per subsystem)
+FunctionCommand DriveWithSticks(Command::DRIVE, driveWithSticks);
+FunctionCommand IntakeButtons(Command::INTAKE, runIntakeButtons);
+FunctionCommand RampButtons(Command::RAMP, runRampButtons);
+FunctionCommand TopWheelButtons(Command::TOP_WHEEL, runTopWheelButtons);
+FunctionCommand HoldHeight(Command::HEIGHT, holdHeight);
+
+// Macros and failsafes
+FunctionCommand QuickTurnCommand(Command::DRIVE, runQuickTurn, quickTurnDone, nullptr, stopQuickTurn);
+FunctionCommand WallSquareCommand(Command::DRIVE, runWallSquare, wallSquareDone, nullptr, stopWallSquare);
+FunctionCommand AutoAimCommand(Command::DRIVE, runAutoAim, autoAimDone, nullptr, stopAutoAim);
+FunctionCommand TipRecovery(Command::DRIVE | Command::HEIGHT, runTipRecovery, tipRecovered,
+                            nullptr, nullptr, false);
+
+/**
+ * Register the default command of each subsystem
+ */
+void setupCommands() {
+  Commands.setDefaultCommand(Command::DRIVE, &DriveWithSticks);
+  Commands.setDefaultCommand(Command::INTAKE, &IntakeButtons);
+  Commands.setDefaultCommand(Command::RAMP, &RampButtons);
+  Commands.setDefaultCommand(Command::TOP_WHEEL, &TopWheelButtons);
+  Commands.setDefaultCommand(Command::HEIGHT, &HoldHeight);
+}
+
+// ACTUATION LATENCY PROBE
+// Measurement mode: set ACTUATION_PROBE_MODE to true, put the robot on a stand (wheels off
+// the ground) and run the program. Each motor type gets PROBE_TRIALS step commands, timed
+// from the command to the first encoder movement (see ActuationProbe). Results are printed
+// as LATENCY records plus one MOTOR_MODEL line per motor for the simulator.
+const bool ACTUATION_PROBE_MODE = false;
+const int PROBE_TRIALS = 30;
+const int PROBE_POWER = 100;          // Step size (percent)
+const uint32_t PROBE_REST_MS = 500;   // Coast to a stop between trials
+
+// One motor of each type: drive 18:1, 5.5W intake and ramp, full power top wheel
+const ActuationFrame::Motor ProbeMotors[] = {
+  ActuationFrame::LEFT_FRONT, ActuationFrame::INTAKE, ActuationFrame::RAMP, ActuationFrame::FULL_POWER_RAMP
+};
+ActuationProbe Probe;
+
+/**
+ * Step one motor PROBE_TRIALS times and print its distributions and fitted model
+ * Encoder readings are timestamped when they are first seen (polled every 1 ms).
+ */
+void probeMotor(ActuationFrame::Motor id) {
+  motor& probed = *AllMotors[id];
+  Probe.reset();
+  
+  for (int trial = 0; trial < PROBE_TRIALS; trial++) {
+    probed.stop();
+    wait(PROBE_REST_MS, msec);
+    
+    double startPosition = probed.position(degrees);
+    uint32_t lastReading = probed.timestamp();
+    uint32_t commandUs = (uint32_t)timer::systemHighResolution();
+    probed.spin(forward, PROBE_POWER, percent);
+    Probe.startTrial(commandUs, startPosition);
+    
+    bool done = false;
+    while (!done) {
+      wait(1, msec);
+      if (probed.timestamp() != lastReading) {
+        lastReading = probed.timestamp();
+        done = Probe.addSample((uint32_t)timer::systemHighResolution(), probed.position(degrees));
+      }
+    }
+  }
+  probed.stop();
+  
+  char name[40];
+  char line[96];
+  const char* motorName = RobotDescriptor::MOTORS[id].name;
+  snprintf(name, sizeof(name), "probe_%s_motion", motorName);
+  Telemetry::formatLatencyRecord(line, sizeof(line), timer::system(), name, Probe.getMotionLatency());
+  printf("%s\n", line);
+  snprintf(name, sizeof(name), "probe_%s_rise", motorName);
+  Telemetry::formatLatencyRecord(line, sizeof(line), timer::system(), name, Probe.getRiseTime());
+  printf("%s\n", line);
+  
+  ActuationProbe::MotorModel model = Probe.getModel();
+  printf("MOTOR_MODEL,%s,dead_ms=%.1f,tau_ms=%.1f,rpm=%.0f,failed=%d\n", motorName,
+         model.deadTimeMs, model.timeConstantMs, model.steadyRpm, Probe.getFailedCount());
+}
 
-// PNEUMATIC STATE TRACKING
-// Track current height position for pneumatic pistons
-PneumaticController::HeightPosition currentHeight = PneumaticController::LOW;  // Start at low position
-bool lastToggleButtonState = false;  // Track button state to detect presses (not holds)
+/**
+ * Measure every motor type (takes about a minute), then wait for the program to be stopped
+ */
+void runActuationProbe() {
+  Brain.Screen.clearScreen();
+  Brain.Screen.setCursor(1, 1);
+  Brain.Screen.print("Actuation probe - robot on a stand!");
+  for (int i = 0; i < (int)(sizeof(ProbeMotors) / sizeof(ProbeMotors[0])); i++) {
+    probeMotor(ProbeMotors[i]);
+  }
+  Brain.Screen.setCursor(2, 1);
+  Brain.Screen.print("Probe done - see serial output");
+}
 
 /**
  * Initialize your robot here.
@@ -77,26 +1562,213 @@ void vexcodeInit(void) {
   bool initialPistonState = PneumaticController::calculatePistonState(PneumaticController::LOW);
   Piston1.set(initialPistonState);
   Piston2.set(initialPistonState);
-  currentHeight = PneumaticController::LOW;  // Set initial state
+  HeightTravel.reset(PneumaticController::LOW);
+  HeightTravel.setConfirmationRequired(PneumaticController::HIGH, HEIGHT_SWITCH_INSTALLED);  // Top switch only
+  Phases.getState() = PhaseManager::defaultState();  // LOW height, nothing running
+  setupPhaseHooks();
+  setupCommands();
+  setupEvents();
+  
+  // Normal motor limits and endgame behaviors
+  applyTorqueLimits();
+  setupMatchRules();
+  
+  // Continue the battery model from the last match (if it's the same battery)
+  loadBatteryState();
+  
+  // Calibrate the inertial sensor (robot must be still, takes about 2 seconds)
+  Inertial.calibrate();
+  while (Inertial.isCalibrating()) {
+    wait(20, msec);
+  }
   
   // Any other initialization code goes here
   // This is called before the competition starts
 }
 
+// AUTONOMOUS ROUTINES
+// A routine is a start pose and a list of steps for Auton. Steps a routine can use:
+// (add a case to runAutonStep() for each new one)
+enum AutonStep {
+  DRIVE_OUT,
+  PICK_UP_BALL
+};
+AutonStep AutonStepKinds[AutonSchedule::MAX_STEPS];  // What each step in Auton does
+
+/**
+ * Add a step to Auton (see AutonSchedule::addStep())
+ */
+int addAutonStep(AutonStep kind, const char* name, uint32_t expectedMs, double points,
+                 int needs = AutonSchedule::NO_STEP) {
+  int step = Auton.addStep(name, expectedMs, points, needs);
+  if (step != AutonSchedule::NO_STEP) {
+    AutonStepKinds[step] = kind;
+  }
+  return step;
+}
+
+/**
+ * Example routine: drive 40 inches straight ahead (around anything in the way), then
+ * pick up the nearest ball of our color, even if it was knocked out of place.
+ * Each step: how long it usually takes (ms), what it scores, and the step it needs.
+ */
+void addDriveAndPickUp() {
+  int driveOut = addAutonStep(DRIVE_OUT, "drive out", 2500, 0.0);
+  addAutonStep(PICK_UP_BALL, "pick up ball", 2500, 1.0, driveOut);
+}
+
+struct AutonRoutine {
+  const char* name;       // Shown on the Brain screen
+  Odometry::Pose start;   // Start pose (field inches, heading clockwise from +y)
+  void (*addSteps)();     // Adds the routine's steps to Auton
+};
+
+// One alliance's start tiles: the field looks the same from the other alliance's tiles
+// turned half a turn, so those can't be told apart (swap the list when switching sides)
+const AutonRoutine ROUTINES[] = {
+  {"Left: drive + ball", {-36.0, -60.0, 0.0}, addDriveAndPickUp},
+  {"Right: drive + ball", {36.0, -60.0, 0.0}, addDriveAndPickUp}
+};
+const int ROUTINE_COUNT = sizeof(ROUTINES) / sizeof(ROUTINES[0]);
+static_assert(ROUTINE_COUNT <= StartDetector::MAX_STARTS, "Too many autonomous routines");
+
+/**
+ * Run one step of the autonomous routine
+ * 
+ * @param step Step number in Auton
+ * @return true if the step did what it was for
+ */
+bool runAutonStep(int step) {
+  switch (AutonStepKinds[step]) {
+    case DRIVE_OUT: {
+      Odometry::Pose startPose;
+      RobotPose.read(startPose);
+      Route.clear();
+      Route.addWaypoint(RouteFollower::pointAhead(startPose, 40.0));
+      return followRoute(4000);  // Give up after 4 seconds
+    }
+    case PICK_UP_BALL:
+      return pickUpBall(3000);
+    default:
+      return false;
+  }
+}
+
+// START TILE DETECTION
+// Until the match starts, the distance sensors look for the start tile the robot is on and
+// select the routine that starts there (see StartDetector). The choice is on the Brain
+// screen (rows 3 and 4). If no tile matches, the last choice stays (the first routine at
+// power-up).
+StartDetector StartTiles;
+int SelectedRoutine = 0;  // Written by startDetectTask() before the match only
+const uint32_t START_DETECT_PERIOD_MS = 50;
+
+// Where the distance sensors are: inches right and forward of the robot's center, and
+// the way they face (degrees clockwise from the front) - measure these on your robot
+const StartDetector::Mount DISTANCE_LEFT_MOUNT = {-7.0, 0.0, -90.0};
+const StartDetector::Mount DISTANCE_RIGHT_MOUNT = {7.0, 0.0, 90.0};
+const StartDetector::Mount DISTANCE_BACK_MOUNT = {0.0, -7.0, 180.0};
+
+/**
+ * Distance sensor reading in inches (-1 if nothing is in range)
+ */
+double readDistance(distance& sensor) {
+  return sensor.isObjectDetected() ? sensor.objectDistance(inches) : -1.0;
+}
+
+/**
+ * Show the selected routine and what the detector knows on the Brain screen
+ */
+void showStartDetection(StartDetector::Status status) {
+  Brain.Screen.clearLine(3);
+  Brain.Screen.setCursor(3, 1);
+  Brain.Screen.print("AUTO: %s", ROUTINES[SelectedRoutine].name);
+  Brain.Screen.clearLine(4);
+  Brain.Screen.setCursor(4, 1);
+  if (status == StartDetector::DETECTED) {
+    Brain.Screen.print("Start tile found");
+  } else if (status == StartDetector::WRONG_HEADING) {
+    // Turned clockwise from the routine's heading: turn back the shorter way
+    double turned = StartTiles.getHeadingError();
+    Brain.Screen.print("%s tile: turn robot %.0f deg %s", ROUTINES[StartTiles.getStart()].name,
+                       (turned > 180.0) ? 360.0 - turned : turned, (turned > 180.0) ? "right" : "left");
+  } else if (status == StartDetector::UNKNOWN) {
+    Brain.Screen.print("Start tile? (keeping this routine)");
+  } else {
+    Brain.Screen.print("Finding start tile...");
+  }
+}
+
+/**
+ * START DETECTION TASK
+ * Runs from power-up until the robot is first enabled (the match starts).
+ * Every 50 ms: feeds the distance readings and inertial heading to StartTiles. When it
+ * finds a routine's start pose, selects that routine and gives its pose to localization.
+ */
+int startDetectTask() {
+  StartTiles.addSensor(DISTANCE_LEFT_MOUNT);
+  StartTiles.addSensor(DISTANCE_RIGHT_MOUNT);
+  StartTiles.addSensor(DISTANCE_BACK_MOUNT);
+  for (int i = 0; i < ROUTINE_COUNT; i++) {
+    StartTiles.addStart(ROUTINES[i].start);
+  }
+  
+  StartDetector::Status shownStatus = StartDetector::WAITING;
+  int shownStart = -1;
+  showStartDetection(shownStatus);
+  while (!Competition.isEnabled()) {
+    double distances[] = {readDistance(DistanceLeft), readDistance(DistanceRight), readDistance(DistanceBack)};
+    StartDetector::Status status = StartTiles.update(distances, Inertial.heading());
+    
+    // Only act on changes (the screen is slow)
+    if (status != shownStatus || StartTiles.getStart() != shownStart) {
+      shownStatus = status;
+      shownStart = StartTiles.getStart();
+      if (status == StartDetector::DETECTED) {
+        SelectedRoutine = shownStart;
+        StartPose.write(ROUTINES[shownStart].start);
+      }
+      showStartDetection(status);
+      printf("START,status=%d,routine=%d,error=%.1f,next=%.1f\n", status, SelectedRoutine,
+             StartTiles.getError(), StartTiles.getRunnerUpError());
+    }
+    wait(START_DETECT_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
 /**
  * AUTONOMOUS MODE
  * This function runs when the robot is in autonomous mode (no driver).
  * Write code here for your robot to run by itself.
  */
 void autonomous(void) {
-  // Example: Move forward for 2 seconds, then stop
-  LeftDrive.spin(forward, 50, percent);   // Left motors at 50% power forward
-  RightDrive.spin(forward, 50, percent);  // Right motors at 50% power forward
-  wait(2000, msec);  // Wait 2000 milliseconds (2 seconds)
+  // Runs the autonomous hooks now if matchClockTask() hasn't noticed the change yet
+  Phases.transition(MatchClock::AUTONOMOUS);
   
-  // Stop the motors
-  LeftDrive.stop();
-  RightDrive.stop();
+  // Forget bumps from before the match (robot placement, etc.)
+  TipDetector::Event oldEvent;
+  while (TipEvents.pop(oldEvent)) {
+  }
+  
+  // The routine startDetectTask() selected
+  const AutonRoutine& routine = ROUTINES[SelectedRoutine];
+  Auton.clear();
+  routine.addSteps();
+  
+  // matchClockTask() may not have seen the period start yet
+  uint32_t now = timer::system();
+  bool clockRunning = Match.getPhase() == MatchClock::AUTONOMOUS;
+  Auton.start(now, clockRunning ? Match.getRemainingMs(now) : MatchClock::DEFAULT_AUTONOMOUS_MS);
+  
+  for (int step = Auton.next(now); step != AutonSchedule::NO_STEP; step = Auton.next(timer::system())) {
+    bool finished = runAutonStep(step);
+    Auton.finishStep(timer::system(), finished);
+  }
+  printf("AUTON,routine=%s,score=%.0f,pace=%.2f\n", routine.name, Auton.getScore(), Auton.getPace());
+  
+  // Example: back into the wall to square up and fix the gyro heading
+  // squareToWall(-1);
 }
 
 /**
@@ -104,125 +1776,168 @@ void autonomous(void) {
  * This function runs continuously while the driver controls the robot.
  */
 void usercontrol(void) {
+  // Runs the driver hooks (and applies the handoff) if matchClockTask() hasn't yet
+  Phases.transition(MatchClock::DRIVER);
+  PhaseManager::RobotState& state = Phases.getState();
+  Commands.cancelAll();  // Nothing left over from an earlier driver control period
+  bool firstTick = true;
+  uint32_t heldMatchActions = 0;  // Endgame height actions waiting for tip recovery to finish
+  bool lastDpad[4] = {false, false, false, false};  // Up, Down, Left, Right last tick
+  bool lastWallButton = false;
+  bool lastScoreButton = false;
+  
   // This loop runs forever while the robot is in driver control mode
   while (true) {
+    uint32_t tickStartMs = timer::system();
     
-    // OPTION 1: TANK DRIVE
-    // Driver uses left stick for left motors, right stick for right motors
-    // This is like a tank - each side moves independently
-    
-    // Read controller stick values (-100 to +100)
-    int leftStickInput = Controller1.Axis3.position();   // Left stick vertical axis (Y)
-    int rightStickInput = Controller1.Axis2.position();  // Right stick vertical axis (Y)
-    // Note: Axis3 = Left stick Y, Axis2 = Right stick Y
-    // If this doesn't work, try Axis4 for right stick instead of Axis2
+    // Events published since the last tick (faults, phase changes)
+    dispatchEvents();
     
-    // Apply deadband to prevent drift (removes small unwanted movements)
-    leftStickInput = DriveTrain::applyDeadband(leftStickInput, 5);
-    rightStickInput = DriveTrain::applyDeadband(rightStickInput, 5);
+    // ============================================
+    // SENSE
+    // ============================================
+    // Read everything the tick needs up front
     
-    // Calculate motor powers using our testable DriveTrain class
-    int leftPower, rightPower;
-    DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, leftPower, rightPower);
+    // Latest controller snapshot from inputTask() (never waits)
+    bool inputChanged = Inputs.read(DriverInput);
+    DriverHeading = Inertial.heading();
+    DriverTickMs = timer::system();
     
-    // Set motor speeds to calculated values
-    LeftDrive.spin(forward, leftPower, percent);   // Left motors
-    RightDrive.spin(forward, rightPower, percent); // Right motors
+    // Gyro every tick, goal frames at the camera's rate (for auto-aim)
+    Aim.addHeading(DriverHeading, DriverTickMs);
+    readGoalFrame(DriverTickMs);
     
     // ============================================
-    // INTAKE AND RAMP CONTROL (Feature 2)
+    // BUTTON BINDINGS
     // ============================================
+    // Start and stop macros; the scheduler hands them the subsystems they need
     
-    // Intake Motor Control
-    // R1 = Intake forward (collect balls), R2 = Intake reverse (spit out)
-    IntakeController::MotorState intakeState = IntakeController::STOP;
-    if (Controller1.ButtonR1.pressing()) {
-        intakeState = IntakeController::FORWARD;  // Collect balls
-    } else if (Controller1.ButtonR2.pressing()) {
-        intakeState = IntakeController::REVERSE;  // Spit out
+    // QUICK TURNS (D-pad)
+    // Right/Left = turn 90 degrees clockwise/counter-clockwise, Down = turn around,
+    // Up = square up to the nearest field direction. Press again while turning to chain.
+    bool dpad[4] = {DriverInput.pressed(InputSampler::BUTTON_UP), DriverInput.pressed(InputSampler::BUTTON_DOWN),
+                    DriverInput.pressed(InputSampler::BUTTON_LEFT), DriverInput.pressed(InputSampler::BUTTON_RIGHT)};
+    bool turnPressed = true;
+    if (dpad[0] && !lastDpad[0]) {
+      QuickTurn.start(DriverHeading, HeadingSnap::nearestPreset(DriverHeading), DriverTickMs);
+    } else if (dpad[1] && !lastDpad[1]) {
+      QuickTurn.startRelative(DriverHeading, 180.0, DriverTickMs);
+    } else if (dpad[2] && !lastDpad[2]) {
+      QuickTurn.startRelative(DriverHeading, -90.0, DriverTickMs);
+    } else if (dpad[3] && !lastDpad[3]) {
+      QuickTurn.startRelative(DriverHeading, 90.0, DriverTickMs);
+    } else {
+      turnPressed = false;
+    }
+    if (turnPressed && !Commands.schedule(&QuickTurnCommand)) {
+      QuickTurn.cancel();  // Refused (tip recovery has the drive)
+    }
+    for (int i = 0; i < 4; i++) {
+      lastDpad[i] = dpad[i];
     }
     
-    // Calculate intake motor power using our testable IntakeController
-    int intakePower = IntakeController::calculateIntakePower(intakeState, 100);  // 100% power
-    IntakeMotor.spin(forward, intakePower, percent);
+    // WALL SQUARING (B)
+    // Drives forward into the wall at low power until both sides touch, then fixes the gyro
+    bool wallButton = DriverInput.pressed(InputSampler::BUTTON_B);
+    if (wallButton && !lastWallButton) {
+      WallAlign.start(1, DriverTickMs);
+      if (!Commands.schedule(&WallSquareCommand)) {
+        WallAlign.cancel();
+      }
+    }
+    lastWallButton = wallButton;
     
-    // Ramp Motor Control (first two wheels)
-    // L1 = Ramp forward (bring balls up), L2 = Ramp reverse (bring balls down)
-    IntakeController::MotorState rampState = IntakeController::STOP;
-    if (Controller1.ButtonL1.pressing()) {
-        rampState = IntakeController::FORWARD;  // Bring balls up
-    } else if (Controller1.ButtonL2.pressing()) {
-        rampState = IntakeController::REVERSE;  // Bring balls down
+    // AUTO-AIM (X)
+    // Pressing X with the goal in view turns to it; releasing X ends it
+    bool scoreButton = DriverInput.pressed(InputSampler::BUTTON_X);
+    if (scoreButton && !lastScoreButton && AUTO_AIM_ON_SCORE && Aim.hasGoal(DriverTickMs)) {
+      Aim.start();
+      if (!Commands.schedule(&AutoAimCommand)) {
+        Aim.cancel();
+      }
+    } else if (!scoreButton) {
+      Commands.cancel(&AutoAimCommand);
     }
+    lastScoreButton = scoreButton;
     
-    // Calculate ramp motor power using our testable IntakeController
-    int rampPower = IntakeController::calculateRampPower(rampState, 100);  // 100% power
-    RampMotor.spin(forward, rampPower, percent);
+    // Moving either stick hands control straight back to the driver
+    if (DriveTrain::applyDeadband(DriverInput.axis(InputSampler::AXIS_3), DRIVE_DEADBAND) != 0 ||
+        DriveTrain::applyDeadband(DriverInput.axis(InputSampler::AXIS_2), DRIVE_DEADBAND) != 0) {
+      Commands.cancel(&QuickTurnCommand);
+      Commands.cancel(&WallSquareCommand);
+      Commands.cancel(&AutoAimCommand);
+    }
     
-    // ============================================
-    // FULL POWER RAMP MOTOR CONTROL (Feature 3)
-    // ============================================
+    // Tipping overrides everything
+    TipState tip;
+    PublishedTipState.read(tip);
+    if (tip.tipping) {
+      Commands.schedule(&TipRecovery);
+    }
     
-    // Full Power Ramp Motor Control
-    // X = Full power forward (push balls out), Y = Full power reverse
-    RampController::MotorState fullPowerState = RampController::STOP;
-    if (Controller1.ButtonX.pressing()) {
-        fullPowerState = RampController::FORWARD;  // Push balls out
-    } else if (Controller1.ButtonY.pressing()) {
-        fullPowerState = RampController::REVERSE;  // Pull balls back
+    // PNEUMATIC HEIGHT (A)
+    // Detect button press (not hold) to toggle once per press; not while recovering from a tip
+    bool currentToggleButton = DriverInput.pressed(InputSampler::BUTTON_A);
+    if (currentToggleButton && !state.lastToggleButton && !Commands.isScheduled(&TipRecovery)) {
+      // Toggle to opposite position (the pistons move when the frame is written)
+      state.height = PneumaticController::togglePosition(state.height);
     }
+    state.lastToggleButton = currentToggleButton;  // Remember state for next loop
+    
+    // ENDGAME RULES
+    // Timed behaviors (relax limits, endgame height, driver warnings). The endgame height
+    // waits while TipRecovery holds the robot at LOW, then applies once it is level.
+    uint32_t dueActions = EndgameRules.update(Match.getRemainingMs(timer::system()));
+    heldMatchActions = applyMatchActions(heldMatchActions | dueActions, Commands.isScheduled(&TipRecovery));
+    
+    // PISTON TRAVEL AND SCORING PROFILE
+    // In transit or settled at the height commanded above; the full power wheel
+    // switches to that height's profile and spins up while the pistons move.
+    // Balls wait on the ramp while auto-aim is still turning to the goal.
+    trackHeight(timer::system());
+    Scoring.holdForAim(Commands.isScheduled(&AutoAimCommand) && !Aim.isLocked());
+    MotorSpeeds speeds;
+    PublishedMotorSpeeds.read(speeds);
+    Scoring.update(state.height, DriverInput.pressed(InputSampler::BUTTON_X), HeightTravel.isSettled(),
+                   speeds.rpm[ActuationFrame::FULL_POWER_RAMP], timer::system());
+    
+    // ============================================
+    // COMPUTE
+    // ============================================
+    // Every command stages its outputs in the frame - nothing is written to the robot yet
+    ActuationFrame frame;
+    uint32_t runStartUs = phaseClockUs();
+    Commands.run(frame);
+    SchedulerOverhead.add(phaseClockUs() - runStartUs);
     
-    // Calculate full power ramp motor power using our testable RampController
-    // Use full power mode (100% when active)
-    int fullPowerRampPower = RampController::calculateRampPower(fullPowerState, true, 0);
-    FullPowerRampMotor.spin(forward, fullPowerRampPower, percent);
+    // Spread each side's command over its three motors
+    balanceDrive(frame, speeds, timer::system());
     
     // ============================================
-    // PNEUMATIC HEIGHT CONTROL (Feature 4)
+    // ACTUATE
     // ============================================
+    // All nine motors and both pistons, back-to-back (left and right drive in pairs)
+    ActuationSkew.add(frame.apply(writeFrameMotor, writeFramePiston, phaseClockUs));
+    
+    // Balls grabbed, handed off or scored this tick
+    countBalls(frame, speeds, timer::system());
+    
+    // Record how long driver control took to act after the phase change
+    if (firstTick) {
+      firstTick = false;
+      Phases.markFirstTick();
+      printf("PHASE,hooks_us=%lu,first_tick_us=%lu\n",
+             (unsigned long)Phases.getHookLatencyUs(), (unsigned long)Phases.getFirstTickLatencyUs());
+    }
+    
+    // How long this input change took to reach the motors
+    if (inputChanged) {
+      InputLatency.add((uint32_t)timer::systemHighResolution() - DriverInput.changedAtUs);
+    }
     
-    // Toggle height position with Button A
-    // Detect button press (not hold) to toggle once per press
-    bool currentToggleButton = Controller1.ButtonA.pressing();
-    if (currentToggleButton && !lastToggleButtonState) {
-        // Button was just pressed (edge detection)
-        // Toggle to opposite position
-        currentHeight = PneumaticController::togglePosition(currentHeight);
-        
-        // Calculate piston state (true = extended, false = retracted)
-        bool pistonState = PneumaticController::calculatePistonState(currentHeight);
-        
-        // Set both pistons to the same state
-        Piston1.set(pistonState);
-        Piston2.set(pistonState);
-    }
-    lastToggleButtonState = currentToggleButton;  // Remember state for next loop
-    
-    // OPTION 2: ARCADE DRIVE (COMMENTED OUT - UNCOMMENT TO USE)
-    // Driver uses one stick: forward/backward controls speed, left/right controls turning
-    // This is more like a car - more intuitive for some drivers
-    
-    /*
-    // Read controller input
-    int forwardInput = Controller1.Axis3.position();    // Forward/backward
-    int turnInput = Controller1.Axis1.position();       // Left/right turning
-    
-    // Apply deadband to prevent drift
-    forwardInput = DriveTrain::applyDeadband(forwardInput, 5);
-    turnInput = DriveTrain::applyDeadband(turnInput, 5);
-    
-    // Calculate left and right motor powers using our testable DriveTrain class
-    int leftPowerArcade, rightPowerArcade;
-    DriveTrain::calculateArcadeDrive(forwardInput, turnInput, leftPowerArcade, rightPowerArcade);
-    
-    // Set motor speeds (clamping is handled inside calculateArcadeDrive!)
-    LeftDrive.spin(forward, leftPowerArcade, percent);
-    RightDrive.spin(forward, rightPowerArcade, percent);
-    */
-    
-    // Small delay to prevent the loop from running too fast
+    // Wait for the next controller change (at most 20 ms)
     // This gives the motors time to respond and saves processing power
-    wait(20, msec);  // Wait 20 milliseconds between loop cycles
+    waitForNextTick(tickStartMs);
   }
 }
 
@@ -234,6 +1949,25 @@ int main() {
   // Initialize the robot
   vexcodeInit();
   
+  // Measurement mode (no background tasks, so nothing else moves the motors)
+  if (ACTUATION_PROBE_MODE) {
+    runActuationProbe();
+    while (true) {
+      wait(100, msec);
+    }
+  }
+  
+  // Start tracking the robot's position in the background
+  task LocalizationTask = task(localizationTask);
+  task MotorVelocityTask = task(motorVelocityTask);
+  task EnergyTask = task(energyTask);
+  task MatchClockTask = task(matchClockTask);
+  task TipTask = task(tipTask);
+  task InputTask = task(inputTask);
+  
+  // Find the start tile and select the autonomous routine until the match starts
+  task StartDetectTask = task(startDetectTask);
+  
   // Competition mode (for competitions)
   Competition.autonomous(autonomous);   // Run autonomous() during autonomous period
   Competition.drivercontrol(usercontrol); // Run usercontrol() during driver control
@@ -0,0 +1,376 @@
+/*
+ * test_actuationframe.cpp
+ * 
+ * Unit tests for ActuationFrame class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our ActuationFrame class to test it
+#include "../src/controllers/ActuationFrame.h"
+
+// ============================================
+// HAL SIMULATOR
+// ============================================
+// A fake clock plus write functions that record when every actuator was written.
+// Each write costs WRITE_COST_US (a smart port command); compute() stands in for
+// the controller code that runs between writes.
+
+const uint32_t WRITE_COST_US = 40;
+
+uint32_t simClockUs = 0;
+uint32_t motorWriteUs[ActuationFrame::MOTOR_COUNT];
+int motorWritePower[ActuationFrame::MOTOR_COUNT];
+uint32_t pistonWriteUs[ActuationFrame::PISTON_COUNT];
+bool pistonWriteState[ActuationFrame::PISTON_COUNT];
+int writeCount = 0;
+uint32_t firstWriteUs = 0;
+uint32_t lastWriteUs = 0;
+
+void simReset() {
+    simClockUs = 1000;
+    writeCount = 0;
+    for (int i = 0; i < ActuationFrame::MOTOR_COUNT; i++) {
+        motorWriteUs[i] = 0;
+        motorWritePower[i] = 0;
+    }
+    for (int i = 0; i < ActuationFrame::PISTON_COUNT; i++) {
+        pistonWriteUs[i] = 0;
+        pistonWriteState[i] = false;
+    }
+}
+
+uint32_t simClock() {
+    return simClockUs;
+}
+
+void simRecordWrite() {
+    if (writeCount == 0) {
+        firstWriteUs = simClockUs;
+    }
+    lastWriteUs = simClockUs;
+    writeCount++;
+    simClockUs += WRITE_COST_US;
+}
+
+void simWriteMotor(ActuationFrame::Motor motor, int power) {
+    motorWriteUs[motor] = simClockUs;
+    motorWritePower[motor] = power;
+    simRecordWrite();
+}
+
+void simWritePiston(int piston, bool extended) {
+    pistonWriteUs[piston] = simClockUs;
+    pistonWriteState[piston] = extended;
+    simRecordWrite();
+}
+
+void compute(uint32_t costUs) {
+    simClockUs += costUs;
+}
+
+/**
+ * Skew between the first and last write of the tick
+ */
+uint32_t simSkewUs() {
+    return lastWriteUs - firstWriteUs;
+}
+
+/**
+ * Skew between the two drive sides: the worst gap between a left motor and its right partner
+ */
+uint32_t simDriveSkewUs() {
+    uint32_t worst = 0;
+    for (int i = 0; i < 3; i++) {
+        uint32_t leftUs = motorWriteUs[ActuationFrame::LEFT_FRONT + i];
+        uint32_t rightUs = motorWriteUs[ActuationFrame::RIGHT_FRONT + i];
+        uint32_t gap = (leftUs > rightUs) ? leftUs - rightUs : rightUs - leftUs;
+        if (gap > worst) worst = gap;
+    }
+    return worst;
+}
+
+// ============================================
+// TEST CASES FOR ACTUATION FRAME
+// ============================================
+
+/**
+ * Test: New Frame Is Safe
+ * 
+ * Given: A new frame
+ * When: Nothing is staged
+ * Then: Every motor is stopped and the pistons are retracted
+ */
+void testFrame_DefaultsSafe() {
+    ActuationFrame frame;
+    bool allStopped = true;
+    for (int i = 0; i < ActuationFrame::MOTOR_COUNT; i++) {
+        if (frame.getMotor((ActuationFrame::Motor)i) != 0) allStopped = false;
+    }
+    TestRunner::assertTrue(allStopped, "Frame - Motors start stopped");
+    TestRunner::assertTrue(!frame.getPiston(0) && !frame.getPiston(1), "Frame - Pistons start retracted");
+}
+
+/**
+ * Test: Staging
+ * 
+ * Given: A frame
+ * When: Stage drive, rollers and pistons
+ * Then: Each side gets its power, out-of-range powers are clamped
+ */
+void testFrame_Staging() {
+    ActuationFrame frame;
+    frame.setDrive(40, -70);
+    frame.setMotor(ActuationFrame::INTAKE, 150);
+    frame.setPistons(true);
+    
+    TestRunner::assertEquals(40, frame.getMotor(ActuationFrame::LEFT_MIDDLE), "Frame - Left side staged");
+    TestRunner::assertEquals(-70, frame.getMotor(ActuationFrame::RIGHT_BACK), "Frame - Right side staged");
+    TestRunner::assertEquals(100, frame.getMotor(ActuationFrame::INTAKE), "Frame - Power clamped");
+    TestRunner::assertTrue(frame.getPiston(0) && frame.getPiston(1), "Frame - Both pistons staged");
+}
+
+/**
+ * Test: Nothing Written Until Apply
+ * 
+ * Given: A frame with staged commands
+ * When: Before and after apply()
+ * Then: No writes while staging; every actuator written once by apply()
+ */
+void testFrame_WritesOnlyOnApply() {
+    simReset();
+    ActuationFrame frame;
+    frame.setDrive(50, 50);
+    frame.setMotor(ActuationFrame::RAMP, -100);
+    frame.setPistons(true);
+    TestRunner::assertEquals(0, writeCount, "Frame - Staging writes nothing");
+    
+    frame.apply(simWriteMotor, simWritePiston);
+    TestRunner::assertEquals(ActuationFrame::WRITE_COUNT, writeCount, "Frame - Every actuator written once");
+    TestRunner::assertEquals(-100, motorWritePower[ActuationFrame::RAMP], "Frame - Staged power written");
+    TestRunner::assertTrue(pistonWriteState[0] && pistonWriteState[1], "Frame - Staged pistons written");
+}
+
+/**
+ * Test: Drive Sides Written In Pairs
+ * 
+ * Given: The write order
+ * When: Check the first six writes
+ * Then: Each left motor is followed right away by its right partner
+ */
+void testFrame_DrivePairsAdjacent() {
+    bool paired = true;
+    for (int pair = 0; pair < 3; pair++) {
+        int left = ActuationFrame::writeOrder(pair * 2);
+        int right = ActuationFrame::writeOrder(pair * 2 + 1);
+        if (left != ActuationFrame::LEFT_FRONT + pair || right != ActuationFrame::RIGHT_FRONT + pair) {
+            paired = false;
+        }
+    }
+    TestRunner::assertTrue(paired, "Frame - Left and right written in pairs");
+    
+    // Every motor appears exactly once
+    int seen[ActuationFrame::MOTOR_COUNT] = {0};
+    for (int i = 0; i < ActuationFrame::MOTOR_COUNT; i++) {
+        seen[ActuationFrame::writeOrder(i)]++;
+    }
+    bool once = true;
+    for (int i = 0; i < ActuationFrame::MOTOR_COUNT; i++) {
+        if (seen[i] != 1) once = false;
+    }
+    TestRunner::assertTrue(once, "Frame - Each motor in the order once");
+}
+
+/**
+ * Test: Skew Measured By Apply
+ * 
+ * Given: The HAL simulator (40 us per write)
+ * When: apply() with the simulator clock
+ * Then: The returned skew matches the time the writes took
+ */
+void testFrame_MeasuresSkew() {
+    simReset();
+    ActuationFrame frame;
+    uint32_t skew = frame.apply(simWriteMotor, simWritePiston, simClock);
+    TestRunner::assertEquals((int)(ActuationFrame::WRITE_COUNT * WRITE_COST_US), (int)skew, "Frame - Skew measured");
+    
+    uint32_t unmeasured = frame.apply(simWriteMotor, simWritePiston);
+    TestRunner::assertEquals(0, (int)unmeasured, "Frame - No clock, no measurement");
+}
+
+/**
+ * Test: Sim - Burst vs Interleaved Writes
+ * 
+ * Given: One driver tick in the HAL simulator
+ * When: Writes are made as soon as each value is computed (the old loop) or
+ *       staged and written in one burst at the end
+ * Then: The burst has a far smaller skew and the drive sides land 40 us apart
+ */
+void testFrame_SimBurstVsInterleaved() {
+    // Old loop: drive, then compute each roller before writing it, then pistons
+    simReset();
+    compute(600);                                      // Sticks, quick turn, wall square, tip
+    for (int i = ActuationFrame::LEFT_FRONT; i <= ActuationFrame::LEFT_BACK; i++) {
+        simWriteMotor((ActuationFrame::Motor)i, 50);   // LeftDrive.spin()
+    }
+    for (int i = ActuationFrame::RIGHT_FRONT; i <= ActuationFrame::RIGHT_BACK; i++) {
+        simWriteMotor((ActuationFrame::Motor)i, 50);   // RightDrive.spin()
+    }
+    compute(150);
+    simWriteMotor(ActuationFrame::INTAKE, 100);
+    compute(150);
+    simWriteMotor(ActuationFrame::RAMP, 100);
+    compute(150);
+    simWriteMotor(ActuationFrame::FULL_POWER_RAMP, 100);
+    compute(200);
+    simWritePiston(0, true);
+    simWritePiston(1, true);
+    uint32_t interleavedSkew = simSkewUs();
+    uint32_t interleavedDriveSkew = simDriveSkewUs();
+    
+    // Sense, compute, then actuate
+    simReset();
+    ActuationFrame frame;
+    compute(600);
+    frame.setDrive(50, 50);
+    compute(150);
+    frame.setMotor(ActuationFrame::INTAKE, 100);
+    compute(150);
+    frame.setMotor(ActuationFrame::RAMP, 100);
+    compute(150);
+    frame.setMotor(ActuationFrame::FULL_POWER_RAMP, 100);
+    compute(200);
+    frame.setPistons(true);
+    uint32_t burstSkew = frame.apply(simWriteMotor, simWritePiston, simClock);
+    uint32_t burstDriveSkew = simDriveSkewUs();
+    
+    std::cout << "  Interleaved: skew " << interleavedSkew << " us, drive " << interleavedDriveSkew
+              << " us; burst: skew " << burstSkew << " us, drive " << burstDriveSkew << " us" << std::endl;
+    
+    TestRunner::assertEquals((int)((ActuationFrame::WRITE_COUNT - 1) * WRITE_COST_US), (int)simSkewUs(), "Sim - Burst skew is only the writes");
+    TestRunner::assertTrue(burstSkew * 2 < interleavedSkew, "Sim - Burst skew less than half");
+    TestRunner::assertTrue(burstDriveSkew < interleavedDriveSkew, "Sim - Drive sides closer together");
+    TestRunner::assertEquals((int)WRITE_COST_US, (int)(motorWriteUs[ActuationFrame::RIGHT_FRONT] - motorWriteUs[ActuationFrame::LEFT_FRONT]), "Sim - Left and right one write apart");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running ActuationFrame Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testFrame_DefaultsSafe();
+    testFrame_Staging();
+    testFrame_WritesOnlyOnApply();
+    testFrame_DrivePairsAdjacent();
+    testFrame_MeasuresSkew();
+    testFrame_SimBurstVsInterleaved();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,306 @@
+/*
+ * test_actuationprobe.cpp
+ * 
+ * Unit tests for ActuationProbe class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cstdlib>
+
+// Include our ActuationProbe class to test it
+#include "../src/controllers/ActuationProbe.h"
+
+// ============================================
+// SIMULATED MOTOR
+// ============================================
+// Dead time + first-order lag (the same model the probe fits). The encoder is
+// reported every REPORT_PERIOD_US, like a V5 smart motor.
+
+const uint32_t REPORT_PERIOD_US = 10000;
+
+struct SimMotor {
+    double deadTimeMs;
+    double timeConstantMs;
+    double steadyRpm;
+    
+    /**
+     * Degrees moved t microseconds after the step command
+     */
+    double position(uint32_t tUs) const {
+        double t = tUs / 1000.0 - deadTimeMs;
+        if (t <= 0.0) {
+            return 0.0;
+        }
+        double degPerMs = steadyRpm * 6.0 / 1000.0;
+        return degPerMs * (t - timeConstantMs * (1.0 - std::exp(-t / timeConstantMs)));
+    }
+    
+    /**
+     * Speed (rpm) t microseconds after the step command
+     */
+    double speed(uint32_t tUs) const {
+        double t = tUs / 1000.0 - deadTimeMs;
+        return (t <= 0.0) ? 0.0 : steadyRpm * (1.0 - std::exp(-t / timeConstantMs));
+    }
+};
+
+/**
+ * Run one trial: command at 1 s, encoder reports from phaseUs after it
+ */
+void runTrial(ActuationProbe& probe, const SimMotor& motor, uint32_t phaseUs, double startPosition = 100.0) {
+    const uint32_t COMMAND_US = 1000000;
+    probe.startTrial(COMMAND_US, startPosition);
+    uint32_t t = phaseUs;
+    while (!probe.addSample(COMMAND_US + t, startPosition + motor.position(t))) {
+        t += REPORT_PERIOD_US;
+    }
+}
+
+// ============================================
+// TEST CASES FOR ACTUATION PROBE
+// ============================================
+
+/**
+ * Test: First-Order Fit
+ * 
+ * Given: The 10% and 90% crossing times of a 20 ms dead time, 50 ms lag motor
+ * When: Fit
+ * Then: Both values come back
+ */
+void testProbe_FitFirstOrder() {
+    double deadTime, timeConstant;
+    ActuationProbe::fitFirstOrder(20.0 + 50.0 * 0.10536, 20.0 + 50.0 * 2.30259, deadTime, timeConstant);
+    TestRunner::assertNear(20.0, deadTime, 0.01, "Probe - Dead time fitted");
+    TestRunner::assertNear(50.0, timeConstant, 0.01, "Probe - Time constant fitted");
+}
+
+/**
+ * Test: One Trial On A Simulated Drive Motor
+ * 
+ * Given: 25 ms dead time, 40 ms lag, 190 rpm, encoder every 10 ms
+ * When: One step trial
+ * Then: First motion is seen within one report of the dead time, and the fitted
+ *       model is close to the real one
+ */
+void testProbe_SingleTrial() {
+    ActuationProbe probe;
+    SimMotor motor = {25.0, 40.0, 190.0};
+    runTrial(probe, motor, 3000);
+    ActuationProbe::TrialResult result = probe.getLastResult();
+    
+    TestRunner::assertTrue(result.valid, "Probe - Trial valid");
+    TestRunner::assertTrue(result.firstMotionUs >= 25000 && result.firstMotionUs <= 25000 + REPORT_PERIOD_US + 5000,
+                           "Probe - First motion just after the dead time");
+    TestRunner::assertNear(190.0, result.steadyRpm, 190.0 * 0.03, "Probe - Steady speed");
+    TestRunner::assertNear(25.0, result.deadTimeMs, 6.0, "Probe - Dead time close");
+    TestRunner::assertNear(40.0, result.timeConstantMs, 10.0, "Probe - Time constant close");
+    TestRunner::assertTrue(!probe.isRunning(), "Probe - Trial over");
+}
+
+/**
+ * Test: Motor That Never Moves
+ * 
+ * Given: A stalled or unplugged motor (encoder doesn't change)
+ * When: One trial
+ * Then: Counted as failed, nothing added to the distributions
+ */
+void testProbe_NoMotion() {
+    ActuationProbe probe;
+    SimMotor stalled = {0.0, 40.0, 0.0};
+    runTrial(probe, stalled, 0);
+    TestRunner::assertTrue(!probe.getLastResult().valid, "Probe - No motion is not valid");
+    TestRunner::assertEquals(1, probe.getFailedCount(), "Probe - Failure counted");
+    TestRunner::assertEquals(0, (int)probe.getMotionLatency().getCount(), "Probe - Nothing recorded");
+}
+
+/**
+ * Test: Too Many Readings
+ * 
+ * Given: Readings every 1 ms (more than MAX_SAMPLES in a trial)
+ * When: One trial
+ * Then: The trial ends when the buffer is full and still measures the step
+ */
+void testProbe_BufferFull() {
+    ActuationProbe probe;
+    SimMotor motor = {10.0, 20.0, 200.0};
+    const uint32_t COMMAND_US = 5000;
+    probe.startTrial(COMMAND_US, 0.0);
+    int readings = 0;
+    for (uint32_t t = 1000; !probe.addSample(COMMAND_US + t, motor.position(t)); t += 1000) {
+        readings++;
+    }
+    TestRunner::assertEquals(ActuationProbe::MAX_SAMPLES - 1, readings, "Probe - Ends when the buffer is full");
+    TestRunner::assertTrue(probe.getLastResult().valid, "Probe - Still measured");
+}
+
+/**
+ * Test: Sim - Distributions Over Many Trials, Model For The Simulator
+ * 
+ * Given: The three motor types (drive 18:1 under load, 5.5W intake/ramp, full power
+ *        top wheel), each with dead time jitter and a random encoder report phase
+ * When: 50 trials per motor
+ * Then: The fitted model is close to the true one, and a simulator motor built from
+ *       it follows the real motor's speed within a few percent
+ */
+void testProbe_SimManyTrials() {
+    SimMotor types[3] = {
+        {22.0, 60.0, 180.0},  // Drive (wheels on the ground)
+        {18.0, 30.0, 195.0},  // 5.5W intake / ramp
+        {20.0, 45.0, 200.0}   // Full power top wheel (flywheel inertia)
+    };
+    const char* names[3] = {"drive", "intake", "top wheel"};
+    std::srand(7);
+    
+    for (int type = 0; type < 3; type++) {
+        ActuationProbe probe;
+        for (int trial = 0; trial < 50; trial++) {
+            SimMotor motor = types[type];
+            motor.deadTimeMs += (std::rand() % 7) - 3;  // +-3 ms firmware jitter
+            runTrial(probe, motor, (uint32_t)(std::rand() % REPORT_PERIOD_US));
+        }
+        ActuationProbe::MotorModel model = probe.getModel();
+        
+        // Simulator motor from the measured model vs the real motor
+        SimMotor fitted = {model.deadTimeMs, model.timeConstantMs, model.steadyRpm};
+        double worstError = 0.0;
+        for (uint32_t t = 0; t <= 300000; t += 1000) {
+            double error = std::fabs(fitted.speed(t) - types[type].speed(t)) / types[type].steadyRpm;
+            if (error > worstError) worstError = error;
+        }
+        
+        std::cout << "  " << names[type] << ": first motion mean " << probe.getMotionLatency().getMean() / 1000.0
+                  << " ms (p95 " << probe.getMotionLatency().getPercentile(95.0) / 1000.0
+                  << "), rise mean " << probe.getRiseTime().getMean() / 1000.0 << " ms; model dead "
+                  << model.deadTimeMs << " ms, tau " << model.timeConstantMs << " ms, "
+                  << model.steadyRpm << " rpm; worst speed error " << worstError * 100.0 << "%" << std::endl;
+        
+        TestRunner::assertEquals(0, probe.getFailedCount(), "Sim - Every trial valid");
+        TestRunner::assertNear(types[type].deadTimeMs, model.deadTimeMs, 4.0, "Sim - Dead time recovered");
+        TestRunner::assertNear(types[type].timeConstantMs, model.timeConstantMs, types[type].timeConstantMs * 0.15, "Sim - Time constant recovered");
+        TestRunner::assertTrue(worstError < 0.05, "Sim - Fitted simulator motor tracks the real one");
+        TestRunner::assertTrue(probe.getMotionLatency().getMean() > types[type].deadTimeMs * 1000.0,
+                               "Sim - First motion comes after the dead time");
+    }
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running ActuationProbe Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testProbe_FitFirstOrder();
+    testProbe_SingleTrial();
+    testProbe_NoMotion();
+    testProbe_BufferFull();
+    testProbe_SimManyTrials();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
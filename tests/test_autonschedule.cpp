@@ -0,0 +1,477 @@
+/*
+ * test_autonschedule.cpp
+ * 
+ * Unit tests for AutonSchedule class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our AutonSchedule class to test it
+#include "../src/controllers/AutonSchedule.h"
+
+// ============================================
+// MATCH SIMULATOR
+// ============================================
+
+/**
+ * Small deterministic random numbers (same matches on every run)
+ */
+struct MatchRandom {
+    uint32_t state;
+    
+    double uniform(double low, double high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * ((state >> 8) / 16777216.0);
+    }
+};
+
+const uint32_t PERIOD_MS = 15000;
+const uint32_t TICK_MS = 10;
+
+/**
+ * The example routine: score the preload, fetch and score two balls, touch the bar
+ * (14 s expected out of 15)
+ */
+const int ROUTINE_STEPS = 7;
+
+void addRoutine(AutonSchedule& schedule) {
+    schedule.clear();
+    schedule.addStep("preload", 1500, 2.0);
+    int drive = schedule.addStep("drive to balls", 2000, 0.0);
+    int pickup = schedule.addStep("pick up 1", 2000, 0.0, drive);
+    int score = schedule.addStep("score 1", 2500, 3.0, pickup);
+    int pickup2 = schedule.addStep("pick up 2", 2000, 0.0, score);
+    schedule.addStep("score 2", 2500, 3.0, pickup2);
+    schedule.addStep("touch bar", 1500, 2.0);
+}
+
+/**
+ * How one match goes: what each step really takes, and whether it works
+ * 
+ * The whole robot runs a bit fast or slow (battery, field), every step varies, and a
+ * pickup sometimes chases the ball for a long time or finds none.
+ */
+struct Match {
+    uint32_t takesMs[AutonSchedule::MAX_STEPS];
+    bool works[AutonSchedule::MAX_STEPS];
+};
+
+Match drawMatch(const AutonSchedule& schedule, const uint32_t expectedMs[], MatchRandom& random) {
+    Match match;
+    double robot = random.uniform(0.9, 1.2);
+    for (int i = 0; i < schedule.getStepCount(); i++) {
+        double takes = expectedMs[i] * robot * random.uniform(0.85, 1.2);
+        bool pickup = schedule.getName(i)[0] == 'p' && schedule.getName(i)[1] == 'i';
+        double chase = random.uniform(0.0, 1.0);
+        double slow = random.uniform(1.5, 3.0);
+        if (pickup && chase < 0.25) {
+            takes *= slow;
+        }
+        match.takesMs[i] = (uint32_t)takes;
+        match.works[i] = !(pickup && chase > 0.92);
+    }
+    return match;
+}
+
+/**
+ * Fixed order: every step in turn, each run until it ends; points only for steps that
+ * end before the buzzer
+ */
+double runFixed(const double points[], const int needs[], int count, const Match& match) {
+    bool done[AutonSchedule::MAX_STEPS];
+    uint32_t now = 0;
+    double score = 0.0;
+    for (int i = 0; i < count; i++) {
+        done[i] = false;
+        if (needs[i] != AutonSchedule::NO_STEP && !done[needs[i]]) {
+            continue;  // Nothing to score
+        }
+        now += match.takesMs[i];
+        if (now > PERIOD_MS) {
+            break;  // Mid-move at the buzzer
+        }
+        done[i] = match.works[i];
+        if (done[i]) {
+            score += points[i];
+        }
+    }
+    return score;
+}
+
+/**
+ * The schedule decides, checked every tick; the period ends at the buzzer
+ */
+double runScheduled(AutonSchedule& schedule, const Match& match) {
+    uint32_t now = 0;
+    schedule.start(now, PERIOD_MS);
+    while (now < PERIOD_MS) {
+        int step = schedule.next(now);
+        if (step == AutonSchedule::NO_STEP) {
+            break;
+        }
+        uint32_t started = now;
+        bool ended = false;
+        while (now < PERIOD_MS && !ended) {
+            now += TICK_MS;
+            if (now - started >= match.takesMs[step]) {
+                schedule.finishStep(now, match.works[step]);
+                ended = true;
+            } else if (!schedule.update(now)) {
+                schedule.finishStep(now, false);
+                ended = true;
+            }
+        }
+    }
+    return schedule.getScore();
+}
+
+// ============================================
+// TEST CASES FOR AUTON SCHEDULE
+// ============================================
+
+/**
+ * Test: On Time
+ * 
+ * Given: Steps that all fit in the period
+ * When: Each takes what it was expected to
+ * Then: They run in the listed order, and all of them count
+ */
+void testSchedule_OnTimeKeepsOrder() {
+    AutonSchedule schedule;
+    addRoutine(schedule);
+    schedule.start(0, PERIOD_MS);
+    
+    uint32_t now = 0;
+    bool inOrder = true;
+    for (int i = 0; i < ROUTINE_STEPS; i++) {
+        int step = schedule.next(now);
+        inOrder = inOrder && step == i;
+        TestRunner::assertTrue(schedule.update(now + 1000), "Schedule On Time - Keeps going");
+        now += (step == AutonSchedule::NO_STEP) ? 0 : 2000 - 500 * (i == 0 || i == 6);
+        now += (i == 3 || i == 5) ? 500 : 0;
+        schedule.finishStep(now, true);
+    }
+    TestRunner::assertTrue(inOrder, "Schedule On Time - Listed order");
+    TestRunner::assertEquals(AutonSchedule::NO_STEP, schedule.next(now), "Schedule On Time - Nothing left");
+    TestRunner::assertNear(10.0, schedule.getScore(), 0.001, "Schedule On Time - Every point");
+    TestRunner::assertNear(1.0, schedule.getPace(), 0.001, "Schedule On Time - Pace 1");
+}
+
+/**
+ * Test: Behind
+ * 
+ * Given: Steps that don't all fit
+ * When: Picking the next steps
+ * Then: The most points per second first, then what still fits; the one that doesn't
+ *       fit anymore is only tried when nothing else is left
+ */
+void testSchedule_BehindRunsBestFirst() {
+    AutonSchedule schedule;
+    schedule.addStep("small", 3000, 2.0);
+    schedule.addStep("big", 3000, 3.0);
+    schedule.addStep("short", 1000, 1.0);
+    schedule.start(0, 5000);
+    
+    TestRunner::assertTrue(schedule.isBehind(0), "Schedule Behind - Behind");
+    TestRunner::assertEquals(1, schedule.next(0), "Schedule Behind - Bigger one first");
+    schedule.finishStep(3000, true);
+    TestRunner::assertEquals(2, schedule.next(3000), "Schedule Behind - Then the one that fits");
+    schedule.finishStep(4000, true);
+    TestRunner::assertEquals(0, schedule.next(4000), "Schedule Behind - Last one last");
+    schedule.finishStep(5000, false);
+    TestRunner::assertEquals(AutonSchedule::NO_STEP, schedule.next(5000), "Schedule Behind - Nothing left");
+    TestRunner::assertNear(4.0, schedule.getScore(), 0.001, "Schedule Behind - Score");
+}
+
+/**
+ * Test: Setup Steps
+ * 
+ * Given: A pickup (0 points) that a score needs, and a short step worth a little
+ * When: Pickup + score no longer fit
+ * Then: The short step runs first; with time for all three, the pickup and score (more
+ *       points per second) go first
+ */
+void testSchedule_SetupStepNeedsItsChain() {
+    AutonSchedule schedule;
+    int pickup = schedule.addStep("pick up", 2000, 0.0);
+    schedule.addStep("score", 1500, 4.0, pickup);
+    int bar = schedule.addStep("touch bar", 1000, 2.0);
+    TestRunner::assertEquals(AutonSchedule::NO_STEP, schedule.addStep("bad", 1000, 1.0, 5),
+                             "Schedule Setup - Needs an earlier step");
+    
+    schedule.start(0, 3200);
+    TestRunner::assertEquals(bar, schedule.next(0), "Schedule Setup - Short step runs");
+    TestRunner::assertEquals(AutonSchedule::PENDING, schedule.getState(pickup), "Schedule Setup - Pickup passed over");
+    
+    schedule.start(0, 4000);
+    TestRunner::assertEquals(pickup, schedule.next(0), "Schedule Setup - Chain first when it fits");
+}
+
+/**
+ * Test: Failed Step
+ * 
+ * Given: A pickup that finds no ball
+ * When: It ends without finishing
+ * Then: The score that needs it is skipped; the rest goes on
+ */
+void testSchedule_FailedStepSkipsWhatNeedsIt() {
+    AutonSchedule schedule;
+    int pickup = schedule.addStep("pick up", 2000, 0.0);
+    int score = schedule.addStep("score", 1500, 4.0, pickup);
+    int bar = schedule.addStep("touch bar", 1000, 2.0);
+    schedule.start(0, PERIOD_MS);
+    
+    schedule.next(0);
+    schedule.finishStep(2000, false);
+    TestRunner::assertEquals(AutonSchedule::FAILED, schedule.getState(pickup), "Schedule Failed - Failed");
+    TestRunner::assertEquals(AutonSchedule::SKIPPED, schedule.getState(score), "Schedule Failed - Score skipped");
+    TestRunner::assertEquals(bar, schedule.next(2000), "Schedule Failed - Next step");
+}
+
+/**
+ * Test: Overrunning Step
+ * 
+ * Given: A pickup running long, with the score that needs it and a short step
+ * When: Checking it every tick
+ * Then: It keeps going while pickup + score can still finish, and is stopped for the
+ *       short step as soon as they can't; with nothing else to do it is never stopped
+ */
+void testSchedule_AbandonsOverrunningStep() {
+    AutonSchedule schedule;
+    int pickup = schedule.addStep("pick up", 2000, 0.0);
+    schedule.addStep("score", 2000, 3.0, pickup);
+    int bar = schedule.addStep("touch bar", 1500, 2.0);
+    schedule.start(0, 6000);
+    schedule.next(0);
+    
+    uint32_t stoppedAt = 0;
+    for (uint32_t now = 0; now < 10000 && stoppedAt == 0; now += TICK_MS) {
+        if (!schedule.update(now)) {
+            stoppedAt = now;
+        }
+    }
+    // Past its time it is counted as needing OVERRUN_LEFT more
+    uint32_t lastChanceMs = 6000 - AutonSchedule::END_MARGIN_MS - 2000 - 500;
+    TestRunner::assertNear(lastChanceMs, stoppedAt, TICK_MS, "Schedule Overrun - Stopped when the score can't fit");
+    schedule.finishStep(stoppedAt, false);
+    TestRunner::assertEquals(bar, schedule.next(stoppedAt), "Schedule Overrun - Short step next");
+    
+    AutonSchedule alone;
+    alone.addStep("pick up", 2000, 1.0);
+    alone.start(0, 5000);
+    alone.next(0);
+    TestRunner::assertTrue(alone.update(8000), "Schedule Overrun - Nothing better, keeps going");
+}
+
+/**
+ * Test: Buzzer
+ * 
+ * Given: A step that can no longer finish before the end of the period
+ * When: A shorter step still fits
+ * Then: The running step is stopped for it
+ */
+void testSchedule_StopsStepThatCantFinish() {
+    AutonSchedule schedule;
+    schedule.addStep("score", 3000, 3.0);
+    schedule.addStep("touch bar", 500, 2.0);
+    schedule.start(0, 3800);
+    schedule.next(0);
+    
+    TestRunner::assertTrue(schedule.update(2800), "Schedule Buzzer - Fits at first");
+    TestRunner::assertTrue(!schedule.update(3010), "Schedule Buzzer - Stopped for the short step");
+}
+
+/**
+ * Test: Pace
+ * 
+ * Given: Steps finishing slower than expected
+ * When: Reading the pace
+ * Then: Time taken / time expected, limited to MAX_PACE
+ */
+void testSchedule_Pace() {
+    AutonSchedule schedule;
+    schedule.addStep("a", 1000, 1.0);
+    schedule.addStep("b", 1000, 1.0);
+    schedule.start(0, PERIOD_MS);
+    
+    schedule.next(0);
+    schedule.finishStep(1200, true);
+    TestRunner::assertNear(1.2, schedule.getPace(), 0.001, "Schedule Pace - 20% slow");
+    schedule.next(1200);
+    schedule.finishStep(4200, true);
+    TestRunner::assertNear(AutonSchedule::MAX_PACE, schedule.getPace(), 0.001, "Schedule Pace - Limited");
+}
+
+/**
+ * Test: Monte Carlo Expected Score
+ * 
+ * Given: The example routine over 5000 simulated matches (slow robots, slow or empty
+ *        pickups)
+ * When: Running it in a fixed order vs. through the schedule
+ * Then: The schedule's expected score is higher, it beats the fixed order much more often
+ *       than it loses to it, and it never loses a point in a match that runs on time
+ */
+void testSchedule_MonteCarloExpectedScore() {
+    AutonSchedule schedule;
+    addRoutine(schedule);
+    uint32_t expectedMs[ROUTINE_STEPS] = {1500, 2000, 2000, 2500, 2000, 2500, 1500};
+    double points[ROUTINE_STEPS] = {2.0, 0.0, 0.0, 3.0, 0.0, 3.0, 2.0};
+    int needs[ROUTINE_STEPS] = {-1, -1, 1, 2, 3, 4, -1};
+    
+    MatchRandom random;
+    random.state = 12345;
+    const int MATCHES = 5000;
+    double fixedTotal = 0.0;
+    double scheduledTotal = 0.0;
+    int better = 0;
+    int worse = 0;
+    int onTime = 0;
+    int onTimeWorse = 0;
+    for (int n = 0; n < MATCHES; n++) {
+        Match match = drawMatch(schedule, expectedMs, random);
+        double fixed = runFixed(points, needs, ROUTINE_STEPS, match);
+        double scheduled = runScheduled(schedule, match);
+        fixedTotal += fixed;
+        scheduledTotal += scheduled;
+        better += (scheduled > fixed) ? 1 : 0;
+        worse += (scheduled < fixed) ? 1 : 0;
+        
+        uint32_t total = 0;
+        for (int i = 0; i < ROUTINE_STEPS; i++) {
+            total += match.takesMs[i];
+        }
+        if (total + AutonSchedule::END_MARGIN_MS <= PERIOD_MS) {
+            onTime++;
+            onTimeWorse += (scheduled < fixed) ? 1 : 0;
+        }
+    }
+    double fixedMean = fixedTotal / MATCHES;
+    double scheduledMean = scheduledTotal / MATCHES;
+    std::cout << "  Expected score: fixed order " << fixedMean << ", scheduled " << scheduledMean
+              << " (better in " << better << ", worse in " << worse << " of " << MATCHES
+              << " matches; " << onTime << " on time)" << std::endl;
+    
+    TestRunner::assertTrue(scheduledMean > fixedMean + 0.3, "Schedule Monte Carlo - Higher expected score");
+    TestRunner::assertTrue(better > 2 * worse, "Schedule Monte Carlo - Better at least twice as often as worse");
+    TestRunner::assertEquals(0, onTimeWorse, "Schedule Monte Carlo - Never worse on time");
+}
+
+int main() {
+    std::cout << "=== Running AutonSchedule Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testSchedule_OnTimeKeepsOrder();
+    testSchedule_BehindRunsBestFirst();
+    testSchedule_SetupStepNeedsItsChain();
+    testSchedule_FailedStepSkipsWhatNeedsIt();
+    testSchedule_AbandonsOverrunningStep();
+    testSchedule_StopsStepThatCantFinish();
+    testSchedule_Pace();
+    testSchedule_MonteCarloExpectedScore();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,641 @@
+/*
+ * test_balldetector.cpp
+ * 
+ * Unit tests for BallDetector class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our BallDetector class to test it
+#include "../src/controllers/BallDetector.h"
+#include "../src/controllers/IntakeController.h"
+
+// ============================================
+// SIMULATED MOTOR READINGS
+// ============================================
+
+const uint32_t TICK_MS = 10;
+const double FREE_AMPS = 0.35;
+const double FREE_RPM = 190.0;
+
+/**
+ * Feed steady running readings, then an optional half-sine ball signature
+ * 
+ * @return Time after the last reading
+ */
+uint32_t feedRunning(BallDetector& detector, BallDetector::Channel channel, uint32_t nowMs, int ticks,
+                     int power = 100, double bumpAmps = 0.0, double dipRpm = 0.0, int bumpTicks = 8,
+                     int* detections = nullptr) {
+    for (int i = 0; i < ticks + bumpTicks; i++) {
+        double shape = 0.0;
+        if (i >= ticks) {
+            shape = std::sin(3.14159265358979 * (i - ticks + 0.5) / bumpTicks);
+        }
+        double sign = (power < 0) ? -1.0 : 1.0;
+        bool hit = detector.update(channel, FREE_AMPS + bumpAmps * shape, sign * (FREE_RPM - dipRpm * shape),
+                                   power, nowMs);
+        if (hit && detections != nullptr) {
+            (*detections)++;
+        }
+        nowMs += TICK_MS;
+    }
+    return nowMs;
+}
+
+// ============================================
+// LABELED LOGS
+// ============================================
+// Synthetic logs with every ball labeled, standing in for recorded robot logs.
+// The motor starts and stops, changes direction, sags with the battery, gets
+// jolted by the drive, and carries sensor noise; ball signatures vary in size
+// and length.
+
+const int LOG_TICKS = 12000;  // 2 min at 10 ms
+const int MAX_LABELS = 200;
+
+struct LabeledLog {
+    double amps[LOG_TICKS];
+    double rpm[LOG_TICKS];
+    int power[LOG_TICKS];
+    int labelStart[MAX_LABELS];  // First tick of each ball signature
+    int labelEnd[MAX_LABELS];    // Last tick
+    int labelCount;
+};
+
+LabeledLog IntakeLog;
+LabeledLog RampLog;
+
+/**
+ * Small deterministic random numbers (same logs on every run)
+ */
+struct LogRandom {
+    uint32_t state;
+    
+    double uniform(double low, double high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * ((state >> 8) / 16777216.0);
+    }
+    
+    double gaussian(double sigma) {
+        double u1 = uniform(1e-9, 1.0);
+        double u2 = uniform(0.0, 1.0);
+        return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * 3.14159265358979 * u2);
+    }
+};
+
+/**
+ * Feed readings at uneven tick periods, with an optional ball signature at a set time
+ * 
+ * @param minTickMs, maxTickMs Range of tick periods (the same value = a fixed period)
+ * @param bumpAtMs Time since the start when the signature begins (negative = no ball)
+ * @param bumpMs Length of the signature
+ * @return Detections
+ */
+int feedTimed(BallDetector& detector, uint32_t startMs, uint32_t durationMs, uint32_t minTickMs,
+              uint32_t maxTickMs, int bumpAtMs, double bumpMs, uint32_t seed) {
+    LogRandom random = {seed};
+    int detections = 0;
+    uint32_t t = 0;
+    while (t < durationMs) {
+        double shape = 0.0;
+        double sinceBump = (double)t - bumpAtMs;
+        if (bumpAtMs >= 0 && sinceBump >= 0.0 && sinceBump < bumpMs) {
+            shape = std::sin(3.14159265358979 * sinceBump / bumpMs);
+        }
+        if (detector.update(BallDetector::INTAKE, FREE_AMPS + 0.5 * shape, FREE_RPM - 15.0 * shape, 100, startMs + t)) {
+            detections++;
+        }
+        t += (uint32_t)random.uniform((double)minTickMs, maxTickMs + 0.999);
+    }
+    return detections;
+}
+
+/**
+ * Intake holding R1 with the ground-speed-matched intake while the robot changes speed:
+ * the command steps (or ramps) from one power to another, the motor's velocity loop
+ * follows (its current rises with the speed error), and an optional grab comes along
+ * 
+ * @param tickMs Tick period
+ * @param fromPower, toPower Command before changeAtMs and after the ramp
+ * @param bumpAtMs Time of a grab signature (negative = no ball)
+ * @param rampMs How long the command takes to get from one to the other (0 = a step)
+ * @return Detections
+ */
+int feedSpeedChange(BallDetector& detector, uint32_t tickMs, int fromPower, int toPower, uint32_t changeAtMs,
+                    int bumpAtMs, uint32_t rampMs = 0) {
+    const double TAU_MS = 50.0;
+    int detections = 0;
+    double rpm = 1.9 * fromPower;
+    for (uint32_t t = 0; t < 2000; t += tickMs) {
+        int power = toPower;
+        if (t < changeAtMs) {
+            power = fromPower;
+        } else if (t < changeAtMs + rampMs) {
+            power = fromPower + (int)std::lround((toPower - fromPower) * (double)(t - changeAtMs) / rampMs);
+        }
+        double target = 1.9 * power;
+        rpm += (target - rpm) * tickMs / TAU_MS;
+        double shape = 0.0;
+        double sinceBump = (double)t - bumpAtMs;
+        if (bumpAtMs >= 0 && sinceBump >= 0.0 && sinceBump < 80.0) {
+            shape = std::sin(3.14159265358979 * sinceBump / 80.0);
+        }
+        double amps = 0.2 + 0.15 * rpm / FREE_RPM + 0.008 * std::fabs(target - rpm) + 0.5 * shape;
+        if (detector.update(BallDetector::INTAKE, amps, rpm - 15.0 * shape, power, 1000 + t)) {
+            detections++;
+        }
+    }
+    return detections;
+}
+
+/**
+ * Build a labeled log
+ * 
+ * @param freeAmps Current when running without a ball
+ * @param minBumpAmps, maxBumpAmps Range of ball current bumps
+ * @param minDipRpm, maxDipRpm Range of ball speed dips
+ */
+void makeLog(LabeledLog& log, uint32_t seed, double freeAmps, double minBumpAmps, double maxBumpAmps,
+             double minDipRpm, double maxDipRpm) {
+    LogRandom random = {seed};
+    log.labelCount = 0;
+    
+    int tick = 0;
+    double rpm = 0.0;
+    double spikeAmps = 0.0;
+    while (tick < LOG_TICKS) {
+        // A segment: run forward (sometimes reverse), then stop
+        int power = (random.uniform(0.0, 1.0) < 0.15) ? -100 : 100;
+        int runTicks = (int)random.uniform(300, 800);
+        int stopTicks = (int)random.uniform(50, 150);
+        int nextBall = tick + (int)random.uniform(30, 80);
+        spikeAmps = 1.2;  // Start-up current
+        
+        for (int t = 0; t < runTicks + stopTicks && tick < LOG_TICKS; t++, tick++) {
+            bool running = t < runTicks;
+            double sag = 1.0 - 0.08 * tick / LOG_TICKS;  // Battery sag over the log
+            double target = running ? FREE_RPM * sag * power / 100.0 : 0.0;
+            rpm += (target - rpm) / 3.0;
+            spikeAmps *= 0.6;
+            double amps = running ? freeAmps + spikeAmps : 0.0;
+            
+            // Drive jolts: one-tick current spikes
+            if (running && random.uniform(0.0, 1.0) < 0.005) {
+                amps += 0.3;
+            }
+            
+            // Ball signature
+            if (running && tick == nextBall && log.labelCount < MAX_LABELS && t + 12 < runTicks) {
+                int length = (int)random.uniform(5, 12);
+                double bump = random.uniform(minBumpAmps, maxBumpAmps);
+                double dip = random.uniform(minDipRpm, maxDipRpm);
+                log.labelStart[log.labelCount] = tick;
+                log.labelEnd[log.labelCount] = tick + length - 1;
+                log.labelCount++;
+                for (int k = 0; k < length && tick + k < LOG_TICKS; k++) {
+                    double shape = std::sin(3.14159265358979 * (k + 0.5) / length);
+                    log.amps[tick + k] = bump * shape;
+                    log.rpm[tick + k] = -dip * shape * (power > 0 ? 1.0 : -1.0);
+                }
+                nextBall = tick + (int)random.uniform(40, 150);
+            } else if (tick == nextBall) {
+                nextBall = tick + (int)random.uniform(40, 150);
+            }
+            
+            // Signature (written ahead above) on top of the running motor, plus noise
+            bool inBall = log.labelCount > 0 && tick >= log.labelStart[log.labelCount - 1] &&
+                          tick <= log.labelEnd[log.labelCount - 1];
+            double ballAmps = inBall ? log.amps[tick] : 0.0;
+            double ballRpm = inBall ? log.rpm[tick] : 0.0;
+            log.amps[tick] = running ? amps + ballAmps + random.gaussian(0.04) : random.gaussian(0.01);
+            log.rpm[tick] = rpm + ballRpm + random.gaussian(2.5);
+            log.power[tick] = running ? power : 0;
+        }
+    }
+}
+
+/**
+ * Detection accuracy against the labels
+ */
+struct Accuracy {
+    int truePositives;
+    int falsePositives;
+    int missed;
+    
+    double recall() const {
+        return truePositives / (double)(truePositives + missed);
+    }
+    
+    double precision() const {
+        return truePositives / (double)(truePositives + falsePositives);
+    }
+};
+
+/**
+ * Run the detector over a log; a detection matches a label if it comes between the
+ * start of the signature and one window after its end
+ */
+Accuracy scoreLog(const LabeledLog& log, BallDetector::Channel channel) {
+    BallDetector detector;
+    Accuracy accuracy = {0, 0, 0};
+    bool matched[MAX_LABELS] = {false};
+    
+    for (int tick = 0; tick < LOG_TICKS; tick++) {
+        if (!detector.update(channel, log.amps[tick], log.rpm[tick], log.power[tick], tick * TICK_MS)) {
+            continue;
+        }
+        bool found = false;
+        for (int i = 0; i < log.labelCount && !found; i++) {
+            if (!matched[i] && tick >= log.labelStart[i] && tick <= log.labelEnd[i] + BallDetector::WINDOW) {
+                matched[i] = true;
+                found = true;
+            }
+        }
+        if (found) {
+            accuracy.truePositives++;
+        } else {
+            accuracy.falsePositives++;
+        }
+    }
+    for (int i = 0; i < log.labelCount; i++) {
+        if (!matched[i]) {
+            accuracy.missed++;
+        }
+    }
+    return accuracy;
+}
+
+// ============================================
+// TEST CASES FOR BALL DETECTOR
+// ============================================
+
+/**
+ * Test: Steady Running Is Not A Ball
+ * 
+ * Given: The intake running steadily
+ * When: 2 s of readings
+ * Then: No detections, count stays 0
+ */
+void testBall_SteadyRunning() {
+    BallDetector detector;
+    int detections = 0;
+    feedRunning(detector, BallDetector::INTAKE, 1000, 200, 100, 0.0, 0.0, 8, &detections);
+    
+    TestRunner::assertEquals(0, detections, "Ball - Steady running detects nothing");
+    TestRunner::assertEquals(0, detector.getCount(), "Ball - Count stays 0");
+}
+
+/**
+ * Test: A Grab Is Counted
+ * 
+ * Given: The intake running forward
+ * When: A 0.5 A bump with a 15 rpm dip
+ * Then: Exactly one detection; count 1
+ */
+void testBall_GrabCounted() {
+    BallDetector detector;
+    int detections = 0;
+    uint32_t now = feedRunning(detector, BallDetector::INTAKE, 1000, 40, 100, 0.5, 15.0, 8, &detections);
+    feedRunning(detector, BallDetector::INTAKE, now, 20, 100, 0.0, 0.0, 8, &detections);
+    
+    TestRunner::assertEquals(1, detections, "Ball - One grab, one detection");
+    TestRunner::assertEquals(1, detector.getCount(), "Ball - Count 1 after a grab");
+    TestRunner::assertTrue(detector.getScore(BallDetector::INTAKE) < BallDetector::DETECT_THRESHOLD,
+                           "Ball - Filter output falls back after the ball");
+}
+
+/**
+ * Test: Spin-Up Is Ignored
+ * 
+ * Given: A stopped intake
+ * When: It starts (current spike, speed rising) and a grab-sized bump comes 100 ms in
+ * Then: Nothing is counted while spinning up
+ */
+void testBall_SpinUpIgnored() {
+    BallDetector detector;
+    int detections = 0;
+    uint32_t now = 1000;
+    for (int i = 0; i < 20; i++) {
+        double amps = FREE_AMPS + 1.2 * std::pow(0.6, i);
+        double rpm = FREE_RPM * (1.0 - std::pow(0.67, i + 1));
+        if (detector.update(BallDetector::INTAKE, amps, rpm, 100, now)) {
+            detections++;
+        }
+        now += TICK_MS;
+    }
+    feedRunning(detector, BallDetector::INTAKE, now, 40, 100, 0.0, 0.0, 8, &detections);
+    
+    TestRunner::assertEquals(0, detections, "Ball - Start-up spike is not a ball");
+}
+
+/**
+ * Test: Two Balls Closer Than The Minimum Gap
+ * 
+ * Given: A ball just detected
+ * When: A second signature 100 ms later (less than MIN_GAP_MS)
+ * Then: Counted once; a ball after the gap is counted again
+ */
+void testBall_MinimumGap() {
+    BallDetector detector;
+    int detections = 0;
+    uint32_t now = feedRunning(detector, BallDetector::INTAKE, 1000, 40, 100, 0.5, 15.0, 6, &detections);
+    now = feedRunning(detector, BallDetector::INTAKE, now, 0, 100, 0.5, 15.0, 6, &detections);
+    TestRunner::assertEquals(1, detections, "Ball - Second bump within the gap ignored");
+    
+    now = feedRunning(detector, BallDetector::INTAKE, now, 30, 100, 0.5, 15.0, 8, &detections);
+    feedRunning(detector, BallDetector::INTAKE, now, 20, 100, 0.0, 0.0, 8, &detections);
+    TestRunner::assertEquals(2, detections, "Ball - Ball after the gap counted");
+}
+
+/**
+ * Test: Spitting Out
+ * 
+ * Given: Two balls in the robot
+ * When: The intake runs in reverse and a ball signature appears
+ * Then: Count goes down to 1
+ */
+void testBall_SpitOut() {
+    BallDetector detector;
+    detector.reset(2);
+    uint32_t now = feedRunning(detector, BallDetector::INTAKE, 1000, 40, -100, 0.5, 15.0);
+    feedRunning(detector, BallDetector::INTAKE, now, 20, -100);
+    
+    TestRunner::assertEquals(1, detector.getCount(), "Ball - Spitting out lowers the count");
+}
+
+/**
+ * Test: Ramp Hand-Off And Scoring
+ * 
+ * Given: Two balls in the robot
+ * When: The ramp carries one up (wheel not feeding), then feeds one into the wheel
+ * Then: Hand-off leaves the count alone; feeding the wheel lowers it
+ */
+void testBall_RampHandOffAndScore() {
+    BallDetector detector;
+    detector.reset(2);
+    
+    uint32_t now = feedRunning(detector, BallDetector::RAMP, 1000, 40, 100, 0.4, 12.0);
+    now = feedRunning(detector, BallDetector::RAMP, now, 20);
+    TestRunner::assertEquals(1, detector.getDetectionCount(BallDetector::RAMP), "Ball - Hand-off detected");
+    TestRunner::assertEquals(2, detector.getCount(), "Ball - Hand-off keeps the count");
+    
+    detector.setWheelFeeding(true);
+    now = feedRunning(detector, BallDetector::RAMP, now, 10, 100, 0.4, 12.0);
+    feedRunning(detector, BallDetector::RAMP, now, 20);
+    TestRunner::assertEquals(1, detector.getCount(), "Ball - Scored ball leaves the count");
+}
+
+/**
+ * Test: Full Robot Stops The Intake
+ * 
+ * Given: Capacity 3
+ * When: Four balls are grabbed
+ * Then: Count stops at 3, isFull(), and IntakeController stops intaking
+ */
+void testBall_FullStopsIntake() {
+    BallDetector detector(3);
+    uint32_t now = 1000;
+    for (int ball = 0; ball < 4; ball++) {
+        now = feedRunning(detector, BallDetector::INTAKE, now, 30, 100, 0.5, 15.0);
+    }
+    feedRunning(detector, BallDetector::INTAKE, now, 20);
+    
+    TestRunner::assertEquals(4, detector.getDetectionCount(BallDetector::INTAKE), "Ball - Four grabs detected");
+    TestRunner::assertEquals(3, detector.getCount(), "Ball - Count capped at capacity");
+    TestRunner::assertTrue(detector.isFull(), "Ball - Robot is full");
+    TestRunner::assertEquals(IntakeController::STOP,
+                             IntakeController::limitToCapacity(IntakeController::FORWARD, detector.isFull()),
+                             "Ball - Full robot stops the intake");
+}
+
+/**
+ * Test: Any Tick Period
+ * 
+ * Given: The intake running, one 80 ms grab signature
+ * When: update() is called every 2, 10 or 20 ms, or at random periods from 2 to 20 ms
+ *       (the driver loop wakes on input changes)
+ * Then: The grab is counted once at every period, and steady running never counts
+ */
+void testBall_AnyTickPeriod() {
+    const uint32_t PERIODS[][2] = {{2, 2}, {10, 10}, {20, 20}, {2, 20}};
+    for (int p = 0; p < 4; p++) {
+        for (uint32_t seed = 1; seed <= 20; seed++) {
+            BallDetector detector;
+            int grabs = feedTimed(detector, 1000, 1500, PERIODS[p][0], PERIODS[p][1], 700, 80.0, seed);
+            BallDetector idle;
+            int phantoms = feedTimed(idle, 1000, 1500, PERIODS[p][0], PERIODS[p][1], -1, 0.0, seed);
+            if (grabs != 1 || phantoms != 0) {
+                std::cout << "  Tick " << PERIODS[p][0] << "-" << PERIODS[p][1] << " ms, seed " << seed
+                          << ": " << grabs << " grabs, " << phantoms << " phantoms" << std::endl;
+                TestRunner::assertTrue(false, "Ball Ticks - One grab at every tick period");
+                return;
+            }
+        }
+    }
+    TestRunner::assertTrue(true, "Ball Ticks - One grab at every tick period");
+}
+
+/**
+ * Test: Speed Changes Are Not Balls
+ * 
+ * Given: R1 held with the matched intake
+ * When: The robot brakes (intake command 100% to 15%, 190 to 28 rpm), at 10 and 20 ms ticks
+ * Then: No phantom ball; a grab after a small command change (within POWER_CHANGE) still counts
+ */
+void testBall_SpeedChangeIgnored() {
+    for (uint32_t tickMs = 10; tickMs <= 20; tickMs += 10) {
+        BallDetector braking;
+        TestRunner::assertEquals(0, feedSpeedChange(braking, tickMs, 100, 15, 600, -1),
+                                 "Ball Speed Change - Braking is not a ball");
+        BallDetector wiggle;
+        TestRunner::assertEquals(1, feedSpeedChange(wiggle, tickMs, 100, 100 - BallDetector::POWER_CHANGE, 600, 1000),
+                                 "Ball Speed Change - Grab after a small change counted");
+    }
+}
+
+/**
+ * Test: Grabs While The Command Changes
+ * 
+ * Given: The matched intake following the drive as it slows down (90% to 30% over 600 ms)
+ *        or speeds up, and BallPursuit's step from APPROACH to COLLECT (51% to 38%);
+ *        at 10 and 20 ms ticks
+ * When: A ball is grabbed halfway through the ramp, or 100 ms after the step
+ * Then: Each grab counted once; the speed changes alone count nothing
+ */
+void testBall_GrabWhileCommandChanges() {
+    for (uint32_t tickMs = 10; tickMs <= 20; tickMs += 10) {
+        BallDetector slowing;
+        TestRunner::assertEquals(0, feedSpeedChange(slowing, tickMs, 90, 30, 600, -1, 600),
+                                 "Ball Command Change - Ramp down is not a ball");
+        BallDetector speeding;
+        TestRunner::assertEquals(0, feedSpeedChange(speeding, tickMs, 30, 90, 600, -1, 600),
+                                 "Ball Command Change - Ramp up is not a ball");
+        BallDetector slowingGrab;
+        TestRunner::assertEquals(1, feedSpeedChange(slowingGrab, tickMs, 90, 30, 600, 900, 600),
+                                 "Ball Command Change - Grab during the ramp down counted");
+        BallDetector speedingGrab;
+        TestRunner::assertEquals(1, feedSpeedChange(speedingGrab, tickMs, 30, 90, 600, 900, 600),
+                                 "Ball Command Change - Grab during the ramp up counted");
+        BallDetector stepped;
+        TestRunner::assertEquals(0, feedSpeedChange(stepped, tickMs, 51, 38, 600, -1),
+                                 "Ball Command Change - Step is not a ball");
+        BallDetector steppedGrab;
+        TestRunner::assertEquals(1, feedSpeedChange(steppedGrab, tickMs, 51, 38, 600, 700),
+                                 "Ball Command Change - Grab 100 ms after the step counted");
+    }
+}
+
+/**
+ * Test: Accuracy Against Labeled Logs
+ * 
+ * Given: 2 min labeled logs for the intake (grabs) and the ramp (hand-offs), with
+ *        start-ups, reversals, battery sag, drive jolts and noise
+ * When: The detector runs over each log
+ * Then: At least 90% of balls found, at least 90% of detections are real balls
+ */
+void testBall_LabeledLogAccuracy() {
+    makeLog(IntakeLog, 12345, 0.35, 0.3, 0.7, 8.0, 25.0);
+    makeLog(RampLog, 54321, 0.25, 0.2, 0.5, 5.0, 18.0);
+    Accuracy intake = scoreLog(IntakeLog, BallDetector::INTAKE);
+    Accuracy ramp = scoreLog(RampLog, BallDetector::RAMP);
+    
+    std::cout << "  [Logs] intake: " << IntakeLog.labelCount << " balls, found " << intake.truePositives
+              << ", missed " << intake.missed << ", false " << intake.falsePositives
+              << " (recall " << intake.recall() << ", precision " << intake.precision() << ")" << std::endl;
+    std::cout << "  [Logs] ramp: " << RampLog.labelCount << " balls, found " << ramp.truePositives
+              << ", missed " << ramp.missed << ", false " << ramp.falsePositives
+              << " (recall " << ramp.recall() << ", precision " << ramp.precision() << ")" << std::endl;
+    
+    TestRunner::assertTrue(IntakeLog.labelCount > 50 && RampLog.labelCount > 50, "Ball Logs - Enough labeled balls");
+    TestRunner::assertTrue(intake.recall() >= 0.9, "Ball Logs - Intake recall at least 90%");
+    TestRunner::assertTrue(intake.precision() >= 0.9, "Ball Logs - Intake precision at least 90%");
+    TestRunner::assertTrue(ramp.recall() >= 0.9, "Ball Logs - Ramp recall at least 90%");
+    TestRunner::assertTrue(ramp.precision() >= 0.9, "Ball Logs - Ramp precision at least 90%");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running BallDetector Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testBall_SteadyRunning();
+    testBall_GrabCounted();
+    testBall_SpinUpIgnored();
+    testBall_MinimumGap();
+    testBall_SpitOut();
+    testBall_RampHandOffAndScore();
+    testBall_FullStopsIntake();
+    testBall_AnyTickPeriod();
+    testBall_SpeedChangeIgnored();
+    testBall_GrabWhileCommandChanges();
+    testBall_LabeledLogAccuracy();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,633 @@
+/*
+ * test_ballpursuit.cpp
+ * 
+ * Unit tests for BallPursuit class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our BallPursuit class to test it
+#include "../src/controllers/BallPursuit.h"
+#include "../src/controllers/BallDetector.h"
+
+const int BALL = 1;       // Our color signature
+const int OPPONENT = 2;   // The other alliance's balls
+
+// ============================================
+// HOST FIELD MODEL AND SIMULATED VISION FEED
+// ============================================
+// Robot pose and balls on the field (mm, heading in degrees clockwise from +y like
+// the gyro). The camera sits at the front of the robot looking slightly down, so a
+// ball closer than ~430 mm drops out of the bottom of the image. Each frame has
+// pixel noise, random dropouts and the occasional noise blob, like the real sensor.
+
+const uint32_t FRAME_MS = 20;                // Vision sensor at 50 Hz
+const double MAX_WHEEL_SPEED_MM_S = 1200.0;  // At 100% power
+const double TRACK_WIDTH_MM = 300.0;
+const double CAMERA_AHEAD_MM = 150.0;        // Camera in front of the robot center
+const double CAMERA_HEIGHT_MM = 250.0;
+const double PI = 3.14159265358979;
+
+struct SimRandom {
+    uint32_t state;
+    
+    double uniform(double low, double high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * ((state >> 8) / 16777216.0);
+    }
+};
+
+struct SimBall {
+    double x;
+    double y;
+    int signature;
+    bool onField;
+};
+
+struct SimField {
+    SimBall balls[8];
+    int ballCount;
+    double robotX;
+    double robotY;
+    double headingDeg;
+    SimRandom random;
+    
+    /**
+     * Ball position in the camera's frame
+     */
+    void toCamera(const SimBall& ball, double& forward, double& right) const {
+        double heading = headingDeg * PI / 180.0;
+        double dx = ball.x - robotX;
+        double dy = ball.y - robotY;
+        forward = dx * std::sin(heading) + dy * std::cos(heading) - CAMERA_AHEAD_MM;
+        right = dx * std::cos(heading) - dy * std::sin(heading);
+    }
+    
+    /**
+     * One vision frame
+     * 
+     * @return Number of detections written
+     */
+    int snapshot(VisionTracker::Detection* out) {
+        double focalPx = (VisionTracker::IMAGE_WIDTH / 2.0) / std::tan(VisionTracker::FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+        int count = 0;
+        for (int i = 0; i < ballCount && count < VisionTracker::MAX_DETECTIONS; i++) {
+            double forward;
+            double right;
+            toCamera(balls[i], forward, right);
+            if (!balls[i].onField || forward < 50.0 || random.uniform(0.0, 1.0) < 0.1) {
+                continue;  // Behind the camera, or dropped this frame
+            }
+            double centerX = VisionTracker::IMAGE_WIDTH / 2.0 + focalPx * right / forward + random.uniform(-2.0, 2.0);
+            double centerY = VisionTracker::IMAGE_HEIGHT / 2.0 +
+                             focalPx * (CAMERA_HEIGHT_MM - VisionTracker::BALL_DIAMETER_MM / 2.0) / forward;
+            double width = focalPx * VisionTracker::BALL_DIAMETER_MM / std::sqrt(forward * forward + right * right);
+            if (centerX < 0.0 || centerX > VisionTracker::IMAGE_WIDTH || centerY > VisionTracker::IMAGE_HEIGHT) {
+                continue;  // Out of the picture
+            }
+            VisionTracker::Detection detection = {(int)centerX, (int)centerY, (int)(width + random.uniform(-1.0, 1.0)),
+                                                  (int)(width + random.uniform(-1.0, 1.0)), balls[i].signature};
+            out[count++] = detection;
+        }
+        if (count < VisionTracker::MAX_DETECTIONS && random.uniform(0.0, 1.0) < 0.05) {
+            VisionTracker::Detection noise = {(int)random.uniform(0, 316), (int)random.uniform(0, 212), 4, 3, BALL};
+            out[count++] = noise;
+        }
+        return count;
+    }
+    
+    /**
+     * Move the robot one frame; the intake picks up a ball in front of it
+     * 
+     * @return true if a ball was picked up
+     */
+    bool step(int leftPower, int rightPower, IntakeController::MotorState intake) {
+        double dt = FRAME_MS / 1000.0;
+        double left = leftPower / 100.0 * MAX_WHEEL_SPEED_MM_S;
+        double right = rightPower / 100.0 * MAX_WHEEL_SPEED_MM_S;
+        double speed = (left + right) / 2.0;
+        headingDeg += (left - right) / TRACK_WIDTH_MM * dt * 180.0 / PI;
+        robotX += speed * std::sin(headingDeg * PI / 180.0) * dt;
+        robotY += speed * std::cos(headingDeg * PI / 180.0) * dt;
+        
+        bool grabbed = false;
+        for (int i = 0; i < ballCount; i++) {
+            double forward;
+            double side;
+            toCamera(balls[i], forward, side);
+            forward += CAMERA_AHEAD_MM;  // From the robot center
+            if (balls[i].onField && intake == IntakeController::FORWARD &&
+                forward > 120.0 && forward < 260.0 && std::fabs(side) < 110.0) {
+                balls[i].onField = false;
+                grabbed = grabbed || balls[i].signature == BALL;
+            }
+        }
+        return grabbed;
+    }
+};
+
+/**
+ * Run a pickup on the field model
+ * 
+ * @return Time taken (ms), or -1 if it failed
+ */
+double runPickup(SimField& field, uint32_t timeoutMs) {
+    VisionTracker tracker(BALL);
+    BallPursuit pursuit;
+    VisionTracker::Detection frame[VisionTracker::MAX_DETECTIONS];
+    uint32_t now = 1000;
+    pursuit.start(now, timeoutMs);
+    bool grabbed = false;
+    
+    while (true) {
+        tracker.update(frame, field.snapshot(frame));
+        int left;
+        int right;
+        IntakeController::MotorState intake;
+        BallPursuit::Status status = pursuit.update(tracker, grabbed, now, left, right, intake);
+        if (status == BallPursuit::DONE) {
+            return now - 1000.0;
+        }
+        if (status == BallPursuit::FAILED) {
+            return -1.0;
+        }
+        grabbed = field.step(left, right, intake);
+        now += FRAME_MS;
+    }
+}
+
+/**
+ * Run a pickup that ends the way pickUpBall() does: on a BallDetector hit from the intake
+ * motor, not on the field model's grab. The intake runs ground-speed matched to the drive's
+ * measured speed (which lags the power), its velocity loop follows the command, and a ball
+ * going through bumps its current and dips its speed. One detector update per frame.
+ * 
+ * @param phantom Output: true if it finished with the ball still on the field
+ * @return Time taken (ms), or -1 if it failed
+ */
+double runPickupOnDetector(SimField& field, uint32_t timeoutMs, bool& phantom) {
+    const double INTAKE_RPM = 200.0;     // At 100%
+    const double MAX_SURFACE_SPEED = IntakeController::surfaceSpeed(INTAKE_RPM, 2.5, 3.0);
+    const double INTAKE_TAU_MS = 50.0;   // Velocity loop
+    const double DRIVE_TAU_MS = 100.0;   // Measured drive speed behind the power
+    const double BALL_MS = 80.0;         // Signature length
+    VisionTracker tracker(BALL);
+    BallPursuit pursuit;
+    BallDetector detector;
+    VisionTracker::Detection frame[VisionTracker::MAX_DETECTIONS];
+    uint32_t now = 1000;
+    pursuit.start(now, timeoutMs);
+    double driveSpeed = 0.0;
+    double rpm = 0.0;
+    double ballAtMs = -1.0;
+    bool detected = false;
+    phantom = false;
+    
+    while (true) {
+        tracker.update(frame, field.snapshot(frame));
+        int left;
+        int right;
+        IntakeController::MotorState intake;
+        BallPursuit::Status status = pursuit.update(tracker, detected, now, left, right, intake);
+        if (status == BallPursuit::DONE) {
+            phantom = ballAtMs < 0.0;
+            return now - 1000.0;
+        }
+        if (status == BallPursuit::FAILED) {
+            return -1.0;
+        }
+        
+        double forward = (left + right) / 200.0 * MAX_WHEEL_SPEED_MM_S;
+        driveSpeed += (forward - driveSpeed) * FRAME_MS / DRIVE_TAU_MS;
+        int power = IntakeController::calculateGroundMatchedPower(intake, driveSpeed / 25.4, MAX_SURFACE_SPEED);
+        if (field.step(left, right, intake)) {
+            ballAtMs = now;
+        }
+        
+        double target = INTAKE_RPM * power / 100.0;
+        rpm += (target - rpm) * FRAME_MS / INTAKE_TAU_MS;
+        double shape = 0.0;
+        if (ballAtMs >= 0.0 && now - ballAtMs < BALL_MS) {
+            shape = std::sin(PI * (now - ballAtMs) / BALL_MS);
+        }
+        double amps = 0.2 + 0.15 * std::fabs(rpm) / INTAKE_RPM + 0.008 * std::fabs(target - rpm) + 0.5 * shape;
+        detected = detector.update(BallDetector::INTAKE, amps, rpm - 15.0 * shape, power, now);
+        now += FRAME_MS;
+    }
+}
+
+/**
+ * Field with the robot at the origin facing +y
+ */
+SimField makeField(uint32_t seed) {
+    SimField field;
+    field.ballCount = 0;
+    field.robotX = 0.0;
+    field.robotY = 0.0;
+    field.headingDeg = 0.0;
+    field.random.state = seed;
+    return field;
+}
+
+void addBall(SimField& field, double x, double y, int signature = BALL) {
+    SimBall ball = {x, y, signature, true};
+    field.balls[field.ballCount++] = ball;
+}
+
+/**
+ * Tracker with one confirmed ball at a bearing and distance
+ */
+void trackBall(VisionTracker& tracker, double bearingDeg, double distanceMm) {
+    double focalPx = (VisionTracker::IMAGE_WIDTH / 2.0) / std::tan(VisionTracker::FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+    int centerX = (int)(VisionTracker::IMAGE_WIDTH / 2.0 + focalPx * std::tan(bearingDeg * PI / 180.0));
+    int width = (int)(focalPx * VisionTracker::BALL_DIAMETER_MM / distanceMm + 0.5);
+    VisionTracker::Detection frame[1] = {{centerX, 150, width, width, BALL}};
+    tracker.update(frame, 1);
+    tracker.update(frame, 1);
+}
+
+// ============================================
+// TEST CASES FOR BALL PURSUIT
+// ============================================
+
+/**
+ * Test: Idle Until Started
+ * 
+ * Given: A new pursuit
+ * When: update() is called
+ * Then: IDLE, no drive, no intake
+ */
+void testPursuit_IdleUntilStarted() {
+    BallPursuit pursuit;
+    VisionTracker tracker(BALL);
+    int left = 99;
+    int right = 99;
+    IntakeController::MotorState intake = IntakeController::FORWARD;
+    
+    TestRunner::assertEquals(BallPursuit::IDLE, pursuit.update(tracker, false, 1000, left, right, intake), "Pursuit - Idle");
+    TestRunner::assertEquals(0, left, "Pursuit - Idle left 0");
+    TestRunner::assertEquals(0, right, "Pursuit - Idle right 0");
+    TestRunner::assertEquals(IntakeController::STOP, intake, "Pursuit - Idle intake stopped");
+}
+
+/**
+ * Test: Search Turns In Place
+ * 
+ * Given: Started, no ball in view
+ * When: update()
+ * Then: SEARCHING, turning clockwise in place, intake running
+ */
+void testPursuit_Search() {
+    BallPursuit pursuit;
+    VisionTracker tracker(BALL);
+    int left;
+    int right;
+    IntakeController::MotorState intake;
+    pursuit.start(1000, 5000);
+    
+    TestRunner::assertEquals(BallPursuit::SEARCHING, pursuit.update(tracker, false, 1000, left, right, intake), "Pursuit - Searching");
+    TestRunner::assertEquals(BallPursuit::SEARCH_TURN_POWER, left, "Pursuit - Search left forward");
+    TestRunner::assertEquals(-BallPursuit::SEARCH_TURN_POWER, right, "Pursuit - Search right reverse");
+    TestRunner::assertEquals(IntakeController::FORWARD, intake, "Pursuit - Intake on while searching");
+}
+
+/**
+ * Test: Steers Toward The Ball
+ * 
+ * Given: A ball 1500 mm away, 10 degrees right
+ * When: update()
+ * Then: APPROACH, turning right while driving forward at reduced power
+ */
+void testPursuit_SteersTowardBall() {
+    BallPursuit pursuit;
+    VisionTracker tracker(BALL);
+    trackBall(tracker, 10.0, 1500.0);
+    int left;
+    int right;
+    IntakeController::MotorState intake;
+    pursuit.start(1000, 5000);
+    
+    TestRunner::assertEquals(BallPursuit::APPROACH, pursuit.update(tracker, false, 1000, left, right, intake), "Pursuit - Approaching");
+    TestRunner::assertTrue(left > right, "Pursuit - Turns right toward the ball");
+    TestRunner::assertTrue(left + right > 0 && (left + right) / 2 < BallPursuit::APPROACH_POWER, "Pursuit - Slower while off-center");
+}
+
+/**
+ * Test: Turn First When Far Off-Center
+ * 
+ * Given: A ball 30 degrees left, and (in another pursuit) one straight ahead
+ * When: update()
+ * Then: Almost no forward power off-center; full approach power straight ahead
+ */
+void testPursuit_TurnFirst() {
+    int left;
+    int right;
+    IntakeController::MotorState intake;
+    
+    BallPursuit offCenter;
+    VisionTracker leftTracker(BALL);
+    trackBall(leftTracker, -30.0, 1500.0);
+    offCenter.start(1000, 5000);
+    offCenter.update(leftTracker, false, 1000, left, right, intake);
+    TestRunner::assertTrue(right > left, "Pursuit - Turns left");
+    TestRunner::assertTrue(std::abs(left + right) / 2 <= 15, "Pursuit - Little forward power 30 degrees off");
+    
+    BallPursuit ahead;
+    VisionTracker aheadTracker(BALL);
+    trackBall(aheadTracker, 0.0, 1500.0);
+    ahead.start(1000, 5000);
+    ahead.update(aheadTracker, false, 1000, left, right, intake);
+    TestRunner::assertEquals(BallPursuit::APPROACH_POWER, left, "Pursuit - Full approach power straight ahead");
+}
+
+/**
+ * Test: Collect Over A Close Ball
+ * 
+ * Given: A ball 400 mm ahead
+ * When: It disappears under the camera
+ * Then: Keeps driving at collect power for COLLECT_TIME_MS, then searches again
+ */
+void testPursuit_CollectBlind() {
+    BallPursuit pursuit;
+    VisionTracker tracker(BALL);
+    trackBall(tracker, 0.0, 400.0);
+    int left;
+    int right;
+    IntakeController::MotorState intake;
+    pursuit.start(1000, 5000);
+    TestRunner::assertEquals(BallPursuit::COLLECT, pursuit.update(tracker, false, 1000, left, right, intake), "Pursuit - Collecting close ball");
+    
+    VisionTracker empty(BALL);
+    TestRunner::assertEquals(BallPursuit::COLLECT, pursuit.update(empty, false, 1000 + BallPursuit::COLLECT_TIME_MS - 1, left, right, intake),
+                             "Pursuit - Still collecting blind");
+    TestRunner::assertEquals(BallPursuit::COLLECT_POWER, left, "Pursuit - Driving over the ball");
+    TestRunner::assertEquals(BallPursuit::SEARCHING, pursuit.update(empty, false, 1000 + BallPursuit::COLLECT_TIME_MS, left, right, intake),
+                             "Pursuit - Searches again after a miss");
+}
+
+/**
+ * Test: Done And Failed
+ * 
+ * Given: A running pursuit
+ * When: A ball is grabbed / the time limit passes
+ * Then: DONE / FAILED, with everything stopped
+ */
+void testPursuit_DoneAndFailed() {
+    VisionTracker tracker(BALL);
+    int left;
+    int right;
+    IntakeController::MotorState intake;
+    
+    BallPursuit done;
+    done.start(1000, 5000);
+    TestRunner::assertEquals(BallPursuit::DONE, done.update(tracker, true, 1100, left, right, intake), "Pursuit - Grab finishes");
+    TestRunner::assertEquals(IntakeController::STOP, intake, "Pursuit - Intake stops when done");
+    
+    BallPursuit failed;
+    failed.start(1000, 5000);
+    TestRunner::assertEquals(BallPursuit::FAILED, failed.update(tracker, false, 6000, left, right, intake), "Pursuit - Time limit");
+    TestRunner::assertEquals(0, left + right, "Pursuit - Drive stops when failed");
+}
+
+/**
+ * Test: Simulated Displaced Ball
+ * 
+ * Given: The field model with one ball 1.6 m away, 20 degrees right
+ * When: A pickup runs on the simulated vision feed
+ * Then: The ball is picked up within 4 s
+ */
+void testPursuit_SimDisplacedBall() {
+    SimField field = makeField(1);
+    addBall(field, 550.0, 1500.0);
+    double ms = runPickup(field, 4000);
+    
+    std::cout << "  [Sim] displaced ball picked up in " << ms << " ms" << std::endl;
+    TestRunner::assertTrue(ms > 0.0, "Pursuit Sim - Displaced ball picked up");
+    TestRunner::assertTrue(!field.balls[0].onField, "Pursuit Sim - Ball left the field");
+}
+
+/**
+ * Test: Simulated Nearest Valid Ball
+ * 
+ * Given: An opponent ball straight ahead (nearest), our balls at 1.3 m and 1.9 m
+ * When: A pickup runs
+ * Then: The 1.3 m ball of our color is picked up; the others stay put
+ */
+void testPursuit_SimNearestValid() {
+    SimField field = makeField(2);
+    addBall(field, 0.0, 800.0, OPPONENT);
+    addBall(field, -500.0, 1200.0);
+    addBall(field, 900.0, 1700.0);
+    double ms = runPickup(field, 5000);
+    
+    TestRunner::assertTrue(ms > 0.0, "Pursuit Sim - Picked up a ball");
+    TestRunner::assertTrue(!field.balls[1].onField, "Pursuit Sim - Nearest of our balls picked up");
+    TestRunner::assertTrue(field.balls[0].onField && field.balls[2].onField, "Pursuit Sim - Others left alone");
+}
+
+/**
+ * Test: Simulated Search
+ * 
+ * Given: The only ball is behind the robot
+ * When: A pickup runs
+ * Then: The robot turns until it sees the ball, then picks it up
+ */
+void testPursuit_SimSearch() {
+    SimField field = makeField(3);
+    addBall(field, 300.0, -1200.0);
+    double ms = runPickup(field, 8000);
+    
+    std::cout << "  [Sim] ball behind the robot picked up in " << ms << " ms" << std::endl;
+    TestRunner::assertTrue(ms > 0.0, "Pursuit Sim - Ball behind found and picked up");
+}
+
+/**
+ * Test: Simulated Random Placements
+ * 
+ * Given: 100 fields with one ball 0.6-2 m away in any direction
+ * When: A pickup runs on each (6 s limit)
+ * Then: At least 95% picked up
+ */
+void testPursuit_SimRandomPlacements() {
+    SimRandom placement = {777};
+    int pickedUp = 0;
+    double totalMs = 0.0;
+    const int FIELDS = 100;
+    for (int n = 0; n < FIELDS; n++) {
+        SimField field = makeField(1000 + n);
+        double angle = placement.uniform(-PI, PI);
+        double distance = placement.uniform(600.0, 2000.0);
+        addBall(field, distance * std::sin(angle), distance * std::cos(angle));
+        double ms = runPickup(field, 6000);
+        if (ms > 0.0) {
+            pickedUp++;
+            totalMs += ms;
+        }
+    }
+    
+    std::cout << "  [Sim] random placements: " << pickedUp << "/" << FIELDS << " picked up, mean "
+              << (pickedUp > 0 ? totalMs / pickedUp : 0.0) << " ms" << std::endl;
+    TestRunner::assertTrue(pickedUp >= 95, "Pursuit Sim - At least 95% of random placements picked up");
+}
+
+/**
+ * Test: Simulated Pickups Ending On The Ball Detector
+ * 
+ * Given: 50 fields with one ball 0.6-2 m away in any direction, the intake ground-speed
+ *        matched (its command drops when APPROACH slows to COLLECT near the ball)
+ * When: A pickup runs on each, finishing only when BallDetector sees the grab (6 s limit)
+ * Then: At least 95% picked up, and none finished before the ball was in
+ */
+void testPursuit_SimEndsOnDetector() {
+    SimRandom placement = {4242};
+    int pickedUp = 0;
+    int phantoms = 0;
+    double totalMs = 0.0;
+    const int FIELDS = 50;
+    for (int n = 0; n < FIELDS; n++) {
+        SimField field = makeField(2000 + n);
+        double angle = placement.uniform(-PI, PI);
+        double distance = placement.uniform(600.0, 2000.0);
+        addBall(field, distance * std::sin(angle), distance * std::cos(angle));
+        bool phantom;
+        double ms = runPickupOnDetector(field, 6000, phantom);
+        if (phantom) {
+            phantoms++;
+        } else if (ms > 0.0) {
+            pickedUp++;
+            totalMs += ms;
+        }
+    }
+    
+    std::cout << "  [Sim] ending on the detector: " << pickedUp << "/" << FIELDS << " picked up, mean "
+              << (pickedUp > 0 ? totalMs / pickedUp : 0.0) << " ms, " << phantoms << " phantom" << std::endl;
+    TestRunner::assertTrue(pickedUp >= 48, "Pursuit Sim - At least 95% picked up by the detector");
+    TestRunner::assertEquals(0, phantoms, "Pursuit Sim - Never done before the ball is in");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running BallPursuit Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testPursuit_IdleUntilStarted();
+    testPursuit_Search();
+    testPursuit_SteersTowardBall();
+    testPursuit_TurnFirst();
+    testPursuit_CollectBlind();
+    testPursuit_DoneAndFailed();
+    testPursuit_SimDisplacedBall();
+    testPursuit_SimNearestValid();
+    testPursuit_SimSearch();
+    testPursuit_SimRandomPlacements();
+    testPursuit_SimEndsOnDetector();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * test_batterymodel.cpp
+ * 
+ * Unit tests for BatteryModel class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our BatteryModel class to test it
+#include "../src/controllers/BatteryModel.h"
+
+// ============================================
+// TEST CASES FOR BATTERY MODEL
+// ============================================
+
+/**
+ * Test: Coulomb Counting
+ * 
+ * Given: Full battery (1.1 Ah)
+ * When: Draw 11 A for 36 seconds (0.11 Ah)
+ * Then: State of charge drops 10%
+ */
+void testBattery_CoulombCounting() {
+    BatteryModel battery(100.0);
+    for (int tick = 0; tick < 1800; tick++) {
+        battery.update(12.5, 11.0, 0.020);
+    }
+    TestRunner::assertNear(90.0, battery.getStateOfCharge(), 1e-6, "Battery - 0.11 Ah uses 10%");
+}
+
+/**
+ * Test: State of Charge Never Below Zero
+ */
+void testBattery_ClampedAtZero() {
+    BatteryModel battery(1.0);
+    battery.update(11.0, 20.0, 60.0);
+    TestRunner::assertNear(0.0, battery.getStateOfCharge(), 1e-9, "Battery - Never below 0%");
+}
+
+/**
+ * Test: Internal Resistance From Load Steps
+ * 
+ * Given: A battery with 13.0 V open circuit and 0.12 ohm resistance
+ * When: Current steps between 1 A and 15 A many times
+ * Then: The estimate converges to 0.12 ohm and the open-circuit voltage to 13.0 V
+ */
+void testBattery_ResistanceFromLoadSteps() {
+    BatteryModel battery;
+    const double TRUE_RESISTANCE = 0.12;
+    for (int step = 0; step < 60; step++) {
+        double amps = (step % 2 == 0) ? 1.0 : 15.0;
+        battery.update(13.0 - amps * TRUE_RESISTANCE, amps, 0.020);
+    }
+    TestRunner::assertNear(TRUE_RESISTANCE, battery.getInternalResistance(), 0.001, "Battery - Resistance converges");
+    TestRunner::assertNear(13.0, battery.getOpenCircuitVoltage(), 0.02, "Battery - Open circuit voltage estimated");
+}
+
+/**
+ * Test: Small Current Changes Don't Move Resistance
+ * 
+ * Given: Noisy voltage with only small current changes
+ * When: Update
+ * Then: Resistance stays at the default (noise isn't mistaken for sag)
+ */
+void testBattery_SmallStepsIgnored() {
+    BatteryModel battery;
+    battery.update(12.8, 3.0, 0.020);
+    battery.update(12.5, 3.5, 0.020);
+    TestRunner::assertNear(BatteryModel::DEFAULT_RESISTANCE, battery.getInternalResistance(), 1e-9,
+                           "Battery - Small current step ignored");
+}
+
+/**
+ * Test: Restore Same Battery
+ * 
+ * Given: Saved state 70%, 0.1 ohm, 2 matches; Brain reports 68%
+ * When: Restore
+ * Then: Saved state is kept (same battery)
+ */
+void testBattery_RestoreSameBattery() {
+    BatteryModel battery;
+    BatteryModel::State saved = {70.0, 0.1, 2};
+    bool used = battery.restore(saved, 68.0);
+    
+    TestRunner::assertEqualsBool(true, used, "Battery - Same battery restored");
+    TestRunner::assertNear(70.0, battery.getStateOfCharge(), 1e-9, "Battery - Saved state of charge kept");
+    TestRunner::assertEquals(2, battery.getState().matchCount, "Battery - Match count kept");
+}
+
+/**
+ * Test: Restore Detects Fresh Battery
+ * 
+ * Given: Saved state 40%; Brain reports 100%
+ * When: Restore
+ * Then: Start over from the Brain estimate with default resistance and 0 matches
+ */
+void testBattery_RestoreFreshBattery() {
+    BatteryModel battery;
+    BatteryModel::State saved = {40.0, 0.2, 5};
+    bool used = battery.restore(saved, 100.0);
+    
+    TestRunner::assertEqualsBool(false, used, "Battery - Fresh battery detected");
+    TestRunner::assertNear(100.0, battery.getStateOfCharge(), 1e-9, "Battery - State of charge from Brain");
+    TestRunner::assertNear(BatteryModel::DEFAULT_RESISTANCE, battery.getInternalResistance(), 1e-9,
+                           "Battery - Resistance reset for new battery");
+    TestRunner::assertEquals(0, battery.getState().matchCount, "Battery - Match count reset");
+}
+
+/**
+ * Test: Restore Rejects Corrupt Data
+ */
+void testBattery_RestoreCorrupt() {
+    BatteryModel battery;
+    BatteryModel::State saved = {80.0, -1.0, 3};
+    TestRunner::assertEqualsBool(false, battery.restore(saved, 80.0), "Battery - Negative resistance rejected");
+}
+
+/**
+ * Test: Match Counting
+ */
+void testBattery_StartMatch() {
+    BatteryModel battery;
+    battery.startMatch();
+    battery.startMatch();
+    TestRunner::assertEquals(2, battery.getState().matchCount, "Battery - Matches counted");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running BatteryModel Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testBattery_CoulombCounting();
+    testBattery_ClampedAtZero();
+    testBattery_ResistanceFromLoadSteps();
+    testBattery_SmallStepsIgnored();
+    testBattery_RestoreSameBattery();
+    testBattery_RestoreFreshBattery();
+    testBattery_RestoreCorrupt();
+    testBattery_StartMatch();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,474 @@
+/*
+ * test_commandscheduler.cpp
+ * 
+ * Unit tests for CommandScheduler class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our CommandScheduler class to test it
+#include "../src/controllers/CommandScheduler.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+// ============================================
+// ALLOCATION COUNTER
+// ============================================
+// Counts every heap allocation, so the tests can check that ticks allocate nothing
+
+long heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    heapAllocations++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+// ============================================
+// TEST COMMAND
+// ============================================
+// Records what the scheduler did to it and stages one power on its subsystems
+
+class TestCommand : public Command {
+public:
+    TestCommand(uint8_t requirements, int power, int runTicks = -1, bool interruptible = true)
+        : requirements(requirements), power(power), runTicks(runTicks), interruptible(interruptible),
+          initializeCount(0), executeCount(0), endCount(0), lastInterrupted(false) {}
+    
+    uint8_t getRequirements() const override { return requirements; }
+    bool isInterruptible() const override { return interruptible; }
+    
+    void initialize() override {
+        initializeCount++;
+        executeCount = 0;
+    }
+    
+    void execute(ActuationFrame& frame) override {
+        executeCount++;
+        if (requirements & DRIVE) frame.setDrive(power, power);
+        if (requirements & INTAKE) frame.setMotor(ActuationFrame::INTAKE, power);
+        if (requirements & RAMP) frame.setMotor(ActuationFrame::RAMP, power);
+        if (requirements & TOP_WHEEL) frame.setMotor(ActuationFrame::FULL_POWER_RAMP, power);
+        if (requirements & HEIGHT) frame.setPistons(power > 0);
+    }
+    
+    bool isFinished() override {
+        return runTicks >= 0 && executeCount >= runTicks;
+    }
+    
+    void end(bool interrupted) override {
+        endCount++;
+        lastInterrupted = interrupted;
+    }
+    
+    uint8_t requirements;
+    int power;
+    int runTicks;       // -1 = runs until interrupted
+    bool interruptible;
+    int initializeCount;
+    int executeCount;
+    int endCount;
+    bool lastInterrupted;
+};
+
+// ============================================
+// TEST CASES FOR COMMAND SCHEDULER
+// ============================================
+
+/**
+ * Test: Default Commands Fill Free Subsystems
+ * 
+ * Given: Default commands for drive and intake
+ * When: Run one tick with nothing scheduled
+ * Then: Both defaults run and own their subsystems
+ */
+void testScheduler_DefaultsRun() {
+    CommandScheduler scheduler;
+    TestCommand driveSticks(Command::DRIVE, 30);
+    TestCommand intakeButtons(Command::INTAKE, 100);
+    scheduler.setDefaultCommand(Command::DRIVE, &driveSticks);
+    scheduler.setDefaultCommand(Command::INTAKE, &intakeButtons);
+    
+    ActuationFrame frame;
+    scheduler.run(frame);
+    
+    TestRunner::assertEquals(1, driveSticks.executeCount, "Scheduler - Drive default executed");
+    TestRunner::assertEquals(30, frame.getMotor(ActuationFrame::LEFT_FRONT), "Scheduler - Drive default output staged");
+    TestRunner::assertEquals(100, frame.getMotor(ActuationFrame::INTAKE), "Scheduler - Intake default output staged");
+    TestRunner::assertTrue(scheduler.getOwner(Command::DRIVE) == &driveSticks, "Scheduler - Default owns drive");
+    TestRunner::assertTrue(scheduler.getOwner(Command::RAMP) == nullptr, "Scheduler - No default, no owner");
+}
+
+/**
+ * Test: Default Must Require Its Subsystem
+ */
+void testScheduler_DefaultRequirementChecked() {
+    CommandScheduler scheduler;
+    TestCommand intakeOnly(Command::INTAKE, 100);
+    TestRunner::assertTrue(!scheduler.setDefaultCommand(Command::DRIVE, &intakeOnly), "Scheduler - Wrong default refused");
+}
+
+/**
+ * Test: Command Interrupts Default, Default Resumes
+ * 
+ * Given: Driver sticks as the drive default
+ * When: A 3-tick macro that needs the drive is scheduled
+ * Then: The default is interrupted, the macro's output wins, and the default
+ *       comes back the tick after the macro finishes
+ */
+void testScheduler_InterruptAndResume() {
+    CommandScheduler scheduler;
+    TestCommand driveSticks(Command::DRIVE, 30);
+    TestCommand quickTurn(Command::DRIVE, 80, 3);
+    scheduler.setDefaultCommand(Command::DRIVE, &driveSticks);
+    
+    ActuationFrame frame;
+    scheduler.run(frame);
+    TestRunner::assertTrue(scheduler.schedule(&quickTurn), "Scheduler - Macro scheduled");
+    TestRunner::assertEquals(1, driveSticks.endCount, "Scheduler - Default ended");
+    TestRunner::assertTrue(driveSticks.lastInterrupted, "Scheduler - Default was interrupted");
+    
+    for (int tick = 0; tick < 3; tick++) {
+        ActuationFrame turnFrame;
+        scheduler.run(turnFrame);
+        TestRunner::assertEquals(80, turnFrame.getMotor(ActuationFrame::RIGHT_BACK), "Scheduler - Macro drives");
+    }
+    TestRunner::assertEquals(1, quickTurn.endCount, "Scheduler - Macro ended");
+    TestRunner::assertTrue(!quickTurn.lastInterrupted, "Scheduler - Macro finished normally");
+    
+    ActuationFrame afterFrame;
+    scheduler.run(afterFrame);
+    TestRunner::assertEquals(2, driveSticks.initializeCount, "Scheduler - Default restarted");
+    TestRunner::assertEquals(30, afterFrame.getMotor(ActuationFrame::LEFT_BACK), "Scheduler - Sticks drive again");
+}
+
+/**
+ * Test: Non-Interruptible Command Keeps Its Subsystems
+ * 
+ * Given: Tip recovery (drive + height, not interruptible) is running
+ * When: A quick turn is scheduled, then tip recovery finishes
+ * Then: The quick turn is refused; afterward it can be scheduled
+ */
+void testScheduler_NonInterruptible() {
+    CommandScheduler scheduler;
+    TestCommand tipRecovery(Command::DRIVE | Command::HEIGHT, -40, 2, false);
+    TestCommand quickTurn(Command::DRIVE, 80);
+    
+    TestRunner::assertTrue(scheduler.schedule(&tipRecovery), "Scheduler - Recovery scheduled");
+    TestRunner::assertTrue(!scheduler.schedule(&quickTurn), "Scheduler - Turn refused during recovery");
+    TestRunner::assertEquals(0, tipRecovery.endCount, "Scheduler - Recovery not interrupted");
+    
+    ActuationFrame frame;
+    scheduler.run(frame);
+    scheduler.run(frame);
+    TestRunner::assertTrue(!scheduler.isScheduled(&tipRecovery), "Scheduler - Recovery finished");
+    TestRunner::assertTrue(scheduler.schedule(&quickTurn), "Scheduler - Turn allowed after");
+}
+
+/**
+ * Test: One Command Takes Several Owners' Subsystems
+ * 
+ * Given: Separate commands own intake and ramp, another owns the drive
+ * When: A command needing intake + ramp is scheduled
+ * Then: Both owners are interrupted; the drive command keeps running
+ */
+void testScheduler_MultipleRequirements() {
+    CommandScheduler scheduler;
+    TestCommand intake(Command::INTAKE, 100);
+    TestCommand ramp(Command::RAMP, 100);
+    TestCommand drive(Command::DRIVE, 50);
+    TestCommand unjam(Command::INTAKE | Command::RAMP, -100);
+    scheduler.schedule(&intake);
+    scheduler.schedule(&ramp);
+    scheduler.schedule(&drive);
+    
+    scheduler.schedule(&unjam);
+    TestRunner::assertEquals(1, intake.endCount, "Scheduler - Intake owner interrupted");
+    TestRunner::assertEquals(1, ramp.endCount, "Scheduler - Ramp owner interrupted");
+    TestRunner::assertEquals(0, drive.endCount, "Scheduler - Drive untouched");
+    TestRunner::assertEquals(2, scheduler.getScheduledCount(), "Scheduler - Drive and unjam running");
+    
+    ActuationFrame frame;
+    scheduler.run(frame);
+    TestRunner::assertEquals(-100, frame.getMotor(ActuationFrame::RAMP), "Scheduler - Unjam output");
+    TestRunner::assertEquals(50, frame.getMotor(ActuationFrame::LEFT_FRONT), "Scheduler - Drive output");
+}
+
+/**
+ * Test: Default Waits While Part Of It Is Owned
+ * 
+ * Given: A default for intake that also needs the ramp; the ramp is owned
+ * When: Run
+ * Then: The default doesn't steal the ramp
+ */
+void testScheduler_DefaultDoesNotSteal() {
+    CommandScheduler scheduler;
+    TestCommand rollers(Command::INTAKE | Command::RAMP, 100);
+    TestCommand rampMacro(Command::RAMP, -50);
+    scheduler.setDefaultCommand(Command::INTAKE, &rollers);
+    scheduler.schedule(&rampMacro);
+    
+    ActuationFrame frame;
+    scheduler.run(frame);
+    TestRunner::assertTrue(!scheduler.isScheduled(&rollers), "Scheduler - Default waits");
+    TestRunner::assertEquals(0, rampMacro.endCount, "Scheduler - Macro not interrupted by default");
+}
+
+/**
+ * Test: Cancel And Cancel All
+ */
+void testScheduler_Cancel() {
+    CommandScheduler scheduler;
+    TestCommand drive(Command::DRIVE, 50);
+    TestCommand tipRecovery(Command::HEIGHT, 0, -1, false);
+    scheduler.schedule(&drive);
+    scheduler.schedule(&tipRecovery);
+    
+    scheduler.cancel(&drive);
+    TestRunner::assertTrue(drive.lastInterrupted && drive.endCount == 1, "Scheduler - Cancel interrupts");
+    TestRunner::assertTrue(scheduler.getOwner(Command::DRIVE) == nullptr, "Scheduler - Cancel frees subsystem");
+    scheduler.cancel(&drive);
+    TestRunner::assertEquals(1, drive.endCount, "Scheduler - Cancel twice ends once");
+    
+    scheduler.cancelAll();
+    TestRunner::assertEquals(0, scheduler.getScheduledCount(), "Scheduler - Cancel all stops everything");
+    TestRunner::assertEquals(1, tipRecovery.endCount, "Scheduler - Even non-interruptible");
+}
+
+/**
+ * Test: Full Scheduler Refuses
+ * 
+ * Given: MAX_SCHEDULED commands with no requirements
+ * When: Schedule one more
+ * Then: Refused; scheduling a running command again is fine
+ */
+void testScheduler_Full() {
+    CommandScheduler scheduler;
+    TestCommand commands[CommandScheduler::MAX_SCHEDULED + 1] = {
+        TestCommand(0, 0), TestCommand(0, 0), TestCommand(0, 0), TestCommand(0, 0),
+        TestCommand(0, 0), TestCommand(0, 0), TestCommand(0, 0), TestCommand(0, 0), TestCommand(0, 0)
+    };
+    for (int i = 0; i < CommandScheduler::MAX_SCHEDULED; i++) {
+        scheduler.schedule(&commands[i]);
+    }
+    TestRunner::assertTrue(!scheduler.schedule(&commands[CommandScheduler::MAX_SCHEDULED]), "Scheduler - Full refuses");
+    TestRunner::assertTrue(scheduler.schedule(&commands[0]), "Scheduler - Already running is fine");
+    TestRunner::assertEquals(1, commands[0].initializeCount, "Scheduler - Not initialized twice");
+}
+
+/**
+ * Test: Function Commands
+ */
+int functionTicks = 0;
+int functionEnds = 0;
+void functionExecute(ActuationFrame& frame) {
+    functionTicks++;
+    frame.setMotor(ActuationFrame::INTAKE, 60);
+}
+bool functionFinished() {
+    return functionTicks >= 2;
+}
+void functionEnd(bool) {
+    functionEnds++;
+}
+
+void testScheduler_FunctionCommand() {
+    CommandScheduler scheduler;
+    FunctionCommand command(Command::INTAKE, functionExecute, functionFinished, nullptr, functionEnd);
+    scheduler.schedule(&command);
+    ActuationFrame frame;
+    scheduler.run(frame);
+    scheduler.run(frame);
+    TestRunner::assertEquals(60, frame.getMotor(ActuationFrame::INTAKE), "Function - Output staged");
+    TestRunner::assertEquals(1, functionEnds, "Function - Finished after 2 ticks");
+    TestRunner::assertTrue(!scheduler.isScheduled(&command), "Function - Released");
+}
+
+/**
+ * Test: Benchmark - Scheduler Overhead, No Allocation
+ * 
+ * Given: Five defaults (one per subsystem) and a macro scheduled and cancelled
+ *        every few ticks
+ * When: Run 200,000 ticks
+ * Then: Nothing is allocated and a tick costs well under a microsecond per command
+ */
+void testScheduler_Benchmark() {
+    CommandScheduler scheduler;
+    TestCommand drive(Command::DRIVE, 50);
+    TestCommand intake(Command::INTAKE, 100);
+    TestCommand ramp(Command::RAMP, 100);
+    TestCommand topWheel(Command::TOP_WHEEL, 100);
+    TestCommand height(Command::HEIGHT, 1);
+    TestCommand quickTurn(Command::DRIVE, 80, 5);
+    TestCommand tipRecovery(Command::DRIVE | Command::HEIGHT, -40, 3, false);
+    scheduler.setDefaultCommand(Command::DRIVE, &drive);
+    scheduler.setDefaultCommand(Command::INTAKE, &intake);
+    scheduler.setDefaultCommand(Command::RAMP, &ramp);
+    scheduler.setDefaultCommand(Command::TOP_WHEEL, &topWheel);
+    scheduler.setDefaultCommand(Command::HEIGHT, &height);
+    
+    const int TICKS = 200000;
+    long allocationsBefore = heapAllocations;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int checksum = 0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        if (tick % 7 == 0) {
+            scheduler.schedule(&quickTurn);
+        }
+        if (tick % 50 == 0) {
+            scheduler.schedule(&tipRecovery);
+        }
+        ActuationFrame frame;
+        scheduler.run(frame);
+        checksum += frame.getMotor(ActuationFrame::LEFT_FRONT);
+    }
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    long allocations = heapAllocations - allocationsBefore;
+    double nsPerTick = std::chrono::duration<double, std::nano>(stop - start).count() / TICKS;
+    
+    std::cout << "  Scheduler tick: " << nsPerTick << " ns (5-6 commands), allocations: "
+              << allocations << ", checksum " << checksum << std::endl;
+    
+    TestRunner::assertEquals(0, (int)allocations, "Benchmark - No heap allocation per tick");
+    TestRunner::assertTrue(nsPerTick < 10000.0, "Benchmark - Tick well under the 20 ms loop");
+    TestRunner::assertTrue(quickTurn.endCount > 0 && tipRecovery.endCount > 0, "Benchmark - Commands cycled");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running CommandScheduler Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testScheduler_DefaultsRun();
+    testScheduler_DefaultRequirementChecked();
+    testScheduler_InterruptAndResume();
+    testScheduler_NonInterruptible();
+    testScheduler_MultipleRequirements();
+    testScheduler_DefaultDoesNotSteal();
+    testScheduler_Cancel();
+    testScheduler_Full();
+    testScheduler_FunctionCommand();
+    testScheduler_Benchmark();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,518 @@
+/*
+ * test_drivebalancer.cpp
+ * 
+ * Unit tests for DriveBalancer class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our DriveBalancer class to test it
+#include "../src/controllers/DriveBalancer.h"
+
+typedef DriveBalancer::MotorReading Reading;
+
+// ============================================
+// DRIVE SIDE SIMULATOR
+// ============================================
+
+/**
+ * One drive side: three motors, each on its own wheel, pushing one chassis side
+ * 
+ * Motors: V5 green cartridge on 4" wheels. The motor firmware runs its own velocity loop
+ * (spin(..., percent) is a speed command), current is limited by the torque limit, and
+ * the motor heats with current squared.
+ * Wheels: each has its own normal force (how much weight it carries) and effective
+ * radius (the middle drop-center wheel sits a little lower). Tire force grows with the
+ * slip ratio up to static friction; past that the wheel slides at kinetic friction.
+ */
+struct SideSim {
+    static constexpr double WHEEL_RADIUS = 0.0508;     // m
+    static constexpr double FREE_SPEED = 200.0 * 2.0 * 3.14159265358979 / 60.0;  // rad/s
+    static constexpr double STALL_AMPS = 2.5;
+    static constexpr double LIMIT_AMPS = 2.0;          // 80% torque limit (a hot, derated motor)
+    static constexpr double TORQUE_PER_AMP = 0.42;     // Nm at the wheel
+    static constexpr double WHEEL_INERTIA = 0.002;     // kg m^2 (wheel + motor)
+    static constexpr double SIDE_MASS = 3.5;           // kg
+    static constexpr double STATIC_FRICTION = 1.0;
+    static constexpr double KINETIC_FRICTION = 0.7;
+    static constexpr double PEAK_SLIP = 0.1;           // Slip ratio where the tire reaches static friction
+    static constexpr double FIRMWARE_KP = 2.0;         // Motor velocity loop (per unit speed error)
+    static constexpr double FIRMWARE_KI = 10.0;
+    static constexpr double HEATING = 0.12;            // deg C per second per A^2
+    static constexpr double COOLING_SECONDS = 300.0;
+    static constexpr double AMBIENT_C = 25.0;
+    
+    double radius[3];     // Effective wheel radius (m)
+    double normal[3];     // Normal force (N)
+    double loadForce;     // Constant resistance (N)
+    double loadDamping;   // Resistance per m/s
+    
+    double speed;         // Chassis side speed (m/s)
+    double distance;      // m
+    double wheel[3];      // Wheel speed (rad/s)
+    double integral[3];   // Firmware velocity loop state
+    double amps[3];
+    double celsius[3];
+    bool sliding[3];
+    double slideSeconds[3];
+    
+    SideSim(const double radiusScale[3], const double weightShare[3], double loadForce, double loadDamping)
+        : loadForce(loadForce), loadDamping(loadDamping), speed(0.0), distance(0.0) {
+        for (int i = 0; i < 3; i++) {
+            radius[i] = WHEEL_RADIUS * radiusScale[i];
+            normal[i] = SIDE_MASS * 9.81 * weightShare[i];
+            wheel[i] = 0.0;
+            integral[i] = 0.0;
+            amps[i] = 0.0;
+            celsius[i] = AMBIENT_C;
+            sliding[i] = false;
+            slideSeconds[i] = 0.0;
+        }
+    }
+    
+    /**
+     * Advance by dt with each motor's power command
+     */
+    void step(const int powers[3], double dt) {
+        double totalForce = 0.0;
+        for (int i = 0; i < 3; i++) {
+            // Firmware velocity loop -> voltage fraction -> current (limited)
+            double error = (powers[i] / 100.0 * FREE_SPEED - wheel[i]) / FREE_SPEED;
+            integral[i] = std::fmax(-1.0, std::fmin(1.0, integral[i] + FIRMWARE_KI * error * dt));
+            double voltage = std::fmax(-1.0, std::fmin(1.0, FIRMWARE_KP * error + integral[i]));
+            double current = STALL_AMPS * (voltage - wheel[i] / FREE_SPEED);
+            current = std::fmax(-LIMIT_AMPS, std::fmin(LIMIT_AMPS, current));
+            amps[i] = current;
+            
+            // Tire: grips up to static friction, then slides at kinetic friction
+            double slip = wheel[i] * radius[i] - speed;
+            double force = STATIC_FRICTION * normal[i] * slip / (PEAK_SLIP * std::fmax(std::fabs(speed), 0.1));
+            if (!sliding[i] && std::fabs(force) > STATIC_FRICTION * normal[i]) {
+                sliding[i] = true;
+            } else if (sliding[i] && std::fabs(force) < KINETIC_FRICTION * normal[i]) {
+                sliding[i] = false;
+            }
+            if (sliding[i]) {
+                force = std::copysign(KINETIC_FRICTION * normal[i], slip);
+                slideSeconds[i] += dt;
+            }
+            
+            wheel[i] += (TORQUE_PER_AMP * current - force * radius[i]) / WHEEL_INERTIA * dt;
+            totalForce += force;
+            celsius[i] += (HEATING * current * current - (celsius[i] - AMBIENT_C) / COOLING_SECONDS) * dt;
+        }
+        double resistance = (speed > 0.0 || totalForce > loadForce) ? loadForce + loadDamping * speed : totalForce;
+        speed = std::fmax(0.0, speed + (totalForce - resistance) / SIDE_MASS * dt);
+        distance += speed * dt;
+    }
+    
+    void read(Reading readings[3]) const {
+        for (int i = 0; i < 3; i++) {
+            readings[i].currentA = amps[i];
+            readings[i].temperatureC = celsius[i];
+            readings[i].rpm = wheel[i] * 60.0 / (2.0 * 3.14159265358979);
+        }
+    }
+};
+
+const double SIM_DT = 0.0001;   // Physics step (s)
+const int TICK_STEPS = 100;     // Balancer runs every 10 ms
+
+/**
+ * Result of one simulated run
+ */
+struct SideResult {
+    double meters;          // Distance driven
+    double amps[3];         // Mean current of each motor while driving
+    double peakAmps;        // Highest mean current
+    double peakCelsius;     // Hottest motor at the end
+    double slideSeconds;    // Total time wheels were sliding
+};
+
+/**
+ * Drive one side at a constant command for a while (drivingSeconds on, restSeconds off,
+ * repeated) with or without balancing
+ */
+SideResult simulateSide(const double radiusScale[3], const double weightShare[3], double loadForce,
+                        int sidePower, bool balance, double drivingSeconds, double restSeconds, int cycles) {
+    SideSim sim(radiusScale, weightShare, loadForce, 10.0);
+    DriveBalancer balancer;
+    SideResult result = {0.0, {0.0, 0.0, 0.0}, 0.0, 0.0, 0.0};
+    double drivingTicks = 0.0;
+    int powers[3] = {0, 0, 0};
+    
+    int ticksPerCycle = (int)std::lround((drivingSeconds + restSeconds) * 100.0);
+    int drivingTicksPerCycle = (int)std::lround(drivingSeconds * 100.0);
+    for (int tick = 0; tick < ticksPerCycle * cycles; tick++) {
+        bool driving = tick % ticksPerCycle < drivingTicksPerCycle;
+        int command = driving ? sidePower : 0;
+        Reading readings[3];
+        sim.read(readings);
+        if (balance) {
+            balancer.update(DriveBalancer::LEFT, command, readings, 0.01, powers);
+        } else {
+            powers[0] = powers[1] = powers[2] = command;
+        }
+        // Skip the first half second of each push (spin-up) when averaging currents
+        if (driving && tick % ticksPerCycle >= 50) {
+            for (int i = 0; i < 3; i++) {
+                result.amps[i] += readings[i].currentA;
+            }
+            drivingTicks += 1.0;
+        }
+        for (int s = 0; s < TICK_STEPS; s++) {
+            sim.step(powers, SIM_DT);
+        }
+    }
+    
+    result.meters = sim.distance;
+    for (int i = 0; i < 3; i++) {
+        result.amps[i] /= drivingTicks;
+        result.peakAmps = std::fmax(result.peakAmps, result.amps[i]);
+        result.peakCelsius = std::fmax(result.peakCelsius, sim.celsius[i]);
+        result.slideSeconds += sim.slideSeconds[i];
+    }
+    return result;
+}
+
+void printSide(const char* name, const SideResult& r) {
+    std::cout << "  " << name << ": " << r.meters << " m, current " << r.amps[0] << " / " << r.amps[1]
+              << " / " << r.amps[2] << " A, hottest " << r.peakCelsius << " C, sliding " << r.slideSeconds
+              << " s" << std::endl;
+}
+
+/**
+ * Readings with the same temperature and speed
+ */
+void makeReadings(Reading readings[3], double a0, double a1, double a2, double rpm = 100.0) {
+    double amps[3] = {a0, a1, a2};
+    for (int i = 0; i < 3; i++) {
+        readings[i].currentA = amps[i];
+        readings[i].temperatureC = 30.0;
+        readings[i].rpm = rpm;
+    }
+}
+
+// ============================================
+// TEST CASES FOR DRIVE BALANCER
+// ============================================
+
+/**
+ * Test: Distribute Keeps The Total
+ * 
+ * Given: Uneven shares
+ * When: A side command is distributed
+ * Then: The powers follow the shares and add up to 3 x the command; past 100 they clamp
+ */
+void testBalancer_DistributeKeepsTotal() {
+    int powers[3];
+    double shares[3] = {0.8, 1.4, 0.8};
+    DriveBalancer::distribute(50, shares, powers);
+    TestRunner::assertEquals(40, powers[0], "Balancer - Front follows its share");
+    TestRunner::assertEquals(70, powers[1], "Balancer - Middle follows its share");
+    TestRunner::assertEquals(150, powers[0] + powers[1] + powers[2], "Balancer - Total kept");
+    
+    DriveBalancer::distribute(90, shares, powers);
+    TestRunner::assertEquals(100, powers[1], "Balancer - Clamped at 100");
+    TestRunner::assertEquals(72, powers[0], "Balancer - Clamped excess isn't handed back");
+    
+    double thirds[3] = {1.0 / 3.0, 4.0 / 3.0, 4.0 / 3.0};
+    DriveBalancer::distribute(-35, thirds, powers);
+    TestRunner::assertEquals(-105, powers[0] + powers[1] + powers[2], "Balancer - Rounding doesn't lose effort");
+}
+
+/**
+ * Test: Even Until Imbalanced
+ * 
+ * Given: Three motors with the same current, speed and temperature
+ * When: update() runs for a second
+ * Then: Every motor gets the side command
+ */
+void testBalancer_EvenWhenBalanced() {
+    DriveBalancer balancer;
+    Reading readings[3];
+    makeReadings(readings, 1.0, 1.0, 1.0);
+    int powers[3];
+    for (int i = 0; i < 100; i++) {
+        balancer.update(DriveBalancer::LEFT, 60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(powers[0] == 60 && powers[1] == 60 && powers[2] == 60, "Balancer - Balanced = same power");
+}
+
+/**
+ * Test: High Current Sheds Effort
+ * 
+ * Given: The middle motor draws 2 A, the ends 0.5 A
+ * When: update() runs for a while
+ * Then: The middle's share drops, the ends' rise, the total stays the same
+ */
+void testBalancer_HighCurrentSheds() {
+    DriveBalancer balancer;
+    Reading readings[3];
+    makeReadings(readings, 0.5, 2.0, 0.5);
+    int powers[3];
+    for (int i = 0; i < 10; i++) {
+        balancer.update(DriveBalancer::LEFT, 60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(balancer.getShare(DriveBalancer::LEFT, 1) < 1.0, "Balancer - Loaded motor sheds");
+    TestRunner::assertTrue(powers[0] > 60 && powers[2] > 60 && powers[1] < 60, "Balancer - Effort moves to the ends");
+    TestRunner::assertEquals(180, powers[0] + powers[1] + powers[2], "Balancer - Side total kept");
+    TestRunner::assertNear(1.0, balancer.getShare(DriveBalancer::RIGHT, 1), 0.0001, "Balancer - Other side untouched");
+    
+    for (int i = 0; i < 1000; i++) {
+        balancer.update(DriveBalancer::LEFT, 60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(balancer.getShare(DriveBalancer::LEFT, 1) >= DriveBalancer::MIN_SHARE - 1e-9,
+                           "Balancer - Share never below the minimum");
+}
+
+/**
+ * Test: Slipping Wheel Sheds Effort
+ * 
+ * Given: The front wheel turns 50% faster than the others (and draws little current)
+ * When: update() runs
+ * Then: The front's share drops even though its current is lowest
+ */
+void testBalancer_SlipSheds() {
+    DriveBalancer balancer;
+    Reading readings[3];
+    makeReadings(readings, 0.3, 1.5, 1.5);
+    readings[0].rpm = 150.0;
+    int powers[3];
+    for (int i = 0; i < 10; i++) {
+        balancer.update(DriveBalancer::LEFT, 60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(balancer.getShare(DriveBalancer::LEFT, 0) < 1.0, "Balancer - Slipping wheel sheds");
+    TestRunner::assertTrue(powers[1] > 60 && powers[2] > 60, "Balancer - Effort to the wheels with traction");
+}
+
+/**
+ * Test: Hot Motor Sheds Effort
+ * 
+ * Given: Same currents, the back motor 15 degrees hotter
+ * When: update() runs
+ * Then: The back's share drops
+ */
+void testBalancer_HotSheds() {
+    DriveBalancer balancer;
+    Reading readings[3];
+    makeReadings(readings, 1.0, 1.0, 1.0);
+    readings[2].temperatureC = 45.0;
+    int powers[3];
+    for (int i = 0; i < 10; i++) {
+        balancer.update(DriveBalancer::RIGHT, 60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(balancer.getShare(DriveBalancer::RIGHT, 2) < 1.0, "Balancer - Hot motor sheds");
+}
+
+/**
+ * Test: Reverse And Idle
+ * 
+ * Given: Driving backward with the middle motor loaded (most negative current)
+ * When: update() runs, then the stick is released
+ * Then: The middle sheds in reverse too; at rest every motor gets the (small) command and
+ *       the shares drift back to even
+ */
+void testBalancer_ReverseAndIdle() {
+    DriveBalancer balancer;
+    Reading readings[3];
+    makeReadings(readings, -0.5, -2.0, -0.5, -100.0);
+    int powers[3];
+    for (int i = 0; i < 10; i++) {
+        balancer.update(DriveBalancer::LEFT, -60, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(powers[1] > -60 && powers[0] < -60, "Balancer - Reverse: loaded motor sheds");
+    
+    for (int i = 0; i < 200; i++) {
+        balancer.update(DriveBalancer::LEFT, 2, readings, 0.01, powers);
+    }
+    TestRunner::assertTrue(powers[0] == 2 && powers[1] == 2 && powers[2] == 2, "Balancer - Small commands pass through");
+    TestRunner::assertNear(1.0, balancer.getShare(DriveBalancer::LEFT, 1), 0.01, "Balancer - Shares relax to even");
+}
+
+/**
+ * Test: Simulated Drop-Center Push
+ * 
+ * Given: A side whose middle wheel sits lower (2% larger effective radius) and carries
+ *        half the weight, pushing a heavy load at 60%
+ * When: Driven with the same command on all three motors, then balanced
+ * Then: Same command: the middle motor does the work while the ends spin. Balanced: the
+ *       three currents are within 0.3 A, the ends stop sliding, the side goes further
+ */
+void testBalancer_SimDropCenterPush() {
+    double radius[3] = {1.0, 1.02, 1.0};
+    double weight[3] = {0.25, 0.5, 0.25};
+    SideResult same = simulateSide(radius, weight, 16.0, 60, false, 3.0, 0.0, 1);
+    SideResult balanced = simulateSide(radius, weight, 16.0, 60, true, 3.0, 0.0, 1);
+    printSide("Push, same command", same);
+    printSide("Push, balanced    ", balanced);
+    
+    double spread = std::fmax(balanced.amps[0], std::fmax(balanced.amps[1], balanced.amps[2])) -
+                    std::fmin(balanced.amps[0], std::fmin(balanced.amps[1], balanced.amps[2]));
+    TestRunner::assertTrue(same.amps[1] > same.amps[0] + 0.3, "Balancer Sim - Same command loads the middle");
+    TestRunner::assertTrue(spread < 0.3, "Balancer Sim - Balanced currents within 0.3 A");
+    TestRunner::assertTrue(balanced.amps[1] < same.amps[1], "Balancer Sim - Middle motor works less");
+    TestRunner::assertTrue(balanced.slideSeconds < same.slideSeconds * 0.5, "Balancer Sim - End wheels slide less");
+    TestRunner::assertTrue(balanced.meters > same.meters, "Balancer Sim - Pushes further");
+}
+
+/**
+ * Test: Simulated Turn With Lifted Ends
+ * 
+ * Given: A turning side: the middle wheel carries most of the weight, the ends barely
+ *        touch, heavy scrub resistance, 70% command
+ * When: Driven with the same command, then balanced
+ * Then: Balancing cuts the time the end wheels slide and the side turns further
+ */
+void testBalancer_SimTurnLiftedEnds() {
+    double radius[3] = {1.0, 1.02, 1.0};
+    double weight[3] = {0.1, 0.8, 0.1};
+    SideResult same = simulateSide(radius, weight, 14.0, 70, false, 2.0, 0.0, 1);
+    SideResult balanced = simulateSide(radius, weight, 14.0, 70, true, 2.0, 0.0, 1);
+    printSide("Turn, same command", same);
+    printSide("Turn, balanced    ", balanced);
+    
+    TestRunner::assertTrue(balanced.slideSeconds < same.slideSeconds * 0.5, "Balancer Sim - End wheels slide less");
+    TestRunner::assertTrue(balanced.meters > same.meters, "Balancer Sim - Turns further");
+}
+
+/**
+ * Test: Simulated Match Heating
+ * 
+ * Given: The drop-center push, 3 s on and 2 s off for two minutes
+ * When: Driven with the same command, then balanced
+ * Then: The hottest motor ends up cooler with balancing
+ */
+void testBalancer_SimMatchHeating() {
+    double radius[3] = {1.0, 1.02, 1.0};
+    double weight[3] = {0.25, 0.5, 0.25};
+    SideResult same = simulateSide(radius, weight, 16.0, 60, false, 3.0, 2.0, 24);
+    SideResult balanced = simulateSide(radius, weight, 16.0, 60, true, 3.0, 2.0, 24);
+    printSide("Match, same command", same);
+    printSide("Match, balanced    ", balanced);
+    
+    TestRunner::assertTrue(balanced.peakCelsius < same.peakCelsius - 1.0, "Balancer Sim - Hottest motor cooler");
+}
+
+int main() {
+    std::cout << "=== Running DriveBalancer Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testBalancer_DistributeKeepsTotal();
+    testBalancer_EvenWhenBalanced();
+    testBalancer_HighCurrentSheds();
+    testBalancer_SlipSheds();
+    testBalancer_HotSheds();
+    testBalancer_ReverseAndIdle();
+    testBalancer_SimDropCenterPush();
+    testBalancer_SimTurnLiftedEnds();
+    testBalancer_SimMatchHeating();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * test_energymonitor.cpp
+ * 
+ * Unit tests for EnergyMonitor class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our EnergyMonitor class to test it
+#include "../src/controllers/EnergyMonitor.h"
+
+// ============================================
+// TEST CASES FOR ENERGY MONITOR
+// ============================================
+
+/**
+ * Test: Electrical Power - Forward and Reverse
+ * 
+ * Given: 12 V at 2 A, and -12 V at 2 A (motor reversed)
+ * When: Calculate electrical power
+ * Then: Both draw 24 W from the battery
+ */
+void testElectricalPower_Direction() {
+    TestRunner::assertNear(24.0, EnergyMonitor::electricalPower(12.0, 2.0), 1e-9, "Power - Forward 12 V * 2 A = 24 W");
+    TestRunner::assertNear(24.0, EnergyMonitor::electricalPower(-12.0, 2.0), 1e-9, "Power - Reverse also draws 24 W");
+    TestRunner::assertNear(0.0, EnergyMonitor::electricalPower(0.0, 2.5), 1e-9, "Power - Zero voltage draws 0 W");
+}
+
+/**
+ * Test: Energy Integrates Over Ticks
+ * 
+ * Given: Drive draws 6 motors * 12 V * 1 A = 72 W
+ * When: 50 ticks of 20 ms (1 second)
+ * Then: Drive used 72 J
+ */
+void testEnergy_IntegratesOverTicks() {
+    EnergyMonitor monitor;
+    for (int tick = 0; tick < 50; tick++) {
+        for (int motor = 0; motor < 6; motor++) {
+            monitor.addMotorSample(EnergyMonitor::DRIVE, 12.0, 1.0);
+        }
+        monitor.endTick(0.020);
+    }
+    TestRunner::assertNear(72.0, monitor.getEnergy(EnergyMonitor::DRIVE), 1e-6, "Energy - 72 W for 1 s is 72 J");
+    TestRunner::assertNear(72.0, monitor.getPower(EnergyMonitor::DRIVE), 1e-9, "Energy - Last tick power is 72 W");
+}
+
+/**
+ * Test: Uneven Tick Lengths
+ * 
+ * Given: Same power, ticks of 15 ms and 25 ms
+ * When: Integrate
+ * Then: Energy uses the real elapsed time (40 ms total)
+ */
+void testEnergy_UnevenTicks() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::INTAKE, 10.0, 1.0);
+    monitor.endTick(0.015);
+    monitor.addMotorSample(EnergyMonitor::INTAKE, 10.0, 1.0);
+    monitor.endTick(0.025);
+    TestRunner::assertNear(0.4, monitor.getEnergy(EnergyMonitor::INTAKE), 1e-9, "Energy - Uses real tick length");
+}
+
+/**
+ * Test: Share Per Subsystem
+ * 
+ * Given: Drive 30 W, intake 5 W, ramp 5 W, full power ramp 10 W
+ * When: Integrate one tick
+ * Then: Shares are 60%, 10%, 10%, 20%
+ */
+void testEnergy_Share() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::DRIVE, 10.0, 3.0);
+    monitor.addMotorSample(EnergyMonitor::INTAKE, 5.0, 1.0);
+    monitor.addMotorSample(EnergyMonitor::RAMP, 5.0, 1.0);
+    monitor.addMotorSample(EnergyMonitor::FULL_POWER_RAMP, 10.0, 1.0);
+    monitor.endTick(0.020);
+    
+    TestRunner::assertNear(0.6, monitor.getShare(EnergyMonitor::DRIVE), 1e-9, "Energy - Drive share 60%");
+    TestRunner::assertNear(0.1, monitor.getShare(EnergyMonitor::INTAKE), 1e-9, "Energy - Intake share 10%");
+    TestRunner::assertNear(0.2, monitor.getShare(EnergyMonitor::FULL_POWER_RAMP), 1e-9, "Energy - Full power ramp share 20%");
+    TestRunner::assertNear(50.0, monitor.getTotalPower(), 1e-9, "Energy - Total power 50 W");
+}
+
+/**
+ * Test: Share Before Any Energy Is Zero (no divide by zero)
+ */
+void testEnergy_ShareWhenEmpty() {
+    EnergyMonitor monitor;
+    TestRunner::assertNear(0.0, monitor.getShare(EnergyMonitor::DRIVE), 1e-9, "Energy - Empty share is 0");
+}
+
+/**
+ * Test: Invalid Subsystem Ignored
+ */
+void testEnergy_InvalidSubsystemIgnored() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::SUBSYSTEM_COUNT, 12.0, 2.0);
+    monitor.endTick(1.0);
+    TestRunner::assertNear(0.0, monitor.getTotalEnergy(), 1e-9, "Energy - Invalid subsystem ignored");
+}
+
+/**
+ * Test: Negative Tick Length Ignored
+ */
+void testEnergy_NegativeTickIgnored() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::DRIVE, 12.0, 2.0);
+    monitor.endTick(-0.02);
+    TestRunner::assertNear(0.0, monitor.getTotalEnergy(), 1e-9, "Energy - Negative dt adds nothing");
+}
+
+/**
+ * Test: Reset Clears Totals
+ */
+void testEnergy_Reset() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::DRIVE, 12.0, 2.0);
+    monitor.endTick(1.0);
+    monitor.reset();
+    TestRunner::assertNear(0.0, monitor.getTotalEnergy(), 1e-9, "Energy - Reset clears totals");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running EnergyMonitor Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testElectricalPower_Direction();
+    testEnergy_IntegratesOverTicks();
+    testEnergy_UnevenTicks();
+    testEnergy_Share();
+    testEnergy_ShareWhenEmpty();
+    testEnergy_InvalidSubsystemIgnored();
+    testEnergy_NegativeTickIgnored();
+    testEnergy_Reset();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * test_eventbus.cpp
+ * 
+ * Unit tests for EventBus class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <chrono>
+#include <thread>
+
+// Include our EventBus class to test it
+#include "../src/controllers/EventBus.h"
+
+// ============================================
+// TEST EVENTS AND HANDLERS
+// ============================================
+
+struct JamEvent {
+    int motor;
+    uint32_t timeMs;
+};
+
+struct FaultEvent {
+    int code;
+};
+
+struct BallEvent {
+    uint32_t sequence;
+};
+
+typedef EventBus<EventChannel<JamEvent, 4>, EventChannel<FaultEvent, 8>, EventChannel<BallEvent, 64, 2> > TestBus;
+
+int jamCount = 0;
+int lastJamMotor = -1;
+int faultCount = 0;
+int callOrder[4];
+int callCount = 0;
+
+void onJam(const JamEvent& event) {
+    jamCount++;
+    lastJamMotor = event.motor;
+    if (callCount < 4) callOrder[callCount++] = 1;
+}
+
+void onJamSecond(const JamEvent&) {
+    if (callCount < 4) callOrder[callCount++] = 2;
+}
+
+void onFault(const FaultEvent&) {
+    faultCount++;
+}
+
+void resetHandlers() {
+    jamCount = 0;
+    lastJamMotor = -1;
+    faultCount = 0;
+    callCount = 0;
+}
+
+uint32_t ballsSeen = 0;
+uint32_t ballsOutOfOrder = 0;
+
+void onBall(const BallEvent& event) {
+    if (event.sequence != ballsSeen) {
+        ballsOutOfOrder++;
+    }
+    ballsSeen++;
+}
+
+// ============================================
+// TEST CASES FOR EVENT BUS
+// ============================================
+
+/**
+ * Test: Nothing Delivered Until Dispatch
+ * 
+ * Given: A subscribed jam handler
+ * When: A jam event is published
+ * Then: The handler runs only at dispatchAll() (the tick boundary), once
+ */
+void testEventBus_DispatchAtTickBoundary() {
+    resetHandlers();
+    TestBus bus;
+    bus.subscribe<JamEvent>(onJam);
+    
+    bus.publish(JamEvent{7, 1000});
+    TestRunner::assertEquals(0, jamCount, "Event Bus - Publish doesn't call handlers");
+    TestRunner::assertEquals(1, (int)bus.getPendingCount<JamEvent>(), "Event Bus - Event queued");
+    
+    TestRunner::assertEquals(1, bus.dispatchAll(), "Event Bus - One event delivered");
+    TestRunner::assertEquals(1, jamCount, "Event Bus - Handler ran at dispatch");
+    TestRunner::assertEquals(7, lastJamMotor, "Event Bus - Event data delivered");
+    TestRunner::assertEquals(0, bus.dispatchAll(), "Event Bus - Delivered only once");
+}
+
+/**
+ * Test: Routing By Type
+ * 
+ * Given: Handlers for jams (two) and faults
+ * When: One of each is published
+ * Then: Each handler sees only its type; jam handlers run in subscription order
+ */
+void testEventBus_RoutingByType() {
+    resetHandlers();
+    TestBus bus;
+    bus.subscribe<JamEvent>(onJam);
+    bus.subscribe<JamEvent>(onJamSecond);
+    bus.subscribe<FaultEvent>(onFault);
+    
+    bus.publish(FaultEvent{3});
+    bus.publish(JamEvent{2, 0});
+    bus.dispatchAll();
+    
+    TestRunner::assertEquals(1, jamCount, "Event Bus - Jam handler saw the jam");
+    TestRunner::assertEquals(1, faultCount, "Event Bus - Fault handler saw the fault");
+    TestRunner::assertTrue(callCount == 2 && callOrder[0] == 1 && callOrder[1] == 2, "Event Bus - Subscribers in order");
+}
+
+/**
+ * Test: Subscriber List Is Fixed Size
+ */
+void testEventBus_SubscriberLimit() {
+    TestBus bus;
+    TestRunner::assertTrue(bus.subscribe<BallEvent>(onBall), "Event Bus - First subscriber");
+    TestRunner::assertTrue(bus.subscribe<BallEvent>(onBall), "Event Bus - Second subscriber");
+    TestRunner::assertTrue(!bus.subscribe<BallEvent>(onBall), "Event Bus - Third refused (limit 2)");
+}
+
+/**
+ * Test: Full Channel Drops Only Its Own Events
+ * 
+ * Given: The jam channel holds 4
+ * When: 6 jams and a fault are published before dispatch
+ * Then: 2 jams are dropped and counted; the fault still arrives
+ */
+void testEventBus_FullChannel() {
+    resetHandlers();
+    TestBus bus;
+    bus.subscribe<JamEvent>(onJam);
+    bus.subscribe<FaultEvent>(onFault);
+    
+    int accepted = 0;
+    for (int i = 0; i < 6; i++) {
+        if (bus.publish(JamEvent{i, 0})) accepted++;
+    }
+    bus.publish(FaultEvent{1});
+    bus.dispatchAll();
+    
+    TestRunner::assertEquals(4, accepted, "Event Bus - Jam channel full at 4");
+    TestRunner::assertEquals(2, (int)bus.getDroppedCount(), "Event Bus - Drops counted");
+    TestRunner::assertEquals(3, lastJamMotor, "Event Bus - Oldest jams kept");
+    TestRunner::assertEquals(1, faultCount, "Event Bus - Other channel unaffected");
+}
+
+/**
+ * Test: Torture - Publishing Task And Control Tick
+ * 
+ * Given: A producer thread and a consumer thread that dispatches in "ticks"
+ * When: 500,000 ball events are published (retrying when full)
+ * Then: Every event is delivered exactly once, in order
+ */
+void testEventBus_Torture() {
+    const uint32_t EVENTS = 500000;
+    TestBus bus;
+    bus.subscribe<BallEvent>(onBall);
+    ballsSeen = 0;
+    ballsOutOfOrder = 0;
+    
+    std::thread consumer([&]() {
+        while (ballsSeen < EVENTS) {
+            if (bus.dispatchAll() == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < EVENTS; i++) {
+            while (!bus.publish(BallEvent{i})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    producer.join();
+    consumer.join();
+    
+    TestRunner::assertEquals((int)EVENTS, (int)ballsSeen, "Torture - Every event delivered");
+    TestRunner::assertEquals(0, (int)ballsOutOfOrder, "Torture - In order");
+}
+
+/**
+ * Test: Benchmark - Publish And Dispatch Cost
+ * 
+ * Given: One subscriber on the ball channel
+ * When: 1,000,000 events are published and dispatched in ticks of 16
+ * Then: Both costs per event are printed, and each is far below a microsecond
+ */
+void testEventBus_Benchmark() {
+    const int TICKS = 62500;
+    const int EVENTS_PER_TICK = 16;
+    TestBus bus;
+    bus.subscribe<BallEvent>(onBall);
+    ballsSeen = 0;
+    ballsOutOfOrder = 0;
+    
+    double publishNs = 0.0;
+    double dispatchNs = 0.0;
+    uint32_t sequence = 0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < EVENTS_PER_TICK; i++) {
+            bus.publish(BallEvent{sequence++});
+        }
+        std::chrono::steady_clock::time_point published = std::chrono::steady_clock::now();
+        bus.dispatchAll();
+        std::chrono::steady_clock::time_point dispatched = std::chrono::steady_clock::now();
+        publishNs += std::chrono::duration<double, std::nano>(published - start).count();
+        dispatchNs += std::chrono::duration<double, std::nano>(dispatched - published).count();
+    }
+    double events = (double)TICKS * EVENTS_PER_TICK;
+    
+    std::cout << "  Per event: publish " << publishNs / events << " ns, dispatch "
+              << dispatchNs / events << " ns (3 channels, 1 subscriber)" << std::endl;
+    
+    TestRunner::assertEquals((int)events, (int)ballsSeen, "Benchmark - All delivered");
+    TestRunner::assertTrue(publishNs / events < 1000.0, "Benchmark - Publish under 1 us");
+    TestRunner::assertTrue(dispatchNs / events < 1000.0, "Benchmark - Dispatch under 1 us");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running EventBus Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testEventBus_DispatchAtTickBoundary();
+    testEventBus_RoutingByType();
+    testEventBus_SubscriberLimit();
+    testEventBus_FullChannel();
+    testEventBus_Torture();
+    testEventBus_Benchmark();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,518 @@
+/*
+ * test_goalaim.cpp
+ * 
+ * Unit tests for GoalAim class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+#include <cstdlib>
+
+// Include our GoalAim class to test it
+#include "../src/controllers/GoalAim.h"
+#include "../src/controllers/Odometry.h"
+
+const int GOAL_SIGNATURE = 2;
+const int BALL_SIGNATURE = 1;
+
+// ============================================
+// TURN AND VISION SIMULATOR
+// ============================================
+
+/**
+ * Drivetrain turning in place
+ * Turn rate follows the commanded power with a first-order lag (motor + robot inertia);
+ * below a few percent of power the robot doesn't move (friction).
+ */
+struct TurnSim {
+    double heading;    // Degrees, compass (clockwise positive)
+    double rate;       // Degrees per second
+    double maxRate;    // Turn rate at 100% power
+    double lagSeconds; // Time constant
+    int stictionPower; // Less than this doesn't turn the robot
+    
+    TurnSim(double startHeading)
+        : heading(startHeading), rate(0.0), maxRate(450.0), lagSeconds(0.08), stictionPower(4) {
+    }
+    
+    void step(int leftPower, int rightPower, double dt) {
+        double turnPower = (leftPower - rightPower) / 2.0;
+        double commanded = (std::fabs(turnPower) < stictionPower) ? 0.0 : turnPower / 100.0 * maxRate;
+        rate += (commanded - rate) * (dt / lagSeconds);
+        heading = Odometry::wrapHeading(heading + rate * dt);
+    }
+};
+
+/**
+ * Stand-in for the vision sensor looking at the goal
+ * A frame shows the goal where it was relative to the robot when the frame was taken;
+ * the program only reads it latencyMs later. Adds pixel noise, dropped frames and a
+ * ball blob that must be ignored.
+ */
+struct SimCamera {
+    double goalHeading;    // Field heading of the goal from the robot
+    uint32_t latencyMs;
+    double noisePx;        // Uniform noise on the goal's center (+/- pixels)
+    int dropPercent;       // Frames where the goal isn't found
+    
+    // Headings the robot had, one per ms, so frames can be taken in the past
+    double pastHeadings[1000];
+    
+    SimCamera(double goalHeading, uint32_t latencyMs)
+        : goalHeading(goalHeading), latencyMs(latencyMs), noisePx(1.5), dropPercent(10) {
+        for (int i = 0; i < 1000; i++) {
+            pastHeadings[i] = 0.0;
+        }
+    }
+    
+    void record(uint32_t nowMs, double heading) {
+        pastHeadings[nowMs % 1000] = heading;
+    }
+    
+    static int pixelForBearing(double bearingDeg) {
+        const double PI = 3.14159265358979;
+        double focalPx = (VisionTracker::IMAGE_WIDTH / 2.0) /
+                         std::tan(VisionTracker::FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+        return (int)std::lround(VisionTracker::IMAGE_WIDTH / 2.0 + focalPx * std::tan(bearingDeg * PI / 180.0));
+    }
+    
+    /**
+     * Frame read at nowMs (taken latencyMs before)
+     * @return Number of detections
+     */
+    int read(uint32_t nowMs, VisionTracker::Detection* detections) {
+        int count = 0;
+        // A ball on the floor, always in view
+        detections[count++] = {200, 180, 40, 38, BALL_SIGNATURE};
+        
+        double headingThen = pastHeadings[(nowMs - latencyMs) % 1000];
+        double bearing = Odometry::headingDifference(headingThen, goalHeading);
+        if (std::fabs(bearing) > VisionTracker::FIELD_OF_VIEW_DEG / 2.0 || std::rand() % 100 < dropPercent) {
+            return count;
+        }
+        double noise = ((std::rand() % 2001) / 1000.0 - 1.0) * noisePx;
+        int centerX = pixelForBearing(bearing) + (int)std::lround(noise);
+        detections[count++] = {centerX, 60, 70, 40, GOAL_SIGNATURE};
+        return count;
+    }
+};
+
+/**
+ * Result of one simulated aim
+ */
+struct AimResult {
+    bool locked;           // Aim locked before the time limit
+    uint32_t lockTimeMs;   // From the start to the first lock
+    double errorAtLock;    // True degrees off the goal when it locked
+    double overshoot;      // Worst degrees past the goal
+    bool stayedLocked;     // Still locked (and on target) for a second after
+};
+
+const uint32_t TICK_MS = 10;
+const uint32_t FRAME_MS = 20;
+
+/**
+ * Aim at a goal offsetDeg clockwise of the robot, with a camera latencyMs behind
+ * and GoalAim told the latency is assumedLatencyMs
+ */
+AimResult simulateAim(double offsetDeg, uint32_t latencyMs, uint32_t assumedLatencyMs, unsigned int seed) {
+    std::srand(seed);
+    TurnSim robot(90.0);
+    SimCamera camera(Odometry::wrapHeading(90.0 + offsetDeg), latencyMs);
+    GoalAim aim(GOAL_SIGNATURE, assumedLatencyMs);
+    VisionTracker::Detection detections[VisionTracker::MAX_DETECTIONS];
+    
+    AimResult result = {false, 0, 0.0, 0.0, true};
+    double direction = (offsetDeg < 0.0) ? -1.0 : 1.0;
+    uint32_t startMs = 1000;
+    int leftPower = 0, rightPower = 0;
+    
+    for (uint32_t now = 0; now < startMs + 3000; now++) {
+        camera.record(now, robot.heading);
+        if (now % TICK_MS != 0) {
+            continue;
+        }
+        aim.addHeading(robot.heading, now);
+        if (now % FRAME_MS == 0) {
+            aim.addGoalFrame(detections, camera.read(now, detections), now);
+        }
+        if (now == startMs) {
+            aim.start();
+        }
+        if (now >= startMs) {
+            aim.update(now, leftPower, rightPower);
+        }
+        robot.step(leftPower, rightPower, TICK_MS / 1000.0);
+        
+        double error = Odometry::headingDifference(robot.heading, camera.goalHeading);
+        if (now >= startMs && -direction * error > result.overshoot) {
+            result.overshoot = -direction * error;
+        }
+        if (aim.isLocked() && !result.locked) {
+            result.locked = true;
+            result.lockTimeMs = now - startMs;
+            result.errorAtLock = error;
+        }
+        if (result.locked && now - startMs < result.lockTimeMs + 1000 &&
+            (!aim.isLocked() || std::fabs(error) > GoalAim::UNLOCK_TOLERANCE_DEG)) {
+            result.stayedLocked = false;
+        }
+    }
+    return result;
+}
+
+/**
+ * One goal blob at a bearing
+ */
+VisionTracker::Detection goalAt(double bearingDeg, int width = 60) {
+    VisionTracker::Detection d = {SimCamera::pixelForBearing(bearingDeg), 60, width, 40, GOAL_SIGNATURE};
+    return d;
+}
+
+// ============================================
+// TEST CASES FOR GOAL AIM
+// ============================================
+
+/**
+ * Test: Heading History
+ * 
+ * Given: Gyro samples 10 ms apart, one pair crossing 0/360
+ * When: headingAt() looks up times between and outside the samples
+ * Then: Headings are interpolated (the short way across 0/360) and clamped at the ends
+ */
+void testGoalAim_HeadingHistory() {
+    GoalAim aim(GOAL_SIGNATURE);
+    aim.addHeading(340.0, 100);
+    aim.addHeading(350.0, 110);
+    aim.addHeading(10.0, 120);
+    
+    TestRunner::assertNear(345.0, aim.headingAt(105), 0.001, "Goal Aim - Interpolates between samples");
+    TestRunner::assertNear(0.0, aim.headingAt(115), 0.001, "Goal Aim - Interpolates across 0/360");
+    TestRunner::assertNear(340.0, aim.headingAt(50), 0.001, "Goal Aim - Older than history = oldest");
+    TestRunner::assertNear(10.0, aim.headingAt(200), 0.001, "Goal Aim - Newer than history = newest");
+    TestRunner::assertNear(1500.0, aim.getTurnRate(), 0.001, "Goal Aim - Turn rate from history");
+}
+
+/**
+ * Test: Goal Heading From Bearing
+ * 
+ * Given: A still robot facing 90 degrees, goal 10 degrees right in the frame
+ * When: The frame is added
+ * Then: The goal's field heading is 100 and the heading error is +10
+ */
+void testGoalAim_GoalHeadingFromBearing() {
+    GoalAim aim(GOAL_SIGNATURE);
+    for (uint32_t t = 0; t <= 100; t += 10) {
+        aim.addHeading(90.0, t);
+    }
+    VisionTracker::Detection d = goalAt(10.0);
+    TestRunner::assertEqualsBool(true, aim.addGoalFrame(&d, 1, 100), "Goal Aim - Goal found in frame");
+    TestRunner::assertNear(100.0, aim.getGoalHeading(), 0.3, "Goal Aim - Goal heading = heading + bearing");
+    TestRunner::assertNear(10.0, aim.getHeadingError(), 0.3, "Goal Aim - Error is the bearing");
+    TestRunner::assertEqualsBool(true, aim.hasGoal(100), "Goal Aim - Goal seen");
+}
+
+/**
+ * Test: Camera Latency Compensation
+ * 
+ * Given: A robot turning clockwise at 200 deg/s, frames read 40 ms after they are taken
+ * When: A frame shows the goal where it was 40 ms ago
+ * Then: The goal heading is right when the latency is known; 8 degrees too far without it
+ */
+void testGoalAim_LatencyCompensation() {
+    GoalAim aim(GOAL_SIGNATURE, 40);
+    GoalAim naive(GOAL_SIGNATURE, 0);
+    double goal = 60.0;
+    for (uint32_t t = 0; t <= 200; t += 10) {
+        aim.addHeading(0.2 * t, t);
+        naive.addHeading(0.2 * t, t);
+    }
+    // Taken at 160 ms (heading 32), read at 200 ms (heading 40)
+    VisionTracker::Detection d = goalAt(goal - 32.0);
+    aim.addGoalFrame(&d, 1, 200);
+    naive.addGoalFrame(&d, 1, 200);
+    
+    TestRunner::assertNear(goal, aim.getGoalHeading(), 0.3, "Goal Aim - Latency compensated goal heading");
+    TestRunner::assertNear(goal + 8.0, naive.getGoalHeading(), 0.3, "Goal Aim - Uncompensated is off by rate x latency");
+    TestRunner::assertNear(20.0, aim.getHeadingError(), 0.3, "Goal Aim - Error from the current heading");
+}
+
+/**
+ * Test: Error Between Frames
+ * 
+ * Given: One frame with the goal 20 degrees right
+ * When: The gyro turns 15 degrees with no new frame
+ * Then: The heading error follows the gyro down to 5 degrees
+ */
+void testGoalAim_ErrorBetweenFrames() {
+    GoalAim aim(GOAL_SIGNATURE, 0);
+    aim.addHeading(0.0, 0);
+    VisionTracker::Detection d = goalAt(20.0);
+    aim.addGoalFrame(&d, 1, 0);
+    
+    aim.addHeading(15.0, 10);
+    TestRunner::assertNear(5.0, aim.getHeadingError(), 0.3, "Goal Aim - Error predicted from the gyro");
+}
+
+/**
+ * Test: Goal Selection
+ * 
+ * Given: Frames with balls, a blob too small to be the goal, and two goal blobs
+ * When: The frames are added
+ * Then: Only goal-colored blobs count, tiny ones are ignored, the widest wins
+ */
+void testGoalAim_GoalSelection() {
+    GoalAim aim(GOAL_SIGNATURE, 0);
+    aim.addHeading(0.0, 0);
+    
+    VisionTracker::Detection noGoal[2] = {{100, 150, 40, 40, BALL_SIGNATURE}, goalAt(5.0, 6)};
+    TestRunner::assertEqualsBool(false, aim.addGoalFrame(noGoal, 2, 0), "Goal Aim - Balls and specks are not the goal");
+    TestRunner::assertEqualsBool(false, aim.hasGoal(0), "Goal Aim - No goal yet");
+    
+    VisionTracker::Detection twoGoals[3] = {goalAt(-20.0, 30), {100, 150, 40, 40, BALL_SIGNATURE}, goalAt(12.0, 80)};
+    aim.addGoalFrame(twoGoals, 3, 0);
+    TestRunner::assertNear(12.0, aim.getGoalHeading(), 0.3, "Goal Aim - Widest goal blob is the goal");
+}
+
+/**
+ * Test: Turn Direction And Lost Goal
+ * 
+ * Given: Aiming at a goal to the right
+ * When: update() is called, then the goal stays out of view past the timeout
+ * Then: Turns clockwise (left forward); then stops and hands the drive back
+ */
+void testGoalAim_TurnDirectionAndLostGoal() {
+    GoalAim aim(GOAL_SIGNATURE, 0);
+    aim.addHeading(0.0, 0);
+    VisionTracker::Detection d = goalAt(20.0);
+    aim.addGoalFrame(&d, 1, 0);
+    aim.start();
+    
+    int leftPower, rightPower;
+    TestRunner::assertEqualsBool(true, aim.update(10, leftPower, rightPower), "Goal Aim - Aiming");
+    TestRunner::assertEqualsBool(true, leftPower > 0 && rightPower < 0, "Goal Aim - Goal right = turn clockwise");
+    TestRunner::assertEquals((int)(GoalAim::TURN_KP * 20.0), leftPower, "Goal Aim - Turn power from the error");
+    
+    aim.addHeading(0.0, GoalAim::GOAL_TIMEOUT_MS + 10);
+    TestRunner::assertEqualsBool(false, aim.update(GoalAim::GOAL_TIMEOUT_MS + 10, leftPower, rightPower),
+                                 "Goal Aim - Lost goal ends the aim");
+    TestRunner::assertEqualsBool(true, leftPower == 0 && rightPower == 0, "Goal Aim - Stopped");
+    TestRunner::assertEqualsBool(false, aim.isActive(), "Goal Aim - Idle");
+}
+
+/**
+ * Test: Lock And Unlock
+ * 
+ * Given: Aiming with the robot still and 1 degree off the goal
+ * When: It stays there, then gets bumped 4 degrees
+ * Then: Locks after LOCK_TIME_MS (not before); unlocks on the bump
+ */
+void testGoalAim_LockAndUnlock() {
+    GoalAim aim(GOAL_SIGNATURE, 0);
+    aim.addHeading(0.0, 0);
+    VisionTracker::Detection d = goalAt(1.0);
+    aim.addGoalFrame(&d, 1, 0);
+    aim.start();
+    
+    int leftPower, rightPower;
+    uint32_t t = 0;
+    for (; t < GoalAim::LOCK_TIME_MS; t += 10) {
+        aim.addHeading(0.0, t);
+        aim.update(t, leftPower, rightPower);
+    }
+    TestRunner::assertEqualsBool(false, aim.isLocked(), "Goal Aim - Not locked before the settle time");
+    aim.addHeading(0.0, t);
+    aim.update(t, leftPower, rightPower);
+    TestRunner::assertEqualsBool(true, aim.isLocked(), "Goal Aim - Locked once settled on target");
+    
+    // Bumped (a new frame keeps the goal fresh)
+    aim.addGoalFrame(&d, 1, t);
+    aim.addHeading(-4.0, t + 10);
+    aim.update(t + 10, leftPower, rightPower);
+    TestRunner::assertEqualsBool(false, aim.isLocked(), "Goal Aim - Bump unlocks");
+    TestRunner::assertEqualsBool(true, leftPower > 0, "Goal Aim - Turns back after the bump");
+    
+    aim.cancel();
+    TestRunner::assertEqualsBool(false, aim.isLocked(), "Goal Aim - Not locked when cancelled");
+}
+
+/**
+ * Test: Simulated Aim
+ * 
+ * Given: Robot 25 degrees off the goal; camera frames every 20 ms, 40 ms old when read,
+ *        with pixel noise, 10% dropped frames and a ball in view
+ * When: The aim runs in the turn simulator
+ * Then: Locks within 0.5 s, less than 1.5 degrees off and without big overshoot, stays locked;
+ *       ignoring the latency overshoots more
+ */
+void testGoalAim_SimulatedAim() {
+    AimResult right = simulateAim(25.0, 40, 40, 1);
+    AimResult left = simulateAim(-25.0, 40, 40, 2);
+    AimResult naive = simulateAim(25.0, 40, 0, 1);
+    
+    std::cout << "  Aim 25 deg right: lock " << right.lockTimeMs << " ms, error " << right.errorAtLock
+              << " deg, overshoot " << right.overshoot << " deg" << std::endl;
+    std::cout << "  Aim 25 deg left:  lock " << left.lockTimeMs << " ms, error " << left.errorAtLock
+              << " deg, overshoot " << left.overshoot << " deg" << std::endl;
+    std::cout << "  Without latency compensation: lock " << naive.lockTimeMs << " ms, overshoot "
+              << naive.overshoot << " deg" << std::endl;
+    
+    TestRunner::assertEqualsBool(true, right.locked && left.locked, "Goal Aim Sim - Locks both ways");
+    TestRunner::assertTrue(right.lockTimeMs <= 500 && left.lockTimeMs <= 500, "Goal Aim Sim - Locks within 0.5 s");
+    TestRunner::assertTrue(std::fabs(right.errorAtLock) <= GoalAim::LOCK_TOLERANCE_DEG &&
+                           std::fabs(left.errorAtLock) <= GoalAim::LOCK_TOLERANCE_DEG,
+                           "Goal Aim Sim - On target when locked");
+    TestRunner::assertTrue(right.overshoot < 3.0 && left.overshoot < 3.0, "Goal Aim Sim - Little overshoot");
+    TestRunner::assertEqualsBool(true, right.stayedLocked && left.stayedLocked, "Goal Aim Sim - Stays locked");
+    TestRunner::assertTrue(naive.overshoot > right.overshoot, "Goal Aim Sim - Latency compensation reduces overshoot");
+}
+
+/**
+ * Test: Random Aims
+ * 
+ * Given: 100 goals at random offsets within the camera's view
+ * When: Each aim runs in the simulator
+ * Then: Every one locks on target
+ */
+void testGoalAim_RandomAims() {
+    int locked = 0;
+    uint32_t totalMs = 0;
+    uint32_t worstMs = 0;
+    for (unsigned int seed = 1; seed <= 100; seed++) {
+        std::srand(seed * 7919);
+        double offset = (std::rand() % 5001) / 100.0 - 25.0;
+        AimResult result = simulateAim(offset, 40, 40, seed);
+        if (result.locked && std::fabs(result.errorAtLock) <= GoalAim::LOCK_TOLERANCE_DEG) {
+            locked++;
+            totalMs += result.lockTimeMs;
+            if (result.lockTimeMs > worstMs) {
+                worstMs = result.lockTimeMs;
+            }
+        }
+    }
+    std::cout << "  Random aims: " << locked << "/100 locked, mean " << (locked ? totalMs / locked : 0)
+              << " ms, worst " << worstMs << " ms" << std::endl;
+    TestRunner::assertEquals(100, locked, "Goal Aim Sim - All random aims lock");
+}
+
+int main() {
+    std::cout << "=== Running GoalAim Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testGoalAim_HeadingHistory();
+    testGoalAim_GoalHeadingFromBearing();
+    testGoalAim_LatencyCompensation();
+    testGoalAim_ErrorBetweenFrames();
+    testGoalAim_GoalSelection();
+    testGoalAim_TurnDirectionAndLostGoal();
+    testGoalAim_LockAndUnlock();
+    testGoalAim_SimulatedAim();
+    testGoalAim_RandomAims();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,495 @@
+/*
+ * test_gpsfusion.cpp
+ * 
+ * Unit tests for GpsFusion class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include the classes under test
+#include "../src/controllers/GpsFusion.h"
+#include "../src/controllers/PoseHistory.h"
+
+// ============================================
+// SIMULATED ROBOT + GPS
+// ============================================
+
+/**
+ * Simulated drive: the robot follows a constant-speed arc, sampled every 10 ms.
+ * Odometry under-reads distance (wheel slip), the GPS reports the TRUE pose but
+ * GPS_LATENCY_MS late, and drops out for part of the run.
+ */
+namespace GpsSim {
+    const uint32_t TICK_MS = 10;
+    const uint32_t GPS_PERIOD_MS = 50;
+    const uint32_t GPS_LATENCY_MS = 120;
+    const double SPEED = 40.0;           // Inches per second
+    const double TURN_RATE = 30.0;       // Degrees per second
+    const double ODOMETRY_SCALE = 0.93;  // Odometry reads 7% short (slip)
+    
+    struct Result {
+        double finalError;  // Inches between fused and true pose at the end
+        int rejected;       // GPS fixes rejected
+    };
+    
+    double distance(const Odometry::Pose& a, const Odometry::Pose& b) {
+        return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    }
+    
+    /**
+     * Run the simulation
+     * 
+     * @param fusion Filter under test
+     * @param compensateLatency If false, fixes are applied as if measured when received
+     * @param useGps If false, no fixes are applied (pure odometry)
+     * @param dropoutStartMs Start of GPS dropout window
+     * @param dropoutEndMs End of GPS dropout window
+     * @param durationMs Length of the run
+     */
+    Result run(GpsFusion& fusion, bool compensateLatency, bool useGps,
+               uint32_t dropoutStartMs, uint32_t dropoutEndMs, uint32_t durationMs) {
+        // Ring of true poses so the GPS can report the pose from GPS_LATENCY_MS ago
+        const int TRUE_HISTORY = 64;
+        Odometry::Pose truePoses[TRUE_HISTORY];
+        Odometry::Pose truePose = {0.0, 0.0, 0.0};
+        truePoses[0] = truePose;
+        fusion.reset(0, truePose, 0.0);
+        
+        for (uint32_t now = TICK_MS; now <= durationMs; now += TICK_MS) {
+            double step = SPEED * TICK_MS / 1000.0;
+            double heading = truePose.heading + TURN_RATE * TICK_MS / 1000.0;
+            truePose = Odometry::integrate(truePose, step, heading);
+            truePoses[(now / TICK_MS) % TRUE_HISTORY] = truePose;
+            
+            // Gyro is exact here; only the drive distance is wrong
+            fusion.updateOdometry(now, step * ODOMETRY_SCALE, heading);
+            
+            // A fix measured at (now - latency) is delivered now
+            if (useGps && now >= GPS_LATENCY_MS && now % GPS_PERIOD_MS == 0) {
+                uint32_t measuredAt = now - GPS_LATENCY_MS;
+                Odometry::Pose gpsPose = truePoses[(measuredAt / TICK_MS) % TRUE_HISTORY];
+                int quality = (measuredAt >= dropoutStartMs && measuredAt < dropoutEndMs) ? 30 : 100;
+                uint32_t appliedAt = compensateLatency ? measuredAt : now;
+                fusion.applyGpsFix(appliedAt, gpsPose, quality);
+            }
+        }
+        
+        Result result;
+        result.finalError = distance(fusion.getPose(), truePose);
+        result.rejected = fusion.getRejectedFixCount();
+        return result;
+    }
+}
+
+// ============================================
+// TEST CASES FOR POSE HISTORY
+// ============================================
+
+PoseHistory::Entry makeEntry(uint32_t timestampMs, double x) {
+    PoseHistory::Entry entry = {timestampMs, {x, 0.0, 0.0}, 0.0, 0.0};
+    return entry;
+}
+
+/**
+ * Test: Pose History - Empty Lookup
+ * 
+ * Given: Empty history
+ * When: Look up any time
+ * Then: Should return -1 (not found)
+ */
+void testPoseHistory_EmptyLookup() {
+    PoseHistory history;
+    TestRunner::assertEquals(-1, history.findAtOrBefore(100), "Pose History - Empty history finds nothing");
+}
+
+/**
+ * Test: Pose History - Exact and In-Between Lookups
+ * 
+ * Given: Entries at 0, 10, 20, ... 90 ms
+ * When: Look up 30 ms and 35 ms
+ * Then: Both should find the 30 ms entry (index 3)
+ */
+void testPoseHistory_Lookup() {
+    PoseHistory history;
+    for (int i = 0; i < 10; i++) {
+        history.add(makeEntry(i * 10, i));
+    }
+    TestRunner::assertEquals(3, history.findAtOrBefore(30), "Pose History - Exact timestamp found");
+    TestRunner::assertEquals(3, history.findAtOrBefore(35), "Pose History - Between entries finds earlier one");
+    TestRunner::assertEquals(9, history.findAtOrBefore(500), "Pose History - Future time finds newest");
+}
+
+/**
+ * Test: Pose History - Older Than History
+ */
+void testPoseHistory_TooOld() {
+    PoseHistory history;
+    history.add(makeEntry(100, 0.0));
+    TestRunner::assertEquals(-1, history.findAtOrBefore(50), "Pose History - Time before oldest entry not found");
+}
+
+/**
+ * Test: Pose History - Ring Wraparound
+ * 
+ * Given: More entries than CAPACITY added
+ * When: Check size, oldest entry and lookups
+ * Then: Oldest entries are overwritten, lookup still works across the wrap point
+ */
+void testPoseHistory_Wraparound() {
+    PoseHistory history;
+    int total = PoseHistory::CAPACITY + 20;
+    for (int i = 0; i < total; i++) {
+        history.add(makeEntry(i * 10, i));
+    }
+    TestRunner::assertEquals(PoseHistory::CAPACITY, history.size(), "Pose History - Size capped at CAPACITY");
+    TestRunner::assertEquals(200, static_cast<int>(history.at(0).timestampMs), "Pose History - Oldest entries overwritten");
+    TestRunner::assertEquals(-1, history.findAtOrBefore(150), "Pose History - Overwritten time not found");
+    
+    int index = history.findAtOrBefore(1005);
+    TestRunner::assertEquals(1000, static_cast<int>(history.at(index).timestampMs),
+                             "Pose History - Lookup across wrap point");
+}
+
+// ============================================
+// TEST CASES FOR GPS FUSION
+// ============================================
+
+/**
+ * Test: First Fix Initializes Pose
+ * 
+ * Given: Filter never reset
+ * When: First good GPS fix arrives
+ * Then: Pose snaps to the GPS pose
+ */
+void testGpsFusion_FirstFixInitializes() {
+    GpsFusion fusion;
+    fusion.updateOdometry(0, 0.0, 0.0);
+    Odometry::Pose gpsPose = {-48.0, 24.0, 90.0};
+    
+    GpsFusion::FixResult result = fusion.applyGpsFix(0, gpsPose, 100);
+    
+    TestRunner::assertEquals(GpsFusion::INITIALIZED, result, "GPS Fusion - First fix initializes");
+    TestRunner::assertNear(-48.0, fusion.getPose().x, 1e-9, "GPS Fusion - Initial x from GPS");
+    TestRunner::assertNear(90.0, fusion.getPose().heading, 1e-9, "GPS Fusion - Initial heading from GPS");
+}
+
+/**
+ * Test: Low Quality Fix Rejected
+ */
+void testGpsFusion_LowQualityRejected() {
+    GpsFusion fusion;
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    Odometry::Pose gpsPose = {5.0, 5.0, 0.0};
+    
+    GpsFusion::FixResult result = fusion.applyGpsFix(0, gpsPose, GpsFusion::MIN_GPS_QUALITY - 1);
+    
+    TestRunner::assertEquals(GpsFusion::REJECTED_LOW_QUALITY, result, "GPS Fusion - Low quality rejected");
+    TestRunner::assertNear(0.0, fusion.getPose().x, 1e-9, "GPS Fusion - Rejected fix leaves pose alone");
+}
+
+/**
+ * Test: Outlier Rejected
+ */
+void testGpsFusion_OutlierRejected() {
+    GpsFusion fusion;
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    Odometry::Pose gpsPose = {GpsFusion::MAX_CORRECTION + 10.0, 0.0, 0.0};
+    
+    GpsFusion::FixResult result = fusion.applyGpsFix(0, gpsPose, 100);
+    TestRunner::assertEquals(GpsFusion::REJECTED_OUTLIER, result, "GPS Fusion - Large jump rejected");
+}
+
+/**
+ * Test: Recovers After Being Bumped
+ * 
+ * Given: Robot driving along +y, shoved 20 inches sideways (odometry doesn't see it)
+ * When: Every fix after that reports the real pose
+ * Then: The first OUTLIER_RECOVERY_COUNT - 1 are rejected, the next re-snaps the pose
+ */
+void testGpsFusion_RecoversAfterBump() {
+    GpsFusion fusion;
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    
+    int rejected = 0;
+    GpsFusion::FixResult result = GpsFusion::APPLIED;
+    for (uint32_t tick = 1; tick <= 10 * GpsFusion::OUTLIER_RECOVERY_COUNT; tick++) {
+        fusion.updateOdometry(tick * 10, 0.5, 0.0);
+        if (tick % 10 == 0) {
+            Odometry::Pose gpsPose = {20.0, tick * 0.5, 0.0};
+            result = fusion.applyGpsFix(tick * 10, gpsPose, 100);
+            rejected += (result == GpsFusion::REJECTED_OUTLIER) ? 1 : 0;
+        }
+    }
+    
+    TestRunner::assertEquals(GpsFusion::OUTLIER_RECOVERY_COUNT - 1, rejected, "GPS Fusion - Outliers rejected at first");
+    TestRunner::assertEquals(GpsFusion::RECOVERED, result, "GPS Fusion - Agreeing outliers re-snap");
+    TestRunner::assertNear(20.0, fusion.getPose().x, 1e-6, "GPS Fusion - Pose back on the GPS");
+    
+    // Back to normal afterwards
+    fusion.updateOdometry(510, 0.5, 0.0);
+    Odometry::Pose gpsPose = {20.5, 25.5, 0.0};
+    TestRunner::assertEquals(GpsFusion::APPLIED, fusion.applyGpsFix(510, gpsPose, 100), "GPS Fusion - Normal fixes after recovery");
+}
+
+/**
+ * Test: Scattered Outliers Never Recover
+ * 
+ * Given: A robot standing still
+ * When: Many outliers arrive that disagree with each other (reflections)
+ * Then: All rejected, the pose stays put
+ */
+void testGpsFusion_ScatteredOutliersRejected() {
+    GpsFusion fusion;
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    
+    int rejected = 0;
+    for (uint32_t n = 1; n <= 20; n++) {
+        fusion.updateOdometry(n * 50, 0.0, 0.0);
+        double side = (n % 2 == 0) ? 1.0 : -1.0;
+        Odometry::Pose gpsPose = {side * 20.0, side * (15.0 + n), 0.0};
+        rejected += (fusion.applyGpsFix(n * 50, gpsPose, 100) == GpsFusion::REJECTED_OUTLIER) ? 1 : 0;
+    }
+    
+    TestRunner::assertEquals(20, rejected, "GPS Fusion - Disagreeing outliers all rejected");
+    TestRunner::assertNear(0.0, fusion.getPose().x, 1e-9, "GPS Fusion - Pose not moved by outliers");
+}
+
+/**
+ * Test: Stale Fix Rejected
+ */
+void testGpsFusion_StaleFixRejected() {
+    GpsFusion fusion;
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(1000, start, 0.0);
+    
+    GpsFusion::FixResult result = fusion.applyGpsFix(500, start, 100);
+    TestRunner::assertEquals(GpsFusion::REJECTED_TOO_OLD, result, "GPS Fusion - Fix older than history rejected");
+}
+
+/**
+ * Test: Late Fix Corrects Past Pose and Re-propagates
+ * 
+ * Given: Robot drove 1 inch per tick along +y for 10 ticks
+ * When: A fix from tick 5 says the robot was 2 inches further along x than odometry thought
+ * Then: The correction is carried forward to the present pose
+ */
+void testGpsFusion_RepropagatesToPresent() {
+    GpsFusion fusion(1.0, 0.0);  // Full correction makes the math easy to check
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    for (uint32_t tick = 1; tick <= 10; tick++) {
+        fusion.updateOdometry(tick * 10, 1.0, 0.0);
+    }
+    Odometry::Pose gpsPose = {2.0, 5.0, 0.0};
+    
+    GpsFusion::FixResult result = fusion.applyGpsFix(50, gpsPose, 100);
+    
+    TestRunner::assertEquals(GpsFusion::APPLIED, result, "GPS Fusion - Late fix applied");
+    TestRunner::assertNear(2.0, fusion.getPose().x, 1e-9, "GPS Fusion - x correction carried to present");
+    TestRunner::assertNear(10.0, fusion.getPose().y, 1e-9, "GPS Fusion - Odometry since fix replayed");
+}
+
+/**
+ * Test: Heading Correction Rotates Replayed Path
+ * 
+ * Given: Gyro heading is 90 degrees off, robot drove 5 inches after the fix
+ * When: A fully trusted fix corrects heading
+ * Then: The replayed 5 inches go along the corrected heading
+ */
+void testGpsFusion_HeadingCorrectionReplays() {
+    GpsFusion fusion(1.0, 1.0);
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    fusion.reset(0, start, 0.0);
+    for (uint32_t tick = 1; tick <= 5; tick++) {
+        fusion.updateOdometry(tick * 10, 1.0, 0.0);
+    }
+    Odometry::Pose gpsPose = {0.0, 0.0, 90.0};
+    
+    fusion.applyGpsFix(0, gpsPose, 100);
+    
+    TestRunner::assertNear(5.0, fusion.getPose().x, 1e-6, "GPS Fusion - Replayed steps follow corrected heading");
+    TestRunner::assertNear(0.0, fusion.getPose().y, 1e-6, "GPS Fusion - No travel along old heading");
+    TestRunner::assertNear(90.0, fusion.getPose().heading, 1e-6, "GPS Fusion - Present heading corrected");
+}
+
+/**
+ * Test: Simulated Delay - Latency Compensation Beats Naive Fusion
+ * 
+ * Given: 120 ms GPS latency, odometry reading 7% short, 6 second arc drive
+ * When: Run with odometry only, naive fusion (fix applied as if current), and compensated fusion
+ * Then: Compensated fusion has the smallest error and stays within 1 inch
+ */
+void testGpsFusion_SimulatedDelay() {
+    GpsFusion odometryOnly;
+    GpsFusion naive;
+    GpsFusion compensated;
+    
+    GpsSim::Result odometryResult = GpsSim::run(odometryOnly, true, false, 0, 0, 6000);
+    GpsSim::Result naiveResult = GpsSim::run(naive, false, true, 0, 0, 6000);
+    GpsSim::Result compensatedResult = GpsSim::run(compensated, true, true, 0, 0, 6000);
+    
+    std::cout << "  Final error (in): odometry " << odometryResult.finalError
+              << ", naive " << naiveResult.finalError
+              << ", compensated " << compensatedResult.finalError << std::endl;
+    
+    TestRunner::assertTrue(compensatedResult.finalError < naiveResult.finalError,
+                           "GPS Fusion - Latency compensation beats naive fusion");
+    TestRunner::assertTrue(compensatedResult.finalError < odometryResult.finalError,
+                           "GPS Fusion - Fusion beats odometry alone");
+    TestRunner::assertTrue(compensatedResult.finalError < 1.0,
+                           "GPS Fusion - Compensated error under 1 inch");
+}
+
+/**
+ * Test: Simulated Dropout - Odometry Bridges the Gap, GPS Recovers It
+ * 
+ * Given: GPS drops out from 2.0 s to 3.5 s
+ * When: Run 6 seconds with latency compensation
+ * Then: Dropout fixes are rejected and the pose re-converges after the dropout
+ */
+void testGpsFusion_SimulatedDropout() {
+    GpsFusion fusion;
+    GpsSim::Result result = GpsSim::run(fusion, true, true, 2000, 3500, 6000);
+    
+    std::cout << "  Dropout run: final error " << result.finalError
+              << " in, rejected fixes " << result.rejected << std::endl;
+    
+    TestRunner::assertEquals(30, result.rejected, "GPS Fusion - Every fix in the dropout window rejected");
+    TestRunner::assertTrue(result.finalError < 1.0, "GPS Fusion - Pose re-converges after dropout");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running GpsFusion Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Pose history
+    testPoseHistory_EmptyLookup();
+    testPoseHistory_Lookup();
+    testPoseHistory_TooOld();
+    testPoseHistory_Wraparound();
+    
+    // Fusion
+    testGpsFusion_FirstFixInitializes();
+    testGpsFusion_LowQualityRejected();
+    testGpsFusion_OutlierRejected();
+    testGpsFusion_RecoversAfterBump();
+    testGpsFusion_ScatteredOutliersRejected();
+    testGpsFusion_StaleFixRejected();
+    testGpsFusion_RepropagatesToPresent();
+    testGpsFusion_HeadingCorrectionReplays();
+    testGpsFusion_SimulatedDelay();
+    testGpsFusion_SimulatedDropout();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
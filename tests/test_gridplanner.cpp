@@ -0,0 +1,301 @@
+/*
+ * test_gridplanner.cpp
+ * 
+ * Unit tests for GridPlanner class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our GridPlanner class to test it
+#include "../src/controllers/GridPlanner.h"
+
+typedef GridPlanner::Point Point;
+
+Point at(double x, double y) {
+    Point p;
+    p.x = x;
+    p.y = y;
+    return p;
+}
+
+/**
+ * Run a search to the end with a per-call budget
+ * 
+ * @param calls Output: step() calls it took
+ */
+GridPlanner::Status runSearch(GridPlanner& planner, Point from, Point to, int budget, int& calls) {
+    planner.start(from, to);
+    calls = 0;
+    GridPlanner::Status status = GridPlanner::SEARCHING;
+    while (status == GridPlanner::SEARCHING && calls < 10000) {
+        status = planner.step(budget);
+        calls++;
+    }
+    return status;
+}
+
+/**
+ * Closest the path (robot position + waypoints) comes to a point (sampled every 0.5")
+ */
+double closestApproach(const GridPlanner& planner, Point from, Point obstacle) {
+    double closest = 1e9;
+    Point a = from;
+    for (int i = 0; i < planner.getWaypointCount(); i++) {
+        Point b = planner.getWaypoint(i);
+        double length = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+        int samples = (int)(length / 0.5) + 1;
+        for (int s = 0; s <= samples; s++) {
+            double x = a.x + (b.x - a.x) * s / samples;
+            double y = a.y + (b.y - a.y) * s / samples;
+            closest = std::fmin(closest, std::sqrt((x - obstacle.x) * (x - obstacle.x) + (y - obstacle.y) * (y - obstacle.y)));
+        }
+        a = b;
+    }
+    return closest;
+}
+
+// ============================================
+// TEST CASES FOR GRID PLANNER
+// ============================================
+
+/**
+ * Test: Open Field
+ * 
+ * Given: Nothing on the field
+ * When: Planning across it
+ * Then: One waypoint, the goal itself (a straight line)
+ */
+void testGrid_OpenFieldIsStraight() {
+    GridPlanner planner;
+    int calls;
+    GridPlanner::Status status = runSearch(planner, at(-40, -40), at(35, 20), 1000, calls);
+    
+    TestRunner::assertEquals(GridPlanner::FOUND, status, "Grid - Path found");
+    TestRunner::assertEquals(1, planner.getWaypointCount(), "Grid - Straight line: goal only");
+    TestRunner::assertNear(35.0, planner.getWaypoint(0).x, 1e-9, "Grid - Ends exactly at the goal (x)");
+    TestRunner::assertNear(20.0, planner.getWaypoint(0).y, 1e-9, "Grid - Ends exactly at the goal (y)");
+}
+
+/**
+ * Test: Around An Obstacle
+ * 
+ * Given: A robot-sized obstacle right between start and goal
+ * When: Planning
+ * Then: The path bends around it, keeping the robot's center a robot radius away
+ */
+void testGrid_AroundObstacle() {
+    GridPlanner planner;
+    Point obstacle = at(0, 0);
+    planner.addObstacle(obstacle, 9.0);
+    int calls;
+    GridPlanner::Status status = runSearch(planner, at(0, -40), at(0, 40), 1000, calls);
+    
+    TestRunner::assertEquals(GridPlanner::FOUND, status, "Grid - Detour found");
+    TestRunner::assertTrue(planner.getWaypointCount() >= 2, "Grid - Detour has a corner");
+    TestRunner::assertTrue(closestApproach(planner, at(0, -40), obstacle) >= 9.0 + GridPlanner::ROBOT_RADIUS - 3.0,
+                           "Grid - Path keeps clear of the obstacle (within half a cell)");
+    TestRunner::assertTrue(planner.isBlocked(obstacle), "Grid - Obstacle is blocked");
+    
+    planner.clearObstacles();
+    TestRunner::assertEqualsBool(false, planner.isBlocked(obstacle), "Grid - Cleared");
+    TestRunner::assertEqualsBool(true, planner.isBlocked(at(70, 0)), "Grid - Walls stay");
+}
+
+/**
+ * Test: No Path
+ * 
+ * Given: A goal inside an obstacle, then a goal walled in by a ring of obstacles
+ * When: Planning
+ * Then: NO_PATH both times (the first right away)
+ */
+void testGrid_NoPath() {
+    GridPlanner planner;
+    planner.addObstacle(at(30, 30), 6.0);
+    planner.start(at(-30, -30), at(30, 30));
+    TestRunner::assertEquals(GridPlanner::NO_PATH, planner.getStatus(), "Grid - Goal inside an obstacle");
+    
+    planner.clearObstacles();
+    for (int i = 0; i < 16; i++) {
+        double angle = i * 2.0 * 3.14159265358979 / 16;
+        planner.addObstacle(at(30 + 22 * std::cos(angle), 30 + 22 * std::sin(angle)), 3.0);
+    }
+    int calls;
+    GridPlanner::Status status = runSearch(planner, at(-30, -30), at(30, 30), 1000, calls);
+    TestRunner::assertEquals(GridPlanner::NO_PATH, status, "Grid - Walled-in goal");
+}
+
+/**
+ * Test: Incremental Search
+ * 
+ * Given: A detour search
+ * When: Run with a budget of 20 cells per call, then all at once
+ * Then: Same path; no call expands more than its budget; it took several calls
+ */
+void testGrid_IncrementalMatchesAllAtOnce() {
+    GridPlanner small;
+    GridPlanner large;
+    for (int i = -3; i <= 3; i++) {
+        small.addObstacle(at(i * 6.0, 0), 4.0);
+        large.addObstacle(at(i * 6.0, 0), 4.0);
+    }
+    
+    small.start(at(5, -40), at(-5, 40));
+    int calls = 0;
+    bool withinBudget = true;
+    while (small.getStatus() == GridPlanner::SEARCHING) {
+        int before = small.getExpansions();
+        small.step(20);
+        withinBudget = withinBudget && small.getExpansions() - before <= 20;
+        calls++;
+    }
+    int largeCalls;
+    runSearch(large, at(5, -40), at(-5, 40), 100000, largeCalls);
+    
+    TestRunner::assertEquals(GridPlanner::FOUND, small.getStatus(), "Grid Incremental - Found");
+    TestRunner::assertTrue(withinBudget, "Grid Incremental - Each call within its budget");
+    TestRunner::assertTrue(calls >= 3, "Grid Incremental - Spread over several calls");
+    TestRunner::assertEquals(1, largeCalls, "Grid Incremental - One call with a big budget");
+    TestRunner::assertEquals(large.getWaypointCount(), small.getWaypointCount(), "Grid Incremental - Same path length");
+    bool same = true;
+    for (int i = 0; i < small.getWaypointCount(); i++) {
+        same = same && small.getWaypoint(i).x == large.getWaypoint(i).x && small.getWaypoint(i).y == large.getWaypoint(i).y;
+    }
+    TestRunner::assertTrue(same, "Grid Incremental - Same waypoints");
+}
+
+/**
+ * Test: Start And Goal Cells
+ * 
+ * Given: A robot pressed against an obstacle (its cell is covered), and a goal next to a wall
+ * When: Planning
+ * Then: Both are allowed: the robot plans its way out, the goal by the wall is reached
+ */
+void testGrid_StartInObstacleGoalByWall() {
+    GridPlanner planner;
+    planner.addObstacle(at(0, 10), 9.0);
+    TestRunner::assertEqualsBool(true, planner.isBlocked(at(0, -6)), "Grid - Robot's cell covered by the obstacle");
+    TestRunner::assertEqualsBool(true, planner.isBlocked(at(0, 70)), "Grid - Goal by the wall");
+    
+    int calls;
+    GridPlanner::Status status = runSearch(planner, at(0, -6), at(0, 70), 1000, calls);
+    TestRunner::assertEquals(GridPlanner::FOUND, status, "Grid - Plans out of a covered cell to a wall goal");
+}
+
+int main() {
+    std::cout << "=== Running GridPlanner Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testGrid_OpenFieldIsStraight();
+    testGrid_AroundObstacle();
+    testGrid_NoPath();
+    testGrid_IncrementalMatchesAllAtOnce();
+    testGrid_StartInObstacleGoalByWall();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
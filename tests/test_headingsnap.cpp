@@ -0,0 +1,365 @@
+/*
+ * test_headingsnap.cpp
+ * 
+ * Unit tests for HeadingSnap class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our HeadingSnap class to test it
+#include "../src/controllers/HeadingSnap.h"
+
+// ============================================
+// TURN SIMULATOR
+// ============================================
+
+/**
+ * Simple drivetrain turning model
+ * Turn rate follows the commanded power with a first-order lag (motor + robot inertia),
+ * the gyro reports the heading. Runs at the usercontrol() tick (20 ms).
+ */
+struct TurnSim {
+    double heading;    // Degrees, compass (clockwise positive)
+    double turned;     // Total degrees turned (unwrapped)
+    double rate;       // Degrees per second
+    double maxRate;    // Turn rate at 100% power
+    double lagSeconds; // Time constant
+    
+    TurnSim(double startHeading)
+        : heading(startHeading), turned(0.0), rate(0.0), maxRate(450.0), lagSeconds(0.08) {
+    }
+    
+    void step(int leftPower, int rightPower, double dt) {
+        double commanded = (leftPower - rightPower) / 2.0 / 100.0 * maxRate;
+        rate += (commanded - rate) * (dt / lagSeconds);
+        heading += rate * dt;
+        turned += rate * dt;
+        while (heading >= 360.0) heading -= 360.0;
+        while (heading < 0.0) heading += 360.0;
+    }
+};
+
+/**
+ * Result of one simulated snap
+ */
+struct SnapResult {
+    uint32_t turnTimeMs;   // Until the snap handed control back
+    double overshoot;      // Worst degrees past the target (in the turn direction)
+    double finalError;     // Degrees from the target at the end
+};
+
+const uint32_t TICK_MS = 20;
+
+/**
+ * Run a relative snap in the simulator until it finishes (or 3 s)
+ */
+SnapResult simulateSnap(double startHeading, double turn) {
+    TurnSim sim(startHeading);
+    HeadingSnap snap;
+    uint32_t now = 0;
+    snap.startRelative(sim.heading, turn, now);
+    
+    double direction = (turn < 0.0) ? -1.0 : 1.0;
+
+    SnapResult result;
+    result.overshoot = 0.0;
+    
+    int leftPower = 0, rightPower = 0;
+    while (snap.update(sim.heading, now, leftPower, rightPower) && now < 3000) {
+        sim.step(leftPower, rightPower, TICK_MS / 1000.0);
+        now += TICK_MS;
+        
+        // Past the target in the turn direction = overshoot
+        double past = direction * sim.turned - std::fabs(turn);
+        if (past > result.overshoot) {
+            result.overshoot = past;
+        }
+    }
+    
+    double error = snap.getTarget() - sim.heading;
+    while (error > 180.0) error -= 360.0;
+    while (error <= -180.0) error += 360.0;
+    result.turnTimeMs = now;
+    result.finalError = error;
+    return result;
+}
+
+// ============================================
+// TEST CASES FOR HEADING SNAP
+// ============================================
+
+/**
+ * Test: Nearest Preset
+ * Given: Headings near each multiple of 90
+ * When: nearestPreset() is called
+ * Then: The closest of 0/90/180/270 is returned
+ */
+void testHeadingSnap_NearestPreset() {
+    TestRunner::assertNear(0.0, HeadingSnap::nearestPreset(10.0), 0.001, "Heading Snap - 10 snaps to 0");
+    TestRunner::assertNear(0.0, HeadingSnap::nearestPreset(350.0), 0.001, "Heading Snap - 350 snaps to 0");
+    TestRunner::assertNear(90.0, HeadingSnap::nearestPreset(100.0), 0.001, "Heading Snap - 100 snaps to 90");
+    TestRunner::assertNear(270.0, HeadingSnap::nearestPreset(-80.0), 0.001, "Heading Snap - -80 snaps to 270");
+}
+
+/**
+ * Test: Profile Shape
+ * Given: A 90 degree turn
+ * When: The profile is sampled
+ * Then: It starts and ends at rest, ends at the full angle, never exceeds the max rate
+ */
+void testHeadingSnap_ProfileShape() {
+    double angle = 90.0;
+    uint32_t duration = HeadingSnap::profileDurationMs(angle);
+    double position, rate;
+    
+    HeadingSnap::profileAt(angle, 0.0, position, rate);
+    TestRunner::assertNear(0.0, rate, 0.001, "Heading Snap - Profile starts at rest");
+    
+    HeadingSnap::profileAt(angle, duration / 1000.0, position, rate);
+    TestRunner::assertNear(90.0, position, 0.01, "Heading Snap - Profile ends at the full angle");
+    TestRunner::assertNear(0.0, rate, 0.5, "Heading Snap - Profile ends at rest");
+    
+    bool withinLimit = true;
+    for (uint32_t t = 0; t <= duration; t += 5) {
+        HeadingSnap::profileAt(angle, t / 1000.0, position, rate);
+        if (std::fabs(rate) > HeadingSnap::MAX_TURN_RATE + 0.001) {
+            withinLimit = false;
+        }
+    }
+    TestRunner::assertEqualsBool(true, withinLimit, "Heading Snap - Profile stays under max rate");
+    
+    HeadingSnap::profileAt(-90.0, duration / 2000.0, position, rate);
+    TestRunner::assertEqualsBool(true, position < 0.0 && rate < 0.0, "Heading Snap - Negative turns run backward");
+}
+
+/**
+ * Test: Turn Direction
+ * Given: A snap clockwise
+ * When: update() is called at the start
+ * Then: Left drive forward, right drive backward
+ */
+void testHeadingSnap_TurnDirection() {
+    HeadingSnap snap;
+    int leftPower, rightPower;
+    snap.startRelative(0.0, 90.0, 0);
+    snap.update(0.0, 100, leftPower, rightPower);
+    TestRunner::assertEqualsBool(true, leftPower > 0 && rightPower < 0, "Heading Snap - Clockwise = left forward");
+    TestRunner::assertEquals(-leftPower, rightPower, "Heading Snap - Turns in place");
+}
+
+/**
+ * Test: Simulated 90 Degree Turn
+ * Given: The turn simulator
+ * When: Snapping 90 degrees clockwise
+ * Then: Settles within tolerance, quickly, with little overshoot
+ */
+void testHeadingSnap_Sim90() {
+    SnapResult result = simulateSnap(0.0, 90.0);
+    std::cout << "  90 deg: " << result.turnTimeMs << " ms, overshoot " << result.overshoot
+              << " deg, final error " << result.finalError << " deg" << std::endl;
+    TestRunner::assertNear(0.0, result.finalError, HeadingSnap::SETTLE_TOLERANCE, "Heading Snap - 90 deg ends on target");
+    TestRunner::assertEqualsBool(true, result.turnTimeMs <= 700, "Heading Snap - 90 deg in under 0.7 s");
+    TestRunner::assertEqualsBool(true, result.overshoot <= 3.0, "Heading Snap - 90 deg overshoot under 3 deg");
+}
+
+/**
+ * Test: Simulated 180 Degree Turn Across North
+ * Given: Robot at 300 degrees
+ * When: Snapping 180 degrees counter-clockwise (through 0)
+ * Then: Ends at 120 degrees without flipping direction halfway
+ */
+void testHeadingSnap_Sim180() {
+    SnapResult result = simulateSnap(300.0, -180.0);
+    std::cout << "  180 deg: " << result.turnTimeMs << " ms, overshoot " << result.overshoot
+              << " deg, final error " << result.finalError << " deg" << std::endl;
+    TestRunner::assertNear(0.0, result.finalError, HeadingSnap::SETTLE_TOLERANCE, "Heading Snap - 180 deg ends on target");
+    TestRunner::assertEqualsBool(true, result.turnTimeMs <= 1000, "Heading Snap - 180 deg in under 1 s");
+    TestRunner::assertEqualsBool(true, result.overshoot <= 3.0, "Heading Snap - 180 deg overshoot under 3 deg");
+}
+
+/**
+ * Test: Absolute Target
+ * Given: Robot at 350 degrees
+ * When: start() to heading 20
+ * Then: Turns the short way (clockwise 30 degrees)
+ */
+void testHeadingSnap_AbsoluteShortWay() {
+    HeadingSnap snap;
+    int leftPower, rightPower;
+    snap.start(350.0, 20.0, 0);
+    snap.update(350.0, 60, leftPower, rightPower);
+    TestRunner::assertNear(20.0, snap.getTarget(), 0.001, "Heading Snap - Absolute target kept");
+    TestRunner::assertEqualsBool(true, leftPower > 0, "Heading Snap - Short way is clockwise");
+}
+
+/**
+ * Test: Chained Presses
+ * Given: A 90 degree snap in progress
+ * When: Another +90 is requested
+ * Then: The target becomes 180 from the original heading
+ */
+void testHeadingSnap_Chained() {
+    HeadingSnap snap;
+    snap.startRelative(0.0, 90.0, 0);
+    snap.startRelative(30.0, 90.0, 200);
+    TestRunner::assertNear(180.0, snap.getTarget(), 0.001, "Heading Snap - Second press adds to the target");
+}
+
+/**
+ * Test: Cancel
+ * Given: A snap in progress
+ * When: cancel() is called (driver moved a stick)
+ * Then: update() returns false and zero powers immediately
+ */
+void testHeadingSnap_Cancel() {
+    HeadingSnap snap;
+    int leftPower, rightPower;
+    snap.startRelative(0.0, 90.0, 0);
+    TestRunner::assertEqualsBool(true, snap.update(0.0, 20, leftPower, rightPower), "Heading Snap - Running");
+    snap.cancel();
+    TestRunner::assertEqualsBool(false, snap.isActive(), "Heading Snap - Cancelled");
+    TestRunner::assertEqualsBool(false, snap.update(10.0, 40, leftPower, rightPower), "Heading Snap - No output after cancel");
+    TestRunner::assertEquals(0, leftPower, "Heading Snap - Zero power after cancel");
+}
+
+/**
+ * Test: Timeout
+ * Given: A robot that can't turn (heading never changes)
+ * When: The snap runs long past its profile
+ * Then: It gives up instead of fighting forever
+ */
+void testHeadingSnap_Timeout() {
+    HeadingSnap snap;
+    int leftPower, rightPower;
+    snap.startRelative(0.0, 90.0, 0);
+    uint32_t limit = HeadingSnap::profileDurationMs(90.0) + HeadingSnap::TIMEOUT_MARGIN_MS;
+    TestRunner::assertEqualsBool(true, snap.update(0.0, limit - 20, leftPower, rightPower), "Heading Snap - Still trying before timeout");
+    TestRunner::assertEqualsBool(false, snap.update(0.0, limit, leftPower, rightPower), "Heading Snap - Gives up at timeout");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running HeadingSnap Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testHeadingSnap_NearestPreset();
+    testHeadingSnap_ProfileShape();
+    testHeadingSnap_TurnDirection();
+    testHeadingSnap_Sim90();
+    testHeadingSnap_Sim180();
+    testHeadingSnap_AbsoluteShortWay();
+    testHeadingSnap_Chained();
+    testHeadingSnap_Cancel();
+    testHeadingSnap_Timeout();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
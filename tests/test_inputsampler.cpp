@@ -0,0 +1,335 @@
+/*
+ * test_inputsampler.cpp
+ * 
+ * Unit tests for InputSampler class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our InputSampler class to test it
+#include "../src/controllers/InputSampler.h"
+#include "../src/controllers/LatencyStats.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+const int CENTERED[InputSampler::AXIS_COUNT] = {0, 0, 0, 0};
+
+/**
+ * Simple repeatable pseudo-random numbers (same sequence every run)
+ */
+uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+/**
+ * Input-to-actuation latency simulation
+ * 
+ * The driver presses/releases a button at random times. The Brain sees the change when
+ * the next radio packet arrives (every PACKET_US). Latency is measured from that moment
+ * (the earliest the robot could know) to the motor command.
+ * 
+ * eventDriven = false: the old loop - read the controller at the top of a fixed 20 ms tick
+ * eventDriven = true:  input task samples every 2 ms, control loop wakes within 1 ms of a change
+ */
+LatencyStats simulateLatency(bool eventDriven) {
+    const uint32_t STEP_US = 100;
+    const uint32_t PACKET_US = 9000;      // Not a multiple of the tick, so every phase occurs
+    const uint32_t PACKET_OFFSET_US = 3700;
+    const uint32_t TICK_US = 20000;
+    const uint32_t INPUT_PERIOD_US = 2000;
+    const uint32_t POLL_US = 1000;
+    const uint32_t COMPUTE_US = 1000;
+    const uint32_t DURATION_US = 20000000;
+    
+    LatencyStats stats(250);
+    InputSampler sampler;
+    uint32_t random = 12345;
+    
+    uint16_t truth = 0;                     // What the driver is doing
+    uint32_t nextChangeUs = 50000;
+    uint16_t visible = 0;                   // What the Brain has received
+    uint32_t visibleSinceUs = 0;
+    uint16_t acted = 0;                     // What the motors were last told
+    uint32_t lastTickUs = 0;
+    
+    for (uint32_t t = 0; t < DURATION_US; t += STEP_US) {
+        if (t >= nextChangeUs) {
+            truth ^= InputSampler::buttonBit(InputSampler::BUTTON_R1);
+            nextChangeUs = t + 60000 + nextRandom(random) % 200000;
+        }
+        if (t % PACKET_US == PACKET_OFFSET_US && visible != truth) {
+            visible = truth;
+            visibleSinceUs = t;
+        }
+        
+        if (!eventDriven) {
+            if (t % TICK_US == 0 && visible != acted) {
+                acted = visible;
+                stats.add(t + COMPUTE_US - visibleSinceUs);
+            }
+            continue;
+        }
+        
+        if (t % INPUT_PERIOD_US == 0) {
+            sampler.sample(CENTERED, visible, t);
+        }
+        bool wake = (t % POLL_US == 0 && sampler.hasNew()) || (t - lastTickUs >= TICK_US);
+        if (wake) {
+            lastTickUs = t;
+            InputSampler::Snapshot snapshot;
+            if (sampler.read(snapshot) && snapshot.buttons != acted) {
+                acted = snapshot.buttons;
+                stats.add(t + COMPUTE_US - visibleSinceUs);
+            }
+        }
+    }
+    return stats;
+}
+
+// ============================================
+// TEST CASES FOR TRIPLE BUFFER
+// ============================================
+
+/**
+ * Test: Triple Buffer Latest Value
+ * Given: Several writes before a read
+ * When: read() is called
+ * Then: Only the newest value is returned, marked new once
+ */
+void testTripleBuffer_Latest() {
+    TripleBuffer<int> buffer;
+    int value = -1;
+    TestRunner::assertEqualsBool(false, buffer.read(value), "Triple Buffer - Nothing new at start");
+    
+    buffer.write(1);
+    buffer.write(2);
+    buffer.write(3);
+    TestRunner::assertEqualsBool(true, buffer.hasNew(), "Triple Buffer - Has new after write");
+    TestRunner::assertEqualsBool(true, buffer.read(value), "Triple Buffer - Read is new");
+    TestRunner::assertEquals(3, value, "Triple Buffer - Newest value wins");
+    
+    TestRunner::assertEqualsBool(false, buffer.read(value), "Triple Buffer - Second read not new");
+    TestRunner::assertEquals(3, value, "Triple Buffer - Second read keeps the value");
+}
+
+/**
+ * Test: Triple Buffer Interleaved
+ * Given: Writes and reads alternating
+ * When: Many rounds
+ * Then: Every read sees the value just written (no copy is lost or reused)
+ */
+void testTripleBuffer_Interleaved() {
+    TripleBuffer<int> buffer;
+    bool allMatch = true;
+    for (int i = 0; i < 100; i++) {
+        buffer.write(i);
+        if (i % 3 == 0) {
+            buffer.write(i + 1000);  // Extra write the reader never sees
+            buffer.write(i);
+        }
+        int value;
+        if (!buffer.read(value) || value != i) {
+            allMatch = false;
+        }
+    }
+    TestRunner::assertEqualsBool(true, allMatch, "Triple Buffer - Reads always see the latest write");
+}
+
+// ============================================
+// TEST CASES FOR INPUT SAMPLER
+// ============================================
+
+/**
+ * Test: Button Bits
+ * Given: A snapshot with R1 and A held
+ * When: Checking buttons
+ * Then: Only those two report pressed
+ */
+void testInputSampler_Buttons() {
+    InputSampler::Snapshot snapshot;
+    snapshot.buttons = InputSampler::buttonBit(InputSampler::BUTTON_R1) | InputSampler::buttonBit(InputSampler::BUTTON_A);
+    TestRunner::assertEqualsBool(true, snapshot.pressed(InputSampler::BUTTON_R1), "Input Sampler - R1 pressed");
+    TestRunner::assertEqualsBool(true, snapshot.pressed(InputSampler::BUTTON_A), "Input Sampler - A pressed");
+    TestRunner::assertEqualsBool(false, snapshot.pressed(InputSampler::BUTTON_L1), "Input Sampler - L1 not pressed");
+}
+
+/**
+ * Test: Only Changes Are Published
+ * Given: The same reading sampled repeatedly
+ * When: read() is called
+ * Then: Nothing new until a stick moves; then the change time is when it was first seen
+ */
+void testInputSampler_PublishOnChange() {
+    InputSampler sampler;
+    InputSampler::Snapshot snapshot;
+    TestRunner::assertEqualsBool(false, sampler.sample(CENTERED, 0, 1000), "Input Sampler - Same reading not a change");
+    TestRunner::assertEqualsBool(false, sampler.read(snapshot), "Input Sampler - Nothing new");
+    
+    int moved[InputSampler::AXIS_COUNT] = {0, 0, 55, 0};
+    TestRunner::assertEqualsBool(true, sampler.sample(moved, 0, 3000), "Input Sampler - Stick move is a change");
+    sampler.sample(moved, 0, 5000);
+    TestRunner::assertEqualsBool(true, sampler.read(snapshot), "Input Sampler - Change published");
+    TestRunner::assertEquals(55, snapshot.axis(InputSampler::AXIS_3), "Input Sampler - Axis value");
+    TestRunner::assertEquals(3000, (int)snapshot.changedAtUs, "Input Sampler - Change time is first sighting");
+    TestRunner::assertEquals(1, (int)snapshot.sequence, "Input Sampler - Sequence counts changes");
+    TestRunner::assertEquals(3, (int)sampler.getSampleCount(), "Input Sampler - All readings counted");
+}
+
+/**
+ * Test: Latest Change Wins
+ * Given: Two changes before the control loop reads
+ * When: read() is called
+ * Then: The second change is returned
+ */
+void testInputSampler_LatestWins() {
+    InputSampler sampler;
+    InputSampler::Snapshot snapshot;
+    sampler.sample(CENTERED, InputSampler::buttonBit(InputSampler::BUTTON_X), 1000);
+    sampler.sample(CENTERED, InputSampler::buttonBit(InputSampler::BUTTON_Y), 3000);
+    sampler.read(snapshot);
+    TestRunner::assertEqualsBool(true, snapshot.pressed(InputSampler::BUTTON_Y), "Input Sampler - Latest change read");
+    TestRunner::assertEquals(2, (int)snapshot.sequence, "Input Sampler - Skipped change still counted");
+}
+
+/**
+ * Test: Input-to-Actuation Latency, Before and After
+ * Given: The same simulated button presses
+ * When: Run with the fixed 20 ms loop, then with the input task + event-driven loop
+ * Then: Event-driven mean and worst case are far lower
+ */
+void testInputSampler_LatencyBeforeAfter() {
+    LatencyStats before = simulateLatency(false);
+    LatencyStats after = simulateLatency(true);
+    std::cout << "  Before (20 ms loop):    n=" << before.getCount() << " mean " << before.getMean() / 1000.0
+              << " ms, p95 " << before.getPercentile(95) / 1000.0 << " ms, max " << before.getMax() / 1000.0 << " ms" << std::endl;
+    std::cout << "  After (input task):     n=" << after.getCount() << " mean " << after.getMean() / 1000.0
+              << " ms, p95 " << after.getPercentile(95) / 1000.0 << " ms, max " << after.getMax() / 1000.0 << " ms" << std::endl;
+    TestRunner::assertNear(before.getCount(), after.getCount(), 1.0, "Input Sampler - Same presses in both runs");
+    TestRunner::assertEqualsBool(true, after.getMean() < before.getMean() / 3.0, "Input Sampler - Mean latency cut by 3x");
+    TestRunner::assertEqualsBool(true, after.getMax() <= 4000, "Input Sampler - Worst case within 4 ms");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running InputSampler Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testTripleBuffer_Latest();
+    testTripleBuffer_Interleaved();
+    testInputSampler_Buttons();
+    testInputSampler_PublishOnChange();
+    testInputSampler_LatestWins();
+    testInputSampler_LatencyBeforeAfter();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
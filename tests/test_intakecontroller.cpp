@@ -22,6 +22,8 @@
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 
 // Simple test framework for demonstration
 class TestRunner {
@@ -54,6 +56,18 @@ public:
         }
     }
     
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
     static void printResults() {
         std::cout << "\n=== Test Results ===" << std::endl;
         std::cout << "Total: " << testTotal << std::endl;
@@ -219,6 +233,189 @@ void testClampPowerLevel_AtBoundaries() {
     TestRunner::assertEquals(100, result100, "Clamp Power - At maximum boundary (100)");
 }
 
+/**
+ * Test: Limit To Capacity
+ * 
+ * Given: The robot is full
+ * When: The driver asks for intake forward, reverse and stop
+ * Then: Forward becomes STOP; reverse and stop are unchanged (and nothing changes when not full)
+ */
+void testLimitToCapacity() {
+    TestRunner::assertEquals(IntakeController::STOP, IntakeController::limitToCapacity(IntakeController::FORWARD, true),
+                             "Capacity - Full robot stops intaking");
+    TestRunner::assertEquals(IntakeController::REVERSE, IntakeController::limitToCapacity(IntakeController::REVERSE, true),
+                             "Capacity - Full robot can still spit out");
+    TestRunner::assertEquals(IntakeController::STOP, IntakeController::limitToCapacity(IntakeController::STOP, true),
+                             "Capacity - Stop stays stop");
+    TestRunner::assertEquals(IntakeController::FORWARD, IntakeController::limitToCapacity(IntakeController::FORWARD, false),
+                             "Capacity - Intake forward when not full");
+}
+
+/**
+ * Test: Ground-Matched Intake - Surface Speed
+ * 
+ * Given: A 4" wheel at 200 rpm direct, a 2.5" roller at 200 rpm geared 3:1
+ * When: Calculate surface speeds
+ * Then: 41.9 and 78.5 inches per second
+ */
+void testSurfaceSpeed() {
+    TestRunner::assertNear(41.888, IntakeController::surfaceSpeed(200.0, 4.0, 1.0), 0.001,
+                           "Surface Speed - 4 inch wheel at 200 rpm");
+    TestRunner::assertNear(78.540, IntakeController::surfaceSpeed(200.0, 2.5, 3.0), 0.001,
+                           "Surface Speed - Geared roller");
+    TestRunner::assertNear(-41.888, IntakeController::surfaceSpeed(-200.0, 4.0, 1.0), 0.001,
+                           "Surface Speed - Backwards is negative");
+}
+
+/**
+ * Test: Ground-Matched Intake - Power
+ * 
+ * Given: A roller with 80 in/s surface speed at 100%
+ * When: The robot is stopped, driving forward, driving backwards, faster than the roller
+ * Then: Stopped runs MIN_SURFACE_SPEED; forward adds the ground speed plus the overspeed;
+ *       backwards counts as stopped; the power never passes 100; reverse and stop ignore speed
+ */
+void testGroundMatchedPower() {
+    const double maxSurface = 80.0;
+    TestRunner::assertEquals(15, IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, 0.0, maxSurface),
+                             "Matched Intake - Stopped robot: 12 in/s");
+    TestRunner::assertEquals(45, IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, 20.0, maxSurface),
+                             "Matched Intake - 20 in/s: 12 + 24 in/s");
+    TestRunner::assertEquals(40, IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, 20.0, maxSurface, 0.0),
+                             "Matched Intake - No overspeed: 12 + 20 in/s");
+    TestRunner::assertEquals(15, IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, -30.0, maxSurface),
+                             "Matched Intake - Backwards counts as stopped");
+    TestRunner::assertEquals(100, IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, 70.0, maxSurface),
+                             "Matched Intake - Never past 100%");
+    TestRunner::assertEquals(-100, IntakeController::calculateGroundMatchedPower(IntakeController::REVERSE, 20.0, maxSurface),
+                             "Matched Intake - Spitting out is full power");
+    TestRunner::assertEquals(0, IntakeController::calculateGroundMatchedPower(IntakeController::STOP, 20.0, maxSurface),
+                             "Matched Intake - Stop is stop");
+}
+
+// ============================================
+// BALL-FLOW MODEL
+// ============================================
+// The robot drives onto a ball with the intake on. At contact the roller surface has to
+// move faster than the ball comes at it (GRAB_MARGIN), or the ball is pushed ahead of
+// the robot. A roller much faster than the ball flicks it off instead; how much faster is
+// too fast depends on where the roller catches the ball (KICK_MIN..KICK_MAX). The kick
+// range has not been measured: it is set wide, on both sides of the fixed 100% roller
+// speed, so the fixed intake's result is printed for comparison but not asserted.
+// The roller follows its command through the motor's velocity loop (ROLLER_TAU), and the
+// matched intake sees the drive speed a little late and noisy, like the real one.
+
+const double SIM_ROLLER_SURFACE = 78.54;  // 2.5" roller, 200 rpm motor geared 3:1 (in/s at 100%)
+const double SIM_TOP_SPEED = 41.9;        // 4" wheels at 200 rpm (in/s)
+const double GRAB_MARGIN = 3.0;           // in/s
+const double KICK_MIN = 40.0;             // in/s
+const double KICK_MAX = 120.0;            // in/s
+const double ROLLER_TAU = 0.08;           // Seconds
+const double SPEED_DELAY = 0.02;          // Drive speed measurement delay (seconds)
+const double SPEED_NOISE = 1.5;           // Drive speed measurement noise (in/s)
+const double APPROACH_SECONDS = 0.5;      // Intake on for this long before contact
+const double SIM_DT = 0.01;
+
+/**
+ * Small deterministic random numbers (same trials on every run)
+ */
+struct SimRandom {
+    uint32_t state;
+    
+    double uniform(double low, double high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * ((state >> 8) / 16777216.0);
+    }
+};
+
+/**
+ * Result of a batch of pickups
+ */
+struct PickupResult {
+    double successRate;   // Balls picked up / balls driven onto
+    double meanPower;     // Average intake command while approaching (percent)
+};
+
+/**
+ * Drive onto a ball many times
+ * 
+ * @param matched true = ground-speed-matched intake, false = fixed 100%
+ * @param overspeed Overspeed margin for the matched intake
+ */
+PickupResult simulatePickups(bool matched, double overspeed, int trials, uint32_t seed) {
+    SimRandom random = {seed};
+    int picked = 0;
+    double powerSum = 0.0;
+    int powerSamples = 0;
+    
+    for (int trial = 0; trial < trials; trial++) {
+        // Speed at contact, still speeding up or slowing down; the ball may be rolling
+        double contactSpeed = random.uniform(6.0, SIM_TOP_SPEED);
+        double accel = random.uniform(-60.0, 60.0);
+        double ballSpeed = random.uniform(-6.0, 6.0);  // Toward the robot = positive
+        double kick = random.uniform(KICK_MIN, KICK_MAX);
+        
+        double surface = matched ? 0.0 : SIM_ROLLER_SURFACE;
+        for (double t = -APPROACH_SECONDS; t < 0.0; t += SIM_DT) {
+            double measuredAt = t - SPEED_DELAY;
+            double measured = std::fmin(SIM_TOP_SPEED, std::fmax(0.0, contactSpeed + accel * measuredAt)) +
+                              random.uniform(-SPEED_NOISE, SPEED_NOISE);
+            int power = matched ? IntakeController::calculateGroundMatchedPower(IntakeController::FORWARD, measured,
+                                                                                SIM_ROLLER_SURFACE, overspeed)
+                                : IntakeController::calculateIntakePower(IntakeController::FORWARD, 100);
+            surface += (power / 100.0 * SIM_ROLLER_SURFACE - surface) * SIM_DT / ROLLER_TAU;
+            powerSum += power;
+            powerSamples++;
+        }
+        
+        double excess = surface - (contactSpeed + ballSpeed);
+        if (excess >= GRAB_MARGIN && excess <= kick) {
+            picked++;
+        }
+    }
+    
+    PickupResult result;
+    result.successRate = (double)picked / trials;
+    result.meanPower = powerSum / powerSamples;
+    return result;
+}
+
+/**
+ * Test: Ball-Flow Model - Pickup Success
+ * 
+ * Given: 500 pickups at random speeds, accelerations and ball roll
+ * When: The intake runs at a fixed 100%, then matched to the ground speed
+ * Then: The matched intake grabs nearly every ball (the roller stays ahead of the ball
+ *       despite the delayed, noisy speed) while running the roller slower
+ */
+void testBallFlow_MatchedPicksUp() {
+    PickupResult fixed = simulatePickups(false, IntakeController::DEFAULT_OVERSPEED, 500, 11);
+    PickupResult matched = simulatePickups(true, IntakeController::DEFAULT_OVERSPEED, 500, 11);
+    std::cout << "  Fixed 100%: " << fixed.successRate * 100.0 << "% picked up, mean power " << fixed.meanPower
+              << "%" << std::endl;
+    std::cout << "  Matched   : " << matched.successRate * 100.0 << "% picked up, mean power " << matched.meanPower
+              << "%" << std::endl;
+    
+    TestRunner::assertTrue(matched.successRate >= 0.95, "Ball Flow - Matched intake picks up 95%");
+    TestRunner::assertTrue(matched.meanPower < fixed.meanPower * 0.6, "Ball Flow - Roller runs slower on average");
+}
+
+/**
+ * Test: Ball-Flow Model - Overspeed Margin
+ * 
+ * Given: The same 500 pickups
+ * When: The matched intake runs with no overspeed, then with the default
+ * Then: Without the margin more balls that were still speeding up get pushed ahead
+ */
+void testBallFlow_OverspeedMargin() {
+    PickupResult none = simulatePickups(true, 0.0, 500, 11);
+    PickupResult margin = simulatePickups(true, IntakeController::DEFAULT_OVERSPEED, 500, 11);
+    std::cout << "  No overspeed: " << none.successRate * 100.0 << "% picked up" << std::endl;
+    std::cout << "  20% overspeed: " << margin.successRate * 100.0 << "% picked up" << std::endl;
+    
+    TestRunner::assertTrue(margin.successRate > none.successRate, "Ball Flow - Overspeed margin helps");
+}
+
 // ============================================
 // MAIN TEST RUNNER
 // ============================================
@@ -247,6 +444,11 @@ int main() {
     testClampPowerLevel_AboveMaximum();
     testClampPowerLevel_BelowMinimum();
     testClampPowerLevel_AtBoundaries();
+    testLimitToCapacity();
+    testSurfaceSpeed();
+    testGroundMatchedPower();
+    testBallFlow_MatchedPicksUp();
+    testBallFlow_OverspeedMargin();
     
     // Print results
     TestRunner::printResults();
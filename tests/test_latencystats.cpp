@@ -0,0 +1,212 @@
+/*
+ * test_latencystats.cpp
+ * 
+ * Unit tests for LatencyStats class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our LatencyStats class to test it
+#include "../src/controllers/LatencyStats.h"
+
+// ============================================
+// TEST CASES FOR LATENCY STATS
+// ============================================
+
+/**
+ * Test: Empty Statistics
+ * Given: No measurements
+ * When: Reading the statistics
+ * Then: Everything is zero
+ */
+void testLatencyStats_Empty() {
+    LatencyStats stats;
+    TestRunner::assertEquals(0, (int)stats.getCount(), "Latency Stats - Empty count");
+    TestRunner::assertEquals(0, (int)stats.getMax(), "Latency Stats - Empty max");
+    TestRunner::assertNear(0.0, stats.getMean(), 0.001, "Latency Stats - Empty mean");
+    TestRunner::assertEquals(0, (int)stats.getPercentile(95), "Latency Stats - Empty percentile");
+}
+
+/**
+ * Test: Min, Mean, Max
+ * Given: 1000, 2000, 6000 us
+ * When: Reading the statistics
+ * Then: Min 1000, mean 3000, max 6000
+ */
+void testLatencyStats_Basic() {
+    LatencyStats stats;
+    stats.add(2000);
+    stats.add(1000);
+    stats.add(6000);
+    TestRunner::assertEquals(3, (int)stats.getCount(), "Latency Stats - Count");
+    TestRunner::assertEquals(1000, (int)stats.getMin(), "Latency Stats - Min");
+    TestRunner::assertEquals(6000, (int)stats.getMax(), "Latency Stats - Max");
+    TestRunner::assertNear(3000.0, stats.getMean(), 0.001, "Latency Stats - Mean");
+}
+
+/**
+ * Test: Percentiles
+ * Given: 100 measurements 100, 200, ... 10000 us with 200 us buckets
+ * When: Asking for percentiles
+ * Then: Within one bucket of the exact value, p100 = max
+ */
+void testLatencyStats_Percentiles() {
+    LatencyStats stats(200);
+    for (int i = 1; i <= 100; i++) {
+        stats.add(i * 100);
+    }
+    TestRunner::assertNear(5000.0, stats.getPercentile(50), 200.0, "Latency Stats - Median");
+    TestRunner::assertNear(9500.0, stats.getPercentile(95), 200.0, "Latency Stats - p95");
+    TestRunner::assertEquals(10000, (int)stats.getPercentile(100), "Latency Stats - p100 is the max");
+}
+
+/**
+ * Test: Overflow Bucket
+ * Given: A latency far beyond the histogram range
+ * When: Asking for the top percentile
+ * Then: The real max is reported, not the histogram edge
+ */
+void testLatencyStats_Overflow() {
+    LatencyStats stats;
+    stats.add(100);
+    stats.add(1000000);
+    TestRunner::assertEquals(1000000, (int)stats.getPercentile(99), "Latency Stats - Overflow reports the max");
+    TestRunner::assertEquals(500, (int)stats.getPercentile(10), "Latency Stats - Low percentile in first bucket");
+}
+
+/**
+ * Test: Reset
+ * Given: Some measurements
+ * When: reset() is called
+ * Then: Statistics start over
+ */
+void testLatencyStats_Reset() {
+    LatencyStats stats;
+    stats.add(5000);
+    stats.reset();
+    stats.add(700);
+    TestRunner::assertEquals(1, (int)stats.getCount(), "Latency Stats - Count after reset");
+    TestRunner::assertEquals(700, (int)stats.getMin(), "Latency Stats - Min after reset");
+    TestRunner::assertEquals(700, (int)stats.getMax(), "Latency Stats - Max after reset");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running LatencyStats Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testLatencyStats_Empty();
+    testLatencyStats_Basic();
+    testLatencyStats_Percentiles();
+    testLatencyStats_Overflow();
+    testLatencyStats_Reset();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
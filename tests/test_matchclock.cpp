@@ -0,0 +1,228 @@
+/*
+ * test_matchclock.cpp
+ * 
+ * Unit tests for MatchClock class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our MatchClock class to test it
+#include "../src/controllers/MatchClock.h"
+
+// ============================================
+// TEST CASES FOR MATCH CLOCK
+// ============================================
+
+/**
+ * Test: Phase From Competition Flags
+ */
+void testPhaseFromFlags() {
+    TestRunner::assertEquals(MatchClock::DISABLED, MatchClock::phaseFromFlags(false, false), "Match Clock - Disabled");
+    TestRunner::assertEquals(MatchClock::DISABLED, MatchClock::phaseFromFlags(false, true), "Match Clock - Disabled in autonomous");
+    TestRunner::assertEquals(MatchClock::AUTONOMOUS, MatchClock::phaseFromFlags(true, true), "Match Clock - Autonomous");
+    TestRunner::assertEquals(MatchClock::DRIVER, MatchClock::phaseFromFlags(true, false), "Match Clock - Driver control");
+}
+
+/**
+ * Test: Starts Disabled With No Time Left
+ */
+void testMatchClock_StartsDisabled() {
+    MatchClock clock;
+    TestRunner::assertEquals(MatchClock::DISABLED, clock.getPhase(), "Match Clock - Starts disabled");
+    TestRunner::assertEquals(0, static_cast<int>(clock.getRemainingMs(5000)), "Match Clock - No time left when disabled");
+}
+
+/**
+ * Test: Transition Detection
+ * 
+ * Given: Clock disabled
+ * When: Update with DRIVER twice
+ * Then: First update is a transition, second is not
+ */
+void testMatchClock_TransitionDetected() {
+    MatchClock clock;
+    TestRunner::assertEqualsBool(true, clock.update(MatchClock::DRIVER, 1000), "Match Clock - Phase change is a transition");
+    TestRunner::assertEqualsBool(false, clock.update(MatchClock::DRIVER, 1020), "Match Clock - Same phase is not a transition");
+}
+
+/**
+ * Test: Driver Time Remaining
+ * 
+ * Given: Driver control started at t = 20000 ms
+ * When: Ask at t = 110000 ms (90 s in)
+ * Then: 15 seconds remain
+ */
+void testMatchClock_DriverRemaining() {
+    MatchClock clock;
+    clock.update(MatchClock::DRIVER, 20000);
+    TestRunner::assertEquals(90000, static_cast<int>(clock.getElapsedMs(110000)), "Match Clock - Elapsed in driver");
+    TestRunner::assertEquals(15000, static_cast<int>(clock.getRemainingMs(110000)), "Match Clock - 15 s left in driver");
+}
+
+/**
+ * Test: Autonomous Time Remaining
+ */
+void testMatchClock_AutonomousRemaining() {
+    MatchClock clock;
+    clock.update(MatchClock::AUTONOMOUS, 0);
+    TestRunner::assertEquals(5000, static_cast<int>(clock.getRemainingMs(10000)), "Match Clock - 5 s left in autonomous");
+}
+
+/**
+ * Test: Remaining Never Negative
+ */
+void testMatchClock_RemainingAfterEnd() {
+    MatchClock clock;
+    clock.update(MatchClock::AUTONOMOUS, 0);
+    TestRunner::assertEquals(0, static_cast<int>(clock.getRemainingMs(20000)), "Match Clock - 0 after period ends");
+}
+
+/**
+ * Test: Custom Durations (skills)
+ */
+void testMatchClock_CustomDurations() {
+    MatchClock clock;
+    clock.setDurations(60000, 60000);
+    clock.update(MatchClock::DRIVER, 0);
+    TestRunner::assertEquals(50000, static_cast<int>(clock.getRemainingMs(10000)), "Match Clock - 60 s skills driver period");
+}
+
+/**
+ * Test: New Period Restarts the Clock
+ * 
+ * Given: Autonomous, then disabled, then driver control
+ * When: Ask for remaining time right after driver starts
+ * Then: Full driver period remains
+ */
+void testMatchClock_RestartsEachPeriod() {
+    MatchClock clock;
+    clock.update(MatchClock::AUTONOMOUS, 0);
+    clock.update(MatchClock::DISABLED, 15000);
+    clock.update(MatchClock::DRIVER, 18000);
+    TestRunner::assertEquals(static_cast<int>(MatchClock::DEFAULT_DRIVER_MS), static_cast<int>(clock.getRemainingMs(18000)),
+                             "Match Clock - Driver period starts full");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running MatchClock Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testPhaseFromFlags();
+    testMatchClock_StartsDisabled();
+    testMatchClock_TransitionDetected();
+    testMatchClock_DriverRemaining();
+    testMatchClock_AutonomousRemaining();
+    testMatchClock_RemainingAfterEnd();
+    testMatchClock_CustomDurations();
+    testMatchClock_RestartsEachPeriod();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
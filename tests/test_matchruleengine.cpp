@@ -0,0 +1,269 @@
+/*
+ * test_matchruleengine.cpp
+ * 
+ * Unit tests for MatchRuleEngine class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our MatchRuleEngine class to test it
+#include "../src/controllers/MatchRuleEngine.h"
+
+// ============================================
+// TEST CASES FOR MATCH RULE ENGINE
+// ============================================
+
+/**
+ * Test: Rule Fires When Time Reached
+ * 
+ * Given: Rule "relax limits with 15 s left in driver"
+ * When: Tick at 16 s, then at 15 s
+ * Then: Nothing at 16 s, RELAX_LIMITS at 15 s
+ */
+void testRules_FiresAtTime() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);
+    engine.startPhase(MatchClock::DRIVER);
+    
+    TestRunner::assertEquals(0, static_cast<int>(engine.update(16000)), "Rules - Nothing due at 16 s");
+    TestRunner::assertEquals(static_cast<int>(MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS)),
+                             static_cast<int>(engine.update(15000)), "Rules - Relax limits due at 15 s");
+}
+
+/**
+ * Test: Rule Fires Only Once
+ */
+void testRules_FiresOnce() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RUMBLE_DRIVER);
+    engine.startPhase(MatchClock::DRIVER);
+    engine.update(14000);
+    TestRunner::assertEquals(0, static_cast<int>(engine.update(13000)), "Rules - Rule does not fire twice");
+}
+
+/**
+ * Test: Rules Added Out of Order Fire in Time Order
+ * 
+ * Given: Rules at 5 s, 30 s and 15 s added in that order
+ * When: Time counts down
+ * Then: They fire at 30 s, 15 s and 5 s
+ */
+void testRules_SortedByTime() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 5000, MatchRuleEngine::SET_HEIGHT_HIGH);
+    engine.addRule(MatchClock::DRIVER, 30000, MatchRuleEngine::RUMBLE_DRIVER);
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);
+    engine.startPhase(MatchClock::DRIVER);
+    
+    uint32_t at30 = engine.update(30000);
+    uint32_t at15 = engine.update(15000);
+    uint32_t at5 = engine.update(5000);
+    
+    TestRunner::assertEquals(static_cast<int>(MatchRuleEngine::actionBit(MatchRuleEngine::RUMBLE_DRIVER)),
+                             static_cast<int>(at30), "Rules - Rumble first (30 s)");
+    TestRunner::assertEquals(static_cast<int>(MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS)),
+                             static_cast<int>(at15), "Rules - Relax second (15 s)");
+    TestRunner::assertEquals(static_cast<int>(MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH)),
+                             static_cast<int>(at5), "Rules - Height last (5 s)");
+}
+
+/**
+ * Test: Rules Sharing a Time Fire Together
+ */
+void testRules_SameTimeFireTogether() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RUMBLE_DRIVER);
+    engine.startPhase(MatchClock::DRIVER);
+    
+    uint32_t due = engine.update(15000);
+    uint32_t expected = MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS) |
+                        MatchRuleEngine::actionBit(MatchRuleEngine::RUMBLE_DRIVER);
+    TestRunner::assertEquals(static_cast<int>(expected), static_cast<int>(due), "Rules - Same-time rules fire together");
+}
+
+/**
+ * Test: Late Tick Catches Up
+ * 
+ * Given: Rules at 15 s and 10 s
+ * When: The first tick checked is at 8 s (e.g. driver control started late)
+ * Then: Both fire on that tick
+ */
+void testRules_LateTickCatchesUp() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);
+    engine.addRule(MatchClock::DRIVER, 10000, MatchRuleEngine::SET_HEIGHT_HIGH);
+    engine.startPhase(MatchClock::DRIVER);
+    
+    uint32_t due = engine.update(8000);
+    TestRunner::assertTrue((due & MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS)) &&
+                           (due & MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH)),
+                           "Rules - Missed rules fire on the next tick");
+}
+
+/**
+ * Test: Rules Only Fire in Their Phase
+ */
+void testRules_PhaseSeparated() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);
+    engine.addRule(MatchClock::AUTONOMOUS, 2000, MatchRuleEngine::SET_HEIGHT_LOW);
+    
+    engine.startPhase(MatchClock::AUTONOMOUS);
+    uint32_t autonomousDue = engine.update(1000);
+    TestRunner::assertEquals(static_cast<int>(MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_LOW)),
+                             static_cast<int>(autonomousDue), "Rules - Only the autonomous rule fires in autonomous");
+    
+    engine.startPhase(MatchClock::DISABLED);
+    TestRunner::assertEquals(0, static_cast<int>(engine.update(0)), "Rules - Nothing fires while disabled");
+}
+
+/**
+ * Test: Restarting a Phase Re-arms Its Rules
+ */
+void testRules_RearmedEachPhase() {
+    MatchRuleEngine engine;
+    engine.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RUMBLE_DRIVER);
+    engine.startPhase(MatchClock::DRIVER);
+    engine.update(10000);
+    engine.startPhase(MatchClock::DISABLED);
+    engine.startPhase(MatchClock::DRIVER);
+    TestRunner::assertTrue(engine.update(10000) != 0, "Rules - Rule fires again next match");
+}
+
+/**
+ * Test: Rule Table Full
+ */
+void testRules_TableFull() {
+    MatchRuleEngine engine;
+    for (int i = 0; i < MatchRuleEngine::MAX_RULES; i++) {
+        engine.addRule(MatchClock::DRIVER, i * 1000, MatchRuleEngine::RUMBLE_DRIVER);
+    }
+    TestRunner::assertEqualsBool(false, engine.addRule(MatchClock::DRIVER, 500, MatchRuleEngine::RUMBLE_DRIVER),
+                                 "Rules - Add fails when table is full");
+    TestRunner::assertEquals(MatchRuleEngine::MAX_RULES, engine.getRuleCount(), "Rules - Count stays at MAX_RULES");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running MatchRuleEngine Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testRules_FiresAtTime();
+    testRules_FiresOnce();
+    testRules_SortedByTime();
+    testRules_SameTimeFireTogether();
+    testRules_LateTickCatchesUp();
+    testRules_PhaseSeparated();
+    testRules_RearmedEachPhase();
+    testRules_TableFull();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/*
+ * test_odometry.cpp
+ * 
+ * Unit tests for Odometry class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our Odometry class to test it
+#include "../src/controllers/Odometry.h"
+
+// ============================================
+// TEST CASES FOR ODOMETRY
+// ============================================
+
+/**
+ * Test: Integrate - Straight Along +y
+ * 
+ * Given: Robot at origin facing heading 0
+ * When: Drive forward 10 inches without turning
+ * Then: Robot should be at (0, 10)
+ */
+void testIntegrate_StraightNorth() {
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    Odometry::Pose result = Odometry::integrate(start, 10.0, 0.0);
+    
+    TestRunner::assertNear(0.0, result.x, 1e-9, "Integrate - Heading 0 keeps x unchanged");
+    TestRunner::assertNear(10.0, result.y, 1e-9, "Integrate - Heading 0 moves along +y");
+}
+
+/**
+ * Test: Integrate - Heading 90 Moves Along +x
+ * 
+ * Given: Robot facing heading 90 (clockwise from +y)
+ * When: Drive forward 10 inches
+ * Then: Robot should move along +x
+ */
+void testIntegrate_HeadingEast() {
+    Odometry::Pose start = {5.0, 5.0, 90.0};
+    Odometry::Pose result = Odometry::integrate(start, 10.0, 90.0);
+    
+    TestRunner::assertNear(15.0, result.x, 1e-9, "Integrate - Heading 90 moves along +x");
+    TestRunner::assertNear(5.0, result.y, 1e-9, "Integrate - Heading 90 keeps y unchanged");
+}
+
+/**
+ * Test: Integrate - Backward Drive
+ * 
+ * Given: Robot facing heading 0
+ * When: Drive -10 inches
+ * Then: Robot should move along -y
+ */
+void testIntegrate_Backward() {
+    Odometry::Pose start = {0.0, 0.0, 0.0};
+    Odometry::Pose result = Odometry::integrate(start, -10.0, 0.0);
+    
+    TestRunner::assertNear(-10.0, result.y, 1e-9, "Integrate - Negative distance drives backward");
+}
+
+/**
+ * Test: Integrate - Turn Across North Uses Shortest Average
+ * 
+ * Given: Robot heading 350, ends at heading 10
+ * When: Drive forward 10 inches
+ * Then: Average heading is 0, so robot moves along +y (not -y)
+ */
+void testIntegrate_WrapAroundAverage() {
+    Odometry::Pose start = {0.0, 0.0, 350.0};
+    Odometry::Pose result = Odometry::integrate(start, 10.0, 10.0);
+    
+    TestRunner::assertNear(10.0, result.y, 1e-9, "Integrate - 350 to 10 averages to heading 0");
+    TestRunner::assertNear(10.0, result.heading, 1e-9, "Integrate - Ends at new heading");
+}
+
+/**
+ * Test: Wheel Travel - One Turn
+ * 
+ * Given: 4 inch wheel, direct drive
+ * When: Motor turns 360 degrees
+ * Then: Wheel rolls one circumference (4 * pi)
+ */
+void testWheelTravel_OneTurn() {
+    double travel = Odometry::wheelTravel(360.0, 4.0, 1.0);
+    TestRunner::assertNear(4.0 * 3.14159265358979, travel, 1e-6, "Wheel Travel - One turn is one circumference");
+}
+
+/**
+ * Test: Wheel Travel - Gear Ratio
+ * 
+ * Given: 4 inch wheel geared 3:5 (0.6 wheel turns per motor turn)
+ * When: Motor turns 360 degrees
+ * Then: Wheel rolls 0.6 circumference
+ */
+void testWheelTravel_GearRatio() {
+    double travel = Odometry::wheelTravel(360.0, 4.0, 0.6);
+    TestRunner::assertNear(0.6 * 4.0 * 3.14159265358979, travel, 1e-6, "Wheel Travel - Gear ratio scales travel");
+}
+
+/**
+ * Test: Wrap Heading - Negative and Large Values
+ */
+void testWrapHeading_OutOfRange() {
+    TestRunner::assertNear(270.0, Odometry::wrapHeading(-90.0), 1e-9, "Wrap Heading - -90 becomes 270");
+    TestRunner::assertNear(90.0, Odometry::wrapHeading(450.0), 1e-9, "Wrap Heading - 450 becomes 90");
+    TestRunner::assertNear(0.0, Odometry::wrapHeading(360.0), 1e-9, "Wrap Heading - 360 becomes 0");
+}
+
+/**
+ * Test: Heading Difference - Shortest Direction
+ */
+void testHeadingDifference_Shortest() {
+    TestRunner::assertNear(20.0, Odometry::headingDifference(350.0, 10.0), 1e-9,
+                           "Heading Difference - 350 to 10 is +20 (clockwise)");
+    TestRunner::assertNear(-20.0, Odometry::headingDifference(10.0, 350.0), 1e-9,
+                           "Heading Difference - 10 to 350 is -20 (counter-clockwise)");
+    TestRunner::assertNear(180.0, Odometry::headingDifference(0.0, 180.0), 1e-9,
+                           "Heading Difference - Half turn is +180");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running Odometry Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testIntegrate_StraightNorth();
+    testIntegrate_HeadingEast();
+    testIntegrate_Backward();
+    testIntegrate_WrapAroundAverage();
+    testWheelTravel_OneTurn();
+    testWheelTravel_GearRatio();
+    testWrapHeading_OutOfRange();
+    testHeadingDifference_Shortest();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
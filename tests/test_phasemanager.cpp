@@ -0,0 +1,308 @@
+/*
+ * test_phasemanager.cpp
+ * 
+ * Unit tests for PhaseManager class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our PhaseManager class to test it
+#include "../src/controllers/PhaseManager.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+// Fake microsecond clock: each hook "takes" HOOK_COST_US
+uint32_t fakeTimeUs = 0;
+const uint32_t HOOK_COST_US = 250;
+uint32_t fakeClock() {
+    return fakeTimeUs;
+}
+
+// Record of hook calls, in order (e.g. "xD eA" = exit disabled, enter autonomous)
+std::string hookLog;
+void enterDisabled() { hookLog += "eD "; fakeTimeUs += HOOK_COST_US; }
+void exitDisabled() { hookLog += "xD "; fakeTimeUs += HOOK_COST_US; }
+void enterAutonomous() { hookLog += "eA "; fakeTimeUs += HOOK_COST_US; }
+void exitAutonomous() { hookLog += "xA "; fakeTimeUs += HOOK_COST_US; }
+void enterDriver() { hookLog += "eR "; fakeTimeUs += HOOK_COST_US; }
+void exitDriver() { hookLog += "xR "; fakeTimeUs += HOOK_COST_US; }
+
+PhaseManager makeManager() {
+    hookLog = "";
+    fakeTimeUs = 1000;
+    PhaseManager manager(fakeClock);
+    manager.setHooks(MatchClock::DISABLED, enterDisabled, exitDisabled);
+    manager.setHooks(MatchClock::AUTONOMOUS, enterAutonomous, exitAutonomous);
+    manager.setHooks(MatchClock::DRIVER, enterDriver, exitDriver);
+    return manager;
+}
+
+PhaseManager::DriverHandoff makeHandoff(uint32_t preparedAtMs) {
+    PhaseManager::DriverHandoff handoff;
+    handoff.ready = false;
+    handoff.preparedAtMs = preparedAtMs;
+    handoff.leftPower = 40;
+    handoff.rightPower = -40;
+    handoff.intakeState = IntakeController::FORWARD;
+    handoff.rampState = IntakeController::REVERSE;
+    handoff.fullPowerState = RampController::STOP;
+    handoff.toggleButtonHeld = true;
+    return handoff;
+}
+
+// ============================================
+// TEST CASES FOR PHASE MANAGER
+// ============================================
+
+/**
+ * Test: Default State
+ */
+void testPhaseManager_DefaultState() {
+    PhaseManager manager;
+    TestRunner::assertEquals(MatchClock::DISABLED, manager.getPhase(), "Phase Manager - Starts disabled");
+    TestRunner::assertEquals(PneumaticController::LOW, manager.getState().height, "Phase Manager - Starts at LOW height");
+    TestRunner::assertEqualsBool(false, manager.getState().lastToggleButton, "Phase Manager - No button held at start");
+}
+
+/**
+ * Test: Exit Hook Runs Before Enter Hook
+ * 
+ * Given: Full match sequence disabled -> autonomous -> disabled -> driver
+ * When: Transition through it
+ * Then: Each change runs the old phase's exit hook, then the new phase's enter hook
+ */
+void testPhaseManager_HookOrder() {
+    PhaseManager manager = makeManager();
+    manager.transition(MatchClock::AUTONOMOUS);
+    manager.transition(MatchClock::DISABLED);
+    manager.transition(MatchClock::DRIVER);
+    TestRunner::assertTrue(hookLog == "xD eA xA eD xD eR ", "Phase Manager - Exit old then enter new, every change");
+    TestRunner::assertEquals(3, manager.getTransitionCount(), "Phase Manager - Three transitions counted");
+}
+
+/**
+ * Test: Repeated Reports of the Same Phase Do Nothing
+ */
+void testPhaseManager_SamePhaseIgnored() {
+    PhaseManager manager = makeManager();
+    manager.transition(MatchClock::DRIVER);
+    bool second = manager.transition(MatchClock::DRIVER);
+    TestRunner::assertEqualsBool(false, second, "Phase Manager - Same phase is not a transition");
+    TestRunner::assertTrue(hookLog == "xD eR ", "Phase Manager - Hooks run only once");
+}
+
+/**
+ * Test: Missing Hooks Are Allowed
+ */
+void testPhaseManager_NullHooks() {
+    PhaseManager manager;
+    TestRunner::assertEqualsBool(true, manager.transition(MatchClock::AUTONOMOUS), "Phase Manager - Works without hooks");
+}
+
+/**
+ * Test: Hook Latency Measured
+ * 
+ * Given: Each hook takes 250 us on the fake clock
+ * When: Transition (exit + enter)
+ * Then: Hook latency is 500 us
+ */
+void testPhaseManager_HookLatency() {
+    PhaseManager manager = makeManager();
+    manager.transition(MatchClock::AUTONOMOUS);
+    TestRunner::assertEquals(500, static_cast<int>(manager.getHookLatencyUs()), "Phase Manager - Hook latency 500 us");
+    TestRunner::assertEquals(500, static_cast<int>(manager.getMaxHookLatencyUs()), "Phase Manager - Max hook latency tracked");
+}
+
+/**
+ * Test: First Tick Latency Measured Once
+ * 
+ * Given: Transition to driver, first tick 1200 us after the transition started
+ * When: markFirstTick twice
+ * Then: Latency is 1200 us and the second call doesn't change it
+ */
+void testPhaseManager_FirstTickLatency() {
+    PhaseManager manager = makeManager();
+    manager.transition(MatchClock::DRIVER);  // Starts at 1000 us
+    fakeTimeUs = 2200;
+    manager.markFirstTick();
+    fakeTimeUs = 9000;
+    manager.markFirstTick();
+    TestRunner::assertEquals(1200, static_cast<int>(manager.getFirstTickLatencyUs()), "Phase Manager - First tick latency 1200 us");
+}
+
+/**
+ * Test: Fresh Handoff Applies Motor Commands
+ * 
+ * Given: Handoff prepared at 14950 ms
+ * When: Taken at 15000 ms (50 ms later)
+ * Then: Fresh - commands may be applied; state carries over
+ */
+void testPhaseManager_FreshHandoff() {
+    PhaseManager manager;
+    manager.prepareHandoff(makeHandoff(14950));
+    PhaseManager::DriverHandoff handoff;
+    
+    bool fresh = manager.takeHandoff(15000, handoff);
+    
+    TestRunner::assertEqualsBool(true, fresh, "Phase Manager - Handoff 50 ms old is fresh");
+    TestRunner::assertEquals(40, handoff.leftPower, "Phase Manager - Handoff left power kept");
+    TestRunner::assertEqualsBool(true, manager.getState().lastToggleButton, "Phase Manager - Held A carried over (no toggle)");
+    TestRunner::assertEquals(IntakeController::FORWARD, manager.getState().intakeState, "Phase Manager - Intake state carried over");
+}
+
+/**
+ * Test: Stale Handoff Only Restores State
+ * 
+ * Given: Handoff prepared, then a 3 second disabled gap
+ * When: Taken
+ * Then: Not fresh (motor commands not applied) but state still carried over
+ */
+void testPhaseManager_StaleHandoff() {
+    PhaseManager manager;
+    manager.prepareHandoff(makeHandoff(15000));
+    PhaseManager::DriverHandoff handoff;
+    
+    bool fresh = manager.takeHandoff(18000, handoff);
+    
+    TestRunner::assertEqualsBool(false, fresh, "Phase Manager - Handoff after disabled gap is stale");
+    TestRunner::assertEqualsBool(true, manager.getState().lastToggleButton, "Phase Manager - Stale handoff still restores state");
+}
+
+/**
+ * Test: Handoff Used Only Once
+ */
+void testPhaseManager_HandoffOnce() {
+    PhaseManager manager;
+    manager.prepareHandoff(makeHandoff(1000));
+    PhaseManager::DriverHandoff handoff;
+    manager.takeHandoff(1010, handoff);
+    TestRunner::assertEqualsBool(false, manager.hasHandoff(), "Phase Manager - Handoff consumed");
+    TestRunner::assertEqualsBool(false, manager.takeHandoff(1020, handoff), "Phase Manager - Second take returns false");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running PhaseManager Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testPhaseManager_DefaultState();
+    testPhaseManager_HookOrder();
+    testPhaseManager_SamePhaseIgnored();
+    testPhaseManager_NullHooks();
+    testPhaseManager_HookLatency();
+    testPhaseManager_FirstTickLatency();
+    testPhaseManager_FreshHandoff();
+    testPhaseManager_StaleHandoff();
+    testPhaseManager_HandoffOnce();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
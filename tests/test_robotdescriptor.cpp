@@ -0,0 +1,215 @@
+/*
+ * test_robotdescriptor.cpp
+ * 
+ * Unit tests for RobotDescriptor class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our RobotDescriptor class to test it
+#include "../src/controllers/RobotDescriptor.h"
+
+// Groupings are computed by the compiler - these only compile if they are constant
+constexpr int LEFT_MOTORS = RobotDescriptor::countSide(RobotDescriptor::LEFT);
+constexpr int FIRST_RIGHT_MOTOR = RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, 0);
+constexpr int ROLLER_MOTORS = RobotDescriptor::countMotors(Command::INTAKE | Command::RAMP | Command::TOP_WHEEL);
+
+// ============================================
+// TEST CASES FOR ROBOT DESCRIPTOR
+// ============================================
+
+/**
+ * Test: Drive Sides
+ * 
+ * Given: The robot description
+ * When: Group the drive motors by side
+ * Then: Three per side, front to back, matching the ActuationFrame order
+ */
+void testDescriptor_DriveSides() {
+    TestRunner::assertEquals(3, LEFT_MOTORS, "Descriptor - Three left motors");
+    TestRunner::assertEquals(3, RobotDescriptor::countSide(RobotDescriptor::RIGHT), "Descriptor - Three right motors");
+    TestRunner::assertEquals(ActuationFrame::RIGHT_FRONT, FIRST_RIGHT_MOTOR, "Descriptor - First right motor");
+    TestRunner::assertEquals(ActuationFrame::LEFT_BACK, RobotDescriptor::sideMotor(RobotDescriptor::LEFT, 2), "Descriptor - Last left motor");
+    TestRunner::assertEquals(-1, RobotDescriptor::sideMotor(RobotDescriptor::LEFT, 3), "Descriptor - No fourth left motor");
+}
+
+/**
+ * Test: Subsystem Groupings
+ * 
+ * Given: The robot description
+ * When: Count motors per subsystem
+ * Then: Six drive, one each for intake, ramp and top wheel
+ */
+void testDescriptor_Subsystems() {
+    TestRunner::assertEquals(6, RobotDescriptor::countMotors(Command::DRIVE), "Descriptor - Six drive motors");
+    TestRunner::assertEquals(3, ROLLER_MOTORS, "Descriptor - Three roller motors");
+    TestRunner::assertEquals(0, RobotDescriptor::countMotors(Command::HEIGHT), "Descriptor - Height has no motors");
+    TestRunner::assertEquals(RobotDescriptor::MOTOR_COUNT,
+                             RobotDescriptor::countMotors(Command::DRIVE | Command::INTAKE | Command::RAMP | Command::TOP_WHEEL),
+                             "Descriptor - Every motor in a subsystem");
+}
+
+/**
+ * Test: Energy Groups
+ * 
+ * Given: Each motor's subsystem
+ * When: Map to energy accounting groups
+ * Then: Drive motors count as DRIVE, the top wheel as FULL_POWER_RAMP
+ */
+void testDescriptor_EnergyGroups() {
+    TestRunner::assertEquals(EnergyMonitor::DRIVE, RobotDescriptor::energySubsystem(ActuationFrame::RIGHT_MIDDLE), "Descriptor - Drive energy");
+    TestRunner::assertEquals(EnergyMonitor::INTAKE, RobotDescriptor::energySubsystem(ActuationFrame::INTAKE), "Descriptor - Intake energy");
+    TestRunner::assertEquals(EnergyMonitor::RAMP, RobotDescriptor::energySubsystem(ActuationFrame::RAMP), "Descriptor - Ramp energy");
+    TestRunner::assertEquals(EnergyMonitor::FULL_POWER_RAMP, RobotDescriptor::energySubsystem(ActuationFrame::FULL_POWER_RAMP), "Descriptor - Top wheel energy");
+}
+
+/**
+ * Test: Wiring Details
+ * 
+ * Given: The robot description
+ * When: Read ports, reversals and cartridges
+ * Then: Right side reversed, 18:1 cartridges at 200 rpm, pistons on A and B
+ */
+void testDescriptor_Wiring() {
+    TestRunner::assertTrue(RobotDescriptor::MOTORS[ActuationFrame::RIGHT_BACK].reversed, "Descriptor - Right side reversed");
+    TestRunner::assertTrue(!RobotDescriptor::MOTORS[ActuationFrame::LEFT_BACK].reversed, "Descriptor - Left side forward");
+    TestRunner::assertEquals(7, RobotDescriptor::MOTORS[ActuationFrame::INTAKE].port, "Descriptor - Intake port");
+    TestRunner::assertNear(200.0, RobotDescriptor::maxRpm(ActuationFrame::LEFT_FRONT), 1e-9, "Descriptor - 18:1 free speed");
+    TestRunner::assertTrue(RobotDescriptor::PISTONS[0].port == 'A' && RobotDescriptor::PISTONS[1].port == 'B', "Descriptor - Piston ports");
+}
+
+/**
+ * Test: Wiring Checks
+ * 
+ * Given: The checks behind the compile-time asserts
+ * When: Run them on the real description
+ * Then: All pass (a duplicate port would stop the build)
+ */
+void testDescriptor_Checks() {
+    TestRunner::assertTrue(RobotDescriptor::idsInOrder(), "Descriptor - Motors in frame order");
+    TestRunner::assertTrue(RobotDescriptor::motorPortsValid(), "Descriptor - Motor ports unique");
+    TestRunner::assertTrue(RobotDescriptor::pistonPortsValid(), "Descriptor - Piston ports valid");
+    TestRunner::assertTrue(RobotDescriptor::portUsedAfter(RobotDescriptor::MOTORS[5].port, 0), "Descriptor - Port lookup finds a used port");
+    TestRunner::assertTrue(!RobotDescriptor::portUsedAfter(21, 0), "Descriptor - Free port not found");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running RobotDescriptor Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testDescriptor_DriveSides();
+    testDescriptor_Subsystems();
+    testDescriptor_EnergyGroups();
+    testDescriptor_Wiring();
+    testDescriptor_Checks();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
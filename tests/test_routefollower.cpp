@@ -0,0 +1,437 @@
+/*
+ * test_routefollower.cpp
+ * 
+ * Unit tests for RouteFollower class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our RouteFollower class to test it
+#include "../src/controllers/RouteFollower.h"
+
+typedef GridPlanner::Point Point;
+
+Point at(double x, double y) {
+    Point p;
+    p.x = x;
+    p.y = y;
+    return p;
+}
+
+// ============================================
+// FIELD SIMULATOR
+// ============================================
+
+/**
+ * A tank-drive robot on the field with round obstacles (partner robots, game elements)
+ * 
+ * The drive follows its powers with a short lag. Driving into an obstacle or a wall
+ * stops the robot where it touches (it can still turn and back away); touching it at
+ * speed is a collision, like the jerk TipDetector picks up.
+ */
+struct FieldSim {
+    static constexpr double TOP_SPEED = 42.0;     // in/s at 100%
+    static constexpr double TRACK_WIDTH = 12.0;   // in
+    static constexpr double LAG_SECONDS = 0.1;
+    static constexpr double ROBOT_RADIUS = 9.0;
+    static const int MAX_OBSTACLES = 40;
+    
+    Odometry::Pose pose;
+    double speed;      // in/s
+    double turnRate;   // rad/s, clockwise
+    Point obstacles[MAX_OBSTACLES];
+    double radii[MAX_OBSTACLES];
+    int obstacleCount;
+    bool collision;
+    
+    void reset(double x, double y, double heading) {
+        pose.x = x;
+        pose.y = y;
+        pose.heading = heading;
+        speed = 0.0;
+        turnRate = 0.0;
+        obstacleCount = 0;
+        collision = false;
+    }
+    
+    void addObstacle(double x, double y, double radius) {
+        obstacles[obstacleCount] = at(x, y);
+        radii[obstacleCount] = radius;
+        obstacleCount++;
+    }
+    
+    bool touches(double x, double y) const {
+        if (std::fabs(x) > 72.0 - ROBOT_RADIUS || std::fabs(y) > 72.0 - ROBOT_RADIUS) {
+            return true;
+        }
+        for (int i = 0; i < obstacleCount; i++) {
+            double dx = x - obstacles[i].x;
+            double dy = y - obstacles[i].y;
+            if (std::sqrt(dx * dx + dy * dy) < ROBOT_RADIUS + radii[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void step(int leftPower, int rightPower, double dt) {
+        double left = leftPower / 100.0 * TOP_SPEED;
+        double right = rightPower / 100.0 * TOP_SPEED;
+        speed += ((left + right) / 2.0 - speed) * dt / LAG_SECONDS;
+        turnRate += ((left - right) / TRACK_WIDTH - turnRate) * dt / LAG_SECONDS;
+        
+        pose.heading = Odometry::wrapHeading(pose.heading + turnRate * dt / Odometry::DEGREES_TO_RADIANS);
+        double radians = pose.heading * Odometry::DEGREES_TO_RADIANS;
+        double x = pose.x + speed * dt * std::sin(radians);
+        double y = pose.y + speed * dt * std::cos(radians);
+        if (touches(x, y) && !touches(pose.x, pose.y)) {
+            collision = collision || std::fabs(speed) > 5.0;
+            speed = 0.0;   // Stopped against it
+            return;
+        }
+        pose.x = x;
+        pose.y = y;
+    }
+};
+
+/**
+ * Result of driving a route
+ */
+struct RouteResult {
+    RouteFollower::Status status;
+    double seconds;
+    int replans;
+    int replanTicks;   // Ticks spent searching
+    Point end;
+};
+
+/**
+ * Drive a route in the simulator (10 ms ticks)
+ */
+RouteResult driveRoute(FieldSim& field, RouteFollower& follower, uint32_t timeoutMs) {
+    const uint32_t TICK_MS = 10;
+    uint32_t now = 1000;
+    follower.start(now, timeoutMs);
+    RouteResult result;
+    result.replanTicks = 0;
+    while (follower.isRunning()) {
+        if (field.collision) {
+            field.collision = false;
+            follower.notifyCollision(now);
+        }
+        int left;
+        int right;
+        if (follower.update(field.pose, now, left, right) == RouteFollower::REPLANNING) {
+            result.replanTicks++;
+        }
+        field.step(left, right, TICK_MS / 1000.0);
+        now += TICK_MS;
+    }
+    result.status = follower.getStatus();
+    result.seconds = (now - 1000) / 1000.0;
+    result.replans = follower.getReplanCount();
+    result.end = at(field.pose.x, field.pose.y);
+    return result;
+}
+
+void printRoute(const char* name, const RouteResult& result) {
+    std::cout << "  " << name << ": status " << result.status << ", " << result.seconds << " s, "
+              << result.replans << " replans (" << result.replanTicks << " ticks searching), end ("
+              << result.end.x << ", " << result.end.y << ")" << std::endl;
+}
+
+/**
+ * The test route: up the left side, across, and over to the right
+ */
+void addTestRoute(RouteFollower& follower) {
+    follower.clear();
+    follower.addWaypoint(at(-48, 0));
+    follower.addWaypoint(at(0, 24));
+    follower.addWaypoint(at(36, 24));
+}
+
+// ============================================
+// TEST CASES FOR ROUTE FOLLOWER
+// ============================================
+
+/**
+ * Test: Clear Route
+ * 
+ * Given: Nothing in the way
+ * When: Driving the route
+ * Then: DONE at the last waypoint, no replans
+ */
+void testRoute_ClearRoute() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    RouteFollower follower;
+    addTestRoute(follower);
+    RouteResult result = driveRoute(field, follower, 15000);
+    printRoute("Clear route", result);
+    
+    TestRunner::assertEquals(RouteFollower::DONE, result.status, "Route - Done");
+    TestRunner::assertEquals(0, result.replans, "Route - No replans");
+    TestRunner::assertNear(36.0, result.end.x, RouteFollower::ARRIVE_DISTANCE + 1.0, "Route - Ends at the last waypoint (x)");
+    TestRunner::assertNear(24.0, result.end.y, RouteFollower::ARRIVE_DISTANCE + 1.0, "Route - Ends at the last waypoint (y)");
+}
+
+/**
+ * Test: Partner Robot In The Way
+ * 
+ * Given: A robot parked on the first leg
+ * When: Driving the route
+ * Then: Blocked once, drives around it and finishes; the search never expands more than
+ *       its per-tick budget; a few seconds longer than the clear route, not the time limit
+ */
+void testRoute_DetourAroundRobot() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    field.addObstacle(-48, -22, 9.0);
+    RouteFollower follower;
+    addTestRoute(follower);
+    RouteResult result = driveRoute(field, follower, 15000);
+    printRoute("Robot in the way", result);
+    
+    TestRunner::assertEquals(RouteFollower::DONE, result.status, "Route Detour - Done");
+    TestRunner::assertEquals(1, result.replans, "Route Detour - One replan");
+    TestRunner::assertTrue(follower.getMaxTickExpansions() <= RouteFollower::EXPANSIONS_PER_TICK,
+                           "Route Detour - Search within its budget every tick");
+    TestRunner::assertTrue(result.replanTicks >= 1, "Route Detour - Searched");
+    TestRunner::assertTrue(result.seconds < 10.0, "Route Detour - Finished well before the time limit");
+}
+
+/**
+ * Test: Partner Robot Moves Away
+ * 
+ * Given: A route that was blocked by a partner robot, which has since driven off, and a
+ *        known obstacle added to the grid
+ * When: Driving the next route
+ * Then: The partner's old spot is open again (no replans, as fast as a clear route) and the
+ *       known obstacle is still there
+ */
+void testRoute_ForgetsMovedRobot() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    field.addObstacle(-48, -22, 9.0);
+    RouteFollower follower;
+    follower.getPlanner().addObstacle(at(48, -48), 6.0);
+    addTestRoute(follower);
+    RouteResult first = driveRoute(field, follower, 15000);
+    TestRunner::assertEquals(1, first.replans, "Route Moved Robot - First route blocked");
+    TestRunner::assertTrue(follower.getPlanner().isBlocked(at(-48, -22)), "Route Moved Robot - Partner marked");
+    
+    field.reset(-48, -48, 0);
+    addTestRoute(follower);
+    RouteResult second = driveRoute(field, follower, 15000);
+    printRoute("Partner moved away", second);
+    
+    TestRunner::assertEquals(RouteFollower::DONE, second.status, "Route Moved Robot - Done");
+    TestRunner::assertEquals(0, second.replans, "Route Moved Robot - No replans");
+    TestRunner::assertTrue(!follower.getPlanner().isBlocked(at(-48, -22)), "Route Moved Robot - Old spot open");
+    TestRunner::assertTrue(follower.getPlanner().isBlocked(at(48, -48)), "Route Moved Robot - Known obstacle kept");
+    TestRunner::assertTrue(second.seconds < first.seconds, "Route Moved Robot - Faster than the blocked route");
+}
+
+/**
+ * Test: Game Element On A Waypoint
+ * 
+ * Given: A game element sitting on the middle waypoint
+ * When: Driving the route
+ * Then: The waypoint is skipped and the route finishes at the last waypoint
+ */
+void testRoute_SkipsBlockedWaypoint() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    field.addObstacle(0, 26, 4.0);
+    RouteFollower follower;
+    addTestRoute(follower);
+    RouteResult result = driveRoute(field, follower, 15000);
+    printRoute("Element on a waypoint", result);
+    
+    TestRunner::assertEquals(RouteFollower::DONE, result.status, "Route Skip - Done");
+    TestRunner::assertEquals(1, result.replans, "Route Skip - One replan");
+    TestRunner::assertNear(36.0, result.end.x, RouteFollower::ARRIVE_DISTANCE + 1.0, "Route Skip - Ends at the last waypoint");
+}
+
+/**
+ * Test: No Way Through
+ * 
+ * Given: A row of robots and elements across the whole field between the robot and the goal
+ * When: Driving the route
+ * Then: FAILED after MAX_REPLANS + 1 blocks, before the time limit (instead of pushing
+ *       into the row until then)
+ */
+void testRoute_GivesUpWhenWalledOff() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    for (double x = -66; x <= 66; x += 12) {
+        field.addObstacle(x, -12, 7.0);
+    }
+    RouteFollower follower;
+    addTestRoute(follower);
+    RouteResult result = driveRoute(field, follower, 30000);
+    printRoute("Walled off", result);
+    
+    TestRunner::assertEquals(RouteFollower::FAILED, result.status, "Route Walled - Failed");
+    TestRunner::assertTrue(result.seconds < 30.0, "Route Walled - Before the time limit");
+    TestRunner::assertTrue(result.end.y < -12.0, "Route Walled - Never got through");
+}
+
+/**
+ * Test: Time Limit
+ * 
+ * Given: A route that takes a few seconds
+ * When: Driven with a 1 s limit
+ * Then: FAILED at the limit, motors at 0
+ */
+void testRoute_TimeLimit() {
+    FieldSim field;
+    field.reset(-48, -48, 0);
+    RouteFollower follower;
+    addTestRoute(follower);
+    RouteResult result = driveRoute(field, follower, 1000);
+    
+    int left = 1;
+    int right = 1;
+    follower.update(field.pose, 5000, left, right);
+    TestRunner::assertEquals(RouteFollower::FAILED, result.status, "Route Timeout - Failed");
+    TestRunner::assertNear(1.0, result.seconds, 0.011, "Route Timeout - At the limit");
+    TestRunner::assertTrue(left == 0 && right == 0, "Route Timeout - Motors stopped");
+}
+
+/**
+ * Test: Point Ahead
+ * 
+ * Given: Poses facing +y, +x (90) and -y (180)
+ * When: Asking for the point 10" ahead (and 10" behind)
+ * Then: Along the heading, compass style
+ */
+void testRoute_PointAhead() {
+    Odometry::Pose pose = {5.0, -5.0, 0.0};
+    TestRunner::assertNear(5.0, RouteFollower::pointAhead(pose, 10.0).y, 1e-9, "Point Ahead - Facing +y");
+    pose.heading = 90.0;
+    TestRunner::assertNear(15.0, RouteFollower::pointAhead(pose, 10.0).x, 1e-9, "Point Ahead - Facing +x");
+    pose.heading = 180.0;
+    TestRunner::assertNear(5.0, RouteFollower::pointAhead(pose, -10.0).y, 1e-9, "Point Ahead - Behind");
+}
+
+int main() {
+    std::cout << "=== Running RouteFollower Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testRoute_PointAhead();
+    testRoute_ClearRoute();
+    testRoute_DetourAroundRobot();
+    testRoute_ForgetsMovedRobot();
+    testRoute_SkipsBlockedWaypoint();
+    testRoute_GivesUpWhenWalledOff();
+    testRoute_TimeLimit();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * test_seqlock.cpp
+ * 
+ * Unit tests for SeqLock class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <atomic>
+#include <thread>
+
+// Include our SeqLock class to test it
+#include "../src/controllers/SeqLock.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+/**
+ * Value whose fields must always agree (a torn read breaks the pattern)
+ */
+struct Sample {
+    uint32_t counter;
+    uint32_t check[7];
+    double x;
+};
+
+Sample makeSample(uint32_t counter) {
+    Sample sample;
+    sample.counter = counter;
+    for (int i = 0; i < 7; i++) {
+        sample.check[i] = counter * (i + 3) ^ 0x5A5A5A5Au;
+    }
+    sample.x = counter * 0.5;
+    return sample;
+}
+
+bool isConsistent(const Sample& sample) {
+    for (int i = 0; i < 7; i++) {
+        if (sample.check[i] != (sample.counter * (i + 3) ^ 0x5A5A5A5Au)) {
+            return false;
+        }
+    }
+    return sample.x == sample.counter * 0.5;
+}
+
+// ============================================
+// TEST CASES FOR SEQLOCK
+// ============================================
+
+/**
+ * Test: Write Then Read
+ * Given: A seqlock
+ * When: A value is written
+ * Then: Readers get it and the version counts writes
+ */
+void testSeqLock_WriteRead() {
+    SeqLock<Sample> lock;
+    Sample out;
+    TestRunner::assertEquals(0, (int)lock.getVersion(), "SeqLock - Version 0 at start");
+    
+    lock.write(makeSample(42));
+    TestRunner::assertEqualsBool(true, lock.tryRead(out), "SeqLock - Read succeeds with no writer active");
+    TestRunner::assertEquals(42, (int)out.counter, "SeqLock - Value read back");
+    TestRunner::assertEqualsBool(true, isConsistent(out), "SeqLock - Value consistent");
+    
+    lock.write(makeSample(43));
+    TestRunner::assertEquals(2, (int)lock.getVersion(), "SeqLock - Version counts writes");
+}
+
+/**
+ * Test: Torture - One Writer, Three Readers
+ * Given: A writer thread publishing as fast as it can
+ * When: Three reader threads read continuously
+ * Then: No reader ever sees a torn value, and counters never go backward
+ */
+void testSeqLock_Torture() {
+    const uint32_t WRITES = 2000000;
+    const int READERS = 3;
+    SeqLock<Sample> lock;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backward(0);
+    std::atomic<uint32_t> reads(0);
+    
+    std::thread readers[READERS];
+    for (int r = 0; r < READERS; r++) {
+        readers[r] = std::thread([&]() {
+            uint32_t last = 0;
+            uint32_t count = 0;
+            uint32_t attempts = 0;
+            Sample out;
+            while (!done.load(std::memory_order_acquire)) {
+                if (++attempts % 16 == 0) {
+                    std::this_thread::yield();
+                }
+                if (!lock.read(out) || out.counter == 0) {
+                    continue;  // Nothing written yet (default value)
+                }
+                count++;
+                if (!isConsistent(out)) {
+                    torn++;
+                }
+                if (out.counter < last) {
+                    backward++;
+                }
+                last = out.counter;
+            }
+            reads += count;
+        });
+    }
+    
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= WRITES; i++) {
+            lock.write(makeSample(i));
+            if (i % 16 == 0) {
+                std::this_thread::yield();  // Let readers in often, even on a single core
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+    
+    writer.join();
+    for (int r = 0; r < READERS; r++) {
+        readers[r].join();
+    }
+    
+    Sample last;
+    lock.read(last);
+    std::cout << "  " << WRITES << " writes, " << reads.load() << " consistent reads" << std::endl;
+    TestRunner::assertEquals(0, (int)torn.load(), "SeqLock - No torn reads");
+    TestRunner::assertEquals(0, (int)backward.load(), "SeqLock - Readers never go backward");
+    TestRunner::assertEquals((int)WRITES, (int)last.counter, "SeqLock - Final value visible");
+    TestRunner::assertEqualsBool(true, reads.load() > 0, "SeqLock - Readers made progress");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running SeqLock Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testSeqLock_WriteRead();
+    testSeqLock_Torture();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
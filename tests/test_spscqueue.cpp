@@ -0,0 +1,273 @@
+/*
+ * test_spscqueue.cpp
+ * 
+ * Unit tests for SpscQueue class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <atomic>
+#include <thread>
+
+// Include our SpscQueue class to test it
+#include "../src/controllers/SpscQueue.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+/**
+ * Event with a payload that must match its sequence number
+ */
+struct Message {
+    uint32_t sequence;
+    uint32_t payload[3];
+};
+
+Message makeMessage(uint32_t sequence) {
+    Message message;
+    message.sequence = sequence;
+    message.payload[0] = sequence * 7;
+    message.payload[1] = ~sequence;
+    message.payload[2] = sequence ^ 0xA5A5A5A5u;
+    return message;
+}
+
+bool isConsistent(const Message& message) {
+    return message.payload[0] == message.sequence * 7 &&
+           message.payload[1] == ~message.sequence &&
+           message.payload[2] == (message.sequence ^ 0xA5A5A5A5u);
+}
+
+// ============================================
+// TEST CASES FOR SPSC QUEUE
+// ============================================
+
+/**
+ * Test: First In, First Out
+ * Given: Three pushed items
+ * When: Popped
+ * Then: Same order, then empty
+ */
+void testSpscQueue_Fifo() {
+    SpscQueue<int, 4> queue;
+    int item = 0;
+    TestRunner::assertEqualsBool(false, queue.pop(item), "SPSC Queue - Empty pop fails");
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+    TestRunner::assertEquals(3, (int)queue.size(), "SPSC Queue - Size");
+    queue.pop(item);
+    TestRunner::assertEquals(1, item, "SPSC Queue - First out");
+    queue.pop(item);
+    TestRunner::assertEquals(2, item, "SPSC Queue - Second out");
+    queue.pop(item);
+    TestRunner::assertEquals(3, item, "SPSC Queue - Third out");
+    TestRunner::assertEqualsBool(true, queue.empty(), "SPSC Queue - Empty again");
+}
+
+/**
+ * Test: Full Queue
+ * Given: A queue of 4 with 4 items
+ * When: Another push is made
+ * Then: It fails, is counted as dropped, and the queued items are untouched
+ */
+void testSpscQueue_Full() {
+    SpscQueue<int, 4> queue;
+    for (int i = 0; i < 4; i++) {
+        queue.push(i);
+    }
+    TestRunner::assertEqualsBool(false, queue.push(99), "SPSC Queue - Push to full queue fails");
+    TestRunner::assertEquals(1, (int)queue.getDroppedCount(), "SPSC Queue - Drop counted");
+    int item;
+    queue.pop(item);
+    TestRunner::assertEquals(0, item, "SPSC Queue - Oldest item kept");
+}
+
+/**
+ * Test: Wrap Around
+ * Given: A small queue
+ * When: Many more items than its capacity pass through
+ * Then: Order is kept across the wrap
+ */
+void testSpscQueue_WrapAround() {
+    SpscQueue<int, 2> queue;
+    bool ordered = true;
+    for (int i = 0; i < 1000; i++) {
+        queue.push(i);
+        int item;
+        if (!queue.pop(item) || item != i) {
+            ordered = false;
+        }
+    }
+    TestRunner::assertEqualsBool(true, ordered, "SPSC Queue - Order kept across wrap-around");
+    TestRunner::assertEquals(2, (int)SpscQueue<int, 2>::capacity(), "SPSC Queue - Capacity");
+}
+
+/**
+ * Test: Torture - Producer and Consumer Threads
+ * Given: A small queue (lots of full/empty transitions)
+ * When: A producer pushes 2 million messages (retrying when full) and a consumer pops
+ * Then: Every message arrives exactly once, in order, intact
+ */
+void testSpscQueue_Torture() {
+    const uint32_t MESSAGES = 2000000;
+    SpscQueue<Message, 64> queue;
+    uint32_t received = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t corrupt = 0;
+    
+    std::thread consumer([&]() {
+        Message message;
+        while (received < MESSAGES) {
+            if (!queue.pop(message)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (message.sequence != received) {
+                outOfOrder++;
+            }
+            if (!isConsistent(message)) {
+                corrupt++;
+            }
+            received++;
+        }
+    });
+    
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < MESSAGES; i++) {
+            while (!queue.push(makeMessage(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    producer.join();
+    consumer.join();
+    
+    std::cout << "  " << received << " messages, " << queue.getDroppedCount() << " full-queue retries" << std::endl;
+    TestRunner::assertEquals((int)MESSAGES, (int)received, "SPSC Queue - Every message received");
+    TestRunner::assertEquals(0, (int)outOfOrder, "SPSC Queue - All in order");
+    TestRunner::assertEquals(0, (int)corrupt, "SPSC Queue - No corrupt messages");
+    TestRunner::assertEqualsBool(true, queue.empty(), "SPSC Queue - Empty at the end");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running SpscQueue Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testSpscQueue_Fifo();
+    testSpscQueue_Full();
+    testSpscQueue_WrapAround();
+    testSpscQueue_Torture();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
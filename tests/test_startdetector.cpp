@@ -0,0 +1,390 @@
+/*
+ * test_startdetector.cpp
+ * 
+ * Unit tests for StartDetector class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+// Include our StartDetector class to test it
+#include "../src/controllers/StartDetector.h"
+
+// ============================================
+// START POSE SIMULATOR
+// ============================================
+
+/**
+ * Small deterministic random numbers (same placements on every run)
+ */
+struct PlaceRandom {
+    uint32_t state;
+    
+    double uniform(double low, double high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * ((state >> 8) / 16777216.0);
+    }
+};
+
+Odometry::Pose pose(double x, double y, double heading) {
+    Odometry::Pose p;
+    p.x = x;
+    p.y = y;
+    p.heading = heading;
+    return p;
+}
+
+/**
+ * The robot's sensors: left, right, back, 7" from the center
+ */
+void addSensors(StartDetector& detector) {
+    StartDetector::Mount left = {-7.0, 0.0, -90.0};
+    StartDetector::Mount right = {7.0, 0.0, 90.0};
+    StartDetector::Mount back = {0.0, -7.0, 180.0};
+    detector.addSensor(left);
+    detector.addSensor(right);
+    detector.addSensor(back);
+}
+
+/**
+ * Two routines for our alliance: left and right starting tiles, facing the field
+ */
+const int LEFT_START = 0;
+const int RIGHT_START = 1;
+
+void addStarts(StartDetector& detector) {
+    detector.addStart(pose(-36.0, -60.0, 0.0));
+    detector.addStart(pose(36.0, -60.0, 0.0));
+}
+
+/**
+ * What the sensors read with the robot at a pose
+ * 
+ * @param noise Reading noise (+/- inches)
+ * @param blocked Sensor that sees something close instead of the wall (-1 = none)
+ * @param blockedAt How far that something is (inches)
+ */
+void readSensors(const Odometry::Pose& robot, double noise, int blocked, double blockedAt,
+                 PlaceRandom& random, double distances[]) {
+    StartDetector::Mount mounts[3] = {{-7.0, 0.0, -90.0}, {7.0, 0.0, 90.0}, {0.0, -7.0, 180.0}};
+    for (int i = 0; i < 3; i++) {
+        distances[i] = StartDetector::expectedDistance(robot, mounts[i]);
+        if (distances[i] >= 0.0) {
+            distances[i] += random.uniform(-noise, noise);
+        }
+        if (i == blocked) {
+            distances[i] = blockedAt + random.uniform(-noise, noise);  // Partner robot, game element
+        }
+    }
+}
+
+/**
+ * Updates until the detector stops WAITING (at most 50)
+ * 
+ * @return Updates it took
+ */
+int detect(StartDetector& detector, const Odometry::Pose& robot, double noise, int blocked, PlaceRandom& random) {
+    double blockedAt = random.uniform(4.0, 20.0);
+    int updates = 0;
+    while (updates < 50) {
+        double distances[3];
+        readSensors(robot, noise, blocked, blockedAt, random, distances);
+        updates++;
+        if (detector.update(distances, 0.0) != StartDetector::WAITING) {
+            break;
+        }
+    }
+    return updates;
+}
+
+// ============================================
+// TEST CASES FOR START DETECTOR
+// ============================================
+
+/**
+ * Test: Expected Distances
+ * 
+ * Given: A robot at known poses
+ * When: Working out what each sensor would read
+ * Then: The distance to the wall the sensor faces, or -1 beyond MAX_RANGE
+ */
+void testStart_ExpectedDistance() {
+    StartDetector::Mount left = {-7.0, 0.0, -90.0};
+    StartDetector::Mount back = {0.0, -7.0, 180.0};
+    
+    TestRunner::assertNear(65.0, StartDetector::expectedDistance(pose(0, 0, 0), back), 0.001, "Start Distance - Back wall");
+    TestRunner::assertNear(29.0, StartDetector::expectedDistance(pose(-36, -60, 0), left), 0.001, "Start Distance - Left wall");
+    TestRunner::assertNear(65.0, StartDetector::expectedDistance(pose(0, 0, 90), left), 0.001, "Start Distance - Turned: left faces +y");
+    TestRunner::assertNear(-1.0, StartDetector::expectedDistance(pose(36, -60, 0), left), 0.001, "Start Distance - Out of range");
+}
+
+/**
+ * Test: Each Start Tile
+ * 
+ * Given: The robot placed exactly on each start pose, readings with 0.5" noise
+ * When: Updating once per reading
+ * Then: DETECTED with that start after SAMPLE_COUNT readings
+ */
+void testStart_DetectsEachTile() {
+    PlaceRandom random;
+    random.state = 7;
+    for (int s = 0; s < 2; s++) {
+        StartDetector detector;
+        addSensors(detector);
+        addStarts(detector);
+        int updates = detect(detector, pose(s == 0 ? -36.0 : 36.0, -60.0, 0.0), 0.5, -1, random);
+        
+        TestRunner::assertEquals(StartDetector::DETECTED, detector.getStatus(), "Start Tile - Detected");
+        TestRunner::assertEquals(s, detector.getStart(), "Start Tile - Right start");
+        TestRunner::assertEquals(StartDetector::SAMPLE_COUNT, updates, "Start Tile - After SAMPLE_COUNT readings");
+        TestRunner::assertTrue(detector.getError() < 1.0, "Start Tile - Small error");
+    }
+}
+
+/**
+ * Test: Facing The Wrong Way
+ * 
+ * Given: The robot on the left tile, turned to face the right side of the field
+ * When: Detecting
+ * Then: WRONG_HEADING on the left start, turned 90 degrees
+ */
+void testStart_WrongHeading() {
+    PlaceRandom random;
+    random.state = 11;
+    StartDetector detector;
+    addSensors(detector);
+    addStarts(detector);
+    detect(detector, pose(-36.0, -60.0, 90.0), 0.5, -1, random);
+    
+    TestRunner::assertEquals(StartDetector::WRONG_HEADING, detector.getStatus(), "Start Heading - Wrong heading");
+    TestRunner::assertEquals(LEFT_START, detector.getStart(), "Start Heading - Left tile");
+    TestRunner::assertNear(90.0, detector.getHeadingError(), 0.001, "Start Heading - Turned 90");
+}
+
+/**
+ * Test: Not On A Start Tile
+ * 
+ * Given: The robot in the middle of the field
+ * When: Detecting
+ * Then: UNKNOWN, no start
+ */
+void testStart_OffTileUnknown() {
+    PlaceRandom random;
+    random.state = 13;
+    StartDetector detector;
+    addSensors(detector);
+    addStarts(detector);
+    detect(detector, pose(0.0, -20.0, 0.0), 0.5, -1, random);
+    
+    TestRunner::assertEquals(StartDetector::UNKNOWN, detector.getStatus(), "Start Off Tile - Unknown");
+    TestRunner::assertEquals(-1, detector.getStart(), "Start Off Tile - No start");
+}
+
+/**
+ * Test: Robot Moved
+ * 
+ * Given: The robot detected on the left tile
+ * When: It is turned, then carried to the right tile
+ * Then: Back to WAITING when turned; the right tile SAMPLE_COUNT readings after it is put down
+ */
+void testStart_RestartsWhenMoved() {
+    PlaceRandom random;
+    random.state = 17;
+    StartDetector detector;
+    addSensors(detector);
+    addStarts(detector);
+    detect(detector, pose(-36.0, -60.0, 0.0), 0.5, -1, random);
+    TestRunner::assertEquals(LEFT_START, detector.getStart(), "Start Moved - Left first");
+    
+    double distances[3];
+    readSensors(pose(-36.0, -60.0, 0.0), 0.5, -1, 0.0, random, distances);
+    TestRunner::assertEquals(StartDetector::WAITING, detector.update(distances, 10.0), "Start Moved - Turned: waiting");
+    
+    int updates = detect(detector, pose(36.0, -60.0, 0.0), 0.5, -1, random);
+    TestRunner::assertEquals(RIGHT_START, detector.getStart(), "Start Moved - Right after");
+    TestRunner::assertEquals(StartDetector::SAMPLE_COUNT, updates, "Start Moved - SAMPLE_COUNT readings after moving");
+}
+
+/**
+ * Test: Mirror Image Starts
+ * 
+ * Given: A start pose that the field's symmetry makes look the same as another (the other
+ *        alliance's tile, turned half a turn)
+ * When: Detecting
+ * Then: UNKNOWN rather than a guess (register one alliance's routines at a time)
+ */
+void testStart_SymmetricStartsUnknown() {
+    PlaceRandom random;
+    random.state = 19;
+    StartDetector detector;
+    addSensors(detector);
+    addStarts(detector);
+    detector.addStart(pose(36.0, 60.0, 180.0));  // Left tile of the other alliance
+    detect(detector, pose(-36.0, -60.0, 0.0), 0.5, -1, random);
+    
+    TestRunner::assertEquals(StartDetector::UNKNOWN, detector.getStatus(), "Start Symmetric - Unknown");
+}
+
+/**
+ * Test: Simulated Placements
+ * 
+ * Given: 1000 placements on either tile (up to 2" and 5 degrees off), 0.5" reading noise,
+ *        one sensor in ten blocked by a partner robot, one in ten turned a quarter turn
+ * When: Detecting
+ * Then: Nearly always detected, always within SAMPLE_COUNT readings; the wrong routine or
+ *       heading only when a blocked sensor happens to read like a wall of another pose
+ *       (a turned robot with a blocked sensor: at most 1 in 200)
+ */
+void testStart_SimulatedPlacements() {
+    PlaceRandom random;
+    random.state = 2024;
+    const int PLACEMENTS = 1000;
+    int wrong = 0;
+    int decided = 0;
+    int slow = 0;
+    for (int n = 0; n < PLACEMENTS; n++) {
+        int s = (random.uniform(0.0, 1.0) < 0.5) ? LEFT_START : RIGHT_START;
+        double turn = (random.uniform(0.0, 1.0) < 0.1) ? 90.0 * (1 + (int)random.uniform(0.0, 3.0)) : 0.0;
+        Odometry::Pose robot = pose((s == LEFT_START ? -36.0 : 36.0) + random.uniform(-2.0, 2.0),
+                                    -60.0 + random.uniform(-2.0, 2.0),
+                                    Odometry::wrapHeading(turn + random.uniform(-5.0, 5.0)));
+        int blocked = (random.uniform(0.0, 1.0) < 0.1) ? (int)random.uniform(0.0, 3.0) : -1;
+        
+        StartDetector detector;
+        addSensors(detector);
+        addStarts(detector);
+        int updates = detect(detector, robot, 0.5, blocked, random);
+        slow += (updates > StartDetector::SAMPLE_COUNT) ? 1 : 0;
+        
+        StartDetector::Status status = detector.getStatus();
+        if (status == StartDetector::DETECTED || status == StartDetector::WRONG_HEADING) {
+            decided++;
+            bool right = detector.getStart() == s && std::fabs(detector.getHeadingError() - turn) < 0.001;
+            wrong += right ? 0 : 1;
+        }
+    }
+    std::cout << "  Simulated placements: " << decided << " of " << PLACEMENTS << " decided, "
+              << wrong << " wrong" << std::endl;
+    
+    TestRunner::assertTrue(wrong <= PLACEMENTS / 200, "Start Simulated - Almost never wrong");
+    TestRunner::assertTrue(decided >= PLACEMENTS * 85 / 100, "Start Simulated - Nearly always decided");
+    TestRunner::assertEquals(0, slow, "Start Simulated - Within SAMPLE_COUNT readings");
+}
+
+int main() {
+    std::cout << "=== Running StartDetector Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testStart_ExpectedDistance();
+    testStart_DetectsEachTile();
+    testStart_WrongHeading();
+    testStart_OffTileUnknown();
+    testStart_RestartsWhenMoved();
+    testStart_SymmetricStartsUnknown();
+    testStart_SimulatedPlacements();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
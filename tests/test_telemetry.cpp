@@ -0,0 +1,278 @@
+/*
+ * test_telemetry.cpp
+ * 
+ * Unit tests for Telemetry class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cstring>
+
+// Include our Telemetry class to test it
+#include "../src/controllers/Telemetry.h"
+
+// ============================================
+// TEST CASES FOR TELEMETRY
+// ============================================
+
+/**
+ * Build a monitor with drive 60 J, intake 10 J, ramp 10 J, full power ramp 20 J (1 second)
+ */
+EnergyMonitor makeMonitor() {
+    EnergyMonitor monitor;
+    monitor.addMotorSample(EnergyMonitor::DRIVE, 12.0, 5.0);
+    monitor.addMotorSample(EnergyMonitor::INTAKE, 10.0, 1.0);
+    monitor.addMotorSample(EnergyMonitor::RAMP, 10.0, 1.0);
+    monitor.addMotorSample(EnergyMonitor::FULL_POWER_RAMP, 10.0, 2.0);
+    monitor.endTick(1.0);
+    return monitor;
+}
+
+/**
+ * Test: Energy Record Layout
+ */
+void testTelemetry_EnergyRecord() {
+    EnergyMonitor monitor = makeMonitor();
+    BatteryModel battery(87.0);
+    char buffer[128];
+    
+    int length = Telemetry::formatEnergyRecord(buffer, sizeof(buffer), 15000, monitor, battery);
+    
+    TestRunner::assertTrue(std::strcmp(buffer, "ENERGY,15000,60.0,10.0,10.0,20.0,100.0,87.0,80") == 0,
+                           "Telemetry - Energy record CSV layout");
+    TestRunner::assertEquals(static_cast<int>(std::strlen(buffer)), length, "Telemetry - Returns length written");
+}
+
+/**
+ * Test: Energy Dashboard Line
+ */
+void testTelemetry_EnergyDashboard() {
+    EnergyMonitor monitor = makeMonitor();
+    char buffer[64];
+    Telemetry::formatEnergyDashboard(buffer, sizeof(buffer), monitor);
+    TestRunner::assertTrue(std::strcmp(buffer, "Drv 60% Int 10% Rmp 10% Top 20%") == 0,
+                           "Telemetry - Energy dashboard line");
+}
+
+/**
+ * Test: Battery Dashboard Line
+ */
+void testTelemetry_BatteryDashboard() {
+    BatteryModel battery(92.4);
+    battery.startMatch();
+    char buffer[64];
+    Telemetry::formatBatteryDashboard(buffer, sizeof(buffer), battery);
+    TestRunner::assertTrue(std::strcmp(buffer, "Batt 92% R 80mOhm Match 1") == 0,
+                           "Telemetry - Battery dashboard line");
+}
+
+/**
+ * Test: Latency Record
+ * 
+ * Given: Latencies of 1, 2 and 3 ms
+ * When: Format a latency record
+ * Then: Count, mean, p95 and max in microseconds
+ */
+void testTelemetry_LatencyRecord() {
+    LatencyStats stats;
+    stats.add(1000);
+    stats.add(2000);
+    stats.add(3000);
+    char buffer[96];
+    Telemetry::formatLatencyRecord(buffer, sizeof(buffer), 500, "input", stats);
+    TestRunner::assertTrue(std::strcmp(buffer, "LATENCY,500,input,3,2000,3000,3000") == 0,
+                           "Telemetry - Latency record layout");
+}
+
+/**
+ * Test: Motor Layout From The Robot Descriptor
+ * 
+ * Given: The robot descriptor
+ * When: Format the motor layout
+ * Then: Field names, then every motor name in descriptor order
+ */
+void testTelemetry_MotorLayout() {
+    char buffer[256];
+    Telemetry::formatMotorLayout(buffer, sizeof(buffer));
+    TestRunner::assertTrue(std::strcmp(buffer, "MOTORS_LAYOUT,rpm;amps;celsius,LeftFront,LeftMiddle,LeftBack,"
+                                               "RightFront,RightMiddle,RightBack,Intake,Ramp,TopWheel") == 0,
+                           "Telemetry - Motor layout from descriptor");
+}
+
+/**
+ * Test: Motor Record
+ * 
+ * Given: Speed, current and temperature for each motor
+ * When: Format a motor record
+ * Then: Three values per motor in layout order; a short buffer truncates safely
+ */
+void testTelemetry_MotorRecord() {
+    double rpm[RobotDescriptor::MOTOR_COUNT];
+    double amps[RobotDescriptor::MOTOR_COUNT];
+    double celsius[RobotDescriptor::MOTOR_COUNT];
+    for (int i = 0; i < RobotDescriptor::MOTOR_COUNT; i++) {
+        rpm[i] = 100.0 + i;
+        amps[i] = 0.5 * i;
+        celsius[i] = 30.0 + i;
+    }
+    char buffer[256];
+    Telemetry::formatMotorRecord(buffer, sizeof(buffer), 40, rpm, amps, celsius);
+    TestRunner::assertTrue(std::strncmp(buffer, "MOTORS,40,100,0.0,30,101,0.5,31,", 32) == 0,
+                           "Telemetry - Motor record starts with first motors");
+    TestRunner::assertTrue(std::strstr(buffer, ",108,4.0,38") != nullptr &&
+                           buffer[std::strlen(buffer) - 1] == '8', "Telemetry - Motor record ends with last motor");
+    
+    char shortBuffer[20];
+    int length = Telemetry::formatMotorRecord(shortBuffer, sizeof(shortBuffer), 40, rpm, amps, celsius);
+    TestRunner::assertEquals(19, length, "Telemetry - Motor record truncates safely");
+}
+
+/**
+ * Test: Small Buffer Truncates Safely
+ * 
+ * Given: A 10 byte buffer
+ * When: Format a longer line
+ * Then: 9 characters written plus '\0' (no overflow)
+ */
+void testTelemetry_Truncates() {
+    EnergyMonitor monitor = makeMonitor();
+    char buffer[16];
+    std::memset(buffer, 'X', sizeof(buffer));
+    
+    int length = Telemetry::formatEnergyDashboard(buffer, 10, monitor);
+    
+    TestRunner::assertEquals(9, length, "Telemetry - Truncated length reported");
+    TestRunner::assertTrue(buffer[9] == '\0' && buffer[10] == 'X', "Telemetry - No write past buffer");
+}
+
+/**
+ * Test: Null Buffer Is Safe
+ */
+void testTelemetry_NullBuffer() {
+    EnergyMonitor monitor;
+    TestRunner::assertEquals(0, Telemetry::formatEnergyDashboard(nullptr, 10, monitor), "Telemetry - Null buffer writes nothing");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running Telemetry Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testTelemetry_EnergyRecord();
+    testTelemetry_EnergyDashboard();
+    testTelemetry_BatteryDashboard();
+    testTelemetry_LatencyRecord();
+    testTelemetry_MotorLayout();
+    testTelemetry_MotorRecord();
+    testTelemetry_Truncates();
+    testTelemetry_NullBuffer();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,381 @@
+/*
+ * test_tipdetector.cpp
+ * 
+ * Unit tests for TipDetector class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our TipDetector class to test it
+#include "../src/controllers/TipDetector.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+const uint32_t SENSOR_PERIOD_MS = 10;  // Inertial sensor data rate (100 Hz)
+
+// Deterministic "noise": small repeating pattern
+double noiseAt(int i, double amplitude) {
+    static const double pattern[7] = {0.3, -0.8, 0.5, 1.0, -0.6, -0.2, 0.9};
+    return pattern[i % 7] * amplitude;
+}
+
+/**
+ * Simulated tip: robot pushed over from level, tilt grows like an inverted pendulum
+ * (tilt'' = w^2 * tilt). Returns how long after the push the detector warned (ms),
+ * and the tilt at that moment.
+ */
+uint32_t simulateTip(double pushRate, double& tiltAtDetection, uint32_t& crossingMs) {
+    TipDetector detector;
+    double tilt = 0.0;      // Degrees (front up)
+    double rate = 0.0;      // Degrees per second
+    const double W2 = 16.0; // Pendulum constant (1/s^2)
+    uint32_t now = 0;
+    crossingMs = 0;
+    
+    // Level for a moment, then pushed
+    for (int i = 0; i < 20; i++, now += SENSOR_PERIOD_MS) {
+        detector.update(now, noiseAt(i, 0.3), noiseAt(i + 3, 0.3), 0.0, 0.0);
+    }
+    uint32_t pushMs = now;
+    uint32_t detectedMs = 0;
+    tiltAtDetection = 0.0;
+    rate = pushRate;
+    for (int i = 0; i < 200 && crossingMs == 0; i++, now += SENSOR_PERIOD_MS) {
+        double dt = SENSOR_PERIOD_MS / 1000.0;
+        rate += W2 * tilt * dt;
+        tilt += rate * dt;
+        if (tilt >= TipDetector::TIP_ANGLE) {
+            crossingMs = now - pushMs;
+        }
+        detector.update(now, tilt + noiseAt(i, 0.3), noiseAt(i + 3, 0.3), 0.0, 0.0);
+        if (detectedMs == 0 && detector.isTipping()) {
+            detectedMs = now - pushMs;
+            tiltAtDetection = tilt;
+        }
+    }
+    return detectedMs;
+}
+
+// ============================================
+// TEST CASES FOR TIP DETECTOR
+// ============================================
+
+/**
+ * Test: Level Driving
+ * Given: Small tilt noise and normal acceleration changes
+ * When: Several seconds of readings
+ * Then: No tip and no collision events
+ */
+void testTipDetector_QuietDriving() {
+    TipDetector detector;
+    uint32_t now = 0;
+    for (int i = 0; i < 500; i++, now += SENSOR_PERIOD_MS) {
+        // Speeding up and slowing down smoothly (0.3 g over 200 ms)
+        double accel = 0.3 * std::sin(i * 0.05);
+        detector.update(now, noiseAt(i, 1.5), noiseAt(i + 2, 1.5), accel, noiseAt(i, 0.02));
+    }
+    TestRunner::assertEqualsBool(false, detector.isTipping(), "Tip Detector - No tip while driving");
+    TestRunner::assertEquals(0, detector.getEventCount(), "Tip Detector - No events while driving");
+}
+
+/**
+ * Test: Simulated Tip Detection Latency
+ * Given: Robot pushed over backward (simulated pendulum)
+ * When: The tilt grows
+ * Then: The warning comes before the tilt reaches TIP_ANGLE (prediction) and well before 25 degrees
+ */
+void testTipDetector_SimTipLatency() {
+    double tilt;
+    uint32_t crossingMs;
+    uint32_t latency = simulateTip(40.0, tilt, crossingMs);
+    std::cout << "  Tip warned " << latency << " ms after the push at " << tilt
+              << " deg (tilt reached " << TipDetector::TIP_ANGLE << " deg at " << crossingMs << " ms)" << std::endl;
+    TestRunner::assertEqualsBool(true, latency > 0, "Tip Detector - Tip detected");
+    TestRunner::assertEqualsBool(true, latency <= crossingMs, "Tip Detector - Warned no later than the threshold crossing");
+    TestRunner::assertEqualsBool(true, tilt < 20.0, "Tip Detector - Warned below 20 degrees");
+}
+
+/**
+ * Test: Fast Push
+ * Given: A hard push (fast tilt)
+ * When: Simulated
+ * Then: Still warned before the tilt reaches TIP_ANGLE
+ */
+void testTipDetector_SimFastTip() {
+    double tilt;
+    uint32_t crossingMs;
+    uint32_t latency = simulateTip(120.0, tilt, crossingMs);
+    std::cout << "  Fast tip warned " << latency << " ms after the push at " << tilt << " deg" << std::endl;
+    TestRunner::assertEqualsBool(true, latency > 0 && latency <= crossingMs, "Tip Detector - Fast tip warned in time");
+}
+
+/**
+ * Test: Correction Direction
+ * Given: Front lifting (pitch positive, tipping backward)
+ * When: Tipping is detected
+ * Then: Correction drives backward, height drop suggested, TIP_WARNING event BACK
+ */
+void testTipDetector_CorrectionBackward() {
+    TipDetector detector;
+    detector.update(0, 0.0, 0.0, 0.0, 0.0);
+    detector.update(10, 18.0, 0.0, 0.0, 0.0);
+    TestRunner::assertEqualsBool(true, detector.isTipping(), "Tip Detector - Tipping at 18 degrees");
+    TestRunner::assertEqualsBool(true, detector.getCorrectionPower() < 0, "Tip Detector - Backward tip drives backward");
+    TestRunner::assertEqualsBool(true, detector.getCorrectionPower() >= -TipDetector::MAX_CORRECTION, "Tip Detector - Correction limited");
+    TestRunner::assertEqualsBool(true, detector.shouldDropHeight(), "Tip Detector - Drop height suggested");
+    
+    TipDetector::Event event;
+    TestRunner::assertEqualsBool(true, detector.pollEvent(event), "Tip Detector - Event published");
+    TestRunner::assertEquals(TipDetector::TIP_WARNING, event.type, "Tip Detector - Tip warning event");
+    TestRunner::assertEquals(TipDetector::BACK, event.direction, "Tip Detector - Tipping backward");
+}
+
+/**
+ * Test: Forward Tip
+ * Given: Front going down (pitch negative)
+ * When: Tipping is detected
+ * Then: Correction drives forward
+ */
+void testTipDetector_CorrectionForward() {
+    TipDetector detector;
+    detector.update(0, 0.0, 0.0, 0.0, 0.0);
+    detector.update(10, -20.0, 0.0, 0.0, 0.0);
+    TestRunner::assertEqualsBool(true, detector.getCorrectionPower() > 0, "Tip Detector - Forward tip drives forward");
+}
+
+/**
+ * Test: Sideways Tip
+ * Given: Roll past the limit, detector set not to drop height
+ * When: Tipping is detected
+ * Then: No drive correction (tank drive can't move sideways), no height drop
+ */
+void testTipDetector_SidewaysNoDrop() {
+    TipDetector detector(false);
+    detector.update(0, 0.0, 0.0, 0.0, 0.0);
+    detector.update(10, 0.0, -17.0, 0.0, 0.0);
+    TestRunner::assertEqualsBool(true, detector.isTipping(), "Tip Detector - Roll tip detected");
+    TestRunner::assertEquals(0, detector.getCorrectionPower(), "Tip Detector - No drive correction sideways");
+    TestRunner::assertEqualsBool(false, detector.shouldDropHeight(), "Tip Detector - Height drop disabled");
+}
+
+/**
+ * Test: Recovery
+ * Given: Tipping
+ * When: The robot settles back below CLEAR_ANGLE
+ * Then: Tipping ends and TIP_CLEARED is published
+ */
+void testTipDetector_Cleared() {
+    TipDetector detector;
+    detector.update(0, 0.0, 0.0, 0.0, 0.0);
+    detector.update(10, 18.0, 0.0, 0.0, 0.0);
+    detector.update(20, 10.0, 0.0, 0.0, 0.0);
+    TestRunner::assertEqualsBool(true, detector.isTipping(), "Tip Detector - Still tipping at 10 degrees");
+    detector.update(30, 3.0, 0.0, 0.0, 0.0);
+    TestRunner::assertEqualsBool(false, detector.isTipping(), "Tip Detector - Cleared at 3 degrees");
+    
+    TipDetector::Event event;
+    detector.pollEvent(event);
+    detector.pollEvent(event);
+    TestRunner::assertEquals(TipDetector::TIP_CLEARED, event.type, "Tip Detector - Cleared event");
+}
+
+/**
+ * Test: Simulated Collision Latency
+ * Given: Driving forward at constant speed, then hitting a wall (sudden -1.5 g)
+ * When: Readings continue at the sensor rate
+ * Then: COLLISION (FRONT) is published on the first reading after the hit, only once
+ */
+void testTipDetector_SimCollision() {
+    TipDetector detector;
+    uint32_t now = 0;
+    for (int i = 0; i < 50; i++, now += SENSOR_PERIOD_MS) {
+        detector.update(now, noiseAt(i, 0.5), 0.0, noiseAt(i, 0.02), 0.0);
+    }
+    uint32_t hitMs = now;
+    uint32_t detectedMs = 0;
+    for (int i = 0; i < 30; i++, now += SENSOR_PERIOD_MS) {
+        double accel = (i < 5) ? -1.5 : 0.0;  // 50 ms deceleration spike
+        detector.update(now, 0.0, 0.0, accel, 0.0);
+        if (detectedMs == 0 && detector.getEventCount() > 0) {
+            detectedMs = now;
+        }
+    }
+    std::cout << "  Collision detected " << (detectedMs - hitMs) << " ms after the hit" << std::endl;
+    TestRunner::assertEqualsBool(true, detectedMs - hitMs <= SENSOR_PERIOD_MS, "Tip Detector - Collision within one reading");
+    TestRunner::assertEquals(1, detector.getEventCount(), "Tip Detector - One event per hit");
+    
+    TipDetector::Event event;
+    detector.pollEvent(event);
+    TestRunner::assertEquals(TipDetector::COLLISION, event.type, "Tip Detector - Collision event");
+    TestRunner::assertEquals(TipDetector::FRONT, event.direction, "Tip Detector - Hit on the front");
+}
+
+/**
+ * Test: Side Hit
+ * Given: A sudden push to the right (hit on the left side)
+ * When: update() is called
+ * Then: COLLISION LEFT
+ */
+void testTipDetector_SideHit() {
+    TipDetector detector;
+    detector.update(0, 0.0, 0.0, 0.0, 0.0);
+    detector.update(10, 0.0, 0.0, 0.0, 1.2);
+    TipDetector::Event event;
+    TestRunner::assertEqualsBool(true, detector.pollEvent(event), "Tip Detector - Side hit published");
+    TestRunner::assertEquals(TipDetector::LEFT, event.direction, "Tip Detector - Hit on the left");
+}
+
+/**
+ * Test: Event Overflow
+ * Given: Nobody reads events
+ * When: More than EVENT_CAPACITY are published
+ * Then: Oldest are dropped and counted, newest kept
+ */
+void testTipDetector_EventOverflow() {
+    TipDetector detector;
+    uint32_t now = 0;
+    detector.update(now, 0.0, 0.0, 0.0, 0.0);
+    int hits = TipDetector::EVENT_CAPACITY + 4;
+    for (int i = 0; i < hits; i++) {
+        // Level reading, then a hit 10 ms later
+        now += TipDetector::COLLISION_HOLDOFF_MS;
+        detector.update(now, 0.0, 0.0, 0.0, 0.0);
+        detector.update(now + SENSOR_PERIOD_MS, 0.0, 0.0, -2.0, 0.0);
+    }
+    TestRunner::assertEquals(TipDetector::EVENT_CAPACITY, detector.getEventCount(), "Tip Detector - Queue full");
+    TestRunner::assertEquals(4, detector.getDroppedEventCount(), "Tip Detector - Oldest dropped");
+    
+    TipDetector::Event event;
+    detector.pollEvent(event);
+    TestRunner::assertEquals((int)(5 * TipDetector::COLLISION_HOLDOFF_MS + SENSOR_PERIOD_MS), (int)event.timestampMs, "Tip Detector - Oldest kept is the 5th");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running TipDetector Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testTipDetector_QuietDriving();
+    testTipDetector_SimTipLatency();
+    testTipDetector_SimFastTip();
+    testTipDetector_CorrectionBackward();
+    testTipDetector_CorrectionForward();
+    testTipDetector_SidewaysNoDrop();
+    testTipDetector_Cleared();
+    testTipDetector_SimCollision();
+    testTipDetector_SideHit();
+    testTipDetector_EventOverflow();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
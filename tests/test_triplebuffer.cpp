@@ -0,0 +1,233 @@
+/*
+ * test_triplebuffer.cpp
+ * 
+ * Unit tests for TripleBuffer class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <atomic>
+#include <thread>
+
+// Include our TripleBuffer class to test it
+#include "../src/controllers/TripleBuffer.h"
+
+// ============================================
+// TEST HELPERS
+// ============================================
+
+/**
+ * Value whose fields must always agree (a torn read breaks the pattern)
+ */
+struct Frame {
+    uint32_t counter;
+    uint32_t copies[15];
+};
+
+Frame makeFrame(uint32_t counter) {
+    Frame frame;
+    frame.counter = counter;
+    for (int i = 0; i < 15; i++) {
+        frame.copies[i] = counter + i;
+    }
+    return frame;
+}
+
+bool isConsistent(const Frame& frame) {
+    for (int i = 0; i < 15; i++) {
+        if (frame.copies[i] != frame.counter + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================
+// TEST CASES FOR TRIPLE BUFFER
+// ============================================
+
+/**
+ * Test: No New Value Without a Write
+ * Given: A new buffer
+ * When: read() is called
+ * Then: It reports nothing new and gives the default value
+ */
+void testTripleBuffer_Empty() {
+    TripleBuffer<Frame> buffer;
+    Frame frame = makeFrame(7);
+    TestRunner::assertEqualsBool(false, buffer.hasNew(), "Triple Buffer - Nothing new at start");
+    TestRunner::assertEqualsBool(false, buffer.read(frame), "Triple Buffer - First read not new");
+}
+
+/**
+ * Test: Torture - Writer and Reader Threads
+ * Given: A writer thread publishing as fast as it can
+ * When: A reader thread reads continuously
+ * Then: Every value read is complete, counters never go backward, the last value arrives
+ */
+void testTripleBuffer_Torture() {
+    const uint32_t WRITES = 2000000;
+    TripleBuffer<Frame> buffer;
+    std::atomic<bool> done(false);
+    uint32_t torn = 0;
+    uint32_t backward = 0;
+    uint32_t fresh = 0;
+    uint32_t last = 0;
+    
+    std::thread reader([&]() {
+        Frame frame;
+        while (true) {
+            bool finished = done.load(std::memory_order_acquire);
+            if (buffer.read(frame)) {
+                fresh++;
+                if (!isConsistent(frame)) {
+                    torn++;
+                }
+                if (frame.counter <= last) {
+                    backward++;
+                }
+                last = frame.counter;
+            }
+            if (finished && !buffer.hasNew()) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    });
+    
+    std::thread writer([&]() {
+        for (uint32_t i = 1; i <= WRITES; i++) {
+            buffer.write(makeFrame(i));
+            if (i % 16 == 0) {
+                std::this_thread::yield();  // Let readers in often, even on a single core
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+    
+    writer.join();
+    reader.join();
+    
+    std::cout << "  " << WRITES << " writes, " << fresh << " new values seen by the reader" << std::endl;
+    TestRunner::assertEquals(0, (int)torn, "Triple Buffer - No torn reads");
+    TestRunner::assertEquals(0, (int)backward, "Triple Buffer - Each new value is newer than the last");
+    TestRunner::assertEquals((int)WRITES, (int)last, "Triple Buffer - Last write reaches the reader");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running TripleBuffer Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testTripleBuffer_Empty();
+    testTripleBuffer_Torture();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -0,0 +1,370 @@
+/*
+ * test_velocityestimator.cpp
+ * 
+ * Unit tests for VelocityEstimator class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <chrono>
+
+// Include our VelocityEstimator class to test it
+#include "../src/controllers/VelocityEstimator.h"
+
+// ============================================
+// SYNTHETIC JITTERED ENCODER TRACE
+// ============================================
+
+/**
+ * Simulated motor: the device reports a new encoder reading every 10 ms plus
+ * 0-4 ms of jitter; the control loop wakes every 20 ms plus 0-3 ms of jitter and
+ * reads whatever the latest report is (sometimes the same one as last tick).
+ */
+namespace EncoderSim {
+    // Small repeatable pseudo-random generator so the test is deterministic
+    unsigned int seed = 12345;
+    int nextRandom(int range) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 16) % range);
+    }
+    
+    // True motor speed profile: accelerate, cruise, slow down (degrees per second)
+    double trueVelocity(double t) {
+        if (t < 0.5) {
+            return 1200.0 * t / 0.5;
+        }
+        if (t < 1.5) {
+            return 1200.0;
+        }
+        return 1200.0 - 600.0 * (t - 1.5);
+    }
+    
+    // Position is the integral of trueVelocity (closed form per segment)
+    double truePosition(double t) {
+        if (t < 0.5) {
+            return 1200.0 * t * t;
+        }
+        if (t < 1.5) {
+            return 300.0 + 1200.0 * (t - 0.5);
+        }
+        double dt = t - 1.5;
+        return 1500.0 + 1200.0 * dt - 300.0 * dt * dt;
+    }
+    
+    struct Errors {
+        double estimatorRms;  // RMS error using device timestamps
+        double naiveRms;      // RMS error of (delta position) / 20 ms
+    };
+    
+    /**
+     * Run a 2.5 second trace and compare against the true velocity at each loop tick
+     * (errors are only counted after the first 100 ms so both methods have history)
+     */
+    Errors run(VelocityEstimator& estimator) {
+        const int MAX_REPORTS = 400;
+        uint32_t reportTimes[MAX_REPORTS];
+        int reportCount = 0;
+        uint32_t reportTime = 0;
+        while (reportCount < MAX_REPORTS && reportTime < 2500) {
+            reportTimes[reportCount++] = reportTime;
+            reportTime += 10 + nextRandom(5);
+        }
+        
+        double estimatorSquares = 0.0;
+        double naiveSquares = 0.0;
+        int samples = 0;
+        double lastNaivePosition = 0.0;
+        int latest = 0;
+        
+        for (uint32_t loopTime = 0; loopTime < 2500; loopTime += 20 + nextRandom(4)) {
+            // Newest report the device has sent by now
+            while (latest + 1 < reportCount && reportTimes[latest + 1] <= loopTime) {
+                latest++;
+            }
+            uint32_t deviceTime = reportTimes[latest];
+            double position = truePosition(deviceTime / 1000.0);
+            
+            estimator.addSample(deviceTime, position);
+            double naive = (position - lastNaivePosition) / 0.020;
+            lastNaivePosition = position;
+            
+            if (loopTime >= 100) {
+                double truth = trueVelocity(loopTime / 1000.0);
+                estimatorSquares += (estimator.getVelocity() - truth) * (estimator.getVelocity() - truth);
+                naiveSquares += (naive - truth) * (naive - truth);
+                samples++;
+            }
+        }
+        
+        Errors errors;
+        errors.estimatorRms = std::sqrt(estimatorSquares / samples);
+        errors.naiveRms = std::sqrt(naiveSquares / samples);
+        return errors;
+    }
+}
+
+// ============================================
+// TEST CASES FOR VELOCITY ESTIMATOR
+// ============================================
+
+/**
+ * Test: No Velocity Before Two Readings
+ */
+void testVelocity_SingleSampleIsZero() {
+    VelocityEstimator estimator;
+    estimator.addSample(100, 500.0);
+    TestRunner::assertNear(0.0, estimator.getVelocity(), 1e-9, "Velocity - Single reading gives 0");
+}
+
+/**
+ * Test: Constant Speed With Uneven Spacing Is Exact
+ * 
+ * Given: Motor at exactly 600 deg/s, readings 7, 13 and 10 ms apart
+ * When: Estimate with the Savitzky-Golay filter
+ * Then: Estimate is exactly 600 deg/s (100 RPM) - spacing doesn't matter
+ */
+void testVelocity_ConstantSpeedUnevenSpacing() {
+    VelocityEstimator estimator(VelocityEstimator::SAVITZKY_GOLAY, 4);
+    uint32_t times[] = {0, 7, 20, 30};
+    for (int i = 0; i < 4; i++) {
+        estimator.addSample(times[i], 600.0 * times[i] / 1000.0);
+    }
+    TestRunner::assertNear(600.0, estimator.getVelocity(), 1e-6, "Velocity - Exact on uneven spacing");
+    TestRunner::assertNear(100.0, estimator.getRpm(), 1e-6, "Velocity - 600 deg/s is 100 RPM");
+}
+
+/**
+ * Test: Repeated Reading Ignored
+ * 
+ * Given: Motor moving at 600 deg/s
+ * When: The control loop reads the same device reading twice
+ * Then: The repeat is rejected and the estimate is unchanged (no fake zero)
+ */
+void testVelocity_RepeatedReadingIgnored() {
+    VelocityEstimator estimator(VelocityEstimator::SAVITZKY_GOLAY, 4);
+    estimator.addSample(0, 0.0);
+    estimator.addSample(10, 6.0);
+    
+    bool accepted = estimator.addSample(10, 6.0);
+    
+    TestRunner::assertEqualsBool(false, accepted, "Velocity - Repeat reading rejected");
+    TestRunner::assertNear(600.0, estimator.getVelocity(), 1e-6, "Velocity - Estimate unchanged by repeat");
+}
+
+/**
+ * Test: Alpha-Beta Converges to Constant Speed
+ */
+void testVelocity_AlphaBetaConverges() {
+    VelocityEstimator estimator(VelocityEstimator::ALPHA_BETA, 2, 0.5, 0.2);
+    uint32_t time = 0;
+    for (int i = 0; i < 100; i++) {
+        estimator.addSample(time, -300.0 * time / 1000.0);
+        time += 9 + (i % 3) * 2;  // 9, 11, 13 ms spacing
+    }
+    TestRunner::assertNear(-300.0, estimator.getVelocity(), 1.0, "Velocity - Alpha-beta converges (reverse)");
+}
+
+/**
+ * Test: Window Size Clamped
+ * 
+ * Given: Window sizes outside 2..MAX_WINDOW
+ * When: Estimators are built
+ * Then: They still produce a correct slope (no out-of-bounds)
+ */
+void testVelocity_WindowClamped() {
+    VelocityEstimator tiny(VelocityEstimator::SAVITZKY_GOLAY, 0);
+    VelocityEstimator huge(VelocityEstimator::SAVITZKY_GOLAY, 1000);
+    for (uint32_t t = 0; t <= 400; t += 10) {
+        tiny.addSample(t, t * 1.0);
+        huge.addSample(t, t * 1.0);
+    }
+    TestRunner::assertNear(1000.0, tiny.getVelocity(), 1e-6, "Velocity - Window below 2 clamped");
+    TestRunner::assertNear(1000.0, huge.getVelocity(), 1e-6, "Velocity - Window above MAX clamped");
+}
+
+/**
+ * Test: Reset Clears History
+ */
+void testVelocity_Reset() {
+    VelocityEstimator estimator;
+    estimator.addSample(0, 0.0);
+    estimator.addSample(10, 10.0);
+    estimator.reset();
+    TestRunner::assertNear(0.0, estimator.getVelocity(), 1e-9, "Velocity - Reset clears estimate");
+}
+
+/**
+ * Test: Jittered Trace Accuracy
+ * 
+ * Given: 10 ms +/- jitter device reports, 20 ms +/- jitter control loop
+ * When: Compare both filters to the naive delta / 20 ms estimate
+ * Then: Both filters have much lower RMS error than the naive estimate
+ */
+void testVelocity_JitteredTraceAccuracy() {
+    VelocityEstimator savitzkyGolay(VelocityEstimator::SAVITZKY_GOLAY, 3);
+    VelocityEstimator alphaBeta(VelocityEstimator::ALPHA_BETA, 2, 0.6, 0.3);
+    
+    EncoderSim::seed = 12345;
+    EncoderSim::Errors sgErrors = EncoderSim::run(savitzkyGolay);
+    EncoderSim::seed = 12345;
+    EncoderSim::Errors abErrors = EncoderSim::run(alphaBeta);
+    
+    std::cout << "  RMS error (deg/s): naive " << sgErrors.naiveRms
+              << ", Savitzky-Golay " << sgErrors.estimatorRms
+              << ", alpha-beta " << abErrors.estimatorRms << std::endl;
+    
+    TestRunner::assertTrue(sgErrors.estimatorRms < sgErrors.naiveRms / 2.0,
+                           "Velocity - Savitzky-Golay at least 2x better than naive");
+    TestRunner::assertTrue(abErrors.estimatorRms < abErrors.naiveRms / 2.0,
+                           "Velocity - Alpha-beta at least 2x better than naive");
+}
+
+/**
+ * Test: Cost Per Update Under 1 Microsecond
+ * 
+ * Given: Nine motors (the whole robot) updated for 20000 ticks
+ * When: Time the updates on the host
+ * Then: Average cost per motor per tick is under 1 microsecond
+ */
+void testVelocity_CostPerUpdate() {
+    const int MOTORS = 9;
+    const int TICKS = 20000;
+    VelocityEstimator estimators[MOTORS];
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 1; tick <= TICKS; tick++) {
+        for (int m = 0; m < MOTORS; m++) {
+            estimators[m].addSample(tick * 10, tick * 3.0 + m);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    double perUpdate = nanoseconds / (MOTORS * TICKS);
+    std::cout << "  Cost per motor per tick: " << perUpdate << " ns" << std::endl;
+    TestRunner::assertTrue(perUpdate < 1000.0, "Velocity - Under 1 microsecond per motor per tick");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running VelocityEstimator Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testVelocity_SingleSampleIsZero();
+    testVelocity_ConstantSpeedUnevenSpacing();
+    testVelocity_RepeatedReadingIgnored();
+    testVelocity_AlphaBetaConverges();
+    testVelocity_WindowClamped();
+    testVelocity_Reset();
+    testVelocity_JitteredTraceAccuracy();
+    testVelocity_CostPerUpdate();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
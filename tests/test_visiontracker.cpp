@@ -0,0 +1,325 @@
+/*
+ * test_visiontracker.cpp
+ * 
+ * Unit tests for VisionTracker class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <chrono>
+
+// Include our VisionTracker class to test it
+#include "../src/controllers/VisionTracker.h"
+
+const int BALL = 1;       // Our color signature
+const int OPPONENT = 2;   // The other alliance's balls
+
+/**
+ * A round blob of a given width
+ */
+VisionTracker::Detection blob(int centerX, int centerY, int width, int signature = BALL) {
+    VisionTracker::Detection detection = {centerX, centerY, width, width, signature};
+    return detection;
+}
+
+/**
+ * Width (pixels) of a ball at a distance
+ */
+int widthAt(double distanceMm) {
+    double focalPx = (VisionTracker::IMAGE_WIDTH / 2.0) / std::tan(VisionTracker::FIELD_OF_VIEW_DEG / 2.0 * 3.14159265358979 / 180.0);
+    return (int)(VisionTracker::BALL_DIAMETER_MM * focalPx / distanceMm + 0.5);
+}
+
+// ============================================
+// TEST CASES FOR VISION TRACKER
+// ============================================
+
+/**
+ * Test: Camera Geometry
+ * 
+ * Given: The V5 vision sensor's image size and field of view
+ * When: Converting widths and columns
+ * Then: A ball's width gives its distance; the center column is straight ahead
+ *       and the edge is half the field of view
+ */
+void testTracker_Geometry() {
+    TestRunner::assertNear(1000.0, VisionTracker::distanceFromWidth(widthAt(1000.0)), 15.0, "Tracker - Distance from width");
+    TestRunner::assertNear(0.0, VisionTracker::bearingFromX(158.0), 0.001, "Tracker - Center column is straight ahead");
+    TestRunner::assertNear(30.5, VisionTracker::bearingFromX(316.0), 0.01, "Tracker - Right edge at half the field of view");
+    TestRunner::assertNear(-30.5, VisionTracker::bearingFromX(0.0), 0.01, "Tracker - Left edge is negative");
+}
+
+/**
+ * Test: Confirmation
+ * 
+ * Given: An empty tracker
+ * When: A ball is seen in one frame, then a second
+ * Then: Tracked at once, but only a target after CONFIRM_FRAMES frames
+ */
+void testTracker_Confirmation() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection frame[1] = {blob(150, 120, 40)};
+    
+    TestRunner::assertEquals(1, tracker.update(frame, 1), "Tracker - New ball tracked");
+    TestRunner::assertTrue(tracker.getTarget() == nullptr, "Tracker - Not a target after one frame");
+    tracker.update(frame, 1);
+    TestRunner::assertTrue(tracker.getTarget() != nullptr, "Tracker - Target after two frames");
+}
+
+/**
+ * Test: Same Ball Across Frames
+ * 
+ * Given: A ball moving 10 px per frame across the image
+ * When: 10 frames
+ * Then: One track with the same id, following the ball
+ */
+void testTracker_FollowsMovingBall() {
+    VisionTracker tracker(BALL);
+    int firstId = -1;
+    for (int i = 0; i < 10; i++) {
+        VisionTracker::Detection frame[1] = {blob(100 + 10 * i, 120, 40)};
+        tracker.update(frame, 1);
+        if (i == 0) {
+            firstId = tracker.getTrack(0).id;
+        }
+    }
+    
+    TestRunner::assertEquals(1, tracker.getTrackCount(), "Tracker - Still one track");
+    TestRunner::assertEquals(firstId, tracker.getTrack(0).id, "Tracker - Same id throughout");
+    TestRunner::assertNear(190.0, tracker.getTrack(0).centerX, 12.0, "Tracker - Follows the ball");
+}
+
+/**
+ * Test: Dropped After Missed Frames
+ * 
+ * Given: A confirmed target
+ * When: It is missing from frames
+ * Then: Still tracked after 2 missed frames, dropped on the 3rd
+ */
+void testTracker_DropAfterMisses() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection frame[1] = {blob(150, 120, 40)};
+    tracker.update(frame, 1);
+    tracker.update(frame, 1);
+    
+    tracker.update(frame, 0);
+    tracker.update(frame, 0);
+    TestRunner::assertTrue(tracker.getTarget() != nullptr, "Tracker - Survives 2 missed frames");
+    tracker.update(frame, 0);
+    TestRunner::assertEquals(0, tracker.getTrackCount(), "Tracker - Dropped after 3 missed frames");
+    TestRunner::assertTrue(tracker.getTarget() == nullptr, "Tracker - No target");
+}
+
+/**
+ * Test: Only Valid Balls Are Targets
+ * 
+ * Given: An opponent ball, a tiny blob and a long thin blob, all nearer than our ball
+ * When: Tracked for two frames
+ * Then: Our ball is the target
+ */
+void testTracker_ValidBallsOnly() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection frame[4] = {
+        blob(60, 150, 80, OPPONENT),
+        blob(120, 150, 4),
+        {200, 150, 90, 20, BALL},
+        blob(260, 100, 30)
+    };
+    tracker.update(frame, 4);
+    tracker.update(frame, 4);
+    
+    const VisionTracker::Track* target = tracker.getTarget();
+    TestRunner::assertTrue(target != nullptr && target->centerX > 250.0, "Tracker - Our round ball is the target");
+}
+
+/**
+ * Test: Nearest Ball, Without Flip-Flopping
+ * 
+ * Given: A target 1000 mm away
+ * When: Another ball appears at 900 mm, then it is at 700 mm
+ * Then: 900 mm is not enough to switch; 700 mm is
+ */
+void testTracker_NearestSticky() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection first[1] = {blob(100, 120, widthAt(1000.0))};
+    tracker.update(first, 1);
+    tracker.update(first, 1);
+    int firstId = tracker.getTarget()->id;
+    
+    VisionTracker::Detection both[2] = {blob(100, 120, widthAt(1000.0)), blob(220, 140, widthAt(900.0))};
+    tracker.update(both, 2);
+    tracker.update(both, 2);
+    TestRunner::assertEquals(firstId, tracker.getTarget()->id, "Tracker - 10% nearer does not switch");
+    
+    both[1] = blob(220, 140, widthAt(700.0));
+    tracker.update(both, 2);
+    tracker.update(both, 2);
+    TestRunner::assertTrue(tracker.getTarget()->id != firstId, "Tracker - Clearly nearer ball takes over");
+}
+
+/**
+ * Test: Bounded Work Per Frame
+ * 
+ * Given: A frame with 20 blobs (more than the sensor's 16)
+ * When: Processed
+ * Then: Only MAX_DETECTIONS are looked at and at most MAX_TRACKS are kept
+ */
+void testTracker_Bounded() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection frame[20];
+    for (int i = 0; i < 20; i++) {
+        frame[i] = blob(10 + 15 * i, 100, 12);
+    }
+    
+    TestRunner::assertEquals(VisionTracker::MAX_TRACKS, tracker.update(frame, 20), "Tracker - Tracks capped");
+    TestRunner::assertEquals(VisionTracker::MAX_TRACKS, tracker.update(frame, 20), "Tracker - Still capped next frame");
+}
+
+/**
+ * Test: Time Per Frame
+ * 
+ * Given: Full frames (16 blobs, 8 tracks)
+ * When: 100000 frames are processed
+ * Then: Each takes well under the 20 ms between vision frames (host time)
+ */
+void testTracker_TimePerFrame() {
+    VisionTracker tracker(BALL);
+    VisionTracker::Detection frame[VisionTracker::MAX_DETECTIONS];
+    const int FRAMES = 100000;
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int n = 0; n < FRAMES; n++) {
+        for (int i = 0; i < VisionTracker::MAX_DETECTIONS; i++) {
+            frame[i] = blob(10 + 18 * i + (n % 5), 60 + (i % 4) * 30, 14 + (i % 3));
+        }
+        tracker.update(frame, VisionTracker::MAX_DETECTIONS);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+    
+    std::cout << "  [Bench] full frame: " << ns << " ns" << std::endl;
+    TestRunner::assertTrue(ns < 50000.0, "Tracker - Full frame well under the frame period");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running VisionTracker Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testTracker_Geometry();
+    testTracker_Confirmation();
+    testTracker_FollowsMovingBall();
+    testTracker_DropAfterMisses();
+    testTracker_ValidBallsOnly();
+    testTracker_NearestSticky();
+    testTracker_Bounded();
+    testTracker_TimePerFrame();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
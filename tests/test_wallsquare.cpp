@@ -0,0 +1,360 @@
+/*
+ * test_wallsquare.cpp
+ * 
+ * Unit tests for WallSquare class following TDD principles.
+ * 
+ * TDD RED-GREEN-REFACTOR CYCLE:
+ * 1. RED: Write a test that fails (functionality doesn't exist yet)
+ * 2. GREEN: Write minimal code to make the test pass
+ * 3. REFACTOR: Improve code quality while keeping tests passing
+ * 
+ * Best Practices Followed:
+ * - Tests are independent (can run in any order)
+ * - Tests are fast (pure functions, no hardware)
+ * - Tests are descriptive (clear names explain what they test)
+ * - Tests cover edge cases (boundary conditions)
+ */
+
+
+// Include our simple test framework
+#ifndef SIMPLE_TEST_FRAMEWORK_H
+#define SIMPLE_TEST_FRAMEWORK_H
+
+#include <iostream>
+#include <string>
+#include <cassert>
+#include <cmath>
+
+// Simple test framework for demonstration
+class TestRunner {
+private:
+    static int testsPassed;
+    static int testsFailed;
+    static int testTotal;
+    
+public:
+    static void assertEquals(int expected, int actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void assertTrue(bool condition, const std::string& testName) {
+        testTotal++;
+        if (condition) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName << std::endl;
+        }
+    }
+    
+    static void assertEqualsBool(bool expected, bool actual, const std::string& testName) {
+        testTotal++;
+        if (expected == actual) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << (expected ? "true" : "false") 
+                      << ", Got: " << (actual ? "true" : "false") << ")" << std::endl;
+        }
+    }
+    
+    static void assertNear(double expected, double actual, double tolerance, const std::string& testName) {
+        testTotal++;
+        if (std::fabs(expected - actual) <= tolerance) {
+            testsPassed++;
+            std::cout << "✓ PASS: " << testName << std::endl;
+        } else {
+            testsFailed++;
+            std::cerr << "✗ FAIL: " << testName 
+                      << " (Expected: " << expected << " ± " << tolerance << ", Got: " << actual << ")" << std::endl;
+        }
+    }
+    
+    static void printResults() {
+        std::cout << "\n=== Test Results ===" << std::endl;
+        std::cout << "Total: " << testTotal << std::endl;
+        std::cout << "Passed: " << testsPassed << std::endl;
+        std::cout << "Failed: " << testsFailed << std::endl;
+        
+        if (testsFailed == 0) {
+            std::cout << "✓ All tests passed!" << std::endl;
+        } else {
+            std::cout << "✗ Some tests failed!" << std::endl;
+        }
+    }
+    
+    static int getFailedCount() {
+        return testsFailed;
+    }
+};
+
+int TestRunner::testsPassed = 0;
+int TestRunner::testsFailed = 0;
+int TestRunner::testTotal = 0;
+
+#endif // SIMPLE_TEST_FRAMEWORK_H
+
+#include <cmath>
+
+// Include our WallSquare class to test it
+#include "../src/controllers/WallSquare.h"
+
+// ============================================
+// WALL SIMULATOR
+// ============================================
+
+/**
+ * Simple model of a tank drive driving into a wall
+ * Each side moves at a speed proportional to its power until it has covered its gap
+ * to the wall, then stalls (speed 0, current up). Heading follows the difference
+ * in side travel.
+ */
+struct WallSim {
+    double gap[2];        // Inches from each side to the wall
+    double travel[2];     // Inches each side has moved
+    double rpm[2];        // Motor speed (rpm)
+    double current[2];    // Motor current (amps)
+    double startHeading;  // Degrees
+    double noise;         // Current noise amplitude (amps)
+    int tick;
+    
+    static constexpr double FREE_RPM = 200.0;         // At 100% power
+    static constexpr double FREE_CURRENT = 0.4;       // Amps while cruising
+    static constexpr double STALL_CURRENT = 2.5;      // Amps at 100% power stalled
+    static constexpr double INCHES_PER_REV = 4.0 * 3.14159265;
+    static constexpr double TRACK_WIDTH = 12.0;       // Inches between sides
+    static constexpr double LAG_SECONDS = 0.08;
+    
+    WallSim(double leftGap, double rightGap, double heading)
+        : startHeading(heading), noise(0.0), tick(0) {
+        gap[0] = leftGap;
+        gap[1] = rightGap;
+        for (int i = 0; i < 2; i++) {
+            travel[i] = 0.0;
+            rpm[i] = 0.0;
+            current[i] = 0.0;
+        }
+    }
+    
+    void step(int leftPower, int rightPower, double dt) {
+        int power[2] = {leftPower, rightPower};
+        tick++;
+        for (int i = 0; i < 2; i++) {
+            double target = FREE_RPM * power[i] / 100.0;
+            bool atWall = travel[i] >= gap[i] && power[i] > 0;
+            if (atWall) {
+                rpm[i] = 0.0;
+                current[i] = FREE_CURRENT + STALL_CURRENT * power[i] / 100.0;
+            } else {
+                double accel = (target - rpm[i]) * (dt / LAG_SECONDS);
+                rpm[i] += accel;
+                // Spin-up draws extra current (proportional to acceleration)
+                current[i] = FREE_CURRENT + std::fabs(accel) * 0.05;
+                travel[i] += rpm[i] / 60.0 * INCHES_PER_REV * dt;
+                if (travel[i] > gap[i] && power[i] > 0) {
+                    travel[i] = gap[i];
+                }
+            }
+            // Deterministic noise: alternate sign every tick
+            current[i] += ((tick + i) % 2 == 0) ? noise : -noise;
+        }
+    }
+    
+    double heading() const {
+        return startHeading + (travel[0] - travel[1]) / TRACK_WIDTH / 3.14159265 * 180.0;
+    }
+};
+
+const uint32_t TICK_MS = 20;
+
+/**
+ * Run the routine in the simulator until it stops (or 4 s)
+ */
+WallSquare::Status simulateSquare(WallSim& sim, WallSquare& square, uint32_t& elapsedMs) {
+    uint32_t now = 1000;
+    square.start(1, now);
+    int leftPower = 0, rightPower = 0;
+    WallSquare::Status status = WallSquare::APPROACH;
+    while (now < 5000) {
+        status = square.update(sim.current[0], sim.rpm[0], sim.current[1], sim.rpm[1],
+                               sim.heading(), now, leftPower, rightPower);
+        if (status != WallSquare::APPROACH) {
+            break;
+        }
+        sim.step(leftPower, rightPower, TICK_MS / 1000.0);
+        now += TICK_MS;
+    }
+    elapsedMs = now - 1000;
+    return status;
+}
+
+/**
+ * Gaps that put a robot at startHeading square to a wall at heading 0 once both sides touch
+ */
+WallSim makeAngledApproach(double startHeading, double nearGap) {
+    double difference = -startHeading / 180.0 * 3.14159265 * WallSim::TRACK_WIDTH;  // Left minus right
+    if (difference < 0.0) {
+        return WallSim(nearGap, nearGap - difference, startHeading);
+    }
+    return WallSim(nearGap + difference, nearGap, startHeading);
+}
+
+// ============================================
+// TEST CASES FOR WALL SQUARE
+// ============================================
+
+/**
+ * Test: Start State
+ * Given: A new routine
+ * When: Nothing has started
+ * Then: IDLE, no output
+ */
+void testWallSquare_Idle() {
+    WallSquare square;
+    int leftPower, rightPower;
+    TestRunner::assertEquals(WallSquare::IDLE, square.getStatus(), "Wall Square - Starts idle");
+    square.update(0, 0, 0, 0, 0, 0, leftPower, rightPower);
+    TestRunner::assertEquals(0, leftPower, "Wall Square - No output when idle");
+}
+
+/**
+ * Test: Approach Power
+ * Given: Started backward
+ * When: update() is called before contact
+ * Then: Both sides drive backward at approach power
+ */
+void testWallSquare_ApproachPower() {
+    WallSquare square;
+    int leftPower, rightPower;
+    square.start(-1, 0);
+    square.update(0.5, -60, 0.5, -60, 0, 20, leftPower, rightPower);
+    TestRunner::assertEquals(-WallSquare::APPROACH_POWER, leftPower, "Wall Square - Left drives backward");
+    TestRunner::assertEquals(-WallSquare::APPROACH_POWER, rightPower, "Wall Square - Right drives backward");
+}
+
+/**
+ * Test: Simulated Angled Approach
+ * Given: Robot 8 degrees off a wall at heading 0, left side closer
+ * When: The routine runs in the simulator
+ * Then: Left touches first and is held, both touch, heading ends square, reported aligned heading 0
+ */
+void testWallSquare_SimAngled() {
+    WallSim sim = makeAngledApproach(8.0, 10.0);
+    WallSquare square;
+    uint32_t elapsed;
+    WallSquare::Status status = simulateSquare(sim, square, elapsed);
+    
+    std::cout << "  Squared in " << elapsed << " ms, heading " << sim.heading()
+              << " (measured " << square.getMeasuredHeading() << ")" << std::endl;
+    TestRunner::assertEquals(WallSquare::SQUARED, status, "Wall Square - Angled approach squares up");
+    TestRunner::assertEquals(WallSquare::LEFT, square.getFirstContact(), "Wall Square - Closer side touches first");
+    TestRunner::assertNear(0.0, sim.heading(), 1.0, "Wall Square - Robot ends square to the wall");
+    TestRunner::assertNear(0.0, square.getAlignedHeading(), 0.001, "Wall Square - Reports wall heading 0");
+    TestRunner::assertEqualsBool(true, elapsed < 2500, "Wall Square - Finishes in under 2.5 s");
+}
+
+/**
+ * Test: Simulated Angled Approach, Other Side, Noisy Current
+ * Given: Robot at 264 degrees (right side closer) with noisy current readings
+ * When: The routine runs in the simulator
+ * Then: Right touches first, reported aligned heading 270
+ */
+void testWallSquare_SimNoisyRight() {
+    WallSim sim = makeAngledApproach(-6.0, 8.0);
+    sim.startHeading = 264.0;
+    sim.noise = 0.15;
+    WallSquare square;
+    uint32_t elapsed;
+    WallSquare::Status status = simulateSquare(sim, square, elapsed);
+    
+    TestRunner::assertEquals(WallSquare::SQUARED, status, "Wall Square - Noisy approach squares up");
+    TestRunner::assertEquals(WallSquare::RIGHT, square.getFirstContact(), "Wall Square - Right touches first");
+    TestRunner::assertNear(270.0, square.getAlignedHeading(), 0.001, "Wall Square - Reports wall heading 270");
+}
+
+/**
+ * Test: No Early Contact
+ * Given: A robot far from the wall
+ * When: It spins up (current high, speed low)
+ * Then: No contact is reported during spin-up
+ */
+void testWallSquare_NoContactDuringSpinup() {
+    WallSim sim(40.0, 40.0, 0.0);
+    WallSquare square;
+    int leftPower, rightPower;
+    uint32_t now = 0;
+    square.start(1, now);
+    for (int i = 0; i < 30; i++) {
+        square.update(sim.current[0], sim.rpm[0], sim.current[1], sim.rpm[1], 0, now, leftPower, rightPower);
+        sim.step(leftPower, rightPower, TICK_MS / 1000.0);
+        now += TICK_MS;
+    }
+    TestRunner::assertEqualsBool(false, square.hasContact(WallSquare::LEFT), "Wall Square - No false contact left");
+    TestRunner::assertEqualsBool(false, square.hasContact(WallSquare::RIGHT), "Wall Square - No false contact right");
+}
+
+/**
+ * Test: Timeout
+ * Given: No wall in reach
+ * When: The routine runs past its timeout
+ * Then: FAILED, motors off
+ */
+void testWallSquare_Timeout() {
+    WallSim sim(1000.0, 1000.0, 0.0);
+    WallSquare square;
+    uint32_t elapsed;
+    WallSquare::Status status = simulateSquare(sim, square, elapsed);
+    TestRunner::assertEquals(WallSquare::FAILED, status, "Wall Square - Fails without a wall");
+    TestRunner::assertEquals((int)WallSquare::TIMEOUT_MS, (int)elapsed, "Wall Square - Fails at the timeout");
+}
+
+/**
+ * Test: Cancel
+ * Given: A running routine
+ * When: cancel() is called
+ * Then: IDLE and no output
+ */
+void testWallSquare_Cancel() {
+    WallSquare square;
+    int leftPower, rightPower;
+    square.start(1, 0);
+    square.cancel();
+    TestRunner::assertEqualsBool(false, square.isActive(), "Wall Square - Cancelled");
+    square.update(0.5, 60, 0.5, 60, 0, 20, leftPower, rightPower);
+    TestRunner::assertEquals(0, leftPower, "Wall Square - No output after cancel");
+}
+
+// ============================================
+// MAIN TEST RUNNER
+// ============================================
+
+int main() {
+    std::cout << "=== Running WallSquare Unit Tests ===" << std::endl;
+    std::cout << "Following TDD Best Practices\n" << std::endl;
+    
+    // Run all tests
+    testWallSquare_Idle();
+    testWallSquare_ApproachPower();
+    testWallSquare_SimAngled();
+    testWallSquare_SimNoisyRight();
+    testWallSquare_NoContactDuringSpinup();
+    testWallSquare_Timeout();
+    testWallSquare_Cancel();
+    
+    // Print results
+    TestRunner::printResults();
+    
+    // Return 0 if all tests passed, 1 if any failed
+    return (TestRunner::getFailedCount() > 0) ? 1 : 0;
+}
@@ -11,6 +11,13 @@
  * 4. Build and download to robot
  */
 
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include "vex.h"  // VEX library (VEXcode includes this automatically)
 
 using namespace vex;  // Allows us to use VEX functions without typing "vex::"
@@ -115,12 +122,14 @@ public:
  * IntakeController Class
  * 
  * Handles intake and ramp motor control logic.
- * Pure functions - no hardware dependencies, fully testable!
+ * This class is designed to be easily testable - it doesn't directly control hardware.
+ * Instead, it calculates what the motors should do, and returns those values.
  */
 class IntakeController {
 public:
     /**
      * Motor power states
+     * Used to represent the desired state of a motor
      */
     enum MotorState {
         STOP = 0,      // Motor stopped
@@ -128,6 +137,19 @@ public:
         REVERSE = -1   // Motor spinning reverse (spit out/ramp down)
     };
     
+    /**
+     * Ground-speed-matched intake: the roller's surface runs this much faster than the
+     * robot drives (0.2 = 20%), so a ball it drives onto is pulled in instead of being
+     * pushed ahead or flicked off by a roller far faster than the ball
+     */
+    static constexpr double DEFAULT_OVERSPEED = 0.2;
+    
+    /**
+     * Roller surface speed on top of the matched speed (inches per second): what the
+     * roller runs at with the robot stopped, enough for a ball rolling into it
+     */
+    static constexpr double MIN_SURFACE_SPEED = 12.0;
+    
     /**
      * Calculate intake motor power
      * 
@@ -137,25 +159,35 @@ public:
      * @param powerLevel The power level (0-100) for forward/reverse, ignored for STOP
      * @return Motor power value (-100 to 100, where 0 = stop)
      */
-    static int calculateIntakePower(MotorState state, int powerLevel) {
-        // If motor should stop, return 0 regardless of power level
-        if (state == STOP) {
-            return 0;
-        }
-        
-        // Clamp power level to valid range (0-100)
-        int clampedPower = clampPowerLevel(powerLevel);
-        
-        // Return positive power for forward, negative for reverse
-        if (state == FORWARD) {
-            return clampedPower;
-        } else if (state == REVERSE) {
-            return -clampedPower;
-        }
-        
-        // Default to stop (shouldn't reach here, but safety check)
-        return 0;
-    }
+    static int calculateIntakePower(MotorState state, int powerLevel);
+    
+    /**
+     * Calculate intake motor power matched to the robot's ground speed
+     * 
+     * Pure function: FORWARD runs the roller surface at MIN_SURFACE_SPEED plus the forward
+     * ground speed times (1 + overspeed); driving backwards counts as stopped. REVERSE
+     * (spitting out) is full power. The motor's velocity control holds the speed.
+     * 
+     * @param state The desired motor state (STOP, FORWARD, REVERSE)
+     * @param groundSpeed Robot forward speed (inches per second, negative = backwards)
+     * @param maxSurfaceSpeed Roller surface speed at 100% (inches per second)
+     * @param overspeed Roller surface speed above the ground speed (0.2 = 20% faster)
+     * @return Motor power value (-100 to 100, where 0 = stop)
+     */
+    static int calculateGroundMatchedPower(MotorState state, double groundSpeed, double maxSurfaceSpeed,
+                                           double overspeed = DEFAULT_OVERSPEED);
+    
+    /**
+     * Surface speed of a wheel or roller
+     * 
+     * Pure function: works for the drive wheels (ground speed) and the intake roller
+     * 
+     * @param motorRpm Motor speed (rpm)
+     * @param diameter Wheel or roller diameter (inches)
+     * @param gearRatio Wheel turns per motor turn
+     * @return Surface speed (inches per second)
+     */
+    static double surfaceSpeed(double motorRpm, double diameter, double gearRatio);
     
     /**
      * Calculate ramp motor power
@@ -166,26 +198,18 @@ public:
      * @param powerLevel The power level (0-100) for forward/reverse, ignored for STOP
      * @return Motor power value (-100 to 100, where 0 = stop)
      */
-    static int calculateRampPower(MotorState state, int powerLevel) {
-        // Ramp motor uses same logic as intake motor
-        // If motor should stop, return 0 regardless of power level
-        if (state == STOP) {
-            return 0;
-        }
-        
-        // Clamp power level to valid range (0-100)
-        int clampedPower = clampPowerLevel(powerLevel);
-        
-        // Return positive power for forward, negative for reverse
-        if (state == FORWARD) {
-            return clampedPower;
-        } else if (state == REVERSE) {
-            return -clampedPower;
-        }
-        
-        // Default to stop (shouldn't reach here, but safety check)
-        return 0;
-    }
+    static int calculateRampPower(MotorState state, int powerLevel);
+    
+    /**
+     * Stop intaking when the robot is full
+     * 
+     * Pure function: FORWARD becomes STOP when full; REVERSE (spitting out) is always allowed
+     * 
+     * @param state The requested intake state
+     * @param full true if the robot holds as many balls as it can (see BallDetector)
+     * @return The intake state to use
+     */
+    static MotorState limitToCapacity(MotorState state, bool full);
     
     /**
      * Clamp power level to valid range
@@ -195,18 +219,88 @@ public:
      * @param powerLevel The power level to clamp
      * @return Clamped power level (0-100)
      */
-    static int clampPowerLevel(int powerLevel) {
-        // Ensure power level stays within 0-100 range
-        if (powerLevel < 0) {
-            return 0;
-        }
-        if (powerLevel > 100) {
-            return 100;
-        }
-        return powerLevel;
-    }
+    static int clampPowerLevel(int powerLevel);
 };
 
+int IntakeController::calculateIntakePower(MotorState state, int powerLevel) {
+    // If motor should stop, return 0 regardless of power level
+    if (state == STOP) {
+        return 0;
+    }
+    
+    // Clamp power level to valid range (0-100)
+    int clampedPower = clampPowerLevel(powerLevel);
+    
+    // Return positive power for forward, negative for reverse
+    if (state == FORWARD) {
+        return clampedPower;
+    } else if (state == REVERSE) {
+        return -clampedPower;
+    }
+    
+    // Default to stop (shouldn't reach here, but safety check)
+    return 0;
+}
+
+int IntakeController::calculateGroundMatchedPower(MotorState state, double groundSpeed, double maxSurfaceSpeed,
+                                                   double overspeed) {
+    // Spitting out and stopping don't depend on the ground speed
+    if (state != FORWARD) {
+        return calculateIntakePower(state, 100);
+    }
+    
+    // A ball only comes at the roller while the robot drives forward
+    double target = MIN_SURFACE_SPEED + std::fmax(0.0, groundSpeed) * (1.0 + overspeed);
+    
+    // Round up so the roller is never slower than the target
+    int power = (int)std::ceil(100.0 * target / maxSurfaceSpeed - 1e-9);
+    return calculateIntakePower(FORWARD, power);
+}
+
+double IntakeController::surfaceSpeed(double motorRpm, double diameter, double gearRatio) {
+    // Turns per second times circumference
+    return motorRpm / 60.0 * gearRatio * 3.14159265358979323846 * diameter;
+}
+
+int IntakeController::calculateRampPower(MotorState state, int powerLevel) {
+    // Ramp motor uses same logic as intake motor
+    // If motor should stop, return 0 regardless of power level
+    if (state == STOP) {
+        return 0;
+    }
+    
+    // Clamp power level to valid range (0-100)
+    int clampedPower = clampPowerLevel(powerLevel);
+    
+    // Return positive power for forward, negative for reverse
+    if (state == FORWARD) {
+        return clampedPower;
+    } else if (state == REVERSE) {
+        return -clampedPower;
+    }
+    
+    // Default to stop (shouldn't reach here, but safety check)
+    return 0;
+}
+
+IntakeController::MotorState IntakeController::limitToCapacity(MotorState state, bool full) {
+    // A full robot can't take another ball - stop instead of jamming it against the others
+    if (full && state == FORWARD) {
+        return STOP;
+    }
+    return state;
+}
+
+int IntakeController::clampPowerLevel(int powerLevel) {
+    // Ensure power level stays within 0-100 range
+    if (powerLevel < 0) {
+        return 0;
+    }
+    if (powerLevel > 100) {
+        return 100;
+    }
+    return powerLevel;
+}
 // ----------------------------------------------------------------------------
 // RampController Class
 // ----------------------------------------------------------------------------
@@ -353,219 +447,10133 @@ public:
     }
 };
 
-// ============================================================================
-// HARDWARE DECLARATIONS
-// ============================================================================
+// ----------------------------------------------------------------------------
+// PistonTravel Class
+// ----------------------------------------------------------------------------
+/**
+ * PistonTravel Class
+ * 
+ * Usage (once per control tick):
+ *   1. update() with the commanded height (a change starts a stroke)
+ *   2. confirm() when a sensor sees the pistons at an end position (optional)
+ *   3. Score only while isSettled() (ScoringProfile::update() takes it)
+ */
+class PistonTravel {
+public:
+    /**
+     * Where the pistons are
+     */
+    enum Status {
+        SETTLED,     // At the commanded end position
+        IN_TRANSIT   // Still stroking toward it
+    };
+    
+    /**
+     * Default stroke times (ms), measured at full tank pressure
+     */
+    static constexpr double DEFAULT_EXTEND_MS = 300.0;
+    static constexpr double DEFAULT_RETRACT_MS = 220.0;
+    
+    /**
+     * Weight of each confirmed stroke in the calibrated travel time
+     */
+    static constexpr double CALIBRATION_WEIGHT = 0.25;
+    
+    /**
+     * With confirmation required, a stroke the sensor never confirms is trusted
+     * after this many travel times (a broken switch must not block scoring)
+     */
+    static constexpr double CONFIRM_TIMEOUT_FACTOR = 2.0;
+    
+    /**
+     * Constructor
+     * 
+     * @param extendMs Travel time LOW to HIGH
+     * @param retractMs Travel time HIGH to LOW
+     */
+    PistonTravel(double extendMs = DEFAULT_EXTEND_MS, double retractMs = DEFAULT_RETRACT_MS);
+    
+    /**
+     * Forget any stroke: the pistons are known to be settled at a position
+     */
+    void reset(PneumaticController::HeightPosition position);
+    
+    /**
+     * Require a sensor to confirm strokes toward a position before they count as settled
+     * (a switch at one end only confirms strokes toward that end)
+     * 
+     * @param position HIGH for extends, LOW for retracts
+     * @param required true = wait for confirm()
+     */
+    void setConfirmationRequired(PneumaticController::HeightPosition position, bool required);
+    
+    /**
+     * Advance the model
+     * 
+     * A new target starts a stroke from wherever the pistons are (reversing
+     * mid-stroke only takes the distance already travelled).
+     * 
+     * @param target Commanded height
+     * @param nowMs Current time
+     * @return Current status
+     */
+    Status update(PneumaticController::HeightPosition target, uint32_t nowMs);
+    
+    /**
+     * A sensor sees the pistons at an end position
+     * Settles a stroke toward that position; a full stroke also calibrates
+     * that direction's travel time (even if the model already settled it).
+     * 
+     * @param position End position the sensor sees
+     * @param nowMs Current time
+     */
+    void confirm(PneumaticController::HeightPosition position, uint32_t nowMs);
+    
+    Status getStatus() const;
+    bool isSettled() const;
+    PneumaticController::HeightPosition getTarget() const;
+    
+    /**
+     * Piston position: 0 = fully LOW, 1 = fully HIGH
+     */
+    double getTravel() const;
+    
+    /**
+     * Time until the current stroke should end (0 when settled)
+     */
+    double getRemainingMs() const;
+    
+    /**
+     * Calibrated travel time toward a position
+     * 
+     * @param position HIGH for the extend time, LOW for the retract time
+     */
+    double getTravelMs(PneumaticController::HeightPosition position) const;
+    
+    /**
+     * Strokes used for calibration, and strokes settled without the required confirmation
+     */
+    int getCalibrationCount() const;
+    int getUnconfirmedCount() const;
+    
+    
+private:
+    double travelMs[2];  // Indexed by HeightPosition: [LOW] = retract, [HIGH] = extend
+    PneumaticController::HeightPosition target;
+    Status status;
+    bool confirmationRequired[2];  // Indexed by HeightPosition, like travelMs
+    double travel;        // 0 to 1
+    double strokeFrom;    // travel when the stroke started
+    uint32_t strokeStartMs;
+    bool fullStroke;      // Stroke started at the other end position
+    bool awaitingConfirm; // No sensor has seen the end of this stroke yet
+    int calibrationCount;
+    int unconfirmedCount;
+    
+    /**
+     * Settle at the target end position
+     */
+    void settle();
+};
 
-// Initialize the VEX Brain controller (the main robot brain)
-brain Brain;
+PistonTravel::PistonTravel(double extendMs, double retractMs)
+    : target(PneumaticController::LOW),
+      status(SETTLED),
+      confirmationRequired{false, false},
+      travel(0.0),
+      strokeFrom(0.0),
+      strokeStartMs(0),
+      fullStroke(false),
+      awaitingConfirm(false),
+      calibrationCount(0),
+      unconfirmedCount(0) {
+    travelMs[PneumaticController::LOW] = retractMs;
+    travelMs[PneumaticController::HIGH] = extendMs;
+}
 
-// MOTOR DECLARATIONS
-// Motors are named and assigned to specific ports on the V5 Brain
-// The motor groups allow us to control multiple motors together
+void PistonTravel::reset(PneumaticController::HeightPosition position) {
+    target = position;
+    awaitingConfirm = false;
+    settle();
+}
 
-// Left side motors - 3 motors that spin together to move the left side
-motor LeftFrontMotor = motor(PORT1, ratio18_1, false);  
-// motor: the type (like "int" or "string" but for VEX motors)
-// LeftFrontMotor: the variable name we'll use to control this motor
-// motor(...): the constructor that creates the motor object
-//   PORT1: physical port number on the V5 Brain (where the motor is plugged in)
-//   ratio18_1: gear ratio (18:1 means 18 motor rotations = 1 wheel rotation)
-//   false: NOT reversed (set to true if the motor spins the wrong direction)
-motor LeftMiddleMotor = motor(PORT2, ratio18_1, false);   // Port 2, middle left motor
-motor LeftBackMotor = motor(PORT3, ratio18_1, false);   // Port 3, back left motor
-motor_group LeftDrive = motor_group(LeftFrontMotor, LeftMiddleMotor, LeftBackMotor);  // Group all 3 together
+void PistonTravel::setConfirmationRequired(PneumaticController::HeightPosition position, bool required) {
+    confirmationRequired[position] = required;
+}
 
-// Right side motors - 3 motors that spin together to move the right side
-motor RightFrontMotor = motor(PORT4, ratio18_1, true);  // Port 4, reversed for opposite spin
-motor RightMiddleMotor = motor(PORT5, ratio18_1, true);  // Port 5, middle right motor, reversed
-motor RightBackMotor = motor(PORT6, ratio18_1, true);   // Port 6, back right motor, reversed
-motor_group RightDrive = motor_group(RightFrontMotor, RightMiddleMotor, RightBackMotor);  // Group all 3 together
+PistonTravel::Status PistonTravel::update(PneumaticController::HeightPosition target, uint32_t nowMs) {
+    if (target != this->target) {
+        this->target = target;
+        strokeFrom = travel;
+        strokeStartMs = nowMs;
+        fullStroke = (travel == ((target == PneumaticController::HIGH) ? 0.0 : 1.0));
+        awaitingConfirm = true;
+        status = IN_TRANSIT;
+    }
+    if (status == SETTLED) {
+        return status;
+    }
+    
+    // Constant speed over the stroke, toward the target end
+    double endTravel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    double fraction = (double)(nowMs - strokeStartMs) / travelMs[target];
+    double distance = std::fabs(endTravel - strokeFrom);
+    if (fraction >= distance) {
+        travel = endTravel;
+        if (!confirmationRequired[target]) {
+            settle();
+        } else if (fraction >= distance * CONFIRM_TIMEOUT_FACTOR) {
+            unconfirmedCount++;
+            settle();
+        }
+    } else {
+        travel = (endTravel > strokeFrom) ? strokeFrom + fraction : strokeFrom - fraction;
+    }
+    return status;
+}
 
-// INTAKE AND RAMP MOTORS (Feature 2)
-// Intake motor - collects balls from ground (5.5V motor)
-motor IntakeMotor = motor(PORT7, ratio18_1, false);  // Port 7, adjust port and reversal as needed
+void PistonTravel::confirm(PneumaticController::HeightPosition position, uint32_t nowMs) {
+    if (!awaitingConfirm || position != target) {
+        return;
+    }
+    awaitingConfirm = false;
+    
+    // Only a stroke from the other end measures the whole travel time
+    if (fullStroke) {
+        double measuredMs = (double)(nowMs - strokeStartMs);
+        travelMs[target] += (measuredMs - travelMs[target]) * CALIBRATION_WEIGHT;
+        calibrationCount++;
+    }
+    settle();
+}
 
-// Ramp motors - first two ramp wheels share one motor (5.5V motor)
-motor RampMotor = motor(PORT8, ratio18_1, false);  // Port 8, adjust port and reversal as needed
+PistonTravel::Status PistonTravel::getStatus() const {
+    return status;
+}
 
-// FULL POWER RAMP MOTOR (Feature 3)
-// Final ramp wheel - pushes balls out at top (full power motor)
-motor FullPowerRampMotor = motor(PORT9, ratio18_1, false);  // Port 9, adjust port and reversal as needed
+bool PistonTravel::isSettled() const {
+    return status == SETTLED;
+}
 
-// PNEUMATIC PISTONS (Feature 4)
-// Two pneumatic pistons control height of full power wheel
-// Note: Adjust port numbers to match your robot's wiring
-digital_out Piston1 = digital_out(Brain.ThreeWirePort.A);  // First piston
-digital_out Piston2 = digital_out(Brain.ThreeWirePort.B);  // Second piston
+PneumaticController::HeightPosition PistonTravel::getTarget() const {
+    return target;
+}
 
-// Controller - the V5 controller that the driver uses
-controller Controller1 = controller(primary);
+double PistonTravel::getTravel() const {
+    return travel;
+}
 
-// Competition object - handles autonomous and driver control periods
-competition Competition;
+double PistonTravel::getRemainingMs() const {
+    if (status == SETTLED) {
+        return 0.0;
+    }
+    double endTravel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    return std::fabs(endTravel - travel) * travelMs[target];
+}
 
-// PNEUMATIC STATE TRACKING
-// Track current height position for pneumatic pistons
-PneumaticController::HeightPosition currentHeight = PneumaticController::LOW;  // Start at low position
-bool lastToggleButtonState = false;  // Track button state to detect presses (not holds)
+double PistonTravel::getTravelMs(PneumaticController::HeightPosition position) const {
+    return travelMs[position];
+}
 
-/**
- * Initialize your robot here.
- * This function runs once when the robot starts up.
- */
-void vexcodeInit(void) {
-  // Initialize pneumatic pistons to LOW position (retracted)
-  // This ensures the robot starts at low height
-  bool initialPistonState = PneumaticController::calculatePistonState(PneumaticController::LOW);
-  Piston1.set(initialPistonState);
-  Piston2.set(initialPistonState);
-  currentHeight = PneumaticController::LOW;  // Set initial state
-  
-  // Any other initialization code goes here
-  // This is called before the competition starts
+int PistonTravel::getCalibrationCount() const {
+    return calibrationCount;
 }
 
-/**
- * AUTONOMOUS MODE
- * This function runs when the robot is in autonomous mode (no driver).
- * Write code here for your robot to run by itself.
- */
-void autonomous(void) {
-  // Example: Move forward for 2 seconds, then stop
-  LeftDrive.spin(forward, 50, percent);   // Left motors at 50% power forward
-  RightDrive.spin(forward, 50, percent);  // Right motors at 50% power forward
-  wait(2000, msec);  // Wait 2000 milliseconds (2 seconds)
-  
-  // Stop the motors
-  LeftDrive.stop();
-  RightDrive.stop();
+int PistonTravel::getUnconfirmedCount() const {
+    return unconfirmedCount;
 }
 
+void PistonTravel::settle() {
+    travel = (target == PneumaticController::HIGH) ? 1.0 : 0.0;
+    strokeFrom = travel;
+    status = SETTLED;
+}
+// ----------------------------------------------------------------------------
+// ScoringProfile Class
+// ----------------------------------------------------------------------------
 /**
- * USER CONTROL MODE (DRIVER CONTROL)
- * This function runs continuously while the driver controls the robot.
+ * ScoringProfile Class
+ * 
+ * Usage (once per control tick):
+ *   1. update() with the commanded height, the score button, whether the pistons
+ *      have settled (PistonTravel) and the wheel's measured speed
+ *   2. getWheelPower() for the full power wheel while isSpinning()
+ *   3. getFeedPower() for the ramp (held while the wheel is not ready, or while
+ *      holdForAim() says the robot is still turning to the goal)
  */
-void usercontrol(void) {
-  // This loop runs forever while the robot is in driver control mode
-  while (true) {
-    
-    // OPTION 1: TANK DRIVE
-    // Driver uses left stick for left motors, right stick for right motors
-    // This is like a tank - each side moves independently
+class ScoringProfile {
+public:
+    /**
+     * How to score at one height
+     */
+    struct Profile {
+        double wheelRpm;      // Full power wheel exit speed target
+        int feedPower;        // Ramp power while feeding balls into the wheel (percent)
+        uint32_t preSpinMs;   // Wheel spin-up before the first ball is fed
+    };
     
-    // Read controller stick values (-100 to +100)
-    int leftStickInput = Controller1.Axis3.position();   // Left stick vertical axis (Y)
-    int rightStickInput = Controller1.Axis2.position();  // Right stick vertical axis (Y)
-    // Note: Axis3 = Left stick Y, Axis2 = Right stick Y
-    // If this doesn't work, try Axis4 for right stick instead of Axis2
+    /**
+     * Profiles indexed by PneumaticController::HeightPosition (tune on the field)
+     */
+    static constexpr Profile PROFILES[2] = {
+        {140.0, 100, 200},   // LOW: flatter shot, feed as fast as the wheel takes them
+        {185.0, 70, 300}     // HIGH: faster exit, slower feed so the wheel recovers between balls
+    };
     
-    // Apply deadband to prevent drift (removes small unwanted movements)
-    leftStickInput = DriveTrain::applyDeadband(leftStickInput, 5);
-    rightStickInput = DriveTrain::applyDeadband(rightStickInput, 5);
+    /**
+     * Speed loop gain on top of the feedforward (percent per rpm of error)
+     */
+    static constexpr double VELOCITY_KP = 0.5;
     
-    // Calculate motor powers using our testable DriveTrain class
-    int leftPower, rightPower;
-    DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, leftPower, rightPower);
+    /**
+     * After a height change the wheel keeps its pre-spin this long waiting for the
+     * score button, then stops to save energy
+     */
+    static const uint32_t PRESPIN_HOLD_MS = 2000;
     
-    // Set motor speeds to calculated values
-    LeftDrive.spin(forward, leftPower, percent);   // Left motors
-    RightDrive.spin(forward, rightPower, percent); // Right motors
+    /**
+     * Constructor
+     * 
+     * @param wheelMaxRpm Free speed of the wheel's cartridge (100% power)
+     */
+    ScoringProfile(double wheelMaxRpm);
     
-    // ============================================
-    // INTAKE AND RAMP CONTROL (Feature 2)
-    // ============================================
+    /**
+     * Profile for a height
+     */
+    static const Profile& forHeight(PneumaticController::HeightPosition height);
     
-    // Intake Motor Control
-    // R1 = Intake forward (collect balls), R2 = Intake reverse (spit out)
-    IntakeController::MotorState intakeState = IntakeController::STOP;
-    if (Controller1.ButtonR1.pressing()) {
-        intakeState = IntakeController::FORWARD;  // Collect balls
-    } else if (Controller1.ButtonR2.pressing()) {
-        intakeState = IntakeController::REVERSE;  // Spit out
-    }
+    /**
+     * Advance one control tick
+     * 
+     * @param height Commanded height (a change switches profile and starts a pre-spin)
+     * @param scoreHeld Score button held
+     * @param settled Pistons have finished their stroke (PistonTravel::isSettled())
+     * @param wheelRpm Measured wheel speed
+     * @param nowMs Current time
+     */
+    void update(PneumaticController::HeightPosition height, bool scoreHeld, bool settled,
+                double wheelRpm, uint32_t nowMs);
     
-    // Calculate intake motor power using our testable IntakeController
-    int intakePower = IntakeController::calculateIntakePower(intakeState, 100);  // 100% power
-    IntakeMotor.spin(forward, intakePower, percent);
+    /**
+     * Stop spinning (pre-spin included) until the score button or a height change
+     */
+    void stop();
     
-    // Ramp Motor Control (first two wheels)
-    // L1 = Ramp forward (bring balls up), L2 = Ramp reverse (bring balls down)
-    IntakeController::MotorState rampState = IntakeController::STOP;
-    if (Controller1.ButtonL1.pressing()) {
-        rampState = IntakeController::FORWARD;  // Bring balls up
-    } else if (Controller1.ButtonL2.pressing()) {
-        rampState = IntakeController::REVERSE;  // Bring balls down
-    }
+    /**
+     * Hold the feed while auto-aim is turning to the goal (GoalAim)
+     * 
+     * @param hold true until the aim locks; false when not aiming
+     */
+    void holdForAim(bool hold);
     
-    // Calculate ramp motor power using our testable IntakeController
-    int rampPower = IntakeController::calculateRampPower(rampState, 100);  // 100% power
-    RampMotor.spin(forward, rampPower, percent);
+    /**
+     * Profile of the current height
+     */
+    const Profile& getActiveProfile() const;
+    
+    /**
+     * Wheel is spinning for a shot (score button held or pre-spinning)
+     */
+    bool isSpinning() const;
+    
+    /**
+     * Balls can be fed: spinning, pistons settled, pre-spin time done and not
+     * held for the aim
+     */
+    bool isReady() const;
+    
+    /**
+     * Full power wheel power (percent): feedforward plus speed loop while spinning, else 0
+     */
+    int getWheelPower() const;
+    
+    /**
+     * Ramp power (percent) for a requested ramp power
+     * Forward feed is held while the wheel is spinning but not ready, and scaled to
+     * the profile's feed rate once it is. Reverse, and feeding to a stopped wheel,
+     * pass through unchanged.
+     */
+    int getFeedPower(int requestedPower) const;
+    
+private:
+    double wheelMaxRpm;
+    PneumaticController::HeightPosition height;
+    bool spinning;
+    bool ready;
+    bool aimHold;
+    bool preSpinning;      // Spinning because of a height change, not the button
+    uint32_t spinStartMs;
+    uint32_t preSpinStartMs;
+    double wheelRpm;
+    
+    /**
+     * Start (or restart, for a new target) the spin-up clock
+     */
+    void startSpin(uint32_t nowMs);
+};
+
+constexpr ScoringProfile::Profile ScoringProfile::PROFILES[2];
+
+ScoringProfile::ScoringProfile(double wheelMaxRpm)
+    : wheelMaxRpm(wheelMaxRpm),
+      height(PneumaticController::LOW),
+      spinning(false),
+      ready(false),
+      aimHold(false),
+      preSpinning(false),
+      spinStartMs(0),
+      preSpinStartMs(0),
+      wheelRpm(0.0) {
+}
+
+const ScoringProfile::Profile& ScoringProfile::forHeight(PneumaticController::HeightPosition height) {
+    return PROFILES[height];
+}
+
+void ScoringProfile::update(PneumaticController::HeightPosition height, bool scoreHeld, bool settled,
+                            double wheelRpm, uint32_t nowMs) {
+    this->wheelRpm = wheelRpm;
+    
+    // New height: switch profile and spin up to it while the pistons travel
+    if (height != this->height) {
+        this->height = height;
+        preSpinning = true;
+        preSpinStartMs = nowMs;
+        startSpin(nowMs);
+    }
+    if (preSpinning && !scoreHeld && nowMs - preSpinStartMs >= PRESPIN_HOLD_MS) {
+        preSpinning = false;
+    }
+    
+    bool wasSpinning = spinning;
+    spinning = scoreHeld || preSpinning;
+    if (spinning && !wasSpinning) {
+        startSpin(nowMs);
+    }
+    
+    ready = spinning && settled && (nowMs - spinStartMs >= getActiveProfile().preSpinMs);
+}
+
+void ScoringProfile::stop() {
+    spinning = false;
+    preSpinning = false;
+    ready = false;
+}
+
+void ScoringProfile::holdForAim(bool hold) {
+    aimHold = hold;
+}
+
+const ScoringProfile::Profile& ScoringProfile::getActiveProfile() const {
+    return forHeight(height);
+}
+
+bool ScoringProfile::isSpinning() const {
+    return spinning;
+}
+
+bool ScoringProfile::isReady() const {
+    return ready && !aimHold;
+}
+
+int ScoringProfile::getWheelPower() const {
+    if (!spinning) {
+        return 0;
+    }
+    double targetRpm = getActiveProfile().wheelRpm;
+    double power = targetRpm / wheelMaxRpm * 100.0 + (targetRpm - wheelRpm) * VELOCITY_KP;
+    if (power < 0.0) {
+        return 0;  // Never brake the wheel with a ball in it
+    }
+    if (power > 100.0) {
+        return 100;
+    }
+    return (int)(power + 0.5);
+}
+
+int ScoringProfile::getFeedPower(int requestedPower) const {
+    if (requestedPower <= 0 || !spinning) {
+        return requestedPower;
+    }
+    if (!isReady()) {
+        return 0;  // Ball waits on the ramp until the wheel is at speed and height (and aimed)
+    }
+    return requestedPower * getActiveProfile().feedPower / 100;
+}
+
+void ScoringProfile::startSpin(uint32_t nowMs) {
+    spinStartMs = nowMs;
+    ready = false;
+}
+// ----------------------------------------------------------------------------
+// BallDetector Class
+// ----------------------------------------------------------------------------
+/**
+ * BallDetector Class
+ * 
+ * Usage (once per control tick, any period - readings are resampled by timestamp):
+ *   1. setWheelFeeding() - true while the ramp feeds balls into a spinning full power wheel
+ *   2. update() for the intake and the ramp with current, speed and commanded power
+ *   3. isFull() to stop intaking (IntakeController::limitToCapacity())
+ * 
+ * Counting:
+ *   - Intake forward signature: ball grabbed (+1)
+ *   - Intake reverse signature: ball spat out (-1)
+ *   - Ramp forward signature while feeding the wheel: ball scored (-1)
+ *   - Ramp signature otherwise: hand-off inside the robot (no change)
+ */
+class BallDetector {
+public:
+    /**
+     * Motors that are watched
+     */
+    enum Channel {
+        INTAKE = 0,
+        RAMP = 1,
+        CHANNEL_COUNT = 2
+    };
+    
+    /**
+     * Readings are averaged into slots this long (ms), one window entry per slot, so
+     * the window covers the same time however often update() is called. A slot with
+     * no reading (ticks slower than SAMPLE_MS) repeats the previous one.
+     */
+    static const uint32_t SAMPLE_MS = 10;
+    
+    /**
+     * Slots in the matched filter window
+     */
+    static const int WINDOW = 12;
+    
+    /**
+     * Slots of the ball signature inside the window (the rest is flat on each side)
+     */
+    static const int SIGNATURE_TICKS = 8;
+    
+    /**
+     * Units that make a current bump and a speed dip comparable
+     * (a typical grab is about 0.5 A up and 15 rpm down)
+     */
+    static constexpr double CURRENT_SCALE_AMPS = 0.5;
+    static constexpr double SPEED_SCALE_RPM = 20.0;
+    
+    /**
+     * Matched filter output that counts as a ball
+     */
+    static constexpr double DETECT_THRESHOLD = 1.0;
+    
+    /**
+     * Two balls can't go through one motor closer together than this (ms)
+     */
+    static const uint32_t MIN_GAP_MS = 150;
+    
+    /**
+     * A commanded power this far (percent) from the last update's is a step: the motor's
+     * velocity loop catching up looks just like a ball, so the window waits for the speed
+     * to settle and then moves its older readings to the new level. Gradual changes (the
+     * ground-speed-matched intake following the drive) need nothing: the filter is blind
+     * to a steady ramp.
+     */
+    static const int POWER_CHANGE = 10;
+    
+    /**
+     * After a step, the speed has settled once the signal changes less than this per
+     * slot (in CURRENT/SPEED_SCALE units)
+     */
+    static constexpr double SETTLED_CHANGE = 0.05;
+    
+    /**
+     * Longest wait for the speed to settle after a step (ms)
+     */
+    static const uint32_t SETTLE_MS = 200;
+    
+    /**
+     * Readings are ignored this long after the motor starts or changes direction (ms)
+     */
+    static const uint32_t SPINUP_MS = 200;
+    
+    /**
+     * Below this speed the motor is stalled or stopped, not handling a ball (rpm)
+     */
+    static constexpr double MIN_RUNNING_RPM = 20.0;
+    
+    /**
+     * Balls the robot holds when full (tune to the robot)
+     */
+    static const int DEFAULT_CAPACITY = 3;
+    
+    /**
+     * Constructor
+     * 
+     * @param capacity Balls the robot holds when full
+     */
+    BallDetector(int capacity = DEFAULT_CAPACITY);
+    
+    /**
+     * Start over with a known count (e.g. 1 preload at the start of a match)
+     */
+    void reset(int balls = 0);
+    
+    /**
+     * Ramp detections are balls leaving through the full power wheel
+     */
+    void setWheelFeeding(bool feeding);
+    
+    /**
+     * Add one reading for a motor
+     * 
+     * @param channel INTAKE or RAMP
+     * @param amps Motor current
+     * @param rpm Motor speed
+     * @param power Commanded power (percent, sign = direction)
+     * @param nowMs Current time
+     * @return true if a ball was detected on this call
+     */
+    bool update(Channel channel, double amps, double rpm, int power, uint32_t nowMs);
+    
+    /**
+     * Approximate balls in the robot (0 to capacity)
+     */
+    int getCount() const;
+    int getCapacity() const;
+    bool isFull() const;
+    
+    /**
+     * Balls detected on a motor since the last reset()
+     */
+    int getDetectionCount(Channel channel) const;
+    
+    /**
+     * Latest matched filter output for a motor (for tuning DETECT_THRESHOLD)
+     */
+    double getScore(Channel channel) const;
+    
+private:
+    /**
+     * One motor's recent readings
+     */
+    struct ChannelState {
+        double signal[WINDOW];  // Ring buffer of current bump + speed dip, one per slot
+        int next;               // Where the next slot goes
+        int filled;
+        uint32_t slot;          // Slot being filled (SAMPLE_MS steps since runningSinceMs)
+        double slotSum;         // Readings in it so far
+        int slotReadings;
+        int direction;          // Sign of the commanded power
+        int power;              // Commanded power at the last update
+        bool settling;          // Waiting for the speed to settle after a step
+        uint32_t settleStartMs;
+        bool settleHasValue;    // settleValue/settleSlot are valid
+        double settleValue;     // Last finished slot while settling
+        uint32_t settleSlot;
+        uint32_t runningSinceMs;
+        uint32_t lastDetectMs;
+        bool detected;          // Has ever detected (lastDetectMs is valid)
+        double score;
+        double lastScore;
+        int detections;
+    };
+    
+    double weights[WINDOW];   // Matched filter (zero mean, unit length)
+    ChannelState channels[CHANNEL_COUNT];
+    int capacity;
+    int count;
+    bool wheelFeeding;
+    
+    /**
+     * Forget a motor's readings (it stopped or changed direction)
+     */
+    void restart(ChannelState& state, int power, uint32_t nowMs);
+    
+    /**
+     * Check a finished slot while settling after a step; once settled, moves the window's
+     * readings to the new level
+     * 
+     * @return true if settled (the slot goes into the window)
+     */
+    bool settle(ChannelState& state, double value, uint32_t nowMs);
+    
+    /**
+     * Add a finished slot to the window and look for a ball
+     * 
+     * @return true if a ball was detected
+     */
+    bool addSlot(Channel channel, double value, uint32_t nowMs);
+    
+    /**
+     * Change the count by one ball, kept within 0 to capacity
+     */
+    void addBalls(int change);
+};
+
+BallDetector::BallDetector(int capacity)
+    : capacity(capacity),
+      count(0),
+      wheelFeeding(false) {
+    // Half-sine bump in the middle of the window, flat on each side. Removing the mean
+    // makes the filter blind to the motor's steady current and speed, and scaling to
+    // unit length makes the output the bump's size in CURRENT/SPEED_SCALE units.
+    const double PI = 3.14159265358979;
+    int flat = (WINDOW - SIGNATURE_TICKS) / 2;
+    double mean = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        int k = i - flat;
+        weights[i] = (k >= 0 && k < SIGNATURE_TICKS) ? std::sin(PI * (k + 0.5) / SIGNATURE_TICKS) : 0.0;
+        mean += weights[i] / WINDOW;
+    }
+    double length = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        weights[i] -= mean;
+        length += weights[i] * weights[i];
+    }
+    length = std::sqrt(length);
+    for (int i = 0; i < WINDOW; i++) {
+        weights[i] /= length;
+    }
+    
+    reset();
+}
+
+void BallDetector::reset(int balls) {
+    count = 0;
+    addBalls(balls);
+    for (int c = 0; c < CHANNEL_COUNT; c++) {
+        restart(channels[c], 0, 0);
+        channels[c].detected = false;
+        channels[c].lastDetectMs = 0;
+        channels[c].detections = 0;
+    }
+}
+
+void BallDetector::setWheelFeeding(bool feeding) {
+    wheelFeeding = feeding;
+}
+
+bool BallDetector::update(Channel channel, double amps, double rpm, int power, uint32_t nowMs) {
+    ChannelState& state = channels[channel];
+    int direction = (power > 0) ? 1 : (power < 0) ? -1 : 0;
+    
+    // Stopped, stalled, or reversed: the readings are speed changes, not balls
+    bool reversed = direction != state.direction;
+    if (reversed || direction == 0 || std::fabs(rpm) < MIN_RUNNING_RPM) {
+        if (reversed || state.filled > 0) {
+            restart(state, power, nowMs);
+        }
+        return false;
+    }
+    
+    // A step in the command: hold the window until the speed settles at the new level
+    if (std::abs(power - state.power) > POWER_CHANGE && state.filled > 0) {
+        state.settling = true;
+        state.settleStartMs = nowMs;
+        state.settleHasValue = false;
+    }
+    state.power = power;
+    
+    // A reading in a later slot finishes the current one (and repeats it over any slots
+    // that got no reading), then starts its own
+    uint32_t slot = (nowMs - state.runningSinceMs) / SAMPLE_MS;
+    bool hit = false;
+    if (state.slotReadings > 0 && slot > state.slot) {
+        double value = state.slotSum / state.slotReadings;
+        if (!state.settling || settle(state, value, nowMs)) {
+            uint32_t finished = slot - state.slot;
+            for (uint32_t i = 0; i < finished && i < (uint32_t)WINDOW; i++) {
+                hit = addSlot(channel, value, nowMs) || hit;
+            }
+        }
+        state.slotSum = 0.0;
+        state.slotReadings = 0;
+    }
+    state.slot = slot;
+    state.slotSum += std::fabs(amps) / CURRENT_SCALE_AMPS - std::fabs(rpm) / SPEED_SCALE_RPM;
+    state.slotReadings++;
+    return hit;
+}
+
+bool BallDetector::addSlot(Channel channel, double value, uint32_t nowMs) {
+    ChannelState& state = channels[channel];
+    state.signal[state.next] = value;
+    state.next = (state.next + 1) % WINDOW;
+    if (state.filled < WINDOW) {
+        state.filled++;
+    }
+    if (state.filled < WINDOW || nowMs - state.runningSinceMs < SPINUP_MS) {
+        return false;
+    }
+    
+    // Matched filter over the window, oldest slot first
+    state.lastScore = state.score;
+    state.score = 0.0;
+    for (int i = 0; i < WINDOW; i++) {
+        state.score += weights[i] * state.signal[(state.next + i) % WINDOW];
+    }
+    
+    // A ball is the peak of the filter output (the slot after it starts falling)
+    bool peak = state.lastScore >= DETECT_THRESHOLD && state.score < state.lastScore;
+    bool tooSoon = state.detected && nowMs - state.lastDetectMs < MIN_GAP_MS;
+    if (!peak || tooSoon) {
+        return false;
+    }
+    
+    state.detected = true;
+    state.lastDetectMs = nowMs;
+    state.detections++;
+    if (channel == INTAKE) {
+        addBalls(state.direction);  // Grabbed, or spat out
+    } else if (state.direction > 0 && wheelFeeding) {
+        addBalls(-1);               // Fed into the full power wheel and scored
+    }
+    return true;
+}
+
+int BallDetector::getCount() const {
+    return count;
+}
+
+int BallDetector::getCapacity() const {
+    return capacity;
+}
+
+bool BallDetector::isFull() const {
+    return count >= capacity;
+}
+
+int BallDetector::getDetectionCount(Channel channel) const {
+    return channels[channel].detections;
+}
+
+double BallDetector::getScore(Channel channel) const {
+    return channels[channel].score;
+}
+
+bool BallDetector::settle(ChannelState& state, double value, uint32_t nowMs) {
+    // Settled once the signal stops changing (slots without a reading count as steps too)
+    bool steady = state.settleHasValue &&
+                  std::fabs(value - state.settleValue) <= SETTLED_CHANGE * (state.slot - state.settleSlot);
+    state.settleHasValue = true;
+    state.settleValue = value;
+    state.settleSlot = state.slot;
+    if (!steady && nowMs - state.settleStartMs < SETTLE_MS) {
+        return false;
+    }
+    
+    // The filter ignores a constant level but not a step: move the readings from before
+    // the step to the new level so only what comes next can look like a ball
+    double shift = value - state.signal[(state.next + WINDOW - 1) % WINDOW];
+    for (int i = 0; i < WINDOW; i++) {
+        state.signal[i] += shift;
+    }
+    state.settling = false;
+    return true;
+}
+
+void BallDetector::restart(ChannelState& state, int power, uint32_t nowMs) {
+    for (int i = 0; i < WINDOW; i++) {
+        state.signal[i] = 0.0;
+    }
+    state.next = 0;
+    state.filled = 0;
+    state.slot = 0;
+    state.slotSum = 0.0;
+    state.slotReadings = 0;
+    state.direction = (power > 0) ? 1 : (power < 0) ? -1 : 0;
+    state.power = power;
+    state.settling = false;
+    state.settleStartMs = nowMs;
+    state.settleHasValue = false;
+    state.settleValue = 0.0;
+    state.settleSlot = 0;
+    state.runningSinceMs = nowMs;
+    state.score = 0.0;
+    state.lastScore = 0.0;
+}
+
+void BallDetector::addBalls(int change) {
+    count += change;
+    if (count < 0) {
+        count = 0;
+    }
+    if (count > capacity) {
+        count = capacity;
+    }
+}
+// ----------------------------------------------------------------------------
+// VisionTracker Class
+// ----------------------------------------------------------------------------
+/**
+ * VisionTracker Class
+ * 
+ * Usage (once per vision frame):
+ *   1. update() with the frame's detections
+ *   2. getTarget() for the nearest valid ball (nullptr if there is none)
+ */
+class VisionTracker {
+public:
+    /**
+     * One blob from the vision sensor (pixels, origin top left)
+     */
+    struct Detection {
+        int centerX;
+        int centerY;
+        int width;
+        int height;
+        int signature;  // Color signature id
+    };
+    
+    /**
+     * A ball followed across frames
+     */
+    struct Track {
+        int id;               // Stays the same while the ball is tracked
+        double centerX;       // Smoothed (pixels)
+        double centerY;
+        double width;
+        double height;
+        int signature;
+        int hits;             // Frames it was seen in
+        int misses;           // Frames in a row it was not seen
+        double distanceMm;    // From the camera, worked out from the width
+        double bearingDeg;    // Right of the camera axis is positive
+    };
+    
+    /**
+     * Camera (V5 vision sensor: 316 x 212 pixels, about 61 degrees wide)
+     */
+    static const int IMAGE_WIDTH = 316;
+    static const int IMAGE_HEIGHT = 212;
+    static constexpr double FIELD_OF_VIEW_DEG = 61.0;
+    
+    /**
+     * Game ball diameter (mm)
+     */
+    static constexpr double BALL_DIAMETER_MM = 160.0;
+    
+    /**
+     * Limits that bound the work per frame (the sensor reports at most 16 objects)
+     */
+    static const int MAX_DETECTIONS = 16;
+    static const int MAX_TRACKS = 8;
+    
+    /**
+     * A detection this close (pixels) to a track's center is that ball
+     */
+    static constexpr double MATCH_GATE_PX = 40.0;
+    
+    /**
+     * Weight of each new frame in a track's smoothed position and size
+     */
+    static constexpr double SMOOTHING = 0.5;
+    
+    /**
+     * Frames a track must be seen in before it can be a target,
+     * and missed frames in a row before it is dropped
+     */
+    static const int CONFIRM_FRAMES = 2;
+    static const int DROP_AFTER_MISSES = 3;
+    
+    /**
+     * Shape checks for a valid ball (smaller blobs are noise; balls are round)
+     */
+    static const int MIN_WIDTH_PX = 6;
+    static constexpr double MAX_ASPECT = 1.6;
+    
+    /**
+     * Another ball must be this much nearer to take over as the target
+     */
+    static constexpr double SWITCH_MARGIN = 0.8;
+    
+    /**
+     * Constructor
+     * 
+     * @param ballSignature Color signature of the balls to pick up
+     */
+    VisionTracker(int ballSignature);
+    
+    /**
+     * Forget every track (start of a new pickup)
+     */
+    void reset();
+    
+    /**
+     * Change the color of the balls to pick up
+     */
+    void setBallSignature(int signature);
+    
+    /**
+     * Process one frame
+     * 
+     * @param detections Blobs in the frame (only the first MAX_DETECTIONS are used)
+     * @param count Number of blobs
+     * @return Number of tracks after the frame
+     */
+    int update(const Detection* detections, int count);
+    
+    /**
+     * Nearest valid ball (sticks to the current one unless another is clearly nearer)
+     * 
+     * @return The target track, or nullptr if no valid ball is tracked
+     */
+    const Track* getTarget() const;
+    
+    int getTrackCount() const;
+    const Track& getTrack(int index) const;
+    
+    /**
+     * A confirmed, round ball of the right color
+     */
+    bool isValidBall(const Track& track) const;
+    
+    /**
+     * Distance to a ball from its width in the image (pinhole camera)
+     */
+    static double distanceFromWidth(double widthPx);
+    
+    /**
+     * Bearing of an image column from the camera axis (degrees, right positive)
+     */
+    static double bearingFromX(double centerX);
+    
+private:
+    Track tracks[MAX_TRACKS];
+    int trackCount;
+    int nextId;
+    int ballSignature;
+    int targetId;   // -1 = no target
+    
+    /**
+     * Pick the target after a frame
+     */
+    void selectTarget();
+    
+    /**
+     * Index of the track with an id, or -1
+     */
+    int findTrack(int id) const;
+};
+
+VisionTracker::VisionTracker(int ballSignature)
+    : trackCount(0),
+      nextId(1),
+      ballSignature(ballSignature),
+      targetId(-1) {
+}
+
+void VisionTracker::reset() {
+    trackCount = 0;
+    targetId = -1;
+}
+
+void VisionTracker::setBallSignature(int signature) {
+    ballSignature = signature;
+    selectTarget();
+}
+
+int VisionTracker::update(const Detection* detections, int count) {
+    if (count > MAX_DETECTIONS) {
+        count = MAX_DETECTIONS;
+    }
+    
+    // Greedy nearest match: each track takes the closest free detection of its color
+    bool used[MAX_DETECTIONS] = {false};
+    for (int t = 0; t < trackCount; t++) {
+        Track& track = tracks[t];
+        int best = -1;
+        double bestDistance = MATCH_GATE_PX;
+        for (int d = 0; d < count; d++) {
+            if (used[d] || detections[d].signature != track.signature) {
+                continue;
+            }
+            double dx = detections[d].centerX - track.centerX;
+            double dy = detections[d].centerY - track.centerY;
+            double distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < bestDistance) {
+                best = d;
+                bestDistance = distance;
+            }
+        }
+        
+        if (best < 0) {
+            track.misses++;
+            continue;
+        }
+        used[best] = true;
+        const Detection& seen = detections[best];
+        track.centerX += (seen.centerX - track.centerX) * SMOOTHING;
+        track.centerY += (seen.centerY - track.centerY) * SMOOTHING;
+        track.width += (seen.width - track.width) * SMOOTHING;
+        track.height += (seen.height - track.height) * SMOOTHING;
+        track.hits++;
+        track.misses = 0;
+    }
+    
+    // Drop tracks that have been missing too long (keep the array packed)
+    int kept = 0;
+    for (int t = 0; t < trackCount; t++) {
+        if (tracks[t].misses < DROP_AFTER_MISSES) {
+            tracks[kept++] = tracks[t];
+        }
+    }
+    trackCount = kept;
+    
+    // New tracks for unmatched detections while there is room
+    for (int d = 0; d < count && trackCount < MAX_TRACKS; d++) {
+        if (used[d]) {
+            continue;
+        }
+        Track& track = tracks[trackCount++];
+        track.id = nextId++;
+        track.centerX = detections[d].centerX;
+        track.centerY = detections[d].centerY;
+        track.width = detections[d].width;
+        track.height = detections[d].height;
+        track.signature = detections[d].signature;
+        track.hits = 1;
+        track.misses = 0;
+    }
+    
+    for (int t = 0; t < trackCount; t++) {
+        tracks[t].distanceMm = distanceFromWidth(tracks[t].width);
+        tracks[t].bearingDeg = bearingFromX(tracks[t].centerX);
+    }
+    selectTarget();
+    return trackCount;
+}
+
+const VisionTracker::Track* VisionTracker::getTarget() const {
+    int index = findTrack(targetId);
+    return (index < 0) ? nullptr : &tracks[index];
+}
+
+int VisionTracker::getTrackCount() const {
+    return trackCount;
+}
+
+const VisionTracker::Track& VisionTracker::getTrack(int index) const {
+    return tracks[index];
+}
+
+bool VisionTracker::isValidBall(const Track& track) const {
+    if (track.signature != ballSignature || track.hits < CONFIRM_FRAMES || track.width < MIN_WIDTH_PX) {
+        return false;
+    }
+    double aspect = (track.height > 0.0) ? track.width / track.height : MAX_ASPECT + 1.0;
+    return aspect <= MAX_ASPECT && aspect >= 1.0 / MAX_ASPECT;
+}
+
+double VisionTracker::distanceFromWidth(double widthPx) {
+    const double PI = 3.14159265358979;
+    double focalPx = (IMAGE_WIDTH / 2.0) / std::tan(FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+    return BALL_DIAMETER_MM * focalPx / ((widthPx > 1.0) ? widthPx : 1.0);
+}
+
+double VisionTracker::bearingFromX(double centerX) {
+    const double PI = 3.14159265358979;
+    double focalPx = (IMAGE_WIDTH / 2.0) / std::tan(FIELD_OF_VIEW_DEG / 2.0 * PI / 180.0);
+    return std::atan((centerX - IMAGE_WIDTH / 2.0) / focalPx) * 180.0 / PI;
+}
+
+void VisionTracker::selectTarget() {
+    int current = findTrack(targetId);
+    if (current >= 0 && !isValidBall(tracks[current])) {
+        current = -1;
+    }
+    
+    int nearest = -1;
+    for (int t = 0; t < trackCount; t++) {
+        if (isValidBall(tracks[t]) && (nearest < 0 || tracks[t].distanceMm < tracks[nearest].distanceMm)) {
+            nearest = t;
+        }
+    }
+    
+    // Keep chasing the same ball unless another one is clearly nearer
+    if (current >= 0 && nearest >= 0 && tracks[nearest].distanceMm > tracks[current].distanceMm * SWITCH_MARGIN) {
+        nearest = current;
+    }
+    targetId = (nearest < 0) ? -1 : tracks[nearest].id;
+}
+
+int VisionTracker::findTrack(int id) const {
+    for (int t = 0; t < trackCount; t++) {
+        if (tracks[t].id == id) {
+            return t;
+        }
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// BallPursuit Class
+// ----------------------------------------------------------------------------
+/**
+ * BallPursuit Class
+ * 
+ * Usage:
+ *   1. start() with a time limit
+ *   2. update() every vision frame with the tracker and whether a ball was just
+ *      grabbed (BallDetector); apply the returned drive powers and intake state
+ *   3. Stop when it returns DONE (ball picked up) or FAILED (time limit)
+ */
+class BallPursuit {
+public:
+    /**
+     * Where the pickup is
+     */
+    enum Status {
+        IDLE,        // Not running
+        SEARCHING,   // No ball in view, turning to look for one
+        APPROACH,    // Driving toward the target ball
+        COLLECT,     // Ball too close to see, driving over it with the intake on
+        DONE,        // Ball picked up (finished)
+        FAILED       // Time limit reached (finished)
+    };
+    
+    /**
+     * Steering: turn power per degree of bearing, and its limit (percent)
+     */
+    static constexpr double TURN_KP = 1.2;
+    static const int MAX_TURN_POWER = 40;
+    
+    /**
+     * Forward power far from the ball and close to it (percent)
+     */
+    static const int APPROACH_POWER = 55;
+    static const int COLLECT_POWER = 35;
+    
+    /**
+     * Forward power drops to 0 at this bearing (turn first, then drive)
+     */
+    static constexpr double FULL_TURN_BEARING_DEG = 40.0;
+    
+    /**
+     * Closer than this the ball is about to drop out of the bottom of the image (mm)
+     */
+    static constexpr double COLLECT_DISTANCE_MM = 600.0;
+    
+    /**
+     * Driving blind over a ball that left the view, before looking again (ms)
+     */
+    static const uint32_t COLLECT_TIME_MS = 1000;
+    
+    /**
+     * Turn power while searching (percent, clockwise)
+     */
+    static const int SEARCH_TURN_POWER = 25;
+    
+    BallPursuit();
+    
+    /**
+     * Start a pickup
+     * 
+     * @param nowMs Current time
+     * @param timeoutMs Give up after this long
+     */
+    void start(uint32_t nowMs, uint32_t timeoutMs);
+    
+    /**
+     * Stop without finishing (outputs go to 0)
+     */
+    void cancel();
+    
+    /**
+     * One control step
+     * 
+     * @param tracker Tracker after this frame's update()
+     * @param ballGrabbed A ball went into the intake since the last step
+     * @param nowMs Current time
+     * @param leftPower Left drive power (percent)
+     * @param rightPower Right drive power (percent)
+     * @param intake Intake state to apply
+     * @return Status after the step
+     */
+    Status update(const VisionTracker& tracker, bool ballGrabbed, uint32_t nowMs,
+                  int& leftPower, int& rightPower, IntakeController::MotorState& intake);
+    
+    Status getStatus() const;
+    bool isRunning() const;
+    
+    /**
+     * Id of the track being chased (-1 if none)
+     */
+    int getTargetId() const;
+    
+private:
+    Status status;
+    uint32_t startMs;
+    uint32_t timeoutMs;
+    uint32_t collectStartMs;
+    int targetId;
+};
+
+BallPursuit::BallPursuit()
+    : status(IDLE),
+      startMs(0),
+      timeoutMs(0),
+      collectStartMs(0),
+      targetId(-1) {
+}
+
+void BallPursuit::start(uint32_t nowMs, uint32_t timeoutMs) {
+    status = SEARCHING;
+    startMs = nowMs;
+    this->timeoutMs = timeoutMs;
+    targetId = -1;
+}
+
+void BallPursuit::cancel() {
+    status = IDLE;
+    targetId = -1;
+}
+
+BallPursuit::Status BallPursuit::update(const VisionTracker& tracker, bool ballGrabbed, uint32_t nowMs,
+                                        int& leftPower, int& rightPower, IntakeController::MotorState& intake) {
+    leftPower = 0;
+    rightPower = 0;
+    intake = IntakeController::STOP;
+    if (!isRunning()) {
+        return status;
+    }
+    if (ballGrabbed) {
+        status = DONE;
+        return status;
+    }
+    if (nowMs - startMs >= timeoutMs) {
+        status = FAILED;
+        return status;
+    }
+    
+    intake = IntakeController::FORWARD;
+    const VisionTracker::Track* target = tracker.getTarget();
+    
+    // Close ball out of view: it is under the camera, keep driving over it
+    if (status == COLLECT && nowMs - collectStartMs < COLLECT_TIME_MS &&
+        (target == nullptr || target->id != targetId)) {
+        leftPower = COLLECT_POWER;
+        rightPower = COLLECT_POWER;
+        return status;
+    }
+    
+    if (target == nullptr) {
+        status = SEARCHING;
+        targetId = -1;
+        DriveTrain::calculateArcadeDrive(0, SEARCH_TURN_POWER, leftPower, rightPower);
+        return status;
+    }
+    
+    // Turn toward the ball, driving slower the further off-center it is
+    targetId = target->id;
+    double turn = target->bearingDeg * TURN_KP;
+    if (turn > MAX_TURN_POWER) {
+        turn = MAX_TURN_POWER;
+    } else if (turn < -MAX_TURN_POWER) {
+        turn = -MAX_TURN_POWER;
+    }
+    double alignment = 1.0 - std::fabs(target->bearingDeg) / FULL_TURN_BEARING_DEG;
+    if (alignment < 0.0) {
+        alignment = 0.0;
+    }
+    
+    int forwardPower = APPROACH_POWER;
+    if (target->distanceMm < COLLECT_DISTANCE_MM) {
+        status = COLLECT;
+        collectStartMs = nowMs;
+        forwardPower = COLLECT_POWER;
+    } else {
+        status = APPROACH;
+    }
+    DriveTrain::calculateArcadeDrive((int)(forwardPower * alignment), (int)turn, leftPower, rightPower);
+    return status;
+}
+
+BallPursuit::Status BallPursuit::getStatus() const {
+    return status;
+}
+
+bool BallPursuit::isRunning() const {
+    return status == SEARCHING || status == APPROACH || status == COLLECT;
+}
+
+int BallPursuit::getTargetId() const {
+    return targetId;
+}
+
+// ----------------------------------------------------------------------------
+// DriveBalancer Class
+// ----------------------------------------------------------------------------
+/**
+ * DriveBalancer Class
+ * 
+ * Usage (once per control tick, after the drive command is known):
+ *   1. update() for each side with its command and its motors' readings
+ *   2. Write the returned per-motor powers instead of the side command
+ */
+class DriveBalancer {
+public:
+    /**
+     * Drive sides
+     */
+    enum Side {
+        LEFT,
+        RIGHT,
+        SIDE_COUNT
+    };
+    
+    /**
+     * Motors per side (front, middle, back)
+     */
+    static const int MOTORS_PER_SIDE = 3;
+    
+    /**
+     * One motor's measurements
+     */
+    struct MotorReading {
+        double currentA;      // Current draw (amps, signed like the motor's power)
+        double temperatureC;  // Motor temperature (celsius)
+        double rpm;           // Measured speed (signed)
+    };
+    
+    /**
+     * Limits on a motor's share of its side's command (1.0 = even split; a share is
+     * never raised past what takes the motor to 100%)
+     */
+    static constexpr double MIN_SHARE = 0.2;
+    static constexpr double MAX_SHARE = 1.6;
+    
+    /**
+     * Share change per second per unit of imbalance
+     */
+    static constexpr double ADAPT_RATE = 1.5;
+    
+    /**
+     * Weights of the three imbalances
+     */
+    static constexpr double SLIP_GAIN = 4.0;         // Per unit of slip past SLIP_RATIO
+    static constexpr double CURRENT_GAIN = 1.0;      // Per unit of (current - mean) / mean
+    static constexpr double TEMPERATURE_GAIN = 1.0;  // Per TEMPERATURE_SCALE_C above the mean
+    
+    /**
+     * A wheel turning this much faster than the side's slowest wheel is slipping
+     */
+    static constexpr double SLIP_RATIO = 0.05;
+    
+    /**
+     * Below this side speed (rpm) slip isn't measured (too slow to tell)
+     */
+    static constexpr double MIN_SLIP_RPM = 15.0;
+    
+    /**
+     * Currents are compared relative to the side's mean, but never to less than this (amps)
+     */
+    static constexpr double MIN_BALANCE_AMPS = 0.5;
+    
+    /**
+     * Temperature difference that counts as one unit of imbalance (celsius)
+     */
+    static constexpr double TEMPERATURE_SCALE_C = 10.0;
+    
+    /**
+     * Side commands smaller than this (percent) are passed through unchanged, and the
+     * shares drift back to even with this time constant (seconds)
+     */
+    static const int MIN_BALANCE_POWER = 5;
+    static constexpr double RELAX_SECONDS = 0.5;
+    
+    /**
+     * Constructor: every share even
+     */
+    DriveBalancer();
+    
+    /**
+     * Back to an even split on both sides
+     */
+    void reset();
+    
+    /**
+     * Split one side's command for this tick
+     * 
+     * @param side Which side
+     * @param sidePower Side command (-100 to 100)
+     * @param readings Front, middle, back motor readings
+     * @param dtSeconds Time since the last update of this side
+     * @param powers Output: front, middle, back powers (-100 to 100); they add up to
+     *               3 x sidePower unless a slipping wheel's effort had nowhere to go
+     */
+    void update(Side side, int sidePower, const MotorReading readings[MOTORS_PER_SIDE],
+                double dtSeconds, int powers[MOTORS_PER_SIDE]);
+    
+    /**
+     * Current share of a motor (1.0 = even split)
+     */
+    double getShare(Side side, int motor) const;
+    
+    /**
+     * Split a side command by shares, keeping the total (rounding included); powers
+     * past +/-100 are clamped
+     * 
+     * @param sidePower Side command (-100 to 100)
+     * @param shares Shares (adding up to MOTORS_PER_SIDE)
+     * @param powers Output: motor powers
+     */
+    static void distribute(int sidePower, const double shares[MOTORS_PER_SIDE], int powers[MOTORS_PER_SIDE]);
+    
+private:
+    double shares[SIDE_COUNT][MOTORS_PER_SIDE];
+};
+
+DriveBalancer::DriveBalancer() {
+    reset();
+}
+
+void DriveBalancer::reset() {
+    for (int side = 0; side < SIDE_COUNT; side++) {
+        for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+            shares[side][i] = 1.0;
+        }
+    }
+}
+
+void DriveBalancer::update(Side side, int sidePower, const MotorReading readings[MOTORS_PER_SIDE],
+                           double dtSeconds, int powers[MOTORS_PER_SIDE]) {
+    double* share = shares[side];
+    
+    // Barely driving: nothing useful to measure, drift back to an even split
+    if (std::abs(sidePower) < MIN_BALANCE_POWER) {
+        double relax = std::fmin(1.0, dtSeconds / RELAX_SECONDS);
+        for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+            share[i] += (1.0 - share[i]) * relax;
+            powers[i] = sidePower;
+        }
+        return;
+    }
+    
+    // Speeds and currents in the commanded direction
+    double direction = (sidePower > 0) ? 1.0 : -1.0;
+    double speed[MOTORS_PER_SIDE];
+    double current[MOTORS_PER_SIDE];
+    double slowest = 0.0;
+    double meanTemperature = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        speed[i] = direction * readings[i].rpm;
+        current[i] = direction * readings[i].currentA;
+        if (i == 0 || speed[i] < slowest) {
+            slowest = speed[i];
+        }
+        meanTemperature += readings[i].temperatureC / MOTORS_PER_SIDE;
+    }
+    
+    // Slip: faster than the slowest wheel (which is the one most likely gripping)
+    double slip[MOTORS_PER_SIDE];
+    bool slipping[MOTORS_PER_SIDE];
+    bool anySlipping = false;
+    double grippingCurrent = 0.0;
+    double grippingTemperature = 0.0;
+    int grippingCount = 0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        slip[i] = (speed[i] - slowest) / std::fmax(slowest, MIN_SLIP_RPM) - SLIP_RATIO;
+        slipping[i] = slip[i] > 0.0;
+        anySlipping = anySlipping || slipping[i];
+        if (!slipping[i]) {
+            grippingCurrent += current[i];
+            grippingTemperature += readings[i].temperatureC;
+            grippingCount++;
+        }
+    }
+    grippingCurrent /= grippingCount;  // At least the slowest wheel grips
+    grippingTemperature /= grippingCount;
+    double scale = std::fmax(std::fabs(grippingCurrent), MIN_BALANCE_AMPS);
+    
+    // Largest share a motor can use before its power clamps at 100
+    double fullShare = std::fmin(MAX_SHARE, 100.0 / std::abs(sidePower));
+    
+    // Current and temperature: effort moves between gripping motors, from the most loaded
+    // and hottest to the others, and only to motors that can still take more (zero sum)
+    double error[MOTORS_PER_SIDE];
+    double meanError = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        error[i] = 0.0;
+        if (!slipping[i]) {
+            error[i] = CURRENT_GAIN * (current[i] - grippingCurrent) / scale +
+                       TEMPERATURE_GAIN * (readings[i].temperatureC - grippingTemperature) / TEMPERATURE_SCALE_C;
+            meanError += error[i] / grippingCount;
+        }
+    }
+    double change[MOTORS_PER_SIDE];
+    double given = 0.0;
+    double taken = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        change[i] = slipping[i] ? 0.0 : -ADAPT_RATE * dtSeconds * (error[i] - meanError);
+        if (change[i] > 0.0 && share[i] >= fullShare) {
+            change[i] = 0.0;
+        }
+        if (change[i] > 0.0) {
+            taken += change[i];
+        } else {
+            given -= change[i];
+        }
+    }
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (change[i] > 0.0 && taken > given) {
+            change[i] *= given / taken;
+        } else if (change[i] < 0.0 && given > taken) {
+            change[i] *= taken / given;
+        }
+    }
+    
+    // Slipping wheels shed effort (it only spins them faster). Gripping motors with room
+    // get it; the rest is dropped, and comes back once nothing slips.
+    double shed = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (slipping[i]) {
+            double drop = std::fmin(share[i] - MIN_SHARE, ADAPT_RATE * dtSeconds * SLIP_GAIN * std::fmin(slip[i], 1.0));
+            drop = std::fmax(0.0, drop);
+            change[i] -= drop;
+            shed += drop;
+        }
+    }
+    double total = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        total += share[i] + change[i];
+    }
+    if (!anySlipping && total < MOTORS_PER_SIDE) {
+        shed += (MOTORS_PER_SIDE - total) * std::fmin(1.0, dtSeconds / RELAX_SECONDS);
+    }
+    int roomCount = 0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (!slipping[i] && share[i] + change[i] < fullShare) {
+            roomCount++;
+        }
+    }
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        if (!slipping[i] && share[i] + change[i] < fullShare) {
+            change[i] += std::fmin(shed / roomCount, fullShare - share[i] - change[i]);
+        }
+    }
+    
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        share[i] = std::fmin(MAX_SHARE, std::fmax(MIN_SHARE, share[i] + change[i]));
+    }
+    
+    distribute(sidePower, share, powers);
+}
+
+double DriveBalancer::getShare(Side side, int motor) const {
+    return shares[side][motor];
+}
+
+void DriveBalancer::distribute(int sidePower, const double shares[MOTORS_PER_SIDE],
+                               int powers[MOTORS_PER_SIDE]) {
+    double power[MOTORS_PER_SIDE];
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        power[i] = sidePower * shares[i];
+    }
+    
+    // A motor can't do more than 100%: what a share asks past that is lost, not handed
+    // back to a wheel that was shedding effort
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        power[i] = std::fmax(-100.0, std::fmin(100.0, power[i]));
+    }
+    
+    // Round, then hand out what rounding lost so the total matches the side command
+    int total = 0;
+    double target = 0.0;
+    for (int i = 0; i < MOTORS_PER_SIDE; i++) {
+        powers[i] = (int)std::lround(power[i]);
+        total += powers[i];
+        target += power[i];
+    }
+    int remainder = (int)std::lround(target) - total;
+    for (int i = 0; i < MOTORS_PER_SIDE && remainder != 0; i++) {
+        int step = (remainder > 0) ? 1 : -1;
+        if (std::abs(powers[i] + step) <= 100) {
+            powers[i] += step;
+            remainder -= step;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Odometry Class
+// ----------------------------------------------------------------------------
+/**
+ * Odometry Class
+ * 
+ * Pure functions for tank-drive dead reckoning.
+ * Nothing here touches hardware - main.cpp reads the encoders and inertial sensor
+ * and passes the numbers in.
+ */
+class Odometry {
+public:
+    /**
+     * Robot position on the field
+     */
+    struct Pose {
+        double x;        // Inches
+        double y;        // Inches
+        double heading;  // Degrees, 0-360, clockwise from +y
+    };
+    
+    /**
+     * Move a pose forward by a distance driven
+     * 
+     * Pure function: uses the average of the old and new heading so that
+     * driving along an arc is integrated more accurately than using either end alone.
+     * 
+     * @param start Pose before the move
+     * @param forwardDistance Distance driven along the robot's forward axis (inches, negative = backward)
+     * @param newHeading Heading at the end of the move (degrees)
+     * @return Pose after the move
+     */
+    static Pose integrate(const Pose& start, double forwardDistance, double newHeading);
+    
+    /**
+     * Convert motor rotation into wheel travel
+     * 
+     * @param motorDegrees Motor output shaft rotation (degrees)
+     * @param wheelDiameter Wheel diameter (inches)
+     * @param gearRatio Wheel turns per motor output turn (1.0 for direct drive)
+     * @return Distance the wheel rolled (inches)
+     */
+    static double wheelTravel(double motorDegrees, double wheelDiameter, double gearRatio);
+    
+    /**
+     * Wrap a heading into the 0-360 range
+     * 
+     * @param heading Any heading in degrees (e.g. -90 or 450)
+     * @return Same direction expressed in [0, 360)
+     */
+    static double wrapHeading(double heading);
+    
+    /**
+     * Shortest signed angle from one heading to another
+     * 
+     * @param from Starting heading (degrees)
+     * @param to Target heading (degrees)
+     * @return Turn needed in degrees, in (-180, 180] (positive = clockwise)
+     */
+    static double headingDifference(double from, double to);
+    
+    /**
+     * Degrees to radians conversion factor (pi / 180)
+     */
+    static constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+};
+
+Odometry::Pose Odometry::integrate(const Pose& start, double forwardDistance, double newHeading) {
+    // Average the start and end heading along the shortest turn direction
+    // (averaging 350 and 10 must give 0, not 180)
+    double midHeading = start.heading + headingDifference(start.heading, newHeading) / 2.0;
+    double midRadians = midHeading * DEGREES_TO_RADIANS;
+    
+    // Compass convention: heading 0 drives along +y, heading 90 drives along +x
+    Pose result;
+    result.x = start.x + forwardDistance * std::sin(midRadians);
+    result.y = start.y + forwardDistance * std::cos(midRadians);
+    result.heading = wrapHeading(newHeading);
+    return result;
+}
+
+double Odometry::wheelTravel(double motorDegrees, double wheelDiameter, double gearRatio) {
+    // Arc length rolled = wheel angle (radians) * wheel radius
+    double wheelRadians = motorDegrees * gearRatio * DEGREES_TO_RADIANS;
+    return wheelRadians * (wheelDiameter / 2.0);
+}
+
+double Odometry::wrapHeading(double heading) {
+    double wrapped = std::fmod(heading, 360.0);
+    if (wrapped < 0.0) {
+        wrapped += 360.0;
+    }
+    return wrapped;
+}
+
+double Odometry::headingDifference(double from, double to) {
+    double difference = wrapHeading(to - from);
+    // Anything past half a turn is shorter the other way around
+    if (difference > 180.0) {
+        difference -= 360.0;
+    }
+    return difference;
+}
+// ----------------------------------------------------------------------------
+// PoseHistory Class
+// ----------------------------------------------------------------------------
+/**
+ * PoseHistory Class
+ * 
+ * Ring buffer of timestamped poses, oldest entry first.
+ * Each entry also keeps the odometry step that produced it (distance driven and
+ * heading reached) so a corrected pose can be re-propagated to the present.
+ */
+class PoseHistory {
+public:
+    /**
+     * Number of entries kept (at a 10 ms update rate this is 1.28 seconds of history)
+     */
+    static const int CAPACITY = 128;
+    
+    /**
+     * One recorded pose
+     */
+    struct Entry {
+        uint32_t timestampMs;     // When the pose was valid (Brain system time)
+        Odometry::Pose pose;      // Pose at that time
+        double forwardDistance;   // Inches driven since the previous entry
+        double odometryHeading;   // Heading reported by the inertial sensor for this step
+    };
+    
+    PoseHistory();
+    
+    /**
+     * Remove all entries
+     */
+    void clear();
+    
+    /**
+     * Add a new entry (overwrites the oldest entry once full)
+     * 
+     * Timestamps must not go backwards - entries are kept in time order for binary search.
+     * 
+     * @param entry The entry to record
+     */
+    void add(const Entry& entry);
+    
+    /**
+     * Number of entries currently stored (0 to CAPACITY)
+     */
+    int size() const;
+    
+    /**
+     * Access an entry by age
+     * 
+     * @param index 0 = oldest entry, size() - 1 = newest entry
+     * @return Reference to the entry (index is clamped to the valid range)
+     */
+    Entry& at(int index);
+    const Entry& at(int index) const;
+    
+    /**
+     * Find the newest entry recorded at or before a time
+     * 
+     * Binary search: O(log n).
+     * 
+     * @param timestampMs Time to look up
+     * @return Index of the entry (0 = oldest), or -1 if the time is older than all entries
+     */
+    int findAtOrBefore(uint32_t timestampMs) const;
+    
+private:
+    Entry entries[CAPACITY];
+    int oldest;  // Ring position of the oldest entry
+    int count;   // Number of valid entries
+};
+
+PoseHistory::PoseHistory() : oldest(0), count(0) {
+}
+
+void PoseHistory::clear() {
+    oldest = 0;
+    count = 0;
+}
+
+void PoseHistory::add(const Entry& entry) {
+    if (count < CAPACITY) {
+        // Still filling up: write after the newest entry
+        entries[(oldest + count) % CAPACITY] = entry;
+        count++;
+    } else {
+        // Full: the oldest slot becomes the newest entry
+        entries[oldest] = entry;
+        oldest = (oldest + 1) % CAPACITY;
+    }
+}
+
+int PoseHistory::size() const {
+    return count;
+}
+
+PoseHistory::Entry& PoseHistory::at(int index) {
+    // Bounds check: clamp instead of reading outside the array
+    if (index >= count) {
+        index = count - 1;
+    }
+    if (index < 0) {
+        index = 0;
+    }
+    return entries[(oldest + index) % CAPACITY];
+}
+
+const PoseHistory::Entry& PoseHistory::at(int index) const {
+    return const_cast<PoseHistory*>(this)->at(index);
+}
+
+int PoseHistory::findAtOrBefore(uint32_t timestampMs) const {
+    if (count == 0 || timestampMs < at(0).timestampMs) {
+        return -1;
+    }
+    
+    // Binary search for the last entry with timestamp <= timestampMs
+    // Invariant: at(low) is at or before the time, everything after high is after it
+    int low = 0;
+    int high = count - 1;
+    while (low < high) {
+        int middle = (low + high + 1) / 2;  // Round up so the loop always shrinks
+        if (at(middle).timestampMs <= timestampMs) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+// ----------------------------------------------------------------------------
+// GpsFusion Class
+// ----------------------------------------------------------------------------
+/**
+ * GpsFusion Class
+ * 
+ * Latency-compensated odometry + GPS localization.
+ * main.cpp calls updateOdometry() every localization tick and applyGpsFix() whenever
+ * the GPS has a new reading.
+ */
+class GpsFusion {
+public:
+    /**
+     * What happened to a GPS fix
+     */
+    enum FixResult {
+        APPLIED = 0,               // Fix blended into the pose history
+        INITIALIZED = 1,           // First fix: pose snapped to the GPS
+        REJECTED_LOW_QUALITY = 2,  // GPS quality below MIN_GPS_QUALITY (dropout)
+        REJECTED_TOO_OLD = 3,      // Fix is older than the whole pose history
+        REJECTED_OUTLIER = 4,      // Fix disagrees with odometry by more than MAX_CORRECTION
+        RECOVERED = 5              // OUTLIER_RECOVERY_COUNT outliers in a row agreed: pose re-snapped
+    };
+    
+    /**
+     * Lowest GPS quality (0-100) that is trusted
+     */
+    static const int MIN_GPS_QUALITY = 90;
+    
+    /**
+     * Largest position correction accepted from one fix (inches)
+     * Bigger jumps are almost always reflections or a partly blocked code strip.
+     */
+    static constexpr double MAX_CORRECTION = 12.0;
+    
+    /**
+     * Outliers in a row that re-snap the pose to the GPS when they agree with each other
+     * (their errors within OUTLIER_AGREEMENT inches): a bump or wheel slip moved the robot
+     * and odometry didn't see it. Low quality fixes in between don't break the run.
+     */
+    static const int OUTLIER_RECOVERY_COUNT = 5;
+    static constexpr double OUTLIER_AGREEMENT = 3.0;
+    
+    /**
+     * Create a fusion filter
+     * 
+     * @param positionGain How much of each GPS position error to correct (0-1)
+     * @param headingGain How much of each GPS heading error to correct (0-1, 0 = trust the gyro)
+     */
+    GpsFusion(double positionGain = 0.3, double headingGain = 0.05);
+    
+    /**
+     * Set a known pose (e.g. the autonomous starting tile) and clear the history
+     * 
+     * @param timestampMs Current time
+     * @param pose Known pose
+     * @param rawHeading Heading the inertial sensor reports right now
+     */
+    void reset(uint32_t timestampMs, const Odometry::Pose& pose, double rawHeading);
+    
+    /**
+     * Advance the pose with one odometry step and record it in the history
+     * 
+     * @param timestampMs Time of the encoder/inertial reading
+     * @param forwardDistance Inches driven since the last call (average of both sides)
+     * @param rawHeading Heading reported by the inertial sensor (degrees)
+     */
+    void updateOdometry(uint32_t timestampMs, double forwardDistance, double rawHeading);
+    
+    /**
+     * Apply a GPS fix at the time it was measured and re-propagate to the present
+     * 
+     * Cost: O(log n) lookup + O(n) replay of the entries newer than the fix.
+     * 
+     * @param measuredAtMs Time the GPS actually measured this pose (receive time minus latency)
+     * @param gpsPose Pose reported by the GPS
+     * @param quality GPS quality (0-100)
+     * @return What was done with the fix
+     */
+    FixResult applyGpsFix(uint32_t measuredAtMs, const Odometry::Pose& gpsPose, int quality);
+    
+    /**
+     * Best estimate of the current pose
+     */
+    Odometry::Pose getPose() const;
+    
+    /**
+     * True once reset() was called or a first GPS fix was accepted
+     */
+    bool isInitialized() const;
+    
+    /**
+     * Number of GPS fixes rejected since the last reset (dropouts, outliers, stale fixes)
+     */
+    int getRejectedFixCount() const;
+    
+    /**
+     * Read-only access to the pose history (e.g. for heading at a past time)
+     */
+    const PoseHistory& getHistory() const;
+    
+private:
+    PoseHistory history;
+    Odometry::Pose currentPose;
+    double positionGain;
+    double headingGain;
+    double headingOffset;  // Added to the raw inertial heading to get field heading
+    bool initialized;
+    int rejectedFixCount;
+    
+    // Outliers in a row, and the error of the last one (inches)
+    int outlierCount;
+    double outlierErrorX;
+    double outlierErrorY;
+};
+
+GpsFusion::GpsFusion(double positionGain, double headingGain)
+    : currentPose{0.0, 0.0, 0.0},
+      positionGain(positionGain),
+      headingGain(headingGain),
+      headingOffset(0.0),
+      initialized(false),
+      rejectedFixCount(0),
+      outlierCount(0),
+      outlierErrorX(0.0),
+      outlierErrorY(0.0) {
+}
+
+void GpsFusion::reset(uint32_t timestampMs, const Odometry::Pose& pose, double rawHeading) {
+    history.clear();
+    currentPose = pose;
+    currentPose.heading = Odometry::wrapHeading(pose.heading);
+    
+    // From now on: field heading = raw inertial heading + offset
+    headingOffset = Odometry::headingDifference(rawHeading, currentPose.heading);
+    initialized = true;
+    rejectedFixCount = 0;
+    outlierCount = 0;
+    
+    PoseHistory::Entry entry = {timestampMs, currentPose, 0.0, rawHeading};
+    history.add(entry);
+}
+
+void GpsFusion::updateOdometry(uint32_t timestampMs, double forwardDistance, double rawHeading) {
+    currentPose = Odometry::integrate(currentPose, forwardDistance, rawHeading + headingOffset);
+    
+    // Keep the raw step too, so it can be replayed after a late GPS correction
+    PoseHistory::Entry entry = {timestampMs, currentPose, forwardDistance, rawHeading};
+    history.add(entry);
+}
+
+GpsFusion::FixResult GpsFusion::applyGpsFix(uint32_t measuredAtMs, const Odometry::Pose& gpsPose,
+                                            int quality) {
+    // Dropout: the GPS can't see enough of the field code strip
+    if (quality < MIN_GPS_QUALITY) {
+        rejectedFixCount++;
+        return REJECTED_LOW_QUALITY;
+    }
+    
+    // Find where odometry thought we were when the GPS took its measurement
+    int index = history.findAtOrBefore(measuredAtMs);
+    if (index < 0) {
+        rejectedFixCount++;
+        return REJECTED_TOO_OLD;
+    }
+    
+    // The fix usually lands between two history entries: interpolate the position
+    // so a fast-moving robot isn't corrected by up to a whole tick of travel
+    const PoseHistory::Entry& before = history.at(index);
+    Odometry::Pose predicted = before.pose;
+    if (index + 1 < history.size()) {
+        const PoseHistory::Entry& after = history.at(index + 1);
+        double span = static_cast<double>(after.timestampMs - before.timestampMs);
+        if (span > 0.0) {
+            double fraction = static_cast<double>(measuredAtMs - before.timestampMs) / span;
+            predicted.x += (after.pose.x - before.pose.x) * fraction;
+            predicted.y += (after.pose.y - before.pose.y) * fraction;
+        }
+    }
+    
+    double errorX = gpsPose.x - predicted.x;
+    double errorY = gpsPose.y - predicted.y;
+    double errorHeading = Odometry::headingDifference(predicted.heading, gpsPose.heading);
+    
+    // A huge jump means a bad reading, not a huge odometry error - unless the GPS keeps
+    // reporting the same jump: then the robot was moved and odometry missed it
+    bool recovering = false;
+    if (initialized && std::sqrt(errorX * errorX + errorY * errorY) > MAX_CORRECTION) {
+        double changeX = errorX - outlierErrorX;
+        double changeY = errorY - outlierErrorY;
+        bool agrees = outlierCount > 0 && std::sqrt(changeX * changeX + changeY * changeY) <= OUTLIER_AGREEMENT;
+        outlierCount = agrees ? outlierCount + 1 : 1;
+        outlierErrorX = errorX;
+        outlierErrorY = errorY;
+        if (outlierCount < OUTLIER_RECOVERY_COUNT) {
+            rejectedFixCount++;
+            return REJECTED_OUTLIER;
+        }
+        recovering = true;
+    }
+    outlierCount = 0;
+    
+    // The very first fix places the robot on the field, so take it completely (same for
+    // the position after a run of agreeing outliers)
+    double positionStep = (initialized && !recovering) ? positionGain : 1.0;
+    double headingStep = initialized ? headingGain : 1.0;
+    
+    // Correct the pose at measurement time
+    PoseHistory::Entry& corrected = history.at(index);
+    corrected.pose.x += errorX * positionStep;
+    corrected.pose.y += errorY * positionStep;
+    corrected.pose.heading = Odometry::wrapHeading(corrected.pose.heading + errorHeading * headingStep);
+    headingOffset += errorHeading * headingStep;
+    
+    // Replay every odometry step recorded after the measurement to reach the present
+    for (int i = index + 1; i < history.size(); i++) {
+        PoseHistory::Entry& entry = history.at(i);
+        entry.pose = Odometry::integrate(history.at(i - 1).pose, entry.forwardDistance,
+                                         entry.odometryHeading + headingOffset);
+    }
+    currentPose = history.at(history.size() - 1).pose;
+    
+    FixResult result = !initialized ? INITIALIZED : recovering ? RECOVERED : APPLIED;
+    initialized = true;
+    return result;
+}
+
+Odometry::Pose GpsFusion::getPose() const {
+    return currentPose;
+}
+
+bool GpsFusion::isInitialized() const {
+    return initialized;
+}
+
+int GpsFusion::getRejectedFixCount() const {
+    return rejectedFixCount;
+}
+
+const PoseHistory& GpsFusion::getHistory() const {
+    return history;
+}
+// ----------------------------------------------------------------------------
+// VelocityEstimator Class
+// ----------------------------------------------------------------------------
+/**
+ * VelocityEstimator Class
+ * 
+ * One instance per motor. Feed it (timestamp, position) every tick; it ignores
+ * repeated readings and filters the rest with the selected filter.
+ */
+class VelocityEstimator {
+public:
+    /**
+     * Filter used to turn positions into a velocity
+     */
+    enum FilterType {
+        // Least-squares slope over the last N readings (a first-order Savitzky-Golay
+        // derivative, generalized to uneven sample spacing). Smooth, but lags by about
+        // half the window.
+        SAVITZKY_GOLAY = 0,
+        // Alpha-beta tracker: predicts position, corrects with a fraction of the error
+        ALPHA_BETA = 1
+    };
+    
+    /**
+     * Largest supported Savitzky-Golay window
+     */
+    static const int MAX_WINDOW = 16;
+    
+    /**
+     * Create an estimator
+     * 
+     * @param filter Filter type
+     * @param windowSize Readings used by SAVITZKY_GOLAY (2 to MAX_WINDOW, clamped)
+     * @param alpha ALPHA_BETA position correction gain (0-1)
+     * @param beta ALPHA_BETA velocity correction gain (0-1, usually much smaller than alpha)
+     */
+    VelocityEstimator(FilterType filter = SAVITZKY_GOLAY, int windowSize = 6,
+                      double alpha = 0.5, double beta = 0.1);
+    
+    /**
+     * Add an encoder reading
+     * 
+     * @param timestampMs Time the DEVICE took the reading (motor.timestamp()), not loop time
+     * @param position Encoder position (degrees)
+     * @return true if this was a new reading, false if it was a repeat and was ignored
+     */
+    bool addSample(uint32_t timestampMs, double position);
+    
+    /**
+     * Latest velocity estimate in degrees per second (0 until two readings arrive)
+     */
+    double getVelocity() const;
+    
+    /**
+     * Latest velocity estimate in RPM
+     */
+    double getRpm() const;
+    
+    /**
+     * Forget all readings (e.g. after resetting the encoder)
+     */
+    void reset();
+    
+private:
+    double computeSlope() const;
+    
+    FilterType filter;
+    int windowSize;
+    double alpha;
+    double beta;
+    
+    // Ring buffer of recent readings (time stored in seconds relative to the first reading)
+    double times[MAX_WINDOW];
+    double positions[MAX_WINDOW];
+    int newest;
+    int count;
+    uint32_t firstTimestampMs;
+    uint32_t lastTimestampMs;
+    
+    // Alpha-beta tracker state
+    double trackedPosition;
+    double velocity;
+};
+
+VelocityEstimator::VelocityEstimator(FilterType filter, int windowSize, double alpha, double beta)
+    : filter(filter), alpha(alpha), beta(beta) {
+    // Bounds check: a slope needs at least 2 points and must fit in the buffer
+    if (windowSize < 2) {
+        windowSize = 2;
+    }
+    if (windowSize > MAX_WINDOW) {
+        windowSize = MAX_WINDOW;
+    }
+    this->windowSize = windowSize;
+    reset();
+}
+
+void VelocityEstimator::reset() {
+    newest = -1;
+    count = 0;
+    firstTimestampMs = 0;
+    lastTimestampMs = 0;
+    trackedPosition = 0.0;
+    velocity = 0.0;
+}
+
+bool VelocityEstimator::addSample(uint32_t timestampMs, double position) {
+    // Same device timestamp = same reading read twice; using it would fake a zero velocity
+    if (count > 0 && timestampMs == lastTimestampMs) {
+        return false;
+    }
+    if (count == 0) {
+        firstTimestampMs = timestampMs;
+    }
+    
+    // Seconds since the first reading (small numbers keep the least-squares math accurate)
+    double time = static_cast<double>(timestampMs - firstTimestampMs) / 1000.0;
+    double dt = static_cast<double>(timestampMs - lastTimestampMs) / 1000.0;
+    lastTimestampMs = timestampMs;
+    
+    newest = (newest + 1) % windowSize;
+    times[newest] = time;
+    positions[newest] = position;
+    if (count < windowSize) {
+        count++;
+    }
+    
+    if (filter == ALPHA_BETA) {
+        if (count == 1) {
+            trackedPosition = position;
+            velocity = 0.0;
+        } else {
+            // Predict where the motor should be now, then correct by the measured error
+            double predicted = trackedPosition + velocity * dt;
+            double error = position - predicted;
+            trackedPosition = predicted + alpha * error;
+            velocity = velocity + (beta / dt) * error;
+        }
+    } else {
+        velocity = computeSlope();
+    }
+    return true;
+}
+
+double VelocityEstimator::computeSlope() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    
+    // Least-squares line through (time, position): slope = cov(t, p) / var(t)
+    double meanTime = 0.0;
+    double meanPosition = 0.0;
+    for (int i = 0; i < count; i++) {
+        meanTime += times[i];
+        meanPosition += positions[i];
+    }
+    meanTime /= count;
+    meanPosition /= count;
+    
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (int i = 0; i < count; i++) {
+        double timeOffset = times[i] - meanTime;
+        covariance += timeOffset * (positions[i] - meanPosition);
+        variance += timeOffset * timeOffset;
+    }
+    
+    // Can't happen with distinct timestamps, but never divide by zero
+    if (variance <= 0.0) {
+        return 0.0;
+    }
+    return covariance / variance;
+}
+
+double VelocityEstimator::getVelocity() const {
+    return velocity;
+}
+
+double VelocityEstimator::getRpm() const {
+    // degrees/second -> revolutions/minute: * 60 / 360
+    return velocity / 6.0;
+}
+
+// ----------------------------------------------------------------------------
+// EnergyMonitor Class
+// ----------------------------------------------------------------------------
+/**
+ * EnergyMonitor Class
+ * 
+ * Usage every control tick:
+ *   1. addMotorSample() once per motor
+ *   2. endTick() once, with the time since the last tick
+ */
+class EnergyMonitor {
+public:
+    /**
+     * Subsystems energy is tracked for
+     */
+    enum Subsystem {
+        DRIVE = 0,            // 6 drive motors
+        INTAKE = 1,           // Intake motor (5.5W)
+        RAMP = 2,             // First two ramp wheels (5.5W)
+        FULL_POWER_RAMP = 3,  // Final ramp wheel (11W)
+        SUBSYSTEM_COUNT = 4
+    };
+    
+    EnergyMonitor();
+    
+    /**
+     * Electrical power drawn by a motor
+     * 
+     * Pure function: power = |voltage| * |current|. The sign of the voltage only says
+     * which way the motor spins - either way the battery supplies the power.
+     * 
+     * @param volts Voltage applied to the motor (V, may be negative)
+     * @param amps Motor current (A)
+     * @return Power in watts (always >= 0)
+     */
+    static double electricalPower(double volts, double amps);
+    
+    /**
+     * Add one motor's reading to this tick
+     * 
+     * @param subsystem Subsystem the motor belongs to
+     * @param volts Applied voltage (V)
+     * @param amps Current (A)
+     */
+    void addMotorSample(Subsystem subsystem, double volts, double amps);
+    
+    /**
+     * Finish the tick: integrate this tick's power over the elapsed time
+     * 
+     * @param dtSeconds Time since the previous tick (seconds, ignored if <= 0)
+     */
+    void endTick(double dtSeconds);
+    
+    /**
+     * Energy used by a subsystem since the last reset (joules)
+     */
+    double getEnergy(Subsystem subsystem) const;
+    
+    /**
+     * Energy used by all subsystems since the last reset (joules)
+     */
+    double getTotalEnergy() const;
+    
+    /**
+     * Fraction of the total energy used by a subsystem (0-1, 0 if nothing used yet)
+     */
+    double getShare(Subsystem subsystem) const;
+    
+    /**
+     * Power drawn by a subsystem during the last completed tick (watts)
+     */
+    double getPower(Subsystem subsystem) const;
+    
+    /**
+     * Power drawn by all subsystems during the last completed tick (watts)
+     */
+    double getTotalPower() const;
+    
+    /**
+     * Clear all totals (e.g. at the start of a match)
+     */
+    void reset();
+    
+private:
+    static bool isValid(Subsystem subsystem);
+    
+    double energy[SUBSYSTEM_COUNT];        // Joules since reset
+    double tickPower[SUBSYSTEM_COUNT];     // Watts being summed for the current tick
+    double lastPower[SUBSYSTEM_COUNT];     // Watts of the last completed tick
+};
+
+EnergyMonitor::EnergyMonitor() {
+    reset();
+}
+
+double EnergyMonitor::electricalPower(double volts, double amps) {
+    return std::fabs(volts) * std::fabs(amps);
+}
+
+bool EnergyMonitor::isValid(Subsystem subsystem) {
+    // Bounds check before using the enum as an array index
+    return subsystem >= 0 && subsystem < SUBSYSTEM_COUNT;
+}
+
+void EnergyMonitor::addMotorSample(Subsystem subsystem, double volts, double amps) {
+    if (!isValid(subsystem)) {
+        return;
+    }
+    tickPower[subsystem] += electricalPower(volts, amps);
+}
+
+void EnergyMonitor::endTick(double dtSeconds) {
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        // Energy (J) = power (W) * time (s)
+        if (dtSeconds > 0.0) {
+            energy[i] += tickPower[i] * dtSeconds;
+        }
+        lastPower[i] = tickPower[i];
+        tickPower[i] = 0.0;
+    }
+}
+
+double EnergyMonitor::getEnergy(Subsystem subsystem) const {
+    return isValid(subsystem) ? energy[subsystem] : 0.0;
+}
+
+double EnergyMonitor::getTotalEnergy() const {
+    double total = 0.0;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        total += energy[i];
+    }
+    return total;
+}
+
+double EnergyMonitor::getShare(Subsystem subsystem) const {
+    double total = getTotalEnergy();
+    if (total <= 0.0) {
+        return 0.0;
+    }
+    return getEnergy(subsystem) / total;
+}
+
+double EnergyMonitor::getPower(Subsystem subsystem) const {
+    return isValid(subsystem) ? lastPower[subsystem] : 0.0;
+}
+
+double EnergyMonitor::getTotalPower() const {
+    double total = 0.0;
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        total += lastPower[i];
+    }
+    return total;
+}
+
+void EnergyMonitor::reset() {
+    for (int i = 0; i < SUBSYSTEM_COUNT; i++) {
+        energy[i] = 0.0;
+        tickPower[i] = 0.0;
+        lastPower[i] = 0.0;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// BatteryModel Class
+// ----------------------------------------------------------------------------
+/**
+ * BatteryModel Class
+ * 
+ * Call update() every tick with the battery terminal voltage and current.
+ * getState() / restore() let main.cpp keep the model on the SD card between matches.
+ */
+class BatteryModel {
+public:
+    /**
+     * Saved battery state (plain data, safe to write to the SD card as bytes)
+     */
+    struct State {
+        double stateOfCharge;       // Percent (0-100)
+        double internalResistance;  // Ohms
+        int matchCount;             // Matches run on this battery since it was detected
+    };
+    
+    /**
+     * V5 battery capacity (1100 mAh)
+     */
+    static constexpr double CAPACITY_AMP_HOURS = 1.1;
+    
+    /**
+     * Starting resistance guess before any load steps are seen (ohms)
+     */
+    static constexpr double DEFAULT_RESISTANCE = 0.08;
+    
+    /**
+     * Smallest current change used to measure resistance (amps)
+     * Smaller steps are swamped by voltage measurement noise.
+     */
+    static constexpr double MIN_CURRENT_STEP = 2.0;
+    
+    /**
+     * How far the saved state of charge may differ from the Brain's own estimate
+     * before we decide a different battery was plugged in (percent)
+     */
+    static constexpr double SAME_BATTERY_TOLERANCE = 15.0;
+    
+    /**
+     * Create a model for a battery at a known state of charge
+     * 
+     * @param stateOfCharge Starting state of charge (percent, clamped to 0-100)
+     */
+    BatteryModel(double stateOfCharge = 100.0);
+    
+    /**
+     * Add one battery reading
+     * 
+     * @param terminalVolts Battery voltage (V)
+     * @param amps Battery current (A, positive = discharging)
+     * @param dtSeconds Time since the previous reading (seconds)
+     */
+    void update(double terminalVolts, double amps, double dtSeconds);
+    
+    /**
+     * Estimated state of charge (percent, 0-100)
+     */
+    double getStateOfCharge() const;
+    
+    /**
+     * Estimated internal resistance (ohms)
+     */
+    double getInternalResistance() const;
+    
+    /**
+     * Estimated voltage with no load (terminal voltage + current * resistance)
+     */
+    double getOpenCircuitVoltage() const;
+    
+    /**
+     * Current state, for saving between matches
+     */
+    State getState() const;
+    
+    /**
+     * Continue from a saved state if it still matches the battery plugged in
+     * 
+     * If the saved state of charge is far from what the Brain reports, a different
+     * battery is plugged in: start fresh from the Brain's estimate instead.
+     * 
+     * @param saved State loaded from the SD card
+     * @param brainCapacityPercent Brain.Battery.capacity() reading
+     * @return true if the saved state was used, false if a new battery was detected
+     */
+    bool restore(const State& saved, double brainCapacityPercent);
+    
+    /**
+     * Count one more match on this battery
+     */
+    void startMatch();
+    
+private:
+    static double clampPercent(double percent);
+    
+    double stateOfCharge;
+    double internalResistance;
+    int matchCount;
+    bool hasLastSample;
+    double lastVolts;
+    double lastAmps;
+};
+
+BatteryModel::BatteryModel(double stateOfCharge)
+    : stateOfCharge(clampPercent(stateOfCharge)),
+      internalResistance(DEFAULT_RESISTANCE),
+      matchCount(0),
+      hasLastSample(false),
+      lastVolts(0.0),
+      lastAmps(0.0) {
+}
+
+double BatteryModel::clampPercent(double percent) {
+    if (percent < 0.0) {
+        return 0.0;
+    }
+    if (percent > 100.0) {
+        return 100.0;
+    }
+    return percent;
+}
+
+void BatteryModel::update(double terminalVolts, double amps, double dtSeconds) {
+    // Coulomb counting: amp-seconds drawn / (capacity in amp-seconds) = fraction used
+    if (dtSeconds > 0.0) {
+        double capacityAmpSeconds = CAPACITY_AMP_HOURS * 3600.0;
+        stateOfCharge = clampPercent(stateOfCharge - 100.0 * amps * dtSeconds / capacityAmpSeconds);
+    }
+    
+    // Resistance from a load step: more current -> more voltage sag
+    if (hasLastSample) {
+        double currentStep = amps - lastAmps;
+        if (std::fabs(currentStep) >= MIN_CURRENT_STEP) {
+            double measured = -(terminalVolts - lastVolts) / currentStep;
+            // Ignore physically impossible readings (noise, or a regen spike)
+            if (measured > 0.0 && measured < 1.0) {
+                // Smooth: each step moves the estimate 20% of the way
+                internalResistance += 0.2 * (measured - internalResistance);
+            }
+        }
+    }
+    hasLastSample = true;
+    lastVolts = terminalVolts;
+    lastAmps = amps;
+}
+
+double BatteryModel::getStateOfCharge() const {
+    return stateOfCharge;
+}
+
+double BatteryModel::getInternalResistance() const {
+    return internalResistance;
+}
+
+double BatteryModel::getOpenCircuitVoltage() const {
+    return lastVolts + lastAmps * internalResistance;
+}
+
+BatteryModel::State BatteryModel::getState() const {
+    State state;
+    state.stateOfCharge = stateOfCharge;
+    state.internalResistance = internalResistance;
+    state.matchCount = matchCount;
+    return state;
+}
+
+bool BatteryModel::restore(const State& saved, double brainCapacityPercent) {
+    bool sameBattery = std::fabs(saved.stateOfCharge - brainCapacityPercent) <= SAME_BATTERY_TOLERANCE &&
+                       saved.internalResistance > 0.0 && saved.matchCount >= 0;
+    if (sameBattery) {
+        stateOfCharge = clampPercent(saved.stateOfCharge);
+        internalResistance = saved.internalResistance;
+        matchCount = saved.matchCount;
+    } else {
+        // Different battery (or garbage on the SD card): start over
+        stateOfCharge = clampPercent(brainCapacityPercent);
+        internalResistance = DEFAULT_RESISTANCE;
+        matchCount = 0;
+    }
+    hasLastSample = false;
+    return sameBattery;
+}
+
+void BatteryModel::startMatch() {
+    matchCount++;
+}
+
+// ----------------------------------------------------------------------------
+// LatencyStats Class
+// ----------------------------------------------------------------------------
+/**
+ * LatencyStats Class
+ * 
+ * Usage:
+ *   1. add() each measured latency
+ *   2. Read getMean(), getPercentile(95), getMax(), ...
+ */
+class LatencyStats {
+public:
+    /**
+     * Number of histogram buckets (the last one collects everything longer)
+     */
+    static const int BUCKET_COUNT = 64;
+    
+    /**
+     * Default bucket width (microseconds)
+     */
+    static const uint32_t DEFAULT_BUCKET_US = 500;
+    
+    /**
+     * Create empty statistics
+     * 
+     * @param bucketUs Histogram bucket width in microseconds (percentile resolution)
+     */
+    LatencyStats(uint32_t bucketUs = DEFAULT_BUCKET_US);
+    
+    /**
+     * Add one measurement
+     * 
+     * @param latencyUs Latency in microseconds
+     */
+    void add(uint32_t latencyUs);
+    
+    /**
+     * Forget all measurements
+     */
+    void reset();
+    
+    /**
+     * Number of measurements
+     */
+    uint32_t getCount() const;
+    
+    /**
+     * Shortest latency (microseconds, 0 if none)
+     */
+    uint32_t getMin() const;
+    
+    /**
+     * Longest latency (microseconds, 0 if none)
+     */
+    uint32_t getMax() const;
+    
+    /**
+     * Average latency (microseconds, 0 if none)
+     */
+    double getMean() const;
+    
+    /**
+     * Latency that the given percent of measurements are at or below
+     * (upper edge of the histogram bucket, never more than getMax())
+     * 
+     * @param percent 0 to 100 (e.g. 95)
+     * @return Latency in microseconds (0 if none)
+     */
+    uint32_t getPercentile(double percent) const;
+    
+    /**
+     * Bucket width (microseconds)
+     */
+    uint32_t getBucketUs() const;
+    
+private:
+    uint32_t bucketUs;
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+LatencyStats::LatencyStats(uint32_t bucketUs)
+    : bucketUs(bucketUs > 0 ? bucketUs : DEFAULT_BUCKET_US) {
+    reset();
+}
+
+void LatencyStats::add(uint32_t latencyUs) {
+    uint32_t bucket = latencyUs / bucketUs;
+    if (bucket >= (uint32_t)BUCKET_COUNT) {
+        bucket = BUCKET_COUNT - 1;
+    }
+    buckets[bucket]++;
+    
+    if (count == 0 || latencyUs < minUs) {
+        minUs = latencyUs;
+    }
+    if (count == 0 || latencyUs > maxUs) {
+        maxUs = latencyUs;
+    }
+    count++;
+    totalUs += latencyUs;
+}
+
+void LatencyStats::reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] = 0;
+    }
+    count = 0;
+    minUs = 0;
+    maxUs = 0;
+    totalUs = 0;
+}
+
+uint32_t LatencyStats::getCount() const {
+    return count;
+}
+
+uint32_t LatencyStats::getMin() const {
+    return minUs;
+}
+
+uint32_t LatencyStats::getMax() const {
+    return maxUs;
+}
+
+double LatencyStats::getMean() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    return (double)totalUs / count;
+}
+
+uint32_t LatencyStats::getPercentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    
+    // Smallest bucket whose running total reaches the requested share
+    double needed = percent / 100.0 * count;
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= needed) {
+            uint32_t upperEdge = (i == BUCKET_COUNT - 1) ? maxUs : (uint32_t)(i + 1) * bucketUs;
+            return (upperEdge < maxUs) ? upperEdge : maxUs;
+        }
+    }
+    return maxUs;
+}
+
+uint32_t LatencyStats::getBucketUs() const {
+    return bucketUs;
+}
+
+// ----------------------------------------------------------------------------
+// ActuationFrame Class
+// ----------------------------------------------------------------------------
+/**
+ * ActuationFrame Class
+ * 
+ * Usage (each tick):
+ *   1. setDrive(), setMotor(), setPistons() while computing
+ *   2. apply() once at the end
+ */
+class ActuationFrame {
+public:
+    /**
+     * Motors, in the same order as AllMotors in main.cpp
+     */
+    enum Motor {
+        LEFT_FRONT, LEFT_MIDDLE, LEFT_BACK,
+        RIGHT_FRONT, RIGHT_MIDDLE, RIGHT_BACK,
+        INTAKE, RAMP, FULL_POWER_RAMP,
+        MOTOR_COUNT
+    };
+    
+    /**
+     * Number of pistons (both move the full power wheel together)
+     */
+    static const int PISTON_COUNT = 2;
+    
+    /**
+     * Writes per apply()
+     */
+    static const int WRITE_COUNT = MOTOR_COUNT + PISTON_COUNT;
+    
+    /**
+     * Writes one motor command (power in percent, -100 to 100)
+     */
+    typedef void (*MotorWriter)(Motor motor, int power);
+    
+    /**
+     * Writes one piston command (true = extended)
+     */
+    typedef void (*PistonWriter)(int piston, bool extended);
+    
+    /**
+     * Supplies the current time in microseconds (for skew measurement)
+     */
+    typedef uint32_t (*MicrosecondClock)();
+    
+    /**
+     * Create a frame: every motor stopped, pistons retracted
+     */
+    ActuationFrame();
+    
+    /**
+     * Stage both drive sides
+     * 
+     * @param leftPower Left side power (-100 to 100)
+     * @param rightPower Right side power (-100 to 100)
+     */
+    void setDrive(int leftPower, int rightPower);
+    
+    /**
+     * Stage one motor
+     * 
+     * @param motor Which motor
+     * @param power Power (-100 to 100, clamped)
+     */
+    void setMotor(Motor motor, int power);
+    
+    /**
+     * Stage both pistons
+     * 
+     * @param extended true = extended
+     */
+    void setPistons(bool extended);
+    
+    /**
+     * Staged power of a motor
+     */
+    int getMotor(Motor motor) const;
+    
+    /**
+     * Staged state of a piston
+     */
+    bool getPiston(int piston) const;
+    
+    /**
+     * Motor written at a position in the burst
+     * Drive pairs first (left front, right front, left middle, ...), then the rollers.
+     * 
+     * @param position 0 to MOTOR_COUNT - 1
+     */
+    static Motor writeOrder(int position);
+    
+    /**
+     * Write every staged command back-to-back: motors in writeOrder(), then pistons
+     * 
+     * @param writeMotor Function that commands one motor
+     * @param writePiston Function that commands one piston
+     * @param clock Microsecond clock (nullptr = don't measure)
+     * @return Skew: microseconds from the first write to the last (0 if not measured)
+     */
+    uint32_t apply(MotorWriter writeMotor, PistonWriter writePiston, MicrosecondClock clock = nullptr) const;
+    
+private:
+    int powers[MOTOR_COUNT];
+    bool pistons[PISTON_COUNT];
+};
+
+ActuationFrame::ActuationFrame() {
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        powers[i] = 0;
+    }
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        pistons[i] = false;
+    }
+}
+
+void ActuationFrame::setDrive(int leftPower, int rightPower) {
+    setMotor(LEFT_FRONT, leftPower);
+    setMotor(LEFT_MIDDLE, leftPower);
+    setMotor(LEFT_BACK, leftPower);
+    setMotor(RIGHT_FRONT, rightPower);
+    setMotor(RIGHT_MIDDLE, rightPower);
+    setMotor(RIGHT_BACK, rightPower);
+}
+
+void ActuationFrame::setMotor(Motor motor, int power) {
+    powers[motor] = DriveTrain::clamp(power, -100, 100);
+}
+
+void ActuationFrame::setPistons(bool extended) {
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        pistons[i] = extended;
+    }
+}
+
+int ActuationFrame::getMotor(Motor motor) const {
+    return powers[motor];
+}
+
+bool ActuationFrame::getPiston(int piston) const {
+    return pistons[piston];
+}
+
+ActuationFrame::Motor ActuationFrame::writeOrder(int position) {
+    static const Motor ORDER[MOTOR_COUNT] = {
+        LEFT_FRONT, RIGHT_FRONT,
+        LEFT_MIDDLE, RIGHT_MIDDLE,
+        LEFT_BACK, RIGHT_BACK,
+        INTAKE, RAMP, FULL_POWER_RAMP
+    };
+    return ORDER[position];
+}
+
+uint32_t ActuationFrame::apply(MotorWriter writeMotor, PistonWriter writePiston, MicrosecondClock clock) const {
+    uint32_t startUs = (clock != nullptr) ? clock() : 0;
+    
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+        Motor motor = writeOrder(i);
+        writeMotor(motor, powers[motor]);
+    }
+    for (int i = 0; i < PISTON_COUNT; i++) {
+        writePiston(i, pistons[i]);
+    }
+    
+    return (clock != nullptr) ? clock() - startUs : 0;
+}
+
+// ----------------------------------------------------------------------------
+// Command Class
+// ----------------------------------------------------------------------------
+/**
+ * Command Interface
+ * 
+ * Life of a command: initialize() once when scheduled, execute() every tick,
+ * then end() when isFinished() returns true (interrupted = false) or another
+ * command takes one of its subsystems (interrupted = true).
+ */
+class Command {
+public:
+    /**
+     * Subsystems a command can require (bit flags, combine with |)
+     */
+    enum Subsystem {
+        DRIVE = 1 << 0,      // Both drive sides
+        INTAKE = 1 << 1,     // Intake motor
+        RAMP = 1 << 2,       // Ramp motor (first two ramp wheels)
+        TOP_WHEEL = 1 << 3,  // Full power ramp motor
+        HEIGHT = 1 << 4      // Both pistons
+    };
+    
+    /**
+     * Number of subsystems
+     */
+    static const int SUBSYSTEM_COUNT = 5;
+    
+    virtual ~Command() {}
+    
+    /**
+     * Subsystems this command needs
+     * 
+     * @return Subsystem flags combined with |
+     */
+    virtual uint8_t getRequirements() const = 0;
+    
+    /**
+     * Whether another command may take this command's subsystems
+     * 
+     * @return true by default
+     */
+    virtual bool isInterruptible() const { return true; }
+    
+    /**
+     * Called once when the command is scheduled
+     */
+    virtual void initialize() {}
+    
+    /**
+     * Called every tick while scheduled
+     * Stage outputs only for the subsystems this command requires.
+     * 
+     * @param frame This tick's actuator commands
+     */
+    virtual void execute(ActuationFrame& frame) = 0;
+    
+    /**
+     * Checked after every execute()
+     * 
+     * @return true when the command is done (false by default - runs until interrupted)
+     */
+    virtual bool isFinished() { return false; }
+    
+    /**
+     * Called once when the command stops
+     * 
+     * @param interrupted true if cancelled or replaced, false if it finished
+     */
+    virtual void end(bool interrupted) { (void)interrupted; }
+};
+
+/**
+ * FunctionCommand Class
+ * 
+ * A command made from plain functions, for robot code that is written as functions
+ * (like the phase hooks). Any function except execute may be nullptr.
+ */
+class FunctionCommand : public Command {
+public:
+    typedef void (*InitializeFunction)();
+    typedef void (*ExecuteFunction)(ActuationFrame& frame);
+    typedef bool (*FinishedFunction)();
+    typedef void (*EndFunction)(bool interrupted);
+    
+    /**
+     * Create a command
+     * 
+     * @param requirements Subsystem flags combined with |
+     * @param executeFunction Runs every tick
+     * @param finishedFunction Returns true when done (nullptr = runs until interrupted)
+     * @param initializeFunction Runs when scheduled (nullptr = nothing)
+     * @param endFunction Runs when stopped (nullptr = nothing)
+     * @param interruptible false = nothing can take its subsystems until it finishes
+     */
+    FunctionCommand(uint8_t requirements, ExecuteFunction executeFunction,
+                    FinishedFunction finishedFunction = nullptr,
+                    InitializeFunction initializeFunction = nullptr,
+                    EndFunction endFunction = nullptr, bool interruptible = true)
+        : requirements(requirements), executeFunction(executeFunction),
+          finishedFunction(finishedFunction), initializeFunction(initializeFunction),
+          endFunction(endFunction), interruptible(interruptible) {}
+    
+    uint8_t getRequirements() const override { return requirements; }
+    bool isInterruptible() const override { return interruptible; }
+    
+    void initialize() override {
+        if (initializeFunction != nullptr) {
+            initializeFunction();
+        }
+    }
+    
+    void execute(ActuationFrame& frame) override {
+        executeFunction(frame);
+    }
+    
+    bool isFinished() override {
+        return (finishedFunction != nullptr) && finishedFunction();
+    }
+    
+    void end(bool interrupted) override {
+        if (endFunction != nullptr) {
+            endFunction(interrupted);
+        }
+    }
+    
+private:
+    uint8_t requirements;
+    ExecuteFunction executeFunction;
+    FinishedFunction finishedFunction;
+    InitializeFunction initializeFunction;
+    EndFunction endFunction;
+    bool interruptible;
+};
+
+// ----------------------------------------------------------------------------
+// RobotDescriptor Class
+// ----------------------------------------------------------------------------
+/**
+ * RobotDescriptor Class
+ * 
+ * To rewire the robot, edit MOTORS / PISTONS / sensor ports below - nothing else.
+ * MOTORS is indexed by ActuationFrame::Motor (same order as AllMotors).
+ */
+class RobotDescriptor {
+public:
+    /**
+     * Motor cartridge
+     */
+    enum Gearset {
+        GEARSET_36_1,  // Red (100 rpm)
+        GEARSET_18_1,  // Green (200 rpm)
+        GEARSET_6_1    // Blue (600 rpm)
+    };
+    
+    /**
+     * Drive side of a motor
+     */
+    enum Side {
+        LEFT,
+        RIGHT,
+        NO_SIDE  // Not a drive motor
+    };
+    
+    /**
+     * One motor
+     */
+    struct MotorSpec {
+        ActuationFrame::Motor id;      // Must match its position in MOTORS
+        const char* name;              // Telemetry name
+        int port;                      // Smart port (1-21)
+        Gearset gearset;
+        bool reversed;                 // true = spins the other way for forward
+        Side side;
+        Command::Subsystem subsystem;  // Who commands it (see CommandScheduler)
+    };
+    
+    /**
+     * One pneumatic piston (solenoid on a 3-wire port)
+     */
+    struct PistonSpec {
+        const char* name;
+        char port;  // 3-wire port letter ('A' to 'H')
+    };
+    
+    static constexpr int MOTOR_COUNT = ActuationFrame::MOTOR_COUNT;
+    static constexpr int PISTON_COUNT = ActuationFrame::PISTON_COUNT;
+    
+    // Adjust ports and reversals to match your robot's wiring
+    static constexpr MotorSpec MOTORS[MOTOR_COUNT] = {
+        {ActuationFrame::LEFT_FRONT, "LeftFront", 1, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::LEFT_MIDDLE, "LeftMiddle", 2, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::LEFT_BACK, "LeftBack", 3, GEARSET_18_1, false, LEFT, Command::DRIVE},
+        {ActuationFrame::RIGHT_FRONT, "RightFront", 4, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::RIGHT_MIDDLE, "RightMiddle", 5, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::RIGHT_BACK, "RightBack", 6, GEARSET_18_1, true, RIGHT, Command::DRIVE},
+        {ActuationFrame::INTAKE, "Intake", 7, GEARSET_18_1, false, NO_SIDE, Command::INTAKE},
+        {ActuationFrame::RAMP, "Ramp", 8, GEARSET_18_1, false, NO_SIDE, Command::RAMP},
+        {ActuationFrame::FULL_POWER_RAMP, "TopWheel", 9, GEARSET_18_1, false, NO_SIDE, Command::TOP_WHEEL}
+    };
+    
+    // Both pistons move the full power wheel together
+    static constexpr PistonSpec PISTONS[PISTON_COUNT] = {
+        {"Piston1", 'A'},
+        {"Piston2", 'B'}
+    };
+    
+    // Limit switch closed at the top of the piston stroke (optional, see PistonTravel)
+    static constexpr char HEIGHT_SWITCH_PORT = 'C';
+    
+    static constexpr int INERTIAL_PORT = 10;  // Mount flat near the center of the robot
+    static constexpr int GPS_PORT = 11;
+    static constexpr int VISION_PORT = 12;  // Front of the robot, looking slightly down at the field
+    
+    // Distance sensors for start position detection (see StartDetector), level, facing out
+    static constexpr int DISTANCE_LEFT_PORT = 13;
+    static constexpr int DISTANCE_RIGHT_PORT = 14;
+    static constexpr int DISTANCE_BACK_PORT = 15;
+    
+    /**
+     * Number of motors in any of the given subsystems
+     * 
+     * @param subsystems Command::Subsystem flags combined with |
+     */
+    static constexpr int countMotors(uint8_t subsystems, int from = 0) {
+        return (from >= MOTOR_COUNT) ? 0
+             : ((MOTORS[from].subsystem & subsystems) ? 1 : 0) + countMotors(subsystems, from + 1);
+    }
+    
+    /**
+     * Number of motors on a drive side
+     */
+    static constexpr int countSide(Side side, int from = 0) {
+        return (from >= MOTOR_COUNT) ? 0
+             : ((MOTORS[from].side == side) ? 1 : 0) + countSide(side, from + 1);
+    }
+    
+    /**
+     * The nth motor (front to back) on a drive side
+     * 
+     * @return Motor index, or -1 if the side has fewer motors
+     */
+    static constexpr int sideMotor(Side side, int n, int from = 0) {
+        return (from >= MOTOR_COUNT) ? -1
+             : (MOTORS[from].side != side) ? sideMotor(side, n, from + 1)
+             : (n == 0) ? from
+             : sideMotor(side, n - 1, from + 1);
+    }
+    
+    /**
+     * Energy accounting group of a motor
+     */
+    static constexpr EnergyMonitor::Subsystem energySubsystem(int motor) {
+        return (MOTORS[motor].subsystem == Command::DRIVE) ? EnergyMonitor::DRIVE
+             : (MOTORS[motor].subsystem == Command::INTAKE) ? EnergyMonitor::INTAKE
+             : (MOTORS[motor].subsystem == Command::RAMP) ? EnergyMonitor::RAMP
+             : EnergyMonitor::FULL_POWER_RAMP;
+    }
+    
+    /**
+     * Free speed of a motor's cartridge (rpm)
+     */
+    static constexpr double maxRpm(int motor) {
+        return (MOTORS[motor].gearset == GEARSET_36_1) ? 100.0
+             : (MOTORS[motor].gearset == GEARSET_18_1) ? 200.0
+             : 600.0;
+    }
+    
+    /**
+     * Checks used by the static_asserts below
+     */
+    static constexpr bool idsInOrder(int from = 0) {
+        return (from >= MOTOR_COUNT) || (MOTORS[from].id == from && idsInOrder(from + 1));
+    }
+    
+    static constexpr bool sensorPort(int port) {
+        return port == INERTIAL_PORT || port == GPS_PORT || port == VISION_PORT ||
+               port == DISTANCE_LEFT_PORT || port == DISTANCE_RIGHT_PORT || port == DISTANCE_BACK_PORT;
+    }
+    
+    static constexpr bool sensorPortsDistinct() {
+        return INERTIAL_PORT != GPS_PORT && VISION_PORT != INERTIAL_PORT && VISION_PORT != GPS_PORT &&
+               !(DISTANCE_LEFT_PORT == INERTIAL_PORT || DISTANCE_LEFT_PORT == GPS_PORT || DISTANCE_LEFT_PORT == VISION_PORT) &&
+               !(DISTANCE_RIGHT_PORT == INERTIAL_PORT || DISTANCE_RIGHT_PORT == GPS_PORT || DISTANCE_RIGHT_PORT == VISION_PORT) &&
+               !(DISTANCE_BACK_PORT == INERTIAL_PORT || DISTANCE_BACK_PORT == GPS_PORT || DISTANCE_BACK_PORT == VISION_PORT) &&
+               DISTANCE_LEFT_PORT != DISTANCE_RIGHT_PORT && DISTANCE_LEFT_PORT != DISTANCE_BACK_PORT &&
+               DISTANCE_RIGHT_PORT != DISTANCE_BACK_PORT;
+    }
+    
+    static constexpr bool portUsedAfter(int port, int from) {
+        return (from < MOTOR_COUNT) && (MOTORS[from].port == port || portUsedAfter(port, from + 1));
+    }
+    
+    static constexpr bool motorPortsValid(int from = 0) {
+        return (from >= MOTOR_COUNT) ||
+               (MOTORS[from].port >= 1 && MOTORS[from].port <= 21 &&
+                !sensorPort(MOTORS[from].port) &&
+                !portUsedAfter(MOTORS[from].port, from + 1) && motorPortsValid(from + 1));
+    }
+    
+    static constexpr bool pistonPortsValid(int from = 0) {
+        return (from >= PISTON_COUNT) ||
+               (PISTONS[from].port >= 'A' && PISTONS[from].port <= 'H' &&
+                (from + 1 >= PISTON_COUNT || PISTONS[from].port != PISTONS[from + 1].port) &&
+                pistonPortsValid(from + 1));
+    }
+    
+    static constexpr bool pistonPortUsed(char port, int from = 0) {
+        return (from < PISTON_COUNT) && (PISTONS[from].port == port || pistonPortUsed(port, from + 1));
+    }
+};
+
+static_assert(RobotDescriptor::idsInOrder(), "RobotDescriptor: MOTORS must be in ActuationFrame::Motor order");
+static_assert(RobotDescriptor::motorPortsValid(), "RobotDescriptor: each motor needs its own smart port (1-21)");
+static_assert(RobotDescriptor::pistonPortsValid(), "RobotDescriptor: each piston needs its own 3-wire port (A-H)");
+static_assert(!RobotDescriptor::pistonPortUsed(RobotDescriptor::HEIGHT_SWITCH_PORT),
+              "RobotDescriptor: the height switch needs its own 3-wire port");
+static_assert(RobotDescriptor::sensorPortsDistinct(), "RobotDescriptor: sensors share a port");
+static_assert(RobotDescriptor::countSide(RobotDescriptor::LEFT) == RobotDescriptor::countSide(RobotDescriptor::RIGHT),
+              "RobotDescriptor: both drive sides need the same number of motors");
+static_assert(RobotDescriptor::countMotors(Command::DRIVE) ==
+              RobotDescriptor::countSide(RobotDescriptor::LEFT) + RobotDescriptor::countSide(RobotDescriptor::RIGHT),
+              "RobotDescriptor: every drive motor needs a side");
+
+constexpr RobotDescriptor::MotorSpec RobotDescriptor::MOTORS[RobotDescriptor::MOTOR_COUNT];
+constexpr RobotDescriptor::PistonSpec RobotDescriptor::PISTONS[RobotDescriptor::PISTON_COUNT];
+// ----------------------------------------------------------------------------
+// Telemetry Class
+// ----------------------------------------------------------------------------
+/**
+ * Telemetry Class
+ * 
+ * Pure formatting functions. Each returns the number of characters written
+ * (not counting the terminating '\0'), truncating safely if the buffer is too small.
+ */
+class Telemetry {
+public:
+    /**
+     * Format an energy telemetry record
+     * 
+     * Layout: ENERGY,<time ms>,<drive J>,<intake J>,<ramp J>,<full power ramp J>,
+     *         <total W>,<state of charge %>,<internal resistance mOhm>
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param energy Energy totals
+     * @param battery Battery model
+     * @return Characters written
+     */
+    static int formatEnergyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                  const EnergyMonitor& energy, const BatteryModel& battery);
+    
+    /**
+     * Format the energy split for the Brain screen, e.g. "Drv 62% Int 12% Rmp 9% Top 17%"
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param energy Energy totals
+     * @return Characters written
+     */
+    static int formatEnergyDashboard(char* buffer, int bufferSize, const EnergyMonitor& energy);
+    
+    /**
+     * Format the battery state for the Brain screen, e.g. "Batt 87% R 85mOhm Match 3"
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param battery Battery model
+     * @return Characters written
+     */
+    static int formatBatteryDashboard(char* buffer, int bufferSize, const BatteryModel& battery);
+    
+    /**
+     * Format a latency distribution record
+     * 
+     * Layout: LATENCY,<time ms>,<name>,<count>,<mean us>,<p95 us>,<max us>
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param name What was measured (e.g. "input")
+     * @param stats The distribution
+     * @return Characters written
+     */
+    static int formatLatencyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                   const char* name, const LatencyStats& stats);
+    
+    /**
+     * Format the per-motor record layout (print once at startup)
+     * One column group per motor, in RobotDescriptor::MOTORS order.
+     * 
+     * Layout: MOTORS_LAYOUT,rpm;amps;celsius,<motor 0 name>,<motor 1 name>,...
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @return Characters written
+     */
+    static int formatMotorLayout(char* buffer, int bufferSize);
+    
+    /**
+     * Format a per-motor record (columns as in formatMotorLayout())
+     * 
+     * Layout: MOTORS,<time ms>,<rpm>,<amps>,<celsius>,... (three values per motor)
+     * 
+     * @param buffer Output buffer
+     * @param bufferSize Size of the output buffer in bytes
+     * @param timestampMs Time of the record
+     * @param rpm Speed of each motor (RobotDescriptor::MOTOR_COUNT values)
+     * @param amps Current of each motor
+     * @param celsius Temperature of each motor
+     * @return Characters written
+     */
+    static int formatMotorRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                 const double rpm[], const double amps[], const double celsius[]);
+                                 
+private:
+    static int finish(int written, int bufferSize);
+};
+
+int Telemetry::finish(int written, int bufferSize) {
+    // snprintf returns the length it WANTED to write; report what actually fit
+    if (written < 0 || bufferSize <= 0) {
+        return 0;
+    }
+    if (written >= bufferSize) {
+        return bufferSize - 1;
+    }
+    return written;
+}
+
+int Telemetry::formatEnergyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                  const EnergyMonitor& energy, const BatteryModel& battery) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "ENERGY,%lu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.0f",
+                                static_cast<unsigned long>(timestampMs),
+                                energy.getEnergy(EnergyMonitor::DRIVE),
+                                energy.getEnergy(EnergyMonitor::INTAKE),
+                                energy.getEnergy(EnergyMonitor::RAMP),
+                                energy.getEnergy(EnergyMonitor::FULL_POWER_RAMP),
+                                energy.getTotalPower(),
+                                battery.getStateOfCharge(),
+                                battery.getInternalResistance() * 1000.0);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatEnergyDashboard(char* buffer, int bufferSize, const EnergyMonitor& energy) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "Drv %.0f%% Int %.0f%% Rmp %.0f%% Top %.0f%%",
+                                energy.getShare(EnergyMonitor::DRIVE) * 100.0,
+                                energy.getShare(EnergyMonitor::INTAKE) * 100.0,
+                                energy.getShare(EnergyMonitor::RAMP) * 100.0,
+                                energy.getShare(EnergyMonitor::FULL_POWER_RAMP) * 100.0);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatBatteryDashboard(char* buffer, int bufferSize, const BatteryModel& battery) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    BatteryModel::State state = battery.getState();
+    int written = std::snprintf(buffer, bufferSize, "Batt %.0f%% R %.0fmOhm Match %d",
+                                state.stateOfCharge, state.internalResistance * 1000.0, state.matchCount);
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatLatencyRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                   const char* name, const LatencyStats& stats) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "LATENCY,%lu,%s,%lu,%.0f,%lu,%lu",
+                                (unsigned long)timestampMs, name, (unsigned long)stats.getCount(),
+                                stats.getMean(), (unsigned long)stats.getPercentile(95.0),
+                                (unsigned long)stats.getMax());
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatMotorLayout(char* buffer, int bufferSize) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "MOTORS_LAYOUT,rpm;amps;celsius");
+    for (int i = 0; i < RobotDescriptor::MOTOR_COUNT && written >= 0 && written < bufferSize; i++) {
+        written += std::snprintf(buffer + written, bufferSize - written, ",%s", RobotDescriptor::MOTORS[i].name);
+    }
+    return finish(written, bufferSize);
+}
+
+int Telemetry::formatMotorRecord(char* buffer, int bufferSize, uint32_t timestampMs,
+                                 const double rpm[], const double amps[], const double celsius[]) {
+    if (buffer == nullptr || bufferSize <= 0) {
+        return 0;
+    }
+    int written = std::snprintf(buffer, bufferSize, "MOTORS,%lu", (unsigned long)timestampMs);
+    for (int i = 0; i < RobotDescriptor::MOTOR_COUNT && written >= 0 && written < bufferSize; i++) {
+        written += std::snprintf(buffer + written, bufferSize - written, ",%.0f,%.1f,%.0f",
+                                 rpm[i], amps[i], celsius[i]);
+    }
+    return finish(written, bufferSize);
+}
+// ----------------------------------------------------------------------------
+// MatchClock Class
+// ----------------------------------------------------------------------------
+/**
+ * MatchClock Class
+ * 
+ * Call update() regularly (every tick) with the current competition phase.
+ */
+class MatchClock {
+public:
+    /**
+     * Competition phases
+     */
+    enum Phase {
+        DISABLED = 0,    // Robot disabled (before/between/after periods)
+        AUTONOMOUS = 1,  // Autonomous period
+        DRIVER = 2       // Driver control period
+    };
+    
+    /**
+     * Standard match period lengths (VRC: 0:15 autonomous, 1:45 driver control)
+     */
+    static const uint32_t DEFAULT_AUTONOMOUS_MS = 15000;
+    static const uint32_t DEFAULT_DRIVER_MS = 105000;
+    
+    MatchClock();
+    
+    /**
+     * Turn competition flags into a phase
+     * 
+     * Pure function.
+     * 
+     * @param enabled Competition.isEnabled()
+     * @param autonomous Competition.isAutonomous()
+     * @return DISABLED, AUTONOMOUS or DRIVER
+     */
+    static Phase phaseFromFlags(bool enabled, bool autonomous);
+    
+    /**
+     * Change the period lengths (e.g. 60 s for skills runs)
+     * 
+     * @param autonomousMs Autonomous period length
+     * @param driverMs Driver control period length
+     */
+    void setDurations(uint32_t autonomousMs, uint32_t driverMs);
+    
+    /**
+     * Report the current phase
+     * 
+     * @param phase Current competition phase
+     * @param nowMs Current time
+     * @return true if the phase changed since the last update (a transition)
+     */
+    bool update(Phase phase, uint32_t nowMs);
+    
+    /**
+     * Current phase
+     */
+    Phase getPhase() const;
+    
+    /**
+     * Time since the current phase started
+     * 
+     * @param nowMs Current time
+     */
+    uint32_t getElapsedMs(uint32_t nowMs) const;
+    
+    /**
+     * Time left in the current period (0 when disabled or the period is over)
+     * 
+     * @param nowMs Current time
+     */
+    uint32_t getRemainingMs(uint32_t nowMs) const;
+    
+private:
+    Phase phase;
+    uint32_t phaseStartMs;
+    uint32_t autonomousMs;
+    uint32_t driverMs;
+};
+
+MatchClock::MatchClock()
+    : phase(DISABLED),
+      phaseStartMs(0),
+      autonomousMs(DEFAULT_AUTONOMOUS_MS),
+      driverMs(DEFAULT_DRIVER_MS) {
+}
+
+MatchClock::Phase MatchClock::phaseFromFlags(bool enabled, bool autonomous) {
+    if (!enabled) {
+        return DISABLED;
+    }
+    return autonomous ? AUTONOMOUS : DRIVER;
+}
+
+void MatchClock::setDurations(uint32_t autonomousMs, uint32_t driverMs) {
+    this->autonomousMs = autonomousMs;
+    this->driverMs = driverMs;
+}
+
+bool MatchClock::update(Phase newPhase, uint32_t nowMs) {
+    if (newPhase == phase) {
+        return false;
+    }
+    // Transition: the new period starts now
+    phase = newPhase;
+    phaseStartMs = nowMs;
+    return true;
+}
+
+MatchClock::Phase MatchClock::getPhase() const {
+    return phase;
+}
+
+uint32_t MatchClock::getElapsedMs(uint32_t nowMs) const {
+    return nowMs - phaseStartMs;
+}
+
+uint32_t MatchClock::getRemainingMs(uint32_t nowMs) const {
+    uint32_t duration = 0;
+    if (phase == AUTONOMOUS) {
+        duration = autonomousMs;
+    } else if (phase == DRIVER) {
+        duration = driverMs;
+    }
+    
+    uint32_t elapsed = getElapsedMs(nowMs);
+    if (elapsed >= duration) {
+        return 0;
+    }
+    return duration - elapsed;
+}
+
+// ----------------------------------------------------------------------------
+// MatchRuleEngine Class
+// ----------------------------------------------------------------------------
+/**
+ * MatchRuleEngine Class
+ * 
+ * Usage:
+ *   1. addRule() for each timed behavior (at startup)
+ *   2. startPhase() when the competition phase changes
+ *   3. update() every tick - returns a bit mask of actions that just became due
+ */
+class MatchRuleEngine {
+public:
+    /**
+     * Things a rule can do (used as bit positions in the update() mask)
+     */
+    enum Action {
+        RELAX_LIMITS = 0,     // Raise motor torque limits for the final push
+        SET_HEIGHT_HIGH = 1,  // Raise the full power wheel for endgame scoring
+        SET_HEIGHT_LOW = 2,   // Lower the full power wheel
+        RUMBLE_DRIVER = 3,    // Rumble the controller to warn the driver
+        ACTION_COUNT = 4
+    };
+    
+    /**
+     * Largest number of rules (fixed array, no dynamic allocation)
+     */
+    static const int MAX_RULES = 16;
+    
+    /**
+     * A timed behavior
+     */
+    struct Rule {
+        MatchClock::Phase phase;  // Period the rule belongs to
+        uint32_t remainingMs;     // Fires when this much time (or less) is left
+        Action action;            // What to do
+    };
+    
+    MatchRuleEngine();
+    
+    /**
+     * Bit for an action in the update() mask
+     * 
+     * @param action The action
+     * @return 1 << action
+     */
+    static uint32_t actionBit(Action action);
+    
+    /**
+     * Add a rule (call at startup, not during a match)
+     * 
+     * @param phase Period the rule belongs to
+     * @param remainingMs Time left in that period when the rule fires
+     * @param action What to do
+     * @return false if the rule table is full
+     */
+    bool addRule(MatchClock::Phase phase, uint32_t remainingMs, Action action);
+    
+    /**
+     * Remove all rules
+     */
+    void clearRules();
+    
+    /**
+     * A new phase started: arm that phase's rules from the beginning
+     * 
+     * @param phase The phase that just started
+     */
+    void startPhase(MatchClock::Phase phase);
+    
+    /**
+     * Check for rules that are now due (constant time per tick)
+     * 
+     * Each rule fires once per phase.
+     * 
+     * @param remainingMs Time left in the current phase
+     * @return Bit mask of actions due this tick (test with actionBit())
+     */
+    uint32_t update(uint32_t remainingMs);
+    
+    /**
+     * Number of rules
+     */
+    int getRuleCount() const;
+    
+private:
+    Rule rules[MAX_RULES];  // Sorted by phase, then by remainingMs from most to least
+    int ruleCount;
+    MatchClock::Phase currentPhase;
+    int nextRule;           // Next rule to check in the current phase
+};
+
+MatchRuleEngine::MatchRuleEngine()
+    : ruleCount(0), currentPhase(MatchClock::DISABLED), nextRule(0) {
+}
+
+uint32_t MatchRuleEngine::actionBit(Action action) {
+    return 1u << static_cast<uint32_t>(action);
+}
+
+bool MatchRuleEngine::addRule(MatchClock::Phase phase, uint32_t remainingMs, Action action) {
+    if (ruleCount >= MAX_RULES) {
+        return false;
+    }
+    
+    // Insertion sort: keep rules grouped by phase, earliest-firing (most time left) first.
+    // This runs at startup only, so the per-tick check can stay O(1).
+    int position = ruleCount;
+    while (position > 0) {
+        const Rule& before = rules[position - 1];
+        bool beforeComesFirst = before.phase < phase ||
+                                (before.phase == phase && before.remainingMs >= remainingMs);
+        if (beforeComesFirst) {
+            break;
+        }
+        rules[position] = before;
+        position--;
+    }
+    rules[position].phase = phase;
+    rules[position].remainingMs = remainingMs;
+    rules[position].action = action;
+    ruleCount++;
+    return true;
+}
+
+void MatchRuleEngine::clearRules() {
+    ruleCount = 0;
+    nextRule = 0;
+}
+
+void MatchRuleEngine::startPhase(MatchClock::Phase phase) {
+    currentPhase = phase;
+    
+    // Skip to the first rule of this phase
+    nextRule = 0;
+    while (nextRule < ruleCount && rules[nextRule].phase < phase) {
+        nextRule++;
+    }
+}
+
+uint32_t MatchRuleEngine::update(uint32_t remainingMs) {
+    uint32_t due = 0;
+    
+    // Only the next rule can be due; the loop repeats only when several rules share a time
+    while (nextRule < ruleCount &&
+           rules[nextRule].phase == currentPhase &&
+           remainingMs <= rules[nextRule].remainingMs) {
+        due |= actionBit(rules[nextRule].action);
+        nextRule++;
+    }
+    return due;
+}
+
+int MatchRuleEngine::getRuleCount() const {
+    return ruleCount;
+}
+
+// ----------------------------------------------------------------------------
+// PhaseManager Class
+// ----------------------------------------------------------------------------
+/**
+ * PhaseManager Class
+ * 
+ * Usage:
+ *   1. setHooks() for each phase at startup
+ *   2. transition() whenever a phase change is detected (safe to call repeatedly)
+ *   3. Read and write subsystem state through getState()
+ */
+class PhaseManager {
+public:
+    /**
+     * Enter/exit hook: a plain function with no arguments
+     */
+    typedef void (*Hook)();
+    
+    /**
+     * Supplies the current time in microseconds (for latency measurement)
+     */
+    typedef uint32_t (*MicrosecondClock)();
+    
+    /**
+     * Subsystem state owned by the manager (used to be loose globals in main.cpp)
+     */
+    struct RobotState {
+        PneumaticController::HeightPosition height;  // Current full power wheel height
+        bool lastToggleButton;                       // A button last tick (edge detection)
+        IntakeController::MotorState intakeState;    // Last intake command
+        IntakeController::MotorState rampState;      // Last ramp command
+        RampController::MotorState fullPowerState;   // Last full power ramp command
+    };
+    
+    /**
+     * What the first driver control tick needs, prepared during autonomous
+     */
+    struct DriverHandoff {
+        bool ready;                                   // Prepared and not yet used
+        uint32_t preparedAtMs;                        // When it was prepared
+        int leftPower;                                // Drive powers from the sticks (-100 to 100)
+        int rightPower;
+        IntakeController::MotorState intakeState;     // Intake command from the buttons
+        IntakeController::MotorState rampState;       // Ramp command from the buttons
+        RampController::MotorState fullPowerState;    // Full power ramp command from the buttons
+        bool toggleButtonHeld;                        // A held across the boundary (must not toggle)
+    };
+    
+    /**
+     * Oldest handoff whose motor commands may still be applied directly (ms)
+     * Older handoffs (e.g. across the disabled gap in a real match) only restore state.
+     */
+    static const uint32_t HANDOFF_MAX_AGE_MS = 100;
+    
+    /**
+     * Number of phases (DISABLED, AUTONOMOUS, DRIVER)
+     */
+    static const int PHASE_COUNT = 3;
+    
+    /**
+     * Create a manager
+     * 
+     * @param clock Microsecond clock for latency measurement (nullptr = don't measure)
+     */
+    PhaseManager(MicrosecondClock clock = nullptr);
+    
+    /**
+     * Default state: LOW height, everything stopped, no button held
+     */
+    static RobotState defaultState();
+    
+    /**
+     * Set the hooks for a phase (either may be nullptr)
+     * 
+     * @param phase The phase
+     * @param enter Called when the phase starts
+     * @param exit Called when the phase ends
+     */
+    void setHooks(MatchClock::Phase phase, Hook enter, Hook exit);
+    
+    /**
+     * Switch phase: exit hook of the old phase, then enter hook of the new one
+     * 
+     * Calling it again with the current phase does nothing, so both the Competition
+     * callbacks and a polling task can report the same change.
+     * 
+     * @param phase New phase
+     * @return true if a transition happened
+     */
+    bool transition(MatchClock::Phase phase);
+    
+    /**
+     * Current phase
+     */
+    MatchClock::Phase getPhase() const;
+    
+    /**
+     * Subsystem state (read and write)
+     */
+    RobotState& getState();
+    
+    /**
+     * Store a prepared driver handoff (replaces any previous one)
+     * 
+     * @param handoff Prepared values (ready is set automatically)
+     */
+    void prepareHandoff(const DriverHandoff& handoff);
+    
+    /**
+     * Use the handoff once: copies its state into getState()
+     * 
+     * @param nowMs Current time
+     * @param handoff Output: the handoff
+     * @return true if the handoff's motor commands are fresh enough to apply directly
+     */
+    bool takeHandoff(uint32_t nowMs, DriverHandoff& handoff);
+    
+    /**
+     * True if a handoff is prepared and not yet used
+     */
+    bool hasHandoff() const;
+    
+    /**
+     * Mark the first control tick of the current phase as done
+     * (records the transition-to-first-tick latency; later calls are ignored)
+     */
+    void markFirstTick();
+    
+    /**
+     * Time the last transition spent in its exit + enter hooks (microseconds)
+     */
+    uint32_t getHookLatencyUs() const;
+    
+    /**
+     * Time from the last transition to the first control tick (microseconds, 0 if not yet)
+     */
+    uint32_t getFirstTickLatencyUs() const;
+    
+    /**
+     * Worst hook latency seen since startup (microseconds)
+     */
+    uint32_t getMaxHookLatencyUs() const;
+    
+    /**
+     * Number of transitions since startup
+     */
+    int getTransitionCount() const;
+    
+private:
+    uint32_t now() const;
+    
+    MicrosecondClock clock;
+    MatchClock::Phase phase;
+    RobotState state;
+    DriverHandoff handoff;
+    Hook enterHooks[PHASE_COUNT];
+    Hook exitHooks[PHASE_COUNT];
+    uint32_t transitionStartUs;
+    uint32_t hookLatencyUs;
+    uint32_t maxHookLatencyUs;
+    uint32_t firstTickLatencyUs;
+    bool waitingForFirstTick;
+    int transitionCount;
+};
+
+PhaseManager::PhaseManager(MicrosecondClock clock)
+    : clock(clock),
+      phase(MatchClock::DISABLED),
+      state(defaultState()),
+      transitionStartUs(0),
+      hookLatencyUs(0),
+      maxHookLatencyUs(0),
+      firstTickLatencyUs(0),
+      waitingForFirstTick(false),
+      transitionCount(0) {
+    handoff.ready = false;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        enterHooks[i] = nullptr;
+        exitHooks[i] = nullptr;
+    }
+}
+
+PhaseManager::RobotState PhaseManager::defaultState() {
+    RobotState defaults;
+    defaults.height = PneumaticController::LOW;
+    defaults.lastToggleButton = false;
+    defaults.intakeState = IntakeController::STOP;
+    defaults.rampState = IntakeController::STOP;
+    defaults.fullPowerState = RampController::STOP;
+    return defaults;
+}
+
+uint32_t PhaseManager::now() const {
+    return clock != nullptr ? clock() : 0;
+}
+
+void PhaseManager::setHooks(MatchClock::Phase phase, Hook enter, Hook exit) {
+    // Bounds check before using the enum as an array index
+    if (phase < 0 || phase >= PHASE_COUNT) {
+        return;
+    }
+    enterHooks[phase] = enter;
+    exitHooks[phase] = exit;
+}
+
+bool PhaseManager::transition(MatchClock::Phase newPhase) {
+    if (newPhase == phase || newPhase < 0 || newPhase >= PHASE_COUNT) {
+        return false;
+    }
+    
+    transitionStartUs = now();
+    
+    // Leave the old phase cleanly before starting the new one
+    if (exitHooks[phase] != nullptr) {
+        exitHooks[phase]();
+    }
+    phase = newPhase;
+    if (enterHooks[phase] != nullptr) {
+        enterHooks[phase]();
+    }
+    
+    hookLatencyUs = now() - transitionStartUs;
+    if (hookLatencyUs > maxHookLatencyUs) {
+        maxHookLatencyUs = hookLatencyUs;
+    }
+    firstTickLatencyUs = 0;
+    waitingForFirstTick = true;
+    transitionCount++;
+    return true;
+}
+
+MatchClock::Phase PhaseManager::getPhase() const {
+    return phase;
+}
+
+PhaseManager::RobotState& PhaseManager::getState() {
+    return state;
+}
+
+void PhaseManager::prepareHandoff(const DriverHandoff& prepared) {
+    handoff = prepared;
+    handoff.ready = true;
+}
+
+bool PhaseManager::takeHandoff(uint32_t nowMs, DriverHandoff& out) {
+    if (!handoff.ready) {
+        return false;
+    }
+    out = handoff;
+    handoff.ready = false;
+    
+    // State always carries over: a held A button must not count as a new press
+    state.lastToggleButton = out.toggleButtonHeld;
+    state.intakeState = out.intakeState;
+    state.rampState = out.rampState;
+    state.fullPowerState = out.fullPowerState;
+    
+    // Motor commands are only safe to apply if the sticks were read moments ago
+    return (nowMs - out.preparedAtMs) <= HANDOFF_MAX_AGE_MS;
+}
+
+bool PhaseManager::hasHandoff() const {
+    return handoff.ready;
+}
+
+void PhaseManager::markFirstTick() {
+    if (!waitingForFirstTick) {
+        return;
+    }
+    waitingForFirstTick = false;
+    firstTickLatencyUs = now() - transitionStartUs;
+}
+
+uint32_t PhaseManager::getHookLatencyUs() const {
+    return hookLatencyUs;
+}
+
+uint32_t PhaseManager::getFirstTickLatencyUs() const {
+    return firstTickLatencyUs;
+}
+
+uint32_t PhaseManager::getMaxHookLatencyUs() const {
+    return maxHookLatencyUs;
+}
+
+int PhaseManager::getTransitionCount() const {
+    return transitionCount;
+}
+
+// ----------------------------------------------------------------------------
+// HeadingSnap Class
+// ----------------------------------------------------------------------------
+/**
+ * HeadingSnap Class
+ * 
+ * Usage (once per control tick):
+ *   1. start() when a D-pad button is pressed
+ *   2. update() with the gyro heading; while it returns true, use its motor powers
+ *   3. cancel() as soon as the driver moves a stick
+ */
+class HeadingSnap {
+public:
+    /**
+     * Maximum turn speed of the profile (degrees per second)
+     */
+    static constexpr double MAX_TURN_RATE = 300.0;
+    
+    /**
+     * Turn acceleration / deceleration of the profile (degrees per second squared)
+     */
+    static constexpr double TURN_ACCEL = 1500.0;
+    
+    /**
+     * Power per degree/second of profile speed (feedforward, percent)
+     * About 100% / top turn speed of the drive.
+     */
+    static constexpr double KV = 0.22;
+    
+    /**
+     * Feedforward looks this far ahead in the profile (ms)
+     * The drive takes about this long to reach a commanded speed; without the lead
+     * the robot is still turning fast when the profile has already stopped.
+     */
+    static const uint32_t FEEDFORWARD_LEAD_MS = 80;
+    
+    /**
+     * Power per degree of error from the profile (feedback, percent)
+     */
+    static constexpr double KP = 1.6;
+    
+    /**
+     * Finished when within this many degrees of the target...
+     */
+    static constexpr double SETTLE_TOLERANCE = 2.0;
+    
+    /**
+     * ...for this long after the profile ends (ms)
+     */
+    static const uint32_t SETTLE_TIME_MS = 60;
+    
+    /**
+     * Give up this long after the profile should have ended (ms)
+     */
+    static const uint32_t TIMEOUT_MARGIN_MS = 750;
+    
+    /**
+     * Create an idle snap
+     */
+    HeadingSnap();
+    
+    /**
+     * Start a turn to an absolute heading (shortest direction)
+     * 
+     * @param currentHeading Gyro heading now (degrees)
+     * @param targetHeading Heading to end at (degrees)
+     * @param nowMs Current time
+     */
+    void start(double currentHeading, double targetHeading, uint32_t nowMs);
+    
+    /**
+     * Start a turn by a relative angle (e.g. 90, -90, 180)
+     * 
+     * If a snap is already running, the angle is added to its target, so pressing
+     * right twice turns 180 degrees.
+     * 
+     * @param currentHeading Gyro heading now (degrees)
+     * @param angle Turn in degrees (positive = clockwise)
+     * @param nowMs Current time
+     */
+    void startRelative(double currentHeading, double angle, uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param heading Gyro heading now (degrees)
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return true while the snap is running (use the powers), false when idle
+     */
+    bool update(double heading, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop the snap and hand control back to the driver
+     */
+    void cancel();
+    
+    /**
+     * True while a snap is running
+     */
+    bool isActive() const;
+    
+    /**
+     * Heading the running (or last) snap is turning to
+     */
+    double getTarget() const;
+    
+    /**
+     * Nearest multiple of 90 degrees (field-square preset)
+     * 
+     * @param heading Any heading (degrees)
+     * @return 0, 90, 180 or 270
+     */
+    static double nearestPreset(double heading);
+    
+    /**
+     * Time the profile needs for a turn (ms)
+     * 
+     * @param angle Turn size in degrees (sign ignored)
+     */
+    static uint32_t profileDurationMs(double angle);
+    
+    /**
+     * Profile position and speed at a time into the turn
+     * 
+     * @param angle Total turn (degrees, signed)
+     * @param elapsedSeconds Time since the start
+     * @param position Output: degrees turned so far (signed)
+     * @param rate Output: degrees per second (signed)
+     */
+    static void profileAt(double angle, double elapsedSeconds, double& position, double& rate);
+    
+private:
+    bool active;
+    double startHeading;
+    double target;
+    double angle;            // Signed turn from startHeading to target
+    double traveled;         // Signed turn so far (unwrapped)
+    double lastHeading;
+    uint32_t startMs;
+    uint32_t durationMs;
+    uint32_t settledSinceMs;
+    bool settling;
+};
+
+HeadingSnap::HeadingSnap()
+    : active(false),
+      startHeading(0.0),
+      target(0.0),
+      angle(0.0),
+      traveled(0.0),
+      lastHeading(0.0),
+      startMs(0),
+      durationMs(0),
+      settledSinceMs(0),
+      settling(false) {
+}
+
+void HeadingSnap::start(double currentHeading, double targetHeading, uint32_t nowMs) {
+    // Absolute target: start fresh (don't chain onto a running snap)
+    active = false;
+    startRelative(currentHeading, Odometry::headingDifference(currentHeading, targetHeading), nowMs);
+}
+
+void HeadingSnap::startRelative(double currentHeading, double turn, uint32_t nowMs) {
+    // Chained presses build on the previous target, not on where the robot is mid-turn
+    double base = active ? target : currentHeading;
+    double remaining = active ? (angle - traveled) : 0.0;
+    
+    active = true;
+    startHeading = currentHeading;
+    target = Odometry::wrapHeading(base + turn);
+    angle = remaining + turn;
+    traveled = 0.0;
+    lastHeading = currentHeading;
+    startMs = nowMs;
+    durationMs = profileDurationMs(angle);
+    settling = false;
+}
+
+bool HeadingSnap::update(double heading, uint32_t nowMs, int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!active) {
+        return false;
+    }
+    
+    // Unwrapped progress, so 180 degree turns don't flip direction halfway
+    traveled += Odometry::headingDifference(lastHeading, heading);
+    lastHeading = heading;
+    
+    uint32_t elapsedMs = nowMs - startMs;
+    double position, rate;
+    profileAt(angle, elapsedMs / 1000.0, position, rate);
+    
+    // Finished? Profile done and close enough for a little while
+    double remaining = angle - traveled;
+    if (elapsedMs >= durationMs && std::fabs(remaining) <= SETTLE_TOLERANCE) {
+        if (!settling) {
+            settling = true;
+            settledSinceMs = nowMs;
+        }
+        if (nowMs - settledSinceMs >= SETTLE_TIME_MS) {
+            active = false;
+            return false;
+        }
+    } else {
+        settling = false;
+    }
+    if (elapsedMs >= durationMs + TIMEOUT_MARGIN_MS) {
+        active = false;
+        return false;
+    }
+    
+    // Feedforward from the (upcoming) profile speed + feedback on the profile position
+    double leadPosition, leadRate;
+    profileAt(angle, (elapsedMs + FEEDFORWARD_LEAD_MS) / 1000.0, leadPosition, leadRate);
+    double power = KV * leadRate + KP * (position - traveled);
+    int turnPower = DriveTrain::clamp((int)std::lround(power), -100, 100);
+    
+    // Clockwise: left forward, right backward
+    leftPower = turnPower;
+    rightPower = -turnPower;
+    return true;
+}
+
+void HeadingSnap::cancel() {
+    active = false;
+}
+
+bool HeadingSnap::isActive() const {
+    return active;
+}
+
+double HeadingSnap::getTarget() const {
+    return target;
+}
+
+double HeadingSnap::nearestPreset(double heading) {
+    return Odometry::wrapHeading(std::floor(Odometry::wrapHeading(heading) / 90.0 + 0.5) * 90.0);
+}
+
+uint32_t HeadingSnap::profileDurationMs(double turn) {
+    double distance = std::fabs(turn);
+    double accelTime = MAX_TURN_RATE / TURN_ACCEL;
+    double accelDistance = 0.5 * TURN_ACCEL * accelTime * accelTime;
+    
+    double seconds;
+    if (distance < 2.0 * accelDistance) {
+        // Triangle: never reaches full speed
+        seconds = 2.0 * std::sqrt(distance / TURN_ACCEL);
+    } else {
+        seconds = 2.0 * accelTime + (distance - 2.0 * accelDistance) / MAX_TURN_RATE;
+    }
+    return (uint32_t)std::lround(seconds * 1000.0);
+}
+
+void HeadingSnap::profileAt(double turn, double t, double& position, double& rate) {
+    double distance = std::fabs(turn);
+    double direction = (turn < 0.0) ? -1.0 : 1.0;
+    
+    // Peak speed (lower than MAX_TURN_RATE for short turns)
+    double peakRate = std::fmin(MAX_TURN_RATE, std::sqrt(distance * TURN_ACCEL));
+    double accelTime = peakRate / TURN_ACCEL;
+    double accelDistance = 0.5 * peakRate * accelTime;
+    double cruiseTime = (peakRate > 0.0) ? (distance - 2.0 * accelDistance) / peakRate : 0.0;
+    double total = 2.0 * accelTime + cruiseTime;
+    
+    double p, v;
+    if (t <= 0.0) {
+        p = 0.0;
+        v = 0.0;
+    } else if (t < accelTime) {
+        p = 0.5 * TURN_ACCEL * t * t;
+        v = TURN_ACCEL * t;
+    } else if (t < accelTime + cruiseTime) {
+        p = accelDistance + peakRate * (t - accelTime);
+        v = peakRate;
+    } else if (t < total) {
+        double left = total - t;
+        p = distance - 0.5 * TURN_ACCEL * left * left;
+        v = TURN_ACCEL * left;
+    } else {
+        p = distance;
+        v = 0.0;
+    }
+    position = direction * p;
+    rate = direction * v;
+}
+
+// ----------------------------------------------------------------------------
+// GoalAim Class
+// ----------------------------------------------------------------------------
+/**
+ * GoalAim Class
+ * 
+ * Usage (once per control tick):
+ *   1. addHeading() with the gyro heading (every tick, aiming or not)
+ *   2. addGoalFrame() whenever a new vision frame is read
+ *   3. start(); then update() while it returns true, using its motor powers
+ *   4. isLocked() tells the scoring pipeline it can shoot
+ */
+class GoalAim {
+public:
+    /**
+     * Time from the vision sensor taking a frame to the program reading it (ms)
+     */
+    static const uint32_t DEFAULT_CAMERA_LATENCY_MS = 40;
+    
+    /**
+     * Gyro samples kept to look up the heading at a frame's capture time
+     * (one per control tick: 128 ms even at the fastest 2 ms driver tick)
+     */
+    static const int HEADING_HISTORY = 64;
+    
+    /**
+     * Goal blobs narrower than this (pixels) are noise
+     */
+    static const int MIN_GOAL_WIDTH_PX = 10;
+    
+    /**
+     * Weight of each new frame in the goal's heading
+     */
+    static constexpr double GOAL_SMOOTHING = 0.5;
+    
+    /**
+     * Goal not seen for this long (ms) = lost; the aim stops
+     */
+    static const uint32_t GOAL_TIMEOUT_MS = 300;
+    
+    /**
+     * Turn controller: power per degree of error, power per degree/second of turn
+     * rate (damping), and its limits (percent)
+     */
+    static constexpr double TURN_KP = 3.0;
+    static constexpr double TURN_KD = 0.16;
+    static const int MIN_TURN_POWER = 6;    // Overcomes friction for the last few degrees
+    static const int MAX_TURN_POWER = 80;
+    
+    /**
+     * Errors smaller than this (degrees) don't get MIN_TURN_POWER (the robot stops)
+     */
+    static constexpr double DEADBAND_DEG = 0.5;
+    
+    /**
+     * Locked when within LOCK_TOLERANCE_DEG and turning slower than LOCK_RATE_DPS
+     * for LOCK_TIME_MS; unlocks again past UNLOCK_TOLERANCE_DEG
+     */
+    static constexpr double LOCK_TOLERANCE_DEG = 1.5;
+    static constexpr double UNLOCK_TOLERANCE_DEG = 3.0;
+    static constexpr double LOCK_RATE_DPS = 15.0;
+    static const uint32_t LOCK_TIME_MS = 60;
+    
+    /**
+     * Turn rate is measured over this much gyro history (ms)
+     */
+    static const uint32_t RATE_WINDOW_MS = 30;
+    
+    /**
+     * Constructor
+     * 
+     * @param goalSignature Color signature of the goal
+     * @param cameraLatencyMs Frame age when it is read (0 = frames are current)
+     */
+    GoalAim(int goalSignature, uint32_t cameraLatencyMs = DEFAULT_CAMERA_LATENCY_MS);
+    
+    /**
+     * Forget the goal and the gyro history, and stop aiming
+     */
+    void reset();
+    
+    /**
+     * Record the gyro heading (every control tick)
+     * 
+     * @param heading Gyro heading (degrees)
+     * @param nowMs Time of the reading (must not go backwards)
+     */
+    void addHeading(double heading, uint32_t nowMs);
+    
+    /**
+     * Take the goal's bearing from a vision frame (widest blob of the goal's color)
+     * 
+     * @param detections Blobs in the frame
+     * @param detectionCount Number of blobs
+     * @param readMs Time the frame was read (it was taken cameraLatencyMs earlier)
+     * @return true if the goal was in the frame
+     */
+    bool addGoalFrame(const VisionTracker::Detection* detections, int detectionCount, uint32_t readMs);
+    
+    /**
+     * Goal seen recently enough to aim at
+     */
+    bool hasGoal(uint32_t nowMs) const;
+    
+    /**
+     * Field heading of the goal (degrees; only meaningful while hasGoal())
+     */
+    double getGoalHeading() const;
+    
+    /**
+     * Turn still needed to face the goal from the newest gyro heading
+     * (positive = clockwise)
+     */
+    double getHeadingError() const;
+    
+    /**
+     * Gyro heading at a past time, interpolated from the history
+     * (clamped to the oldest / newest sample)
+     */
+    double headingAt(uint32_t timeMs) const;
+    
+    /**
+     * Turn rate over the last RATE_WINDOW_MS (degrees per second, clockwise positive)
+     */
+    double getTurnRate() const;
+    
+    /**
+     * Start aiming (takes effect if the goal is in view)
+     */
+    void start();
+    
+    /**
+     * One control step (after addHeading() for this tick)
+     * 
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return true while aiming (use the powers), false when idle or the goal was lost
+     */
+    bool update(uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop aiming
+     */
+    void cancel();
+    
+    /**
+     * True while aiming
+     */
+    bool isActive() const;
+    
+    /**
+     * Aiming, on target and settled: safe to shoot
+     */
+    bool isLocked() const;
+    
+private:
+    /**
+     * One gyro sample (heading unwrapped, so interpolation never crosses 0/360)
+     */
+    struct HeadingSample {
+        uint32_t timeMs;
+        double heading;
+    };
+    
+    int goalSignature;
+    uint32_t cameraLatencyMs;
+    
+    HeadingSample history[HEADING_HISTORY];
+    int newest;   // Ring position of the newest sample
+    int count;
+    
+    bool goalSeen;
+    double goalHeading;
+    uint32_t goalSeenMs;
+    
+    bool active;
+    bool locked;
+    bool settling;
+    uint32_t settledSinceMs;
+    
+    /**
+     * History sample by age (0 = newest)
+     */
+    const HeadingSample& sample(int age) const;
+    
+    /**
+     * Unwrapped heading at a time (interpolated, clamped)
+     */
+    double unwrappedAt(uint32_t timeMs) const;
+};
+
+GoalAim::GoalAim(int goalSignature, uint32_t cameraLatencyMs)
+    : goalSignature(goalSignature),
+      cameraLatencyMs(cameraLatencyMs) {
+    reset();
+}
+
+void GoalAim::reset() {
+    newest = 0;
+    count = 0;
+    goalSeen = false;
+    goalHeading = 0.0;
+    goalSeenMs = 0;
+    active = false;
+    locked = false;
+    settling = false;
+    settledSinceMs = 0;
+}
+
+void GoalAim::addHeading(double heading, uint32_t nowMs) {
+    // Unwrap against the previous sample so the history is continuous across 0/360
+    double unwrapped = heading;
+    if (count > 0) {
+        double previous = sample(0).heading;
+        unwrapped = previous + Odometry::headingDifference(Odometry::wrapHeading(previous), heading);
+    }
+    
+    newest = (newest + 1) % HEADING_HISTORY;
+    history[newest].timeMs = nowMs;
+    history[newest].heading = unwrapped;
+    if (count < HEADING_HISTORY) {
+        count++;
+    }
+}
+
+bool GoalAim::addGoalFrame(const VisionTracker::Detection* detections, int detectionCount, uint32_t readMs) {
+    // The goal is the widest blob of its color (other robots' goals are further away)
+    int widest = -1;
+    for (int i = 0; i < detectionCount && i < VisionTracker::MAX_DETECTIONS; i++) {
+        const VisionTracker::Detection& d = detections[i];
+        if (d.signature != goalSignature || d.width < MIN_GOAL_WIDTH_PX) {
+            continue;
+        }
+        if (widest < 0 || d.width > detections[widest].width) {
+            widest = i;
+        }
+    }
+    if (widest < 0) {
+        return false;
+    }
+    
+    // Bearing in the frame + where the robot pointed when the frame was taken
+    double bearing = VisionTracker::bearingFromX(detections[widest].centerX);
+    double measured = Odometry::wrapHeading(headingAt(readMs - cameraLatencyMs) + bearing);
+    
+    if (!hasGoal(readMs)) {
+        goalHeading = measured;
+    } else {
+        goalHeading = Odometry::wrapHeading(goalHeading +
+                                            GOAL_SMOOTHING * Odometry::headingDifference(goalHeading, measured));
+    }
+    goalSeen = true;
+    goalSeenMs = readMs;
+    return true;
+}
+
+bool GoalAim::hasGoal(uint32_t nowMs) const {
+    return goalSeen && nowMs - goalSeenMs <= GOAL_TIMEOUT_MS;
+}
+
+double GoalAim::getGoalHeading() const {
+    return goalHeading;
+}
+
+double GoalAim::getHeadingError() const {
+    double heading = (count > 0) ? Odometry::wrapHeading(sample(0).heading) : 0.0;
+    return Odometry::headingDifference(heading, goalHeading);
+}
+
+double GoalAim::headingAt(uint32_t timeMs) const {
+    return Odometry::wrapHeading(unwrappedAt(timeMs));
+}
+
+double GoalAim::getTurnRate() const {
+    if (count < 2) {
+        return 0.0;
+    }
+    uint32_t newestMs = sample(0).timeMs;
+    uint32_t fromMs = newestMs - RATE_WINDOW_MS;
+    uint32_t oldestMs = sample(count - 1).timeMs;
+    if (newestMs - oldestMs < RATE_WINDOW_MS) {
+        fromMs = oldestMs;  // Not enough history yet
+    }
+    if (fromMs == newestMs) {
+        return 0.0;
+    }
+    return (sample(0).heading - unwrappedAt(fromMs)) * 1000.0 / (double)(newestMs - fromMs);
+}
+
+void GoalAim::start() {
+    active = true;
+    locked = false;
+    settling = false;
+}
+
+bool GoalAim::update(uint32_t nowMs, int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!active) {
+        return false;
+    }
+    if (!hasGoal(nowMs)) {
+        // Nothing to aim at: hand the drive back
+        active = false;
+        locked = false;
+        return false;
+    }
+    
+    double error = getHeadingError();
+    double rate = getTurnRate();
+    
+    // Locked once on target and still for a moment; a bump past the wider band unlocks
+    if (locked) {
+        if (std::fabs(error) > UNLOCK_TOLERANCE_DEG) {
+            locked = false;
+            settling = false;
+        }
+    } else if (std::fabs(error) <= LOCK_TOLERANCE_DEG && std::fabs(rate) <= LOCK_RATE_DPS) {
+        if (!settling) {
+            settling = true;
+            settledSinceMs = nowMs;
+        }
+        if (nowMs - settledSinceMs >= LOCK_TIME_MS) {
+            locked = true;
+        }
+    } else {
+        settling = false;
+    }
+    
+    // PD on the heading error, with the gyro rate as the damping term
+    double power = TURN_KP * error - TURN_KD * rate;
+    if (std::fabs(error) > DEADBAND_DEG && std::fabs(power) < MIN_TURN_POWER) {
+        power = (error > 0.0) ? MIN_TURN_POWER : -MIN_TURN_POWER;
+    }
+    int turnPower = DriveTrain::clamp((int)std::lround(power), -MAX_TURN_POWER, MAX_TURN_POWER);
+    
+    // Turn in place (clockwise: left forward, right backward)
+    DriveTrain::calculateArcadeDrive(0, turnPower, leftPower, rightPower);
+    return true;
+}
+
+void GoalAim::cancel() {
+    active = false;
+    locked = false;
+    settling = false;
+}
+
+bool GoalAim::isActive() const {
+    return active;
+}
+
+bool GoalAim::isLocked() const {
+    return active && locked;
+}
+
+const GoalAim::HeadingSample& GoalAim::sample(int age) const {
+    return history[(newest - age + HEADING_HISTORY) % HEADING_HISTORY];
+}
+
+double GoalAim::unwrappedAt(uint32_t timeMs) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    if ((int32_t)(timeMs - sample(0).timeMs) >= 0) {
+        return sample(0).heading;
+    }
+    
+    // Newest sample at or before the time, interpolated toward the one after it
+    for (int age = 1; age < count; age++) {
+        const HeadingSample& before = sample(age);
+        if ((int32_t)(timeMs - before.timeMs) >= 0) {
+            const HeadingSample& after = sample(age - 1);
+            uint32_t span = after.timeMs - before.timeMs;
+            if (span == 0) {
+                return after.heading;
+            }
+            double fraction = (double)(timeMs - before.timeMs) / (double)span;
+            return before.heading + (after.heading - before.heading) * fraction;
+        }
+    }
+    return sample(count - 1).heading;  // Older than the history: oldest sample
+}
+
+// ----------------------------------------------------------------------------
+// WallSquare Class
+// ----------------------------------------------------------------------------
+/**
+ * WallSquare Class
+ * 
+ * Usage (once per control tick):
+ *   1. start() with the direction to drive (forward or backward into the wall)
+ *   2. update() with each side's current and speed; apply the returned powers
+ *   3. When it returns SQUARED, getAlignedHeading() is the wall's heading
+ */
+class WallSquare {
+public:
+    /**
+     * Where the routine is
+     */
+    enum Status {
+        IDLE,       // Not running
+        APPROACH,   // Driving toward the wall
+        SQUARED,    // Both sides touched (finished)
+        FAILED      // Timed out without both sides touching
+    };
+    
+    /**
+     * One drive side
+     */
+    enum Side {
+        LEFT = 0,
+        RIGHT = 1,
+        SIDE_COUNT = 2
+    };
+    
+    /**
+     * Drive power on the way to the wall (percent)
+     */
+    static const int APPROACH_POWER = 30;
+    
+    /**
+     * Power that keeps a touching side pressed against the wall (percent)
+     */
+    static const int HOLD_POWER = 12;
+    
+    /**
+     * Contact readings are ignored while the drive spins up (ms)
+     */
+    static const uint32_t SPINUP_MS = 300;
+    
+    /**
+     * Current rise over the free-running current that counts as contact (amps)
+     */
+    static constexpr double CONTACT_CURRENT_RISE = 0.5;
+    
+    /**
+     * Current low-pass filter weight for the newest reading (0-1, lower = smoother)
+     */
+    static constexpr double CURRENT_FILTER = 0.5;
+    
+    /**
+     * Speed below this fraction of the free-running speed counts as contact
+     */
+    static constexpr double CONTACT_SPEED_FRACTION = 0.4;
+    
+    /**
+     * Both signs must hold this long to count (filters bumps and noise) (ms)
+     */
+    static const uint32_t CONTACT_CONFIRM_MS = 60;
+    
+    /**
+     * Give up after this long (ms)
+     */
+    static const uint32_t TIMEOUT_MS = 3000;
+    
+    /**
+     * Create an idle routine
+     */
+    WallSquare();
+    
+    /**
+     * Start driving into the wall
+     * 
+     * @param direction 1 = forward into the wall, -1 = backward
+     * @param nowMs Current time
+     */
+    void start(int direction, uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param leftCurrent Average motor current of the left side (amps)
+     * @param leftRpm Average motor speed of the left side (rpm, any sign)
+     * @param rightCurrent Average motor current of the right side (amps)
+     * @param rightRpm Average motor speed of the right side (rpm, any sign)
+     * @param heading Gyro heading now (degrees)
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (-100 to 100)
+     * @param rightPower Output: right drive power (-100 to 100)
+     * @return Status after this step
+     */
+    Status update(double leftCurrent, double leftRpm, double rightCurrent, double rightRpm,
+                  double heading, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    /**
+     * Stop the routine (e.g. the driver moved a stick)
+     */
+    void cancel();
+    
+    /**
+     * Current status
+     */
+    Status getStatus() const;
+    
+    /**
+     * True while driving to the wall
+     */
+    bool isActive() const;
+    
+    /**
+     * True once a side has touched the wall
+     */
+    bool hasContact(Side side) const;
+    
+    /**
+     * Side that touched first (only valid once a side has contact)
+     */
+    Side getFirstContact() const;
+    
+    /**
+     * Gyro heading when both sides touched (degrees)
+     */
+    double getMeasuredHeading() const;
+    
+    /**
+     * Wall heading: the measured heading snapped to the nearest 90 degrees
+     * (walls are square to the field). Use it to correct the gyro.
+     */
+    double getAlignedHeading() const;
+    
+private:
+    Status status;
+    int direction;
+    uint32_t startMs;
+    double current[SIDE_COUNT];       // Filtered current
+    double freeCurrent[SIDE_COUNT];   // Average current before contact
+    double freeRpm[SIDE_COUNT];       // Fastest speed before contact
+    int freeSamples[SIDE_COUNT];
+    bool contact[SIDE_COUNT];
+    bool pending[SIDE_COUNT];         // Contact signs seen, not yet confirmed
+    uint32_t pendingSinceMs[SIDE_COUNT];
+    Side firstContact;
+    double measuredHeading;
+    
+    void updateSide(int side, double rawCurrent, double rpm, uint32_t nowMs);
+};
+
+WallSquare::WallSquare()
+    : status(IDLE),
+      direction(1),
+      startMs(0),
+      firstContact(LEFT),
+      measuredHeading(0.0) {
+    for (int side = 0; side < SIDE_COUNT; side++) {
+        current[side] = 0.0;
+        freeCurrent[side] = 0.0;
+        freeRpm[side] = 0.0;
+        freeSamples[side] = 0;
+        contact[side] = false;
+        pending[side] = false;
+        pendingSinceMs[side] = 0;
+    }
+}
+
+void WallSquare::start(int direction, uint32_t nowMs) {
+    *this = WallSquare();
+    this->direction = (direction < 0) ? -1 : 1;
+    startMs = nowMs;
+    status = APPROACH;
+}
+
+void WallSquare::updateSide(int side, double rawCurrent, double rpm, uint32_t nowMs) {
+    double speed = std::fabs(rpm);
+    current[side] += (rawCurrent - current[side]) * CURRENT_FILTER;
+    
+    if (nowMs - startMs < SPINUP_MS) {
+        // Spin-up: current is high and speed is low anyway, nothing to learn yet
+        return;
+    }
+    
+    bool currentRise = freeSamples[side] > 0 && current[side] > freeCurrent[side] + CONTACT_CURRENT_RISE;
+    bool speedDrop = speed < freeRpm[side] * CONTACT_SPEED_FRACTION;
+    
+    if (currentRise && speedDrop) {
+        if (!pending[side]) {
+            pending[side] = true;
+            pendingSinceMs[side] = nowMs;
+        }
+        if (nowMs - pendingSinceMs[side] >= CONTACT_CONFIRM_MS) {
+            contact[side] = true;
+        }
+        return;
+    }
+    pending[side] = false;
+    
+    // Free running: learn the normal current (average) and speed (peak)
+    freeSamples[side]++;
+    freeCurrent[side] += (current[side] - freeCurrent[side]) / freeSamples[side];
+    if (speed > freeRpm[side]) {
+        freeRpm[side] = speed;
+    }
+}
+
+WallSquare::Status WallSquare::update(double leftCurrent, double leftRpm,
+                                      double rightCurrent, double rightRpm,
+                                      double heading, uint32_t nowMs,
+                                      int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (status != APPROACH) {
+        return status;
+    }
+    
+    if (nowMs - startMs >= TIMEOUT_MS) {
+        status = FAILED;
+        return status;
+    }
+    
+    bool hadContact = contact[LEFT] || contact[RIGHT];
+    if (!contact[LEFT]) {
+        updateSide(LEFT, leftCurrent, leftRpm, nowMs);
+    }
+    if (!contact[RIGHT]) {
+        updateSide(RIGHT, rightCurrent, rightRpm, nowMs);
+    }
+    if (!hadContact && (contact[LEFT] || contact[RIGHT])) {
+        firstContact = contact[LEFT] ? LEFT : RIGHT;
+    }
+    
+    if (contact[LEFT] && contact[RIGHT]) {
+        measuredHeading = heading;
+        status = SQUARED;
+        return status;
+    }
+    
+    // A side touching the wall only pushes gently; the other keeps driving
+    leftPower = direction * (contact[LEFT] ? HOLD_POWER : APPROACH_POWER);
+    rightPower = direction * (contact[RIGHT] ? HOLD_POWER : APPROACH_POWER);
+    return status;
+}
+
+void WallSquare::cancel() {
+    if (status == APPROACH) {
+        status = IDLE;
+    }
+}
+
+WallSquare::Status WallSquare::getStatus() const {
+    return status;
+}
+
+bool WallSquare::isActive() const {
+    return status == APPROACH;
+}
+
+bool WallSquare::hasContact(Side side) const {
+    return contact[side];
+}
+
+WallSquare::Side WallSquare::getFirstContact() const {
+    return firstContact;
+}
+
+double WallSquare::getMeasuredHeading() const {
+    return measuredHeading;
+}
+
+double WallSquare::getAlignedHeading() const {
+    return HeadingSnap::nearestPreset(measuredHeading);
+}
+
+// ----------------------------------------------------------------------------
+// GridPlanner Class
+// ----------------------------------------------------------------------------
+/**
+ * GridPlanner Class
+ * 
+ * Usage:
+ *   1. addObstacle() for whatever blocks the field (clearObstacles() to forget them),
+ *      addSeenObstacle() for things found in the way that may move (clearSeenObstacles())
+ *   2. start() with where the robot is and where it is going
+ *   3. step() once per control tick until it returns FOUND or NO_PATH
+ *   4. getWaypointCount() / getWaypoint(): the path, shortened to its corners
+ */
+class GridPlanner {
+public:
+    /**
+     * Where the search is
+     */
+    enum Status {
+        IDLE,        // Not started
+        SEARCHING,   // Started, step() again
+        FOUND,       // Path ready (finished)
+        NO_PATH      // Nothing gets there (finished)
+    };
+    
+    /**
+     * Field size: 144" square, origin at the center (inches)
+     */
+    static constexpr double FIELD_HALF_SIZE = 72.0;
+    
+    /**
+     * Grid cell size (inches) and cells per side
+     */
+    static constexpr double CELL_SIZE = 6.0;
+    static const int GRID_SIZE = 24;
+    static const int CELL_COUNT = GRID_SIZE * GRID_SIZE;
+    
+    /**
+     * Robot radius obstacles and walls are grown by (inches)
+     */
+    static constexpr double ROBOT_RADIUS = 9.0;
+    
+    /**
+     * Most waypoints a path is shortened to
+     */
+    static const int MAX_WAYPOINTS = 16;
+    
+    /**
+     * One point on the field (inches)
+     */
+    struct Point {
+        double x;
+        double y;
+    };
+    
+    /**
+     * Constructor: empty field
+     */
+    GridPlanner();
+    
+    /**
+     * Forget every obstacle (the walls stay)
+     */
+    void clearObstacles();
+    
+    /**
+     * Forget only the obstacles added with addSeenObstacle()
+     */
+    void clearSeenObstacles();
+    
+    /**
+     * Mark a round obstacle (grown by ROBOT_RADIUS)
+     * 
+     * @param center Obstacle center (inches)
+     * @param radius Obstacle radius (inches)
+     */
+    void addObstacle(Point center, double radius);
+    
+    /**
+     * Mark something found in the way that may move (a robot): blocks like addObstacle()
+     * until clearSeenObstacles()
+     */
+    void addSeenObstacle(Point center, double radius);
+    
+    /**
+     * True if the robot's center can't be at this point
+     */
+    bool isBlocked(Point point) const;
+    
+    /**
+     * Start a search (any search in progress is dropped)
+     * 
+     * The robot's own cell is always allowed, so it can plan its way out of a cell
+     * an obstacle was just grown over. So is the goal's cell if only the walls block it
+     * (routes often end close to a wall); a goal inside an obstacle gives NO_PATH.
+     * 
+     * @param from Robot position
+     * @param to Goal
+     */
+    void start(Point from, Point to);
+    
+    /**
+     * Continue the search
+     * 
+     * @param maxExpansions Most cells to expand in this call (the compute budget)
+     * @return Status after the call
+     */
+    Status step(int maxExpansions);
+    
+    Status getStatus() const;
+    
+    /**
+     * Cells expanded since start()
+     */
+    int getExpansions() const;
+    
+    /**
+     * Path waypoints once FOUND (the robot's position not included; the last one is
+     * the goal)
+     */
+    int getWaypointCount() const;
+    Point getWaypoint(int index) const;
+    
+private:
+    /**
+     * What blocks a cell (bit flags)
+     */
+    enum Blocker {
+        WALL = 1,
+        OBSTACLE = 2,
+        SEEN = 4
+    };
+    
+    /**
+     * Mark every cell an obstacle reaches
+     */
+    void markCircle(Point center, double radius, uint8_t blocker);
+    
+    uint8_t blocked[CELL_COUNT];
+    
+    // Search state (kept between step() calls)
+    Status status;
+    int startCell;
+    int goalCell;
+    Point origin;
+    Point goal;
+    float cost[CELL_COUNT];       // Best cost from the start so far (cells)
+    int16_t parent[CELL_COUNT];
+    bool closed[CELL_COUNT];
+    int16_t heap[CELL_COUNT];     // Open cells, binary heap on cost + estimate
+    int16_t heapIndex[CELL_COUNT];  // Position in the heap, -1 = not in it
+    int heapSize;
+    int expansions;
+    
+    Point waypoints[MAX_WAYPOINTS];
+    int waypointCount;
+    
+    int cellOf(Point point) const;
+    Point centerOf(int cell) const;
+    bool passable(int cell) const;
+    
+    /**
+     * Cost estimate to the goal (octile distance, in cells)
+     */
+    float estimate(int cell) const;
+    
+    /**
+     * Open list: cheapest cost + estimate first
+     */
+    bool before(int a, int b) const;
+    void heapMoveUp(int position);
+    int heapPop();
+    
+    /**
+     * Follow the parents back from the goal, keeping only the corners
+     */
+    void buildWaypoints();
+    
+    /**
+     * Straight line between two points crosses only passable cells
+     */
+    bool lineClear(Point from, Point to) const;
+};
+
+namespace {
+const float DIAGONAL_COST = 1.41421356f;
+}
+
+GridPlanner::GridPlanner() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] = 0;
+        Point center = centerOf(cell);
+        if (std::fabs(center.x) > FIELD_HALF_SIZE - ROBOT_RADIUS ||
+            std::fabs(center.y) > FIELD_HALF_SIZE - ROBOT_RADIUS) {
+            blocked[cell] = WALL;
+        }
+    }
+    status = IDLE;
+    startCell = 0;
+    goalCell = 0;
+    origin.x = 0.0;
+    origin.y = 0.0;
+    goal = origin;
+    heapSize = 0;
+    expansions = 0;
+    waypointCount = 0;
+}
+
+void GridPlanner::clearObstacles() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] &= ~(OBSTACLE | SEEN);
+    }
+}
+
+void GridPlanner::clearSeenObstacles() {
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        blocked[cell] &= ~SEEN;
+    }
+}
+
+void GridPlanner::addObstacle(Point center, double radius) {
+    markCircle(center, radius, OBSTACLE);
+}
+
+void GridPlanner::addSeenObstacle(Point center, double radius) {
+    markCircle(center, radius, SEEN);
+}
+
+void GridPlanner::markCircle(Point center, double radius, uint8_t blocker) {
+    double reach = radius + ROBOT_RADIUS;
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        Point c = centerOf(cell);
+        double dx = c.x - center.x;
+        double dy = c.y - center.y;
+        if (dx * dx + dy * dy <= reach * reach) {
+            blocked[cell] |= blocker;
+        }
+    }
+}
+
+bool GridPlanner::isBlocked(Point point) const {
+    return blocked[cellOf(point)] != 0;
+}
+
+void GridPlanner::start(Point from, Point to) {
+    origin = from;
+    goal = to;
+    startCell = cellOf(from);
+    goalCell = cellOf(to);
+    expansions = 0;
+    waypointCount = 0;
+    
+    for (int cell = 0; cell < CELL_COUNT; cell++) {
+        cost[cell] = INFINITY;
+        parent[cell] = -1;
+        closed[cell] = false;
+        heapIndex[cell] = -1;
+    }
+    heapSize = 0;
+    
+    if ((blocked[goalCell] & (OBSTACLE | SEEN)) != 0) {
+        status = NO_PATH;
+        return;
+    }
+    cost[startCell] = 0.0f;
+    heap[0] = (int16_t)startCell;
+    heapIndex[startCell] = 0;
+    heapSize = 1;
+    status = SEARCHING;
+}
+
+GridPlanner::Status GridPlanner::step(int maxExpansions) {
+    if (status != SEARCHING) {
+        return status;
+    }
+    
+    for (int n = 0; n < maxExpansions; n++) {
+        if (heapSize == 0) {
+            status = NO_PATH;
+            return status;
+        }
+        int cell = heapPop();
+        if (cell == goalCell) {
+            buildWaypoints();
+            status = FOUND;
+            return status;
+        }
+        closed[cell] = true;
+        expansions++;
+        
+        int row = cell / GRID_SIZE;
+        int col = cell % GRID_SIZE;
+        for (int dRow = -1; dRow <= 1; dRow++) {
+            for (int dCol = -1; dCol <= 1; dCol++) {
+                int r = row + dRow;
+                int c = col + dCol;
+                if ((dRow == 0 && dCol == 0) || r < 0 || r >= GRID_SIZE || c < 0 || c >= GRID_SIZE) {
+                    continue;
+                }
+                int next = r * GRID_SIZE + c;
+                if (closed[next] || !passable(next)) {
+                    continue;
+                }
+                bool diagonal = dRow != 0 && dCol != 0;
+                if (diagonal && (!passable(row * GRID_SIZE + c) || !passable(r * GRID_SIZE + col))) {
+                    continue;  // Don't cut a blocked corner
+                }
+                float newCost = cost[cell] + (diagonal ? DIAGONAL_COST : 1.0f);
+                if (newCost >= cost[next]) {
+                    continue;
+                }
+                cost[next] = newCost;
+                parent[next] = (int16_t)cell;
+                if (heapIndex[next] < 0) {
+                    heap[heapSize] = (int16_t)next;
+                    heapIndex[next] = (int16_t)heapSize;
+                    heapSize++;
+                }
+                heapMoveUp(heapIndex[next]);
+            }
+        }
+    }
+    return status;
+}
+
+GridPlanner::Status GridPlanner::getStatus() const {
+    return status;
+}
+
+int GridPlanner::getExpansions() const {
+    return expansions;
+}
+
+int GridPlanner::getWaypointCount() const {
+    return waypointCount;
+}
+
+GridPlanner::Point GridPlanner::getWaypoint(int index) const {
+    return waypoints[index];
+}
+
+int GridPlanner::cellOf(Point point) const {
+    int col = (int)std::floor((point.x + FIELD_HALF_SIZE) / CELL_SIZE);
+    int row = (int)std::floor((point.y + FIELD_HALF_SIZE) / CELL_SIZE);
+    col = (col < 0) ? 0 : (col >= GRID_SIZE) ? GRID_SIZE - 1 : col;
+    row = (row < 0) ? 0 : (row >= GRID_SIZE) ? GRID_SIZE - 1 : row;
+    return row * GRID_SIZE + col;
+}
+
+GridPlanner::Point GridPlanner::centerOf(int cell) const {
+    Point center;
+    center.x = -FIELD_HALF_SIZE + ((cell % GRID_SIZE) + 0.5) * CELL_SIZE;
+    center.y = -FIELD_HALF_SIZE + ((cell / GRID_SIZE) + 0.5) * CELL_SIZE;
+    return center;
+}
+
+bool GridPlanner::passable(int cell) const {
+    if (cell == startCell) {
+        return true;
+    }
+    if (cell == goalCell) {
+        return (blocked[cell] & (OBSTACLE | SEEN)) == 0;
+    }
+    return blocked[cell] == 0;
+}
+
+float GridPlanner::estimate(int cell) const {
+    int dRow = std::abs(cell / GRID_SIZE - goalCell / GRID_SIZE);
+    int dCol = std::abs(cell % GRID_SIZE - goalCell % GRID_SIZE);
+    int straight = (dRow > dCol) ? dRow - dCol : dCol - dRow;
+    int diagonal = (dRow > dCol) ? dCol : dRow;
+    return straight + DIAGONAL_COST * diagonal;
+}
+
+bool GridPlanner::before(int a, int b) const {
+    float fa = cost[a] + estimate(a);
+    float fb = cost[b] + estimate(b);
+    if (fa != fb) {
+        return fa < fb;
+    }
+    return cost[a] > cost[b];  // Tie: the one further along (closer to the goal)
+}
+
+void GridPlanner::heapMoveUp(int position) {
+    int cell = heap[position];
+    while (position > 0) {
+        int parentPosition = (position - 1) / 2;
+        int above = heap[parentPosition];
+        if (!before(cell, above)) {
+            break;
+        }
+        heap[position] = (int16_t)above;
+        heapIndex[above] = (int16_t)position;
+        position = parentPosition;
+    }
+    heap[position] = (int16_t)cell;
+    heapIndex[cell] = (int16_t)position;
+}
+
+int GridPlanner::heapPop() {
+    int top = heap[0];
+    heapIndex[top] = -1;
+    heapSize--;
+    if (heapSize == 0) {
+        return top;
+    }
+    
+    // Last cell to the root, then down to where it belongs
+    int cell = heap[heapSize];
+    int position = 0;
+    while (true) {
+        int child = 2 * position + 1;
+        if (child >= heapSize) {
+            break;
+        }
+        if (child + 1 < heapSize && before(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!before(heap[child], cell)) {
+            break;
+        }
+        heap[position] = heap[child];
+        heapIndex[heap[child]] = (int16_t)position;
+        position = child;
+    }
+    heap[position] = (int16_t)cell;
+    heapIndex[cell] = (int16_t)position;
+    return top;
+}
+
+void GridPlanner::buildWaypoints() {
+    // Cells from the goal back to the start
+    int16_t path[CELL_COUNT];
+    int length = 0;
+    for (int cell = goalCell; cell != startCell && cell >= 0; cell = parent[cell]) {
+        path[length++] = (int16_t)cell;
+    }
+    
+    // From where the robot is, go straight to the furthest cell it can see; repeat
+    waypointCount = 0;
+    Point from = origin;
+    int index = length - 1;  // Next cell along the path
+    while (index > 0 && waypointCount < MAX_WAYPOINTS - 1) {
+        int furthest = index;
+        for (int i = 0; i < index; i++) {
+            if (lineClear(from, (i == 0) ? goal : centerOf(path[i]))) {
+                furthest = i;
+                break;
+            }
+        }
+        if (furthest == 0) {
+            break;
+        }
+        from = centerOf(path[furthest]);
+        waypoints[waypointCount++] = from;
+        index = furthest - 1;
+    }
+    waypoints[waypointCount++] = goal;
+}
+
+bool GridPlanner::lineClear(Point from, Point to) const {
+    double dx = to.x - from.x;
+    double dy = to.y - from.y;
+    int samples = (int)std::ceil(std::sqrt(dx * dx + dy * dy) / (CELL_SIZE / 4.0)) + 1;
+    for (int i = 0; i <= samples; i++) {
+        Point p;
+        p.x = from.x + dx * i / samples;
+        p.y = from.y + dy * i / samples;
+        if (!passable(cellOf(p))) {
+            return false;
+        }
+    }
+    return true;
+}
+// ----------------------------------------------------------------------------
+// RouteFollower Class
+// ----------------------------------------------------------------------------
+/**
+ * RouteFollower Class
+ * 
+ * Usage (once per control tick):
+ *   1. clear(), addWaypoint() for each point of the route, start()
+ *   2. notifyCollision() when TipDetector reports a COLLISION
+ *   3. update() with the pose; apply the returned drive powers
+ *   4. Stop when it returns DONE or FAILED
+ */
+class RouteFollower {
+public:
+    /**
+     * Where the route is
+     */
+    enum Status {
+        IDLE,          // Not running
+        DRIVING,       // Driving to the next waypoint
+        BACKING_OFF,   // Blocked: backing away before replanning
+        REPLANNING,    // Searching for a detour (a few ticks, robot stopped)
+        DONE,          // Last waypoint reached (finished)
+        FAILED         // Time limit, too many blocks, or no way through (finished)
+    };
+    
+    /**
+     * Most waypoints in the route, detours included
+     */
+    static const int MAX_WAYPOINTS = 24;
+    
+    /**
+     * Driving: forward power, turn power per degree of bearing and its limit (percent)
+     */
+    static const int DRIVE_POWER = 60;
+    static constexpr double TURN_KP = 1.5;
+    static const int MAX_TURN_POWER = 50;
+    
+    /**
+     * Forward power drops to 0 at this bearing (turn first, then drive)
+     */
+    static constexpr double FULL_TURN_BEARING_DEG = 45.0;
+    
+    /**
+     * Slowing down for the last waypoint: full power this far out (inches), never
+     * slower than MIN_DRIVE_POWER
+     */
+    static constexpr double SLOW_DISTANCE = 12.0;
+    static const int MIN_DRIVE_POWER = 15;
+    
+    /**
+     * A waypoint is reached this close (inches): the last one exactly, the others as
+     * the robot passes
+     */
+    static constexpr double ARRIVE_DISTANCE = 2.0;
+    static constexpr double PASS_DISTANCE = 6.0;
+    
+    /**
+     * Blocked: less than MIN_PROGRESS inches in STALL_MS while driving with at least
+     * MIN_STALL_POWER forward; COLLISION_STALL_MS right after a collision
+     */
+    static constexpr double MIN_PROGRESS = 1.0;
+    static const uint32_t STALL_MS = 400;
+    static const uint32_t COLLISION_STALL_MS = 150;
+    static const int MIN_STALL_POWER = 20;
+    
+    /**
+     * What blocked the robot is marked as a circle this big (inches; about a robot)
+     * just ahead of the robot
+     */
+    static constexpr double OBSTACLE_RADIUS = 9.0;
+    
+    /**
+     * Backing off before replanning: distance (inches), power (percent), time limit (ms)
+     */
+    static constexpr double BACKOFF_DISTANCE = 6.0;
+    static const int BACKOFF_POWER = 30;
+    static const uint32_t BACKOFF_MS = 600;
+    
+    /**
+     * Planner budget: grid cells expanded per control tick
+     */
+    static const int EXPANSIONS_PER_TICK = 60;
+    
+    /**
+     * Blocks before the route is given up
+     */
+    static const int MAX_REPLANS = 4;
+    
+    RouteFollower();
+    
+    /**
+     * Empty the route
+     */
+    void clear();
+    
+    /**
+     * Add a waypoint at the end of the route
+     * 
+     * @return false if the route is full
+     */
+    bool addWaypoint(GridPlanner::Point point);
+    
+    /**
+     * Start driving the route (forgets what blocked earlier routes)
+     * 
+     * @param nowMs Current time
+     * @param timeoutMs Give up after this long
+     */
+    void start(uint32_t nowMs, uint32_t timeoutMs);
+    
+    /**
+     * Stop without finishing (outputs go to 0)
+     */
+    void cancel();
+    
+    /**
+     * The robot hit something (the blocked check then needs only COLLISION_STALL_MS)
+     */
+    void notifyCollision(uint32_t nowMs);
+    
+    /**
+     * One control step
+     * 
+     * @param pose Robot pose
+     * @param nowMs Current time
+     * @param leftPower Output: left drive power (percent)
+     * @param rightPower Output: right drive power (percent)
+     * @return Status after the step
+     */
+    Status update(const Odometry::Pose& pose, uint32_t nowMs, int& leftPower, int& rightPower);
+    
+    Status getStatus() const;
+    bool isRunning() const;
+    
+    /**
+     * Times the route was blocked and replanned
+     */
+    int getReplanCount() const;
+    
+    /**
+     * Waypoints left, the one being driven to first
+     */
+    int getRemainingCount() const;
+    GridPlanner::Point getWaypoint(int index) const;
+    
+    /**
+     * Point a distance straight ahead of a pose (negative = behind)
+     */
+    static GridPlanner::Point pointAhead(const Odometry::Pose& pose, double distance);
+    
+    /**
+     * The grid: add known obstacles (goals, field elements) before start()
+     */
+    GridPlanner& getPlanner();
+    
+    /**
+     * Most grid cells the planner expanded in one tick since start()
+     */
+    int getMaxTickExpansions() const;
+    
+private:
+    GridPlanner planner;
+    
+    GridPlanner::Point route[MAX_WAYPOINTS];
+    int count;
+    int next;   // Waypoint being driven to
+    
+    Status status;
+    uint32_t startMs;
+    uint32_t timeoutMs;
+    int replans;
+    int maxTickExpansions;
+    
+    // Blocked check: where the robot was when it last made progress
+    bool progressSet;
+    GridPlanner::Point progressPoint;
+    uint32_t progressMs;
+    bool collided;
+    uint32_t collisionMs;
+    
+    // Backing off
+    GridPlanner::Point blockedPoint;
+    uint32_t backoffStartMs;
+    
+    void finish(Status result, int& leftPower, int& rightPower);
+    Status drive(const Odometry::Pose& pose, uint32_t nowMs, int& leftPower, int& rightPower);
+    void blocked(const Odometry::Pose& pose, uint32_t nowMs);
+    
+    /**
+     * Start a search from the robot to the waypoint being driven to
+     */
+    void startReplan(const Odometry::Pose& pose);
+    
+    /**
+     * Put the planner's detour in front of the waypoint being driven to
+     * 
+     * @return false if the route has no room for it
+     */
+    bool insertDetour();
+};
+
+namespace {
+double distanceBetween(GridPlanner::Point a, GridPlanner::Point b) {
+    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+}
+
+GridPlanner::Point positionOf(const Odometry::Pose& pose) {
+    GridPlanner::Point point;
+    point.x = pose.x;
+    point.y = pose.y;
+    return point;
+}
+}
+
+RouteFollower::RouteFollower() {
+    clear();
+}
+
+void RouteFollower::clear() {
+    count = 0;
+    next = 0;
+    status = IDLE;
+    startMs = 0;
+    timeoutMs = 0;
+    replans = 0;
+    maxTickExpansions = 0;
+    progressSet = false;
+    progressMs = 0;
+    collided = false;
+    collisionMs = 0;
+    backoffStartMs = 0;
+}
+
+bool RouteFollower::addWaypoint(GridPlanner::Point point) {
+    if (count >= MAX_WAYPOINTS) {
+        return false;
+    }
+    route[count++] = point;
+    return true;
+}
+
+void RouteFollower::start(uint32_t nowMs, uint32_t timeoutMs) {
+    this->startMs = nowMs;
+    this->timeoutMs = timeoutMs;
+    next = 0;
+    replans = 0;
+    maxTickExpansions = 0;
+    progressSet = false;
+    collided = false;
+    
+    // What blocked an earlier route has probably moved since (known obstacles stay)
+    planner.clearSeenObstacles();
+    status = (count > 0) ? DRIVING : DONE;
+}
+
+void RouteFollower::cancel() {
+    status = IDLE;
+}
+
+void RouteFollower::notifyCollision(uint32_t nowMs) {
+    collided = true;
+    collisionMs = nowMs;
+}
+
+RouteFollower::Status RouteFollower::update(const Odometry::Pose& pose, uint32_t nowMs,
+                                            int& leftPower, int& rightPower) {
+    leftPower = 0;
+    rightPower = 0;
+    if (!isRunning()) {
+        return status;
+    }
+    if (nowMs - startMs >= timeoutMs) {
+        finish(FAILED, leftPower, rightPower);
+        return status;
+    }
+    
+    if (status == DRIVING) {
+        return drive(pose, nowMs, leftPower, rightPower);
+    }
+    
+    if (status == BACKING_OFF) {
+        bool farEnough = distanceBetween(positionOf(pose), blockedPoint) >= BACKOFF_DISTANCE;
+        if (farEnough || nowMs - backoffStartMs >= BACKOFF_MS) {
+            startReplan(pose);  // Searching starts next tick
+            return status;
+        }
+        leftPower = -BACKOFF_POWER;
+        rightPower = -BACKOFF_POWER;
+        return status;
+    }
+    
+    // REPLANNING: one budget's worth of search per tick, robot stopped
+    int before = planner.getExpansions();
+    GridPlanner::Status search = planner.step(EXPANSIONS_PER_TICK);
+    int used = planner.getExpansions() - before;
+    if (used > maxTickExpansions) {
+        maxTickExpansions = used;
+    }
+    if (search == GridPlanner::FOUND) {
+        if (!insertDetour()) {
+            finish(FAILED, leftPower, rightPower);
+            return status;
+        }
+        status = DRIVING;
+        progressSet = false;
+    } else if (search == GridPlanner::NO_PATH) {
+        // The waypoint itself is blocked (or walled in): try the next one
+        if (next + 1 >= count) {
+            finish(FAILED, leftPower, rightPower);
+            return status;
+        }
+        next++;
+        startReplan(pose);
+    }
+    return status;
+}
+
+RouteFollower::Status RouteFollower::getStatus() const {
+    return status;
+}
+
+bool RouteFollower::isRunning() const {
+    return status == DRIVING || status == BACKING_OFF || status == REPLANNING;
+}
+
+int RouteFollower::getReplanCount() const {
+    return replans;
+}
+
+int RouteFollower::getRemainingCount() const {
+    return count - next;
+}
+
+GridPlanner::Point RouteFollower::getWaypoint(int index) const {
+    return route[next + index];
+}
+
+GridPlanner::Point RouteFollower::pointAhead(const Odometry::Pose& pose, double distance) {
+    GridPlanner::Point point;
+    point.x = pose.x + distance * std::sin(pose.heading * Odometry::DEGREES_TO_RADIANS);
+    point.y = pose.y + distance * std::cos(pose.heading * Odometry::DEGREES_TO_RADIANS);
+    return point;
+}
+
+GridPlanner& RouteFollower::getPlanner() {
+    return planner;
+}
+
+int RouteFollower::getMaxTickExpansions() const {
+    return maxTickExpansions;
+}
+
+void RouteFollower::finish(Status result, int& leftPower, int& rightPower) {
+    status = result;
+    leftPower = 0;
+    rightPower = 0;
+}
+
+RouteFollower::Status RouteFollower::drive(const Odometry::Pose& pose, uint32_t nowMs,
+                                           int& leftPower, int& rightPower) {
+    GridPlanner::Point here = positionOf(pose);
+    
+    // Pass (or reach) waypoints
+    bool last = next == count - 1;
+    while (distanceBetween(here, route[next]) < (last ? ARRIVE_DISTANCE : PASS_DISTANCE)) {
+        next++;
+        if (next >= count) {
+            finish(DONE, leftPower, rightPower);
+            return status;
+        }
+        last = next == count - 1;
+    }
+    
+    // Steer toward the waypoint (turn first when it is far off to the side)
+    GridPlanner::Point target = route[next];
+    double distance = distanceBetween(here, target);
+    double targetHeading = std::atan2(target.x - here.x, target.y - here.y) / Odometry::DEGREES_TO_RADIANS;
+    double bearing = Odometry::headingDifference(pose.heading, targetHeading);
+    int turn = DriveTrain::clamp((int)std::lround(TURN_KP * bearing), -MAX_TURN_POWER, MAX_TURN_POWER);
+    double forward = DRIVE_POWER * std::fmax(0.0, 1.0 - std::fabs(bearing) / FULL_TURN_BEARING_DEG);
+    if (last) {
+        forward *= std::fmax((double)MIN_DRIVE_POWER / DRIVE_POWER, std::fmin(1.0, distance / SLOW_DISTANCE));
+    }
+    int forwardPower = (int)std::lround(forward);
+    DriveTrain::calculateArcadeDrive(forwardPower, turn, leftPower, rightPower);
+    
+    // Blocked: pushing forward without getting anywhere
+    if (!progressSet || forwardPower < MIN_STALL_POWER ||
+        distanceBetween(here, progressPoint) >= MIN_PROGRESS) {
+        progressSet = true;
+        progressPoint = here;
+        progressMs = nowMs;
+        return status;
+    }
+    bool recentCollision = collided && nowMs - collisionMs <= STALL_MS;
+    if (nowMs - progressMs >= (recentCollision ? COLLISION_STALL_MS : STALL_MS)) {
+        blocked(pose, nowMs);
+        leftPower = 0;
+        rightPower = 0;
+    }
+    return status;
+}
+
+void RouteFollower::blocked(const Odometry::Pose& pose, uint32_t nowMs) {
+    replans++;
+    collided = false;
+    if (replans > MAX_REPLANS) {
+        status = FAILED;
+        return;
+    }
+    
+    // Whatever it is sits just ahead of the robot
+    planner.addSeenObstacle(pointAhead(pose, GridPlanner::ROBOT_RADIUS + OBSTACLE_RADIUS), OBSTACLE_RADIUS);
+    
+    blockedPoint = positionOf(pose);
+    backoffStartMs = nowMs;
+    status = BACKING_OFF;
+}
+
+void RouteFollower::startReplan(const Odometry::Pose& pose) {
+    planner.start(positionOf(pose), route[next]);
+    status = REPLANNING;
+}
+
+bool RouteFollower::insertDetour() {
+    // The planner's last waypoint is the one being driven to, already in the route
+    int added = planner.getWaypointCount() - 1;
+    if (count + added > MAX_WAYPOINTS) {
+        return false;
+    }
+    for (int i = count - 1; i >= next; i--) {
+        route[i + added] = route[i];
+    }
+    for (int i = 0; i < added; i++) {
+        route[next + i] = planner.getWaypoint(i);
+    }
+    count += added;
+    return true;
+}
+// ----------------------------------------------------------------------------
+// TipDetector Class
+// ----------------------------------------------------------------------------
+/**
+ * TipDetector Class
+ * 
+ * Usage:
+ *   1. update() with every inertial reading (as fast as the sensor runs)
+ *   2. While isTipping(): drive with getCorrectionPower(), drop height if shouldDropHeight()
+ *   3. pollEvent() to react to tips and collisions
+ */
+class TipDetector {
+public:
+    /**
+     * Kinds of event
+     */
+    enum EventType {
+        TIP_WARNING,   // Tipping started
+        TIP_CLEARED,   // Back on the ground
+        COLLISION      // Hit something (or got hit)
+    };
+    
+    /**
+     * Direction of a tip or collision, relative to the robot
+     */
+    enum Direction {
+        FRONT,
+        BACK,
+        LEFT,
+        RIGHT
+    };
+    
+    /**
+     * One published event
+     */
+    struct Event {
+        EventType type;
+        Direction direction;
+        uint32_t timestampMs;
+        double magnitude;   // Tilt in degrees (tips) or jerk in g/s (collisions)
+    };
+    
+    /**
+     * Tilt that counts as tipping (degrees)
+     */
+    static constexpr double TIP_ANGLE = 15.0;
+    
+    /**
+     * Tilt must be below this to count as back on the ground (degrees)
+     */
+    static constexpr double CLEAR_ANGLE = 6.0;
+    
+    /**
+     * How far ahead the tilt is predicted from its rate (seconds)
+     */
+    static constexpr double PREDICT_SECONDS = 0.15;
+    
+    /**
+     * Tilt rate smoothing weight for the newest reading (0-1)
+     */
+    static constexpr double RATE_FILTER = 0.3;
+    
+    /**
+     * Corrective drive power per degree of pitch over CLEAR_ANGLE (percent)
+     */
+    static constexpr double CORRECTION_GAIN = 4.0;
+    
+    /**
+     * Most corrective drive power (percent)
+     */
+    static const int MAX_CORRECTION = 60;
+    
+    /**
+     * Jerk that counts as a collision (g per second)
+     */
+    static constexpr double COLLISION_JERK = 40.0;
+    
+    /**
+     * Ignore further collisions for this long after one (ms)
+     */
+    static const uint32_t COLLISION_HOLDOFF_MS = 250;
+    
+    /**
+     * Events kept until polled (oldest dropped when full)
+     */
+    static const int EVENT_CAPACITY = 16;
+    
+    /**
+     * Create a detector
+     * 
+     * @param dropHeightOnTip true = suggest LOW height when tipping starts
+     */
+    TipDetector(bool dropHeightOnTip = true);
+    
+    /**
+     * Add one inertial reading
+     * 
+     * @param timestampMs When it was measured
+     * @param pitch Degrees (front up positive)
+     * @param roll Degrees (right down positive)
+     * @param accelForward Forward acceleration (g)
+     * @param accelRight Sideways acceleration (g)
+     */
+    void update(uint32_t timestampMs, double pitch, double roll, double accelForward, double accelRight);
+    
+    /**
+     * True while tipping
+     */
+    bool isTipping() const;
+    
+    /**
+     * Drive power to apply to both sides while tipping (percent, 0 if not tipping)
+     * Positive = forward. Sideways tips can't be driven out of, so they give 0.
+     */
+    int getCorrectionPower() const;
+    
+    /**
+     * True while tipping and the height should be dropped to LOW
+     */
+    bool shouldDropHeight() const;
+    
+    /**
+     * Take the oldest unread event
+     * 
+     * @param event Output: the event
+     * @return false if there are none
+     */
+    bool pollEvent(Event& event);
+    
+    /**
+     * Number of unread events
+     */
+    int getEventCount() const;
+    
+    /**
+     * Events lost because nobody read them in time
+     */
+    int getDroppedEventCount() const;
+    
+    /**
+     * Predicted tilt (degrees) after PREDICT_SECONDS
+     */
+    double getPredictedTilt() const;
+    
+private:
+    bool dropHeightOnTip;
+    bool hasReading;
+    uint32_t lastMs;
+    double pitch;
+    double roll;
+    double pitchRate;      // Degrees per second (filtered)
+    double rollRate;
+    double lastAccelForward;
+    double lastAccelRight;
+    bool tipping;
+    Direction tipDirection;
+    bool collisionRecent;
+    uint32_t lastCollisionMs;
+    Event events[EVENT_CAPACITY];
+    int eventStart;
+    int eventCount;
+    int droppedEvents;
+    
+    void publish(EventType type, Direction direction, uint32_t timestampMs, double magnitude);
+};
+
+TipDetector::TipDetector(bool dropHeightOnTip)
+    : dropHeightOnTip(dropHeightOnTip),
+      hasReading(false),
+      lastMs(0),
+      pitch(0.0),
+      roll(0.0),
+      pitchRate(0.0),
+      rollRate(0.0),
+      lastAccelForward(0.0),
+      lastAccelRight(0.0),
+      tipping(false),
+      tipDirection(BACK),
+      collisionRecent(false),
+      lastCollisionMs(0),
+      eventStart(0),
+      eventCount(0),
+      droppedEvents(0) {
+}
+
+void TipDetector::update(uint32_t timestampMs, double newPitch, double newRoll,
+                         double accelForward, double accelRight) {
+    if (!hasReading) {
+        hasReading = true;
+        lastMs = timestampMs;
+        pitch = newPitch;
+        roll = newRoll;
+        lastAccelForward = accelForward;
+        lastAccelRight = accelRight;
+        return;
+    }
+    if (timestampMs == lastMs) {
+        return;  // Same reading again
+    }
+    double dt = (timestampMs - lastMs) / 1000.0;
+    lastMs = timestampMs;
+    
+    // Tilt rates (smoothed - the raw difference is noisy at full sensor rate)
+    pitchRate += ((newPitch - pitch) / dt - pitchRate) * RATE_FILTER;
+    rollRate += ((newRoll - roll) / dt - rollRate) * RATE_FILTER;
+    pitch = newPitch;
+    roll = newRoll;
+    
+    // Collisions: jerk = change in horizontal acceleration per second
+    double jerkForward = (accelForward - lastAccelForward) / dt;
+    double jerkRight = (accelRight - lastAccelRight) / dt;
+    lastAccelForward = accelForward;
+    lastAccelRight = accelRight;
+    double jerk = std::sqrt(jerkForward * jerkForward + jerkRight * jerkRight);
+    
+    if (collisionRecent && timestampMs - lastCollisionMs >= COLLISION_HOLDOFF_MS) {
+        collisionRecent = false;
+    }
+    if (!collisionRecent && jerk >= COLLISION_JERK) {
+        // Direction of the hit: a hit on the front pushes the robot backward
+        Direction direction;
+        if (std::fabs(jerkForward) >= std::fabs(jerkRight)) {
+            direction = (jerkForward < 0.0) ? FRONT : BACK;
+        } else {
+            direction = (jerkRight < 0.0) ? RIGHT : LEFT;
+        }
+        collisionRecent = true;
+        lastCollisionMs = timestampMs;
+        publish(COLLISION, direction, timestampMs, jerk);
+    }
+    
+    // Tipping: now, or soon at the current rate
+    double predictedPitch = pitch + pitchRate * PREDICT_SECONDS;
+    double predictedRoll = roll + rollRate * PREDICT_SECONDS;
+    bool pitchTip = std::fabs(predictedPitch) >= TIP_ANGLE || std::fabs(pitch) >= TIP_ANGLE;
+    bool rollTip = std::fabs(predictedRoll) >= TIP_ANGLE || std::fabs(roll) >= TIP_ANGLE;
+    
+    if (!tipping && (pitchTip || rollTip)) {
+        tipping = true;
+        if (pitchTip && (!rollTip || std::fabs(predictedPitch) >= std::fabs(predictedRoll))) {
+            tipDirection = (predictedPitch > 0.0) ? BACK : FRONT;
+        } else {
+            tipDirection = (predictedRoll > 0.0) ? RIGHT : LEFT;
+        }
+        publish(TIP_WARNING, tipDirection, timestampMs, std::fmax(std::fabs(predictedPitch), std::fabs(predictedRoll)));
+    } else if (tipping && std::fabs(pitch) < CLEAR_ANGLE && std::fabs(roll) < CLEAR_ANGLE) {
+        tipping = false;
+        publish(TIP_CLEARED, tipDirection, timestampMs, std::fmax(std::fabs(pitch), std::fabs(roll)));
+    }
+}
+
+bool TipDetector::isTipping() const {
+    return tipping;
+}
+
+int TipDetector::getCorrectionPower() const {
+    if (!tipping || (tipDirection != FRONT && tipDirection != BACK)) {
+        return 0;
+    }
+    
+    // Drive toward the side going down (at least a little while the tip is still predicted)
+    double excess = std::fmax(std::fabs(pitch) - CLEAR_ANGLE, 0.0);
+    double power = std::fmin(CORRECTION_GAIN * excess + MAX_CORRECTION / 3.0, (double)MAX_CORRECTION);
+    return (tipDirection == BACK) ? -(int)power : (int)power;
+}
+
+bool TipDetector::shouldDropHeight() const {
+    return tipping && dropHeightOnTip;
+}
+
+bool TipDetector::pollEvent(Event& event) {
+    if (eventCount == 0) {
+        return false;
+    }
+    event = events[eventStart];
+    eventStart = (eventStart + 1) % EVENT_CAPACITY;
+    eventCount--;
+    return true;
+}
+
+int TipDetector::getEventCount() const {
+    return eventCount;
+}
+
+int TipDetector::getDroppedEventCount() const {
+    return droppedEvents;
+}
+
+double TipDetector::getPredictedTilt() const {
+    return std::fmax(std::fabs(pitch + pitchRate * PREDICT_SECONDS), std::fabs(roll + rollRate * PREDICT_SECONDS));
+}
+
+void TipDetector::publish(EventType type, Direction direction, uint32_t timestampMs, double magnitude) {
+    if (eventCount == EVENT_CAPACITY) {
+        // Full: drop the oldest so the newest is always there
+        eventStart = (eventStart + 1) % EVENT_CAPACITY;
+        eventCount--;
+        droppedEvents++;
+    }
+    Event& event = events[(eventStart + eventCount) % EVENT_CAPACITY];
+    event.type = type;
+    event.direction = direction;
+    event.timestampMs = timestampMs;
+    event.magnitude = magnitude;
+    eventCount++;
+}
+
+// ----------------------------------------------------------------------------
+// TripleBuffer Class
+// ----------------------------------------------------------------------------
+/**
+ * TripleBuffer Class
+ * 
+ * Usage:
+ *   Writer task: write(value) whenever there is a new value
+ *   Reader task: read(value) - returns true if the value is new since the last read
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    /**
+     * Create a buffer holding three default values
+     */
+    TripleBuffer()
+        : middle(1),
+          back(2),
+          front(0) {
+    }
+    
+    /**
+     * Publish a value (writer task only; never waits)
+     * 
+     * @param value The new value
+     */
+    void write(const T& value) {
+        buffers[back] = value;
+        // Swap the filled copy into the middle, marked fresh; take the old middle to fill next
+        uint8_t previous = middle.exchange((uint8_t)(back | FRESH_BIT), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+    
+    /**
+     * Get the latest value (reader task only; never waits)
+     * 
+     * @param value Output: the latest published value (or the last one read if nothing new)
+     * @return true if it is new since the last read
+     */
+    bool read(T& value) {
+        bool fresh = (middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+        if (fresh) {
+            // Swap our old copy into the middle (not fresh) and take the new one
+            uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+            front = previous & INDEX_MASK;
+        }
+        value = buffers[front];
+        return fresh;
+    }
+    
+    /**
+     * True if a value was published since the last read (either task)
+     */
+    bool hasNew() const {
+        return (middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+    
+private:
+    static const uint8_t INDEX_MASK = 0x03;
+    static const uint8_t FRESH_BIT = 0x04;
+    
+    T buffers[3];
+    std::atomic<uint8_t> middle;   // Index of the middle copy + FRESH_BIT (shared)
+    uint8_t back;                  // Writer's copy (writer only)
+    uint8_t front;                 // Reader's copy (reader only)
+};
+// ----------------------------------------------------------------------------
+// InputSampler Class
+// ----------------------------------------------------------------------------
+/**
+ * InputSampler Class
+ * 
+ * Usage:
+ *   Input task:   sample(axes, buttons, now) as often as possible
+ *   Control loop: read(snapshot) - true when something changed since the last read
+ */
+class InputSampler {
+public:
+    /**
+     * Controller buttons (bit positions in Snapshot::buttons)
+     */
+    enum Button {
+        BUTTON_L1, BUTTON_L2, BUTTON_R1, BUTTON_R2,
+        BUTTON_UP, BUTTON_DOWN, BUTTON_LEFT, BUTTON_RIGHT,
+        BUTTON_X, BUTTON_B, BUTTON_Y, BUTTON_A,
+        BUTTON_COUNT
+    };
+    
+    /**
+     * Controller axes (Axis1 to Axis4)
+     */
+    enum Axis {
+        AXIS_1,   // Right stick X
+        AXIS_2,   // Right stick Y
+        AXIS_3,   // Left stick Y
+        AXIS_4,   // Left stick X
+        AXIS_COUNT
+    };
+    
+    /**
+     * One controller reading
+     */
+    struct Snapshot {
+        uint32_t timestampUs;        // When it was sampled
+        uint32_t changedAtUs;        // When this input state was first seen
+        uint32_t sequence;           // Increases with every published change
+        int axes[AXIS_COUNT];        // -100 to 100
+        uint16_t buttons;            // One bit per Button
+        
+        /**
+         * True if the button is held
+         */
+        bool pressed(Button button) const;
+        
+        /**
+         * Axis position (-100 to 100)
+         */
+        int axis(Axis which) const;
+    };
+    
+    /**
+     * Bit for a button in Snapshot::buttons
+     */
+    static uint16_t buttonBit(Button button);
+    
+    /**
+     * True if two snapshots have different stick positions or buttons
+     */
+    static bool differs(const Snapshot& a, const Snapshot& b);
+    
+    /**
+     * Create a sampler (sticks centered, nothing pressed)
+     */
+    InputSampler();
+    
+    /**
+     * Add one raw reading (input task only)
+     * 
+     * @param axes Stick positions, AXIS_COUNT values (-100 to 100)
+     * @param buttons Held buttons (buttonBit() of each)
+     * @param nowUs Current time in microseconds
+     * @return true if the input changed (and was published)
+     */
+    bool sample(const int axes[AXIS_COUNT], uint16_t buttons, uint32_t nowUs);
+    
+    /**
+     * Latest snapshot (control loop only; never waits)
+     * 
+     * @param snapshot Output: the latest snapshot
+     * @return true if it changed since the last read
+     */
+    bool read(Snapshot& snapshot);
+    
+    /**
+     * True if a change is waiting to be read
+     */
+    bool hasNew() const;
+    
+    /**
+     * Number of raw readings so far
+     */
+    uint32_t getSampleCount() const;
+    
+private:
+    TripleBuffer<Snapshot> published;
+    Snapshot current;       // Input task's latest reading
+    uint32_t sampleCount;
+};
+
+bool InputSampler::Snapshot::pressed(Button button) const {
+    return (buttons & buttonBit(button)) != 0;
+}
+
+int InputSampler::Snapshot::axis(Axis which) const {
+    return axes[which];
+}
+
+uint16_t InputSampler::buttonBit(Button button) {
+    return (uint16_t)(1u << button);
+}
+
+bool InputSampler::differs(const Snapshot& a, const Snapshot& b) {
+    if (a.buttons != b.buttons) {
+        return true;
+    }
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        if (a.axes[i] != b.axes[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+InputSampler::InputSampler()
+    : sampleCount(0) {
+    current.timestampUs = 0;
+    current.changedAtUs = 0;
+    current.sequence = 0;
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        current.axes[i] = 0;
+    }
+    current.buttons = 0;
+    published.write(current);
+    
+    // Nothing new for the reader yet
+    Snapshot discard;
+    published.read(discard);
+}
+
+bool InputSampler::sample(const int axes[AXIS_COUNT], uint16_t buttons, uint32_t nowUs) {
+    sampleCount++;
+    
+    Snapshot reading = current;
+    reading.timestampUs = nowUs;
+    reading.buttons = buttons;
+    for (int i = 0; i < AXIS_COUNT; i++) {
+        reading.axes[i] = axes[i];
+    }
+    
+    bool changed = differs(reading, current);
+    if (changed) {
+        reading.changedAtUs = nowUs;
+        reading.sequence = current.sequence + 1;
+        published.write(reading);
+    }
+    current = reading;
+    return changed;
+}
+
+bool InputSampler::read(Snapshot& snapshot) {
+    return published.read(snapshot);
+}
+
+bool InputSampler::hasNew() const {
+    return published.hasNew();
+}
+
+uint32_t InputSampler::getSampleCount() const {
+    return sampleCount;
+}
+
+// ----------------------------------------------------------------------------
+// SeqLock Class
+// ----------------------------------------------------------------------------
+/**
+ * SeqLock Class
+ * 
+ * Usage:
+ *   Writer task (only one): write(value)
+ *   Reader tasks: read(value) - retries until it gets a consistent copy
+ */
+template <typename T>
+class SeqLock {
+public:
+    /**
+     * Most attempts read() makes before giving up (a writer would have to be
+     * stuck mid-write for this to happen)
+     */
+    static const int MAX_READ_ATTEMPTS = 1000;
+    
+    /**
+     * Create a seqlock holding a default value
+     */
+    SeqLock()
+        : sequence(0),
+          value() {
+    }
+    
+    /**
+     * Publish a value (one writer task only; never waits)
+     * 
+     * @param newValue The new value
+     */
+    void write(const T& newValue) {
+        uint32_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);   // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&value, &newValue, sizeof(T));
+        sequence.store(start + 2, std::memory_order_release);   // Even: done
+    }
+    
+    /**
+     * One attempt at reading (never waits)
+     * 
+     * @param out Output: the value (only valid when this returns true)
+     * @return true if the copy is consistent
+     */
+    bool tryRead(T& out) const {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;  // Writer is in the middle of an update
+        }
+        std::memcpy(&out, &value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence.load(std::memory_order_relaxed) == before;
+    }
+    
+    /**
+     * Read a consistent copy, retrying if a write got in the way
+     * 
+     * @param out Output: the value
+     * @return true on success (false only if the writer never finished)
+     */
+    bool read(T& out) const {
+        for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+            if (tryRead(out)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * Number of writes so far (readers can tell whether anything changed)
+     */
+    uint32_t getVersion() const {
+        return sequence.load(std::memory_order_acquire) / 2;
+    }
+    
+private:
+    std::atomic<uint32_t> sequence;
+    T value;
+};
+
+// ----------------------------------------------------------------------------
+// SpscQueue Class
+// ----------------------------------------------------------------------------
+/**
+ * SpscQueue Class
+ * 
+ * Usage:
+ *   Producer task (only one): push(item) - false if full (item is dropped)
+ *   Consumer task (only one): pop(item) - false if empty
+ */
+template <typename T, uint32_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+    
+public:
+    /**
+     * Create an empty queue
+     */
+    SpscQueue()
+        : head(0),
+          tail(0),
+          dropped(0) {
+    }
+    
+    /**
+     * Add an item at the back (producer only; never waits)
+     * 
+     * @param item The item
+     * @return false if the queue was full (the item is counted as dropped)
+     */
+    bool push(const T& item) {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        items[currentTail & (CAPACITY - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Take the item at the front (consumer only; never waits)
+     * 
+     * @param item Output: the item
+     * @return false if the queue was empty
+     */
+    bool pop(T& item) {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[currentHead & (CAPACITY - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Number of items waiting (exact from either task's own point of view)
+     */
+    uint32_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * True if nothing is waiting
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    /**
+     * Items lost because the queue was full
+     */
+    uint32_t getDroppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * Maximum number of waiting items
+     */
+    static uint32_t capacity() {
+        return CAPACITY;
+    }
+    
+private:
+    T items[CAPACITY];
+    std::atomic<uint32_t> head;     // Next item to pop (consumer writes)
+    std::atomic<uint32_t> tail;     // Next free slot (producer writes)
+    std::atomic<uint32_t> dropped;
+};
+
+// ----------------------------------------------------------------------------
+// CommandScheduler Class
+// ----------------------------------------------------------------------------
+/**
+ * CommandScheduler Class
+ * 
+ * Usage (each tick):
+ *   1. schedule() / cancel() commands in response to buttons or events
+ *   2. run(frame) - default commands fill free subsystems, every command executes
+ *   3. frame.apply() to write the outputs
+ */
+class CommandScheduler {
+public:
+    /**
+     * Most commands scheduled at once
+     */
+    static const int MAX_SCHEDULED = 8;
+    
+    /**
+     * Create an empty scheduler (no commands, no defaults)
+     */
+    CommandScheduler();
+    
+    /**
+     * Set the command that runs when nothing else owns a subsystem
+     * 
+     * @param subsystem The subsystem
+     * @param command Default command (must require the subsystem), nullptr = none
+     * @return true if set
+     */
+    bool setDefaultCommand(Command::Subsystem subsystem, Command* command);
+    
+    /**
+     * Start a command, interrupting the owners of its subsystems
+     * Scheduling a command that is already running does nothing.
+     * Don't call from inside a command's execute().
+     * 
+     * @param command The command
+     * @return true if it is running, false if refused (non-interruptible owner or full)
+     */
+    bool schedule(Command* command);
+    
+    /**
+     * Stop a command (end() is called with interrupted = true)
+     * 
+     * @param command The command (ignored if not running)
+     */
+    void cancel(Command* command);
+    
+    /**
+     * Stop every command, interruptible or not
+     */
+    void cancelAll();
+    
+    /**
+     * One tick: start defaults on free subsystems, execute every command,
+     * end the finished ones
+     * 
+     * @param frame This tick's actuator commands
+     */
+    void run(ActuationFrame& frame);
+    
+    /**
+     * Check if a command is running
+     */
+    bool isScheduled(const Command* command) const;
+    
+    /**
+     * Command that owns a subsystem
+     * 
+     * @return The owner, or nullptr if free
+     */
+    Command* getOwner(Command::Subsystem subsystem) const;
+    
+    /**
+     * Number of commands running
+     */
+    int getScheduledCount() const;
+    
+private:
+    Command* scheduled[MAX_SCHEDULED];
+    int scheduledCount;
+    Command* owners[Command::SUBSYSTEM_COUNT];
+    Command* defaults[Command::SUBSYSTEM_COUNT];
+    
+    void remove(int index, bool interrupted);
+    int indexOf(const Command* command) const;
+    uint8_t getOwnedMask() const;
+    static int subsystemIndex(Command::Subsystem subsystem);
+};
+
+CommandScheduler::CommandScheduler() : scheduledCount(0) {
+    for (int i = 0; i < MAX_SCHEDULED; i++) {
+        scheduled[i] = nullptr;
+    }
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        owners[i] = nullptr;
+        defaults[i] = nullptr;
+    }
+}
+
+bool CommandScheduler::setDefaultCommand(Command::Subsystem subsystem, Command* command) {
+    int index = subsystemIndex(subsystem);
+    if (index < 0) {
+        return false;
+    }
+    if (command != nullptr && (command->getRequirements() & subsystem) == 0) {
+        return false;  // A default must own the subsystem it fills
+    }
+    defaults[index] = command;
+    return true;
+}
+
+bool CommandScheduler::schedule(Command* command) {
+    if (command == nullptr) {
+        return false;
+    }
+    if (indexOf(command) >= 0) {
+        return true;
+    }
+    
+    uint8_t requirements = command->getRequirements();
+    
+    // Refuse if any owner can't be interrupted (checked before interrupting anything)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if ((requirements & (1 << i)) && owners[i] != nullptr && !owners[i]->isInterruptible()) {
+            return false;
+        }
+    }
+    
+    // Interrupt the current owners (one command may own several of the subsystems)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if ((requirements & (1 << i)) && owners[i] != nullptr) {
+            remove(indexOf(owners[i]), true);
+        }
+    }
+    
+    if (scheduledCount >= MAX_SCHEDULED) {
+        return false;
+    }
+    
+    scheduled[scheduledCount++] = command;
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (requirements & (1 << i)) {
+            owners[i] = command;
+        }
+    }
+    command->initialize();
+    return true;
+}
+
+void CommandScheduler::cancel(Command* command) {
+    int index = indexOf(command);
+    if (index >= 0) {
+        remove(index, true);
+    }
+}
+
+void CommandScheduler::cancelAll() {
+    while (scheduledCount > 0) {
+        remove(scheduledCount - 1, true);
+    }
+}
+
+void CommandScheduler::run(ActuationFrame& frame) {
+    // Defaults fill free subsystems (only if everything they need is free)
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        Command* fallback = defaults[i];
+        if (owners[i] == nullptr && fallback != nullptr &&
+            (fallback->getRequirements() & getOwnedMask()) == 0) {
+            schedule(fallback);
+        }
+    }
+    
+    // Execute in the order scheduled
+    for (int i = 0; i < scheduledCount; i++) {
+        scheduled[i]->execute(frame);
+    }
+    
+    // End the finished ones
+    int i = 0;
+    while (i < scheduledCount) {
+        if (scheduled[i]->isFinished()) {
+            remove(i, false);
+        } else {
+            i++;
+        }
+    }
+}
+
+bool CommandScheduler::isScheduled(const Command* command) const {
+    return indexOf(command) >= 0;
+}
+
+Command* CommandScheduler::getOwner(Command::Subsystem subsystem) const {
+    int index = subsystemIndex(subsystem);
+    return (index >= 0) ? owners[index] : nullptr;
+}
+
+int CommandScheduler::getScheduledCount() const {
+    return scheduledCount;
+}
+
+void CommandScheduler::remove(int index, bool interrupted) {
+    Command* command = scheduled[index];
+    for (int i = index; i < scheduledCount - 1; i++) {
+        scheduled[i] = scheduled[i + 1];
+    }
+    scheduledCount--;
+    scheduled[scheduledCount] = nullptr;
+    
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (owners[i] == command) {
+            owners[i] = nullptr;
+        }
+    }
+    command->end(interrupted);
+}
+
+int CommandScheduler::indexOf(const Command* command) const {
+    for (int i = 0; i < scheduledCount; i++) {
+        if (scheduled[i] == command) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint8_t CommandScheduler::getOwnedMask() const {
+    uint8_t mask = 0;
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (owners[i] != nullptr) {
+            mask |= (1 << i);
+        }
+    }
+    return mask;
+}
+
+int CommandScheduler::subsystemIndex(Command::Subsystem subsystem) {
+    for (int i = 0; i < Command::SUBSYSTEM_COUNT; i++) {
+        if (subsystem == (1 << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// EventBus Class
+// ----------------------------------------------------------------------------
+/**
+ * EventChannel Class
+ * 
+ * Queue and subscriber list for one event type.
+ * 
+ * @tparam Event The event struct
+ * @tparam CAPACITY Most events waiting between dispatches (power of two)
+ * @tparam MAX_SUBSCRIBERS Most subscribed handlers
+ */
+template <typename Event, uint32_t CAPACITY = 16, int MAX_SUBSCRIBERS = 4>
+class EventChannel {
+public:
+    typedef Event EventType;
+    
+    /**
+     * Called once per event during dispatch()
+     */
+    typedef void (*Handler)(const Event& event);
+    
+    /**
+     * Create a channel with no subscribers
+     */
+    EventChannel() : subscriberCount(0) {
+        for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+            subscribers[i] = nullptr;
+        }
+    }
+    
+    /**
+     * Add a handler (initialization only)
+     * 
+     * @param handler Function to call for each event
+     * @return false if the subscriber list is full
+     */
+    bool subscribe(Handler handler) {
+        if (handler == nullptr || subscriberCount >= MAX_SUBSCRIBERS) {
+            return false;
+        }
+        subscribers[subscriberCount++] = handler;
+        return true;
+    }
+    
+    /**
+     * Queue an event (publishing task only; never waits)
+     * 
+     * @param event The event
+     * @return false if the queue was full (the event is dropped and counted)
+     */
+    bool publish(const Event& event) {
+        return queue.push(event);
+    }
+    
+    /**
+     * Deliver every queued event to every subscriber, oldest first (dispatching task only)
+     * 
+     * @return Number of events delivered
+     */
+    int dispatch() {
+        int delivered = 0;
+        Event event;
+        while (queue.pop(event)) {
+            for (int i = 0; i < subscriberCount; i++) {
+                subscribers[i](event);
+            }
+            delivered++;
+        }
+        return delivered;
+    }
+    
+    /**
+     * Events waiting for dispatch()
+     */
+    uint32_t getPendingCount() const {
+        return queue.size();
+    }
+    
+    /**
+     * Events lost because the queue was full
+     */
+    uint32_t getDroppedCount() const {
+        return queue.getDroppedCount();
+    }
+    
+    /**
+     * Number of subscribed handlers
+     */
+    int getSubscriberCount() const {
+        return subscriberCount;
+    }
+    
+private:
+    SpscQueue<Event, CAPACITY> queue;
+    Handler subscribers[MAX_SUBSCRIBERS];
+    int subscriberCount;
+};
+
+/**
+ * EventBus Class
+ * 
+ * Usage:
+ *   typedef EventBus<EventChannel<JamEvent>, EventChannel<FaultEvent, 8> > RobotBus;
+ *   Init:             bus.subscribe<JamEvent>(onJam);
+ *   Publishing task:  bus.publish(JamEvent{...});
+ *   Each tick:        bus.dispatchAll();
+ * 
+ * @tparam Channels One EventChannel per event type (each type at most once)
+ */
+template <typename... Channels>
+class EventBus;
+
+/**
+ * Empty bus (end of the channel list)
+ */
+template <>
+class EventBus<> {
+public:
+    int dispatchAll() {
+        return 0;
+    }
+    
+    uint32_t getDroppedCount() const {
+        return 0;
+    }
+    
+protected:
+    void channelFor() {}
+};
+
+template <typename First, typename... Rest>
+class EventBus<First, Rest...> : private EventBus<Rest...> {
+public:
+    /**
+     * Add a handler for an event type (initialization only)
+     * 
+     * @return false if that channel's subscriber list is full
+     */
+    template <typename Event>
+    bool subscribe(void (*handler)(const Event& event)) {
+        return channelFor(static_cast<const Event*>(nullptr)).subscribe(handler);
+    }
+    
+    /**
+     * Queue an event on the channel for its type
+     * 
+     * @return false if that channel was full (event dropped)
+     */
+    template <typename Event>
+    bool publish(const Event& event) {
+        return channelFor(static_cast<const Event*>(nullptr)).publish(event);
+    }
+    
+    /**
+     * Deliver every queued event on every channel (channels in the order listed)
+     * 
+     * @return Number of events delivered
+     */
+    int dispatchAll() {
+        int delivered = first.dispatch();
+        return delivered + EventBus<Rest...>::dispatchAll();
+    }
+    
+    /**
+     * Events of one type waiting for dispatch
+     */
+    template <typename Event>
+    uint32_t getPendingCount() {
+        return channelFor(static_cast<const Event*>(nullptr)).getPendingCount();
+    }
+    
+    /**
+     * Events lost on every channel
+     */
+    uint32_t getDroppedCount() const {
+        return first.getDroppedCount() + EventBus<Rest...>::getDroppedCount();
+    }
+    
+protected:
+    // Overload per channel: the compiler picks the channel from the event pointer type
+    using EventBus<Rest...>::channelFor;
+    
+    First& channelFor(const typename First::EventType*) {
+        return first;
+    }
+    
+private:
+    First first;
+};
+
+// ----------------------------------------------------------------------------
+// ActuationProbe Class
+// ----------------------------------------------------------------------------
+/**
+ * ActuationProbe Class
+ * 
+ * Usage (one probe per motor type):
+ *   startTrial(commandUs, position) right after the step command
+ *   while (!addSample(nowUs, position)) { ... }   - only new encoder readings
+ *   stop the motor, rest, repeat; then read the statistics and getModel()
+ */
+class ActuationProbe {
+public:
+    /**
+     * Most encoder readings kept per trial
+     */
+    static const int MAX_SAMPLES = 128;
+    
+    /**
+     * Movement (degrees) that counts as "the motor started"
+     */
+    static constexpr double MOVE_THRESHOLD_DEG = 0.5;
+    
+    /**
+     * Length of one trial (microseconds) - long enough to reach full speed
+     */
+    static const uint32_t TRIAL_TIME_US = 400000;
+    
+    /**
+     * Result of one trial
+     */
+    struct TrialResult {
+        bool valid;             // Moved and reached a steady speed
+        uint32_t firstMotionUs; // Command -> first encoder movement
+        uint32_t riseTimeUs;    // 10% -> 90% of steady speed
+        double deadTimeMs;      // Fitted dead time (command -> start of acceleration)
+        double timeConstantMs;  // Fitted first-order time constant
+        double steadyRpm;       // Speed over the last part of the trial
+    };
+    
+    /**
+     * Motor model for the simulator: speed follows the command after deadTimeMs,
+     * with a first-order lag of timeConstantMs, settling at steadyRpm
+     */
+    struct MotorModel {
+        double deadTimeMs;
+        double timeConstantMs;
+        double steadyRpm;
+    };
+    
+    /**
+     * Create a probe with no trials
+     */
+    ActuationProbe();
+    
+    /**
+     * Forget every trial
+     */
+    void reset();
+    
+    /**
+     * Start a trial (call right after commanding the step)
+     * 
+     * @param commandUs When the command was sent (microseconds)
+     * @param startPositionDeg Encoder position before the step (degrees)
+     */
+    void startTrial(uint32_t commandUs, double startPositionDeg);
+    
+    /**
+     * Add a new encoder reading
+     * 
+     * @param timestampUs When it was read (microseconds, same clock as startTrial)
+     * @param positionDeg Encoder position (degrees)
+     * @return true when the trial is over (results are in)
+     */
+    bool addSample(uint32_t timestampUs, double positionDeg);
+    
+    /**
+     * Check if a trial is in progress
+     */
+    bool isRunning() const;
+    
+    /**
+     * Result of the last finished trial
+     */
+    TrialResult getLastResult() const;
+    
+    /**
+     * Number of finished trials, and how many of them failed (no movement, no steady speed)
+     */
+    int getTrialCount() const;
+    int getFailedCount() const;
+    
+    /**
+     * Distribution of command -> first encoder movement
+     */
+    const LatencyStats& getMotionLatency() const;
+    
+    /**
+     * Distribution of 10% -> 90% rise time
+     */
+    const LatencyStats& getRiseTime() const;
+    
+    /**
+     * Motor model averaged over the valid trials (all zero if none)
+     */
+    MotorModel getModel() const;
+    
+    /**
+     * Fit a first-order model to the 10% and 90% speed crossing times
+     * For v = V(1 - e^-(t - dead) / tau): t10 = dead + 0.105 tau, t90 = dead + 2.303 tau
+     * 
+     * @param t10Ms Time the speed reached 10% (ms after the command)
+     * @param t90Ms Time the speed reached 90% (ms after the command)
+     * @param deadTimeMs Output: dead time
+     * @param timeConstantMs Output: time constant
+     */
+    static void fitFirstOrder(double t10Ms, double t90Ms, double& deadTimeMs, double& timeConstantMs);
+    
+private:
+    static const uint32_t MOTION_BUCKET_US = 1000;       // 1 ms resolution, up to 64 ms
+    static const uint32_t RISE_BUCKET_US = 4000;         // 4 ms resolution, up to 256 ms
+    static constexpr double STEADY_FRACTION = 0.75;      // Steady speed = average after 75% of the trial
+    static constexpr double LN_10_OVER_9 = 0.10536;      // ln(1 / 0.9)
+    static constexpr double LN_10 = 2.30259;             // ln(1 / 0.1)
+    
+    uint32_t sampleUs[MAX_SAMPLES];      // Time since the command
+    double samplePosition[MAX_SAMPLES];  // Degrees moved since the start
+    int sampleCount;
+    uint32_t commandUs;
+    double startPosition;
+    bool running;
+    
+    TrialResult lastResult;
+    int trialCount;
+    int failedCount;
+    LatencyStats motionLatency;
+    LatencyStats riseTime;
+    double deadTimeSumMs;
+    double timeConstantSumMs;
+    double steadyRpmSum;
+    
+    void finishTrial();
+    double speedAt(int index) const;
+    static double crossingTime(double t0, double v0, double t1, double v1, double level);
+};
+
+ActuationProbe::ActuationProbe() : motionLatency(MOTION_BUCKET_US), riseTime(RISE_BUCKET_US) {
+    reset();
+}
+
+void ActuationProbe::reset() {
+    sampleCount = 0;
+    commandUs = 0;
+    startPosition = 0.0;
+    running = false;
+    lastResult = TrialResult{false, 0, 0, 0.0, 0.0, 0.0};
+    trialCount = 0;
+    failedCount = 0;
+    motionLatency.reset();
+    riseTime.reset();
+    deadTimeSumMs = 0.0;
+    timeConstantSumMs = 0.0;
+    steadyRpmSum = 0.0;
+}
+
+void ActuationProbe::startTrial(uint32_t commandTimeUs, double startPositionDeg) {
+    commandUs = commandTimeUs;
+    startPosition = startPositionDeg;
+    sampleCount = 0;
+    running = true;
+}
+
+bool ActuationProbe::addSample(uint32_t timestampUs, double positionDeg) {
+    if (!running) {
+        return true;
+    }
+    uint32_t elapsedUs = timestampUs - commandUs;
+    if (sampleCount < MAX_SAMPLES) {
+        sampleUs[sampleCount] = elapsedUs;
+        samplePosition[sampleCount] = positionDeg - startPosition;
+        sampleCount++;
+    }
+    if (elapsedUs >= TRIAL_TIME_US || sampleCount >= MAX_SAMPLES) {
+        finishTrial();
+        return true;
+    }
+    return false;
+}
+
+bool ActuationProbe::isRunning() const {
+    return running;
+}
+
+ActuationProbe::TrialResult ActuationProbe::getLastResult() const {
+    return lastResult;
+}
+
+int ActuationProbe::getTrialCount() const {
+    return trialCount;
+}
+
+int ActuationProbe::getFailedCount() const {
+    return failedCount;
+}
+
+const LatencyStats& ActuationProbe::getMotionLatency() const {
+    return motionLatency;
+}
+
+const LatencyStats& ActuationProbe::getRiseTime() const {
+    return riseTime;
+}
+
+ActuationProbe::MotorModel ActuationProbe::getModel() const {
+    int valid = trialCount - failedCount;
+    if (valid <= 0) {
+        return MotorModel{0.0, 0.0, 0.0};
+    }
+    return MotorModel{deadTimeSumMs / valid, timeConstantSumMs / valid, steadyRpmSum / valid};
+}
+
+void ActuationProbe::fitFirstOrder(double t10Ms, double t90Ms, double& deadTimeMs, double& timeConstantMs) {
+    timeConstantMs = (t90Ms - t10Ms) / (LN_10 - LN_10_OVER_9);
+    deadTimeMs = t10Ms - LN_10_OVER_9 * timeConstantMs;
+    if (deadTimeMs < 0.0) {
+        deadTimeMs = 0.0;
+    }
+}
+
+double ActuationProbe::speedAt(int index) const {
+    // Degrees per microsecond -> rpm (one reading back; index >= 1)
+    double dt = (double)(sampleUs[index] - sampleUs[index - 1]);
+    if (dt <= 0.0) {
+        return 0.0;
+    }
+    return (samplePosition[index] - samplePosition[index - 1]) / dt * 1e6 / 6.0;
+}
+
+double ActuationProbe::crossingTime(double t0, double v0, double t1, double v1, double level) {
+    if (v1 <= v0) {
+        return t1;
+    }
+    double fraction = (level - v0) / (v1 - v0);
+    if (fraction < 0.0) {
+        fraction = 0.0;
+    }
+    return t0 + fraction * (t1 - t0);
+}
+
+void ActuationProbe::finishTrial() {
+    running = false;
+    trialCount++;
+    TrialResult result = TrialResult{false, 0, 0, 0.0, 0.0, 0.0};
+    
+    // First encoder movement
+    bool moved = false;
+    for (int i = 0; i < sampleCount; i++) {
+        if (std::fabs(samplePosition[i]) >= MOVE_THRESHOLD_DEG) {
+            result.firstMotionUs = sampleUs[i];
+            moved = true;
+            break;
+        }
+    }
+    
+    // Steady speed: average over the end of the trial
+    uint32_t steadyFromUs = (uint32_t)(sampleUs[sampleCount > 0 ? sampleCount - 1 : 0] * STEADY_FRACTION);
+    int steadyIndex = -1;
+    for (int i = 1; i < sampleCount; i++) {
+        if (sampleUs[i - 1] >= steadyFromUs) {
+            steadyIndex = i - 1;
+            break;
+        }
+    }
+    if (moved && steadyIndex >= 0 && steadyIndex < sampleCount - 1) {
+        int last = sampleCount - 1;
+        result.steadyRpm = (samplePosition[last] - samplePosition[steadyIndex]) /
+                           (double)(sampleUs[last] - sampleUs[steadyIndex]) * 1e6 / 6.0;
+    }
+    
+    // 10% and 90% speed crossings. Speed is measured between readings (placed at the
+    // midpoint time) and the crossing is interpolated, so the report period doesn't bias it.
+    double t10Ms = -1.0;
+    double t90Ms = -1.0;
+    double steadyMagnitude = std::fabs(result.steadyRpm);
+    if (steadyMagnitude > 1.0) {
+        double previousMs = 0.0;     // At rest when commanded
+        double previousSpeed = 0.0;
+        for (int i = 1; i < sampleCount && t90Ms < 0.0; i++) {
+            double speed = std::fabs(speedAt(i));
+            double midMs = (sampleUs[i] + sampleUs[i - 1]) / 2000.0;
+            if (t10Ms < 0.0 && speed >= 0.1 * steadyMagnitude) {
+                t10Ms = crossingTime(previousMs, previousSpeed, midMs, speed, 0.1 * steadyMagnitude);
+            }
+            if (speed >= 0.9 * steadyMagnitude) {
+                t90Ms = crossingTime(previousMs, previousSpeed, midMs, speed, 0.9 * steadyMagnitude);
+            }
+            previousMs = midMs;
+            previousSpeed = speed;
+        }
+    }
+    
+    if (moved && t10Ms >= 0.0 && t90Ms > t10Ms) {
+        result.valid = true;
+        result.riseTimeUs = (uint32_t)((t90Ms - t10Ms) * 1000.0);
+        fitFirstOrder(t10Ms, t90Ms, result.deadTimeMs, result.timeConstantMs);
+        
+        motionLatency.add(result.firstMotionUs);
+        riseTime.add(result.riseTimeUs);
+        deadTimeSumMs += result.deadTimeMs;
+        timeConstantSumMs += result.timeConstantMs;
+        steadyRpmSum += result.steadyRpm;
+    } else {
+        failedCount++;
+    }
+    lastResult = result;
+}
+
+// ----------------------------------------------------------------------------
+// AutonSchedule Class
+// ----------------------------------------------------------------------------
+/**
+ * AutonSchedule Class
+ * 
+ * Usage:
+ *   1. clear(), addStep() for each step of the routine, in the order to run them
+ *   2. start() when the period starts
+ *   3. next() for the step to run (NO_STEP = nothing left worth doing)
+ *   4. Every tick while it runs: update(); false = stop the step now
+ *   5. finishStep() when it ends, then back to 3
+ */
+class AutonSchedule {
+public:
+    /**
+     * Where a step is
+     */
+    enum StepState {
+        PENDING,   // Not run yet
+        RUNNING,   // Being run
+        DONE,      // Finished (its points count)
+        FAILED,    // Ran but didn't finish (timed out, abandoned, nothing to pick up)
+        SKIPPED    // Not run: nothing left to gain from it, or a step it needs failed
+    };
+    
+    /**
+     * Most steps in a routine
+     */
+    static const int MAX_STEPS = 16;
+    
+    /**
+     * "No step" (from next(), and for a step that needs nothing before it)
+     */
+    static const int NO_STEP = -1;
+    
+    /**
+     * Aim to have the last step done this long before the end of the period (ms)
+     */
+    static const uint32_t END_MARGIN_MS = 200;
+    
+    /**
+     * Limits on the pace (time taken / time expected of the finished steps)
+     */
+    static constexpr double MIN_PACE = 0.8;
+    static constexpr double MAX_PACE = 1.5;
+    
+    /**
+     * A step running this many times its expected time (or that can't finish in time
+     * anymore) is checked against starting another step instead
+     */
+    static constexpr double MAX_OVERRUN = 1.5;
+    
+    /**
+     * Time still needed by a step already past its expected time, as a part of that
+     * time (it is close, but nobody knows how close)
+     */
+    static constexpr double OVERRUN_LEFT = 0.25;
+    
+    AutonSchedule();
+    
+    /**
+     * Remove every step
+     */
+    void clear();
+    
+    /**
+     * Add a step at the end of the routine
+     * 
+     * @param name Short name for logs (not copied, use a string literal)
+     * @param expectedMs How long it usually takes
+     * @param points What finishing it is worth (0 for a step that sets up later ones)
+     * @param needs Step that must be DONE before this one (an earlier step, or NO_STEP)
+     * @return The step's number, or NO_STEP if the routine is full or needs is invalid
+     */
+    int addStep(const char* name, uint32_t expectedMs, double points, int needs = NO_STEP);
+    
+    /**
+     * Start the routine: every step PENDING
+     * 
+     * @param nowMs Current time
+     * @param periodMs Time until the end of the period (e.g. MatchClock::getRemainingMs())
+     */
+    void start(uint32_t nowMs, uint32_t periodMs);
+    
+    /**
+     * Pick the step to run and mark it RUNNING
+     * 
+     * When nothing is left that leads to points, the steps not run are marked SKIPPED.
+     * 
+     * @param nowMs Current time
+     * @return Step number, or NO_STEP when nothing left is worth starting
+     */
+    int next(uint32_t nowMs);
+    
+    /**
+     * Check the running step (call every tick)
+     * 
+     * @param nowMs Current time
+     * @return false if the step should be stopped now (then call finishStep() with false)
+     */
+    bool update(uint32_t nowMs);
+    
+    /**
+     * The running step ended
+     * 
+     * @param nowMs Current time
+     * @param finished true if it did what it was for (its points count); false skips
+     *                 the steps that need it
+     */
+    void finishStep(uint32_t nowMs, bool finished);
+    
+    /**
+     * True if the steps left would run past the end of the period at the current pace
+     */
+    bool isBehind(uint32_t nowMs) const;
+    
+    /**
+     * Time taken / time expected of the finished steps (1.0 until one finishes)
+     */
+    double getPace() const;
+    
+    /**
+     * Points of the DONE steps
+     */
+    double getScore() const;
+    
+    int getStepCount() const;
+    int getCurrent() const;
+    StepState getState(int step) const;
+    const char* getName(int step) const;
+    
+private:
+    struct Step {
+        const char* name;
+        uint32_t expectedMs;
+        double points;
+        int needs;
+        StepState state;
+    };
+    
+    /**
+     * What it takes to finish each step from now: the step and every step it needs
+     * that isn't DONE yet (the running one counts for its time still needed)
+     */
+    struct Paths {
+        double ms[MAX_STEPS];
+        double points[MAX_STEPS];
+        int first[MAX_STEPS];   // Step to run first on the way (NO_STEP = can't be done)
+    };
+    
+    Step steps[MAX_STEPS];
+    int count;
+    
+    uint32_t endMs;
+    int current;
+    uint32_t currentStartMs;
+    uint32_t takenMs;      // Time the finished steps took
+    uint32_t plannedMs;    // Time they were expected to take
+    
+    /**
+     * Time left until END_MARGIN_MS before the end (negative when past it)
+     */
+    int32_t timeLeft(uint32_t nowMs) const;
+    
+    /**
+     * Time the running step still needs at the current pace
+     */
+    double runningNeedsMs(uint32_t nowMs) const;
+    
+    /**
+     * Fill in the paths (one pass: a step only needs earlier steps)
+     */
+    void findPaths(uint32_t nowMs, Paths& paths) const;
+    
+    /**
+     * Points per second of going for a step (0 if it's worth nothing or its path
+     * doesn't fit in leftMs)
+     */
+    double rate(const Paths& paths, int step, int32_t leftMs) const;
+    
+    /**
+     * Mark SKIPPED every PENDING step whose needed step FAILED or was SKIPPED
+     */
+    void skipOrphans();
+};
+
+AutonSchedule::AutonSchedule() {
+    clear();
+}
+
+void AutonSchedule::clear() {
+    count = 0;
+    endMs = 0;
+    current = NO_STEP;
+    currentStartMs = 0;
+    takenMs = 0;
+    plannedMs = 0;
+}
+
+int AutonSchedule::addStep(const char* name, uint32_t expectedMs, double points, int needs) {
+    if (count >= MAX_STEPS || needs < NO_STEP || needs >= count) {
+        return NO_STEP;
+    }
+    Step& step = steps[count];
+    step.name = name;
+    step.expectedMs = expectedMs;
+    step.points = points;
+    step.needs = needs;
+    step.state = PENDING;
+    return count++;
+}
+
+void AutonSchedule::start(uint32_t nowMs, uint32_t periodMs) {
+    endMs = nowMs + periodMs;
+    current = NO_STEP;
+    takenMs = 0;
+    plannedMs = 0;
+    for (int i = 0; i < count; i++) {
+        steps[i].state = PENDING;
+    }
+}
+
+int AutonSchedule::next(uint32_t nowMs) {
+    if (current != NO_STEP) {
+        return current;
+    }
+    skipOrphans();
+    
+    int chosen = NO_STEP;
+    if (!isBehind(nowMs)) {
+        // On time: the listed order
+        for (int i = 0; i < count && chosen == NO_STEP; i++) {
+            bool needsDone = steps[i].needs == NO_STEP || steps[steps[i].needs].state == DONE;
+            if (steps[i].state == PENDING && needsDone) {
+                chosen = i;
+            }
+        }
+    } else {
+        Paths paths;
+        findPaths(nowMs, paths);
+        int32_t leftMs = timeLeft(nowMs);
+        
+        // Best points per second, and most points, that still fit
+        int fastest = NO_STEP;
+        int biggest = NO_STEP;
+        double bestRate = 0.0;
+        for (int i = 0; i < count; i++) {
+            double stepRate = rate(paths, i, leftMs);
+            if (stepRate <= 0.0) {
+                continue;
+            }
+            if (stepRate > bestRate) {
+                fastest = i;
+                bestRate = stepRate;
+            }
+            if (biggest == NO_STEP || paths.points[i] > paths.points[biggest]) {
+                biggest = i;
+            }
+        }
+        
+        // The fastest points first, unless that leaves no time for more points
+        int target = fastest;
+        if (fastest != NO_STEP && paths.first[biggest] != paths.first[fastest] &&
+            paths.ms[fastest] + paths.ms[biggest] > leftMs &&
+            paths.points[biggest] > paths.points[fastest]) {
+            target = biggest;
+        }
+        
+        // Nothing fits: the quickest points left, it might still make it
+        for (int i = 0; i < count && fastest == NO_STEP; i++) {
+            if (paths.first[i] != NO_STEP && paths.points[i] > 0.0 &&
+                (target == NO_STEP || paths.ms[i] < paths.ms[target])) {
+                target = i;
+            }
+        }
+        if (target != NO_STEP) {
+            chosen = paths.first[target];
+        }
+    }
+    
+    if (chosen == NO_STEP) {
+        // Nothing left leads to points
+        for (int i = 0; i < count; i++) {
+            if (steps[i].state == PENDING) {
+                steps[i].state = SKIPPED;
+            }
+        }
+    } else {
+        steps[chosen].state = RUNNING;
+        current = chosen;
+        currentStartMs = nowMs;
+    }
+    return chosen;
+}
+
+bool AutonSchedule::update(uint32_t nowMs) {
+    if (current == NO_STEP) {
+        return true;
+    }
+    double expected = getPace() * steps[current].expectedMs;
+    double elapsed = (double)(nowMs - currentStartMs);
+    bool overrun = elapsed > MAX_OVERRUN * expected;
+    bool tooLate = runningNeedsMs(nowMs) > timeLeft(nowMs);
+    if (!overrun && !tooLate) {
+        return true;
+    }
+    
+    // Points from staying with this step (and whatever else fits after it) vs. the
+    // most points another step gets out of the time left
+    Paths paths;
+    findPaths(nowMs, paths);
+    int32_t leftMs = timeLeft(nowMs);
+    int stay = NO_STEP;
+    double otherPoints = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (rate(paths, i, leftMs) <= 0.0) {
+            continue;
+        }
+        if (paths.first[i] == current) {
+            stay = (stay == NO_STEP || paths.points[i] > paths.points[stay]) ? i : stay;
+        } else if (paths.points[i] > otherPoints) {
+            otherPoints = paths.points[i];
+        }
+    }
+    if (stay == NO_STEP) {
+        return otherPoints <= 0.0;  // Can't make it: stop if something else can
+    }
+    double afterPoints = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (paths.first[i] != current && rate(paths, i, leftMs - (int32_t)paths.ms[stay]) > 0.0 &&
+            paths.points[i] > afterPoints) {
+            afterPoints = paths.points[i];
+        }
+    }
+    return paths.points[stay] + afterPoints >= otherPoints;
+}
+
+void AutonSchedule::finishStep(uint32_t nowMs, bool finished) {
+    if (current == NO_STEP) {
+        return;
+    }
+    Step& step = steps[current];
+    if (finished) {
+        step.state = DONE;
+        takenMs += nowMs - currentStartMs;
+        plannedMs += step.expectedMs;
+    } else {
+        step.state = FAILED;
+        skipOrphans();
+    }
+    current = NO_STEP;
+}
+
+bool AutonSchedule::isBehind(uint32_t nowMs) const {
+    double pendingMs = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (steps[i].state == PENDING) {
+            pendingMs += steps[i].expectedMs;
+        }
+    }
+    return getPace() * pendingMs + runningNeedsMs(nowMs) > timeLeft(nowMs);
+}
+
+double AutonSchedule::getPace() const {
+    if (plannedMs == 0) {
+        return 1.0;
+    }
+    double pace = (double)takenMs / plannedMs;
+    return (pace < MIN_PACE) ? MIN_PACE : (pace > MAX_PACE) ? MAX_PACE : pace;
+}
+
+double AutonSchedule::getScore() const {
+    double score = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (steps[i].state == DONE) {
+            score += steps[i].points;
+        }
+    }
+    return score;
+}
+
+int AutonSchedule::getStepCount() const {
+    return count;
+}
+
+int AutonSchedule::getCurrent() const {
+    return current;
+}
+
+AutonSchedule::StepState AutonSchedule::getState(int step) const {
+    return steps[step].state;
+}
+
+const char* AutonSchedule::getName(int step) const {
+    return steps[step].name;
+}
+
+int32_t AutonSchedule::timeLeft(uint32_t nowMs) const {
+    return (int32_t)(endMs - END_MARGIN_MS - nowMs);
+}
+
+double AutonSchedule::runningNeedsMs(uint32_t nowMs) const {
+    if (current == NO_STEP) {
+        return 0.0;
+    }
+    double expected = getPace() * steps[current].expectedMs;
+    double elapsed = (double)(nowMs - currentStartMs);
+    return (elapsed < expected) ? expected - elapsed : OVERRUN_LEFT * expected;
+}
+
+void AutonSchedule::findPaths(uint32_t nowMs, Paths& paths) const {
+    for (int i = 0; i < count; i++) {
+        const Step& step = steps[i];
+        paths.ms[i] = 0.0;
+        paths.points[i] = 0.0;
+        paths.first[i] = NO_STEP;
+        if (step.state != PENDING && step.state != RUNNING) {
+            continue;
+        }
+        
+        double ownMs = (step.state == RUNNING) ? runningNeedsMs(nowMs) : getPace() * step.expectedMs;
+        if (step.needs == NO_STEP || steps[step.needs].state == DONE) {
+            paths.ms[i] = ownMs;
+            paths.points[i] = step.points;
+            paths.first[i] = i;
+        } else if (paths.first[step.needs] != NO_STEP) {
+            paths.ms[i] = paths.ms[step.needs] + ownMs;
+            paths.points[i] = paths.points[step.needs] + step.points;
+            paths.first[i] = paths.first[step.needs];
+        }
+    }
+}
+
+double AutonSchedule::rate(const Paths& paths, int step, int32_t leftMs) const {
+    if (paths.first[step] == NO_STEP || paths.points[step] <= 0.0 || paths.ms[step] > leftMs) {
+        return 0.0;
+    }
+    return paths.points[step] / (paths.ms[step] > 1.0 ? paths.ms[step] : 1.0);
+}
+
+void AutonSchedule::skipOrphans() {
+    // A step only needs earlier steps, so one pass in order reaches the whole chain
+    for (int i = 0; i < count; i++) {
+        int needs = steps[i].needs;
+        if (steps[i].state != PENDING || needs == NO_STEP) {
+            continue;
+        }
+        if (steps[needs].state == FAILED || steps[needs].state == SKIPPED) {
+            steps[i].state = SKIPPED;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// StartDetector Class
+// ----------------------------------------------------------------------------
+/**
+ * StartDetector Class
+ * 
+ * Usage:
+ *   1. addSensor() for each distance sensor, addStart() for each routine's start pose
+ *   2. While disabled before the match: update() with the readings and inertial heading
+ *   3. getStatus() / getStart(): the routine to run
+ */
+class StartDetector {
+public:
+    /**
+     * What the detector knows
+     */
+    enum Status {
+        WAITING,         // Averaging readings (robot just placed or moved)
+        DETECTED,        // On a routine's start pose, facing its way
+        WRONG_HEADING,   // On a routine's start tile, but facing another way
+        UNKNOWN          // No start pose matches, or two match about as well
+    };
+    
+    /**
+     * Most distance sensors and start poses
+     */
+    static const int MAX_SENSORS = 4;
+    static const int MAX_STARTS = 8;
+    
+    /**
+     * Where a distance sensor is on the robot
+     */
+    struct Mount {
+        double x;       // Inches right of the robot's center
+        double y;       // Inches forward of the robot's center
+        double angle;   // Direction it faces, degrees clockwise from the robot's front
+    };
+    
+    /**
+     * Field half size (walls at +/- this, inches) and the farthest a distance sensor
+     * measures (2 m)
+     */
+    static constexpr double FIELD_HALF_SIZE = 72.0;
+    static constexpr double MAX_RANGE = 78.0;
+    
+    /**
+     * Readings averaged before a detection (one per update())
+     */
+    static const int SAMPLE_COUNT = 10;
+    
+    /**
+     * The robot counts as moved when its heading changes this much (degrees) or a
+     * reading jumps this much (inches) from the average so far
+     */
+    static constexpr double MOVE_DEGREES = 3.0;
+    static constexpr double MOVE_INCHES = 3.0;
+    
+    /**
+     * Most a single sensor adds to a pose's error (inches): a blocked sensor, or one
+     * that sees a wall where none was expected
+     */
+    static constexpr double BLOCKED_ERROR = 12.0;
+    
+    /**
+     * A match: RMS error (inches) at most MAX_ERROR, and at least MIN_MARGIN better
+     * than the next best pose
+     */
+    static constexpr double MAX_ERROR = 4.0;
+    static constexpr double MIN_MARGIN = 2.0;
+    
+    /**
+     * Constructor: no sensors, no start poses
+     */
+    StartDetector();
+    
+    /**
+     * Add a distance sensor (readings are passed in this order)
+     * 
+     * @return false if there are already MAX_SENSORS
+     */
+    bool addSensor(const Mount& mount);
+    
+    /**
+     * Add a routine's start pose
+     * 
+     * @return The start's number (0, 1, ...), or -1 if there are already MAX_STARTS
+     */
+    int addStart(const Odometry::Pose& pose);
+    
+    /**
+     * Forget the readings (back to WAITING)
+     */
+    void restart();
+    
+    /**
+     * Add one set of readings
+     * 
+     * @param distances Distance per sensor (inches; negative = nothing in range)
+     * @param headingDeg Inertial heading (degrees, any zero)
+     * @return Status after the update
+     */
+    Status update(const double distances[], double headingDeg);
+    
+    Status getStatus() const;
+    
+    /**
+     * Start pose the robot is on (DETECTED or WRONG_HEADING), else -1
+     */
+    int getStart() const;
+    
+    /**
+     * How far the robot is turned from that start's heading (0, 90, 180 or 270; clockwise)
+     */
+    double getHeadingError() const;
+    
+    /**
+     * RMS error of the best pose, and of the next best (inches)
+     */
+    double getError() const;
+    double getRunnerUpError() const;
+    
+    /**
+     * Where the robot's center is estimated to be (the best pose, or the field center
+     * before a detection)
+     */
+    Odometry::Pose getPose() const;
+    
+    /**
+     * What a sensor would measure with the robot at a pose (nothing but the walls)
+     * 
+     * @return Inches, or -1 if the wall is out of range
+     */
+    static double expectedDistance(const Odometry::Pose& robot, const Mount& mount);
+    
+    /**
+     * RMS error of the averaged readings against a pose (inches)
+     */
+    double poseError(const Odometry::Pose& pose) const;
+    
+private:
+    Mount sensors[MAX_SENSORS];
+    int sensorCount;
+    Odometry::Pose starts[MAX_STARTS];
+    int startCount;
+    
+    // Averaging (inches; "nothing in range" readings are counted separately)
+    double sums[MAX_SENSORS];
+    int hits[MAX_SENSORS];
+    int samples;
+    double firstHeading;
+    
+    Status status;
+    int start;
+    double headingError;
+    double error;
+    double runnerUpError;
+    
+    /**
+     * Averaged reading of a sensor (-1 if it mostly saw nothing)
+     */
+    double average(int sensor) const;
+    
+    /**
+     * Score every start pose facing every way
+     */
+    void match();
+};
+
+StartDetector::StartDetector() {
+    sensorCount = 0;
+    startCount = 0;
+    restart();
+}
+
+bool StartDetector::addSensor(const Mount& mount) {
+    if (sensorCount >= MAX_SENSORS) {
+        return false;
+    }
+    sensors[sensorCount++] = mount;
+    restart();
+    return true;
+}
+
+int StartDetector::addStart(const Odometry::Pose& pose) {
+    if (startCount >= MAX_STARTS) {
+        return -1;
+    }
+    starts[startCount] = pose;
+    restart();
+    return startCount++;
+}
+
+void StartDetector::restart() {
+    for (int i = 0; i < MAX_SENSORS; i++) {
+        sums[i] = 0.0;
+        hits[i] = 0;
+    }
+    samples = 0;
+    firstHeading = 0.0;
+    status = WAITING;
+    start = -1;
+    headingError = 0.0;
+    error = 0.0;
+    runnerUpError = 0.0;
+}
+
+StartDetector::Status StartDetector::update(const double distances[], double headingDeg) {
+    // Moved or turned since the average started: start over from here
+    bool moved = samples > 0 && std::fabs(Odometry::headingDifference(firstHeading, headingDeg)) > MOVE_DEGREES;
+    for (int i = 0; i < sensorCount && !moved; i++) {
+        moved = distances[i] >= 0.0 && hits[i] > 0 && std::fabs(distances[i] - sums[i] / hits[i]) > MOVE_INCHES;
+    }
+    if (moved) {
+        restart();
+    }
+    if (samples == 0) {
+        firstHeading = headingDeg;
+    }
+    
+    for (int i = 0; i < sensorCount; i++) {
+        if (distances[i] >= 0.0) {
+            sums[i] += distances[i];
+            hits[i]++;
+        }
+    }
+    samples++;
+    
+    if (samples >= SAMPLE_COUNT) {
+        match();
+    }
+    return status;
+}
+
+StartDetector::Status StartDetector::getStatus() const {
+    return status;
+}
+
+int StartDetector::getStart() const {
+    return start;
+}
+
+double StartDetector::getHeadingError() const {
+    return headingError;
+}
+
+double StartDetector::getError() const {
+    return error;
+}
+
+double StartDetector::getRunnerUpError() const {
+    return runnerUpError;
+}
+
+Odometry::Pose StartDetector::getPose() const {
+    Odometry::Pose pose = {0.0, 0.0, 0.0};
+    if (start >= 0) {
+        pose = starts[start];
+        pose.heading = Odometry::wrapHeading(pose.heading + headingError);
+    }
+    return pose;
+}
+
+double StartDetector::expectedDistance(const Odometry::Pose& robot, const Mount& mount) {
+    // Sensor position: robot center + mount offset, turned with the robot
+    double heading = robot.heading * Odometry::DEGREES_TO_RADIANS;
+    double x = robot.x + mount.x * std::cos(heading) + mount.y * std::sin(heading);
+    double y = robot.y - mount.x * std::sin(heading) + mount.y * std::cos(heading);
+    
+    // Along the beam to the first wall it reaches
+    double beam = (robot.heading + mount.angle) * Odometry::DEGREES_TO_RADIANS;
+    double dx = std::sin(beam);
+    double dy = std::cos(beam);
+    double distance = INFINITY;
+    if (std::fabs(dx) > 1e-9) {
+        distance = std::fmin(distance, ((dx > 0.0 ? FIELD_HALF_SIZE : -FIELD_HALF_SIZE) - x) / dx);
+    }
+    if (std::fabs(dy) > 1e-9) {
+        distance = std::fmin(distance, ((dy > 0.0 ? FIELD_HALF_SIZE : -FIELD_HALF_SIZE) - y) / dy);
+    }
+    return (distance > MAX_RANGE) ? -1.0 : distance;
+}
+
+double StartDetector::poseError(const Odometry::Pose& pose) const {
+    if (sensorCount == 0) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < sensorCount; i++) {
+        double expected = expectedDistance(pose, sensors[i]);
+        double measured = average(i);
+        double difference;
+        if (expected < 0.0 && measured < 0.0) {
+            difference = 0.0;
+        } else if (expected < 0.0 || measured < 0.0) {
+            difference = BLOCKED_ERROR;
+        } else {
+            difference = std::fmin(std::fabs(measured - expected), BLOCKED_ERROR);
+        }
+        sum += difference * difference;
+    }
+    return std::sqrt(sum / sensorCount);
+}
+
+double StartDetector::average(int sensor) const {
+    // Mostly nothing in range: treat as nothing in range
+    if (hits[sensor] * 2 < samples) {
+        return -1.0;
+    }
+    return sums[sensor] / hits[sensor];
+}
+
+void StartDetector::match() {
+    // Best of every start pose facing every way
+    int bestStart = -1;
+    int bestTurn = 0;
+    double bestError = INFINITY;
+    for (int s = 0; s < startCount; s++) {
+        for (int turn = 0; turn < 4; turn++) {
+            Odometry::Pose pose = starts[s];
+            pose.heading = Odometry::wrapHeading(pose.heading + 90.0 * turn);
+            double poseErr = poseError(pose);
+            if (poseErr < bestError) {
+                bestStart = s;
+                bestTurn = turn;
+                bestError = poseErr;
+            }
+        }
+    }
+    
+    // Next best pose somewhere else (two routines from the same pose: the first one added)
+    double nextError = INFINITY;
+    Odometry::Pose best = (bestStart >= 0) ? starts[bestStart] : Odometry::Pose{0.0, 0.0, 0.0};
+    best.heading = Odometry::wrapHeading(best.heading + 90.0 * bestTurn);
+    for (int s = 0; s < startCount; s++) {
+        for (int turn = 0; turn < 4; turn++) {
+            Odometry::Pose pose = starts[s];
+            pose.heading = Odometry::wrapHeading(pose.heading + 90.0 * turn);
+            bool samePose = std::fabs(pose.x - best.x) < 1.0 && std::fabs(pose.y - best.y) < 1.0 &&
+                            std::fabs(Odometry::headingDifference(pose.heading, best.heading)) < 1.0;
+            if (samePose) {
+                // Prefer a routine that starts facing this way over one turned to it
+                if (turn == 0 && bestTurn != 0) {
+                    bestStart = s;
+                    bestTurn = 0;
+                }
+                continue;
+            }
+            nextError = std::fmin(nextError, poseError(pose));
+        }
+    }
+    
+    error = bestError;
+    runnerUpError = nextError;
+    if (bestStart >= 0 && bestError <= MAX_ERROR && nextError - bestError >= MIN_MARGIN) {
+        start = bestStart;
+        headingError = 90.0 * bestTurn;
+        status = (bestTurn == 0) ? DETECTED : WRONG_HEADING;
+    } else {
+        start = -1;
+        headingError = 0.0;
+        status = UNKNOWN;
+    }
+}
+
+// ============================================================================
+// HARDWARE DECLARATIONS
+// ============================================================================
+
+// Initialize the VEX Brain controller (the main robot brain)
+brain Brain;
+
+// MOTOR DECLARATIONS
+// Motors are named and built from the robot description (see RobotDescriptor.h) -
+// change ports, reversals and gearsets there, not here.
+// The motor groups allow us to control multiple motors together
+
+/**
+ * VEX port number for a smart port (PORT1 is 0)
+ */
+int32_t smartPort(int port) {
+  return port - 1;
+}
+
+/**
+ * VEX gear setting for a cartridge
+ */
+gearSetting motorGearing(RobotDescriptor::Gearset gearset) {
+  switch (gearset) {
+    case RobotDescriptor::GEARSET_36_1: return ratio36_1;
+    case RobotDescriptor::GEARSET_6_1: return ratio6_1;
+    default: return ratio18_1;
+  }
+}
+
+/**
+ * Build a motor from its description
+ * 
+ * @param id Which motor (index into RobotDescriptor::MOTORS)
+ */
+motor makeMotor(ActuationFrame::Motor id) {
+  const RobotDescriptor::MotorSpec& spec = RobotDescriptor::MOTORS[id];
+  return motor(smartPort(spec.port), motorGearing(spec.gearset), spec.reversed);
+}
+
+/**
+ * VEX 3-wire port for a port letter
+ */
+triport::port& threeWirePort(char letter) {
+  switch (letter) {
+    case 'A': return Brain.ThreeWirePort.A;
+    case 'B': return Brain.ThreeWirePort.B;
+    case 'C': return Brain.ThreeWirePort.C;
+    case 'D': return Brain.ThreeWirePort.D;
+    case 'E': return Brain.ThreeWirePort.E;
+    case 'F': return Brain.ThreeWirePort.F;
+    case 'G': return Brain.ThreeWirePort.G;
+    default: return Brain.ThreeWirePort.H;
+  }
+}
+
+// Left side motors - 3 motors that spin together to move the left side
+motor LeftFrontMotor = makeMotor(ActuationFrame::LEFT_FRONT);
+motor LeftMiddleMotor = makeMotor(ActuationFrame::LEFT_MIDDLE);
+motor LeftBackMotor = makeMotor(ActuationFrame::LEFT_BACK);
+motor_group LeftDrive = motor_group(LeftFrontMotor, LeftMiddleMotor, LeftBackMotor);  // Group all 3 together
+
+// Right side motors - 3 motors that spin together to move the right side (reversed for opposite spin)
+motor RightFrontMotor = makeMotor(ActuationFrame::RIGHT_FRONT);
+motor RightMiddleMotor = makeMotor(ActuationFrame::RIGHT_MIDDLE);
+motor RightBackMotor = makeMotor(ActuationFrame::RIGHT_BACK);
+motor_group RightDrive = motor_group(RightFrontMotor, RightMiddleMotor, RightBackMotor);  // Group all 3 together
+
+// INTAKE AND RAMP MOTORS (Feature 2)
+// Intake motor - collects balls from ground (5.5V motor)
+motor IntakeMotor = makeMotor(ActuationFrame::INTAKE);
+
+// Ramp motors - first two ramp wheels share one motor (5.5V motor)
+motor RampMotor = makeMotor(ActuationFrame::RAMP);
+
+// FULL POWER RAMP MOTOR (Feature 3)
+// Final ramp wheel - pushes balls out at top (full power motor)
+motor FullPowerRampMotor = makeMotor(ActuationFrame::FULL_POWER_RAMP);
+
+// ALL MOTORS - dispatch table indexed by ActuationFrame::Motor (RobotDescriptor::MOTORS order)
+const int MOTOR_COUNT = RobotDescriptor::MOTOR_COUNT;
+motor* const AllMotors[MOTOR_COUNT] = {
+  &LeftFrontMotor, &LeftMiddleMotor, &LeftBackMotor,
+  &RightFrontMotor, &RightMiddleMotor, &RightBackMotor,
+  &IntakeMotor, &RampMotor, &FullPowerRampMotor
+};
+
+// Drive motors per side, front to back (worked out from the description at compile time)
+const int DRIVE_MOTORS_PER_SIDE = RobotDescriptor::countSide(RobotDescriptor::LEFT);
+static_assert(RobotDescriptor::sideMotor(RobotDescriptor::LEFT, 0) == ActuationFrame::LEFT_FRONT &&
+              RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, 0) == ActuationFrame::RIGHT_FRONT,
+              "LeftDrive/RightDrive groups must match the robot description");
+
+// PNEUMATIC PISTONS (Feature 4)
+// Two pneumatic pistons control height of full power wheel
+digital_out Piston1 = digital_out(threeWirePort(RobotDescriptor::PISTONS[0].port));  // First piston
+digital_out Piston2 = digital_out(threeWirePort(RobotDescriptor::PISTONS[1].port));  // Second piston
+// Limit switch closed when the pistons are fully extended (set to true once it is fitted)
+const bool HEIGHT_SWITCH_INSTALLED = false;
+limit HeightSwitch = limit(threeWirePort(RobotDescriptor::HEIGHT_SWITCH_PORT));
+
+// LOCALIZATION SENSORS
+// Inertial sensor - heading for odometry
+inertial Inertial = inertial(smartPort(RobotDescriptor::INERTIAL_PORT));
+// GPS sensor - absolute field position from the field code strip
+// gps(port, x offset, y offset, units, heading offset): offsets from robot center to sensor
+gps GPS = gps(smartPort(RobotDescriptor::GPS_PORT), 0.0, 0.0, mm, 180);  // Facing backward (180 degree offset)
+
+// VISION SENSOR
+// Finds balls of our color for autonomous pickup (see VisionTracker, BallPursuit) and the
+// goal for driver auto-aim (see GoalAim)
+// Generate the signatures with the Vision Utility (VEXcode) and paste them here
+const int BALL_SIGNATURE_ID = 1;
+vision::signature BALL_SIGNATURE = vision::signature(BALL_SIGNATURE_ID, 8099, 8893, 8496, -1505, -949, -1227, 3.0, 0);
+const int GOAL_SIGNATURE_ID = 2;
+vision::signature GOAL_SIGNATURE = vision::signature(GOAL_SIGNATURE_ID, -3441, -2785, -3113, 8975, 10355, 9665, 2.5, 0);
+vision Vision = vision(smartPort(RobotDescriptor::VISION_PORT), 50, BALL_SIGNATURE, GOAL_SIGNATURE);
+
+// DISTANCE SENSORS
+// Measure the field walls before the match to find the start tile (see StartDetector)
+distance DistanceLeft = distance(smartPort(RobotDescriptor::DISTANCE_LEFT_PORT));
+distance DistanceRight = distance(smartPort(RobotDescriptor::DISTANCE_RIGHT_PORT));
+distance DistanceBack = distance(smartPort(RobotDescriptor::DISTANCE_BACK_PORT));
+
+// Controller - the V5 controller that the driver uses
+controller Controller1 = controller(primary);
+
+// Competition object - handles autonomous and driver control periods
+competition Competition;
+
+// ROBOT STATE AND PHASES
+// Current height, button edge detection and last subsystem commands live in Phases.getState()
+// so every phase starts from a known state (see the hooks below setupPhaseHooks()).
+
+/**
+ * Microsecond clock for phase latency measurement
+ */
+uint32_t phaseClockUs() {
+  return (uint32_t)timer::systemHighResolution();
+}
+
+PhaseManager Phases(phaseClockUs);
+
+// LOCALIZATION
+// Wheel and sensor constants - adjust to match your robot
+const double DRIVE_WHEEL_DIAMETER = 4.0;  // Inches
+const double DRIVE_GEAR_RATIO = 1.0;      // Wheel turns per motor output turn (1.0 = direct drive)
+const uint32_t GPS_LATENCY_MS = 100;      // How old a GPS reading is when it reaches the Brain
+const uint32_t LOCALIZATION_PERIOD_MS = 10;
+
+// Robot pose on the field, updated by localizationTask()
+// Other tasks read the published copy: RobotPose.read(pose) (never blocks localization)
+GpsFusion Localization;
+SeqLock<Odometry::Pose> RobotPose;
+
+// Known start pose (e.g. from start tile detection): written by any task, applied by
+// localizationTask() on its next tick
+SeqLock<Odometry::Pose> StartPose;
+
+/**
+ * LOCALIZATION TASK
+ * Runs in the background for the whole program.
+ * Every 10 ms: adds one odometry step. Whenever the GPS has a new reading:
+ * applies it at the time it was measured (see GpsFusion). A new StartPose resets the pose.
+ */
+int localizationTask() {
+  double lastLeftDegrees = LeftDrive.position(degrees);
+  double lastRightDegrees = RightDrive.position(degrees);
+  uint32_t lastGpsTimestamp = GPS.timestamp();
+  uint32_t startPoseVersion = StartPose.getVersion();
+  
+  while (true) {
+    uint32_t now = timer::system();
+    
+    // Start pose: only use it once
+    if (StartPose.getVersion() != startPoseVersion) {
+      startPoseVersion = StartPose.getVersion();
+      Odometry::Pose start;
+      StartPose.read(start);
+      Localization.reset(now, start, Inertial.heading());
+    }
+    
+    // Odometry: average travel of both sides since the last tick
+    double leftDegrees = LeftDrive.position(degrees);
+    double rightDegrees = RightDrive.position(degrees);
+    double leftTravel = Odometry::wheelTravel(leftDegrees - lastLeftDegrees, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+    double rightTravel = Odometry::wheelTravel(rightDegrees - lastRightDegrees, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+    lastLeftDegrees = leftDegrees;
+    lastRightDegrees = rightDegrees;
+    Localization.updateOdometry(now, (leftTravel + rightTravel) / 2.0, Inertial.heading());
+    
+    // GPS: only use a reading once (timestamp changes when a new packet arrives)
+    uint32_t gpsTimestamp = GPS.timestamp();
+    if (gpsTimestamp != lastGpsTimestamp && gpsTimestamp > GPS_LATENCY_MS) {
+      lastGpsTimestamp = gpsTimestamp;
+      Odometry::Pose gpsPose;
+      gpsPose.x = GPS.xPosition(inches);
+      gpsPose.y = GPS.yPosition(inches);
+      gpsPose.heading = GPS.heading();
+      Localization.applyGpsFix(gpsTimestamp - GPS_LATENCY_MS, gpsPose, GPS.quality());
+    }
+    RobotPose.write(Localization.getPose());
+    
+    wait(LOCALIZATION_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// MOTOR VELOCITY
+// One estimator per motor, same order as AllMotors (default filter: Savitzky-Golay)
+VelocityEstimator MotorVelocities[MOTOR_COUNT];
+const uint32_t VELOCITY_PERIOD_MS = 5;  // Faster than the ~10 ms motor reports, so none are missed
+
+// Latest speed of every motor, published by motorVelocityTask() for other tasks
+struct MotorSpeeds {
+  double rpm[MOTOR_COUNT];
+};
+SeqLock<MotorSpeeds> PublishedMotorSpeeds;
+
+/**
+ * MOTOR VELOCITY TASK
+ * Runs in the background for the whole program.
+ * Feeds each motor's encoder position and the motor's OWN reading timestamp to its
+ * estimator. Repeated readings are ignored by the estimator, so polling fast is free.
+ * Publishes all speeds together in PublishedMotorSpeeds.
+ */
+int motorVelocityTask() {
+  while (true) {
+    MotorSpeeds speeds;
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+      MotorVelocities[i].addSample(AllMotors[i]->timestamp(), AllMotors[i]->position(degrees));
+      speeds.rpm[i] = MotorVelocities[i].getRpm();
+    }
+    PublishedMotorSpeeds.write(speeds);
+    wait(VELOCITY_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// CONTROLLER INPUT
+// inputTask() samples the controller every 2 ms and hands changes to usercontrol(),
+// which wakes up as soon as something changes instead of waiting for its next tick.
+InputSampler Inputs;
+LatencyStats InputLatency;               // Input change seen -> all motors commanded
+const uint32_t INPUT_PERIOD_MS = 2;
+const uint32_t CONTROL_PERIOD_MS = 20;   // Longest time between usercontrol() ticks
+const bool EVENT_DRIVEN_CONTROL = true;  // false = old fixed 20 ms loop (to compare latency)
+
+// Controller buttons in InputSampler::Button order
+controller::button* const ControllerButtons[InputSampler::BUTTON_COUNT] = {
+  &Controller1.ButtonL1, &Controller1.ButtonL2, &Controller1.ButtonR1, &Controller1.ButtonR2,
+  &Controller1.ButtonUp, &Controller1.ButtonDown, &Controller1.ButtonLeft, &Controller1.ButtonRight,
+  &Controller1.ButtonX, &Controller1.ButtonB, &Controller1.ButtonY, &Controller1.ButtonA
+};
+
+/**
+ * INPUT TASK
+ * Runs in the background for the whole program.
+ * Reads the controller much faster than radio packets arrive, so every new packet is
+ * seen within 2 ms, and timestamps it with the microsecond timer.
+ */
+int inputTask() {
+  while (true) {
+    int axes[InputSampler::AXIS_COUNT] = {
+      Controller1.Axis1.position(), Controller1.Axis2.position(),
+      Controller1.Axis3.position(), Controller1.Axis4.position()
+    };
+    uint16_t buttons = 0;
+    for (int i = 0; i < InputSampler::BUTTON_COUNT; i++) {
+      if (ControllerButtons[i]->pressing()) {
+        buttons |= InputSampler::buttonBit((InputSampler::Button)i);
+      }
+    }
+    Inputs.sample(axes, buttons, (uint32_t)timer::systemHighResolution());
+    wait(INPUT_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+/**
+ * Wait for the next usercontrol() tick: a controller change, or CONTROL_PERIOD_MS at most
+ * 
+ * @param tickStartMs When the tick that just finished started
+ */
+void waitForNextTick(uint32_t tickStartMs) {
+  if (!EVENT_DRIVEN_CONTROL) {
+    wait(CONTROL_PERIOD_MS, msec);
+    return;
+  }
+  while (!Inputs.hasNew() && timer::system() - tickStartMs < CONTROL_PERIOD_MS) {
+    wait(1, msec);
+  }
+}
+
+// ACTUATION
+// usercontrol() stages every motor and piston command in an ActuationFrame while it computes,
+// then writes them all back-to-back at the end of the tick (see ActuationFrame).
+digital_out* const AllPistons[ActuationFrame::PISTON_COUNT] = {&Piston1, &Piston2};
+LatencyStats ActuationSkew(50);     // First write -> last write of a tick (50 us buckets)
+LatencyStats SchedulerOverhead(5);  // Commands.run() time per tick (5 us buckets, see COMMANDS)
+
+/**
+ * Write one staged motor command (index = AllMotors order)
+ */
+void writeFrameMotor(ActuationFrame::Motor motor, int power) {
+  AllMotors[motor]->spin(forward, power, percent);
+}
+
+/**
+ * Write one staged piston command
+ */
+void writeFramePiston(int piston, bool extended) {
+  AllPistons[piston]->set(extended);
+}
+
+// EVENTS
+// Tasks publish events instead of setting shared globals; handlers run at the start of each
+// control tick (usercontrol(), or waitUnlessCollision() in autonomous) - see EventBus.
+// Each event type has exactly one publishing task.
+
+/**
+ * The match moved to a new period (published by matchClockTask())
+ */
+struct PhaseChangedEvent {
+  MatchClock::Phase from;
+  MatchClock::Phase to;
+  uint32_t timeMs;
+};
+
+/**
+ * A motor problem the driver should know about (published by energyTask())
+ */
+struct FaultEvent {
+  enum Type { MOTOR_HOT, MOTOR_COOLED, MOTOR_UNPLUGGED, MOTOR_PLUGGED_IN };
+  Type type;
+  int motor;  // AllMotors index
+  uint32_t timeMs;
+};
+
+/**
+ * The ball detector saw a ball go in, out, or into the full power wheel (published by
+ * countBalls(), from autonomous() or usercontrol() - never both at once)
+ */
+struct BallEvent {
+  enum Type { GRABBED, SPAT_OUT, SCORED };
+  Type type;
+  int count;  // Balls in the robot afterwards (approximate, see BallDetector)
+  uint32_t timeMs;
+};
+
+typedef EventBus<EventChannel<PhaseChangedEvent, 8>, EventChannel<FaultEvent, 16>,
+                 EventChannel<BallEvent, 8> > RobotEventBus;
+RobotEventBus RobotEvents;
+
+const double MOTOR_HOT_CELSIUS = 55.0;   // V5 motors start limiting current here
+const double MOTOR_COOL_CELSIUS = 50.0;  // Below this the motor counts as cooled again
+
+// Torque (current) limits: full torque unless a motor runs hot, then derated until it
+// cools (the endgame rules lift the derating for the final push)
+const double FULL_TORQUE_LIMIT = 100.0;  // Percent - motor firmware limit
+const double HOT_TORQUE_LIMIT = 80.0;    // Percent - for a motor over MOTOR_HOT_CELSIUS
+bool MotorHot[MOTOR_COUNT] = {false};    // Updated by publishMotorFaults()
+bool TorqueDeratingOff = false;          // Set by the endgame rules, cleared every period
+
+/**
+ * Set a motor's torque limit from its temperature and the endgame rules
+ * 
+ * @param motor AllMotors index
+ */
+void applyTorqueLimit(int motor) {
+  bool derate = MotorHot[motor] && !TorqueDeratingOff;
+  AllMotors[motor]->setMaxTorque(derate ? HOT_TORQUE_LIMIT : FULL_TORQUE_LIMIT, percent);
+}
+
+/**
+ * Apply the torque limits of every motor
+ */
+void applyTorqueLimits() {
+  for (int i = 0; i < MOTOR_COUNT; i++) {
+    applyTorqueLimit(i);
+  }
+}
+
+/**
+ * Deliver waiting events (call once at the start of a control tick)
+ */
+void dispatchEvents() {
+  RobotEvents.dispatchAll();
+}
+
+/**
+ * Log every phase change
+ */
+void logPhaseChange(const PhaseChangedEvent& event) {
+  printf("PHASE_CHANGE,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.from, (int)event.to);
+}
+
+/**
+ * Log motor faults and warn the driver when a motor overheats or comes unplugged
+ */
+void reportFault(const FaultEvent& event) {
+  printf("FAULT,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.type, event.motor);
+  if (event.type == FaultEvent::MOTOR_HOT || event.type == FaultEvent::MOTOR_UNPLUGGED) {
+    Controller1.rumble("---");
+  }
+}
+
+/**
+ * Log ball events and tell the driver when the robot is full (the intake has stopped)
+ */
+void reportBall(const BallEvent& event) {
+  printf("BALLS,%lu,%d,%d\n", (unsigned long)event.timeMs, (int)event.type, event.count);
+  if (event.type == BallEvent::GRABBED && event.count >= BallDetector::DEFAULT_CAPACITY) {
+    Controller1.rumble(".");
+  }
+}
+
+/**
+ * Subscribe the event handlers (before the tasks start)
+ */
+void setupEvents() {
+  RobotEvents.subscribe<PhaseChangedEvent>(logPhaseChange);
+  RobotEvents.subscribe<FaultEvent>(reportFault);
+  RobotEvents.subscribe<BallEvent>(reportBall);
+}
+
+// ENERGY AND BATTERY
+// Each motor counts toward the subsystem given in RobotDescriptor
+EnergyMonitor Energy;          // Energy used per subsystem this match
+BatteryModel BatteryEstimate;  // Battery state of charge and internal resistance
+const uint32_t ENERGY_PERIOD_MS = 20;       // Same as the driver control loop
+const uint32_t TELEMETRY_PERIOD_MS = 500;   // Serial record + Brain screen refresh
+const uint32_t BATTERY_SAVE_PERIOD_MS = 10000;
+const char* BATTERY_FILE = "battery.dat";   // Battery model saved on the SD card between matches
+
+/**
+ * Load the saved battery model from the SD card (or start fresh if there is none)
+ */
+void loadBatteryState() {
+  BatteryModel::State saved;
+  int32_t bytesRead = 0;
+  if (Brain.SDcard.isInserted()) {
+    bytesRead = Brain.SDcard.loadfile(BATTERY_FILE, reinterpret_cast<uint8_t*>(&saved), sizeof(saved));
+  }
+  if (bytesRead == static_cast<int32_t>(sizeof(saved))) {
+    BatteryEstimate.restore(saved, Brain.Battery.capacity());
+  } else {
+    BatteryEstimate = BatteryModel(Brain.Battery.capacity());
+  }
+}
+
+/**
+ * Save the battery model to the SD card
+ */
+void saveBatteryState() {
+  if (!Brain.SDcard.isInserted()) {
+    return;
+  }
+  BatteryModel::State state = BatteryEstimate.getState();
+  Brain.SDcard.savefile(BATTERY_FILE, reinterpret_cast<uint8_t*>(&state), sizeof(state));
+}
+
+/**
+ * Publish a fault when a motor crosses the temperature limits or is unplugged/plugged in
+ * (and derate a hot motor's torque until it cools)
+ * 
+ * @param motor AllMotors index
+ * @param now Current time (ms)
+ */
+void publishMotorFaults(int motor, uint32_t now) {
+  static bool unplugged[MOTOR_COUNT] = {false};
+  
+  bool installed = AllMotors[motor]->installed();
+  if (installed == unplugged[motor]) {
+    unplugged[motor] = !installed;
+    RobotEvents.publish(FaultEvent{installed ? FaultEvent::MOTOR_PLUGGED_IN : FaultEvent::MOTOR_UNPLUGGED, motor, now});
+  }
+  
+  double temperature = AllMotors[motor]->temperature(celsius);
+  if (!MotorHot[motor] && temperature >= MOTOR_HOT_CELSIUS) {
+    MotorHot[motor] = true;
+    applyTorqueLimit(motor);
+    RobotEvents.publish(FaultEvent{FaultEvent::MOTOR_HOT, motor, now});
+  } else if (MotorHot[motor] && temperature < MOTOR_COOL_CELSIUS) {
+    MotorHot[motor] = false;
+    applyTorqueLimit(motor);
+    RobotEvents.publish(FaultEvent{FaultEvent::MOTOR_COOLED, motor, now});
+  }
+}
+
+/**
+ * ENERGY TASK
+ * Runs in the background for the whole program.
+ * Every 20 ms: integrates each motor's electrical power into its subsystem and
+ * updates the battery model. Every 500 ms: prints a telemetry record over serial
+ * and refreshes the Brain screen dashboard.
+ */
+int energyTask() {
+  uint32_t lastTick = timer::system();
+  uint32_t lastReport = lastTick;
+  uint32_t lastSave = lastTick;
+  char line[96];
+  char motorLine[256];  // One column group per motor
+  
+  // Column names for the MOTORS records, from the robot description
+  Telemetry::formatMotorLayout(motorLine, sizeof(motorLine));
+  printf("%s\n", motorLine);
+  
+  while (true) {
+    wait(ENERGY_PERIOD_MS, msec);
+    uint32_t now = timer::system();
+    double dtSeconds = (now - lastTick) / 1000.0;  // Real elapsed time, not the nominal 20 ms
+    lastTick = now;
+    
+    for (int i = 0; i < MOTOR_COUNT; i++) {
+      Energy.addMotorSample(RobotDescriptor::energySubsystem(i), AllMotors[i]->voltage(volt), AllMotors[i]->current(amp));
+      publishMotorFaults(i, now);
+    }
+    Energy.endTick(dtSeconds);
+    BatteryEstimate.update(Brain.Battery.voltage(volt), Brain.Battery.current(amp), dtSeconds);
+    
+    if (now - lastReport >= TELEMETRY_PERIOD_MS) {
+      lastReport = now;
+      
+      // Telemetry: one CSV record over serial
+      Telemetry::formatEnergyRecord(line, sizeof(line), now, Energy, BatteryEstimate);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "input", InputLatency);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "actuation_skew", ActuationSkew);
+      printf("%s\n", line);
+      Telemetry::formatLatencyRecord(line, sizeof(line), now, "scheduler", SchedulerOverhead);
+      printf("%s\n", line);
+      
+      // Per-motor speed, current and temperature
+      MotorSpeeds speeds;
+      PublishedMotorSpeeds.read(speeds);
+      double amps[MOTOR_COUNT];
+      double celsiusReadings[MOTOR_COUNT];
+      for (int i = 0; i < MOTOR_COUNT; i++) {
+        amps[i] = AllMotors[i]->current(amp);
+        celsiusReadings[i] = AllMotors[i]->temperature(celsius);
+      }
+      Telemetry::formatMotorRecord(motorLine, sizeof(motorLine), now, speeds.rpm, amps, celsiusReadings);
+      printf("%s\n", motorLine);
+      
+      // Dashboard: energy split on row 1, battery on row 2 of the Brain screen
+      Telemetry::formatEnergyDashboard(line, sizeof(line), Energy);
+      Brain.Screen.clearLine(1);
+      Brain.Screen.setCursor(1, 1);
+      Brain.Screen.print("%s", line);
+      Telemetry::formatBatteryDashboard(line, sizeof(line), BatteryEstimate);
+      Brain.Screen.clearLine(2);
+      Brain.Screen.setCursor(2, 1);
+      Brain.Screen.print("%s", line);
+    }
+    
+    if (now - lastSave >= BATTERY_SAVE_PERIOD_MS) {
+      lastSave = now;
+      saveBatteryState();
+    }
+  }
+  return 0;
+}
+
+// MATCH CLOCK AND ENDGAME RULES
+MatchClock Match;               // Current phase and time left, updated by matchClockTask()
+MatchRuleEngine EndgameRules;   // Timed behaviors, checked every driver control tick
+const uint32_t MATCH_CLOCK_PERIOD_MS = 10;
+
+// Where the pistons really are: a new height takes a few hundred ms to reach
+PistonTravel HeightTravel;
+// Full power wheel speed and feed rate for the current height (see ScoringProfile::PROFILES)
+ScoringProfile Scoring(RobotDescriptor::maxRpm(ActuationFrame::FULL_POWER_RAMP));
+
+// BALL COUNT
+// The intake and ramp motors' current bump and speed dip count the balls in the robot
+// (no sensor needed - see BallDetector). The intake stops by itself when the robot is full;
+// pressing R1 again runs it anyway (the count is only approximate).
+BallDetector Balls;
+const int PRELOAD_BALLS = 0;  // Balls in the robot at the start of the match
+
+/**
+ * Feed this tick's intake and ramp readings to the ball detector and publish what it saw
+ * 
+ * @param frame Commands written this tick (direction of each motor)
+ * @param speeds Latest motor speeds
+ */
+void countBalls(const ActuationFrame& frame, const MotorSpeeds& speeds, uint32_t nowMs) {
+  bool wheelFeeding = Scoring.isReady();
+  Balls.setWheelFeeding(wheelFeeding);
+  int intakeCommand = frame.getMotor(ActuationFrame::INTAKE);
+  int rampCommand = frame.getMotor(ActuationFrame::RAMP);
+  if (Balls.update(BallDetector::INTAKE, IntakeMotor.current(amp), speeds.rpm[ActuationFrame::INTAKE],
+                   intakeCommand, nowMs)) {
+    BallEvent::Type type = (intakeCommand > 0) ? BallEvent::GRABBED : BallEvent::SPAT_OUT;
+    RobotEvents.publish(BallEvent{type, Balls.getCount(), nowMs});
+  }
+  if (Balls.update(BallDetector::RAMP, RampMotor.current(amp), speeds.rpm[ActuationFrame::RAMP],
+                   rampCommand, nowMs) && wheelFeeding && rampCommand > 0) {
+    RobotEvents.publish(BallEvent{BallEvent::SCORED, Balls.getCount(), nowMs});  // Hand-offs aren't events
+  }
+}
+
+// DRIVE BALANCE
+// Each side's three motors get their own share of the side command instead of the same
+// power: effort moves away from a slipping wheel, the motor drawing the most current and
+// the hottest motor (see DriveBalancer). Set to false to send all three the same power.
+const bool BALANCE_DRIVE = true;
+DriveBalancer DriveBalance;
+static_assert(DRIVE_MOTORS_PER_SIDE == DriveBalancer::MOTORS_PER_SIDE, "DriveBalancer splits three motors per side");
+
+/**
+ * Replace the staged side commands with per-motor powers
+ * 
+ * @param frame Commands staged this tick (drive powers are rewritten)
+ * @param speeds Latest motor speeds
+ */
+void balanceDrive(ActuationFrame& frame, const MotorSpeeds& speeds, uint32_t nowMs) {
+  static uint32_t lastMs = nowMs;
+  double dtSeconds = (nowMs - lastMs) / 1000.0;
+  lastMs = nowMs;
+  if (!BALANCE_DRIVE) {
+    return;
+  }
+  
+  const RobotDescriptor::Side sides[] = {RobotDescriptor::LEFT, RobotDescriptor::RIGHT};
+  const DriveBalancer::Side balancerSides[] = {DriveBalancer::LEFT, DriveBalancer::RIGHT};
+  for (int s = 0; s < 2; s++) {
+    ActuationFrame::Motor ids[DriveBalancer::MOTORS_PER_SIDE];
+    DriveBalancer::MotorReading readings[DriveBalancer::MOTORS_PER_SIDE];
+    for (int i = 0; i < DriveBalancer::MOTORS_PER_SIDE; i++) {
+      ids[i] = (ActuationFrame::Motor)RobotDescriptor::sideMotor(sides[s], i);
+      double amps = AllMotors[ids[i]]->current(amp);  // Always positive: sign it like the command
+      readings[i].currentA = (frame.getMotor(ids[i]) < 0) ? -amps : amps;
+      readings[i].temperatureC = AllMotors[ids[i]]->temperature(celsius);
+      readings[i].rpm = speeds.rpm[ids[i]];
+    }
+    
+    int powers[DriveBalancer::MOTORS_PER_SIDE];
+    DriveBalance.update(balancerSides[s], frame.getMotor(ids[0]), readings, dtSeconds, powers);
+    for (int i = 0; i < DriveBalancer::MOTORS_PER_SIDE; i++) {
+      frame.setMotor(ids[i], powers[i]);
+    }
+  }
+}
+
+/**
+ * Move both pistons to a height and remember it
+ * 
+ * @param position LOW or HIGH
+ */
+void setHeight(PneumaticController::HeightPosition position) {
+  Phases.getState().height = position;
+  
+  // Calculate piston state (true = extended, false = retracted)
+  bool pistonState = PneumaticController::calculatePistonState(position);
+  
+  // Set both pistons to the same state
+  Piston1.set(pistonState);
+  Piston2.set(pistonState);
+  HeightTravel.update(position, timer::system());
+}
+
+/**
+ * Advance the piston travel model (the switch confirms and calibrates full extends)
+ */
+void trackHeight(uint32_t nowMs) {
+  HeightTravel.update(Phases.getState().height, nowMs);
+  if (HEIGHT_SWITCH_INSTALLED && HeightSwitch.pressing()) {
+    int calibrations = HeightTravel.getCalibrationCount();
+    HeightTravel.confirm(PneumaticController::HIGH, nowMs);
+    if (HeightTravel.getCalibrationCount() != calibrations) {
+      printf("PISTON_TRAVEL,extend_ms=%.0f,retract_ms=%.0f\n",
+             HeightTravel.getTravelMs(PneumaticController::HIGH), HeightTravel.getTravelMs(PneumaticController::LOW));
+    }
+  }
+}
+
+/**
+ * Timed behaviors for the end of driver control
+ * Adjust times here (milliseconds LEFT in the period).
+ */
+void setupMatchRules() {
+  EndgameRules.addRule(MatchClock::DRIVER, 30000, MatchRuleEngine::RUMBLE_DRIVER);    // 30 s warning
+  EndgameRules.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RUMBLE_DRIVER);    // 15 s warning
+  EndgameRules.addRule(MatchClock::DRIVER, 15000, MatchRuleEngine::RELAX_LIMITS);     // Full torque for the final push, even hot
+  EndgameRules.addRule(MatchClock::DRIVER, 10000, MatchRuleEngine::SET_HEIGHT_HIGH);  // Endgame scoring height
+}
+
+/**
+ * Carry out the actions the rule engine says are due (usercontrol() tick)
+ * Height actions only change the commanded height; the pistons move when the frame is written.
+ * 
+ * @param due Bit mask from EndgameRules.update(), plus whatever was held back last tick
+ * @param heightBusy true while something else owns the height (tip recovery)
+ * @return Height actions held back because of heightBusy (pass them in again next tick)
+ */
+uint32_t applyMatchActions(uint32_t due, bool heightBusy) {
+  uint32_t heightActions = MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH) |
+                           MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_LOW);
+  uint32_t held = heightBusy ? (due & heightActions) : 0;
+  due &= ~held;
+  
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::RELAX_LIMITS)) {
+    TorqueDeratingOff = true;
+    applyTorqueLimits();
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_HIGH)) {
+    Phases.getState().height = PneumaticController::HIGH;
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::SET_HEIGHT_LOW)) {
+    Phases.getState().height = PneumaticController::LOW;
+  }
+  if (due & MatchRuleEngine::actionBit(MatchRuleEngine::RUMBLE_DRIVER)) {
+    Controller1.rumble("--");
+  }
+  return held;
+}
+
+// PHASE HOOKS AND DRIVER HANDOFF
+const uint32_t HANDOFF_WINDOW_MS = 500;  // Start preparing the handoff this close to the end of autonomous
+const int DRIVE_DEADBAND = 5;            // Stick deadband (percent)
+
+// D-pad quick turns, run from usercontrol() (see HeadingSnap)
+HeadingSnap QuickTurn;
+
+// Wall squaring: squareToWall() in autonomous, B button macro in usercontrol() (see WallSquare)
+WallSquare WallAlign;
+const uint32_t WALL_SQUARE_PERIOD_MS = 10;
+
+/**
+ * Average current (amps) and speed (rpm) of each drive side
+ * Speeds come from motorVelocityTask()
+ */
+void readDriveSides(double& leftCurrent, double& leftRpm, double& rightCurrent, double& rightRpm) {
+  MotorSpeeds speeds;
+  PublishedMotorSpeeds.read(speeds);
+  leftCurrent = 0.0;
+  leftRpm = 0.0;
+  rightCurrent = 0.0;
+  rightRpm = 0.0;
+  for (int i = 0; i < DRIVE_MOTORS_PER_SIDE; i++) {
+    int left = RobotDescriptor::sideMotor(RobotDescriptor::LEFT, i);
+    int right = RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, i);
+    leftCurrent += AllMotors[left]->current(amp) / DRIVE_MOTORS_PER_SIDE;
+    leftRpm += speeds.rpm[left] / DRIVE_MOTORS_PER_SIDE;
+    rightCurrent += AllMotors[right]->current(amp) / DRIVE_MOTORS_PER_SIDE;
+    rightRpm += speeds.rpm[right] / DRIVE_MOTORS_PER_SIDE;
+  }
+}
+
+// GROUND-SPEED-MATCHED INTAKE
+// Intake forward runs the roller's surface a little faster than the robot drives (see
+// IntakeController::calculateGroundMatchedPower()) instead of always at 100%: a ball the
+// robot drives onto is pulled in instead of bouncing off, and the roller idles slowly
+// while the robot stands still. The motor's velocity control holds the speed.
+const bool INTAKE_MATCH_GROUND_SPEED = true;  // false = intake always at 100%
+const double INTAKE_ROLLER_DIAMETER = 2.5;    // Inches - adjust to match your robot
+const double INTAKE_GEAR_RATIO = 3.0;         // Roller turns per motor turn
+const double INTAKE_OVERSPEED = IntakeController::DEFAULT_OVERSPEED;  // 0.2 = roller 20% faster than the ground
+
+/**
+ * Intake motor power for a state, matched to the robot's forward speed
+ * Speeds come from motorVelocityTask()
+ */
+int intakePower(IntakeController::MotorState state) {
+  if (!INTAKE_MATCH_GROUND_SPEED) {
+    return IntakeController::calculateIntakePower(state, 100);
+  }
+  MotorSpeeds speeds;
+  PublishedMotorSpeeds.read(speeds);
+  double driveRpm = 0.0;
+  for (int i = 0; i < DRIVE_MOTORS_PER_SIDE; i++) {
+    driveRpm += speeds.rpm[RobotDescriptor::sideMotor(RobotDescriptor::LEFT, i)] / (2 * DRIVE_MOTORS_PER_SIDE);
+    driveRpm += speeds.rpm[RobotDescriptor::sideMotor(RobotDescriptor::RIGHT, i)] / (2 * DRIVE_MOTORS_PER_SIDE);
+  }
+  double groundSpeed = IntakeController::surfaceSpeed(driveRpm, DRIVE_WHEEL_DIAMETER, DRIVE_GEAR_RATIO);
+  double maxSurfaceSpeed = IntakeController::surfaceSpeed(RobotDescriptor::maxRpm(ActuationFrame::INTAKE),
+                                                          INTAKE_ROLLER_DIAMETER, INTAKE_GEAR_RATIO);
+  return IntakeController::calculateGroundMatchedPower(state, groundSpeed, maxSurfaceSpeed, INTAKE_OVERSPEED);
+}
+
+/**
+ * One wall squaring step; once squared, corrects the gyro to the wall's heading
+ * 
+ * @param leftPower Output: left drive power
+ * @param rightPower Output: right drive power
+ * @return Status after this step
+ */
+WallSquare::Status stepWallSquare(int& leftPower, int& rightPower) {
+  double leftCurrent, leftRpm, rightCurrent, rightRpm;
+  readDriveSides(leftCurrent, leftRpm, rightCurrent, rightRpm);
+  WallSquare::Status status = WallAlign.update(leftCurrent, leftRpm, rightCurrent, rightRpm,
+                                               Inertial.heading(), timer::system(), leftPower, rightPower);
+  if (status == WallSquare::SQUARED) {
+    Inertial.setHeading(WallAlign.getAlignedHeading(), degrees);
+  }
+  return status;
+}
+
+/**
+ * Square up against a wall (autonomous - waits until done)
+ * 
+ * @param direction 1 = drive forward into the wall, -1 = backward
+ * @return true if both sides touched (gyro corrected), false on timeout
+ */
+bool squareToWall(int direction) {
+  WallAlign.start(direction, timer::system());
+  int leftPower, rightPower;
+  while (stepWallSquare(leftPower, rightPower) == WallSquare::APPROACH) {
+    LeftDrive.spin(forward, leftPower, percent);
+    RightDrive.spin(forward, rightPower, percent);
+    wait(WALL_SQUARE_PERIOD_MS, msec);
+  }
+  LeftDrive.stop();
+  RightDrive.stop();
+  return WallAlign.getStatus() == WallSquare::SQUARED;
+}
+
+/**
+ * Stop every motor (coast)
+ */
+void stopAllMotors() {
+  for (int i = 0; i < MOTOR_COUNT; i++) {
+    AllMotors[i]->stop();
+  }
+}
+
+/**
+ * Start of autonomous: known state, new match for energy and battery tracking
+ */
+void enterAutonomous() {
+  Phases.getState() = PhaseManager::defaultState();
+  setHeight(PneumaticController::LOW);
+  Balls.reset(PRELOAD_BALLS);
+  
+  // New match: start the energy totals over and count the match on this battery
+  Energy.reset();
+  BatteryEstimate.startMatch();
+}
+
+/**
+ * End of any active phase: nothing keeps running on an old command
+ */
+void exitActivePhase() {
+  QuickTurn.cancel();
+  WallAlign.cancel();
+  stopAllMotors();
+}
+
+/**
+ * Start of driver control: apply the handoff prepared at the end of autonomous
+ * If it is fresh, the drive and rollers already run the driver's commands before the
+ * first usercontrol() tick. Otherwise only the button state is carried over.
+ */
+void enterDriver() {
+  PhaseManager::DriverHandoff handoff;
+  if (!Phases.hasHandoff()) {
+    return;
+  }
+  if (Phases.takeHandoff(timer::system(), handoff)) {
+    LeftDrive.spin(forward, handoff.leftPower, percent);
+    RightDrive.spin(forward, handoff.rightPower, percent);
+    IntakeController::MotorState intakeState = IntakeController::limitToCapacity(handoff.intakeState, Balls.isFull());
+    IntakeMotor.spin(forward, intakePower(intakeState), percent);
+    // The ramp and top wheel wait for the first tick: they go through Scoring, which
+    // holds the feed until the wheel is up to speed at a settled height
+  }
+}
+
+/**
+ * Register the enter/exit hooks for each phase
+ */
+void setupPhaseHooks() {
+  Phases.setHooks(MatchClock::DISABLED, stopAllMotors, nullptr);
+  Phases.setHooks(MatchClock::AUTONOMOUS, enterAutonomous, exitActivePhase);
+  Phases.setHooks(MatchClock::DRIVER, enterDriver, exitActivePhase);
+}
+
+/**
+ * Read the controller into a driver handoff (same mapping as usercontrol())
+ */
+PhaseManager::DriverHandoff readDriverHandoff() {
+  PhaseManager::DriverHandoff handoff;
+  int leftStickInput = DriveTrain::applyDeadband(Controller1.Axis3.position(), DRIVE_DEADBAND);
+  int rightStickInput = DriveTrain::applyDeadband(Controller1.Axis2.position(), DRIVE_DEADBAND);
+  DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, handoff.leftPower, handoff.rightPower);
+  
+  handoff.intakeState = IntakeController::STOP;
+  if (Controller1.ButtonR1.pressing()) {
+    handoff.intakeState = IntakeController::FORWARD;
+  } else if (Controller1.ButtonR2.pressing()) {
+    handoff.intakeState = IntakeController::REVERSE;
+  }
+  handoff.rampState = IntakeController::STOP;
+  if (Controller1.ButtonL1.pressing()) {
+    handoff.rampState = IntakeController::FORWARD;
+  } else if (Controller1.ButtonL2.pressing()) {
+    handoff.rampState = IntakeController::REVERSE;
+  }
+  handoff.fullPowerState = RampController::STOP;
+  if (Controller1.ButtonX.pressing()) {
+    handoff.fullPowerState = RampController::FORWARD;
+  } else if (Controller1.ButtonY.pressing()) {
+    handoff.fullPowerState = RampController::REVERSE;
+  }
+  handoff.toggleButtonHeld = Controller1.ButtonA.pressing();
+  handoff.ready = true;
+  handoff.preparedAtMs = timer::system();
+  return handoff;
+}
+
+/**
+ * MATCH CLOCK TASK
+ * Runs in the background for the whole program.
+ * Watches the competition state and timestamps every change, so the rest of the
+ * code can ask how much time is left in the period. Also runs the phase hooks.
+ */
+int matchClockTask() {
+  MatchClock::Phase lastPhase = MatchClock::DISABLED;
+  while (true) {
+    MatchClock::Phase phase = MatchClock::phaseFromFlags(Competition.isEnabled(), Competition.isAutonomous());
+    if (Match.update(phase, timer::system())) {
+      RobotEvents.publish(PhaseChangedEvent{lastPhase, phase, timer::system()});
+      lastPhase = phase;
+      
+      // New period: arm its rules and go back to normal limits
+      EndgameRules.startPhase(phase);
+      TorqueDeratingOff = false;
+      applyTorqueLimits();
+      Phases.transition(phase);
+    }
+    
+    // Keep the driver handoff fresh during the last moments of autonomous
+    uint32_t now = timer::system();
+    if (phase == MatchClock::AUTONOMOUS && Match.getRemainingMs(now) <= HANDOFF_WINDOW_MS) {
+      Phases.prepareHandoff(readDriverHandoff());
+    }
+    wait(MATCH_CLOCK_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+// TIP AND COLLISION DETECTION
+// Only tipTask() touches TipGuard. Other tasks read what it publishes: the tipping state
+// from PublishedTipState, tips and collisions from TipEvents (autonomous task only).
+TipDetector TipGuard;                 // Drops to LOW height when tipping starts
+const uint32_t TIP_PERIOD_MS = 5;     // Faster than the inertial sensor, so no reading is missed
+
+// Tipping state, published by tipTask() for the task that owns the drive
+struct TipState {
+  bool tipping;
+  bool dropHeight;       // Drop to LOW height
+  int correctionPower;   // Drive power for both sides while tipping
+};
+SeqLock<TipState> PublishedTipState;
+
+// Tips and collisions, from tipTask() to the autonomous task (newest dropped when full)
+SpscQueue<TipDetector::Event, TipDetector::EVENT_CAPACITY> TipEvents;
+
+/**
+ * TIP TASK
+ * Runs in the background for the whole program.
+ * Feeds every inertial reading to TipGuard and publishes what it finds. Detection only: the
+ * task that owns the drive corrects (usercontrol() schedules TipRecovery, the autonomous
+ * loops call recoverFromTip()).
+ */
+int tipTask() {
+  while (true) {
+    TipGuard.update(Inertial.timestamp(), Inertial.pitch(), Inertial.roll(),
+                    Inertial.acceleration(xaxis), Inertial.acceleration(yaxis));
+    
+    TipDetector::Event event;
+    while (TipGuard.pollEvent(event)) {
+      TipEvents.push(event);
+    }
+    TipState state = {TipGuard.isTipping(), TipGuard.shouldDropHeight(), TipGuard.getCorrectionPower()};
+    PublishedTipState.write(state);
+    wait(TIP_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+/**
+ * Tip recovery for the autonomous drive loops: while tipping, drive toward the side going
+ * down and drop to LOW height
+ * 
+ * @param leftPower In: the loop's drive power. Out: the correction while tipping
+ * @param rightPower Same for the right side
+ * @return true while tipping
+ */
+bool recoverFromTip(int& leftPower, int& rightPower) {
+  TipState tip;
+  PublishedTipState.read(tip);
+  if (!tip.tipping) {
+    return false;
+  }
+  if (tip.dropHeight && Phases.getState().height == PneumaticController::HIGH) {
+    setHeight(PneumaticController::LOW);
+  }
+  leftPower = tip.correctionPower;
+  rightPower = leftPower;
+  return true;
+}
+
+/**
+ * Wait, but stop early if the robot hits something (for autonomous)
+ * 
+ * @param timeMs Longest time to wait
+ * @return true if a collision ended the wait
+ */
+bool waitUnlessCollision(uint32_t timeMs) {
+  uint32_t start = timer::system();
+  TipDetector::Event event;
+  while (timer::system() - start < timeMs) {
+    dispatchEvents();  // Autonomous control tick boundary
+    while (TipEvents.pop(event)) {
+      if (event.type == TipDetector::COLLISION) {
+        return true;
+      }
+    }
+    wait(TIP_PERIOD_MS, msec);
+  }
+  return false;
+}
+
+// AUTONOMOUS SCHEDULE
+// autonomous() runs its steps through AutonSchedule: in order while on time; when running
+// late, the steps worth the most points that still fit first. Routines that run a step
+// check keepAutonStep() every tick and stop when it returns false.
+AutonSchedule Auton;
+
+/**
+ * Should the autonomous step being run keep going? (always true outside a step)
+ */
+bool keepAutonStep() {
+  return Auton.update(timer::system());
+}
+
+// AUTONOMOUS ROUTES
+// followRoute() drives the waypoints in Route from the localization pose. If something
+// blocks the way (no progress while driving, or a collision from tipTask()), it backs off
+// and plans a detour on a coarse field grid, a little each tick (see RouteFollower).
+RouteFollower Route;
+const uint32_t ROUTE_PERIOD_MS = 10;  // Same as localization
+
+/**
+ * Drive the route in Route (add its waypoints first)
+ * 
+ * @param timeoutMs Give up after this long
+ * @return true if the last waypoint was reached
+ */
+bool followRoute(uint32_t timeoutMs) {
+  Route.start(timer::system(), timeoutMs);
+  while (Route.isRunning()) {
+    if (!keepAutonStep()) {
+      Route.cancel();
+      break;
+    }
+    dispatchEvents();  // Autonomous control tick boundary
+    TipDetector::Event event;
+    while (TipEvents.pop(event)) {
+      if (event.type == TipDetector::COLLISION) {
+        Route.notifyCollision(timer::system());
+      }
+    }
+    
+    Odometry::Pose pose;
+    RobotPose.read(pose);
+    int leftPower;
+    int rightPower;
+    Route.update(pose, timer::system(), leftPower, rightPower);
+    recoverFromTip(leftPower, rightPower);
+    LeftDrive.spin(forward, leftPower, percent);
+    RightDrive.spin(forward, rightPower, percent);
+    wait(ROUTE_PERIOD_MS, msec);
+  }
+  LeftDrive.stop();
+  RightDrive.stop();
+  
+  if (Route.getReplanCount() > 0) {
+    printf("ROUTE,replans=%d,max_expansions=%d,done=%d\n", Route.getReplanCount(),
+           Route.getMaxTickExpansions(), Route.getStatus() == RouteFollower::DONE);
+  }
+  return Route.getStatus() == RouteFollower::DONE;
+}
+
+// VISION BALL PICKUP
+// pickUpBall() in autonomous: drive to the nearest ball of our color and intake it,
+// wherever it has rolled to
+VisionTracker BallTracker(BALL_SIGNATURE_ID);
+BallPursuit Pursuit;
+const uint32_t VISION_PERIOD_MS = 20;  // Vision sensor frame rate (50 Hz)
+
+/**
+ * Take one vision snapshot and update the tracker
+ */
+void readVisionFrame() {
+  VisionTracker::Detection detections[VisionTracker::MAX_DETECTIONS];
+  int count = Vision.takeSnapshot(BALL_SIGNATURE);
+  if (count > VisionTracker::MAX_DETECTIONS) {
+    count = VisionTracker::MAX_DETECTIONS;
+  }
+  for (int i = 0; i < count; i++) {
+    detections[i].centerX = Vision.objects[i].centerX;
+    detections[i].centerY = Vision.objects[i].centerY;
+    detections[i].width = Vision.objects[i].width;
+    detections[i].height = Vision.objects[i].height;
+    detections[i].signature = BALL_SIGNATURE_ID;
+  }
+  BallTracker.update(detections, count);
+}
+
+/**
+ * Drive to the nearest ball the vision sensor can see and pick it up
+ * 
+ * @param timeoutMs Give up after this long
+ * @return true if a ball was picked up
+ */
+bool pickUpBall(uint32_t timeoutMs) {
+  if (!Vision.installed() || Balls.isFull()) {
+    return false;
+  }
+  BallTracker.reset();
+  Pursuit.start(timer::system(), timeoutMs);
+  int grabsBefore = Balls.getDetectionCount(BallDetector::INTAKE);
+  
+  while (Pursuit.isRunning()) {
+    if (!keepAutonStep()) {
+      Pursuit.cancel();
+      LeftDrive.stop();
+      RightDrive.stop();
+      IntakeMotor.stop();
+      break;
+    }
+    dispatchEvents();  // Autonomous control tick boundary
+    readVisionFrame();
+    
+    int leftPower;
+    int rightPower;
+    IntakeController::MotorState intakeState;
+    bool ballGrabbed = Balls.getDetectionCount(BallDetector::INTAKE) != grabsBefore;
+    Pursuit.update(BallTracker, ballGrabbed, timer::system(), leftPower, rightPower, intakeState);
+    recoverFromTip(leftPower, rightPower);
+    
+    ActuationFrame frame;
+    frame.setDrive(leftPower, rightPower);
+    frame.setMotor(ActuationFrame::INTAKE, intakePower(intakeState));
+    frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+    frame.apply(writeFrameMotor, writeFramePiston);
+    
+    // The intake's current signature tells us when the ball is in
+    MotorSpeeds speeds;
+    PublishedMotorSpeeds.read(speeds);
+    countBalls(frame, speeds, timer::system());
+    wait(VISION_PERIOD_MS, msec);
+  }
+  return Pursuit.getStatus() == BallPursuit::DONE;
+}
+
+// GOAL AUTO-AIM
+// Holding X (score) with the goal in view turns the robot to face it before the first ball
+// is fed (see GoalAim). Set AUTO_AIM_ON_SCORE to false to aim by eye.
+const bool AUTO_AIM_ON_SCORE = true;
+GoalAim Aim(GOAL_SIGNATURE_ID);
+uint32_t LastGoalFrameMs = 0;
+
+/**
+ * Take one vision snapshot of the goal color (at most one per VISION_PERIOD_MS)
+ * Gyro headings are added every driver tick; the frame is matched to the heading
+ * the robot had when the camera took it.
+ */
+void readGoalFrame(uint32_t nowMs) {
+  if (!Vision.installed() || nowMs - LastGoalFrameMs < VISION_PERIOD_MS) {
+    return;
+  }
+  LastGoalFrameMs = nowMs;
+  VisionTracker::Detection detections[VisionTracker::MAX_DETECTIONS];
+  int count = Vision.takeSnapshot(GOAL_SIGNATURE);
+  if (count > VisionTracker::MAX_DETECTIONS) {
+    count = VisionTracker::MAX_DETECTIONS;
+  }
+  for (int i = 0; i < count; i++) {
+    detections[i].centerX = Vision.objects[i].centerX;
+    detections[i].centerY = Vision.objects[i].centerY;
+    detections[i].width = Vision.objects[i].width;
+    detections[i].height = Vision.objects[i].height;
+    detections[i].signature = GOAL_SIGNATURE_ID;
+  }
+  Aim.addGoalFrame(detections, count, nowMs);
+}
+
+// COMMANDS
+// Driver control is built from commands (see CommandScheduler). Each subsystem has a default
+// command that follows the controller; the quick turn and wall squaring macros and tip
+// recovery take the subsystems they need and give them back when they finish.
+CommandScheduler Commands;
+
+// What the current usercontrol() tick sensed, read by the commands
+InputSampler::Snapshot DriverInput;
+double DriverHeading = 0.0;
+uint32_t DriverTickMs = 0;
+
+/**
+ * Drive default: tank drive from the sticks
+ */
+void driveWithSticks(ActuationFrame& frame) {
+  // OPTION 1: TANK DRIVE
+  // Driver uses left stick for left motors, right stick for right motors
+  // This is like a tank - each side moves independently
+  
+  // Read controller stick values (-100 to +100)
+  int leftStickInput = DriverInput.axis(InputSampler::AXIS_3);   // Left stick vertical axis (Y)
+  int rightStickInput = DriverInput.axis(InputSampler::AXIS_2);  // Right stick vertical axis (Y)
+  // Note: Axis3 = Left stick Y, Axis2 = Right stick Y
+  // If this doesn't work, try Axis4 for right stick instead of Axis2
+  
+  // Apply deadband to prevent drift (removes small unwanted movements)
+  leftStickInput = DriveTrain::applyDeadband(leftStickInput, DRIVE_DEADBAND);
+  rightStickInput = DriveTrain::applyDeadband(rightStickInput, DRIVE_DEADBAND);
+  
+  // Calculate motor powers using our testable DriveTrain class
+  int leftPower, rightPower;
+  DriveTrain::calculateTankDrive(leftStickInput, rightStickInput, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+  
+  // OPTION 2: ARCADE DRIVE (COMMENTED OUT - UNCOMMENT TO USE, and remove option 1)
+  // Driver uses one stick: forward/backward controls speed, left/right controls turning
+  // This is more like a car - more intuitive for some drivers
+  
+  /*
+  // Read controller input
+  int forwardInput = DriverInput.axis(InputSampler::AXIS_3);    // Forward/backward
+  int turnInput = DriverInput.axis(InputSampler::AXIS_1);       // Left/right turning
+  
+  // Apply deadband to prevent drift
+  forwardInput = DriveTrain::applyDeadband(forwardInput, 5);
+  turnInput = DriveTrain::applyDeadband(turnInput, 5);
+  
+  // Calculate left and right motor powers using our testable DriveTrain class
+  int leftPowerArcade, rightPowerArcade;
+  DriveTrain::calculateArcadeDrive(forwardInput, turnInput, leftPowerArcade, rightPowerArcade);
+  
+  // Stage motor speeds (clamping is handled inside calculateArcadeDrive!)
+  frame.setDrive(leftPowerArcade, rightPowerArcade);
+  */
+}
+
+/**
+ * Intake default: R1 = intake forward (collect balls, stops when full), R2 = reverse (spit out)
+ * Pressing R1 again while full runs the intake anyway until R1 is released: the count is
+ * approximate, and the driver can see the robot.
+ */
+void runIntakeButtons(ActuationFrame& frame) {
+  static bool lastIntakeButton = false;
+  static bool fullOverride = false;
+  bool intakeButton = DriverInput.pressed(InputSampler::BUTTON_R1);
+  if (intakeButton && !lastIntakeButton) {
+    fullOverride = Balls.isFull();
+  } else if (!intakeButton) {
+    fullOverride = false;
+  }
+  lastIntakeButton = intakeButton;
+  
+  IntakeController::MotorState intakeState = IntakeController::STOP;
+  if (intakeButton) {
+    intakeState = IntakeController::FORWARD;  // Collect balls
+  } else if (DriverInput.pressed(InputSampler::BUTTON_R2)) {
+    intakeState = IntakeController::REVERSE;  // Spit out
+  }
+  if (!fullOverride) {
+    intakeState = IntakeController::limitToCapacity(intakeState, Balls.isFull());
+  }
+  
+  // Calculate intake motor power using our testable IntakeController (matched to the ground speed)
+  frame.setMotor(ActuationFrame::INTAKE, intakePower(intakeState));
+  Phases.getState().intakeState = intakeState;
+}
+
+/**
+ * Ramp default: L1 = ramp forward (bring balls up), L2 = reverse (bring balls down)
+ */
+void runRampButtons(ActuationFrame& frame) {
+  IntakeController::MotorState rampState = IntakeController::STOP;
+  if (DriverInput.pressed(InputSampler::BUTTON_L1)) {
+    rampState = IntakeController::FORWARD;  // Bring balls up
+  } else if (DriverInput.pressed(InputSampler::BUTTON_L2)) {
+    rampState = IntakeController::REVERSE;  // Bring balls down
+  }
+  
+  // Calculate ramp motor power using our testable IntakeController (100% power)
+  // While the full power wheel spins, balls are fed at its profile's rate once it is ready
+  frame.setMotor(ActuationFrame::RAMP, Scoring.getFeedPower(IntakeController::calculateRampPower(rampState, 100)));
+  Phases.getState().rampState = rampState;
+}
+
+/**
+ * Top wheel default: X = full power forward (push balls out), Y = full power reverse
+ */
+void runTopWheelButtons(ActuationFrame& frame) {
+  RampController::MotorState fullPowerState = RampController::STOP;
+  if (DriverInput.pressed(InputSampler::BUTTON_X)) {
+    fullPowerState = RampController::FORWARD;  // Push balls out
+  } else if (DriverInput.pressed(InputSampler::BUTTON_Y)) {
+    fullPowerState = RampController::REVERSE;  // Pull balls back
+  }
+  
+  // Calculate full power ramp motor power using our testable RampController
+  // Use full power mode (100% when active) for reverse. Forward, and the pre-spin after a
+  // height change, run at the current height's wheel speed (runRampButtons() holds the
+  // feed until the pistons settle and the wheel is up to speed).
+  int fullPower = RampController::calculateRampPower(fullPowerState, true, 0);
+  if (fullPowerState == RampController::REVERSE) {
+    Scoring.stop();
+  } else if (Scoring.isSpinning()) {
+    fullPower = Scoring.getWheelPower();
+  }
+  frame.setMotor(ActuationFrame::FULL_POWER_RAMP, fullPower);
+  Phases.getState().fullPowerState = fullPowerState;
+}
+
+/**
+ * Height default: both pistons follow the current height (A toggles it in usercontrol())
+ */
+void holdHeight(ActuationFrame& frame) {
+  frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+}
+
+/**
+ * Quick turn macro (D-pad): drives until HeadingSnap settles
+ */
+void runQuickTurn(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  QuickTurn.update(DriverHeading, DriverTickMs, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool quickTurnDone() {
+  return !QuickTurn.isActive();
+}
+
+void stopQuickTurn(bool interrupted) {
+  if (interrupted) {
+    QuickTurn.cancel();
+  }
+}
+
+/**
+ * Auto-aim macro (X with the goal in view): turns to the goal; runRampButtons() feeds
+ * once the aim locks
+ */
+void runAutoAim(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  Aim.update(DriverTickMs, leftPower, rightPower);
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool autoAimDone() {
+  return !Aim.isActive();  // Goal lost
+}
+
+void stopAutoAim(bool interrupted) {
+  if (interrupted) {
+    Aim.cancel();
+  }
+}
+
+/**
+ * Wall squaring macro (B): drives into the wall until both sides touch
+ */
+void runWallSquare(ActuationFrame& frame) {
+  int leftPower = 0;
+  int rightPower = 0;
+  if (stepWallSquare(leftPower, rightPower) == WallSquare::SQUARED) {
+    Controller1.rumble(".");  // Squared and gyro corrected
+  }
+  frame.setDrive(leftPower, rightPower);
+}
+
+bool wallSquareDone() {
+  return !WallAlign.isActive();
+}
+
+void stopWallSquare(bool interrupted) {
+  if (interrupted) {
+    WallAlign.cancel();
+  }
+}
+
+/**
+ * Tip recovery: drives toward the side going down at LOW height (tipTask() detects the tip)
+ * Not interruptible - no macro can take the drive until the robot is level again.
+ */
+void runTipRecovery(ActuationFrame& frame) {
+  TipState tip;
+  PublishedTipState.read(tip);
+  if (tip.dropHeight) {
+    Phases.getState().height = PneumaticController::LOW;
+  }
+  frame.setDrive(tip.correctionPower, tip.correctionPower);
+  frame.setPistons(PneumaticController::calculatePistonState(Phases.getState().height));
+}
+
+bool tipRecovered() {
+  TipState tip;
+  PublishedTipState.read(tip);
+  return !tip.tipping;
+}
+
+// Defaults (one per subsystem)
+FunctionCommand DriveWithSticks(Command::DRIVE, driveWithSticks);
+FunctionCommand IntakeButtons(Command::INTAKE, runIntakeButtons);
+FunctionCommand RampButtons(Command::RAMP, runRampButtons);
+FunctionCommand TopWheelButtons(Command::TOP_WHEEL, runTopWheelButtons);
+FunctionCommand HoldHeight(Command::HEIGHT, holdHeight);
+
+// Macros and failsafes
+FunctionCommand QuickTurnCommand(Command::DRIVE, runQuickTurn, quickTurnDone, nullptr, stopQuickTurn);
+FunctionCommand WallSquareCommand(Command::DRIVE, runWallSquare, wallSquareDone, nullptr, stopWallSquare);
+FunctionCommand AutoAimCommand(Command::DRIVE, runAutoAim, autoAimDone, nullptr, stopAutoAim);
+FunctionCommand TipRecovery(Command::DRIVE | Command::HEIGHT, runTipRecovery, tipRecovered,
+                            nullptr, nullptr, false);
+
+/**
+ * Register the default command of each subsystem
+ */
+void setupCommands() {
+  Commands.setDefaultCommand(Command::DRIVE, &DriveWithSticks);
+  Commands.setDefaultCommand(Command::INTAKE, &IntakeButtons);
+  Commands.setDefaultCommand(Command::RAMP, &RampButtons);
+  Commands.setDefaultCommand(Command::TOP_WHEEL, &TopWheelButtons);
+  Commands.setDefaultCommand(Command::HEIGHT, &HoldHeight);
+}
+
+// ACTUATION LATENCY PROBE
+// Measurement mode: set ACTUATION_PROBE_MODE to true, put the robot on a stand (wheels off
+// the ground) and run the program. Each motor type gets PROBE_TRIALS step commands, timed
+// from the command to the first encoder movement (see ActuationProbe). Results are printed
+// as LATENCY records plus one MOTOR_MODEL line per motor for the simulator.
+const bool ACTUATION_PROBE_MODE = false;
+const int PROBE_TRIALS = 30;
+const int PROBE_POWER = 100;          // Step size (percent)
+const uint32_t PROBE_REST_MS = 500;   // Coast to a stop between trials
+
+// One motor of each type: drive 18:1, 5.5W intake and ramp, full power top wheel
+const ActuationFrame::Motor ProbeMotors[] = {
+  ActuationFrame::LEFT_FRONT, ActuationFrame::INTAKE, ActuationFrame::RAMP, ActuationFrame::FULL_POWER_RAMP
+};
+ActuationProbe Probe;
+
+/**
+ * Step one motor PROBE_TRIALS times and print its distributions and fitted model
+ * Encoder readings are timestamped when they are first seen (polled every 1 ms).
+ */
+void probeMotor(ActuationFrame::Motor id) {
+  motor& probed = *AllMotors[id];
+  Probe.reset();
+  
+  for (int trial = 0; trial < PROBE_TRIALS; trial++) {
+    probed.stop();
+    wait(PROBE_REST_MS, msec);
+    
+    double startPosition = probed.position(degrees);
+    uint32_t lastReading = probed.timestamp();
+    uint32_t commandUs = (uint32_t)timer::systemHighResolution();
+    probed.spin(forward, PROBE_POWER, percent);
+    Probe.startTrial(commandUs, startPosition);
+    
+    bool done = false;
+    while (!done) {
+      wait(1, msec);
+      if (probed.timestamp() != lastReading) {
+        lastReading = probed.timestamp();
+        done = Probe.addSample((uint32_t)timer::systemHighResolution(), probed.position(degrees));
+      }
+    }
+  }
+  probed.stop();
+  
+  char name[40];
+  char line[96];
+  const char* motorName = RobotDescriptor::MOTORS[id].name;
+  snprintf(name, sizeof(name), "probe_%s_motion", motorName);
+  Telemetry::formatLatencyRecord(line, sizeof(line), timer::system(), name, Probe.getMotionLatency());
+  printf("%s\n", line);
+  snprintf(name, sizeof(name), "probe_%s_rise", motorName);
+  Telemetry::formatLatencyRecord(line, sizeof(line), timer::system(), name, Probe.getRiseTime());
+  printf("%s\n", line);
+  
+  ActuationProbe::MotorModel model = Probe.getModel();
+  printf("MOTOR_MODEL,%s,dead_ms=%.1f,tau_ms=%.1f,rpm=%.0f,failed=%d\n", motorName,
+         model.deadTimeMs, model.timeConstantMs, model.steadyRpm, Probe.getFailedCount());
+}
+
+/**
+ * Measure every motor type (takes about a minute), then wait for the program to be stopped
+ */
+void runActuationProbe() {
+  Brain.Screen.clearScreen();
+  Brain.Screen.setCursor(1, 1);
+  Brain.Screen.print("Actuation probe - robot on a stand!");
+  for (int i = 0; i < (int)(sizeof(ProbeMotors) / sizeof(ProbeMotors[0])); i++) {
+    probeMotor(ProbeMotors[i]);
+  }
+  Brain.Screen.setCursor(2, 1);
+  Brain.Screen.print("Probe done - see serial output");
+}
+
+/**
+ * Initialize your robot here.
+ * This function runs once when the robot starts up.
+ */
+void vexcodeInit(void) {
+  // Initialize pneumatic pistons to LOW position (retracted)
+  // This ensures the robot starts at low height
+  bool initialPistonState = PneumaticController::calculatePistonState(PneumaticController::LOW);
+  Piston1.set(initialPistonState);
+  Piston2.set(initialPistonState);
+  HeightTravel.reset(PneumaticController::LOW);
+  HeightTravel.setConfirmationRequired(PneumaticController::HIGH, HEIGHT_SWITCH_INSTALLED);  // Top switch only
+  Phases.getState() = PhaseManager::defaultState();  // LOW height, nothing running
+  setupPhaseHooks();
+  setupCommands();
+  setupEvents();
+  
+  // Normal motor limits and endgame behaviors
+  applyTorqueLimits();
+  setupMatchRules();
+  
+  // Continue the battery model from the last match (if it's the same battery)
+  loadBatteryState();
+  
+  // Calibrate the inertial sensor (robot must be still, takes about 2 seconds)
+  Inertial.calibrate();
+  while (Inertial.isCalibrating()) {
+    wait(20, msec);
+  }
+  
+  // Any other initialization code goes here
+  // This is called before the competition starts
+}
+
+// AUTONOMOUS ROUTINES
+// A routine is a start pose and a list of steps for Auton. Steps a routine can use:
+// (add a case to runAutonStep() for each new one)
+enum AutonStep {
+  DRIVE_OUT,
+  PICK_UP_BALL
+};
+AutonStep AutonStepKinds[AutonSchedule::MAX_STEPS];  // What each step in Auton does
+
+/**
+ * Add a step to Auton (see AutonSchedule::addStep())
+ */
+int addAutonStep(AutonStep kind, const char* name, uint32_t expectedMs, double points,
+                 int needs = AutonSchedule::NO_STEP) {
+  int step = Auton.addStep(name, expectedMs, points, needs);
+  if (step != AutonSchedule::NO_STEP) {
+    AutonStepKinds[step] = kind;
+  }
+  return step;
+}
+
+/**
+ * Example routine: drive 40 inches straight ahead (around anything in the way), then
+ * pick up the nearest ball of our color, even if it was knocked out of place.
+ * Each step: how long it usually takes (ms), what it scores, and the step it needs.
+ */
+void addDriveAndPickUp() {
+  int driveOut = addAutonStep(DRIVE_OUT, "drive out", 2500, 0.0);
+  addAutonStep(PICK_UP_BALL, "pick up ball", 2500, 1.0, driveOut);
+}
+
+struct AutonRoutine {
+  const char* name;       // Shown on the Brain screen
+  Odometry::Pose start;   // Start pose (field inches, heading clockwise from +y)
+  void (*addSteps)();     // Adds the routine's steps to Auton
+};
+
+// One alliance's start tiles: the field looks the same from the other alliance's tiles
+// turned half a turn, so those can't be told apart (swap the list when switching sides)
+const AutonRoutine ROUTINES[] = {
+  {"Left: drive + ball", {-36.0, -60.0, 0.0}, addDriveAndPickUp},
+  {"Right: drive + ball", {36.0, -60.0, 0.0}, addDriveAndPickUp}
+};
+const int ROUTINE_COUNT = sizeof(ROUTINES) / sizeof(ROUTINES[0]);
+static_assert(ROUTINE_COUNT <= StartDetector::MAX_STARTS, "Too many autonomous routines");
+
+/**
+ * Run one step of the autonomous routine
+ * 
+ * @param step Step number in Auton
+ * @return true if the step did what it was for
+ */
+bool runAutonStep(int step) {
+  switch (AutonStepKinds[step]) {
+    case DRIVE_OUT: {
+      Odometry::Pose startPose;
+      RobotPose.read(startPose);
+      Route.clear();
+      Route.addWaypoint(RouteFollower::pointAhead(startPose, 40.0));
+      return followRoute(4000);  // Give up after 4 seconds
+    }
+    case PICK_UP_BALL:
+      return pickUpBall(3000);
+    default:
+      return false;
+  }
+}
+
+// START TILE DETECTION
+// Until the match starts, the distance sensors look for the start tile the robot is on and
+// select the routine that starts there (see StartDetector). The choice is on the Brain
+// screen (rows 3 and 4). If no tile matches, the last choice stays (the first routine at
+// power-up).
+StartDetector StartTiles;
+int SelectedRoutine = 0;  // Written by startDetectTask() before the match only
+const uint32_t START_DETECT_PERIOD_MS = 50;
+
+// Where the distance sensors are: inches right and forward of the robot's center, and
+// the way they face (degrees clockwise from the front) - measure these on your robot
+const StartDetector::Mount DISTANCE_LEFT_MOUNT = {-7.0, 0.0, -90.0};
+const StartDetector::Mount DISTANCE_RIGHT_MOUNT = {7.0, 0.0, 90.0};
+const StartDetector::Mount DISTANCE_BACK_MOUNT = {0.0, -7.0, 180.0};
+
+/**
+ * Distance sensor reading in inches (-1 if nothing is in range)
+ */
+double readDistance(distance& sensor) {
+  return sensor.isObjectDetected() ? sensor.objectDistance(inches) : -1.0;
+}
+
+/**
+ * Show the selected routine and what the detector knows on the Brain screen
+ */
+void showStartDetection(StartDetector::Status status) {
+  Brain.Screen.clearLine(3);
+  Brain.Screen.setCursor(3, 1);
+  Brain.Screen.print("AUTO: %s", ROUTINES[SelectedRoutine].name);
+  Brain.Screen.clearLine(4);
+  Brain.Screen.setCursor(4, 1);
+  if (status == StartDetector::DETECTED) {
+    Brain.Screen.print("Start tile found");
+  } else if (status == StartDetector::WRONG_HEADING) {
+    // Turned clockwise from the routine's heading: turn back the shorter way
+    double turned = StartTiles.getHeadingError();
+    Brain.Screen.print("%s tile: turn robot %.0f deg %s", ROUTINES[StartTiles.getStart()].name,
+                       (turned > 180.0) ? 360.0 - turned : turned, (turned > 180.0) ? "right" : "left");
+  } else if (status == StartDetector::UNKNOWN) {
+    Brain.Screen.print("Start tile? (keeping this routine)");
+  } else {
+    Brain.Screen.print("Finding start tile...");
+  }
+}
+
+/**
+ * START DETECTION TASK
+ * Runs from power-up until the robot is first enabled (the match starts).
+ * Every 50 ms: feeds the distance readings and inertial heading to StartTiles. When it
+ * finds a routine's start pose, selects that routine and gives its pose to localization.
+ */
+int startDetectTask() {
+  StartTiles.addSensor(DISTANCE_LEFT_MOUNT);
+  StartTiles.addSensor(DISTANCE_RIGHT_MOUNT);
+  StartTiles.addSensor(DISTANCE_BACK_MOUNT);
+  for (int i = 0; i < ROUTINE_COUNT; i++) {
+    StartTiles.addStart(ROUTINES[i].start);
+  }
+  
+  StartDetector::Status shownStatus = StartDetector::WAITING;
+  int shownStart = -1;
+  showStartDetection(shownStatus);
+  while (!Competition.isEnabled()) {
+    double distances[] = {readDistance(DistanceLeft), readDistance(DistanceRight), readDistance(DistanceBack)};
+    StartDetector::Status status = StartTiles.update(distances, Inertial.heading());
+    
+    // Only act on changes (the screen is slow)
+    if (status != shownStatus || StartTiles.getStart() != shownStart) {
+      shownStatus = status;
+      shownStart = StartTiles.getStart();
+      if (status == StartDetector::DETECTED) {
+        SelectedRoutine = shownStart;
+        StartPose.write(ROUTINES[shownStart].start);
+      }
+      showStartDetection(status);
+      printf("START,status=%d,routine=%d,error=%.1f,next=%.1f\n", status, SelectedRoutine,
+             StartTiles.getError(), StartTiles.getRunnerUpError());
+    }
+    wait(START_DETECT_PERIOD_MS, msec);
+  }
+  return 0;
+}
+
+/**
+ * AUTONOMOUS MODE
+ * This function runs when the robot is in autonomous mode (no driver).
+ * Write code here for your robot to run by itself.
+ */
+void autonomous(void) {
+  // Runs the autonomous hooks now if matchClockTask() hasn't noticed the change yet
+  Phases.transition(MatchClock::AUTONOMOUS);
+  
+  // Forget bumps from before the match (robot placement, etc.)
+  TipDetector::Event oldEvent;
+  while (TipEvents.pop(oldEvent)) {
+  }
+  
+  // The routine startDetectTask() selected
+  const AutonRoutine& routine = ROUTINES[SelectedRoutine];
+  Auton.clear();
+  routine.addSteps();
+  
+  // matchClockTask() may not have seen the period start yet
+  uint32_t now = timer::system();
+  bool clockRunning = Match.getPhase() == MatchClock::AUTONOMOUS;
+  Auton.start(now, clockRunning ? Match.getRemainingMs(now) : MatchClock::DEFAULT_AUTONOMOUS_MS);
+  
+  for (int step = Auton.next(now); step != AutonSchedule::NO_STEP; step = Auton.next(timer::system())) {
+    bool finished = runAutonStep(step);
+    Auton.finishStep(timer::system(), finished);
+  }
+  printf("AUTON,routine=%s,score=%.0f,pace=%.2f\n", routine.name, Auton.getScore(), Auton.getPace());
+  
+  // Example: back into the wall to square up and fix the gyro heading
+  // squareToWall(-1);
+}
+
+/**
+ * USER CONTROL MODE (DRIVER CONTROL)
+ * This function runs continuously while the driver controls the robot.
+ */
+void usercontrol(void) {
+  // Runs the driver hooks (and applies the handoff) if matchClockTask() hasn't yet
+  Phases.transition(MatchClock::DRIVER);
+  PhaseManager::RobotState& state = Phases.getState();
+  Commands.cancelAll();  // Nothing left over from an earlier driver control period
+  bool firstTick = true;
+  uint32_t heldMatchActions = 0;  // Endgame height actions waiting for tip recovery to finish
+  bool lastDpad[4] = {false, false, false, false};  // Up, Down, Left, Right last tick
+  bool lastWallButton = false;
+  bool lastScoreButton = false;
+  
+  // This loop runs forever while the robot is in driver control mode
+  while (true) {
+    uint32_t tickStartMs = timer::system();
+    
+    // Events published since the last tick (faults, phase changes)
+    dispatchEvents();
     
     // ============================================
-    // FULL POWER RAMP MOTOR CONTROL (Feature 3)
+    // SENSE
     // ============================================
+    // Read everything the tick needs up front
     
-    // Full Power Ramp Motor Control
-    // X = Full power forward (push balls out), Y = Full power reverse
-    RampController::MotorState fullPowerState = RampController::STOP;
-    if (Controller1.ButtonX.pressing()) {
-        fullPowerState = RampController::FORWARD;  // Push balls out
-    } else if (Controller1.ButtonY.pressing()) {
-        fullPowerState = RampController::REVERSE;  // Pull balls back
-    }
+    // Latest controller snapshot from inputTask() (never waits)
+    bool inputChanged = Inputs.read(DriverInput);
+    DriverHeading = Inertial.heading();
+    DriverTickMs = timer::system();
     
-    // Calculate full power ramp motor power using our testable RampController
-    // Use full power mode (100% when active)
-    int fullPowerRampPower = RampController::calculateRampPower(fullPowerState, true, 0);
-    FullPowerRampMotor.spin(forward, fullPowerRampPower, percent);
+    // Gyro every tick, goal frames at the camera's rate (for auto-aim)
+    Aim.addHeading(DriverHeading, DriverTickMs);
+    readGoalFrame(DriverTickMs);
     
     // ============================================
-    // PNEUMATIC HEIGHT CONTROL (Feature 4)
+    // BUTTON BINDINGS
     // ============================================
+    // Start and stop macros; the scheduler hands them the subsystems they need
     
-    // Toggle height position with Button A
-    // Detect button press (not hold) to toggle once per press
-    bool currentToggleButton = Controller1.ButtonA.pressing();
-    if (currentToggleButton && !lastToggleButtonState) {
-        // Button was just pressed (edge detection)
-        // Toggle to opposite position
-        currentHeight = PneumaticController::togglePosition(currentHeight);
-        
-        // Calculate piston state (true = extended, false = retracted)
-        bool pistonState = PneumaticController::calculatePistonState(currentHeight);
-        
-        // Set both pistons to the same state
-        Piston1.set(pistonState);
-        Piston2.set(pistonState);
+    // QUICK TURNS (D-pad)
+    // Right/Left = turn 90 degrees clockwise/counter-clockwise, Down = turn around,
+    // Up = square up to the nearest field direction. Press again while turning to chain.
+    bool dpad[4] = {DriverInput.pressed(InputSampler::BUTTON_UP), DriverInput.pressed(InputSampler::BUTTON_DOWN),
+                    DriverInput.pressed(InputSampler::BUTTON_LEFT), DriverInput.pressed(InputSampler::BUTTON_RIGHT)};
+    bool turnPressed = true;
+    if (dpad[0] && !lastDpad[0]) {
+      QuickTurn.start(DriverHeading, HeadingSnap::nearestPreset(DriverHeading), DriverTickMs);
+    } else if (dpad[1] && !lastDpad[1]) {
+      QuickTurn.startRelative(DriverHeading, 180.0, DriverTickMs);
+    } else if (dpad[2] && !lastDpad[2]) {
+      QuickTurn.startRelative(DriverHeading, -90.0, DriverTickMs);
+    } else if (dpad[3] && !lastDpad[3]) {
+      QuickTurn.startRelative(DriverHeading, 90.0, DriverTickMs);
+    } else {
+      turnPressed = false;
+    }
+    if (turnPressed && !Commands.schedule(&QuickTurnCommand)) {
+      QuickTurn.cancel();  // Refused (tip recovery has the drive)
+    }
+    for (int i = 0; i < 4; i++) {
+      lastDpad[i] = dpad[i];
+    }
+    
+    // WALL SQUARING (B)
+    // Drives forward into the wall at low power until both sides touch, then fixes the gyro
+    bool wallButton = DriverInput.pressed(InputSampler::BUTTON_B);
+    if (wallButton && !lastWallButton) {
+      WallAlign.start(1, DriverTickMs);
+      if (!Commands.schedule(&WallSquareCommand)) {
+        WallAlign.cancel();
+      }
+    }
+    lastWallButton = wallButton;
+    
+    // AUTO-AIM (X)
+    // Pressing X with the goal in view turns to it; releasing X ends it
+    bool scoreButton = DriverInput.pressed(InputSampler::BUTTON_X);
+    if (scoreButton && !lastScoreButton && AUTO_AIM_ON_SCORE && Aim.hasGoal(DriverTickMs)) {
+      Aim.start();
+      if (!Commands.schedule(&AutoAimCommand)) {
+        Aim.cancel();
+      }
+    } else if (!scoreButton) {
+      Commands.cancel(&AutoAimCommand);
+    }
+    lastScoreButton = scoreButton;
+    
+    // Moving either stick hands control straight back to the driver
+    if (DriveTrain::applyDeadband(DriverInput.axis(InputSampler::AXIS_3), DRIVE_DEADBAND) != 0 ||
+        DriveTrain::applyDeadband(DriverInput.axis(InputSampler::AXIS_2), DRIVE_DEADBAND) != 0) {
+      Commands.cancel(&QuickTurnCommand);
+      Commands.cancel(&WallSquareCommand);
+      Commands.cancel(&AutoAimCommand);
+    }
+    
+    // Tipping overrides everything
+    TipState tip;
+    PublishedTipState.read(tip);
+    if (tip.tipping) {
+      Commands.schedule(&TipRecovery);
     }
-    lastToggleButtonState = currentToggleButton;  // Remember state for next loop
     
-    // OPTION 2: ARCADE DRIVE (COMMENTED OUT - UNCOMMENT TO USE)
-    // Driver uses one stick: forward/backward controls speed, left/right controls turning
-    // This is more like a car - more intuitive for some drivers
+    // PNEUMATIC HEIGHT (A)
+    // Detect button press (not hold) to toggle once per press; not while recovering from a tip
+    bool currentToggleButton = DriverInput.pressed(InputSampler::BUTTON_A);
+    if (currentToggleButton && !state.lastToggleButton && !Commands.isScheduled(&TipRecovery)) {
+      // Toggle to opposite position (the pistons move when the frame is written)
+      state.height = PneumaticController::togglePosition(state.height);
+    }
+    state.lastToggleButton = currentToggleButton;  // Remember state for next loop
+    
+    // ENDGAME RULES
+    // Timed behaviors (relax limits, endgame height, driver warnings). The endgame height
+    // waits while TipRecovery holds the robot at LOW, then applies once it is level.
+    uint32_t dueActions = EndgameRules.update(Match.getRemainingMs(timer::system()));
+    heldMatchActions = applyMatchActions(heldMatchActions | dueActions, Commands.isScheduled(&TipRecovery));
+    
+    // PISTON TRAVEL AND SCORING PROFILE
+    // In transit or settled at the height commanded above; the full power wheel
+    // switches to that height's profile and spins up while the pistons move.
+    // Balls wait on the ramp while auto-aim is still turning to the goal.
+    trackHeight(timer::system());
+    Scoring.holdForAim(Commands.isScheduled(&AutoAimCommand) && !Aim.isLocked());
+    MotorSpeeds speeds;
+    PublishedMotorSpeeds.read(speeds);
+    Scoring.update(state.height, DriverInput.pressed(InputSampler::BUTTON_X), HeightTravel.isSettled(),
+                   speeds.rpm[ActuationFrame::FULL_POWER_RAMP], timer::system());
+    
+    // ============================================
+    // COMPUTE
+    // ============================================
+    // Every command stages its outputs in the frame - nothing is written to the robot yet
+    ActuationFrame frame;
+    uint32_t runStartUs = phaseClockUs();
+    Commands.run(frame);
+    SchedulerOverhead.add(phaseClockUs() - runStartUs);
     
-    /*
-    // Read controller input
-    int forwardInput = Controller1.Axis3.position();    // Forward/backward
-    int turnInput = Controller1.Axis1.position();       // Left/right turning
+    // Spread each side's command over its three motors
+    balanceDrive(frame, speeds, timer::system());
+    
+    // ============================================
+    // ACTUATE
+    // ============================================
+    // All nine motors and both pistons, back-to-back (left and right drive in pairs)
+    ActuationSkew.add(frame.apply(writeFrameMotor, writeFramePiston, phaseClockUs));
     
-    // Apply deadband to prevent drift
-    forwardInput = DriveTrain::applyDeadband(forwardInput, 5);
-    turnInput = DriveTrain::applyDeadband(turnInput, 5);
+    // Balls grabbed, handed off or scored this tick
+    countBalls(frame, speeds, timer::system());
     
-    // Calculate left and right motor powers using our testable DriveTrain class
-    int leftPowerArcade, rightPowerArcade;
-    DriveTrain::calculateArcadeDrive(forwardInput, turnInput, leftPowerArcade, rightPowerArcade);
+    // Record how long driver control took to act after the phase change
+    if (firstTick) {
+      firstTick = false;
+      Phases.markFirstTick();
+      printf("PHASE,hooks_us=%lu,first_tick_us=%lu\n",
+             (unsigned long)Phases.getHookLatencyUs(), (unsigned long)Phases.getFirstTickLatencyUs());
+    }
     
-    // Set motor speeds (clamping is handled inside calculateArcadeDrive!)
-    LeftDrive.spin(forward, leftPowerArcade, percent);
-    RightDrive.spin(forward, rightPowerArcade, percent);
-    */
+    // How long this input change took to reach the motors
+    if (inputChanged) {
+      InputLatency.add((uint32_t)timer::systemHighResolution() - DriverInput.changedAtUs);
+    }
     
-    // Small delay to prevent the loop from running too fast
+    // Wait for the next controller change (at most 20 ms)
     // This gives the motors time to respond and saves processing power
-    wait(20, msec);  // Wait 20 milliseconds between loop cycles
+    waitForNextTick(tickStartMs);
   }
 }
 
@@ -577,6 +10585,25 @@ int main() {
   // Initialize the robot
   vexcodeInit();
   
+  // Measurement mode (no background tasks, so nothing else moves the motors)
+  if (ACTUATION_PROBE_MODE) {
+    runActuationProbe();
+    while (true) {
+      wait(100, msec);
+    }
+  }
+  
+  // Start tracking the robot's position in the background
+  task LocalizationTask = task(localizationTask);
+  task MotorVelocityTask = task(motorVelocityTask);
+  task EnergyTask = task(energyTask);
+  task MatchClockTask = task(matchClockTask);
+  task TipTask = task(tipTask);
+  task InputTask = task(inputTask);
+  
+  // Find the start tile and select the autonomous routine until the match starts
+  task StartDetectTask = task(startDetectTask);
+  
   // Competition mode (for competitions)
   Competition.autonomous(autonomous);   // Run autonomous() during autonomous period
   Competition.drivercontrol(usercontrol); // Run usercontrol() during driver control